@@ -0,0 +1,117 @@
+/**
+ * @file ACDC_ACQUIRE.h
+ * @author Devin Marx
+ * @brief Header file for fixed rate LTC1298 sampling into a ring of sample blocks
+ *
+ * A timer interrupt starts a background LTC1298 conversion every sample period and the SPI interrupt
+ * stores the sample into the block being filled. Full blocks wait in the ring until the main loop takes
+ * them with ACQUIRE_GetBlock, which converts them to q15, calibrates them, and runs the filter pipeline on them in place.
+ * A channel can be oversampled: 4^n conversions are summed (Boxcar or CIC) into one sample with n extra bits,
+ * optionally with a dither ramp from an LTC1451 added to the input.
+ *
+ * @version 0.1
+ * @date 2024-04-15
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_ACQUIRE_H
+#define __ACDC_ACQUIRE_H
+
+#include "stm32f1xx.h"
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+#include "ACDC_LTC1298_ADC.h"
+#include "ACDC_LTC1451_DAC.h"
+#include "ACDC_FILTER.h"
+#include "ACDC_CALIBRATION.h"
+
+#define ACQUIRE_BLOCK_SIZE      64      /**< Samples per block                                                     */
+#define ACQUIRE_BLOCK_COUNT     4       /**< Blocks in the ring (One being filled, the rest waiting or being used)  */
+#define ACQUIRE_MAX_SAMPLE_RATE 4000    /**< Each read clocks 32 bits at <= 200kHz (~230us with SPI2 at 72MHz)      */
+#define ACQUIRE_MAX_EXTRA_BITS  4       /**< Most oversampling bits (4^4 = 256 conversions per sample, 16-bit samples) */
+
+typedef enum{
+    ACQUIRE_CH0,    /**< Sample channel 0 of the LTC1298 */
+    ACQUIRE_CH1     /**< Sample channel 1 of the LTC1298 */
+}ACQUIRE_Channel;
+
+typedef enum{
+    ACQUIRE_OVERSAMPLE_BOXCAR,  /**< Sum of the 4^n conversions (1st order CIC, sinc response)                   */
+    ACQUIRE_OVERSAMPLE_CIC2     /**< 2nd order CIC (Better rejection of aliases, each sample spans 2 * 4^n conversions, the first one after ACQUIRE_Start is thrown away) */
+}ACQUIRE_OversampleFilter;
+
+typedef struct{
+    q15_t *samples;         /**< Converted (and filtered) samples, valid until ACQUIRE_ReleaseBlock */
+    uint32_t length;        /**< Number of samples (Smaller than ACQUIRE_BLOCK_SIZE after decimation) */
+    uint32_t firstSample;   /**< Number of the block's first sample, counted from ACQUIRE_Start (Before decimation) */
+    uint32_t timestamp;     /**< Micros() when the conversion of the block's first sample started (Wraps every ~71 minutes) */
+    uint32_t samplePeriod;  /**< Nanoseconds between the block's samples (After oversampling and decimation) */
+}ACQUIRE_Block_t;
+
+/// @brief Sets up sampling of one LTC1298 channel at a fixed rate (Call ACQUIRE_Start to begin)
+/// @param LTC_ADC ADC returned by LTCADC_InitCS
+/// @param ACQUIRE_CHx Channel to sample (ACQUIRE_CH0 or ACQUIRE_CH1)
+/// @param TIMx Timer that sets the sample rate (Ex. TIM2, TIM3, TIM4), do not use it for PWM
+/// @param sampleRate Samples per second (1 - ACQUIRE_MAX_SAMPLE_RATE)
+/// @return True if the configuration is valid, false otherwise
+bool ACQUIRE_Init(LTC1298_t LTC_ADC, ACQUIRE_Channel ACQUIRE_CHx, TIM_TypeDef *TIMx, uint32_t sampleRate);
+
+/// @brief Sets how a channel is oversampled (Takes effect at the next ACQUIRE_Start). Each sample sums 4^extraBits conversions,
+///        so the sample rate becomes sampleRate / 4^extraBits with extraBits more bits (Ex. 4000Hz, 2 bits -> 250Hz, 14 bits)
+/// @param ACQUIRE_CHx Channel the setting is for (ACQUIRE_CH0 or ACQUIRE_CH1)
+/// @param extraBits Bits to add (0 turns oversampling off, up to ACQUIRE_MAX_EXTRA_BITS)
+/// @param ACQUIRE_OVERSAMPLE_x Filter used to sum the conversions
+/// @return True if the setting was saved, false if extraBits is too large
+bool ACQUIRE_SetOversampling(ACQUIRE_Channel ACQUIRE_CHx, uint8_t extraBits, ACQUIRE_OversampleFilter ACQUIRE_OVERSAMPLE_x);
+
+/// @brief Adds a dither ramp from an LTC1451 to the conversions of an oversampled channel (Takes effect at the next ACQUIRE_Start).
+///        The DAC steps from center - amplitude / 2 up by amplitude over every 4^n conversions. It has to be wired into the ADC input
+///        (Ex. through a large resistor) so the ramp spans about 1 ADC LSB, and must not share the ADC's SPI
+/// @param ACQUIRE_CHx Channel the setting is for (ACQUIRE_CH0 or ACQUIRE_CH1)
+/// @param LTC_DAC DAC returned by LTCDAC_InitCS
+/// @param center DAC code in the middle of the ramp
+/// @param amplitude DAC codes the ramp spans (0 turns dither off)
+/// @return True if the setting was saved, false if the ramp does not fit in the 12-bit DAC range
+bool ACQUIRE_SetDither(ACQUIRE_Channel ACQUIRE_CHx, LTC1451_t LTC_DAC, uint16_t center, uint16_t amplitude);
+
+/// @brief Corrects every block of a channel with a calibration before the filter pipeline runs (Pass 0 to turn it off)
+/// @param ACQUIRE_CHx Channel the calibration is for (ACQUIRE_CH0 or ACQUIRE_CH1)
+/// @param calibration Calibration of the channel (Ex. &set.adc[ACQUIRE_CH0] after CALIBRATION_Load, must stay valid)
+void ACQUIRE_SetCalibration(ACQUIRE_Channel ACQUIRE_CHx, const CALIBRATION_t *calibration);
+
+/// @brief Runs pipeline on every block before ACQUIRE_GetBlock returns it (Pass 0 to get the unfiltered samples)
+/// @param pipeline Pipeline made with FILTER_Init for ACQUIRE_BLOCK_SIZE samples
+/// @return True if the filter was set, false if the pipeline's block size is not ACQUIRE_BLOCK_SIZE
+bool ACQUIRE_SetFilter(FILTER_Pipeline_t *pipeline);
+
+/// @brief Empties the ring and starts sampling
+/// @return True if sampling started, false if ACQUIRE_Init has not succeeded or the timer could not be started
+bool ACQUIRE_Start(void);
+
+/// @brief Stops sampling and waits up to 5ms for the last conversion (Blocks already in the ring can still be taken)
+void ACQUIRE_Stop(void);
+
+/// @brief Takes the oldest full block from the ring, converted to q15 and filtered in place
+/// @param block Set to the samples of the block
+/// @return True if a block was ready, false if none are waiting. Calling it again before ACQUIRE_ReleaseBlock returns the same block
+bool ACQUIRE_GetBlock(ACQUIRE_Block_t *block);
+
+/// @brief Gives the block from ACQUIRE_GetBlock back to the ring so it can be filled again
+void ACQUIRE_ReleaseBlock(void);
+
+/// @brief Gets the number the next sample will have (Safe to call from interrupts, Ex. to mark when an EXTI event happened)
+///        Oversampled channels count samples, not conversions
+/// @return Number of samples taken since ACQUIRE_Start
+uint32_t ACQUIRE_GetSampleNumber(void);
+
+/// @brief Gets the number of full blocks thrown away because every other block was waiting to be taken
+/// @return Number of dropped blocks since ACQUIRE_Start
+uint32_t ACQUIRE_GetDroppedBlocks(void);
+
+/// @brief Gets the number of sample periods skipped because the previous conversion was still running
+/// @return Number of missed samples since ACQUIRE_Start
+uint32_t ACQUIRE_GetMissedSamples(void);
+
+#endif
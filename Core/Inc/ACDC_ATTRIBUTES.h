@@ -0,0 +1,24 @@
+/**
+ * @file ACDC_ATTRIBUTES.h
+ * @author Devin Marx
+ * @brief Header file for compiler attributes used by the ACDC modules
+ * @version 0.1
+ * @date 2024-04-09
+ * 
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_ATTRIBUTES_H
+#define __ACDC_ATTRIBUTES_H
+
+#if defined(__arm__) && !defined(ACDC_NO_RAMFUNC)
+/// @brief Runs the function from SRAM instead of flash (Flash needs 2 wait states at 72MHz {See RM-60})
+///        The function is placed in .ramfunc, which the linker script stores with .data and the startup code copies to RAM.
+///        long_call is needed because SRAM (0x20000000) is out of range of a BL from flash (0x08000000).
+///        Put it on both the prototype and the definition. Define ACDC_NO_RAMFUNC to keep everything in flash.
+#define ACDC_RAMFUNC __attribute__((section(".ramfunc"), long_call, noinline))
+#else
+#define ACDC_RAMFUNC
+#endif
+
+#endif
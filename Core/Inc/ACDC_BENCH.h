@@ -0,0 +1,96 @@
+/**
+ * @file ACDC_BENCH.h
+ * @author Devin Marx
+ * @brief Header file for the cycle counting benchmark harness
+ *
+ * Benchmarks are timed with the DWT cycle counter (1 count per core clock cycle) and the
+ * results are printed over USART as comma separated lines that Python_Helper/BENCH_Helper.py
+ * can collect and compare. The QEMU build (ACDC_QEMU) prints the same lines through semihosting.
+ *
+ * @version 0.1
+ * @date 2024-04-02
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_BENCH_H
+#define __ACDC_BENCH_H
+
+#include "stm32f1xx.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define BENCH_MAX_BENCHMARKS 32     /**< Maximum number of benchmarks that can be registered */
+
+#ifdef ACDC_QEMU
+#define BENCH_CYCLES() (0U)             /**< QEMU does not model the DWT, every cycle count is 0 */
+#else
+#define BENCH_CYCLES() (DWT->CYCCNT)    /**< Current value of the DWT cycle counter */
+#endif
+
+/// @brief Function under test, called once per iteration
+/// @param iteration Current iteration (0 to iterations - 1), use it as input so the call can not be hoisted out of the loop
+/// @return Any value derived from the work done. Results are XORed into the checksum so the work can not be optimized away
+typedef uint32_t (*BenchFunction)(uint32_t iteration);
+
+typedef struct{
+    const char *name;           /**< Name printed with the results (Must not contain commas) */
+    BenchFunction function;     /**< Function under test                                      */
+    uint32_t iterations;        /**< Number of times the function is called                   */
+}Benchmark_t;
+
+typedef struct{
+    uint32_t iterations;        /**< Number of times the function was called                         */
+    uint32_t minCycles;         /**< Fewest cycles taken by a single call (Call overhead removed)    */
+    uint32_t maxCycles;         /**< Most cycles taken by a single call (Includes any interrupts)    */
+    uint64_t totalCycles;       /**< Sum of the cycles taken by every call (Call overhead removed)   */
+    uint32_t checksum;          /**< XOR of every value returned by the function                     */
+}BenchResult_t;
+
+/// @brief Enables the DWT cycle counter and measures the overhead of timing a single call
+void BENCH_Init(void);
+
+/// @brief Checks if the DWT cycle counter is counting (It does not count under emulators such as QEMU)
+/// @return True if the cycle counter is counting, false otherwise
+bool BENCH_IsCycleCounterRunning(void);
+
+/// @brief Adds a benchmark to the list run by BENCH_RunAll
+/// @param name Name printed with the results (Must not contain commas)
+/// @param function Function under test
+/// @param iterations Number of times the function is called
+/// @return True if the benchmark was added, false if BENCH_MAX_BENCHMARKS are already registered
+bool BENCH_Register(const char *name, BenchFunction function, uint32_t iterations);
+
+/// @brief Times every call of a single benchmark
+/// @param bench Benchmark to run
+/// @return Cycle counts and checksum of the run
+BenchResult_t BENCH_Run(const Benchmark_t *bench);
+
+/// @brief Prints the result of a benchmark as "BENCH,name,iterations,min,avg,max,checksum"
+/// @param USARTx USART Peripheral to print to (Ex. USART1, USART2, ...)
+/// @param bench Benchmark that was run
+/// @param result Result returned by BENCH_Run
+void BENCH_Report(USART_TypeDef *USARTx, const Benchmark_t *bench, const BenchResult_t *result);
+
+/// @brief Runs and reports every registered benchmark, wrapped in BENCH_BEGIN and BENCH_END lines
+/// @param USARTx USART Peripheral to print to (Ex. USART1, USART2, ...)
+void BENCH_RunAll(USART_TypeDef *USARTx);
+
+/// @brief Prints the result of a self-check as "CHECK,name,PASS" or "CHECK,name,FAIL" and counts the failures
+/// @param USARTx USART Peripheral to print to (Ex. USART1, USART2, ...)
+/// @param name Name printed with the result (Must not contain commas)
+/// @param passed True if the check passed
+/// @return passed
+bool BENCH_Check(USART_TypeDef *USARTx, const char *name, bool passed);
+
+/// @brief Gets the number of BENCH_Check calls that failed
+/// @return Number of failed checks
+uint32_t BENCH_GetFailedChecks(void);
+
+#ifdef ACDC_QEMU
+/// @brief Ends the QEMU session through semihosting SYS_EXIT_EXTENDED, QEMU exits with status (Only in the QEMU build)
+/// @param status Exit status (0 if every check passed)
+void BENCH_Exit(uint32_t status);
+#endif
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file ACDC_CALIBRATION.h
+ * @author Devin Marx
+ * @brief Header file for fixed point ADC and DAC calibration stored in a flash page
+ *
+ * A calibration corrects q15 values with an offset, a gain, and an optional piecewise linear table:
+ *
+ *   corrected = table((value + offset) * gainFract * 2^gainShift)
+ *
+ * The offset and gain run as CMSIS-DSP block kernels (arm_offset_q15, arm_scale_q15), so a whole ACDC_ACQUIRE
+ * block is corrected in place without floating point. The calibrations of both LTC1298 channels and the
+ * LTC1451 are kept together in the last flash page, protected by a CRC.
+ *
+ * @version 0.1
+ * @date 2024-04-23
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_CALIBRATION_H
+#define __ACDC_CALIBRATION_H
+
+#include "stm32f1xx.h"
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define CALIBRATION_TABLE_POINTS 17     /**< Table points at -1.0, -0.875, ... +1.0 (Every 4096 q15 codes) */
+#define CALIBRATION_MAX_SHIFT    7      /**< Largest gainShift (Gains up to 128)                            */
+
+typedef struct{
+    q15_t offset;                               /**< Added to the value before the gain                        */
+    q15_t gainFract;                            /**< Gain is gainFract * 2^gainShift (arm_scale_q15)            */
+    int8_t gainShift;                           /**< 0 - CALIBRATION_MAX_SHIFT                                  */
+    bool useTable;                              /**< True to run the result through table                       */
+    q15_t table[CALIBRATION_TABLE_POINTS];      /**< Output at each table point, linear in between              */
+}CALIBRATION_t;
+
+typedef struct{
+    CALIBRATION_t adc[2];                       /**< LTC1298 channel 0 and channel 1 (Index with ACQUIRE_CHx)   */
+    CALIBRATION_t dac;                          /**< LTC1451 output                                             */
+}CALIBRATION_Set_t;
+
+/// @brief Sets a calibration that leaves values unchanged (Offset 0, gain 1, no table)
+/// @param calibration Calibration to reset
+void CALIBRATION_Init(CALIBRATION_t *calibration);
+
+/// @brief Sets the offset and gain from two measurements (Ex. the reading with a 0.5V and a 4.5V reference on the input)
+/// @param calibration Calibration to set (The table is turned off)
+/// @param measured1 Value read for the first reference (q15)
+/// @param actual1 Value the first reference should read as (q15)
+/// @param measured2 Value read for the second reference (q15)
+/// @param actual2 Value the second reference should read as (q15)
+/// @return True if the calibration was set, false if the points are the same or the gain is not between 0 and 2^CALIBRATION_MAX_SHIFT
+bool CALIBRATION_SetTwoPoint(CALIBRATION_t *calibration, q15_t measured1, q15_t actual1, q15_t measured2, q15_t actual2);
+
+/// @brief Sets the piecewise linear table applied after the offset and gain
+/// @param calibration Calibration to change
+/// @param table CALIBRATION_TABLE_POINTS outputs at -1.0 + i * 0.125 (Copied), 0 to turn the table off
+void CALIBRATION_SetTable(CALIBRATION_t *calibration, const q15_t *table);
+
+/// @brief Corrects q15 values in place (Ex. an ACDC_ACQUIRE block, ACQUIRE_SetCalibration does this for every block)
+/// @param calibration Calibration to apply
+/// @param values Values to correct
+/// @param count Number of values
+void CALIBRATION_ApplyQ15(const CALIBRATION_t *calibration, q15_t *values, uint32_t count);
+
+/// @brief Corrects a single q15 value
+/// @param calibration Calibration to apply
+/// @param value Value to correct
+/// @return Corrected value
+q15_t CALIBRATION_CorrectQ15(const CALIBRATION_t *calibration, q15_t value);
+
+/// @brief Gets the LTC1451 code that outputs a q15 value after the DAC's calibration (-1.0 = 0V, +1.0 = full scale)
+/// @param calibration Calibration of the DAC
+/// @param value Wanted output (q15)
+/// @return 12-bit code for LTCDAC_SetOutputCS
+uint16_t CALIBRATION_ToDACCode(const CALIBRATION_t *calibration, q15_t value);
+
+/// @brief Reads the calibrations saved in flash
+/// @param set Set to the saved calibrations, or to calibrations that change nothing if none are saved
+/// @return True if saved calibrations were found, false otherwise
+bool CALIBRATION_Load(CALIBRATION_Set_t *set);
+
+/// @brief Erases the calibration flash page and saves set into it (Stop ACQUIRE first, the CPU stalls for ~20ms while the page is erased)
+/// @param set Calibrations to save
+/// @return True if the page was written and reads back correctly, false otherwise
+bool CALIBRATION_Save(const CALIBRATION_Set_t *set);
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @file ACDC_CAPTURE.h
+ * @author Devin Marx
+ * @brief Header file for oscilloscope style triggered capture of ACDC_ACQUIRE blocks
+ *
+ * While armed, every sample is written into a circular buffer so the samples before the trigger are
+ * always available. When the trigger condition is met (A level, edge, or slope on the sampled channel,
+ * or an external EXTI event) the buffer keeps filling until the post-trigger part is full, then freezes.
+ * The frozen window is sent as binary ACDC_TELEMETRY frames.
+ *
+ * @version 0.1
+ * @date 2024-04-21
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_CAPTURE_H
+#define __ACDC_CAPTURE_H
+
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+#include "ACDC_ACQUIRE.h"
+
+typedef enum{
+    CAPTURE_RISING_EDGE,        /**< Sample crosses level going up                              */
+    CAPTURE_FALLING_EDGE,       /**< Sample crosses level going down                            */
+    CAPTURE_ABOVE,              /**< Sample is at or above level                                */
+    CAPTURE_BELOW,              /**< Sample is at or below level                                */
+    CAPTURE_RISING_SLOPE,       /**< Sample rose by at least level since the previous sample    */
+    CAPTURE_FALLING_SLOPE,      /**< Sample fell by at least level since the previous sample    */
+    CAPTURE_EXTERNAL            /**< CAPTURE_TriggerExternal was called (Ex. from an EXTI interrupt) */
+}CAPTURE_TriggerType;
+
+typedef enum{
+    CAPTURE_IDLE,               /**< Not armed, samples are ignored                 */
+    CAPTURE_ARMED,              /**< Filling the pre-trigger history and waiting    */
+    CAPTURE_TRIGGERED,          /**< Filling the post-trigger part                  */
+    CAPTURE_DONE                /**< Window is frozen, ready to read or send        */
+}CAPTURE_State;
+
+typedef struct{
+    q15_t *buffer;                      /**< length samples, oldest first once CAPTURE_DONE          */
+    uint16_t length;                    /**< Samples in the capture window                           */
+    uint16_t preTrigger;                /**< Samples kept from before the trigger                    */
+    uint32_t sampleRate;                /**< Samples per second of the captured samples (Sent to the host) */
+    CAPTURE_TriggerType type;           /**< Trigger condition                                       */
+    q15_t level;                        /**< Level for edges, change per sample for slopes           */
+    volatile CAPTURE_State state;       /**< Current state                                           */
+    uint16_t writeIndex;                /**< Next position in the circular buffer                    */
+    uint16_t history;                   /**< Pre-trigger samples collected since arming              */
+    uint16_t remaining;                 /**< Post-trigger samples still to collect                   */
+    uint16_t triggerIndex;              /**< Position of the trigger sample in the circular buffer   */
+    q15_t previous;                     /**< Last sample, for edges and slopes                       */
+    volatile bool externalPending;      /**< CAPTURE_TriggerExternal was called while armed          */
+    volatile uint32_t externalSample;   /**< ACQUIRE sample number when it was called                */
+    uint32_t triggerSample;             /**< ACQUIRE sample number of the trigger                    */
+    uint16_t captureNumber;             /**< Counts completed captures (Sent to the host)            */
+}CAPTURE_t;
+
+/// @brief Sets up a capture window (Call CAPTURE_SetTrigger and CAPTURE_Arm to start)
+/// @param capture Capture to initialize
+/// @param buffer Buffer of length samples (Must stay valid)
+/// @param length Samples in the capture window (At least 2)
+/// @param sampleRate Samples per second of the blocks that will be added (After any decimation)
+/// @return True if the capture was set up, false if length is too small
+bool CAPTURE_Init(CAPTURE_t *capture, q15_t *buffer, uint16_t length, uint32_t sampleRate);
+
+/// @brief Sets the trigger condition and the pre-trigger depth (Disarms the capture)
+/// @param capture Capture to change
+/// @param CAPTURE_x Trigger condition
+/// @param level Level for edges and levels, smallest change per sample for slopes (q15, ignored for CAPTURE_EXTERNAL)
+/// @param preTrigger Samples to keep from before the trigger (Less than length)
+/// @return True if the trigger was set, false if preTrigger is too large
+bool CAPTURE_SetTrigger(CAPTURE_t *capture, CAPTURE_TriggerType CAPTURE_x, q15_t level, uint16_t preTrigger);
+
+/// @brief Starts filling the pre-trigger history and waiting for the trigger (Call again after a capture to capture again)
+/// @param capture Capture to arm
+void CAPTURE_Arm(CAPTURE_t *capture);
+
+/// @brief Stops waiting for a trigger, any partial capture is thrown away
+/// @param capture Capture to disarm
+void CAPTURE_Disarm(CAPTURE_t *capture);
+
+/// @brief Triggers a CAPTURE_EXTERNAL capture on the sample being taken now (Call from the EXTI interrupt)
+/// @param capture Capture to trigger
+void CAPTURE_TriggerExternal(CAPTURE_t *capture);
+
+/// @brief Runs the samples of a block through the capture
+/// @param capture Capture
+/// @param block Block from ACQUIRE_GetBlock
+/// @return True if the capture finished during this block, false otherwise
+bool CAPTURE_AddBlock(CAPTURE_t *capture, const ACQUIRE_Block_t *block);
+
+/// @brief Gets the state of the capture
+/// @param capture Capture
+/// @return Current state
+CAPTURE_State CAPTURE_GetState(const CAPTURE_t *capture);
+
+/// @brief Gets the frozen window (Only valid in CAPTURE_DONE)
+/// @param capture Capture
+/// @return length samples, oldest first. The trigger sample is at index preTrigger
+const q15_t* CAPTURE_GetSamples(const CAPTURE_t *capture);
+
+/// @brief Sends the frozen window as TELEMETRY_CAPTURE_DATA frames (Waits for each frame to start sending)
+/// @param capture Capture in CAPTURE_DONE
+/// @return True if every frame was sent, false if the capture is not done or a frame was dropped
+bool CAPTURE_Send(const CAPTURE_t *capture);
+
+#endif
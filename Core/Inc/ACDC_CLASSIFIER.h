@@ -0,0 +1,108 @@
+/**
+ * @file ACDC_CLASSIFIER.h
+ * @author Devin Marx
+ * @brief Header file for the CMSIS-NN waveform classifier
+ *
+ * Samples are collected into windows of windowSize samples. Each window is turned into inputSize q7 features
+ * (The mean of every windowSize / inputSize samples, with the mean of the window removed) and run through a
+ * small fully connected network with arm_fully_connected_q7 and arm_relu_q7. The last layer gives one score
+ * per class, so only the class (Ex. a fault signature) has to be reported instead of the samples.
+ * The weights are const q7 arrays in flash, written by Python_Helper/CLASSIFIER_Helper.py.
+ *
+ * @version 0.1
+ * @date 2024-04-24
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_CLASSIFIER_H
+#define __ACDC_CLASSIFIER_H
+
+#include "arm_math.h"
+#include "arm_nnfunctions.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+#include "ACDC_ACQUIRE.h"
+
+#define CLASSIFIER_MAX_WIDTH    64  /**< Most inputs or outputs of a layer (Sizes the buffers in CLASSIFIER_t)  */
+#define CLASSIFIER_MAX_CLASSES  16  /**< Most outputs of the last layer                                        */
+
+typedef struct{
+    const q7_t *weights;        /**< outputSize x inputSize weights, one row per output              */
+    const q7_t *bias;           /**< outputSize biases                                               */
+    uint16_t inputSize;         /**< Inputs (Outputs of the previous layer, or the features)         */
+    uint16_t outputSize;        /**< Outputs                                                         */
+    uint8_t biasShift;          /**< Left shift of the bias (arm_fully_connected_q7 bias_shift)      */
+    uint8_t outShift;           /**< Right shift of the output (arm_fully_connected_q7 out_shift, at least 1) */
+    bool relu;                  /**< Run arm_relu_q7 on the outputs (Hidden layers)                  */
+}CLASSIFIER_Layer_t;
+
+typedef struct{
+    const CLASSIFIER_Layer_t *layers;   /**< layerCount layers, the first one takes the features          */
+    uint8_t layerCount;                 /**< Number of layers                                              */
+    uint16_t windowSize;                /**< Samples per window (Power of 2, a multiple of inputSize)      */
+    uint16_t inputSize;                 /**< Features per window (Power of 2)                              */
+    uint8_t inputShift;                 /**< Right shift that turns a q15 feature into q7                  */
+    const char * const *classNames;     /**< Name of every class (Ex. for printing the result)             */
+}CLASSIFIER_Network_t;
+
+typedef struct{
+    uint32_t firstSample;                   /**< ACQUIRE sample number of the window's first sample     */
+    uint32_t timestamp;                     /**< Micros() of the window's first sample                  */
+    uint8_t classIndex;                     /**< Class with the largest output                          */
+    uint8_t classCount;                     /**< Number of classes                                      */
+    q7_t scores[CLASSIFIER_MAX_CLASSES];    /**< arm_softmax_q7 of the outputs (128 is 100%)            */
+}CLASSIFIER_Result_t;
+
+typedef struct{
+    const CLASSIFIER_Network_t *network;            /**< Network the windows are run through             */
+    uint8_t groupShift;                             /**< log2(windowSize / inputSize)                    */
+    uint8_t meanShift;                              /**< log2(inputSize)                                 */
+    uint16_t groupCount;                            /**< Samples added to the current feature            */
+    uint16_t featureCount;                          /**< Features finished in the current window         */
+    int32_t sum;                                    /**< Sum of the samples of the current feature       */
+    int32_t featureSum;                             /**< Sum of the finished features                    */
+    uint32_t firstSample;                           /**< ACQUIRE sample number of the current window     */
+    uint32_t timestamp;                             /**< Micros() of the current window                  */
+    q15_t features[CLASSIFIER_MAX_WIDTH];           /**< Feature means of the current window (q15)       */
+    q7_t activations[2][CLASSIFIER_MAX_WIDTH];      /**< Layer inputs and outputs (Swapped every layer)  */
+    q15_t vecBuffer[CLASSIFIER_MAX_WIDTH];          /**< Scratch for arm_fully_connected_q7              */
+    CLASSIFIER_Result_t result;                     /**< Result of the last window                       */
+}CLASSIFIER_t;
+
+/// @brief Default network written by Python_Helper/CLASSIFIER_Helper.py (ACDC_CLASSIFIER_WEIGHTS.c)
+extern const CLASSIFIER_Network_t CLASSIFIER_DefaultNetwork;
+
+/// @brief Sets up a classifier and checks that the network fits
+/// @param classifier Classifier to initialize
+/// @param network Network to run (Must stay valid, Ex. &CLASSIFIER_DefaultNetwork)
+/// @return True if the classifier was set up, false if the network is not supported
+bool CLASSIFIER_Init(CLASSIFIER_t *classifier, const CLASSIFIER_Network_t *network);
+
+/// @brief Adds the samples of a block to the window, classifying the window every time it fills up
+/// @param classifier Classifier
+/// @param block Block from ACQUIRE_GetBlock
+/// @return True if a window was classified during this block (The result of the last one is kept), false otherwise
+bool CLASSIFIER_AddBlock(CLASSIFIER_t *classifier, const ACQUIRE_Block_t *block);
+
+/// @brief Runs q7 features through the network (Skips the window, Ex. for features made somewhere else)
+/// @param classifier Classifier
+/// @param features inputSize q7 features
+/// @return Class with the largest output (The full result is in CLASSIFIER_GetResult)
+uint8_t CLASSIFIER_Run(CLASSIFIER_t *classifier, const q7_t *features);
+
+/// @brief Gets the result of the last classified window
+/// @param classifier Classifier
+/// @return Last result (firstSample and timestamp are 0 after CLASSIFIER_Run)
+const CLASSIFIER_Result_t* CLASSIFIER_GetResult(const CLASSIFIER_t *classifier);
+
+/// @brief Throws away the current window (The last result is kept)
+/// @param classifier Classifier
+void CLASSIFIER_Reset(CLASSIFIER_t *classifier);
+
+/// @brief Sends the last result as a TELEMETRY_CLASSIFIER_EVENT frame
+/// @param classifier Classifier
+/// @return True if the frame was sent, false otherwise
+bool CLASSIFIER_SendResult(const CLASSIFIER_t *classifier);
+
+#endif
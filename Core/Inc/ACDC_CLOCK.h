@@ -78,6 +78,7 @@ typedef enum{   /* APBx Clock Prescaler */
 }APB_Prescaler;    
 
 /// @brief Sets the SYSCLK speed, and sets the perepherals to their fastest speed available
+///        (Thread-safe build: other threads are held off while it runs, but baud rates set before are not recalculated)
 /// @param SCS_x System Clock Speed (Ex. SCS_72Mhz, SCS_36Mhz, ...)
 void CLOCK_SetSystemClockSpeed(SystemClockSpeed SCS_x);
 
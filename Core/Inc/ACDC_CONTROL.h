@@ -0,0 +1,116 @@
+/**
+ * @file ACDC_CONTROL.h
+ * @author Devin Marx
+ * @brief Header file for the fixed rate PID control loop (LTC1298 input, LTC1451 or PWM output)
+ *
+ * A timer tick starts a background LTC1298 conversion. When the sample arrives in the SPI interrupt the
+ * error is run through arm_pid_q15 and the output is written to the LTC1451 DAC or a PWM channel right
+ * away, so every step takes the same path no matter what the main loop is doing. Tick jitter and tick to
+ * output latency are measured with the DWT cycle counter. Gains can be changed while the loop is running,
+ * including from text commands received over USART (CONTROL_HandleCommand).
+ *
+ * @version 0.1
+ * @date 2024-04-19
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_CONTROL_H
+#define __ACDC_CONTROL_H
+
+#include "stm32f1xx.h"
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+#include "ACDC_string.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_LTC1298_ADC.h"
+#include "ACDC_LTC1451_DAC.h"
+
+#define CONTROL_MAX_RATE   4000     /**< Each step waits on a ~230us LTC1298 conversion (Same limit as ACDC_ACQUIRE) */
+#define CONTROL_MAX_SHIFT  8        /**< Largest gain shift, gains can be scaled up to 256x                        */
+
+typedef enum{
+    CONTROL_CH0,    /**< Measure channel 0 of the LTC1298 */
+    CONTROL_CH1     /**< Measure channel 1 of the LTC1298 */
+}CONTROL_Channel;
+
+typedef struct{
+    uint32_t steps;             /**< Steps completed                                                    */
+    uint32_t missedSteps;       /**< Ticks skipped because the previous conversion was still running   */
+    uint32_t maxJitterCycles;   /**< Largest difference between a tick period and the set period       */
+    uint32_t minLatencyCycles;  /**< Fastest tick to output write                                       */
+    uint32_t maxLatencyCycles;  /**< Slowest tick to output write                                       */
+    uint32_t maxComputeCycles;  /**< Slowest sample to output write (PID step and output only)          */
+}CONTROL_Stats_t;
+
+/// @brief Sets up a control loop measuring one LTC1298 channel (Set an output, then call CONTROL_Start)
+/// @param LTC_ADC ADC returned by LTCADC_InitCS
+/// @param CONTROL_CHx Channel of the ADC to measure
+/// @param TIMx Timer that sets the loop rate (Ex. TIM2, TIM3, TIM4), do not use it for anything else
+/// @param rate Steps per second (Up to CONTROL_MAX_RATE)
+/// @return True if the loop was set up, false if rate is not supported
+bool CONTROL_Init(LTC1298_t LTC_ADC, CONTROL_Channel CONTROL_CHx, TIM_TypeDef *TIMx, uint32_t rate);
+
+/// @brief Writes the output of every step to the LTC1451 DAC (-1.0 = 0V, +1.0 = 4.095V)
+///        Put the DAC on a different SPI than the ADC, they need different clock speeds
+/// @param LTC_DAC DAC returned by LTCDAC_InitCS
+void CONTROL_SetOutputDAC(LTC1451_t LTC_DAC);
+
+/// @brief Writes the output of every step as a PWM duty cycle (-1.0 = 0%, +1.0 = 100%)
+/// @param TIMx_CHx_Pxx PWM channel set up with TIMER_PWM_Init (Must not be on the loop's timer)
+void CONTROL_SetOutputPWM(TIMx_CHx TIMx_CHx_Pxx);
+
+/// @brief Sets the PID gains (Safe to call while the loop is running, the new gains are used from the next step)
+///        The error is multiplied by 2^shift before the PID, so the effective gains are kp, ki, kd * 2^shift
+/// @param kp Proportional gain (q15)
+/// @param ki Integral gain per step (q15)
+/// @param kd Derivative gain per step (q15)
+/// @param shift Bits to scale the error up by (0 - CONTROL_MAX_SHIFT). kp + ki + 2 * kd must stay below 1.0
+/// @return True if the gains were set, false if shift is too large
+bool CONTROL_SetGains(q15_t kp, q15_t ki, q15_t kd, uint8_t shift);
+
+/// @brief Limits the output. When the output hits a limit the integral stops growing (Anti-windup)
+/// @param min Smallest output (q15)
+/// @param max Largest output (q15)
+/// @return True if the limits were set, false if min is above max
+bool CONTROL_SetLimits(q15_t min, q15_t max);
+
+/// @brief Sets the value the loop drives the measurement to
+/// @param setpoint Target in the same scale as DSP_SamplesToQ15 (-1.0 = 0V, +1.0 = Vref)
+void CONTROL_SetSetpoint(q15_t setpoint);
+
+/// @brief Clears the PID state and the statistics, then starts the timer
+/// @return True if the loop started, false if CONTROL_Init or an output was not set up
+bool CONTROL_Start(void);
+
+/// @brief Stops the timer and waits up to 5ms for the last step to finish (The output keeps its last value)
+void CONTROL_Stop(void);
+
+/// @brief Gets the measurement used by the last step
+/// @return Last measurement (q15)
+q15_t CONTROL_GetInput(void);
+
+/// @brief Gets the output written by the last step
+/// @return Last output (q15)
+q15_t CONTROL_GetOutput(void);
+
+/// @brief Copies the loop statistics (Cycles are core clock cycles, divide by 72 for microseconds at 72MHz)
+/// @param stats Struct to copy the statistics into
+void CONTROL_GetStats(CONTROL_Stats_t *stats);
+
+/// @brief Clears the loop statistics
+void CONTROL_ResetStats(void);
+
+/// @brief Runs a text command, meant for lines received over USART. Values are decimal (Ex. "kp 0.25")
+///        kp <value>, ki <value>, kd <value>, shift <bits>, sp <value>, min <value>, max <value>
+/// @param command Null terminated command
+/// @return True if the command was understood and applied, false otherwise
+bool CONTROL_HandleCommand(const char *command);
+
+/// @brief Appends the gains, setpoint, and statistics as a single line of text
+/// @param sb StringBuilder to append to
+/// @return True if everything fit, false if sb was truncated
+bool CONTROL_AppendStatus(StringBuilder *sb);
+
+#endif
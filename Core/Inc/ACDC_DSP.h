@@ -0,0 +1,69 @@
+/**
+ * @file ACDC_DSP.h
+ * @author Devin Marx
+ * @brief Header file for handing LTC1298 samples to the CMSIS-DSP library
+ *
+ * The LTC1298 returns 12-bit unsigned samples (0 = 0V, 4095 = Vref). CMSIS-DSP works on signed
+ * fixed point, so the samples are centered on mid-scale and scaled to full range:
+ * 0V -> -1.0, Vref / 2 -> 0.0, Vref -> +1.0 (Minus 1 LSB)
+ *
+ * @version 0.1
+ * @date 2024-04-11
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_DSP_H
+#define __ACDC_DSP_H
+
+#include "stm32f1xx.h"
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_LTC1298_ADC.h"
+
+#define DSP_LTC1298_BITS     12     /**< Resolution of the LTC1298 in bits            */
+#define DSP_LTC1298_MIDSCALE 2048   /**< Sample value at Vref / 2 (Converted to 0.0)  */
+
+/// @brief Converts 12-bit LTC1298 samples to q15 (Safe to use in place, samples and output can be the same buffer)
+/// @param samples 12-bit samples from the LTC1298
+/// @param output Buffer to store the q15 values in (Must hold at least count values)
+/// @param count Number of samples to convert
+void DSP_SamplesToQ15(const uint16_t *samples, q15_t *output, uint32_t count);
+
+/// @brief Converts 12-bit LTC1298 samples to q31
+/// @param samples 12-bit samples from the LTC1298
+/// @param output Buffer to store the q31 values in (Must hold at least count values)
+/// @param count Number of samples to convert
+void DSP_SamplesToQ31(const uint16_t *samples, q31_t *output, uint32_t count);
+
+/// @brief Reads count samples from channel 0 of the ADC and converts them to q15 in place
+/// @param LTC_ADC Struct containing configuration data for the ADC
+/// @param output Buffer to store the q15 values in (Must hold at least count values)
+/// @param count Number of samples to read
+void DSP_ReadBlockCH0Q15(LTC1298_t LTC_ADC, q15_t *output, uint16_t count);
+
+/// @brief Reads count samples from channel 1 of the ADC and converts them to q15 in place
+/// @param LTC_ADC Struct containing configuration data for the ADC
+/// @param output Buffer to store the q15 values in (Must hold at least count values)
+/// @param count Number of samples to read
+void DSP_ReadBlockCH1Q15(LTC1298_t LTC_ADC, q15_t *output, uint16_t count);
+
+/// @brief Calculates the mean of a block of q15 values (arm_mean_q15)
+/// @param block Block of q15 values
+/// @param count Number of values in block
+/// @return Mean of the block
+q15_t DSP_MeanQ15(const q15_t *block, uint32_t count);
+
+/// @brief Calculates the root mean square of a block of q15 values (arm_rms_q15)
+/// @param block Block of q15 values
+/// @param count Number of values in block
+/// @return Root mean square of the block
+q15_t DSP_RmsQ15(const q15_t *block, uint32_t count);
+
+/// @brief Converts a q15 value made by DSP_SamplesToQ15 back to millivolts at the ADC input
+/// @param value q15 value (-1.0 = 0V, +1.0 = Vref)
+/// @param vrefMillivolts Reference voltage of the LTC1298 in millivolts (Vcc, Ex. 5000)
+/// @return Voltage in millivolts
+int32_t DSP_Q15ToMillivolts(q15_t value, uint32_t vrefMillivolts);
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file ACDC_FAULT.h
+ * @author Devin Marx
+ * @brief Header file for the crash dumps of the fault handlers
+ *
+ * ACDC_FAULT replaces the empty HardFault, MemManage, BusFault, and UsageFault handlers. On a fault the registers the
+ * core stacked, the fault status registers (CFSR, HFSR, MMFAR, BFAR), and the code addresses found in a shallow scan
+ * of the stack are saved to a record in the .noinit RAM section, which the startup code neither clears nor loads.
+ * The core then resets (Or stops at a breakpoint when a debugger is attached). FAULT_Report prints the record at the
+ * next boot, and Python_Helper/FAULT_Helper.py turns it into function names and lines with the ELF.
+ *
+ * @version 0.1
+ * @date 2024-04-30
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_FAULT_H
+#define __ACDC_FAULT_H
+
+#include "stm32f1xx.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define FAULT_BACKTRACE_DEPTH   8       /**< Code addresses kept from the stack scan                     */
+#define FAULT_SCAN_WORDS        256     /**< Stack words scanned above the fault (Stops at the stack top) */
+
+typedef struct{
+    uint32_t magic;             /**< FAULT_MAGIC when the record holds a crash                                      */
+    uint32_t exception;         /**< Exception number (3 HardFault, 4 MemManage, 5 BusFault, 6 UsageFault)          */
+    uint32_t count;             /**< Faults since the record was last reported (Only the first one is kept)         */
+    uint32_t uptime;            /**< Millis() when the fault happened                                               */
+    uint32_t r0;                /**< Registers stacked by the core (0 if the stack could not be read)               */
+    uint32_t r1;
+    uint32_t r2;
+    uint32_t r3;
+    uint32_t r12;
+    uint32_t lr;                /**< Return address of the function that faulted                                    */
+    uint32_t pc;                /**< Instruction that faulted (Or the one after it for imprecise bus faults)        */
+    uint32_t xpsr;
+    uint32_t sp;                /**< Stack pointer before the fault                                                 */
+    uint32_t excReturn;         /**< EXC_RETURN of the handler (0xFFFFFFFD if a thread on PSP faulted)               */
+    uint32_t cfsr;              /**< Configurable Fault Status Register (MMFSR, BFSR, UFSR)                         */
+    uint32_t hfsr;              /**< HardFault Status Register                                                      */
+    uint32_t mmfar;             /**< MemManage fault address (Valid if CFSR MMARVALID is set)                       */
+    uint32_t bfar;              /**< Bus fault address (Valid if CFSR BFARVALID is set)                             */
+    uint32_t backtraceDepth;    /**< Addresses in backtrace                                                         */
+    uint32_t backtrace[FAULT_BACKTRACE_DEPTH]; /**< Return addresses found on the stack, innermost first             */
+    uint32_t check;             /**< Checksum of the words above (Tells a record from random RAM at power up)       */
+}FAULT_Record_t;
+
+typedef void (*FaultCallback)(const FAULT_Record_t *record);
+
+/// @brief Enables the MemManage, BusFault, and UsageFault exceptions (Otherwise they all escalate to HardFault)
+/// @param callback Called by the fault handler after the record is saved, before the reset (Ex. to TRACE_Dump). NULL for none
+void FAULT_Init(FaultCallback callback);
+
+/// @brief Gets the crash record saved before the last reset
+/// @return Record, NULL if there was no fault since it was last cleared
+const FAULT_Record_t *FAULT_GetRecord(void);
+
+/// @brief Clears the crash record so the next fault is saved (FAULT_Report does this)
+void FAULT_Clear(void);
+
+/// @brief Prints the crash record as FAULT lines for FAULT_Helper.py and clears it (Blocking, call once at boot)
+/// @param USARTx USART Peripheral to print to (Ex. USART1, USART2, ...)
+/// @return True if there was a record to print
+bool FAULT_Report(USART_TypeDef *USARTx);
+
+#endif
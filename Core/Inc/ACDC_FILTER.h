@@ -0,0 +1,85 @@
+/**
+ * @file ACDC_FILTER.h
+ * @author Devin Marx
+ * @brief Header file for the q15 filtering pipeline (FIR, biquad IIR, and decimating FIR stages)
+ *
+ * A pipeline is a list of CMSIS-DSP filter stages that run one after another on the same block.
+ * Every stage works in place, so a block from ACDC_ACQUIRE is filtered without copying it.
+ * Decimating stages shrink the block, later stages are set up for the smaller block size.
+ *
+ * @version 0.1
+ * @date 2024-04-15
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_FILTER_H
+#define __ACDC_FILTER_H
+
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define FILTER_MAX_STAGES 4     /**< Maximum number of stages in a pipeline */
+
+typedef enum{
+    FILTER_STAGE_FIR,           /**< arm_fir_fast_q15                */
+    FILTER_STAGE_BIQUAD,        /**< arm_biquad_cascade_df1_fast_q15 */
+    FILTER_STAGE_DECIMATE       /**< arm_fir_decimate_q15            */
+}FILTER_StageType;
+
+typedef struct{
+    FILTER_StageType type;                          /**< Which CMSIS-DSP kernel runs this stage */
+    uint32_t blockSize;                             /**< Samples handed to this stage           */
+    union{
+        arm_fir_instance_q15 fir;
+        arm_biquad_casd_df1_inst_q15 biquad;
+        arm_fir_decimate_instance_q15 decimate;
+    }instance;                                      /**< CMSIS-DSP instance for type            */
+}FILTER_Stage_t;
+
+typedef struct{
+    FILTER_Stage_t stages[FILTER_MAX_STAGES];       /**< Stages in the order they are run        */
+    uint8_t count;                                  /**< Number of stages added                  */
+    uint32_t blockSize;                             /**< Samples in each block given to the pipeline */
+    uint32_t outputSize;                            /**< Samples left in the block after the last stage */
+}FILTER_Pipeline_t;
+
+/// @brief Clears a pipeline so stages can be added to it
+/// @param pipeline Pipeline to initialize
+/// @param blockSize Number of samples in every block that will be processed
+void FILTER_Init(FILTER_Pipeline_t *pipeline, uint32_t blockSize);
+
+/// @brief Adds a FIR stage (arm_fir_fast_q15, 32-bit accumulator, scale the input down by log2(numTaps) bits to avoid wrap around)
+/// @param pipeline Pipeline to add the stage to
+/// @param coefficients numTaps coefficients in time reversed order (Must stay valid while the pipeline is used)
+/// @param numTaps Number of coefficients
+/// @param state Buffer of numTaps + blockSize - 1 values, blockSize being the block size at this stage (Must stay valid)
+/// @return True if the stage was added, false if the pipeline is full or the arguments are invalid
+bool FILTER_AddFIR(FILTER_Pipeline_t *pipeline, const q15_t *coefficients, uint16_t numTaps, q15_t *state);
+
+/// @brief Adds a cascade of biquad IIR sections (arm_biquad_cascade_df1_fast_q15, keep the input in [-0.25, +0.25) to avoid wrap around)
+/// @param pipeline Pipeline to add the stage to
+/// @param coefficients 6 values per section {b0, 0, b1, b2, a1, a2} scaled by 2^-postShift (Must stay valid while the pipeline is used)
+/// @param numSections Number of 2nd order sections
+/// @param state Buffer of 4 * numSections values (Must stay valid)
+/// @param postShift Bits the coefficients were scaled down by (1 allows coefficients in [-2, +2))
+/// @return True if the stage was added, false if the pipeline is full or the arguments are invalid
+bool FILTER_AddBiquad(FILTER_Pipeline_t *pipeline, const q15_t *coefficients, uint8_t numSections, q15_t *state, int8_t postShift);
+
+/// @brief Adds a low pass FIR that keeps every factor'th sample (arm_fir_decimate_q15). Later stages see blockSize / factor samples
+/// @param pipeline Pipeline to add the stage to
+/// @param coefficients numTaps anti-aliasing coefficients in time reversed order (Must stay valid while the pipeline is used)
+/// @param numTaps Number of coefficients
+/// @param factor Decimation factor (The block size at this stage must be a multiple of it)
+/// @param state Buffer of numTaps + blockSize - 1 values, blockSize being the block size at this stage (Must stay valid)
+/// @return True if the stage was added, false if the pipeline is full or the arguments are invalid
+bool FILTER_AddDecimator(FILTER_Pipeline_t *pipeline, const q15_t *coefficients, uint16_t numTaps, uint8_t factor, q15_t *state);
+
+/// @brief Runs every stage of the pipeline on block in place
+/// @param pipeline Pipeline to run
+/// @param block pipeline->blockSize samples, overwritten with the filtered samples
+/// @return Number of filtered samples at the start of block (pipeline->outputSize)
+uint32_t FILTER_Process(FILTER_Pipeline_t *pipeline, q15_t *block);
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file ACDC_GOERTZEL.h
+ * @author Devin Marx
+ * @brief Header file for the Goertzel tone detector bank
+ *
+ * Each tone is a Goertzel resonator fed q15 samples with a q31 state. Samples are added block by block
+ * (Ex. every ACDC_ACQUIRE block), so the work is spread evenly instead of landing on the end of a window.
+ * Every windowSize samples the level of each tone is checked against its threshold, and the callback is
+ * called when a tone starts or stops being detected.
+ *
+ * @version 0.1
+ * @date 2024-04-18
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_GOERTZEL_H
+#define __ACDC_GOERTZEL_H
+
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define GOERTZEL_MAX_TONES  8       /**< Tones in a single bank                                              */
+#define GOERTZEL_MAX_WINDOW 512     /**< Largest window, a full scale tone 1 bin above DC still fits the q31 state */
+
+/// @brief Called when a tone starts or stops being detected
+/// @param tone Index of the tone (Order it was added in)
+/// @param detected True if the tone was just detected, false if it just went away
+/// @param level Level of the tone over the last window
+typedef void (*GOERTZEL_Callback)(uint8_t tone, bool detected, q15_t level);
+
+typedef struct{
+    uint32_t frequency;             /**< Frequency of the tone in Hz                          */
+    q15_t coefficient;              /**< cos(2 * pi * frequency / sampleRate) (2cos in Q2.14)  */
+    q15_t threshold;                /**< Level the tone is detected at                         */
+    q31_t s1;                       /**< Resonator output 1 sample ago                         */
+    q31_t s2;                       /**< Resonator output 2 samples ago                        */
+    q15_t level;                    /**< Level over the last window                            */
+    bool detected;                  /**< Tone is currently detected                            */
+}GOERTZEL_Tone_t;
+
+typedef struct{
+    GOERTZEL_Tone_t tones[GOERTZEL_MAX_TONES];  /**< Tones in the order they were added    */
+    uint8_t count;                              /**< Number of tones added                 */
+    uint16_t windowSize;                        /**< Samples per detection window (N)      */
+    uint16_t sampleCount;                       /**< Samples added to the current window   */
+    uint32_t sampleRate;                        /**< Samples per second                    */
+    GOERTZEL_Callback callback;                 /**< Called on detection changes, or 0     */
+}GOERTZEL_Bank_t;
+
+/// @brief Clears a bank so tones can be added to it
+/// @param bank Bank to initialize
+/// @param sampleRate Samples per second of the samples that will be added
+/// @param windowSize Samples per detection window (Up to GOERTZEL_MAX_WINDOW, bandwidth is about sampleRate / windowSize)
+/// @param callback Function called when a tone starts or stops being detected (0 for none)
+/// @return True if the bank was set up, false if windowSize is not supported
+bool GOERTZEL_Init(GOERTZEL_Bank_t *bank, uint32_t sampleRate, uint16_t windowSize, GOERTZEL_Callback callback);
+
+/// @brief Adds a tone to detect
+/// @param bank Bank to add the tone to
+/// @param frequency Frequency of the tone in Hz (At least 1 bin, sampleRate / windowSize, away from DC and sampleRate / 2)
+/// @param threshold Level the tone is detected at (A full scale sine on its bin reads 32767).
+///                  It stops being detected below 3/4 of the threshold
+/// @return True if the tone was added, false if the bank is full or frequency is out of range
+bool GOERTZEL_AddTone(GOERTZEL_Bank_t *bank, uint32_t frequency, q15_t threshold);
+
+/// @brief Runs samples through every tone, checking the thresholds each time a window completes
+/// @param bank Bank to run
+/// @param samples q15 samples (Ex. an ACDC_ACQUIRE block)
+/// @param count Number of samples (Does not have to line up with the window)
+/// @return True if at least one window completed, false otherwise
+bool GOERTZEL_AddSamples(GOERTZEL_Bank_t *bank, const q15_t *samples, uint32_t count);
+
+/// @brief Gets the level of a tone over the last completed window
+/// @param bank Bank the tone is in
+/// @param tone Index of the tone
+/// @return Amplitude of the tone (q15), 0 if tone does not exist
+q15_t GOERTZEL_GetLevel(const GOERTZEL_Bank_t *bank, uint8_t tone);
+
+/// @brief Checks if a tone is currently detected
+/// @param bank Bank the tone is in
+/// @param tone Index of the tone
+/// @return True if the tone is detected, false otherwise
+bool GOERTZEL_IsDetected(const GOERTZEL_Bank_t *bank, uint8_t tone);
+
+/// @brief Throws away the current window and clears every detection (No callbacks are called)
+/// @param bank Bank to reset
+void GOERTZEL_Reset(GOERTZEL_Bank_t *bank);
+
+#endif
@@ -12,6 +12,7 @@
 
 #include "stm32f1xx.h"
 #include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
 
 typedef struct {
     SPI_TypeDef *SPIx;          /**< SPI Peripheral to be used for the LTC1298 ADC */
@@ -19,6 +20,10 @@ typedef struct {
     uint16_t GPIO_PIN_CS;       /**< GPIO pin for SPI'x CS                         */
 }LTC1298_t;
 
+/// @brief Function called from the SPI interrupt when a background conversion is done
+/// @param sample 12-bit sample read from the ADC
+typedef void (*LTCADC_Callback)(uint16_t sample);
+
 /// @brief Initiliazes SPIx and the external LTC1298IS8 ADC. Also sets up the software CS pin for SPIx
 /// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
 /// @param GPIOx GPIO Port for the chip select pin (Ex. GPIOA, GPIOB, ...)
@@ -36,4 +41,34 @@ uint16_t LTCADC_ReadCH0CS(LTC1298_t LTC_ADC);
 /// @return 12-bits of data representing the ADC's input on channel 1
 uint16_t LTCADC_ReadCH1CS(LTC1298_t LTC_ADC);
 
+/// @brief Reads count back to back samples from channel 0 into buffer (Software CS)
+/// @param LTC_ADC Struct containing configuration data for the ADC
+/// @param buffer Buffer to store the 12-bit samples in (Must hold at least count samples)
+/// @param count Number of samples to read
+void LTCADC_ReadBlockCH0CS(LTC1298_t LTC_ADC, uint16_t *buffer, uint16_t count);
+
+/// @brief Reads count back to back samples from channel 1 into buffer (Software CS)
+/// @param LTC_ADC Struct containing configuration data for the ADC
+/// @param buffer Buffer to store the 12-bit samples in (Must hold at least count samples)
+/// @param count Number of samples to read
+void LTCADC_ReadBlockCH1CS(LTC1298_t LTC_ADC, uint16_t *buffer, uint16_t count);
+
+/// @brief Starts reading channel 0 in the background and returns without waiting (NON-BLOCKING, Software CS)
+///        The blocking LTCADC read functions must not be used on the same SPI while a read is in progress.
+/// @param LTC_ADC Struct containing configuration data for the ADC
+/// @param callback Called from the SPI interrupt with the sample once the conversion is done
+/// @return True if the read was started, false if the previous background read has not finished (Or, in the thread-safe build, a thread holds the SPI)
+bool LTCADC_StartReadCH0CS(LTC1298_t LTC_ADC, LTCADC_Callback callback);
+
+/// @brief Starts reading channel 1 in the background and returns without waiting (NON-BLOCKING, Software CS)
+///        The blocking LTCADC read functions must not be used on the same SPI while a read is in progress.
+/// @param LTC_ADC Struct containing configuration data for the ADC
+/// @param callback Called from the SPI interrupt with the sample once the conversion is done
+/// @return True if the read was started, false if the previous background read has not finished (Or, in the thread-safe build, a thread holds the SPI)
+bool LTCADC_StartReadCH1CS(LTC1298_t LTC_ADC, LTCADC_Callback callback);
+
+/// @brief Checks if a background read started by LTCADC_StartReadCHxCS is still in progress
+/// @return True if the read has not finished, false otherwise
+bool LTCADC_IsReading(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+ * @file ACDC_POOL.h
+ * @author Devin Marx
+ * @brief Header file for the fixed-block memory pools
+ *
+ * A pool hands out blocks of one size from a static array, so packets, sample blocks, and log records can share RAM
+ * without a heap and without fragmenting. Free blocks are kept in a list threaded through the blocks themselves:
+ * allocating takes the first one and freeing puts it back, both O(1) and lock-free (LDREX/STREX), so they can be called
+ * from interrupts of any priority. Pools registered by POOL_Init also act as size classes: POOL_Alloc picks the
+ * smallest block that fits and moves up to the next size when a pool is empty.
+ * Every pool counts its allocations, failures, and the most blocks it ever had out at once (High-water mark).
+ *
+ * @version 0.1
+ * @date 2024-04-28
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_POOL_H
+#define __ACDC_POOL_H
+
+#include "stm32f1xx.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define POOL_MAX_POOLS  8       /**< Pools POOL_Alloc and POOL_Free search (Size classes)             */
+#define POOL_ALIGNMENT  8       /**< Every block starts on an 8 byte boundary (Safe for uint64_t/q63) */
+
+/// @brief Block size a pool really uses (Rounded up to POOL_ALIGNMENT)
+#define POOL_BLOCK_SIZE(blockSize) (((blockSize) + POOL_ALIGNMENT - 1) & ~(POOL_ALIGNMENT - 1))
+
+/// @brief Declares the aligned storage of a pool (Ex. static POOL_MEMORY(PacketMemory, 64, 16);)
+#define POOL_MEMORY(name, blockSize, blockCount) uint64_t name[POOL_BLOCK_SIZE(blockSize) / 8 * (blockCount)]
+
+typedef struct{
+    volatile uint32_t freeList; /**< Address of the first free block (0 when every block is out)   */
+    uint8_t *memory;            /**< First block                                                    */
+    const char *name;           /**< Name printed by POOL_Report (Must not contain commas)          */
+    uint16_t blockSize;         /**< Bytes per block (Multiple of POOL_ALIGNMENT)                   */
+    uint16_t blockCount;        /**< Blocks in the pool                                             */
+    volatile uint32_t used;     /**< Blocks allocated right now                                     */
+    volatile uint32_t highWater;/**< Most blocks allocated at once                                  */
+    volatile uint32_t allocs;   /**< Successful allocations                                         */
+    volatile uint32_t failures; /**< Allocations that got no block (See POOL_Stats_t)               */
+}POOL_t;
+
+typedef struct{
+    const char *name;           /**< Name given to POOL_Init                                        */
+    uint16_t blockSize;         /**< Bytes per block                                                */
+    uint16_t blockCount;        /**< Blocks in the pool                                             */
+    uint32_t used;              /**< Blocks allocated right now                                     */
+    uint32_t highWater;         /**< Most blocks allocated at once (Size the pool from this)        */
+    uint32_t allocs;            /**< Successful allocations                                         */
+    uint32_t failures;          /**< Allocations that got no block (POOL_Alloc counts one on the smallest pool that fits) */
+}POOL_Stats_t;
+
+/// @brief Sets up a pool over memory and registers it as a size class for POOL_Alloc (Main context, before it is used)
+/// @param pool Pool to set up
+/// @param name Name used in reports (Must stay valid)
+/// @param memory Storage declared with POOL_MEMORY (At least POOL_BLOCK_SIZE(blockSize) * blockCount bytes, 8 byte aligned)
+/// @param blockSize Bytes per block (Rounded up to POOL_ALIGNMENT)
+/// @param blockCount Blocks in the pool
+/// @return True if the pool was set up and registered, false if the arguments are invalid or POOL_MAX_POOLS are
+///         registered already (The pool still works with POOL_AllocFrom and POOL_FreeTo if only the table is full)
+bool POOL_Init(POOL_t *pool, const char *name, void *memory, uint16_t blockSize, uint16_t blockCount);
+
+/// @brief Takes a block from a pool (O(1), safe from interrupts of any priority)
+/// @param pool Pool to take from
+/// @return Block of pool->blockSize bytes (Contents undefined), NULL if the pool is empty (Counted as a failure)
+void *POOL_AllocFrom(POOL_t *pool);
+
+/// @brief Gives a block back to the pool it came from (O(1), safe from interrupts of any priority)
+/// @param pool Pool the block was taken from
+/// @param block Block from POOL_AllocFrom or POOL_Alloc (Must not be used afterwards or freed twice)
+void POOL_FreeTo(POOL_t *pool, void *block);
+
+/// @brief Takes a block of at least size bytes from the smallest registered pool that has one (Safe from interrupts)
+/// @param size Bytes needed
+/// @return Block, NULL if no registered pool with blocks that large has one left (Counted as a failure of the smallest of them)
+void *POOL_Alloc(uint32_t size);
+
+/// @brief Gives a block from POOL_Alloc back to the registered pool that holds it (Safe from interrupts)
+/// @param block Block to free (NULL is ignored)
+/// @return True if the block was freed, false if it is not the start of a block of a registered pool
+bool POOL_Free(void *block);
+
+/// @brief Gets the statistics of a pool
+/// @param pool Pool to read
+/// @param stats Filled with the pool's statistics
+void POOL_GetStats(const POOL_t *pool, POOL_Stats_t *stats);
+
+/// @brief Clears the allocation and failure counts and restarts the high-water mark from the blocks out now
+/// @param pool Pool to clear
+void POOL_ResetStats(POOL_t *pool);
+
+/// @brief Prints one "POOL,name,blockSize,blockCount,used,highWater,allocs,failures" line per registered pool (Blocking)
+/// @param USARTx USART Peripheral to print to (Ex. USART1, USART2, ...)
+void POOL_Report(USART_TypeDef *USARTx);
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ * @file ACDC_RTOS.h
+ * @author Devin Marx
+ * @brief Header file for the small preemptive kernel behind the thread-safe build of the ACDC drivers
+ *
+ * Built with ACDC_THREAD_SAFE (make THREAD_SAFE=1), ACDC_RTOS implements a subset of the CMSIS-RTOS2 API
+ * (Drivers/CMSIS/RTOS2/Include/cmsis_os2.h): threads with fixed priorities and round robin between equal priorities,
+ * thread flags, delays, mutexes with priority inheritance, and counting semaphores. Everything comes from static pools.
+ * PendSV switches threads, SysTick (ACDC_TIMER) is the 1ms kernel tick.
+ * In the thread-safe build the drivers lock their peripheral with a mutex and block on thread flags set by their
+ * interrupts instead of spinning on status flags. Before osKernelStart and in interrupts they work as before.
+ *
+ * @version 0.1
+ * @date 2024-04-27
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_RTOS_H
+#define __ACDC_RTOS_H
+
+#include "stm32f1xx.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+#include "cmsis_os2.h"
+
+#define RTOS_MAX_THREADS        6       /**< Threads that can exist at once (Not counting the idle thread)                 */
+#define RTOS_MAX_MUTEXES        8       /**< Mutexes osMutexNew can allocate without cb_mem                                 */
+#define RTOS_MAX_SEMAPHORES     4       /**< Semaphores osSemaphoreNew can allocate without cb_mem                          */
+#define RTOS_STACK_POOL_SIZE    3072    /**< Bytes shared by the stacks of threads created without stack_mem                */
+#define RTOS_DEFAULT_STACK_SIZE 512     /**< Stack of a thread created without a stack_size                                 */
+#define RTOS_MIN_STACK_SIZE     128     /**< Smallest stack a thread can have (64 bytes are its saved registers)            */
+#define RTOS_IDLE_STACK_SIZE    128     /**< Stack of the idle thread                                                       */
+#define RTOS_TICK_FREQ          1000    /**< Kernel ticks per second (SysTick runs every millisecond)                       */
+#define RTOS_TIME_SLICE         5       /**< Ticks a thread runs before the next ready thread of the same priority          */
+#define RTOS_FLAG_DRIVER        (1UL << 30) /**< Thread flag the drivers wait on (Applications should use bits 0 - 29)     */
+
+typedef struct{
+    osThreadId_t owner;         /**< Thread holding the mutex (NULL when free)                          */
+    uint32_t count;             /**< Times the owner acquired it (More than 1 only for osMutexRecursive) */
+    uint32_t attr;              /**< osMutexRecursive and/or osMutexPrioInherit                          */
+    const char *name;           /**< Name given in osMutexAttr_t                                        */
+    bool used;                  /**< Taken from the mutex pool                                          */
+}RTOS_Mutex_t;
+
+typedef struct{
+    volatile uint32_t count;    /**< Tokens available                                                   */
+    uint32_t maxCount;          /**< Most tokens the semaphore can hold                                 */
+    const char *name;           /**< Name given in osSemaphoreAttr_t                                    */
+    bool used;                  /**< Taken from the semaphore pool                                      */
+}RTOS_Semaphore_t;
+
+/// @brief Static initializer for a driver mutex with priority inheritance (Ex. static RTOS_Mutex_t lock = RTOS_MUTEX_INIT;)
+#define RTOS_MUTEX_INIT {.attr = osMutexPrioInherit}
+
+/// @brief Kernel tick (Called by SysTick_Handler every millisecond, does nothing until osKernelStart)
+void RTOS_Tick(void);
+
+/// @brief Checks if the caller may block (A thread of the running kernel, with interrupts and the scheduler unlocked)
+/// @return True if the caller is a thread that can wait, false in interrupts and before osKernelStart
+bool RTOS_CanBlock(void);
+
+/// @brief Gets the pool slot of the running thread (Ex. to give every thread its own buffer)
+/// @return 0 - RTOS_MAX_THREADS - 1 for threads, RTOS_MAX_THREADS for interrupts, the idle thread, and before osKernelStart
+uint8_t RTOS_GetThreadIndex(void);
+
+/// @brief Acquires a driver mutex if the caller can block, otherwise does nothing (Interrupts and before osKernelStart)
+/// @param mutex Mutex guarding the peripheral
+void RTOS_DriverLock(RTOS_Mutex_t *mutex);
+
+/// @brief Releases a driver mutex if the running thread holds it, otherwise does nothing
+/// @param mutex Mutex guarding the peripheral
+void RTOS_DriverUnlock(RTOS_Mutex_t *mutex);
+
+#endif
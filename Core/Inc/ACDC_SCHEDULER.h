@@ -0,0 +1,94 @@
+/**
+ * @file ACDC_SCHEDULER.h
+ * @author Devin Marx
+ * @brief Header file for the cooperative run to completion task scheduler
+ *
+ * Tasks are plain functions registered once. Interrupts (Or other tasks) post events to a task, and every event
+ * is queued in the lock-free queue of the task's priority (LDREX/STREX, no interrupts are disabled to post).
+ * SCHEDULER_Run takes the oldest event of the highest priority queue and calls the task in the main context;
+ * tasks always run to completion, so a task is never interrupted by another task and needs no locking.
+ * When every queue is empty the core sleeps with WFI until the next interrupt.
+ * Every task keeps its own run count, run time, and post to run latency in DWT cycles.
+ *
+ * @version 0.1
+ * @date 2024-04-25
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_SCHEDULER_H
+#define __ACDC_SCHEDULER_H
+
+#include "stm32f1xx.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define SCHEDULER_MAX_TASKS     16      /**< Most tasks that can be added                                   */
+#define SCHEDULER_PRIORITIES    4       /**< Number of priorities (0 is the highest)                        */
+#define SCHEDULER_QUEUE_SIZE    16      /**< Events each priority can hold before posts fail (Power of 2)   */
+#define SCHEDULER_INVALID_TASK  0xFF    /**< Returned by SCHEDULER_AddTask when the task can not be added   */
+
+/// @brief Task function, called once per posted event in the main context
+/// @param arg Value given to SCHEDULER_Post (Ex. a channel number or a pointer cast to uint32_t)
+typedef void (*SchedulerFunction)(uint32_t arg);
+
+typedef struct{
+    const char *name;           /**< Name printed by SCHEDULER_Report (Must not contain commas) */
+    uint8_t priority;           /**< Priority of the task's events (0 is the highest)           */
+    uint32_t posts;             /**< Events posted                                              */
+    uint32_t dropped;           /**< Posts that failed because the queue was full               */
+    uint32_t runs;              /**< Events run                                                 */
+    uint32_t maxCycles;         /**< Longest run                                                */
+    uint64_t totalCycles;       /**< Sum of every run                                           */
+    uint32_t maxLatencyCycles;  /**< Longest time from a post to the start of its run           */
+}SCHEDULER_TaskStats_t;
+
+typedef struct{
+    uint64_t busyCycles;        /**< Cycles spent running tasks                                 */
+    uint64_t idleCycles;        /**< Cycles spent asleep in WFI                                 */
+    uint32_t sleeps;            /**< Times the core went to sleep                               */
+    uint8_t maxDepth;           /**< Most events waiting in a single queue                      */
+}SCHEDULER_Stats_t;
+
+/// @brief Clears every task and queue and starts the DWT cycle counter (Call before adding tasks)
+void SCHEDULER_Init(void);
+
+/// @brief Adds a task (Main context, before posting to it)
+/// @param name Name used in reports (Must stay valid)
+/// @param function Function called for every event posted to the task
+/// @param priority Priority of the task's events (0 - SCHEDULER_PRIORITIES - 1, 0 is the highest)
+/// @return Task number to post to, SCHEDULER_INVALID_TASK if the table is full or priority is out of range
+uint8_t SCHEDULER_AddTask(const char *name, SchedulerFunction function, uint8_t priority);
+
+/// @brief Queues an event for a task (Safe to call from interrupts of any priority and from tasks)
+/// @param task Task number from SCHEDULER_AddTask
+/// @param arg Value handed to the task function
+/// @return True if the event was queued, false if the task does not exist or its queue is full (Counted as dropped)
+bool SCHEDULER_Post(uint8_t task, uint32_t arg);
+
+/// @brief Runs the oldest event of the highest priority queue that has one
+/// @return True if an event was run, false if every queue was empty
+bool SCHEDULER_RunOne(void);
+
+/// @brief Runs events forever, sleeping with WFI whenever every queue is empty (Does not return)
+void SCHEDULER_Run(void);
+
+/// @brief Gets the statistics of a task
+/// @param task Task number from SCHEDULER_AddTask
+/// @param stats Filled with the task's statistics
+/// @return True if the task exists, false otherwise
+bool SCHEDULER_GetTaskStats(uint8_t task, SCHEDULER_TaskStats_t *stats);
+
+/// @brief Gets the scheduler's busy and idle time
+/// @param stats Filled with the statistics
+void SCHEDULER_GetStats(SCHEDULER_Stats_t *stats);
+
+/// @brief Clears the statistics of the scheduler and every task (Queued events are kept)
+void SCHEDULER_ResetStats(void);
+
+/// @brief Prints one "TASK,name,priority,posts,dropped,runs,avg,max,maxLatency" line per task and a
+///        "SCHEDULER,busy,idle,sleeps,maxDepth" line (Blocking, call from a task)
+/// @param USARTx USART Peripheral to print to (Ex. USART1, USART2, ...)
+void SCHEDULER_Report(USART_TypeDef *USARTx);
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file ACDC_SPECTRUM.h
+ * @author Devin Marx
+ * @brief Header file for the block FFT spectrum analyzer
+ *
+ * Samples are collected into N point windows (64 - 1024). Each full window is multiplied by a Hann window,
+ * run through arm_rfft_q15, and turned into N / 2 magnitude bins with arm_cmplx_mag_q15. The bins, or only
+ * the largest peaks, are sent as ACDC_TELEMETRY frames instead of the raw samples.
+ *
+ * @version 0.1
+ * @date 2024-04-17
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_SPECTRUM_H
+#define __ACDC_SPECTRUM_H
+
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define SPECTRUM_MIN_SIZE 64        /**< Smallest window (Power of 2)                                   */
+#define SPECTRUM_MAX_SIZE 1024      /**< Largest window (Power of 2, sizes the tables in ACDC_SPECTRUM_TABLES.c) */
+
+typedef struct{
+    arm_rfft_instance_q15 rfft;     /**< CMSIS-DSP RFFT instance                                  */
+    uint16_t size;                  /**< Samples per window (N)                                    */
+    uint16_t count;                 /**< Samples collected in input so far                         */
+    uint32_t sampleRate;            /**< Samples per second, used to turn bins into Hz             */
+    q15_t *window;                  /**< N window coefficients (Hann, set by SPECTRUM_Init)        */
+    q15_t *input;                   /**< N samples being collected (Used as scratch by the RFFT)   */
+    q15_t *output;                  /**< 2N values, the first N / 2 hold the magnitudes            */
+}SPECTRUM_t;
+
+typedef struct{
+    uint16_t bin;                   /**< Bin of the peak (Frequency = bin * sampleRate / N) */
+    q15_t magnitude;                /**< Magnitude of the bin                               */
+}SPECTRUM_Peak_t;
+
+/// @brief Sets up a spectrum analyzer and fills window with a Hann window
+/// @param spectrum Spectrum analyzer to initialize
+/// @param size Samples per window (Power of 2 from SPECTRUM_MIN_SIZE to SPECTRUM_MAX_SIZE)
+/// @param sampleRate Samples per second of the samples that will be added
+/// @param window Buffer of size values (Must stay valid, can be overwritten after init with a different window)
+/// @param input Buffer of size values (Must stay valid)
+/// @param output Buffer of 2 * size values (Must stay valid)
+/// @return True if the spectrum analyzer was set up, false if size is not supported
+bool SPECTRUM_Init(SPECTRUM_t *spectrum, uint16_t size, uint32_t sampleRate, q15_t *window, q15_t *input, q15_t *output);
+
+/// @brief Adds samples to the window, calculating the spectrum every time the window fills up
+/// @param spectrum Spectrum analyzer
+/// @param samples q15 samples (Ex. an ACDC_ACQUIRE block)
+/// @param count Number of samples
+/// @return True if a new spectrum was calculated, false otherwise
+bool SPECTRUM_AddSamples(SPECTRUM_t *spectrum, const q15_t *samples, uint32_t count);
+
+/// @brief Gets the magnitude bins of the last spectrum (Valid until the next spectrum is calculated)
+/// @param spectrum Spectrum analyzer
+/// @return N / 2 magnitudes, bin 0 is DC. A full scale sine reads about 4096 (Hann window gain of 1/2) in its bin
+const q15_t* SPECTRUM_GetMagnitudes(const SPECTRUM_t *spectrum);
+
+/// @brief Finds the largest local maxima of the last spectrum (DC is skipped)
+/// @param spectrum Spectrum analyzer
+/// @param peaks Buffer to store the peaks in, largest first (Must hold maxPeaks peaks)
+/// @param maxPeaks Most peaks to find
+/// @return Number of peaks found
+uint8_t SPECTRUM_FindPeaks(const SPECTRUM_t *spectrum, SPECTRUM_Peak_t *peaks, uint8_t maxPeaks);
+
+/// @brief Converts a bin number into the frequency at its center
+/// @param spectrum Spectrum analyzer
+/// @param bin Bin number
+/// @return Frequency in Hz
+uint32_t SPECTRUM_BinToHz(const SPECTRUM_t *spectrum, uint16_t bin);
+
+/// @brief Sends every magnitude bin of the last spectrum as TELEMETRY_SPECTRUM_BINS frames (Split over several frames when needed)
+/// @param spectrum Spectrum analyzer
+/// @return True if every frame was sent, false otherwise
+bool SPECTRUM_SendBins(const SPECTRUM_t *spectrum);
+
+/// @brief Sends peaks found by SPECTRUM_FindPeaks as a TELEMETRY_SPECTRUM_PEAKS frame
+/// @param spectrum Spectrum analyzer
+/// @param peaks Peaks to send
+/// @param count Number of peaks
+/// @return True if the frame was sent, false otherwise
+bool SPECTRUM_SendPeaks(const SPECTRUM_t *spectrum, const SPECTRUM_Peak_t *peaks, uint8_t count);
+
+#endif
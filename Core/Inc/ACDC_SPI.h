@@ -30,6 +30,9 @@ typedef enum{   // SPI Data Frame Format
     SPI_MODE_16Bit = 1          /**< 16-bit data frame format for Tx/Rx */
 }SPI_BitMode;
 
+/// @brief Function called from the SPI interrupt with every frame received (Runs in interrupt context, keep it short)
+typedef void (*SPI_Callback)(uint16_t data);
+
 /// @brief Initializes the SPIx peripheral to master or slave, using the chip select pin of your choosing. (Default Values: SPI_MODE_16Bit, SPI_BAUD_DIV_2, MSB First)
 /// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
 /// @param isMaster True if SPIx should act as the master, false if it should act as the slave
@@ -115,4 +118,40 @@ void SPI_SetToMaster(SPI_TypeDef *SPIx, bool isMaster);
 /// @return True if there is data available to recieve, false otherwise.
 bool SPI_HasDataToRecieve(SPI_TypeDef *SPIx);
 
+/// @brief Waits until SPIx has finished the frame it is sending (A master gives up after 2ms, counted by ACDC_WATCHDOG)
+/// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
+/// @return False if SPIx stayed busy (Stuck peripheral)
+bool SPI_WaitUntilIdle(const SPI_TypeDef *SPIx);
+
+/// @brief Calls callback from the SPIx interrupt with every frame received (NON-BLOCKING). Pass 0 to go back to polling.
+///        While a callback is set the interrupt reads every frame, so SPI_Receive and SPI_TransmitReceive must not be used on SPIx.
+/// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
+/// @param callback Function to call with each received frame, or 0 to disable the receive interrupt
+void SPI_SetReceiveCallback(SPI_TypeDef *SPIx, SPI_Callback callback);
+
+#ifdef ACDC_THREAD_SAFE
+/// @brief Takes the SPIx bus for a whole chip select transaction (Thread-safe build, does nothing in interrupts and before osKernelStart)
+///        The CS functions and the LTC1298/LTC1451 drivers lock it themselves. Waits for a background transfer to finish.
+/// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
+void SPI_Lock(const SPI_TypeDef *SPIx);
+
+/// @brief Gives the SPIx bus back after SPI_Lock
+/// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
+void SPI_Unlock(const SPI_TypeDef *SPIx);
+
+/// @brief Takes the SPIx bus for a transfer driven by interrupts (Ex. LTCADC_StartReadCH0CS), without waiting (Thread-safe build)
+/// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
+/// @return True if the bus was taken, false if a thread holds it or another background transfer is running (Try again later)
+bool SPI_TryLockBackground(const SPI_TypeDef *SPIx);
+
+/// @brief Gives the SPIx bus back after SPI_TryLockBackground (Safe to call from interrupts)
+/// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
+void SPI_UnlockBackground(const SPI_TypeDef *SPIx);
+#else
+#define SPI_Lock(SPIx)   ((void)0)
+#define SPI_Unlock(SPIx) ((void)0)
+#define SPI_TryLockBackground(SPIx) (true)
+#define SPI_UnlockBackground(SPIx)  ((void)0)
+#endif
+
 #endif
\ No newline at end of file
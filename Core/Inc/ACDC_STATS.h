@@ -0,0 +1,75 @@
+/**
+ * @file ACDC_STATS.h
+ * @author Devin Marx
+ * @brief Header file for streaming block statistics (Mean, RMS, min/max, variance)
+ *
+ * Blocks of q15 samples are reduced as they arrive: the CMSIS-DSP kernels give the sum of squares, minimum,
+ * and maximum of each block, and the block is merged into running Welford statistics for the period. Every
+ * periodSamples samples a summary is made, so only the summaries need to be sent to the host.
+ *
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_STATS_H
+#define __ACDC_STATS_H
+
+#include "arm_math.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define STATS_MAX_PERIOD 0x00FFFFFF     /**< Most samples in a period (Keeps the variance merge inside 64 bits) */
+
+typedef struct{
+    uint32_t count;         /**< Samples in the period                                    */
+    q15_t mean;             /**< Mean (DC level)                                          */
+    q15_t rms;              /**< Root mean square                                         */
+    q15_t min;              /**< Smallest sample                                          */
+    q15_t max;              /**< Largest sample                                           */
+    q31_t variance;         /**< Population variance (q31, a full scale square wave is 1.0) */
+    q15_t stdDev;           /**< Standard deviation (AC RMS)                              */
+}STATS_Summary_t;
+
+typedef struct{
+    uint8_t id;                 /**< Sent with the summary so the host can tell inputs apart  */
+    uint32_t periodSamples;     /**< Samples per summary                                       */
+    uint32_t count;             /**< Samples in the current period                             */
+    int64_t mean;               /**< Running mean (q15 scaled up by 2^16)                      */
+    int64_t m2;                 /**< Running sum of squared differences from the mean (Q30)     */
+    int64_t sumSquares;         /**< Sum of squares (Q30, from arm_power_q15)                  */
+    q15_t min;                  /**< Smallest sample so far                                     */
+    q15_t max;                  /**< Largest sample so far                                      */
+    STATS_Summary_t summary;    /**< Summary of the last completed period                       */
+}STATS_t;
+
+/// @brief Sets up a statistics stage
+/// @param stats Statistics stage to initialize
+/// @param id Number sent with every summary (Ex. the ADC channel)
+/// @param periodSamples Samples per summary (Ex. the sample rate for one summary per second, up to STATS_MAX_PERIOD)
+/// @return True if the stage was set up, false if periodSamples is not supported
+bool STATS_Init(STATS_t *stats, uint8_t id, uint32_t periodSamples);
+
+/// @brief Adds samples to the current period, making a summary each time the period completes
+/// @param stats Statistics stage
+/// @param samples q15 samples (Ex. an ACDC_ACQUIRE block)
+/// @param count Number of samples (Does not have to line up with the period)
+/// @return True if at least one summary was made, false otherwise
+bool STATS_AddBlock(STATS_t *stats, const q15_t *samples, uint32_t count);
+
+/// @brief Gets the summary of the last completed period
+/// @param stats Statistics stage
+/// @return Last summary (All 0 before the first period completes)
+const STATS_Summary_t* STATS_GetSummary(const STATS_t *stats);
+
+/// @brief Throws away the current period (The last summary is kept)
+/// @param stats Statistics stage
+void STATS_Reset(STATS_t *stats);
+
+/// @brief Sends the last summary as a TELEMETRY_STATS_SUMMARY frame
+/// @param stats Statistics stage
+/// @return True if the frame was sent, false otherwise
+bool STATS_SendSummary(const STATS_t *stats);
+
+#endif
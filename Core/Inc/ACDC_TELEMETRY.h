@@ -0,0 +1,106 @@
+/**
+ * @file ACDC_TELEMETRY.h
+ * @author Devin Marx
+ * @brief Header file for binary telemetry frames sent over USART
+ *
+ * Results are sent as small binary frames instead of text so only the numbers cross the link.
+ * Every frame looks like this (Multi-byte values are little endian):
+ *
+ *   | 0xA5 | 0x5A | type | sequence | length (2) | payload (length) | CRC-16 (2) |
+ *
+ * The CRC is CRC-16/CCITT-FALSE over type, sequence, length, and payload. sequence counts up by one
+ * per frame so the host can spot lost frames. Python_Helper/TELEMETRY_Helper.py decodes the frames.
+ *
+ * @version 0.1
+ * @date 2024-04-17
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_TELEMETRY_H
+#define __ACDC_TELEMETRY_H
+
+#include "stm32f1xx.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define TELEMETRY_SYNC_0        0xA5    /**< First byte of every frame              */
+#define TELEMETRY_SYNC_1        0x5A    /**< Second byte of every frame             */
+#define TELEMETRY_MAX_PAYLOAD   256     /**< Largest payload a single frame can hold */
+#define TELEMETRY_FRAME_OVERHEAD 8      /**< Bytes a frame adds around its payload (Header and CRC) */
+
+typedef enum{
+    TELEMETRY_SPECTRUM_BINS  = 0x10,    /**< Magnitude bins of a spectrum (ACDC_SPECTRUM)  */
+    TELEMETRY_SPECTRUM_PEAKS = 0x11,    /**< Largest peaks of a spectrum (ACDC_SPECTRUM)   */
+    TELEMETRY_STATS_SUMMARY  = 0x20,    /**< Summary of a statistics period (ACDC_STATS)   */
+    TELEMETRY_CAPTURE_DATA   = 0x30,    /**< Part of a triggered capture (ACDC_CAPTURE)    */
+    TELEMETRY_BLOCK_TIME     = 0x40,    /**< Timing of an ACQUIRE block (ACDC_TIMESTAMP)   */
+    TELEMETRY_EXTI_EVENTS    = 0x41,    /**< Timestamped EXTI events (ACDC_TIMESTAMP)      */
+    TELEMETRY_CLASSIFIER_EVENT = 0x50,  /**< Class of a waveform window (ACDC_CLASSIFIER)  */
+    TELEMETRY_TRACE_RECORDS  = 0x60     /**< Records from the trace ring (ACDC_TRACE)      */
+}TELEMETRY_Type;
+
+/// @brief Sets the USART frames are sent over (Initialize it with USART_Init first)
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+void TELEMETRY_Init(USART_TypeDef *USARTx);
+
+/// @brief Starts a new frame. Waits if the previous frame is still being sent (Main loop only, not from interrupts)
+/// @param TELEMETRY_x Type of the frame (Tells the host how to decode the payload)
+/// @return True if the frame was started, false if the previous frame was still sending after 500ms (Ex. interrupts
+///         are masked). The Add functions then fail and TELEMETRY_End drops the frame
+bool TELEMETRY_Begin(TELEMETRY_Type TELEMETRY_x);
+
+/// @brief Adds a byte to the payload of the current frame
+/// @param value Byte to add
+/// @return True if it fit, false if the payload is full (The frame will not be sent)
+bool TELEMETRY_AddU8(uint8_t value);
+
+/// @brief Adds a 16-bit value to the payload of the current frame (Little endian)
+/// @param value Value to add (Cast q15_t and int16_t values)
+/// @return True if it fit, false if the payload is full (The frame will not be sent)
+bool TELEMETRY_AddU16(uint16_t value);
+
+/// @brief Adds a 32-bit value to the payload of the current frame (Little endian)
+/// @param value Value to add (Cast q31_t and int32_t values)
+/// @return True if it fit, false if the payload is full (The frame will not be sent)
+bool TELEMETRY_AddU32(uint32_t value);
+
+/// @brief Copies length bytes into the payload of the current frame (Arrays of q15_t are copied as little endian values)
+/// @param data Bytes to add
+/// @param length Number of bytes to add
+/// @return True if they fit, false if the payload is full (The frame will not be sent)
+bool TELEMETRY_AddBytes(const void *data, uint16_t length);
+
+/// @brief Gets the number of payload bytes the current frame still has room for
+/// @return Free payload bytes
+uint16_t TELEMETRY_GetFreeSpace(void);
+
+/// @brief Finishes the current frame and sends it in the background (NON-BLOCKING)
+/// @return True if the frame is being sent, false if its payload overflowed or TELEMETRY_Begin timed out and it was dropped
+bool TELEMETRY_End(void);
+
+/// @brief Gets the number of frames dropped because their payload overflowed or TELEMETRY_Begin timed out
+/// @return Number of dropped frames
+uint32_t TELEMETRY_GetDroppedFrames(void);
+
+/// @brief Checks if the last frame from TELEMETRY_End is still being sent (TELEMETRY_Begin would wait for it)
+/// @return True if the frame buffer is still in use
+bool TELEMETRY_IsSending(void);
+
+/// @brief Sends a whole frame with polled writes (BLOCKING). Does not use or wait for the frame buffer of
+///        TELEMETRY_Begin/End and needs no interrupts, so it also works in fault handlers
+/// @param USARTx USART Peripheral to send on (Ex. USART1, USART2, ...)
+/// @param TELEMETRY_x Type of the frame
+/// @param payload Payload of the frame
+/// @param length Payload bytes (At most TELEMETRY_MAX_PAYLOAD)
+void TELEMETRY_SendFrame(USART_TypeDef *USARTx, TELEMETRY_Type TELEMETRY_x, const void *payload, uint16_t length);
+
+/// @brief Writes a whole frame into frame (The same bytes TELEMETRY_SendFrame sends, Ex. for another link)
+/// @param frame Where to write the frame (At least length + TELEMETRY_FRAME_OVERHEAD bytes)
+/// @param TELEMETRY_x Type of the frame
+/// @param payload Payload of the frame
+/// @param length Payload bytes (At most TELEMETRY_MAX_PAYLOAD)
+/// @return Number of bytes written (length + TELEMETRY_FRAME_OVERHEAD)
+uint16_t TELEMETRY_EncodeFrame(uint8_t *frame, TELEMETRY_Type TELEMETRY_x, const void *payload, uint16_t length);
+
+#endif
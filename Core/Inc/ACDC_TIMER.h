@@ -28,6 +28,9 @@ typedef struct {
     bool isRM;              /**< True this is a remapped pin, false if it is the defualt pin function */
 } TIMx_CHx;
 
+/// @brief Function called from a timer's update interrupt (Runs in interrupt context, keep it short)
+typedef void (*TimerCallback)(void);
+
 typedef enum {
     PWM_MODE_1 = 0b01100000,    /**< Each PWM Cycle looks like this: ▔▔▔┃▂▂▂┃ (Starts High then transitions to Low)*/
     PWM_MODE_2 = 0b01110000     /**< Each PWM Cycle looks like this: ▂▂▂┃▔▔▔┃ (Starts Low then transitions to High)*/
@@ -84,15 +87,31 @@ uint32_t TIMER_PWM_GetDuty(TIMx_CHx TIMx_CHx_Pxx);
 /// @return Period of the PWM signal in timer ticks.
 uint32_t TIMER_PWM_GetPeriod(TIMx_CHx TIMx_CHx_Pxx);
 
+/// @brief Starts TIMx counting at frequency and calls callback from its update interrupt every period (TIM2, TIM3, or TIM4)
+/// @param TIMx Timer to use (Ex. TIM2, TIM3, TIM4), do not use the same timer for PWM
+/// @param frequency Number of times per second to call callback (Ex. 1000 -> Every 1ms)
+/// @param callback Function to call from the interrupt
+/// @return True if the timer was started, false if TIMx is not supported or frequency is out of range
+bool TIMER_TICK_Init(TIM_TypeDef *TIMx, uint32_t frequency, TimerCallback callback);
+
+/// @brief Stops TIMx and its update interrupt (callback is no longer called)
+/// @param TIMx Timer started by TIMER_TICK_Init (Ex. TIM2, TIM3, TIM4)
+void TIMER_TICK_Stop(TIM_TypeDef *TIMx);
+
+/// @brief Gets the time between callbacks of a timer started by TIMER_TICK_Init
+/// @param TIMx Timer started by TIMER_TICK_Init (Ex. TIM2, TIM3, TIM4)
+/// @return Period in nanoseconds (Rounded to whole timer ticks, the real period rather than 1 / frequency)
+uint32_t TIMER_TICK_GetPeriodNs(const TIM_TypeDef *TIMx);
+
 /// @brief Grabs and returns the total number of milliseconds since the MCU turned on
 /// @return Number of milliseconds since startup
 uint64_t Millis();
 
-/// @brief Grabs and returns the total number of microseconds since the MCU turned on
+/// @brief Grabs and returns the total number of microseconds since the MCU turned on (Safe to call from interrupts)
 /// @return Number of microseconds since startup
 uint64_t Micros();
 
-/// @brief Pauses code execution for delayVal number of milliseconds
+/// @brief Pauses code execution for delayVal number of milliseconds (Thread-safe build: a thread sleeps with osDelay instead)
 /// @param delayVal Number of milliseconds to delay for
 void Delay_MS(uint64_t delayVal);
 
@@ -0,0 +1,55 @@
+/**
+ * @file ACDC_TIMESTAMP.h
+ * @author Devin Marx
+ * @brief Header file for timestamping EXTI events and ACDC_ACQUIRE blocks in the telemetry stream
+ *
+ * EXTI handlers record the Micros() time and the ACQUIRE sample number of an event into a small queue,
+ * and the main loop sends the queue as a telemetry frame. Each ACQUIRE block carries the time of its first
+ * sample and the sample period, so the host can put every sample and every event on the same microsecond
+ * time axis without a timestamp per sample.
+ *
+ * @version 0.1
+ * @date 2024-04-22
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_TIMESTAMP_H
+#define __ACDC_TIMESTAMP_H
+
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+#include "ACDC_ACQUIRE.h"
+
+#define TIMESTAMP_MAX_EVENTS 16     /**< Events that can wait to be sent (Power of 2, fits in one frame) */
+
+typedef struct{
+    uint32_t time;          /**< Micros() when the event was recorded (Wraps every ~71 minutes)   */
+    uint32_t sampleNumber;  /**< ACQUIRE sample being taken when the event was recorded           */
+    uint8_t line;           /**< EXTI line (The pin number, 0 - 15)                               */
+}TIMESTAMP_Event_t;
+
+/// @brief Records an event on an EXTI line (Call first thing in the EXTI interrupt)
+/// @param line EXTI line that caused the interrupt (Ex. 13 for PC13)
+/// @return True if the event was queued, false if the queue was full and it was dropped
+bool TIMESTAMP_RecordEXTI(uint8_t line);
+
+/// @brief Takes the oldest recorded event off the queue
+/// @param event Set to the event
+/// @return True if there was an event, false if the queue is empty
+bool TIMESTAMP_GetEvent(TIMESTAMP_Event_t *event);
+
+/// @brief Sends every queued event as one TELEMETRY_EXTI_EVENTS frame (Main loop only)
+/// @return True if the frame was sent or there was nothing to send, false if the frame was dropped (The events stay queued)
+bool TIMESTAMP_SendEvents(void);
+
+/// @brief Sends the timing of a block as a TELEMETRY_BLOCK_TIME frame (Main loop only)
+/// @param block Block from ACQUIRE_GetBlock
+/// @return True if the frame was sent, false otherwise
+bool TIMESTAMP_SendBlock(const ACQUIRE_Block_t *block);
+
+/// @brief Gets the number of events dropped because the queue was full
+/// @return Number of dropped events
+uint32_t TIMESTAMP_GetDroppedEvents(void);
+
+#endif
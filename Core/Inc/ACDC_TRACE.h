@@ -0,0 +1,77 @@
+/**
+ * @file ACDC_TRACE.h
+ * @author Devin Marx
+ * @brief Header file for the binary trace ring
+ *
+ * TRACE("format", arg0, arg1) writes a 16 byte record (Cycle count, event id, running exception, two arguments) into
+ * a RAM ring in a few dozen cycles, from interrupts or the main loop. The format string never goes into flash: it is
+ * placed in the .trace_fmt section, which the linker script keeps in the ELF without loading it, and the event id is
+ * its offset in that section. The build extracts the section to build/<target>.trace and
+ * Python_Helper/TRACE_Helper.py uses it to turn records back into text.
+ * TRACE_Drain sends records as TELEMETRY_TRACE_RECORDS frames whenever the telemetry USART is free, and
+ * TRACE_Dump sends the whole ring with polled writes (For fault handlers). The ring keeps the newest records:
+ * records that are overwritten before they are drained are counted as lost.
+ *
+ * @version 0.1
+ * @date 2024-04-29
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_TRACE_H
+#define __ACDC_TRACE_H
+
+#include "stm32f1xx.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define TRACE_BUFFER_RECORDS    64  /**< Records the ring keeps (Power of 2, 16 bytes each)                             */
+#define TRACE_RECORDS_PER_FRAME 15  /**< Records per TELEMETRY_TRACE_RECORDS frame (8 byte header + 15 * 16 bytes)      */
+
+typedef struct{
+    uint32_t time;              /**< DWT cycle count when the record was written                                    */
+    uint16_t id;                /**< Offset of the format string in .trace_fmt                                      */
+    uint16_t context;           /**< Exception running (0 = main loop or thread, 15 = SysTick, 16 + IRQn = interrupt) */
+    uint32_t arg0;              /**< First argument                                                                 */
+    uint32_t arg1;              /**< Second argument                                                                */
+}TRACE_Record_t;
+
+/// @brief Writes a trace record (Safe from interrupts of any priority)
+/// @param format String literal with up to two printf conversions (%d %i %u %x %X %o %c, Ex. "ch%u = %d")
+/// @param arg0 First argument (Cast to uint32_t)
+/// @param arg1 Second argument (Cast to uint32_t)
+#define TRACE(format, arg0, arg1) do{ \
+    static const char TRACE_Format[] __attribute__((section(".trace_fmt"), used)) = format; \
+    TRACE_Write((uint16_t)(uint32_t)TRACE_Format, (uint32_t)(arg0), (uint32_t)(arg1)); \
+}while(0)
+
+/// @brief Clears the ring, starts the DWT cycle counter, and starts recording
+void TRACE_Init(void);
+
+/// @brief Writes a record (Use TRACE, which also stores the format string. Safe from interrupts of any priority)
+/// @param id Offset of the format string in .trace_fmt
+/// @param arg0 First argument
+/// @param arg1 Second argument
+void TRACE_Write(uint16_t id, uint32_t arg0, uint32_t arg1);
+
+/// @brief Starts or stops recording (TRACE does nothing while stopped)
+/// @param enabled True to record
+void TRACE_SetEnabled(bool enabled);
+
+/// @brief Sends up to TRACE_RECORDS_PER_FRAME records that were not sent yet as a telemetry frame (NON-BLOCKING, main loop only)
+/// @return True if a frame was started, false if there is nothing to send or the previous telemetry frame is still being sent
+bool TRACE_Drain(void);
+
+/// @brief Gets the number of records waiting to be drained
+/// @return Records written and not sent yet (At most TRACE_BUFFER_RECORDS)
+uint32_t TRACE_GetPending(void);
+
+/// @brief Gets the number of records overwritten before TRACE_Drain could send them
+/// @return Lost records
+uint32_t TRACE_GetLost(void);
+
+/// @brief Stops recording and sends every record still in the ring with polled writes (BLOCKING, safe in fault handlers)
+/// @param USARTx USART Peripheral to send on (Ex. USART1, USART2, ...)
+void TRACE_Dump(USART_TypeDef *USARTx);
+
+#endif
@@ -13,6 +13,7 @@
 
 #include "stm32f1xx.h"
 #include "ACDC_CLOCK.h"
+#include "ACDC_string.h"
 
 typedef enum{ // UART/USART Serial Speed
     Serial_1200   = 1200,   /**< Baud rate: 1200 bps   */
@@ -47,6 +48,33 @@ void USART_SendChar(USART_TypeDef *USARTx, char chr);
 /// @param str String to send over UART/USART
 void USART_SendString(USART_TypeDef *USARTx, const char* str);
 
+/// @brief Sends length bytes of data over UART/USART. (Does not append "\r\n" or look for a '\0' (BLOCKING))
+///        Like every blocking send, it first waits for a USART_SendBufferAsync buffer to finish so the two never interleave
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @param data Bytes to send
+/// @param length Number of bytes to send
+void USART_SendBuffer(USART_TypeDef *USARTx, const char* data, uint16_t length);
+
+/// @brief Starts sending length bytes of data in the background using the TXE interrupt. (NON-BLOCKING)
+///        data is NOT copied, it must not be modified until USART_IsTransmitting returns false.
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @param data Bytes to send
+/// @param length Number of bytes to send
+/// @return True if the transmission was started, false if USARTx is still sending a previous buffer
+bool USART_SendBufferAsync(USART_TypeDef *USARTx, const char* data, uint16_t length);
+
+/// @brief Starts sending the contents of the StringBuilder sb in the background without copying it. (NON-BLOCKING)
+///        sb must not be appended to or cleared until USART_IsTransmitting returns false.
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @param sb StringBuilder whose buffer will be sent (At most 65535 bytes)
+/// @return True if the transmission was started, false if USARTx is still sending a previous buffer or sb is too long
+bool USART_SendStringBuilderAsync(USART_TypeDef *USARTx, const StringBuilder *sb);
+
+/// @brief Checks if a USART_SendBufferAsync transmission is still using its buffer
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @return True if bytes are still waiting to be sent, false if the buffer can be reused
+bool USART_IsTransmitting(const USART_TypeDef *USARTx);
+
 /// @brief Recieves a single character from  UART/USART (BLOCKING)
 /// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
 /// @return Character recieved over UART/USART
@@ -0,0 +1,96 @@
+/**
+ * @file ACDC_WATCHDOG.h
+ * @author Devin Marx
+ * @brief Header file for the watchdog supervisor
+ *
+ * ACDC_WATCHDOG starts the independent watchdog (IWDG), which resets the board unless it is refreshed in time. Instead
+ * of refreshing it from one place that keeps running when the rest of the firmware is stuck, every task or loop that
+ * must keep running is registered with a deadline and checks in with WATCHDOG_CheckIn. WATCHDOG_Service, called at a
+ * fixed rate (Ex. from a TIMER_TICK), refreshes the IWDG only while every task has checked in within its deadline.
+ * When a task is late the refreshes stop for good, the late task is saved to .noinit RAM, and the IWDG resets the board.
+ * WATCHDOG_Report prints the reset cause from RCC_CSR at the next boot, with the late task if there was one.
+ * Driver busy-waits on peripheral flags are bounded with WATCHDOG_WaitStart / WATCHDOG_WaitExpired, which count the
+ * waits that time out so a stuck peripheral shows up in the report instead of hanging the loop.
+ *
+ * @version 0.1
+ * @date 2024-05-01
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __ACDC_WATCHDOG_H
+#define __ACDC_WATCHDOG_H
+
+#include "stm32f1xx.h"
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define WATCHDOG_MAX_TASKS      8       /**< Tasks that can be registered                                   */
+#define WATCHDOG_NAME_LENGTH    12      /**< Characters of a task or wait name kept in the reset record (With '\0') */
+#define WATCHDOG_INVALID_TASK   0xFF    /**< Returned by WATCHDOG_AddTask when the table is full            */
+
+typedef enum{
+    WATCHDOG_RESET_UNKNOWN,             /**< No flag set (Flags were cleared by something else)             */
+    WATCHDOG_RESET_POWER_ON,            /**< Power on or brown out                                          */
+    WATCHDOG_RESET_PIN,                 /**< NRST pin (Reset button or debugger)                            */
+    WATCHDOG_RESET_SOFTWARE,            /**< NVIC_SystemReset (Ex. after ACDC_FAULT saved a crash)          */
+    WATCHDOG_RESET_IWDG,                /**< Independent watchdog (A task was late or WATCHDOG_Service stopped) */
+    WATCHDOG_RESET_WWDG,                /**< Window watchdog                                                */
+    WATCHDOG_RESET_LOW_POWER            /**< Entering Standby or Stop with the nRST_STDBY/nRST_STOP option bits */
+}WATCHDOG_ResetCause;
+
+/// @brief Starts the IWDG (It can not be stopped until the next reset, and stops while a debugger halts the core)
+/// @param timeoutMs Time without a refresh before the reset, 1 - 26214ms (The LSI clock is 30 - 60kHz, so it can be 25% shorter)
+void WATCHDOG_Init(uint32_t timeoutMs);
+
+/// @brief Registers a task that must check in within its deadline (The check-in clock starts now)
+/// @param name Name of the task for the report (Ex. "adc")
+/// @param deadlineMs Longest time allowed between check-ins
+/// @return Id to pass to WATCHDOG_CheckIn, WATCHDOG_INVALID_TASK if WATCHDOG_MAX_TASKS are registered
+uint8_t WATCHDOG_AddTask(const char *name, uint32_t deadlineMs);
+
+/// @brief Tells the supervisor the task is still running (Safe from interrupts)
+/// @param task Id from WATCHDOG_AddTask
+void WATCHDOG_CheckIn(uint8_t task);
+
+/// @brief Refreshes the IWDG if every task checked in within its deadline. Call it at a fixed rate well under the
+///        IWDG timeout, preferably from a timer interrupt so a stuck main loop is caught and named (Ex. TIMER_TICK_Init(TIM4, 10, WATCHDOG_Service))
+void WATCHDOG_Service(void);
+
+/// @brief Checks if every task checked in within its deadline
+/// @return False once a task was late (The IWDG is no longer refreshed and resets the board)
+bool WATCHDOG_IsHealthy(void);
+
+/// @brief Gets the longest time between two check-ins of a task (To tune the deadline)
+/// @param task Id from WATCHDOG_AddTask
+/// @return Milliseconds
+uint32_t WATCHDOG_GetWorstGap(uint8_t task);
+
+/// @brief Gets the number of driver busy-waits that timed out since boot
+/// @param lastSite Set to the name of the last wait that timed out (NULL if none). Pass NULL to skip
+/// @return Timed out waits
+uint32_t WATCHDOG_GetTimeouts(const char **lastSite);
+
+/// @brief Gets why the board last reset (Reads and clears the RCC_CSR flags the first time)
+/// @return Reset cause
+WATCHDOG_ResetCause WATCHDOG_GetResetCause(void);
+
+/// @brief Prints the reset cause, and the late task if the supervisor let the IWDG reset the board (Blocking, call once at boot)
+/// @param USARTx USART Peripheral to print to (Ex. USART1, USART2, ...)
+void WATCHDOG_Report(USART_TypeDef *USARTx);
+
+/// @brief Starts timing a busy-wait (Use with WATCHDOG_WaitExpired)
+/// @return Cycle count the wait started at
+static inline uint32_t WATCHDOG_WaitStart(void){
+    return DWT->CYCCNT;
+}
+
+/// @brief Checks if a busy-wait ran out of time, and counts it as a timeout if it did (Starts the DWT cycle counter if needed)
+///        Ex. uint32_t start = WATCHDOG_WaitStart(); while(!READ_BIT(SPIx->SR, SPI_SR_TXE)){ if(WATCHDOG_WaitExpired(start, 5000, "SPI TXE")) break; }
+/// @param start Cycle count from WATCHDOG_WaitStart
+/// @param timeoutUs Longest the wait may take
+/// @param site Name of the wait for the report (String literal)
+/// @return True if the wait should give up
+bool WATCHDOG_WaitExpired(uint32_t start, uint32_t timeoutUs, const char *site);
+
+#endif
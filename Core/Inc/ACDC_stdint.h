@@ -11,6 +11,7 @@
 #ifndef __ACDC_STDINT_H
 #define __ACDC_STDINT_H
 
+#if defined(__arm__)    // Cortex-M3 (long is 32-bits)
 typedef unsigned char           uint8_t;
 typedef unsigned short          uint16_t;
 typedef unsigned long int       uint32_t;
@@ -20,5 +21,8 @@ typedef signed char             int8_t;
 typedef signed short            int16_t;
 typedef signed long int         int32_t;
 typedef signed long long int    int64_t;
+#else                   // Host build (long is 64-bits on 64-bit Linux, let the compiler pick the widths)
+#include <stdint.h>
+#endif
 
 #endif
\ No newline at end of file
@@ -14,6 +14,27 @@
 #include "ACDC_stdbool.h"
 #include "ACDC_stdint.h"
 
+#define STRING_U32_BUFFER_SIZE   11 /**< Buffer size needed to format any uint32_t (10 digits + '\0')                   */
+#define STRING_I32_BUFFER_SIZE   12 /**< Buffer size needed to format any int32_t (sign + 10 digits + '\0')             */
+#define STRING_U64_BUFFER_SIZE   21 /**< Buffer size needed to format any uint64_t (20 digits + '\0')                   */
+#define STRING_I64_BUFFER_SIZE   21 /**< Buffer size needed to format any int64_t (sign + 19 digits + '\0')             */
+#define STRING_HEX_BUFFER_SIZE    9 /**< Buffer size needed to format any uint32_t as hex (8 digits + '\0')             */
+#define STRING_BIN_BUFFER_SIZE   33 /**< Buffer size needed to format any uint32_t as binary (32 digits + '\0')         */
+#define STRING_FIXED_BUFFER_SIZE 22 /**< Buffer size needed to format any Qm.n value (sign + 10 + '.' + 9 + '\0')       */
+
+typedef enum{ // Result of a StringParse function
+    STRING_PARSE_OK        = 0, /**< A number was parsed                                                      */
+    STRING_PARSE_NO_DIGITS = 1, /**< The string did not start with a number, nothing was consumed             */
+    STRING_PARSE_OVERFLOW  = 2  /**< The number did not fit, the value is saturated but all digits are consumed */
+}StringParseResult;
+
+typedef struct{ // Fixed capacity string over a caller provided buffer
+    char *buffer;       /**< Caller provided storage, always null terminated           */
+    int32_t capacity;   /**< Size of buffer in characters (Including the '\0')         */
+    int32_t length;     /**< Current length of the string (Not including the '\0')     */
+    bool truncated;     /**< True if any append did not fit and was cut short          */
+}StringBuilder;
+
 /// @brief Copies the string pointed by source (including the null character) to the destination dest
 /// @param destination Destination buffer to copy the source string to
 /// @param source String to be copied
@@ -56,7 +77,7 @@ char* StringSubstring(char *str, int32_t index);
 /// @param str Input string
 /// @param compareWith Substring to check for at the beginning of str
 /// @return True if the string str starts with compareWith, otherwise false.
-bool StringStartsWith(char *str, const char *compareWith);
+bool StringStartsWith(const char *str, const char *compareWith);
 
 /// @brief Checks if the given string str ends with the specified substring compareWith
 /// @param str Input string
@@ -99,9 +120,158 @@ bool StringIsAlphabetic(const char* str);
 /// @return True if all characters are alphanumeric, otherwise false.
 bool StringIsAlphanumeric(const char* str);
 
-/// @brief Converts an int32_t into a string
+/// @brief Converts an int32_t into a string (NOT REENTRANT, every call overwrites the same static buffer. Prefer StringFormatI32)
+///        The thread-safe build gives every thread its own buffer, interrupts still share one
 /// @param num Integer to convert into a string
 /// @return Pointer to a buffer that contains the converted string
 char *StringConvert(int32_t num);
 
+/// @brief Formats an uint32_t as a decimal string into the caller's buffer (Reentrant)
+/// @param buffer Destination buffer (Must hold at least STRING_U32_BUFFER_SIZE characters)
+/// @param num Number to format
+/// @return Number of characters written (not including the null terminating character)
+int32_t StringFormatU32(char *buffer, uint32_t num);
+
+/// @brief Formats an int32_t as a decimal string into the caller's buffer (Reentrant, handles INT32_MIN)
+/// @param buffer Destination buffer (Must hold at least STRING_I32_BUFFER_SIZE characters)
+/// @param num Number to format
+/// @return Number of characters written (not including the null terminating character)
+int32_t StringFormatI32(char *buffer, int32_t num);
+
+/// @brief Formats an uint64_t as a decimal string into the caller's buffer (Reentrant)
+/// @param buffer Destination buffer (Must hold at least STRING_U64_BUFFER_SIZE characters)
+/// @param num Number to format
+/// @return Number of characters written (not including the null terminating character)
+int32_t StringFormatU64(char *buffer, uint64_t num);
+
+/// @brief Formats an int64_t as a decimal string into the caller's buffer (Reentrant, handles INT64_MIN)
+/// @param buffer Destination buffer (Must hold at least STRING_I64_BUFFER_SIZE characters)
+/// @param num Number to format
+/// @return Number of characters written (not including the null terminating character)
+int32_t StringFormatI64(char *buffer, int64_t num);
+
+/// @brief Formats an uint32_t as an uppercase hexadecimal string without a prefix (Ex. 0x2F -> "2F")
+/// @param buffer Destination buffer (Must hold at least STRING_HEX_BUFFER_SIZE characters)
+/// @param num Number to format
+/// @param minDigits Minimum number of digits, the result is padded with leading zeros (0-8)
+/// @return Number of characters written (not including the null terminating character)
+int32_t StringFormatHex(char *buffer, uint32_t num, uint8_t minDigits);
+
+/// @brief Formats an uint32_t as a binary string without a prefix (Ex. 5 -> "101")
+/// @param buffer Destination buffer (Must hold at least STRING_BIN_BUFFER_SIZE characters)
+/// @param num Number to format
+/// @param minDigits Minimum number of digits, the result is padded with leading zeros (0-32)
+/// @return Number of characters written (not including the null terminating character)
+int32_t StringFormatBinary(char *buffer, uint32_t num, uint8_t minDigits);
+
+/// @brief Formats a signed Qm.n fixed point number as a decimal string rounded to decimalPlaces (Ex. Q16.16 0x00018000 -> "1.50")
+/// @param buffer Destination buffer (Must hold at least STRING_FIXED_BUFFER_SIZE characters)
+/// @param num Fixed point number to format
+/// @param fractionalBits Number of fractional bits n in the Qm.n format (0-31)
+/// @param decimalPlaces Number of digits to print after the decimal point (0-9)
+/// @return Number of characters written (not including the null terminating character)
+int32_t StringFormatFixed(char *buffer, int32_t num, uint8_t fractionalBits, uint8_t decimalPlaces);
+
+/// @brief Parses an unsigned decimal number from the start of str. Stops at the first non-digit, '\0', or after length characters.
+///        Unlike strtoul, leading whitespace and a sign are not skipped (They are not digits)
+/// @param str String to parse (Does not need to be null terminated)
+/// @param length Maximum number of characters to read from str
+/// @param value Parsed value (0 if no digits were found, UINT32_MAX on overflow)
+/// @param consumed Number of characters that were part of the number (Can be NULL)
+/// @return STRING_PARSE_OK, STRING_PARSE_NO_DIGITS, or STRING_PARSE_OVERFLOW
+StringParseResult StringParseU32(const char *str, int32_t length, uint32_t *value, int32_t *consumed);
+
+/// @brief Parses a signed decimal number with an optional '+' or '-' from the start of str. Unlike strtol, leading whitespace is not skipped
+/// @param str String to parse (Does not need to be null terminated)
+/// @param length Maximum number of characters to read from str
+/// @param value Parsed value (0 if no digits were found, INT32_MAX or INT32_MIN on overflow)
+/// @param consumed Number of characters that were part of the number, including the sign (Can be NULL)
+/// @return STRING_PARSE_OK, STRING_PARSE_NO_DIGITS, or STRING_PARSE_OVERFLOW
+StringParseResult StringParseI32(const char *str, int32_t length, int32_t *value, int32_t *consumed);
+
+/// @brief Parses a hexadecimal number with an optional "0x" or "0X" prefix from the start of str. (Upper and lowercase digits)
+/// @param str String to parse (Does not need to be null terminated)
+/// @param length Maximum number of characters to read from str
+/// @param value Parsed value (0 if no digits were found, UINT32_MAX on overflow)
+/// @param consumed Number of characters that were part of the number, including the prefix (Can be NULL)
+/// @return STRING_PARSE_OK, STRING_PARSE_NO_DIGITS, or STRING_PARSE_OVERFLOW
+StringParseResult StringParseHex(const char *str, int32_t length, uint32_t *value, int32_t *consumed);
+
+/// @brief Parses a signed decimal number with an optional fraction (Ex. "-1.25") into a Qm.n fixed point number (Rounded to nearest)
+/// @param str String to parse (Does not need to be null terminated)
+/// @param length Maximum number of characters to read from str
+/// @param fractionalBits Number of fractional bits n in the Qm.n format (0-31)
+/// @param value Parsed value (0 if no digits were found, saturated to the Qm.n range on overflow)
+/// @param consumed Number of characters that were part of the number, including the sign and decimal point (Can be NULL)
+/// @return STRING_PARSE_OK, STRING_PARSE_NO_DIGITS, or STRING_PARSE_OVERFLOW
+StringParseResult StringParseFixed(const char *str, int32_t length, uint8_t fractionalBits, int32_t *value, int32_t *consumed);
+
+/// @brief Creates an empty StringBuilder that writes into buffer
+/// @param buffer Storage for the string (Must stay valid for as long as the StringBuilder is used)
+/// @param capacity Size of buffer in characters (Including the '\0')
+/// @return StringBuilder with a length of 0
+StringBuilder StringBuilderInit(char *buffer, int32_t capacity);
+
+/// @brief Empties the StringBuilder and clears its truncated flag
+/// @param sb StringBuilder to clear
+void StringBuilderClear(StringBuilder *sb);
+
+/// @brief Appends the string str to the end of the StringBuilder in O(length of str)
+/// @param sb StringBuilder to append to
+/// @param str String to append
+/// @return True if all of str fit, false if it was truncated
+bool StringBuilderAppend(StringBuilder *sb, const char *str);
+
+/// @brief Appends exactly length characters of str to the end of the StringBuilder
+/// @param sb StringBuilder to append to
+/// @param str Characters to append (Does not need to be null terminated)
+/// @param length Number of characters to append
+/// @return True if all of the characters fit, false if they were truncated
+bool StringBuilderAppendLength(StringBuilder *sb, const char *str, int32_t length);
+
+/// @brief Appends a single character to the end of the StringBuilder
+/// @param sb StringBuilder to append to
+/// @param c Character to append
+/// @return True if the character fit, false otherwise
+bool StringBuilderAppendChar(StringBuilder *sb, char c);
+
+/// @brief Appends an uint32_t as a decimal string (See StringFormatU32)
+/// @param sb StringBuilder to append to
+/// @param num Number to append
+/// @return True if the number fit, false if it was truncated
+bool StringBuilderAppendU32(StringBuilder *sb, uint32_t num);
+
+/// @brief Appends an int32_t as a decimal string (See StringFormatI32)
+/// @param sb StringBuilder to append to
+/// @param num Number to append
+/// @return True if the number fit, false if it was truncated
+bool StringBuilderAppendI32(StringBuilder *sb, int32_t num);
+
+/// @brief Appends an uint64_t as a decimal string (See StringFormatU64)
+/// @param sb StringBuilder to append to
+/// @param num Number to append
+/// @return True if the number fit, false if it was truncated
+bool StringBuilderAppendU64(StringBuilder *sb, uint64_t num);
+
+/// @brief Appends an int64_t as a decimal string (See StringFormatI64)
+/// @param sb StringBuilder to append to
+/// @param num Number to append
+/// @return True if the number fit, false if it was truncated
+bool StringBuilderAppendI64(StringBuilder *sb, int64_t num);
+
+/// @brief Appends an uint32_t as an uppercase hexadecimal string (See StringFormatHex)
+/// @param sb StringBuilder to append to
+/// @param num Number to append
+/// @param minDigits Minimum number of digits, padded with leading zeros (0-8)
+/// @return True if the number fit, false if it was truncated
+bool StringBuilderAppendHex(StringBuilder *sb, uint32_t num, uint8_t minDigits);
+
+/// @brief Appends a Qm.n fixed point number as a decimal string (See StringFormatFixed)
+/// @param sb StringBuilder to append to
+/// @param num Fixed point number to append
+/// @param fractionalBits Number of fractional bits n in the Qm.n format (0-31)
+/// @param decimalPlaces Number of digits to print after the decimal point (0-9)
+/// @return True if the number fit, false if it was truncated
+bool StringBuilderAppendFixed(StringBuilder *sb, int32_t num, uint8_t fractionalBits, uint8_t decimalPlaces);
+
 #endif
\ No newline at end of file
@@ -24,6 +24,7 @@ extern "C" {
 #include "stm32f1xx_hal.h"
 #include "ACDC_stdbool.h"
 #include "ACDC_stdint.h"
+#include "ACDC_ATTRIBUTES.h"
 #include "ACDC_string.h"
 #include "ACDC_GPIO.h"
 #include "ACDC_CLOCK.h"
@@ -33,6 +34,25 @@ extern "C" {
 #include "ACDC_SPI.h"
 #include "ACDC_LTC1298_ADC.h"
 #include "ACDC_LTC1451_DAC.h"
+#include "ACDC_BENCH.h"
+#include "ACDC_DSP.h"
+#include "ACDC_FILTER.h"
+#include "ACDC_ACQUIRE.h"
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_SPECTRUM.h"
+#include "ACDC_GOERTZEL.h"
+#include "ACDC_CONTROL.h"
+#include "ACDC_STATS.h"
+#include "ACDC_CAPTURE.h"
+#include "ACDC_TIMESTAMP.h"
+#include "ACDC_CALIBRATION.h"
+#include "ACDC_CLASSIFIER.h"
+#include "ACDC_SCHEDULER.h"
+#include "ACDC_RTOS.h"
+#include "ACDC_POOL.h"
+#include "ACDC_TRACE.h"
+#include "ACDC_FAULT.h"
+#include "ACDC_WATCHDOG.h"
 
 /* Exported functions prototypes ---------------------------------------------*/
 void Error_Handler(void);
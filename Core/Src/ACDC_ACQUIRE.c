@@ -0,0 +1,284 @@
+/**
+ * @file ACDC_ACQUIRE.c
+ * @author Devin Marx
+ * @brief Implementation of fixed rate LTC1298 sampling into a ring of sample blocks
+ * @version 0.1
+ * @date 2024-04-15
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_ACQUIRE.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_WATCHDOG.h"
+
+#define ACQUIRE_CODE_SHIFT      4       // 12-bit LTC1298 codes are stored left aligned in 16 bits
+#define ACQUIRE_DAC_MAX         0x0FFF  // Largest 12-bit LTC1451 code
+#define ACQUIRE_STOP_TIMEOUT_US 5000    // Longest the last conversion may take (2 frames at APB / 256 with an 8MHz clock is 1ms)
+
+typedef bool (*ACQUIRE_StartReadFunction)(LTC1298_t LTC_ADC, LTCADC_Callback callback);
+
+typedef struct{
+    uint8_t extraBits;                  // 0 when the channel is not oversampled
+    ACQUIRE_OversampleFilter filter;
+    LTC1451_t dac;
+    uint16_t ditherCenter;
+    uint16_t ditherAmplitude;           // 0 when dither is off
+}ACQUIRE_Oversampling_t;
+
+typedef struct{
+    uint32_t ratio;                     // Conversions per sample (4^extraBits)
+    uint32_t count;                     // Conversions summed into the current sample
+    uint32_t integrator1;               // CIC state, wraps around on purpose (Only the differences matter)
+    uint32_t integrator2;
+    uint32_t comb1;                     // integrator2 at the end of the previous sample
+    uint32_t comb2;                     // First comb output of the previous sample
+    uint8_t warmup;                     // Finished samples still to throw away (The combs start from 0)
+    int8_t shift;                       // Right shift that brings the sum to 16 bits (Negative shifts left)
+    uint16_t ditherOffset;              // DAC code at the bottom of the ramp
+    uint32_t ditherStep;                // DAC codes per conversion (Q16)
+}ACQUIRE_Oversampler_t;
+
+static q15_t ACQUIRE_Blocks[ACQUIRE_BLOCK_COUNT][ACQUIRE_BLOCK_SIZE];
+static volatile uint32_t ACQUIRE_BlocksWritten;     // Blocks filled by the interrupt (Free running, only written by the interrupt)
+static volatile uint32_t ACQUIRE_BlocksRead;        // Blocks released by the main loop (Free running, only written by the main loop)
+static uint16_t ACQUIRE_SampleIndex;                // Next sample of the block being filled
+static volatile uint32_t ACQUIRE_SampleNumber;      // Samples taken since ACQUIRE_Start (Including ones in dropped blocks)
+static uint32_t ACQUIRE_FirstSamples[ACQUIRE_BLOCK_COUNT];  // Number of the first sample of each block in the ring
+static uint32_t ACQUIRE_Timestamps[ACQUIRE_BLOCK_COUNT];    // Micros() when each block's first conversion started
+static uint32_t ACQUIRE_StartTime;                  // Micros() when the conversion of a block's first sample started
+static uint32_t ACQUIRE_SamplePeriod;               // Nanoseconds between samples (From the timer registers)
+static volatile uint32_t ACQUIRE_DroppedBlocks;
+static volatile uint32_t ACQUIRE_MissedSamples;
+
+static LTC1298_t ACQUIRE_ADC;
+static ACQUIRE_Channel ACQUIRE_SelectedChannel;
+static ACQUIRE_Oversampling_t ACQUIRE_Oversampling[2];     // Settings of ACQUIRE_CH0 and ACQUIRE_CH1
+static ACQUIRE_Oversampling_t ACQUIRE_Settings;             // Settings of the channel being sampled, copied at ACQUIRE_Start
+static ACQUIRE_Oversampler_t ACQUIRE_Oversampler;
+static const CALIBRATION_t *ACQUIRE_Calibrations[2];       // Calibrations of ACQUIRE_CH0 and ACQUIRE_CH1
+static ACQUIRE_StartReadFunction ACQUIRE_StartRead; // LTCADC_StartReadCH0CS or LTCADC_StartReadCH1CS
+static TIM_TypeDef *ACQUIRE_Timer;
+static uint32_t ACQUIRE_SampleRate;
+static FILTER_Pipeline_t *ACQUIRE_Filter;
+static ACQUIRE_Block_t ACQUIRE_Current;             // Block handed out by ACQUIRE_GetBlock
+static bool ACQUIRE_Holding;                        // True between ACQUIRE_GetBlock and ACQUIRE_ReleaseBlock
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Timer callback, starts the conversion for the next sample
+static void ACQUIRE_TickHandler(void);
+
+/// @brief LTC1298 callback, stores the sample and hands the block to the main loop once it is full
+/// @param sample 12-bit sample read from the ADC
+static void ACQUIRE_SampleHandler(uint16_t sample);
+
+/// @brief Adds a conversion to the oversampled sample and moves the dither to its next step
+/// @param sample 12-bit sample read from the ADC
+/// @param code Set to the finished sample (16-bit, left aligned) when the last conversion of it was added
+/// @return True if a sample was finished, false if more conversions are needed
+static bool ACQUIRE_Oversample(uint16_t sample, uint16_t *code);
+
+/// @brief Gets the DAC code of a step of the dither ramp
+/// @param step Conversion in the sample (0 - ratio - 1)
+/// @return DAC code
+static uint16_t ACQUIRE_DitherCode(uint32_t step);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool ACQUIRE_Init(LTC1298_t LTC_ADC, ACQUIRE_Channel ACQUIRE_CHx, TIM_TypeDef *TIMx, uint32_t sampleRate){
+    if(sampleRate == 0 || sampleRate > ACQUIRE_MAX_SAMPLE_RATE)
+        return false;
+
+    ACQUIRE_Stop();                 // Stop a previous configuration before changing it
+    ACQUIRE_ADC = LTC_ADC;
+    ACQUIRE_StartRead = ACQUIRE_CHx == ACQUIRE_CH1 ? LTCADC_StartReadCH1CS : LTCADC_StartReadCH0CS;
+    ACQUIRE_SelectedChannel = ACQUIRE_CHx;
+    ACQUIRE_Timer = TIMx;
+    ACQUIRE_SampleRate = sampleRate;
+    return true;
+}
+
+bool ACQUIRE_SetOversampling(ACQUIRE_Channel ACQUIRE_CHx, uint8_t extraBits, ACQUIRE_OversampleFilter ACQUIRE_OVERSAMPLE_x){
+    if(extraBits > ACQUIRE_MAX_EXTRA_BITS)
+        return false;
+    ACQUIRE_Oversampling[ACQUIRE_CHx].extraBits = extraBits;
+    ACQUIRE_Oversampling[ACQUIRE_CHx].filter = ACQUIRE_OVERSAMPLE_x;
+    return true;
+}
+
+bool ACQUIRE_SetDither(ACQUIRE_Channel ACQUIRE_CHx, LTC1451_t LTC_DAC, uint16_t center, uint16_t amplitude){
+    if(amplitude / 2 > center || center + (amplitude - amplitude / 2) > ACQUIRE_DAC_MAX)
+        return false;
+    ACQUIRE_Oversampling[ACQUIRE_CHx].dac = LTC_DAC;
+    ACQUIRE_Oversampling[ACQUIRE_CHx].ditherCenter = center;
+    ACQUIRE_Oversampling[ACQUIRE_CHx].ditherAmplitude = amplitude;
+    return true;
+}
+
+void ACQUIRE_SetCalibration(ACQUIRE_Channel ACQUIRE_CHx, const CALIBRATION_t *calibration){
+    ACQUIRE_Calibrations[ACQUIRE_CHx] = calibration;
+}
+
+bool ACQUIRE_SetFilter(FILTER_Pipeline_t *pipeline){
+    if(pipeline != 0 && pipeline->blockSize != ACQUIRE_BLOCK_SIZE)
+        return false;
+    ACQUIRE_Filter = pipeline;
+    return true;
+}
+
+bool ACQUIRE_Start(void){
+    if(ACQUIRE_Timer == 0)
+        return false;
+
+    ACQUIRE_BlocksWritten = 0;      // The timer is stopped, nothing else touches the ring
+    ACQUIRE_BlocksRead = 0;
+    ACQUIRE_SampleIndex = 0;
+    ACQUIRE_SampleNumber = 0;
+    ACQUIRE_DroppedBlocks = 0;
+    ACQUIRE_MissedSamples = 0;
+    ACQUIRE_Holding = false;
+
+    // Sum of 4^n 12-bit codes has 12 + 2n bits, a 2nd order CIC doubles the growth
+    ACQUIRE_Settings = ACQUIRE_Oversampling[ACQUIRE_SelectedChannel];
+    uint8_t extraBits = ACQUIRE_Settings.extraBits;
+    uint8_t order = ACQUIRE_Settings.filter == ACQUIRE_OVERSAMPLE_CIC2 ? 2 : 1;
+    ACQUIRE_Oversampler = (ACQUIRE_Oversampler_t){0};
+    ACQUIRE_Oversampler.ratio = 1UL << (2 * extraBits);
+    ACQUIRE_Oversampler.shift = (int8_t)(2 * extraBits * order - ACQUIRE_CODE_SHIFT);
+    ACQUIRE_Oversampler.warmup = order - 1;     // The first CIC2 sample only has the rising half of its weights
+    if(extraBits != 0 && ACQUIRE_Settings.ditherAmplitude != 0){
+        ACQUIRE_Oversampler.ditherOffset = ACQUIRE_Settings.ditherCenter - ACQUIRE_Settings.ditherAmplitude / 2;
+        ACQUIRE_Oversampler.ditherStep = ((uint32_t)ACQUIRE_Settings.ditherAmplitude << 16) / ACQUIRE_Oversampler.ratio;
+        LTCDAC_SetOutputCS(ACQUIRE_Settings.dac, ACQUIRE_DitherCode(0));      // First step is in place before the first conversion
+    }
+
+    if(!TIMER_TICK_Init(ACQUIRE_Timer, ACQUIRE_SampleRate, ACQUIRE_TickHandler))
+        return false;
+    uint32_t period = TIMER_TICK_GetPeriodNs(ACQUIRE_Timer);       // The first tick is a whole period away
+    ACQUIRE_SamplePeriod = (period > (UINT32_MAX >> (2 * extraBits))) ? UINT32_MAX : period << (2 * extraBits);
+    return true;
+}
+
+void ACQUIRE_Stop(void){
+    if(ACQUIRE_Timer != 0)
+        TIMER_TICK_Stop(ACQUIRE_Timer);
+    uint32_t start = WATCHDOG_WaitStart();
+    while(LTCADC_IsReading()){      // Let the last conversion finish so the SPI is free
+        if(WATCHDOG_WaitExpired(start, ACQUIRE_STOP_TIMEOUT_US, "ACQUIRE stop"))
+            break;
+    }
+}
+
+bool ACQUIRE_GetBlock(ACQUIRE_Block_t *block){
+    if(!ACQUIRE_Holding){
+        if(ACQUIRE_BlocksWritten == ACQUIRE_BlocksRead)
+            return false;           // Nothing waiting
+
+        uint32_t slot = ACQUIRE_BlocksRead % ACQUIRE_BLOCK_COUNT;
+        q15_t *samples = ACQUIRE_Blocks[slot];
+        for(uint32_t i = 0; i < ACQUIRE_BLOCK_SIZE; i++)
+            samples[i] = (q15_t)((uint16_t)samples[i] ^ 0x8000);   // The interrupt stores 16-bit codes, flipping the top bit subtracts midscale
+        const CALIBRATION_t *calibration = ACQUIRE_Calibrations[ACQUIRE_SelectedChannel];
+        if(calibration != 0)
+            CALIBRATION_ApplyQ15(calibration, samples, ACQUIRE_BLOCK_SIZE);
+        uint32_t length = ACQUIRE_BLOCK_SIZE;
+        if(ACQUIRE_Filter != 0)
+            length = FILTER_Process(ACQUIRE_Filter, samples);
+        uint32_t samplePeriod = ACQUIRE_SamplePeriod * (ACQUIRE_BLOCK_SIZE / length);     // Decimation keeps every Mth sample
+        ACQUIRE_Current = (ACQUIRE_Block_t){samples, length, ACQUIRE_FirstSamples[slot], ACQUIRE_Timestamps[slot], samplePeriod};
+        ACQUIRE_Holding = true;
+    }
+
+    *block = ACQUIRE_Current;
+    return true;
+}
+
+void ACQUIRE_ReleaseBlock(void){
+    if(!ACQUIRE_Holding)
+        return;
+    ACQUIRE_Holding = false;
+    ACQUIRE_BlocksRead++;           // The interrupt may now fill this block again
+}
+
+uint32_t ACQUIRE_GetSampleNumber(void){
+    return ACQUIRE_SampleNumber;
+}
+
+uint32_t ACQUIRE_GetDroppedBlocks(void){
+    return ACQUIRE_DroppedBlocks;
+}
+
+uint32_t ACQUIRE_GetMissedSamples(void){
+    return ACQUIRE_MissedSamples;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static void ACQUIRE_TickHandler(void){
+    if(ACQUIRE_SampleIndex == 0 && ACQUIRE_Oversampler.count == 0)  // Only the first sample of each block is timed, the rest follow the sample period
+        ACQUIRE_StartTime = (uint32_t)Micros();
+    if(!ACQUIRE_StartRead(ACQUIRE_ADC, ACQUIRE_SampleHandler))  // The previous conversion is still clocking out
+        ACQUIRE_MissedSamples++;
+}
+
+static void ACQUIRE_SampleHandler(uint16_t sample){
+    uint16_t code = sample << ACQUIRE_CODE_SHIFT;
+    if(ACQUIRE_Oversampler.ratio != 1 && !ACQUIRE_Oversample(sample, &code))
+        return;                     // Still summing conversions
+
+    uint32_t written = ACQUIRE_BlocksWritten;
+    if(ACQUIRE_SampleIndex == 0){
+        ACQUIRE_FirstSamples[written % ACQUIRE_BLOCK_COUNT] = ACQUIRE_SampleNumber;
+        ACQUIRE_Timestamps[written % ACQUIRE_BLOCK_COUNT] = ACQUIRE_StartTime;
+    }
+    ACQUIRE_Blocks[written % ACQUIRE_BLOCK_COUNT][ACQUIRE_SampleIndex] = (q15_t)code;
+    ACQUIRE_SampleNumber++;
+    if(++ACQUIRE_SampleIndex < ACQUIRE_BLOCK_SIZE)
+        return;
+
+    // Block is full. Hand it over only if the next block is not still waiting or held by the main loop,
+    // otherwise refill this one (The newest block is dropped so the waiting blocks stay in order)
+    ACQUIRE_SampleIndex = 0;
+    if(written + 1 - ACQUIRE_BlocksRead < ACQUIRE_BLOCK_COUNT)
+        ACQUIRE_BlocksWritten = written + 1;
+    else
+        ACQUIRE_DroppedBlocks++;
+}
+
+static bool ACQUIRE_Oversample(uint16_t sample, uint16_t *code){
+    ACQUIRE_Oversampler_t *oversampler = &ACQUIRE_Oversampler;
+    uint32_t count = oversampler->count + 1;
+    if(count == oversampler->ratio)
+        count = 0;
+    if(ACQUIRE_Settings.ditherAmplitude != 0)   // Set the next step now so the DAC settles before the next conversion starts
+        LTCDAC_SetOutputCS(ACQUIRE_Settings.dac, ACQUIRE_DitherCode(count));
+
+    oversampler->integrator1 += sample;
+    oversampler->integrator2 += oversampler->integrator1;
+    oversampler->count = count;
+    if(count != 0)
+        return false;
+
+    uint32_t sum;
+    if(ACQUIRE_Settings.filter == ACQUIRE_OVERSAMPLE_CIC2){
+        uint32_t comb1 = oversampler->integrator2 - oversampler->comb1;
+        oversampler->comb1 = oversampler->integrator2;
+        sum = comb1 - oversampler->comb2;
+        oversampler->comb2 = comb1;
+        if(oversampler->warmup != 0){
+            oversampler->warmup--;
+            return false;
+        }
+    } else {
+        sum = oversampler->integrator1;         // Integrate and dump
+        oversampler->integrator1 = 0;
+        oversampler->integrator2 = 0;
+    }
+    *code = (uint16_t)(oversampler->shift >= 0 ? sum >> oversampler->shift : sum << -oversampler->shift);
+    return true;
+}
+
+static uint16_t ACQUIRE_DitherCode(uint32_t step){
+    return ACQUIRE_Oversampler.ditherOffset + (uint16_t)((step * ACQUIRE_Oversampler.ditherStep) >> 16);
+}
+#pragma endregion
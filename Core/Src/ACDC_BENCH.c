@@ -0,0 +1,191 @@
+/**
+ * @file ACDC_BENCH.c
+ * @author Devin Marx
+ * @brief Implementation of the cycle counting benchmark harness
+ * @version 0.1
+ * @date 2024-04-02
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_BENCH.h"
+#include "ACDC_CLOCK.h"
+#include "ACDC_USART.h"
+#include "ACDC_string.h"
+
+#define BENCH_OVERHEAD_SAMPLES 64   // Number of empty calls timed to find the timing overhead
+#define BENCH_LINE_SIZE        96   // "BENCH," + name + 5 numbers + commas + "\r\n"
+
+#ifdef ACDC_QEMU
+// ARM semihosting {See ARM DUI 0471, Semihosting operations}
+#define SEMIHOSTING_SYS_WRITE0          0x04        // Print a null terminated string to the debugger console
+#define SEMIHOSTING_SYS_EXIT_EXTENDED   0x20        // SYS_EXIT with an exit status (Ends the QEMU session)
+#define SEMIHOSTING_APPLICATION_EXIT    0x20026     // ADP_Stopped_ApplicationExit
+#endif
+
+static Benchmark_t Benchmarks[BENCH_MAX_BENCHMARKS];
+static uint8_t BenchmarkCount = 0;
+static uint32_t BenchOverhead = 0;  // Cycles taken to time an empty call
+static uint32_t BenchFailedChecks = 0;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Empty benchmark used to measure the cost of timing a call
+/// @param iteration Current iteration
+/// @return iteration
+static uint32_t BENCH_Empty(uint32_t iteration);
+
+/// @brief Sends a finished line to USARTx (Or to the semihosting console in the QEMU build)
+/// @param USARTx USART Peripheral to print to (Ex. USART1, USART2, ...)
+/// @param sb StringBuilder holding the line
+static void BENCH_Print(USART_TypeDef *USARTx, const StringBuilder *sb);
+
+#ifdef ACDC_QEMU
+/// @brief Calls a semihosting operation on the debugger (QEMU)
+/// @param operation Semihosting operation number (Ex. SEMIHOSTING_SYS_WRITE0)
+/// @param argument Operation specific argument
+/// @return Operation specific result
+static uint32_t BENCH_Semihost(uint32_t operation, const void *argument);
+#endif
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void BENCH_Init(void){
+#ifndef ACDC_QEMU
+    SET_BIT(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);  // Enable the DWT and ITM blocks
+    DWT->CYCCNT = 0;                                        // Reset the cycle counter
+    SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);             // Start the cycle counter
+#endif
+
+    BenchOverhead = 0;
+    Benchmark_t empty = {"overhead", BENCH_Empty, BENCH_OVERHEAD_SAMPLES};
+    BenchOverhead = BENCH_Run(&empty).minCycles;            // Overhead is the fastest an empty call can be timed
+}
+
+bool BENCH_IsCycleCounterRunning(void){
+    uint32_t start = BENCH_CYCLES();
+    __NOP(); __NOP(); __NOP(); __NOP();
+    return BENCH_CYCLES() != start;
+}
+
+bool BENCH_Register(const char *name, BenchFunction function, uint32_t iterations){
+    if(BenchmarkCount >= BENCH_MAX_BENCHMARKS)
+        return false;
+    Benchmarks[BenchmarkCount++] = (Benchmark_t){name, function, iterations};
+    return true;
+}
+
+// Kept out of line so BENCH_Init measures the overhead with the exact same loop the benchmarks use
+__attribute__((noinline, noclone)) BenchResult_t BENCH_Run(const Benchmark_t *bench){
+    BenchResult_t result = {bench->iterations, 0xFFFFFFFF, 0, 0, 0};
+    for(uint32_t i = 0; i < bench->iterations; i++){
+        uint32_t start = BENCH_CYCLES();
+        uint32_t value = bench->function(i);
+        uint32_t cycles = BENCH_CYCLES() - start;           // Unsigned subtraction handles the counter wrapping
+
+        cycles = (cycles > BenchOverhead) ? cycles - BenchOverhead : 0;
+        if(cycles < result.minCycles)
+            result.minCycles = cycles;
+        if(cycles > result.maxCycles)
+            result.maxCycles = cycles;
+        result.totalCycles += cycles;
+        result.checksum ^= value;
+    }
+    if(bench->iterations == 0)
+        result.minCycles = 0;
+    return result;
+}
+
+void BENCH_Report(USART_TypeDef *USARTx, const Benchmark_t *bench, const BenchResult_t *result){
+    char line[BENCH_LINE_SIZE];
+    StringBuilder sb = StringBuilderInit(line, sizeof(line));
+    uint64_t avgCycles = (result->iterations == 0) ? 0 : result->totalCycles / result->iterations;
+
+    StringBuilderAppend(&sb, "BENCH,");
+    StringBuilderAppend(&sb, bench->name);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, result->iterations);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, result->minCycles);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU64(&sb, avgCycles);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, result->maxCycles);
+    StringBuilderAppend(&sb, ",0x");
+    StringBuilderAppendHex(&sb, result->checksum, 8);
+    StringBuilderAppend(&sb, "\r\n");
+    BENCH_Print(USARTx, &sb);
+}
+
+void BENCH_RunAll(USART_TypeDef *USARTx){
+    char line[BENCH_LINE_SIZE];
+    StringBuilder sb = StringBuilderInit(line, sizeof(line));
+
+    StringBuilderAppend(&sb, "BENCH_BEGIN,");
+    StringBuilderAppendU32(&sb, CLOCK_GetSystemClockSpeed());   // Lets the helper convert cycles to time
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, BENCH_IsCycleCounterRunning()); // 0 when only the checksums are meaningful
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, BenchOverhead);
+    StringBuilderAppend(&sb, "\r\n");
+    BENCH_Print(USARTx, &sb);
+
+    for(uint8_t i = 0; i < BenchmarkCount; i++){
+        BenchResult_t result = BENCH_Run(&Benchmarks[i]);
+        BENCH_Report(USARTx, &Benchmarks[i], &result);
+    }
+
+    StringBuilderClear(&sb);
+    StringBuilderAppend(&sb, "BENCH_END,");
+    StringBuilderAppendU32(&sb, BenchmarkCount);
+    StringBuilderAppend(&sb, "\r\n");
+    BENCH_Print(USARTx, &sb);
+}
+
+bool BENCH_Check(USART_TypeDef *USARTx, const char *name, bool passed){
+    char line[BENCH_LINE_SIZE];
+    StringBuilder sb = StringBuilderInit(line, sizeof(line));
+    StringBuilderAppend(&sb, "CHECK,");
+    StringBuilderAppend(&sb, name);
+    StringBuilderAppend(&sb, passed ? ",PASS\r\n" : ",FAIL\r\n");
+    BENCH_Print(USARTx, &sb);
+    if(!passed)
+        BenchFailedChecks++;
+    return passed;
+}
+
+uint32_t BENCH_GetFailedChecks(void){
+    return BenchFailedChecks;
+}
+
+#ifdef ACDC_QEMU
+void BENCH_Exit(uint32_t status){
+    const uint32_t block[2] = {SEMIHOSTING_APPLICATION_EXIT, status};   // Plain SYS_EXIT on a 32-bit core has no status
+    BENCH_Semihost(SEMIHOSTING_SYS_EXIT_EXTENDED, block);
+    while(1){}
+}
+#endif
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static uint32_t BENCH_Empty(uint32_t iteration){
+    return iteration;
+}
+
+static void BENCH_Print(USART_TypeDef *USARTx, const StringBuilder *sb){
+#ifdef ACDC_QEMU
+    (void)USARTx;
+    BENCH_Semihost(SEMIHOSTING_SYS_WRITE0, sb->buffer); // StringBuilder is always null terminated
+#else
+    USART_SendBuffer(USARTx, sb->buffer, sb->length);
+#endif
+}
+
+#ifdef ACDC_QEMU
+static uint32_t BENCH_Semihost(uint32_t operation, const void *argument){
+    register uint32_t r0 __asm__("r0") = operation;
+    register const void *r1 __asm__("r1") = argument;
+    __asm__ volatile("bkpt 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+    return r0;
+}
+#endif
+#pragma endregion
@@ -0,0 +1,187 @@
+/**
+ * @file ACDC_CALIBRATION.c
+ * @author Devin Marx
+ * @brief Implementation of fixed point ADC and DAC calibration stored in a flash page
+ * @version 0.1
+ * @date 2024-04-23
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_CALIBRATION.h"
+#include "ACDC_WATCHDOG.h"
+#include <stddef.h>          // offsetof
+
+#define CALIBRATION_MAGIC       0x4C414341UL    // "ACAL"
+#define CALIBRATION_VERSION     1               // Change when CALIBRATION_Set_t changes, older pages are ignored
+#define CALIBRATION_TABLE_SHIFT 12              // q15 codes between table points (2^12 = 4096)
+#define CALIBRATION_UNITY_FRACT 0x4000          // 0.5 * 2^1 = gain of 1
+#define CALIBRATION_UNITY_SHIFT 1
+#define CALIBRATION_FLASH_TIMEOUT_US 100000    // Longest a page erase or write may take (Erase is 20 - 40ms)
+
+typedef struct{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;                              // sizeof(CALIBRATION_Set_t)
+    CALIBRATION_Set_t set;
+    uint32_t crc;                               // STM32 CRC unit over everything before it
+}CALIBRATION_Page_t;
+
+_Static_assert(sizeof(CALIBRATION_Page_t) % sizeof(uint32_t) == 0, "The CRC unit works on whole words");
+
+extern uint32_t _scalibration;                  // Start of the CALIBRATION flash page (STM32F103RBTx_FLASH.ld)
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Calculates the CRC of a page with the STM32 CRC unit (CRC-32/MPEG-2)
+/// @param page Page to calculate the CRC of (Every word before crc)
+/// @return CRC of the page
+static uint32_t CALIBRATION_CRC(const CALIBRATION_Page_t *page);
+
+/// @brief Looks up a value in the piecewise linear table
+/// @param table CALIBRATION_TABLE_POINTS outputs
+/// @param value Value to look up
+/// @return Value between the two nearest table points
+static q15_t CALIBRATION_Lookup(const q15_t *table, q15_t value);
+
+/// @brief Waits for the flash to finish an operation and clears its status flags
+/// @return True if it finished without an error, false otherwise
+static bool CALIBRATION_FlashWait(void);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void CALIBRATION_Init(CALIBRATION_t *calibration){
+    calibration->offset = 0;
+    calibration->gainFract = CALIBRATION_UNITY_FRACT;
+    calibration->gainShift = CALIBRATION_UNITY_SHIFT;
+    CALIBRATION_SetTable(calibration, 0);
+}
+
+bool CALIBRATION_SetTwoPoint(CALIBRATION_t *calibration, q15_t measured1, q15_t actual1, q15_t measured2, q15_t actual2){
+    int32_t measuredSpan = (int32_t)measured2 - measured1;
+    int32_t actualSpan = (int32_t)actual2 - actual1;
+    if(measuredSpan == 0 || actualSpan == 0 || (measuredSpan < 0) != (actualSpan < 0))
+        return false;
+    if(measuredSpan < 0){
+        measuredSpan = -measuredSpan;
+        actualSpan = -actualSpan;
+    }
+
+    // gain = actualSpan / measuredSpan = gainFract * 2^gainShift, with gainFract < 1.0
+    int8_t shift = 0;
+    while(actualSpan >= (measuredSpan << shift))
+        if(++shift > CALIBRATION_MAX_SHIFT)
+            return false;
+    int32_t fract = (int32_t)(((int64_t)actualSpan << (15 - shift)) / measuredSpan);
+    if(fract == 0)
+        return false;
+
+    // actual1 = (measured1 + offset) * gain -> offset = actual1 / gain - measured1
+    int64_t offset = ((int64_t)actual1 * measuredSpan) / actualSpan - measured1;
+    calibration->offset = (q15_t)__SSAT((int32_t)offset, 16);
+    calibration->gainFract = (q15_t)fract;
+    calibration->gainShift = shift;
+    CALIBRATION_SetTable(calibration, 0);
+    return true;
+}
+
+void CALIBRATION_SetTable(CALIBRATION_t *calibration, const q15_t *table){
+    calibration->useTable = table != 0;
+    for(uint8_t i = 0; i < CALIBRATION_TABLE_POINTS; i++)
+        calibration->table[i] = table != 0 ? table[i] : 0;
+}
+
+void CALIBRATION_ApplyQ15(const CALIBRATION_t *calibration, q15_t *values, uint32_t count){
+    if(calibration->offset != 0)
+        arm_offset_q15(values, calibration->offset, values, count);     // Saturates, in place is allowed
+    if(calibration->gainFract != CALIBRATION_UNITY_FRACT || calibration->gainShift != CALIBRATION_UNITY_SHIFT)
+        arm_scale_q15(values, calibration->gainFract, calibration->gainShift, values, count);
+    if(calibration->useTable)
+        for(uint32_t i = 0; i < count; i++)
+            values[i] = CALIBRATION_Lookup(calibration->table, values[i]);
+}
+
+q15_t CALIBRATION_CorrectQ15(const CALIBRATION_t *calibration, q15_t value){
+    CALIBRATION_ApplyQ15(calibration, &value, 1);
+    return value;
+}
+
+uint16_t CALIBRATION_ToDACCode(const CALIBRATION_t *calibration, q15_t value){
+    return (uint16_t)(((int32_t)CALIBRATION_CorrectQ15(calibration, value) + 32768) >> 4);
+}
+
+bool CALIBRATION_Load(CALIBRATION_Set_t *set){
+    const CALIBRATION_Page_t *page = (const CALIBRATION_Page_t*)&_scalibration;
+    if(page->magic == CALIBRATION_MAGIC && page->version == CALIBRATION_VERSION &&
+       page->size == sizeof(CALIBRATION_Set_t) && page->crc == CALIBRATION_CRC(page)){
+        *set = page->set;
+        return true;
+    }
+
+    CALIBRATION_Init(&set->adc[0]);             // Erased or never written
+    CALIBRATION_Init(&set->adc[1]);
+    CALIBRATION_Init(&set->dac);
+    return false;
+}
+
+bool CALIBRATION_Save(const CALIBRATION_Set_t *set){
+    CALIBRATION_Page_t page = {CALIBRATION_MAGIC, CALIBRATION_VERSION, sizeof(CALIBRATION_Set_t), *set, 0};
+    page.crc = CALIBRATION_CRC(&page);
+    uint32_t address = (uint32_t)&_scalibration;
+
+    // Unlock the flash controller {See PM0075-10}
+    if(READ_BIT(FLASH->CR, FLASH_CR_LOCK)){
+        WRITE_REG(FLASH->KEYR, FLASH_KEY1);
+        WRITE_REG(FLASH->KEYR, FLASH_KEY2);
+    }
+
+    // Erase the page
+    SET_BIT(FLASH->CR, FLASH_CR_PER);
+    WRITE_REG(FLASH->AR, address);
+    SET_BIT(FLASH->CR, FLASH_CR_STRT);
+    bool written = CALIBRATION_FlashWait();
+    CLEAR_BIT(FLASH->CR, FLASH_CR_PER);
+
+    // Program it a half word at a time (The only width the flash controller writes)
+    const uint16_t *source = (const uint16_t*)&page;
+    volatile uint16_t *destination = (volatile uint16_t*)address;
+    SET_BIT(FLASH->CR, FLASH_CR_PG);
+    for(uint32_t i = 0; written && i < sizeof(page) / sizeof(uint16_t); i++){
+        destination[i] = source[i];
+        written = CALIBRATION_FlashWait() && destination[i] == source[i];
+    }
+    CLEAR_BIT(FLASH->CR, FLASH_CR_PG);
+    SET_BIT(FLASH->CR, FLASH_CR_LOCK);
+    return written;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static uint32_t CALIBRATION_CRC(const CALIBRATION_Page_t *page){
+    SET_BIT(RCC->AHBENR, RCC_AHBENR_CRCEN);
+    WRITE_REG(CRC->CR, CRC_CR_RESET);
+    const uint32_t *words = (const uint32_t*)page;
+    for(uint32_t i = 0; i < offsetof(CALIBRATION_Page_t, crc) / sizeof(uint32_t); i++)
+        WRITE_REG(CRC->DR, words[i]);
+    return READ_REG(CRC->DR);
+}
+
+static q15_t CALIBRATION_Lookup(const q15_t *table, q15_t value){
+    uint32_t position = (uint32_t)((int32_t)value + 32768);            // 0 - 65535
+    uint32_t index = position >> CALIBRATION_TABLE_SHIFT;              // 0 - 15, the last point is only interpolated towards
+    int32_t fraction = (int32_t)(position & ((1UL << CALIBRATION_TABLE_SHIFT) - 1));
+    int32_t low = table[index];
+    int32_t high = table[index + 1];
+    return (q15_t)(low + (((high - low) * fraction) >> CALIBRATION_TABLE_SHIFT));
+}
+
+static bool CALIBRATION_FlashWait(void){
+    uint32_t start = WATCHDOG_WaitStart();
+    while(READ_BIT(FLASH->SR, FLASH_SR_BSY)){
+        if(WATCHDOG_WaitExpired(start, CALIBRATION_FLASH_TIMEOUT_US, "FLASH BSY"))
+            return false;
+    }
+    bool ok = !READ_BIT(FLASH->SR, FLASH_SR_PGERR | FLASH_SR_WRPRTERR);
+    WRITE_REG(FLASH->SR, FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPRTERR);   // Write 1 to clear
+    return ok;
+}
+#pragma endregion
@@ -0,0 +1,192 @@
+/**
+ * @file ACDC_CAPTURE.c
+ * @author Devin Marx
+ * @brief Implementation of oscilloscope style triggered capture
+ * @version 0.1
+ * @date 2024-04-21
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_CAPTURE.h"
+#include "ACDC_TELEMETRY.h"
+
+#define CAPTURE_HEADER_SIZE       14    // captureNumber (2), length (2), preTrigger (2), sampleRate (4), offset (2), count (2)
+#define CAPTURE_SAMPLES_PER_FRAME ((TELEMETRY_MAX_PAYLOAD - CAPTURE_HEADER_SIZE) / sizeof(q15_t))
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Checks the trigger condition for one sample
+/// @param capture Armed capture with a full pre-trigger history
+/// @param sample Sample being checked
+/// @param number ACQUIRE sample number of the sample
+/// @return True if the capture should trigger on this sample, false otherwise
+static bool CAPTURE_IsTrigger(CAPTURE_t *capture, q15_t sample, uint32_t number);
+
+/// @brief Rotates the circular buffer so the window starts at index 0 and marks the capture as done
+/// @param capture Capture that just collected its last sample
+static void CAPTURE_Freeze(CAPTURE_t *capture);
+
+/// @brief Reverses count samples in place
+/// @param samples Samples to reverse
+/// @param count Number of samples
+static void CAPTURE_Reverse(q15_t *samples, uint16_t count);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool CAPTURE_Init(CAPTURE_t *capture, q15_t *buffer, uint16_t length, uint32_t sampleRate){
+    if(length < 2)
+        return false;
+
+    capture->buffer = buffer;
+    capture->length = length;
+    capture->preTrigger = 0;
+    capture->sampleRate = sampleRate;
+    capture->type = CAPTURE_RISING_EDGE;
+    capture->level = 0;
+    capture->state = CAPTURE_IDLE;
+    capture->externalPending = false;
+    capture->captureNumber = 0;
+    return true;
+}
+
+bool CAPTURE_SetTrigger(CAPTURE_t *capture, CAPTURE_TriggerType CAPTURE_x, q15_t level, uint16_t preTrigger){
+    if(preTrigger >= capture->length)
+        return false;
+
+    CAPTURE_Disarm(capture);
+    capture->type = CAPTURE_x;
+    capture->level = level;
+    capture->preTrigger = preTrigger;
+    return true;
+}
+
+void CAPTURE_Arm(CAPTURE_t *capture){
+    capture->state = CAPTURE_IDLE;      // Keeps CAPTURE_TriggerExternal out while the fields are reset
+    capture->writeIndex = 0;
+    capture->history = 0;
+    capture->remaining = 0;
+    capture->externalPending = false;
+    capture->state = CAPTURE_ARMED;
+}
+
+void CAPTURE_Disarm(CAPTURE_t *capture){
+    capture->state = CAPTURE_IDLE;
+    capture->externalPending = false;
+}
+
+void CAPTURE_TriggerExternal(CAPTURE_t *capture){
+    if(capture->state != CAPTURE_ARMED || capture->externalPending)
+        return;
+    capture->externalSample = ACQUIRE_GetSampleNumber();
+    capture->externalPending = true;    // Set last, CAPTURE_AddBlock reads externalSample once it sees this
+}
+
+bool CAPTURE_AddBlock(CAPTURE_t *capture, const ACQUIRE_Block_t *block){
+    if((capture->state != CAPTURE_ARMED && capture->state != CAPTURE_TRIGGERED) || block->length == 0)
+        return false;
+
+    uint32_t step = ACQUIRE_BLOCK_SIZE / block->length;     // ACQUIRE samples per sample after decimation
+    for(uint32_t i = 0; i < block->length; i++){
+        q15_t sample = block->samples[i];
+        uint16_t index = capture->writeIndex;
+        capture->buffer[index] = sample;
+        capture->writeIndex = (index + 1 == capture->length) ? 0 : index + 1;
+
+        if(capture->state == CAPTURE_ARMED){
+            // Edges and slopes need a previous sample, so at least one sample is collected before checking
+            if(capture->history < capture->preTrigger || capture->history == 0)
+                capture->history++;
+            else if(CAPTURE_IsTrigger(capture, sample, block->firstSample + i * step)){
+                capture->state = CAPTURE_TRIGGERED;
+                capture->triggerIndex = index;
+                capture->triggerSample = block->firstSample + i * step;
+                capture->remaining = capture->length - capture->preTrigger - 1;    // The trigger sample is the first post-trigger sample
+            }
+        }
+        else
+            capture->remaining--;
+
+        capture->previous = sample;
+        if(capture->state == CAPTURE_TRIGGERED && capture->remaining == 0){
+            CAPTURE_Freeze(capture);
+            return true;
+        }
+    }
+    return false;
+}
+
+CAPTURE_State CAPTURE_GetState(const CAPTURE_t *capture){
+    return capture->state;
+}
+
+const q15_t* CAPTURE_GetSamples(const CAPTURE_t *capture){
+    return capture->buffer;
+}
+
+bool CAPTURE_Send(const CAPTURE_t *capture){
+    if(capture->state != CAPTURE_DONE)
+        return false;
+
+    bool sent = true;
+    for(uint16_t offset = 0; offset < capture->length; offset += CAPTURE_SAMPLES_PER_FRAME){
+        uint16_t count = capture->length - offset;
+        if(count > CAPTURE_SAMPLES_PER_FRAME)
+            count = CAPTURE_SAMPLES_PER_FRAME;
+
+        TELEMETRY_Begin(TELEMETRY_CAPTURE_DATA);
+        TELEMETRY_AddU16(capture->captureNumber);
+        TELEMETRY_AddU16(capture->length);
+        TELEMETRY_AddU16(capture->preTrigger);
+        TELEMETRY_AddU32(capture->sampleRate);
+        TELEMETRY_AddU16(offset);
+        TELEMETRY_AddU16(count);
+        TELEMETRY_AddBytes(&capture->buffer[offset], count * sizeof(q15_t));
+        sent &= TELEMETRY_End();
+    }
+    return sent;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static bool CAPTURE_IsTrigger(CAPTURE_t *capture, q15_t sample, uint32_t number){
+    q15_t level = capture->level;
+    q15_t previous = capture->previous;
+    switch(capture->type){
+        case CAPTURE_RISING_EDGE:   return previous < level && sample >= level;
+        case CAPTURE_FALLING_EDGE:  return previous > level && sample <= level;
+        case CAPTURE_ABOVE:         return sample >= level;
+        case CAPTURE_BELOW:         return sample <= level;
+        case CAPTURE_RISING_SLOPE:  return (int32_t)sample - previous >= level;
+        case CAPTURE_FALLING_SLOPE: return (int32_t)previous - sample >= level;
+        case CAPTURE_EXTERNAL:
+            // Trigger on the sample taken when the event happened (Or the first one after the history filled up)
+            if(!capture->externalPending || (int32_t)(number - capture->externalSample) < 0)
+                return false;
+            capture->externalPending = false;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void CAPTURE_Freeze(CAPTURE_t *capture){
+    // Rotate left by the start of the window with three reversals (No second buffer needed)
+    uint16_t length = capture->length;
+    uint16_t start = (capture->triggerIndex + length - capture->preTrigger) % length;
+    if(start != 0){
+        CAPTURE_Reverse(capture->buffer, start);
+        CAPTURE_Reverse(&capture->buffer[start], length - start);
+        CAPTURE_Reverse(capture->buffer, length);
+    }
+    capture->captureNumber++;
+    capture->state = CAPTURE_DONE;
+}
+
+static void CAPTURE_Reverse(q15_t *samples, uint16_t count){
+    for(uint16_t i = 0, j = count - 1; i < j; i++, j--){
+        q15_t temp = samples[i];
+        samples[i] = samples[j];
+        samples[j] = temp;
+    }
+}
+#pragma endregion
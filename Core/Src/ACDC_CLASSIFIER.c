@@ -0,0 +1,159 @@
+/**
+ * @file ACDC_CLASSIFIER.c
+ * @author Devin Marx
+ * @brief Implementation of the CMSIS-NN waveform classifier
+ * @version 0.1
+ * @date 2024-04-24
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_CLASSIFIER.h"
+#include "ACDC_TELEMETRY.h"
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Gets log2 of a power of 2
+/// @param value Value to check
+/// @param shift Set to log2(value)
+/// @return True if value is a power of 2, false otherwise
+static bool CLASSIFIER_Log2(uint32_t value, uint8_t *shift);
+
+/// @brief Turns the feature means of a full window into q7 features and classifies them
+/// @param classifier Classifier with a full window
+static void CLASSIFIER_Finish(CLASSIFIER_t *classifier);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool CLASSIFIER_Init(CLASSIFIER_t *classifier, const CLASSIFIER_Network_t *network){
+    uint8_t windowShift;
+    if(network->layerCount == 0 || network->inputSize > CLASSIFIER_MAX_WIDTH || network->inputShift > 15 ||
+       !CLASSIFIER_Log2(network->inputSize, &classifier->meanShift) ||
+       !CLASSIFIER_Log2(network->windowSize, &windowShift) || windowShift < classifier->meanShift)
+        return false;
+
+    uint16_t inputSize = network->inputSize;
+    for(uint8_t i = 0; i < network->layerCount; i++){
+        const CLASSIFIER_Layer_t *layer = &network->layers[i];
+        if(layer->inputSize != inputSize || layer->outputSize == 0 || layer->outputSize > CLASSIFIER_MAX_WIDTH ||
+           layer->outShift == 0 || layer->outShift > 31 || layer->biasShift > 24)
+            return false;
+        inputSize = layer->outputSize;
+    }
+    if(inputSize > CLASSIFIER_MAX_CLASSES)
+        return false;
+
+    classifier->network = network;
+    classifier->groupShift = windowShift - classifier->meanShift;
+    classifier->result = (CLASSIFIER_Result_t){0};
+    classifier->result.classCount = inputSize;
+    CLASSIFIER_Reset(classifier);
+    return true;
+}
+
+bool CLASSIFIER_AddBlock(CLASSIFIER_t *classifier, const ACQUIRE_Block_t *block){
+    bool classified = false;
+    uint16_t groupSize = 1 << classifier->groupShift;
+    uint32_t step = ACQUIRE_BLOCK_SIZE / block->length;     // ACQUIRE samples per sample after decimation
+    for(uint32_t i = 0; i < block->length; i++){
+        if(classifier->featureCount == 0 && classifier->groupCount == 0){
+            classifier->firstSample = block->firstSample + i * step;
+            classifier->timestamp = block->timestamp + (uint32_t)(((uint64_t)i * block->samplePeriod) / 1000);
+        }
+
+        classifier->sum += block->samples[i];
+        if(++classifier->groupCount < groupSize)
+            continue;
+
+        q15_t mean = (q15_t)(classifier->sum >> classifier->groupShift);
+        classifier->features[classifier->featureCount++] = mean;
+        classifier->featureSum += mean;
+        classifier->sum = 0;
+        classifier->groupCount = 0;
+        if(classifier->featureCount == classifier->network->inputSize){
+            CLASSIFIER_Finish(classifier);
+            classified = true;
+        }
+    }
+    return classified;
+}
+
+uint8_t CLASSIFIER_Run(CLASSIFIER_t *classifier, const q7_t *features){
+    const CLASSIFIER_Network_t *network = classifier->network;
+    const q7_t *input = features;
+    q7_t *output = classifier->activations[0];
+    for(uint8_t i = 0; i < network->layerCount; i++){
+        const CLASSIFIER_Layer_t *layer = &network->layers[i];
+        arm_fully_connected_q7(input, layer->weights, layer->inputSize, layer->outputSize, layer->biasShift, layer->outShift,
+                               layer->bias, output, classifier->vecBuffer);
+        if(layer->relu)
+            arm_relu_q7(output, layer->outputSize);
+        input = output;
+        output = (output == classifier->activations[0]) ? classifier->activations[1] : classifier->activations[0];
+    }
+
+    // input holds the outputs of the last layer. The class is picked from them, softmax only gives the scores
+    CLASSIFIER_Result_t *result = &classifier->result;
+    uint8_t best = 0;
+    for(uint8_t i = 1; i < result->classCount; i++){
+        if(input[i] > input[best])
+            best = i;
+    }
+    arm_softmax_q7(input, result->classCount, result->scores);
+    result->classIndex = best;
+    result->firstSample = 0;
+    result->timestamp = 0;
+    return best;
+}
+
+const CLASSIFIER_Result_t* CLASSIFIER_GetResult(const CLASSIFIER_t *classifier){
+    return &classifier->result;
+}
+
+void CLASSIFIER_Reset(CLASSIFIER_t *classifier){
+    classifier->groupCount = 0;
+    classifier->featureCount = 0;
+    classifier->sum = 0;
+    classifier->featureSum = 0;
+}
+
+bool CLASSIFIER_SendResult(const CLASSIFIER_t *classifier){
+    const CLASSIFIER_Result_t *result = &classifier->result;
+    TELEMETRY_Begin(TELEMETRY_CLASSIFIER_EVENT);
+    TELEMETRY_AddU32(result->firstSample);
+    TELEMETRY_AddU32(result->timestamp);
+    TELEMETRY_AddU8(result->classIndex);
+    TELEMETRY_AddU8(result->classCount);
+    TELEMETRY_AddBytes(result->scores, result->classCount);
+    return TELEMETRY_End();
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static bool CLASSIFIER_Log2(uint32_t value, uint8_t *shift){
+    if(value == 0 || (value & (value - 1)) != 0)
+        return false;
+    *shift = 0;
+    while(value > 1){
+        value >>= 1;
+        (*shift)++;
+    }
+    return true;
+}
+
+static void CLASSIFIER_Finish(CLASSIFIER_t *classifier){
+    // Remove the mean of the window so the network only sees the shape, then scale down to q7.
+    // The features are built in the second activation buffer, the first layer writes into the first one
+    const CLASSIFIER_Network_t *network = classifier->network;
+    q15_t mean = (q15_t)(classifier->featureSum >> classifier->meanShift);
+    q7_t *features = classifier->activations[1];
+    for(uint16_t i = 0; i < network->inputSize; i++)
+        features[i] = (q7_t)__SSAT(((int32_t)classifier->features[i] - mean) >> network->inputShift, 8);
+
+    uint32_t firstSample = classifier->firstSample;
+    uint32_t timestamp = classifier->timestamp;
+    CLASSIFIER_Run(classifier, features);
+    classifier->result.firstSample = firstSample;
+    classifier->result.timestamp = timestamp;
+    CLASSIFIER_Reset(classifier);
+}
+#pragma endregion
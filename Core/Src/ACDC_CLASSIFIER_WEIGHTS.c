@@ -0,0 +1,132 @@
+/**
+ * @file ACDC_CLASSIFIER_WEIGHTS.c
+ * @author Devin Marx
+ * @brief Default network for ACDC_CLASSIFIER (GENERATED by Python_Helper/CLASSIFIER_Helper.py, do not edit)
+ *
+ * 64 -> 16 -> 16 -> 4 fully connected q7 network (1380 bytes of flash) that sorts 64 sample windows
+ * into normal, clipped, spike, dropout. The q7 network matched 86.0% of the test windows.
+ *
+ * @version 0.1
+ * @date 2024-04-24
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_CLASSIFIER.h"
+
+static const q7_t CLASSIFIER_Weights0[1024] = {
+      -3,  -20,    8,  -16,   -9,   10,    3,   -5,   -9,  -17,   -6,  -29,  -15,   17,   42,   -6,
+      22,   48,   46,   10,   22,    3,    1,  -33,   10,    1,  -22,   -5,  -10,   -6,   -1,    4,
+      -4,  -29,   12,   -3,   22,  -17,  -13,   13,   -3,   16,   -7,  -13,    0,   -7,   19,    2,
+     -12,  -14,    0,   11,   -1,   11,  -13,    9,    6,   -2,   -7,   -4,   10,   19,  -12,    4,
+     -10,   -3,   -7,   -6,   -4,   -9,   -8,  -10,  -17,  -16,  -15,  -19,  -21,  -19,  -21,  -19,
+     -25,  -23,  -26,  -25,  -24,  -26,  -24,  -18,  -17,  -18,  -10,  -14,  -13,   -7,   -9,   -5,
+       2,   10,    8,    9,   14,   15,   17,   20,   18,   25,   26,   29,   24,   29,   25,   28,
+      23,   24,   25,   24,   22,   20,   19,   17,   16,   14,    9,   11,    4,   10,   -1,   18,
+      -6,   16,   -8,  -11,   19,  -14,  -22,    9,   -2,  -18,  -34,    7,   -6,  -26,  -42,   -2,
+     -12,    9,  -52,  -25,  -24,   14,  -16,  -19,  -36,  -22,   -4,   -8,  -31,   20,  -23,  -16,
+     -10,   36,    2,   27,  -14,   -6,    7,   16,    8,   33,   31,   31,  -19,   17,  -21,   34,
+      41,   35,   -7,   12,    4,   11,   28,   -2,   -6,    4,   27,  -33,    8,   -3,  -11,  -22,
+       8,   -3,   -4,    0,    6,    4,   -1,   -3,    0,    5,    2,    7,   -5,    4,   -3,   -8,
+       3,   10,    1,   -6,  -11,    3,    6,   -8,   -4,   -8,   -6,   -3,    5,   -7,   -6,   -1,
+      -4,   -8,   -2,   -1,   -4,   -7,    4,    6,    3,   -5,    0,  -26,   -9,    2,    4,    0,
+       7,   11,  -15,  -19,  -16,    0,   -7,   21,   52,   35,   17,   16,   34,   58,   28,  -28,
+      -9,  -12,   19,    5,    1,   14,    5,    9,  -14,    0,   17,    5,   18,    7,   20,   -3,
+       8,   18,    3,   23,    0,    2,   20,   18,   -4,   23,   24,  -24,   22,    1,   11,  -88,
+     -81,  -83,  -11,    7,   -5,   -2,   -5,    7,    8,    4,  -11,    4,   10,   10,   26,    5,
+      23,  -12,    1,   10,   11,   10,   12,   10,   21,   10,  -31,   11,   10,   17,  -21,   16,
+       1,   -4,    1,   -5,   -2,    3,   -2,   -1,    2,   -7,   -1,   -1,   -3,    0,    2,   -3,
+       3,    3,    4,   -7,    0,    4,    2,    1,   -2,   -1,    0,   11,   -3,   -4,    1,   -3,
+       0,   -8,    4,    4,    5,   -6,    0,    1,   -1,   10,   -6,    4,  -19,    6,    7,    6,
+       0,    5,  -11,  -15,   -6,   -5,   -4,   -8,   -9,  -16,  -42,  -55,    8,   35,   18,   21,
+       6,   -5,   -8,   -3,   25,    2,   -6,   -6,   -4,   -8,    2,   19,   12,   -4,  -23,    2,
+      11,    3,   -4,  -11,    3,   28,    9,  -20,  -31,    8,   20,   21,   -1,  -27,   -2,    5,
+       2,    4,   15,    6,  -13,  -31,    7,   11,   14,   15,    6,  -18,  -31,    3,   17,   18,
+      -4,    4,   -4,   -6,   -9,    4,    5,    4,  -14,   20,   16,  -33,   -1,    5,   13,   -7,
+     -18,   -2,    0,   -2,  -13,   -1,   -9,  -14,    8,    0,    2,    0,  -19,   -7,   -4,  -10,
+     -39,  -13,   -4,   18,   22,   13,   51,   30,    3,    1,    5,  -22,   -6,   13,    1,   -6,
+      -6,    5,  -24,  -14,  -12,   19,    0,   -3,    6,  -12,  -12,   -5,   10,   12,    6,    5,
+      15,  -10,   -2,   -2,  -11,    7,   -2,    3,    3,   -5,  -31,    8,    7,    3,  -14,    1,
+     -39,    3,    5,    0,   16,    6,  -11,   -6,    1,  -19,    7,   17,   18,   21,    6,   12,
+       2,    5,   -3,    0,    5,   17,   29,   15,    2,  -13,  -12,  -26,  -14,    9,   -5,   13,
+       6,   -9,  -16,  -21,  -23,  -11,    9,   24,    4,   15,   15,   -6,   -3,   11,   -3,   15,
+      22,   21,    2,    9,    6,  -11,   -1,    6,    1,   -1,   10,   -2,    4,   -3,    4,  -11,
+       8,   -2,    0,    0,    3,   -4,    3,   -3,   -8,    4,    6,   -5,  -15,   -9,    1,  -17,
+     -15,   -3,   17,  -13,  -20,  -11,   -9,    3,   10,   -4,  -13,    4,   19,    1,   -2,    4,
+       0,   -5,    4,   13,   17,    0,   -8,  -12,   20,    6,   -2,  -15,   -6,   18,    6,   -7,
+      -2,    9,   -1,  -11,   -3,    5,    8,    1,   22,   16,  -21,  -32,    6,   37,   14,  -18,
+     -24,    3,    4,    9,   -7,   18,    4,   -9,    1,    7,    4,   31,   44,   39,   24,   10,
+       1,   -1,  -13,  -12,  -20,  -14,  -10,   -8,   26,  -21,    5,  -22,  -17,   -9,    2,   -2,
+     -10,  -15,  -15,  -10,   -1,   -8,  -17,   24,  -22,  -14,   -7,    3,   -1,   -9,   28,   -3,
+     -22,  -17,  -10,    0,   14,  -16,    8,    6,   -5,  -17,  -11,   14,   -6,   -1,   -9,    9,
+      -9,  -11,   16,  -22,   10,  -11,   -5,  -14,    1,   -5,   -5,   -4,   -4,   12,   23,   -6,
+     -12,   22,   -4,   18,   -8,   12,   -1,   -3,   10,   -5,  -26,  -23,  -25,  -27,  -55,  -39,
+      36,   71,   23,  -11,   23,   -5,    1,   29,    4,   16,   -5,   15,   -6,   19,   16,   17,
+     -10,   -1,    2,   12,   -2,    2,    7,   -1,   -3,    6,  -33,   11,   -9,   14,   -3,    9,
+       1,    9,    1,   -1,    5,    0,    1,   11,    5,    1,    0,    0,    7,    2,   -2,    9,
+      12,   -1,   -4,    4,    0,    2,    7,   16,   -2,   -1,   -3,    6,    2,    8,    5,   -3,
+      13,    9,   -1,  -10,   -1,   11,   17,    7,   -5,   -7,    6,   14,   11,   -4,  -14,    5,
+      16,   20,   -3,   -4,   -2,    2,   -9,    9,   25,   16,  -13,  -16,    9,   10,    7,    3,
+      -1,    3,   -9,    2,    5,    0,    0,    4,  -11,   -1,   -1,    3,   12,    0,   -3,   -3,
+       1,    7,    3,   -4,   -5,    3,    7,    6,   -9,   -2,    2,    4,    1,    2,    3,   -5,
+       7,    0,   -2,   -1,    0,   -4,    0,    2,    1,   -2,   -8,    1,   -8,    1,    2,    7,
+       5,    1,   -5,   -8,    5,   12,   14,    8,   36,   39,  -43,  -59,  -21,  -15,  -17,  -26,
+     -11,   -7,   -7,   -2,  -17,  -10,   -9,   -3,  -14,   -1,  -16,   -3,  -18,  -15,    6,  -22,
+     -14,    9,  -20,   -7,   -7,  -18,  -16,   -9,    3,  -18,  -12,  -21,  -15,   11,  -13,  -28,
+     -13,   -6,  -30,    3,   -2,  -14,  -21,  -14,  -24,    0,   -8,   -5,  -31,   -3,   -7,  -26,
+       2,   -7,  -26,  -15,   -3,  -16,    7,  -24,   -5,  -27,   -8,   -2,   -7,  -19,    3,  -22,
+     -14,    0,  -11,   -1,  -11,   11,   -9,   -1,   -5,   -6,    2,   -4,   -3,    4,    0,   -1,
+       3,  -17,   11,   -9,   -6,    2,    6,  -16,    4,   -4,  -11,  -15,   10,    2,   20,  112,
+      -2,  -25,  -12,    2,   -7,  -13,  -11,    2,   -4,   -7,   -7,   -8,    4,  -10,   -1,    3,
+     -10,  -11,    4,   -5,   -4,    1,  -10,    4,    1,  -11,   -1,  -13,    5,    0,    2,  -11,
+};
+
+static const q7_t CLASSIFIER_Bias0[16] = {
+      -3,  101,  -24,    1,   -8,    7,   33,   -9,   -7,    0,  -14,   -8,   -1,   12,  -22,  -18,
+};
+
+static const q7_t CLASSIFIER_Weights1[256] = {
+     -11,    0,   -2,   14,    2,   16,  -14,  -11,    5,  -20,  -11,    4,  -35,   13,   -1,    3,
+      -1,    2,   -2,   -1,   -3,   -1,  -19,   -2,    6,    0,   -2,   -3,  -56,    0,  -23,   -5,
+      11,    5,    7,    3,    3,   -7,    1,   -6,    3,  -18,   13,   -2,   10,   -2,   -8,   -8,
+       6,   -9,    8,   -1,   -4,    4,  -14,    4,    2,    5,    0,   -1,  -36,    2,  -20,   -2,
+       7,   -2,    5,   -1,    2,   -4,   -4,   12,  -20,    9,   13,   -4,   -6,   -6,   -6,    3,
+      -3,  -75,   -8,    2,    1,    3,    1,   -4,    0,   -8,   -2,    2,    3,    3,    5,    1,
+       0,    6,   -7,   -2,   -6,   -1,   14,    0,    8,   -8,   -3,   -3,   35,    1,   21,   -6,
+      -1,   -7,   -8,    5,   -5,    8,   12,   -2,    3,    5,   -3,   -4,   -6,    8,   53,  -18,
+       0,    1,   -1,   -3,   -1,   -4, -108,    0,    2,    2,    0,   -1,  -22,   -2,   -8,   -1,
+       3,   -4,    4,   -7,    4,   -9,   -1,    3,   -4,    9,    2,    3,   -1,   -9,  -53,    5,
+       0,   11,  -15,  -18,    5,  -22,   16,   -1,   -1,   14,    1,    6,   24,  -15,    5,    8,
+       2,  -44,  -10,    2,    1,    1,   20,    5,   -4,   -4,    0,    3,   27,    2,    2,    5,
+      23,    0,    5,   -1,  -23,    1,    5,   20,    3,   13,   21,  -24,   19,    4,    9,  -40,
+      -1,   20,  -20,   10,   -8,   12,  -10,    1,   11,   -8,   -2,   -8,  -23,    9,   -4,  -10,
+      -8,    6,   -4,   14,    2,   16,   -6,   -7,    4,  -17,   -9,    2,  -18,   13,  -11,    3,
+       3,    5,   -4,   -6,    2,  -10,   26,    3,   -5,    2,    2,    3,   49,   -6,   27,    5,
+};
+
+static const q7_t CLASSIFIER_Bias1[16] = {
+       7,   83,    3,   26,   38,  103,   50,    8,   59,   14,    8,  108,    7,   -4,  -19,   -9,
+};
+
+static const q7_t CLASSIFIER_Weights2[64] = {
+       3,   70,    7,   15,    1,  -51,  -50,  -78,  -74,  -57,   32,   26,    8,  -29,    9,  -55,
+     -95,    9,    4,  -10,   14,  -64,   19,   28,   54,   40,  -76,   19, -103,  -67,  -65,   30,
+      29,  -83,   -8,    8,    1,   53,   32,   11,   51,   36,   48,  -29,   22,   36,   19,   23,
+      65,   18,  -12,  -22,  -42,   47,    0,   -5,  -15,  -12,    9,  -21,   79,   34,   54,  -25,
+};
+
+static const q7_t CLASSIFIER_Bias2[4] = {
+       4,    8,   40,  -48,
+};
+
+static const CLASSIFIER_Layer_t CLASSIFIER_Layers[3] = {
+    {CLASSIFIER_Weights0, CLASSIFIER_Bias0, 64, 16, 5, 10, true},
+    {CLASSIFIER_Weights1, CLASSIFIER_Bias1, 16, 16, 1, 4, true},
+    {CLASSIFIER_Weights2, CLASSIFIER_Bias2, 16, 4, 0, 6, false},
+};
+
+static const char * const CLASSIFIER_ClassNames[4] = {"normal", "clipped", "spike", "dropout"};
+
+const CLASSIFIER_Network_t CLASSIFIER_DefaultNetwork = {
+    CLASSIFIER_Layers, 3, 64, 64, 7, CLASSIFIER_ClassNames
+};
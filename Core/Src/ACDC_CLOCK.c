@@ -11,6 +11,9 @@
 #include "ACDC_CLOCK.h"
 #include "ACDC_TIMER.h"
 #include "ACDC_GPIO.h"
+#ifdef ACDC_THREAD_SAFE
+#include "ACDC_RTOS.h"
+#endif
 
 #define MAX_MCO_CLK_SPEED 50000000
 
@@ -38,6 +41,9 @@ static int APBxPrescalerToDivisor(APB_Prescaler APB_DIV_x);
 
 #pragma region PUBLIC_FUNCTIONS
 void CLOCK_SetSystemClockSpeed(SystemClockSpeed SCS_x){
+#ifdef ACDC_THREAD_SAFE
+    int32_t lock = osKernelLock();  // No other thread runs while the clocks and currentSCS change (Error before osKernelStart)
+#endif
 
     RCC->CFGR |= RCC_CFGR_PLLSRC;   // Use HSE as PLL Source,
     EnableHSI_DisablePLL();         // Disables the PLL
@@ -119,6 +125,11 @@ void CLOCK_SetSystemClockSpeed(SystemClockSpeed SCS_x){
     DisableHSI_EnablePLL(); // Enables the PLL
     TIMER_Init(SCS_x);      // Sets SysTick's Clock Speed to SCS_x (used for Millis and Delay)
     currentSCS = SCS_x;     // Set currentSCS to SCS_x when clocks are done configuring
+
+#ifdef ACDC_THREAD_SAFE
+    if(lock >= 0)
+        osKernelRestoreLock(lock);
+#endif
 }
 
 SystemClockSpeed CLOCK_GetSystemClockSpeed(void){
@@ -170,22 +181,22 @@ void CLOCK_SetAPB2Prescaler(APB_Prescaler APB_DIV_x){
 #pragma region PRIVATE_FUNCTIONS
 static void DisableHSI_EnablePLL(void){
     RCC->CR |= RCC_CR_PLLON;            // Turn on the PLL Clock
-    while(!(RCC->CR & RCC_CR_PLLRDY)){} // Wait until the PLL oscillator is ready
+    while(!READ_BIT(RCC->CR, RCC_CR_PLLRDY)){} // Wait until the PLL oscillator is ready
 
     RCC->CFGR &= ~RCC_CFGR_SW_Msk;      // Clear the SW bits
     RCC->CFGR |= RCC_CFGR_SW_PLL;       // Set PLL as SysClock
 
-    while(!(RCC->CFGR & RCC_CFGR_SWS_PLL)){}    // Wait until PLL is the SysClk
+    while(!READ_BIT(RCC->CFGR, RCC_CFGR_SWS_PLL)){}    // Wait until PLL is the SysClk
 }
 
 static void EnableHSI_DisablePLL(void){
     RCC->CR |= RCC_CR_HSEON;            // Turn on the HSE Clock
-    while(!(RCC->CR & RCC_CR_HSERDY)){} // Wait until HSE oscillator is ready
+    while(!READ_BIT(RCC->CR, RCC_CR_HSERDY)){} // Wait until HSE oscillator is ready
 
     RCC->CFGR &= ~RCC_CFGR_SW_Msk;      // Clear the SW bits
     RCC->CFGR |= RCC_CFGR_SW_HSE;       // Set HSE as SysClock
 
-    while(!(RCC->CFGR & RCC_CFGR_SWS_HSE)){}    // Wait until HSE is the SysClk
+    while(!READ_BIT(RCC->CFGR, RCC_CFGR_SWS_HSE)){}    // Wait until HSE is the SysClk
 
     RCC->CR &= ~RCC_CR_PLLON;           // Disable the PLL
 }
@@ -197,7 +208,7 @@ static void SetFlashMemorySpeed(SystemClockSpeed SCS_x, uint32_t RCC_CFGR_HPRE_x
     }  
     else{                                                   // AHB Prescaler is 2 or 3
         SET_BIT(FLASH->ACR, FLASH_ACR_PRFTBE);              // Enable the prefetch buffer
-        while((READ_BIT(FLASH->ACR, FLASH_ACR_PRFTBS))){}   // Wait until the buffer is enabled
+        while(!READ_BIT(FLASH->ACR, FLASH_ACR_PRFTBS)){}    // Wait until the buffer is enabled
     }
 
     uint32_t flashLatency;  //Desired flash latency {See RM-58}
@@ -0,0 +1,326 @@
+/**
+ * @file ACDC_CONTROL.c
+ * @author Devin Marx
+ * @brief Implementation of the fixed rate PID control loop
+ * @version 0.1
+ * @date 2024-04-19
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_CONTROL.h"
+#include "ACDC_CLOCK.h"
+#include "ACDC_DSP.h"
+#include "ACDC_WATCHDOG.h"
+
+#define CONTROL_STOP_TIMEOUT_US 5000    // Longest the last step's conversion may take (2 frames at APB / 256 with an 8MHz clock is 1ms)
+
+typedef bool (*CONTROL_StartReadFunction)(LTC1298_t LTC_ADC, LTCADC_Callback callback);
+
+typedef enum{
+    CONTROL_OUTPUT_NONE,
+    CONTROL_OUTPUT_DAC,
+    CONTROL_OUTPUT_PWM
+}CONTROL_OutputType;
+
+typedef struct{
+    q15_t kp;
+    q15_t ki;
+    q15_t kd;
+    uint8_t shift;
+}CONTROL_Gains_t;
+
+static LTC1298_t CONTROL_ADC;
+static CONTROL_StartReadFunction CONTROL_StartRead; // LTCADC_StartReadCH0CS or LTCADC_StartReadCH1CS
+static TIM_TypeDef *CONTROL_Timer;
+static uint32_t CONTROL_Rate;
+static uint32_t CONTROL_PeriodCycles;               // Core clock cycles between ticks
+
+static CONTROL_OutputType CONTROL_Output;
+static LTC1451_t CONTROL_DAC;
+static TIMx_CHx CONTROL_PWM;
+static uint32_t CONTROL_PWMPeriod;
+
+static arm_pid_instance_q15 CONTROL_PID;
+static CONTROL_Gains_t CONTROL_Gains;               // Gains in use (Only changed by the interrupt while running)
+static CONTROL_Gains_t CONTROL_PendingGains;        // Written by the main loop, picked up by the next step
+static volatile bool CONTROL_GainsPending;
+static volatile q15_t CONTROL_Setpoint;
+static volatile q15_t CONTROL_Min = -32768;
+static volatile q15_t CONTROL_Max = 32767;
+static volatile bool CONTROL_Running;
+
+static volatile q15_t CONTROL_LastInput;
+static volatile q15_t CONTROL_LastOutput;
+static uint32_t CONTROL_TickCycles;                 // Cycle count when the current step's tick fired
+static uint32_t CONTROL_PreviousTickCycles;
+static CONTROL_Stats_t CONTROL_Stats;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Timer callback, records the tick time and starts the conversion for the next step
+static void CONTROL_TickHandler(void);
+
+/// @brief LTC1298 callback, runs the PID step and writes the output
+/// @param sample 12-bit sample read from the ADC
+static void CONTROL_SampleHandler(uint16_t sample);
+
+/// @brief Loads gains into the CMSIS-DSP PID instance without clearing its state
+/// @param gains Gains to load
+static void CONTROL_LoadGains(const CONTROL_Gains_t *gains);
+
+/// @brief Parses a decimal value into q15
+/// @param str String to parse
+/// @param value Parsed value
+/// @return True if a value in [-1.0, +1.0) was parsed, false otherwise
+static bool CONTROL_ParseQ15(const char *str, q15_t *value);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool CONTROL_Init(LTC1298_t LTC_ADC, CONTROL_Channel CONTROL_CHx, TIM_TypeDef *TIMx, uint32_t rate){
+    if(rate == 0 || rate > CONTROL_MAX_RATE)
+        return false;
+
+    CONTROL_Stop();                 // Stop a previous configuration before changing it
+    CONTROL_ADC = LTC_ADC;
+    CONTROL_StartRead = CONTROL_CHx == CONTROL_CH1 ? LTCADC_StartReadCH1CS : LTCADC_StartReadCH0CS;
+    CONTROL_Timer = TIMx;
+    CONTROL_Rate = rate;
+    return true;
+}
+
+void CONTROL_SetOutputDAC(LTC1451_t LTC_DAC){
+    CONTROL_DAC = LTC_DAC;
+    CONTROL_Output = CONTROL_OUTPUT_DAC;
+}
+
+void CONTROL_SetOutputPWM(TIMx_CHx TIMx_CHx_Pxx){
+    CONTROL_PWM = TIMx_CHx_Pxx;
+    CONTROL_PWMPeriod = TIMER_PWM_GetPeriod(TIMx_CHx_Pxx);
+    CONTROL_Output = CONTROL_OUTPUT_PWM;
+}
+
+bool CONTROL_SetGains(q15_t kp, q15_t ki, q15_t kd, uint8_t shift){
+    if(shift > CONTROL_MAX_SHIFT)
+        return false;
+
+    if(!CONTROL_Running){
+        CONTROL_Gains = (CONTROL_Gains_t){kp, ki, kd, shift};
+        CONTROL_LoadGains(&CONTROL_Gains);
+        return true;
+    }
+
+    while(CONTROL_GainsPending){}   // The next step has not picked up the previous gains yet (At most one period)
+    CONTROL_PendingGains = (CONTROL_Gains_t){kp, ki, kd, shift};
+    CONTROL_GainsPending = true;
+    return true;
+}
+
+bool CONTROL_SetLimits(q15_t min, q15_t max){
+    if(min > max)
+        return false;
+    CONTROL_Min = min;
+    CONTROL_Max = max;
+    return true;
+}
+
+void CONTROL_SetSetpoint(q15_t setpoint){
+    CONTROL_Setpoint = setpoint;
+}
+
+bool CONTROL_Start(void){
+    if(CONTROL_Timer == 0 || CONTROL_Output == CONTROL_OUTPUT_NONE)
+        return false;
+
+    SET_BIT(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);  // Enable the DWT block
+    SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);             // Start the cycle counter (Left running if ACDC_BENCH started it)
+    CONTROL_PeriodCycles = CLOCK_GetSystemClockSpeed() / CONTROL_Rate;
+
+    CONTROL_LoadGains(&CONTROL_Gains);
+    arm_pid_reset_q15(&CONTROL_PID);
+    CONTROL_GainsPending = false;
+    CONTROL_ResetStats();
+    CONTROL_Running = true;
+    if(!TIMER_TICK_Init(CONTROL_Timer, CONTROL_Rate, CONTROL_TickHandler)){
+        CONTROL_Running = false;
+        return false;
+    }
+    return true;
+}
+
+void CONTROL_Stop(void){
+    if(CONTROL_Timer != 0)
+        TIMER_TICK_Stop(CONTROL_Timer);
+    uint32_t start = WATCHDOG_WaitStart();
+    while(LTCADC_IsReading()){      // Let the last step finish so the SPI is free
+        if(WATCHDOG_WaitExpired(start, CONTROL_STOP_TIMEOUT_US, "CONTROL stop"))
+            break;
+    }
+    if(CONTROL_GainsPending){       // Nothing will pick them up now
+        CONTROL_Gains = CONTROL_PendingGains;
+        CONTROL_GainsPending = false;
+    }
+    CONTROL_Running = false;
+}
+
+q15_t CONTROL_GetInput(void){
+    return CONTROL_LastInput;
+}
+
+q15_t CONTROL_GetOutput(void){
+    return CONTROL_LastOutput;
+}
+
+void CONTROL_GetStats(CONTROL_Stats_t *stats){
+    __disable_irq();                // The interrupts update several fields per step
+    *stats = CONTROL_Stats;
+    __enable_irq();
+}
+
+void CONTROL_ResetStats(void){
+    __disable_irq();
+    CONTROL_Stats = (CONTROL_Stats_t){0};
+    CONTROL_Stats.minLatencyCycles = 0xFFFFFFFF;
+    __enable_irq();
+}
+
+bool CONTROL_HandleCommand(const char *command){
+    int32_t nameLength = StringIndexOf(command, ' ');
+    if(nameLength <= 0)
+        return false;
+    const char *value = command + nameLength + 1;
+
+    CONTROL_Gains_t gains = CONTROL_Running && CONTROL_GainsPending ? CONTROL_PendingGains : CONTROL_Gains;
+    q15_t number;
+    if(StringStartsWith(command, "shift ")){
+        uint32_t shift;
+        if(StringParseU32(value, StringLength(value), &shift, 0) != STRING_PARSE_OK || shift > CONTROL_MAX_SHIFT)
+            return false;
+        return CONTROL_SetGains(gains.kp, gains.ki, gains.kd, (uint8_t)shift);
+    }
+    if(!CONTROL_ParseQ15(value, &number))
+        return false;
+
+    if(StringStartsWith(command, "kp "))
+        return CONTROL_SetGains(number, gains.ki, gains.kd, gains.shift);
+    if(StringStartsWith(command, "ki "))
+        return CONTROL_SetGains(gains.kp, number, gains.kd, gains.shift);
+    if(StringStartsWith(command, "kd "))
+        return CONTROL_SetGains(gains.kp, gains.ki, number, gains.shift);
+    if(StringStartsWith(command, "sp ")){
+        CONTROL_SetSetpoint(number);
+        return true;
+    }
+    if(StringStartsWith(command, "min "))
+        return CONTROL_SetLimits(number, CONTROL_Max);
+    if(StringStartsWith(command, "max "))
+        return CONTROL_SetLimits(CONTROL_Min, number);
+    return false;
+}
+
+bool CONTROL_AppendStatus(StringBuilder *sb){
+    CONTROL_Stats_t stats;
+    CONTROL_GetStats(&stats);
+    CONTROL_Gains_t gains = CONTROL_Gains;
+
+    StringBuilderAppend(sb, "kp=");
+    StringBuilderAppendFixed(sb, gains.kp, 15, 4);
+    StringBuilderAppend(sb, " ki=");
+    StringBuilderAppendFixed(sb, gains.ki, 15, 4);
+    StringBuilderAppend(sb, " kd=");
+    StringBuilderAppendFixed(sb, gains.kd, 15, 4);
+    StringBuilderAppend(sb, " shift=");
+    StringBuilderAppendU32(sb, gains.shift);
+    StringBuilderAppend(sb, " sp=");
+    StringBuilderAppendFixed(sb, CONTROL_Setpoint, 15, 4);
+    StringBuilderAppend(sb, " in=");
+    StringBuilderAppendFixed(sb, CONTROL_LastInput, 15, 4);
+    StringBuilderAppend(sb, " out=");
+    StringBuilderAppendFixed(sb, CONTROL_LastOutput, 15, 4);
+    StringBuilderAppend(sb, " steps=");
+    StringBuilderAppendU32(sb, stats.steps);
+    StringBuilderAppend(sb, " missed=");
+    StringBuilderAppendU32(sb, stats.missedSteps);
+    StringBuilderAppend(sb, " jitter=");
+    StringBuilderAppendU32(sb, stats.maxJitterCycles);
+    StringBuilderAppend(sb, " latency=");
+    StringBuilderAppendU32(sb, stats.steps != 0 ? stats.minLatencyCycles : 0);
+    StringBuilderAppendChar(sb, '-');
+    StringBuilderAppendU32(sb, stats.maxLatencyCycles);
+    StringBuilderAppend(sb, " compute=");
+    return StringBuilderAppendU32(sb, stats.maxComputeCycles);
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static void CONTROL_TickHandler(void){
+    uint32_t now = DWT->CYCCNT;
+    if(!CONTROL_StartRead(CONTROL_ADC, CONTROL_SampleHandler)){
+        CONTROL_Stats.missedSteps++;    // The previous step is still converting, keep its tick time
+        return;
+    }
+    CONTROL_PreviousTickCycles = CONTROL_TickCycles;
+    CONTROL_TickCycles = now;
+}
+
+static void CONTROL_SampleHandler(uint16_t sample){
+    uint32_t start = DWT->CYCCNT;
+    if(CONTROL_GainsPending){
+        CONTROL_Gains = CONTROL_PendingGains;
+        CONTROL_LoadGains(&CONTROL_Gains);
+        CONTROL_GainsPending = false;
+    }
+
+    q15_t input;
+    DSP_SamplesToQ15(&sample, &input, 1);
+    q15_t error = (q15_t)__SSAT(((int32_t)CONTROL_Setpoint - input) << CONTROL_Gains.shift, 16);
+    q15_t output = arm_pid_q15(&CONTROL_PID, error);
+
+    // arm_pid_q15 is the incremental form (Output = previous output + change), so clamping the stored
+    // previous output stops the integral from winding up past the limits
+    if(output > CONTROL_Max)
+        output = CONTROL_Max;
+    else if(output < CONTROL_Min)
+        output = CONTROL_Min;
+    CONTROL_PID.state[2] = output;
+
+    uint32_t scaled = (uint32_t)((int32_t)output + 32768);                  // 0 - 65535
+    if(CONTROL_Output == CONTROL_OUTPUT_DAC)
+        LTCDAC_SetOutputCS(CONTROL_DAC, scaled >> 4);                       // 12-bit code
+    else
+        TIMER_PWM_SetDuty(CONTROL_PWM, (scaled * CONTROL_PWMPeriod) >> 16);
+
+    uint32_t end = DWT->CYCCNT;
+    CONTROL_LastInput = input;
+    CONTROL_LastOutput = output;
+
+    uint32_t latency = end - CONTROL_TickCycles;
+    if(latency < CONTROL_Stats.minLatencyCycles)
+        CONTROL_Stats.minLatencyCycles = latency;
+    if(latency > CONTROL_Stats.maxLatencyCycles)
+        CONTROL_Stats.maxLatencyCycles = latency;
+    if(end - start > CONTROL_Stats.maxComputeCycles)
+        CONTROL_Stats.maxComputeCycles = end - start;
+    if(CONTROL_Stats.steps != 0){   // The first step has no previous tick
+        uint32_t period = CONTROL_TickCycles - CONTROL_PreviousTickCycles;
+        uint32_t jitter = period > CONTROL_PeriodCycles ? period - CONTROL_PeriodCycles : CONTROL_PeriodCycles - period;
+        if(jitter > CONTROL_Stats.maxJitterCycles && period < 2 * CONTROL_PeriodCycles)     // Missed ticks are counted separately
+            CONTROL_Stats.maxJitterCycles = jitter;
+    }
+    CONTROL_Stats.steps++;
+}
+
+static void CONTROL_LoadGains(const CONTROL_Gains_t *gains){
+    CONTROL_PID.Kp = gains->kp;
+    CONTROL_PID.Ki = gains->ki;
+    CONTROL_PID.Kd = gains->kd;
+    arm_pid_init_q15(&CONTROL_PID, 0);      // Recalculates A0 - A2 and keeps the state so the output does not jump
+}
+
+static bool CONTROL_ParseQ15(const char *str, q15_t *value){
+    int32_t parsed;
+    if(StringParseFixed(str, StringLength(str), 15, &parsed, 0) != STRING_PARSE_OK || parsed < -32768 || parsed > 32767)
+        return false;
+    *value = (q15_t)parsed;
+    return true;
+}
+#pragma endregion
@@ -0,0 +1,55 @@
+/**
+ * @file ACDC_DSP.c
+ * @author Devin Marx
+ * @brief Implementation of the LTC1298 to CMSIS-DSP glue
+ * @version 0.1
+ * @date 2024-04-11
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_DSP.h"
+
+#define Q15_SHIFT (15 - (DSP_LTC1298_BITS - 1))   // Moves the 12-bit sign/magnitude up to bit 15 (<< 4)
+#define Q31_SHIFT (31 - (DSP_LTC1298_BITS - 1))   // Moves the 12-bit sign/magnitude up to bit 31 (<< 20)
+
+#pragma region PUBLIC_FUNCTIONS
+void DSP_SamplesToQ15(const uint16_t *samples, q15_t *output, uint32_t count){
+    for(uint32_t i = 0; i < count; i++)
+        output[i] = (q15_t)(((int32_t)samples[i] - DSP_LTC1298_MIDSCALE) << Q15_SHIFT);
+}
+
+void DSP_SamplesToQ31(const uint16_t *samples, q31_t *output, uint32_t count){
+    for(uint32_t i = 0; i < count; i++)
+        output[i] = (q31_t)(((int32_t)samples[i] - DSP_LTC1298_MIDSCALE) << Q31_SHIFT);
+}
+
+void DSP_ReadBlockCH0Q15(LTC1298_t LTC_ADC, q15_t *output, uint16_t count){
+    LTCADC_ReadBlockCH0CS(LTC_ADC, (uint16_t*)output, count);  // q15_t and uint16_t are the same size
+    DSP_SamplesToQ15((const uint16_t*)output, output, count);
+}
+
+void DSP_ReadBlockCH1Q15(LTC1298_t LTC_ADC, q15_t *output, uint16_t count){
+    LTCADC_ReadBlockCH1CS(LTC_ADC, (uint16_t*)output, count);  // q15_t and uint16_t are the same size
+    DSP_SamplesToQ15((const uint16_t*)output, output, count);
+}
+
+q15_t DSP_MeanQ15(const q15_t *block, uint32_t count){
+    q15_t mean = 0;
+    if(count != 0)
+        arm_mean_q15((q15_t*)block, count, &mean);  // CMSIS-DSP 1.5 does not take const input
+    return mean;
+}
+
+q15_t DSP_RmsQ15(const q15_t *block, uint32_t count){
+    q15_t rms = 0;
+    if(count != 0)
+        arm_rms_q15((q15_t*)block, count, &rms);
+    return rms;
+}
+
+int32_t DSP_Q15ToMillivolts(q15_t value, uint32_t vrefMillivolts){
+    // (value + 1.0) / 2 * Vref, done in 64-bit so a 5000mV reference can not overflow
+    return (int32_t)((((int64_t)value + 32768) * vrefMillivolts) >> 16);
+}
+#pragma endregion
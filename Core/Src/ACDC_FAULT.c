@@ -0,0 +1,197 @@
+/**
+ * @file ACDC_FAULT.c
+ * @author Devin Marx
+ * @brief Implementation of the crash dumps of the fault handlers
+ * @version 0.1
+ * @date 2024-04-30
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_FAULT.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_USART.h"
+#include "ACDC_string.h"
+
+#define FAULT_MAGIC         0xFA017DEDUL
+#define FAULT_FRAME_WORDS   8               // r0-r3, r12, lr, pc, xPSR stacked by the core {See PM-39}
+#define FAULT_XPSR_ALIGN    (1UL << 9)      // The core added a word to align the frame to 8 bytes
+#define FAULT_RAM_START     0x20000000UL
+#define FAULT_LINE_SIZE     128             // Longest line is FAULT_REGS: 10 * (1 + 8 hex digits) + "\r\n"
+
+// Picks the stack the core stacked the frame on and passes it with EXC_RETURN to FAULT_Capture (Nothing may be pushed first)
+#define FAULT_ENTRY         "tst     lr, #4          \n" \
+                            "ite     eq              \n" \
+                            "mrseq   r0, msp         \n" \
+                            "mrsne   r0, psp         \n" \
+                            "mov     r1, lr          \n" \
+                            "b       FAULT_Capture   \n"
+
+extern uint32_t _etext;                     // End of the code in flash (STM32F103RBTx_FLASH.ld)
+extern uint32_t _sramfunc;                  // ACDC_RAMFUNC code copied to RAM
+extern uint32_t _eramfunc;
+extern uint32_t _estack;                    // Top of RAM, where MSP starts
+
+__attribute__((section(".noinit"))) static FAULT_Record_t FaultRecord;     // Survives the reset
+static FaultCallback FaultUserCallback = NULL;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Saves the crash record and resets (Called by the fault handlers, so it keeps its name)
+/// @param frame Exception frame the core stacked
+/// @param excReturn EXC_RETURN the handler was entered with
+__attribute__((used, noreturn)) void FAULT_Capture(const uint32_t *frame, uint32_t excReturn);
+
+/// @brief Calculates the checksum of a record
+/// @param record Record to check
+/// @return Checksum of every word before check
+static uint32_t FAULT_Checksum(const FAULT_Record_t *record);
+
+/// @brief Checks if a word on the stack looks like a return address (Odd Thumb address inside the code)
+/// @param word Word to check
+/// @return True if word points into .text or the ACDC_RAMFUNC code
+static bool FAULT_IsCodeAddress(uint32_t word);
+
+/// @brief Adds a line of hex values to the report
+/// @param sb StringBuilder of the line (Cleared first)
+/// @param name First field of the line
+/// @param values Values to add
+/// @param count Number of values
+/// @param USARTx USART Peripheral to print to
+static void FAULT_SendHexLine(StringBuilder *sb, const char *name, const uint32_t *values, uint32_t count, USART_TypeDef *USARTx);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void FAULT_Init(FaultCallback callback){
+    FaultUserCallback = callback;
+    SET_BIT(SCB->SHCSR, SCB_SHCSR_MEMFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk | SCB_SHCSR_USGFAULTENA_Msk);
+}
+
+const FAULT_Record_t *FAULT_GetRecord(void){
+    if(FaultRecord.magic != FAULT_MAGIC || FaultRecord.check != FAULT_Checksum(&FaultRecord))
+        return NULL;
+    return &FaultRecord;
+}
+
+void FAULT_Clear(void){
+    FaultRecord.magic = 0;
+    FaultRecord.check = 0;
+}
+
+bool FAULT_Report(USART_TypeDef *USARTx){
+    static const char *const names[] = {"NMI", "HardFault", "MemManage", "BusFault", "UsageFault"};     // Exceptions 2 - 6
+    const FAULT_Record_t *record = FAULT_GetRecord();
+    if(record == NULL)
+        return false;
+
+    char line[FAULT_LINE_SIZE];
+    StringBuilder sb = StringBuilderInit(line, sizeof(line));
+    StringBuilderAppend(&sb, "FAULT,");
+    StringBuilderAppend(&sb, (record->exception >= 2 && record->exception <= 6) ? names[record->exception - 2] : "Exception");
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, record->exception);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, record->count);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, record->uptime);
+    StringBuilderAppend(&sb, "\r\n");
+    USART_SendBuffer(USARTx, sb.buffer, sb.length);
+
+    FAULT_SendHexLine(&sb, "FAULT_REGS", &record->r0, 10, USARTx);             // r0, r1, r2, r3, r12, lr, pc, xPSR, sp, EXC_RETURN
+    FAULT_SendHexLine(&sb, "FAULT_STATUS", &record->cfsr, 4, USARTx);          // CFSR, HFSR, MMFAR, BFAR
+    FAULT_SendHexLine(&sb, "FAULT_STACK", record->backtrace, record->backtraceDepth, USARTx);
+
+    FAULT_Clear();
+    return true;
+}
+
+__attribute__((naked)) void HardFault_Handler(void){
+    __asm volatile(FAULT_ENTRY);
+}
+
+__attribute__((naked)) void MemManage_Handler(void){
+    __asm volatile(FAULT_ENTRY);
+}
+
+__attribute__((naked)) void BusFault_Handler(void){
+    __asm volatile(FAULT_ENTRY);
+}
+
+__attribute__((naked)) void UsageFault_Handler(void){
+    __asm volatile(FAULT_ENTRY);
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+void FAULT_Capture(const uint32_t *frame, uint32_t excReturn){
+    if(FAULT_GetRecord() != NULL){
+        FaultRecord.count++;                                // Keep the first crash, later ones are often caused by it
+    }else{
+        uint32_t *words = (uint32_t *)&FaultRecord;
+        for(uint32_t i = 0; i < sizeof(FaultRecord) / sizeof(uint32_t); i++)
+            words[i] = 0;
+
+        FaultRecord.magic = FAULT_MAGIC;
+        FaultRecord.exception = __get_IPSR() & 0x1FF;
+        FaultRecord.count = 1;
+        FaultRecord.uptime = (uint32_t)Millis();
+        FaultRecord.excReturn = excReturn;
+        FaultRecord.cfsr = SCB->CFSR;
+        FaultRecord.hfsr = SCB->HFSR;
+        FaultRecord.mmfar = SCB->MMFAR;
+        FaultRecord.bfar = SCB->BFAR;
+        FaultRecord.sp = (uint32_t)frame;
+
+        // A fault while stacking leaves no frame, and reading outside RAM here would lock the core up
+        uint32_t top = (uint32_t)&_estack;
+        bool stacked = (FaultRecord.cfsr & (SCB_CFSR_MSTKERR_Msk | SCB_CFSR_STKERR_Msk)) == 0;
+        if(stacked && (uint32_t)frame >= FAULT_RAM_START && (uint32_t)frame + FAULT_FRAME_WORDS * 4 <= top){
+            uint32_t *registers = &FaultRecord.r0;
+            for(uint8_t i = 0; i < FAULT_FRAME_WORDS; i++)
+                registers[i] = frame[i];
+
+            const uint32_t *sp = frame + FAULT_FRAME_WORDS + ((FaultRecord.xpsr & FAULT_XPSR_ALIGN) ? 1 : 0);
+            FaultRecord.sp = (uint32_t)sp;
+            for(uint32_t i = 0; i < FAULT_SCAN_WORDS && (uint32_t)&sp[i] < top; i++){
+                if(FaultRecord.backtraceDepth >= FAULT_BACKTRACE_DEPTH)
+                    break;
+                if(FAULT_IsCodeAddress(sp[i]))
+                    FaultRecord.backtrace[FaultRecord.backtraceDepth++] = sp[i];
+            }
+        }
+    }
+    FaultRecord.check = FAULT_Checksum(&FaultRecord);
+
+    if(FaultUserCallback != NULL)
+        FaultUserCallback(&FaultRecord);
+    if(CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk)
+        __BKPT(0);                                          // Stop where the debugger can still see the fault
+    NVIC_SystemReset();
+}
+
+static uint32_t FAULT_Checksum(const FAULT_Record_t *record){
+    const uint32_t *words = (const uint32_t *)record;
+    uint32_t sum = FAULT_MAGIC;
+    for(uint32_t i = 0; i < sizeof(FAULT_Record_t) / sizeof(uint32_t) - 1; i++)
+        sum = (sum << 1 | sum >> 31) ^ words[i];            // Rotate so swapped words change the checksum
+    return sum;
+}
+
+static bool FAULT_IsCodeAddress(uint32_t word){
+    if((word & 1) == 0)
+        return false;
+    word &= ~1UL;
+    return (word >= FLASH_BASE && word < (uint32_t)&_etext) ||
+           (word >= (uint32_t)&_sramfunc && word < (uint32_t)&_eramfunc);
+}
+
+static void FAULT_SendHexLine(StringBuilder *sb, const char *name, const uint32_t *values, uint32_t count, USART_TypeDef *USARTx){
+    StringBuilderClear(sb);
+    StringBuilderAppend(sb, name);
+    for(uint32_t i = 0; i < count; i++){
+        StringBuilderAppendChar(sb, ',');
+        StringBuilderAppendHex(sb, values[i], 8);
+    }
+    StringBuilderAppend(sb, "\r\n");
+    USART_SendBuffer(USARTx, sb->buffer, sb->length);
+}
+#pragma endregion
@@ -0,0 +1,97 @@
+/**
+ * @file ACDC_FILTER.c
+ * @author Devin Marx
+ * @brief Implementation of the q15 filtering pipeline
+ * @version 0.1
+ * @date 2024-04-15
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_FILTER.h"
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Gets the next free stage of the pipeline
+/// @param pipeline Pipeline to add a stage to
+/// @return Next free stage, or 0 if FILTER_MAX_STAGES have been added
+static FILTER_Stage_t* FILTER_NextStage(FILTER_Pipeline_t *pipeline);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void FILTER_Init(FILTER_Pipeline_t *pipeline, uint32_t blockSize){
+    pipeline->count = 0;
+    pipeline->blockSize = blockSize;
+    pipeline->outputSize = blockSize;   // No stages yet, the block comes out as it went in
+}
+
+bool FILTER_AddFIR(FILTER_Pipeline_t *pipeline, const q15_t *coefficients, uint16_t numTaps, q15_t *state){
+    FILTER_Stage_t *stage = FILTER_NextStage(pipeline);
+    if(stage == 0 || numTaps == 0)
+        return false;
+
+    // The fast and normal q15 FIR share the instance and init function (CMSIS-DSP 1.5 does not take const coefficients)
+    if(arm_fir_init_q15(&stage->instance.fir, numTaps, (q15_t*)coefficients, state, pipeline->outputSize) != ARM_MATH_SUCCESS)
+        return false;
+
+    stage->type = FILTER_STAGE_FIR;
+    stage->blockSize = pipeline->outputSize;
+    pipeline->count++;
+    return true;
+}
+
+bool FILTER_AddBiquad(FILTER_Pipeline_t *pipeline, const q15_t *coefficients, uint8_t numSections, q15_t *state, int8_t postShift){
+    FILTER_Stage_t *stage = FILTER_NextStage(pipeline);
+    if(stage == 0 || numSections == 0)
+        return false;
+
+    arm_biquad_cascade_df1_init_q15(&stage->instance.biquad, numSections, (q15_t*)coefficients, state, postShift);
+    stage->type = FILTER_STAGE_BIQUAD;
+    stage->blockSize = pipeline->outputSize;
+    pipeline->count++;
+    return true;
+}
+
+bool FILTER_AddDecimator(FILTER_Pipeline_t *pipeline, const q15_t *coefficients, uint16_t numTaps, uint8_t factor, q15_t *state){
+    FILTER_Stage_t *stage = FILTER_NextStage(pipeline);
+    if(stage == 0 || numTaps == 0 || factor == 0)
+        return false;
+
+    // Fails if the block size at this stage is not a multiple of factor
+    if(arm_fir_decimate_init_q15(&stage->instance.decimate, numTaps, factor, (q15_t*)coefficients, state, pipeline->outputSize) != ARM_MATH_SUCCESS)
+        return false;
+
+    stage->type = FILTER_STAGE_DECIMATE;
+    stage->blockSize = pipeline->outputSize;
+    pipeline->outputSize /= factor;     // Every stage after this one sees the shorter block
+    pipeline->count++;
+    return true;
+}
+
+uint32_t FILTER_Process(FILTER_Pipeline_t *pipeline, q15_t *block){
+    // Source and destination are the same buffer. Each kernel copies its input into the state buffer
+    // before writing the matching output, and a decimator's output index never passes its input index
+    for(uint8_t i = 0; i < pipeline->count; i++){
+        FILTER_Stage_t *stage = &pipeline->stages[i];
+        switch(stage->type){
+            case FILTER_STAGE_FIR:
+                arm_fir_fast_q15(&stage->instance.fir, block, block, stage->blockSize);
+                break;
+            case FILTER_STAGE_BIQUAD:
+                arm_biquad_cascade_df1_fast_q15(&stage->instance.biquad, block, block, stage->blockSize);
+                break;
+            case FILTER_STAGE_DECIMATE:
+                arm_fir_decimate_q15(&stage->instance.decimate, block, block, stage->blockSize);
+                break;
+        }
+    }
+    return pipeline->outputSize;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static FILTER_Stage_t* FILTER_NextStage(FILTER_Pipeline_t *pipeline){
+    if(pipeline->count >= FILTER_MAX_STAGES)
+        return 0;
+    return &pipeline->stages[pipeline->count];
+}
+#pragma endregion
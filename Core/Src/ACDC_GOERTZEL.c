@@ -0,0 +1,157 @@
+/**
+ * @file ACDC_GOERTZEL.c
+ * @author Devin Marx
+ * @brief Implementation of the Goertzel tone detector bank
+ * @version 0.1
+ * @date 2024-04-18
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_GOERTZEL.h"
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Runs samples through the resonator of one tone
+/// @param tone Tone to run
+/// @param samples q15 samples
+/// @param count Number of samples
+static void GOERTZEL_Run(GOERTZEL_Tone_t *tone, const q15_t *samples, uint32_t count);
+
+/// @brief Calculates the level of every tone at the end of a window and calls the callback on changes
+/// @param bank Bank with a completed window
+static void GOERTZEL_Detect(GOERTZEL_Bank_t *bank);
+
+/// @brief Integer square root
+/// @param value Value to take the square root of
+/// @return floor(sqrt(value))
+static uint32_t GOERTZEL_Sqrt(uint64_t value);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool GOERTZEL_Init(GOERTZEL_Bank_t *bank, uint32_t sampleRate, uint16_t windowSize, GOERTZEL_Callback callback){
+    if(windowSize == 0 || windowSize > GOERTZEL_MAX_WINDOW || sampleRate == 0)
+        return false;
+
+    bank->count = 0;
+    bank->windowSize = windowSize;
+    bank->sampleCount = 0;
+    bank->sampleRate = sampleRate;
+    bank->callback = callback;
+    return true;
+}
+
+bool GOERTZEL_AddTone(GOERTZEL_Bank_t *bank, uint32_t frequency, q15_t threshold){
+    // Within 1 bin of DC or of sampleRate / 2 the resonator gain grows past what the q31 state can hold
+    if(bank->count >= GOERTZEL_MAX_TONES || (uint64_t)frequency * bank->windowSize < bank->sampleRate || frequency >= bank->sampleRate / 2 ||
+       (uint64_t)(bank->sampleRate / 2 - frequency) * bank->windowSize < bank->sampleRate)
+        return false;
+
+    GOERTZEL_Tone_t *tone = &bank->tones[bank->count++];
+    tone->frequency = frequency;
+    // arm_cos_q15 maps 0 - 32767 to 0 - 2 * pi. cos in Q1.15 is the same number as 2cos in Q2.14
+    tone->coefficient = arm_cos_q15((q15_t)(((uint64_t)frequency << 15) / bank->sampleRate));
+    tone->threshold = threshold;
+    tone->s1 = 0;
+    tone->s2 = 0;
+    tone->level = 0;
+    tone->detected = false;
+    return true;
+}
+
+bool GOERTZEL_AddSamples(GOERTZEL_Bank_t *bank, const q15_t *samples, uint32_t count){
+    bool completed = false;
+    while(count != 0){
+        uint32_t toRun = bank->windowSize - bank->sampleCount;
+        if(toRun > count)
+            toRun = count;
+
+        for(uint8_t i = 0; i < bank->count; i++)
+            GOERTZEL_Run(&bank->tones[i], samples, toRun);  // One tone at a time keeps its state in registers
+        bank->sampleCount += toRun;
+        samples += toRun;
+        count -= toRun;
+
+        if(bank->sampleCount == bank->windowSize){
+            GOERTZEL_Detect(bank);
+            bank->sampleCount = 0;
+            completed = true;
+        }
+    }
+    return completed;
+}
+
+q15_t GOERTZEL_GetLevel(const GOERTZEL_Bank_t *bank, uint8_t tone){
+    return tone < bank->count ? bank->tones[tone].level : 0;
+}
+
+bool GOERTZEL_IsDetected(const GOERTZEL_Bank_t *bank, uint8_t tone){
+    return tone < bank->count && bank->tones[tone].detected;
+}
+
+void GOERTZEL_Reset(GOERTZEL_Bank_t *bank){
+    bank->sampleCount = 0;
+    for(uint8_t i = 0; i < bank->count; i++){
+        bank->tones[i].s1 = 0;
+        bank->tones[i].s2 = 0;
+        bank->tones[i].level = 0;
+        bank->tones[i].detected = false;
+    }
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static void GOERTZEL_Run(GOERTZEL_Tone_t *tone, const q15_t *samples, uint32_t count){
+    q31_t s1 = tone->s1;
+    q31_t s2 = tone->s2;
+    q15_t coefficient = tone->coefficient;
+
+    for(uint32_t i = 0; i < count; i++){
+        q31_t s0 = samples[i] + (q31_t)(((int64_t)coefficient * s1) >> 14) - s2;   // s0 = x + 2cos * s1 - s2
+        s2 = s1;
+        s1 = s0;
+    }
+    tone->s1 = s1;
+    tone->s2 = s2;
+}
+
+static void GOERTZEL_Detect(GOERTZEL_Bank_t *bank){
+    for(uint8_t i = 0; i < bank->count; i++){
+        GOERTZEL_Tone_t *tone = &bank->tones[i];
+        int64_t s1 = tone->s1;
+        int64_t s2 = tone->s2;
+
+        // |X|^2 = s1^2 + s2^2 - 2cos * s1 * s2, a sine of amplitude A on its bin gives |X| = A * N / 2
+        int64_t power = s1 * s1 + s2 * s2 - ((((int64_t)tone->coefficient * s1) >> 14) * s2);
+        uint32_t level = (power > 0) ? (2 * GOERTZEL_Sqrt((uint64_t)power)) / bank->windowSize : 0;
+        tone->level = (level > 32767) ? 32767 : (q15_t)level;
+        tone->s1 = 0;
+        tone->s2 = 0;
+
+        // Hysteresis keeps a tone sitting right at the threshold from toggling every window
+        bool detected = tone->detected ? (tone->level >= tone->threshold - (tone->threshold >> 2)) : (tone->level >= tone->threshold);
+        if(detected != tone->detected){
+            tone->detected = detected;
+            if(bank->callback != 0)
+                bank->callback(i, detected, tone->level);
+        }
+    }
+}
+
+static uint32_t GOERTZEL_Sqrt(uint64_t value){
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while(bit > value)
+        bit >>= 2;
+
+    while(bit != 0){
+        if(value >= root + bit){
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+            root >>= 1;
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+#pragma endregion
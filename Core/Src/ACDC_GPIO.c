@@ -46,9 +46,9 @@ void GPIO_PinDirection(GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN, uint8_t GPIO_MODE
 
 void GPIO_Deinit(GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN){
     const uint32_t GPIO_CRx_RESET_VALUE = 0x44444444;                       // Default CRH/CRL register value {See RM-172}
-    volatile uint32_t *REG = (GPIO_PIN > 7) ? &GPIOx->CRH : &GPIOx->CRL;    // Use CRL for 0-7, else CRH for 8-15
     uint8_t PIN = GPIO_GetPinNumber(GPIO_PIN);                              // Get the Pin number (GPIO_PIN_3 -> 3)
-    if(GPIO_PIN > 7)
+    volatile uint32_t *REG = (PIN > 7) ? &GPIOx->CRH : &GPIOx->CRL;         // Use CRL for 0-7, else CRH for 8-15
+    if(PIN > 7)
         PIN -= 8;   // shifts the pin down to accomadate for CRH & CRL
 
     uint32_t GPIO_Pin_Msk = GPIO_MODE_CNF << (PIN*4);   // Creates a bitmask for the MODE & CNF Bits
@@ -77,7 +77,7 @@ void GPIO_Toggle(GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN){
 
 uint8_t GPIO_Read(const GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN){
     uint8_t PIN = GPIO_GetPinNumber(GPIO_PIN);
-    return (GPIOx->IDR & GPIO_PIN) >> PIN;
+    return READ_BIT(GPIOx->IDR, GPIO_PIN) >> PIN;
 }
 
 uint8_t GPIO_GetPinNumber(uint16_t GPIO_PIN){
@@ -25,8 +25,8 @@ void INTERRUPT_Enable(IRQn_Type IRQn){
     // Enables Specific Interrupt Vectors {See PM-120}
     if(IRQn >= 0){
         uint8_t index = IRQn >> 5;                      // Get the index of the IRQ {0-31 = 0, 32-63 = 1}
-        uint8_t irqToEnable = 0b1 << (IRQn & 0x1F);     // Shift the set bit down 0-31 places
-        SET_BIT(NVIC->ISER[index], irqToEnable);        // Set the bit to enable the IRQn interrupt vector
+        uint32_t irqToEnable = 0b1UL << (IRQn & 0x1F);  // Shift the set bit down 0-31 places (32-bit so IRQs 8-31 are not lost)
+        WRITE_REG(NVIC->ISER[index], irqToEnable);      // Writing a 1 enables the IRQn interrupt vector (0s are ignored)
     }
 }
 
@@ -34,8 +34,8 @@ void INTERRUPT_Disable(IRQn_Type IRQn){
     // Disables Specific Interrupt Vectors {See PM-121}
     if(IRQn >= 0){
         uint8_t index = IRQn >> 5;                      // Get the index of the IRQ {0-31 = 0, 32-63 = 1}
-        uint8_t irqToDisable = 0b1 << (IRQn & 0x1F);    // Shift the set bit down 0-31 places
-        SET_BIT(NVIC->ICER[index], irqToDisable);       // Set the bit to disable the IRQn interrupt vector
+        uint32_t irqToDisable = 0b1UL << (IRQn & 0x1F); // Shift the set bit down 0-31 places (32-bit so IRQs 8-31 are not lost)
+        WRITE_REG(NVIC->ICER[index], irqToDisable);     // Writing a 1 disables the IRQn interrupt vector (ICER reads back every enabled vector, so no read-modify-write)
     }
 }
 
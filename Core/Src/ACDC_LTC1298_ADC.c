@@ -22,6 +22,15 @@
 #define ADC_MUX_MSBFIRST          0b0001    /** Sets the Recieved data format to MSB First   */
 #define ADC_MUX_LSBFIRST          0b0000    /** Sets the Recieved data format to LSB First   */
 #define MAX_CLOCK_SPEED           200000    /** ADC MAX Clock Freq = 200kHz {See LTC1298-14} */
+#define ADC_FRAMES_PER_READ       2         /** Command frame + data frame (16-bit SPI frames) */
+
+typedef struct{
+    LTC1298_t LTC_ADC;              /**< ADC being read                                       */
+    LTCADC_Callback callback;       /**< Called with the sample once the read is done          */
+    volatile uint8_t framesLeft;    /**< SPI frames still to be received (0 = No read running) */
+}LTCADC_BackgroundRead;
+
+static LTCADC_BackgroundRead LTCADC_Read;
 
 #pragma region PRIVATE_FUNCTION_PROTOYPES
 /// @brief Reads the current ADC value on channel 0 (Hardware CS)
@@ -33,6 +42,17 @@ static uint16_t LTCADC_ReadCH0(SPI_TypeDef *SPIx);
 /// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
 /// @return 12-bits of data representing the ADC's input on channel 1
 static uint16_t LTCADC_ReadCH1(SPI_TypeDef *SPIx);
+
+/// @brief Selects the ADC and sends the command frame of a background read
+/// @param LTC_ADC Struct containing configuration data for the ADC
+/// @param command Command frame for the channel to read
+/// @param callback Called with the sample once the read is done
+/// @return True if the read was started, false if the previous background read has not finished
+static bool LTCADC_StartRead(LTC1298_t LTC_ADC, uint16_t command, LTCADC_Callback callback);
+
+/// @brief SPI receive callback that steps a background read through its frames
+/// @param data Frame received from the ADC
+static void LTCADC_ReadInterruptHandler(uint16_t data);
 #pragma endregion
 
 LTC1298_t LTCADC_InitCS(SPI_TypeDef *SPIx, GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN){
@@ -44,21 +64,47 @@ LTC1298_t LTCADC_InitCS(SPI_TypeDef *SPIx, GPIO_TypeDef *GPIOx, uint16_t GPIO_PI
 }
 
 uint16_t LTCADC_ReadCH0CS(LTC1298_t LTC_ADC){
+    SPI_Lock(LTC_ADC.SPIx);                             // Hold the bus for the whole CS cycle (Thread-safe build)
     GPIO_Clear(LTC_ADC.GPIOx_CS, LTC_ADC.GPIO_PIN_CS);  // Set the Chip Select Low
     uint16_t adcData = LTCADC_ReadCH0(LTC_ADC.SPIx);    // Read the value from the ADC
-    while(READ_BIT(LTC_ADC.SPIx->SR, SPI_SR_BSY)){}     // Wait until SPIx is done
+    SPI_WaitUntilIdle(LTC_ADC.SPIx);                    // Wait until SPIx is done
     GPIO_Set(LTC_ADC.GPIOx_CS, LTC_ADC.GPIO_PIN_CS);    // Set the Chip Select High
+    SPI_Unlock(LTC_ADC.SPIx);
     return adcData;
 }
 
 uint16_t LTCADC_ReadCH1CS(LTC1298_t LTC_ADC){
+    SPI_Lock(LTC_ADC.SPIx);                             // Hold the bus for the whole CS cycle (Thread-safe build)
     GPIO_Clear(LTC_ADC.GPIOx_CS, LTC_ADC.GPIO_PIN_CS);  // Set the Chip Select Low
     uint16_t adcData = LTCADC_ReadCH1(LTC_ADC.SPIx);    // Read the value from the ADC
-    while(READ_BIT(LTC_ADC.SPIx->SR, SPI_SR_BSY)){}     // Wait until SPIx is done
+    SPI_WaitUntilIdle(LTC_ADC.SPIx);                    // Wait until SPIx is done
     GPIO_Set(LTC_ADC.GPIOx_CS, LTC_ADC.GPIO_PIN_CS);    // Set the Chip Select High
+    SPI_Unlock(LTC_ADC.SPIx);
     return adcData;
 }
 
+void LTCADC_ReadBlockCH0CS(LTC1298_t LTC_ADC, uint16_t *buffer, uint16_t count){
+    for(uint16_t i = 0; i < count; i++)
+        buffer[i] = LTCADC_ReadCH0CS(LTC_ADC);  // Each conversion needs its own CS cycle {See LTC1298-11}
+}
+
+void LTCADC_ReadBlockCH1CS(LTC1298_t LTC_ADC, uint16_t *buffer, uint16_t count){
+    for(uint16_t i = 0; i < count; i++)
+        buffer[i] = LTCADC_ReadCH1CS(LTC_ADC);  // Each conversion needs its own CS cycle {See LTC1298-11}
+}
+
+bool LTCADC_StartReadCH0CS(LTC1298_t LTC_ADC, LTCADC_Callback callback){
+    return LTCADC_StartRead(LTC_ADC, ADC_TRANSMISSON_START | ADC_MUX_MODE_SINGLE_ENDED | ADC_MUX_CHANNEL_0 | ADC_MUX_MSBFIRST, callback);
+}
+
+bool LTCADC_StartReadCH1CS(LTC1298_t LTC_ADC, LTCADC_Callback callback){
+    return LTCADC_StartRead(LTC_ADC, ADC_TRANSMISSON_START | ADC_MUX_MODE_SINGLE_ENDED | ADC_MUX_CHANNEL_1 | ADC_MUX_MSBFIRST, callback);
+}
+
+bool LTCADC_IsReading(void){
+    return LTCADC_Read.framesLeft != 0;
+}
+
 #pragma region PRIVATE_STATIC_FUNCTIONS
 static uint16_t LTCADC_ReadCH0(SPI_TypeDef *SPIx){
     uint16_t dataToTransmit = ADC_TRANSMISSON_START | ADC_MUX_MODE_SINGLE_ENDED | ADC_MUX_CHANNEL_0 | ADC_MUX_MSBFIRST;
@@ -71,4 +117,36 @@ static uint16_t LTCADC_ReadCH1(SPI_TypeDef *SPIx){
     SPI_Transmit(SPIx, dataToTransmit);         // Send the data to start the tranmission
     return SPI_TransmitReceive(SPIx, 0) >> 3;   // Data to send does not matter {See LTC1298-11}
 }
+
+static bool LTCADC_StartRead(LTC1298_t LTC_ADC, uint16_t command, LTCADC_Callback callback){
+    if(LTCADC_Read.framesLeft != 0)                             // Only one read can use the SPI at a time
+        return false;
+    if(!SPI_TryLockBackground(LTC_ADC.SPIx))                    // A thread is in the middle of a transfer (Thread-safe build)
+        return false;
+
+    LTCADC_Read.LTC_ADC = LTC_ADC;
+    LTCADC_Read.callback = callback;
+    LTCADC_Read.framesLeft = ADC_FRAMES_PER_READ;
+    SPI_SetReceiveCallback(LTC_ADC.SPIx, LTCADC_ReadInterruptHandler);
+    GPIO_Clear(LTC_ADC.GPIOx_CS, LTC_ADC.GPIO_PIN_CS);          // Set the Chip Select Low
+    SPI_Transmit(LTC_ADC.SPIx, command);                        // Send the data to start the transmission
+    return true;
+}
+
+static void LTCADC_ReadInterruptHandler(uint16_t data){
+    if(LTCADC_Read.framesLeft == 0)                             // Not our frame
+        return;
+
+    if(--LTCADC_Read.framesLeft != 0){                          // Command frame is done, clock out the sample
+        SPI_Transmit(LTCADC_Read.LTC_ADC.SPIx, 0);              // Data to send does not matter {See LTC1298-11}
+        return;
+    }
+
+    SPI_WaitUntilIdle(LTCADC_Read.LTC_ADC.SPIx);                // Wait until SPIx is done
+    GPIO_Set(LTCADC_Read.LTC_ADC.GPIOx_CS, LTCADC_Read.LTC_ADC.GPIO_PIN_CS);    // Set the Chip Select High
+    SPI_SetReceiveCallback(LTCADC_Read.LTC_ADC.SPIx, 0);        // Hand SPIx back to the blocking functions
+    SPI_UnlockBackground(LTCADC_Read.LTC_ADC.SPIx);
+    if(LTCADC_Read.callback)
+        LTCADC_Read.callback(data >> 3);                        // framesLeft is already 0 so the callback can start the next read
+}
 #pragma endregion
\ No newline at end of file
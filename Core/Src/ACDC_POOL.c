@@ -0,0 +1,208 @@
+/**
+ * @file ACDC_POOL.c
+ * @author Devin Marx
+ * @brief Implementation of the fixed-block memory pools
+ * @version 0.1
+ * @date 2024-04-28
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_POOL.h"
+#include "ACDC_USART.h"
+#include "ACDC_string.h"
+
+#define POOL_LINE_SIZE 96   // "POOL," + name + 6 numbers + commas + "\r\n"
+
+static POOL_t *Pools[POOL_MAX_POOLS];   // Registered pools, smallest blocks first
+static uint8_t PoolCount = 0;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Adds to a counter that interrupts may also be changing
+/// @param counter Counter to add to
+/// @param value Value to add (Cast -1 to subtract)
+/// @return Value of the counter after the add
+static uint32_t POOL_AtomicAdd(volatile uint32_t *counter, uint32_t value);
+
+/// @brief Raises a value to candidate if it is lower, even if interrupts are also raising it
+/// @param value Value to raise
+/// @param candidate New value if it is larger
+static void POOL_AtomicMax(volatile uint32_t *value, uint32_t candidate);
+
+/// @brief Pops the first free block of a pool without counting a failure if there is none
+/// @param pool Pool to take from
+/// @return Block, NULL if the pool is empty
+static void *POOL_Take(POOL_t *pool);
+
+/// @brief Checks if an address is the start of one of a pool's blocks
+/// @param pool Pool to check
+/// @param block Address to check
+/// @return True if block is a block of pool
+static bool POOL_Owns(const POOL_t *pool, const void *block);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool POOL_Init(POOL_t *pool, const char *name, void *memory, uint16_t blockSize, uint16_t blockCount){
+    if(memory == NULL || blockSize == 0 || blockCount == 0 || ((uint32_t)memory & (POOL_ALIGNMENT - 1)) != 0)
+        return false;
+
+    pool->memory = memory;
+    pool->name = name;
+    pool->blockSize = POOL_BLOCK_SIZE(blockSize);
+    pool->blockCount = blockCount;
+
+    // Every free block holds the address of the next one in its first word, the last one holds 0
+    for(uint16_t i = 0; i < blockCount; i++){
+        uint8_t *block = pool->memory + (uint32_t)i * pool->blockSize;
+        *(uint32_t *)block = (i + 1 < blockCount) ? (uint32_t)(block + pool->blockSize) : 0;
+    }
+    pool->freeList = (uint32_t)pool->memory;
+    pool->used = 0;
+    pool->highWater = 0;
+    pool->allocs = 0;
+    pool->failures = 0;
+
+    for(uint8_t i = 0; i < PoolCount; i++)
+        if(Pools[i] == pool)
+            return true;                                    // Set up again, already registered
+    if(PoolCount >= POOL_MAX_POOLS)
+        return false;
+
+    uint8_t i = PoolCount;
+    while(i > 0 && Pools[i - 1]->blockSize > pool->blockSize){
+        Pools[i] = Pools[i - 1];                            // Keep the table sorted so POOL_Alloc finds the best fit first
+        i--;
+    }
+    Pools[i] = pool;
+    PoolCount++;
+    return true;
+}
+
+void *POOL_AllocFrom(POOL_t *pool){
+    void *block = POOL_Take(pool);
+    if(block == NULL)
+        POOL_AtomicAdd(&pool->failures, 1);
+    return block;
+}
+
+void POOL_FreeTo(POOL_t *pool, void *block){
+    uint32_t head;
+    do{
+        head = __LDREXW(&pool->freeList);
+        *(uint32_t *)block = head;                          // The freed block points at the old first block
+    }while(__STREXW((uint32_t)block, &pool->freeList) != 0);
+    POOL_AtomicAdd(&pool->used, (uint32_t)-1);
+}
+
+void *POOL_Alloc(uint32_t size){
+    POOL_t *bestFit = NULL;
+    for(uint8_t i = 0; i < PoolCount; i++){
+        if(Pools[i]->blockSize < size)
+            continue;
+        if(bestFit == NULL)
+            bestFit = Pools[i];
+        void *block = POOL_Take(Pools[i]);                  // An empty pool is not a failure yet, the next size up is tried
+        if(block != NULL)
+            return block;
+    }
+    if(bestFit != NULL)
+        POOL_AtomicAdd(&bestFit->failures, 1);              // Every pool that fits is empty, the size class asked for is too small
+    return NULL;
+}
+
+bool POOL_Free(void *block){
+    if(block == NULL)
+        return false;
+    for(uint8_t i = 0; i < PoolCount; i++){
+        if(POOL_Owns(Pools[i], block)){
+            POOL_FreeTo(Pools[i], block);
+            return true;
+        }
+    }
+    return false;
+}
+
+void POOL_GetStats(const POOL_t *pool, POOL_Stats_t *stats){
+    stats->name = pool->name;
+    stats->blockSize = pool->blockSize;
+    stats->blockCount = pool->blockCount;
+    stats->used = pool->used;
+    stats->highWater = pool->highWater;
+    stats->allocs = pool->allocs;
+    stats->failures = pool->failures;
+}
+
+void POOL_ResetStats(POOL_t *pool){
+    pool->allocs = 0;
+    pool->failures = 0;
+    pool->highWater = pool->used;
+}
+
+void POOL_Report(USART_TypeDef *USARTx){
+    char line[POOL_LINE_SIZE];
+    StringBuilder sb = StringBuilderInit(line, sizeof(line));
+    for(uint8_t i = 0; i < PoolCount; i++){
+        POOL_Stats_t stats;
+        POOL_GetStats(Pools[i], &stats);
+
+        StringBuilderClear(&sb);
+        StringBuilderAppend(&sb, "POOL,");
+        StringBuilderAppend(&sb, stats.name);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats.blockSize);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats.blockCount);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats.used);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats.highWater);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats.allocs);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats.failures);
+        StringBuilderAppend(&sb, "\r\n");
+        USART_SendBuffer(USARTx, sb.buffer, sb.length);
+    }
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static uint32_t POOL_AtomicAdd(volatile uint32_t *counter, uint32_t value){
+    uint32_t result;
+    do{
+        result = __LDREXW(counter) + value;
+    }while(__STREXW(result, counter) != 0);
+    return result;
+}
+
+static void POOL_AtomicMax(volatile uint32_t *value, uint32_t candidate){
+    do{
+        if(__LDREXW(value) >= candidate){
+            __CLREX();
+            return;
+        }
+    }while(__STREXW(candidate, value) != 0);
+}
+
+static void *POOL_Take(POOL_t *pool){
+    // Pop the first free block. Any interrupt between LDREX and STREX clears the exclusive monitor and the STREX
+    // fails, so the next address read from the block can never be stale (No ABA on a single core)
+    uint32_t block;
+    do{
+        block = __LDREXW(&pool->freeList);
+        if(block == 0){
+            __CLREX();
+            return NULL;
+        }
+    }while(__STREXW(*(const uint32_t *)block, &pool->freeList) != 0);
+
+    POOL_AtomicAdd(&pool->allocs, 1);
+    POOL_AtomicMax(&pool->highWater, POOL_AtomicAdd(&pool->used, 1));
+    return (void *)block;
+}
+
+static bool POOL_Owns(const POOL_t *pool, const void *block){
+    uint32_t offset = (uint32_t)block - (uint32_t)pool->memory;    // Addresses below memory wrap to a huge offset
+    return offset < (uint32_t)pool->blockSize * pool->blockCount && (offset % pool->blockSize) == 0;
+}
+#pragma endregion
@@ -0,0 +1,818 @@
+/**
+ * @file ACDC_RTOS.c
+ * @author Devin Marx
+ * @brief Implementation of the CMSIS-RTOS2 subset kernel used by the thread-safe build
+ * @version 0.1
+ * @date 2024-04-27
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_RTOS.h"
+#include "ACDC_INTERRUPT.h"
+
+#ifdef ACDC_THREAD_SAFE
+
+#define RTOS_THREAD_COUNT   (RTOS_MAX_THREADS + 1)  // The idle thread takes the last slot
+#define RTOS_IDLE_THREAD    (&RTOS_Threads[RTOS_MAX_THREADS])
+#define RTOS_STACK_FILL     0xCDCDCDCDUL            // Stack words that were never used (Counted by osThreadGetStackSpace)
+#define RTOS_FRAME_WORDS    16                      // r4-r11 saved by PendSV_Handler + r0-r3, r12, lr, pc, xPSR saved by the core
+#define RTOS_XPSR_THUMB     0x01000000UL            // Thumb bit, must be set in every exception return frame {See PM-20}
+#define RTOS_PENDSV_PRIO    15                      // Lowest priority, so threads only switch once every interrupt has finished
+
+typedef enum{
+    RTOS_WAIT_NONE,
+    RTOS_WAIT_DELAY,
+    RTOS_WAIT_FLAGS,
+    RTOS_WAIT_MUTEX,
+    RTOS_WAIT_SEMAPHORE
+}RTOS_WaitType;
+
+typedef struct{
+    uint32_t *sp;                   // Saved stack pointer (First, PendSV_Handler reads and writes it at offset 0)
+    uint32_t *stack;                // Lowest word of the stack
+    uint32_t stackSize;             // Stack size in bytes
+    bool poolStack;                 // Stack came from RTOS_StackPool (Kept for the next thread created in this slot)
+    const char *name;
+    osThreadState_t state;          // osThreadReady is used for the running thread too
+    osPriority_t priority;          // Current priority (Raised while holding a priority inherit mutex a higher thread waits on)
+    osPriority_t basePriority;      // Priority given to osThreadNew
+    volatile uint32_t flags;        // Thread flags
+    uint32_t waitFlags;             // Flags and options of osThreadFlagsWait
+    uint32_t waitOptions;
+    RTOS_WaitType waitType;         // What a blocked thread waits for
+    void *waitObject;               // Mutex or semaphore waited on
+    uint32_t timeout;               // Ticks left before the wait ends (osWaitForever never ends)
+    uint32_t waitResult;            // osStatus_t or thread flags handed to the thread when the wait ends
+}RTOS_Thread_t;
+
+// Read by PendSV_Handler, so they keep their names
+__attribute__((used)) RTOS_Thread_t *volatile RTOS_CurrentThread = NULL;
+__attribute__((used)) RTOS_Thread_t *volatile RTOS_NextThread = NULL;
+
+static RTOS_Thread_t RTOS_Threads[RTOS_THREAD_COUNT];
+static RTOS_Mutex_t RTOS_Mutexes[RTOS_MAX_MUTEXES];
+static RTOS_Semaphore_t RTOS_Semaphores[RTOS_MAX_SEMAPHORES];
+static uint32_t RTOS_StackPool[RTOS_STACK_POOL_SIZE / 4] __attribute__((aligned(8)));
+static uint32_t RTOS_IdleStack[RTOS_IDLE_STACK_SIZE / 4] __attribute__((aligned(8)));
+static uint32_t RTOS_StackPoolUsed;         // Bytes of RTOS_StackPool handed out
+static volatile osKernelState_t RTOS_State = osKernelInactive;
+static volatile uint32_t RTOS_TickCount;
+static volatile uint8_t RTOS_Locked;        // osKernelLock nesting (0 or 1)
+static uint8_t RTOS_SliceTicks;             // Ticks since the last round robin
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Checks if the caller is an interrupt handler
+/// @return True in handler mode
+static bool RTOS_InISR(void);
+
+/// @brief Checks if the running thread can block, with the interrupts already disabled by the caller
+/// @param primask PRIMASK the caller saved before disabling interrupts
+/// @return True if the running thread may wait
+static bool RTOS_CanWait(uint32_t primask);
+
+/// @brief Picks the highest priority ready thread and pends PendSV if it is not the running thread (Interrupts disabled)
+/// @param rotate True to move on to the next ready thread of the same priority (Round robin and osThreadYield)
+static void RTOS_Schedule(bool rotate);
+
+/// @brief Blocks the running thread until it is woken or the timeout runs out (Interrupts disabled, returns with them disabled)
+/// @param waitType What the thread waits for
+/// @param object Mutex or semaphore waited on, NULL otherwise
+/// @param timeout Ticks to wait (osWaitForever to wait forever)
+/// @return Result handed over by RTOS_Wake
+static uint32_t RTOS_Wait(RTOS_WaitType waitType, void *object, uint32_t timeout);
+
+/// @brief Makes a blocked thread ready (Interrupts disabled, call RTOS_Schedule afterwards)
+/// @param thread Thread to wake
+/// @param result Value its wait returns
+static void RTOS_Wake(RTOS_Thread_t *thread, uint32_t result);
+
+/// @brief Works out the priority of a mutex owner again (Its base priority or that of its highest priority inherit waiter),
+///        then does the same for the owner of the mutex it waits on, and so on down the chain (Interrupts disabled)
+/// @param thread Owner whose waiters changed, NULL does nothing
+static void RTOS_UpdatePriority(RTOS_Thread_t *thread);
+
+/// @brief Finds the highest priority thread waiting on an object
+/// @param waitType Type of the object
+/// @param object Mutex or semaphore
+/// @return Waiting thread, NULL if none
+static RTOS_Thread_t* RTOS_HighestWaiter(RTOS_WaitType waitType, const void *object);
+
+/// @brief Checks if a thread id points to a thread slot that is in use
+/// @param thread Thread id
+/// @return True if it is a created thread that has not exited
+static bool RTOS_IsThread(const RTOS_Thread_t *thread);
+
+/// @brief Builds the first exception frame of a thread so PendSV_Handler can start it like any other thread
+/// @param thread Thread whose stack is set up
+/// @param func Thread function
+/// @param argument Handed to func in r0
+static void RTOS_InitStack(RTOS_Thread_t *thread, osThreadFunc_t func, void *argument);
+
+/// @brief Runs when a thread function returns
+static void RTOS_ThreadReturn(void);
+
+/// @brief Idle thread, sleeps with WFI whenever no other thread is ready
+/// @param argument Unused
+static void RTOS_IdleThread(void *argument);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+osStatus_t osKernelInitialize(void){
+    if(RTOS_InISR())
+        return osErrorISR;
+    if(RTOS_State == osKernelRunning)
+        return osError;
+
+    for(uint8_t i = 0; i < RTOS_THREAD_COUNT; i++)
+        RTOS_Threads[i] = (RTOS_Thread_t){0};
+    for(uint8_t i = 0; i < RTOS_MAX_MUTEXES; i++)
+        RTOS_Mutexes[i] = (RTOS_Mutex_t){0};
+    for(uint8_t i = 0; i < RTOS_MAX_SEMAPHORES; i++)
+        RTOS_Semaphores[i] = (RTOS_Semaphore_t){0};
+    RTOS_StackPoolUsed = 0;
+    RTOS_TickCount = 0;
+    RTOS_Locked = 0;
+    RTOS_SliceTicks = 0;
+    RTOS_CurrentThread = NULL;
+    RTOS_NextThread = NULL;
+
+    RTOS_Thread_t *idle = RTOS_IDLE_THREAD;
+    idle->stack = RTOS_IdleStack;
+    idle->stackSize = sizeof(RTOS_IdleStack);
+    idle->name = "idle";
+    idle->priority = osPriorityIdle;
+    idle->basePriority = osPriorityIdle;
+    RTOS_InitStack(idle, RTOS_IdleThread, NULL);
+    idle->state = osThreadReady;
+
+    RTOS_State = osKernelReady;
+    return osOK;
+}
+
+osStatus_t osKernelStart(void){
+    if(RTOS_InISR())
+        return osErrorISR;
+    if(RTOS_State != osKernelReady)
+        return osError;
+
+    INTERRUPT_SetPriority(PendSV_IRQn, RTOS_PENDSV_PRIO);
+    __disable_irq();
+    RTOS_State = osKernelRunning;
+    RTOS_Schedule(false);           // RTOS_CurrentThread is NULL, so PendSV_Handler starts the first thread without saving main
+    __enable_irq();                 // PendSV runs here and never comes back
+#ifdef ACDC_HOST_TEST
+    return osOK;                    // The simulated PendSV does come back, the host test goes on as the first thread
+#else
+    while(1){}
+#endif
+}
+
+osKernelState_t osKernelGetState(void){
+    if(RTOS_State == osKernelRunning && RTOS_Locked)
+        return osKernelLocked;
+    return RTOS_State;
+}
+
+int32_t osKernelLock(void){
+    if(RTOS_InISR())
+        return osErrorISR;
+    if(RTOS_State != osKernelRunning)
+        return osError;
+    int32_t previous = RTOS_Locked;
+    RTOS_Locked = 1;
+    return previous;
+}
+
+int32_t osKernelUnlock(void){
+    if(RTOS_InISR())
+        return osErrorISR;
+    if(RTOS_State != osKernelRunning)
+        return osError;
+    int32_t previous = RTOS_Locked;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    RTOS_Locked = 0;
+    RTOS_Schedule(false);           // Threads woken while locked run now
+    __set_PRIMASK(primask);
+    return previous;
+}
+
+int32_t osKernelRestoreLock(int32_t lock){
+    if(lock == 0)
+        return (osKernelUnlock() < 0) ? osError : 0;
+    if(lock == 1)
+        return (osKernelLock() < 0) ? osError : 1;
+    return osErrorParameter;
+}
+
+uint32_t osKernelGetTickCount(void){
+    return RTOS_TickCount;
+}
+
+uint32_t osKernelGetTickFreq(void){
+    return RTOS_TICK_FREQ;
+}
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr){
+    if(RTOS_InISR() || func == NULL || RTOS_State == osKernelInactive)
+        return NULL;
+
+    osPriority_t priority = (attr != NULL && attr->priority != osPriorityNone) ? attr->priority : osPriorityNormal;
+    if(priority < osPriorityIdle || priority >= osPriorityISR)
+        return NULL;
+    uint32_t stackSize = (attr != NULL && attr->stack_size != 0) ? attr->stack_size : RTOS_DEFAULT_STACK_SIZE;
+    stackSize &= ~7UL;                                      // Whole 8 byte aligned frames only
+    if(stackSize < RTOS_MIN_STACK_SIZE)
+        return NULL;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    RTOS_Thread_t *thread = NULL;
+    for(uint8_t i = 0; i < RTOS_MAX_THREADS && thread == NULL; i++){
+        RTOS_Thread_t *slot = &RTOS_Threads[i];
+        if(slot->state == osThreadInactive || (slot->state == osThreadTerminated && slot != RTOS_CurrentThread))
+            thread = slot;
+    }
+
+    uint32_t *stack = NULL;
+    bool poolStack = false;
+    if(thread != NULL){
+        if(attr != NULL && attr->stack_mem != NULL){
+            if(((uint32_t)attr->stack_mem & 7UL) == 0)     // The first frame must be 8 byte aligned
+                stack = attr->stack_mem;
+        } else if(thread->poolStack && thread->stackSize >= stackSize){
+            stack = thread->stack;                          // Reuse the stack of the thread that exited from this slot
+            stackSize = thread->stackSize;
+            poolStack = true;
+        } else if(RTOS_StackPoolUsed + stackSize <= sizeof(RTOS_StackPool)){
+            stack = &RTOS_StackPool[RTOS_StackPoolUsed / 4];
+            RTOS_StackPoolUsed += stackSize;
+            poolStack = true;
+        }
+    }
+    if(stack == NULL){
+        __set_PRIMASK(primask);
+        return NULL;
+    }
+
+    *thread = (RTOS_Thread_t){0};
+    thread->stack = stack;
+    thread->stackSize = stackSize;
+    thread->poolStack = poolStack;
+    thread->name = (attr != NULL) ? attr->name : NULL;
+    thread->priority = priority;
+    thread->basePriority = priority;
+    RTOS_InitStack(thread, func, argument);
+    thread->state = osThreadReady;
+    RTOS_Schedule(false);                                   // Runs right away if it outranks the caller
+    __set_PRIMASK(primask);
+    return thread;
+}
+
+const char *osThreadGetName(osThreadId_t thread_id){
+    const RTOS_Thread_t *thread = thread_id;
+    return RTOS_IsThread(thread) ? thread->name : NULL;
+}
+
+osThreadId_t osThreadGetId(void){
+    return RTOS_CurrentThread;
+}
+
+osThreadState_t osThreadGetState(osThreadId_t thread_id){
+    const RTOS_Thread_t *thread = thread_id;
+    if(thread < RTOS_Threads || thread >= &RTOS_Threads[RTOS_THREAD_COUNT])
+        return osThreadError;
+    if(thread == RTOS_CurrentThread && thread->state == osThreadReady)
+        return osThreadRunning;
+    return thread->state;
+}
+
+osPriority_t osThreadGetPriority(osThreadId_t thread_id){
+    const RTOS_Thread_t *thread = thread_id;
+    return RTOS_IsThread(thread) ? thread->priority : osPriorityError;
+}
+
+uint32_t osThreadGetStackSize(osThreadId_t thread_id){
+    const RTOS_Thread_t *thread = thread_id;
+    return RTOS_IsThread(thread) ? thread->stackSize : 0;
+}
+
+uint32_t osThreadGetStackSpace(osThreadId_t thread_id){
+    const RTOS_Thread_t *thread = thread_id;
+    if(!RTOS_IsThread(thread))
+        return 0;
+    uint32_t words = 0;
+    while(words < thread->stackSize / 4 && thread->stack[words] == RTOS_STACK_FILL)
+        words++;                                            // The stack grows down, so the untouched words are at the bottom
+    return words * 4;
+}
+
+osStatus_t osThreadYield(void){
+    if(RTOS_InISR())
+        return osErrorISR;
+    if(RTOS_State != osKernelRunning)
+        return osError;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    RTOS_Schedule(true);
+    __set_PRIMASK(primask);
+    return osOK;
+}
+
+__NO_RETURN void osThreadExit(void){
+    __disable_irq();
+    RTOS_CurrentThread->state = osThreadTerminated;         // The slot is reused once another thread is running
+    RTOS_Schedule(false);
+    __enable_irq();
+    while(1){}
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags){
+    RTOS_Thread_t *thread = thread_id;
+    if(!RTOS_IsThread(thread) || (flags & osFlagsError))
+        return osFlagsErrorParameter;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    thread->flags |= flags;
+    uint32_t result = thread->flags;
+    if(thread->state == osThreadBlocked && thread->waitType == RTOS_WAIT_FLAGS){
+        uint32_t match = result & thread->waitFlags;
+        bool done = (thread->waitOptions & osFlagsWaitAll) ? (match == thread->waitFlags) : (match != 0);
+        if(done){
+            if(!(thread->waitOptions & osFlagsNoClear))
+                thread->flags &= ~thread->waitFlags;
+            RTOS_Wake(thread, result);
+            RTOS_Schedule(false);
+        }
+    }
+    __set_PRIMASK(primask);
+    return result;
+}
+
+uint32_t osThreadFlagsClear(uint32_t flags){
+    if(RTOS_InISR())
+        return osFlagsErrorISR;
+    RTOS_Thread_t *thread = RTOS_CurrentThread;
+    if(thread == NULL || (flags & osFlagsError))
+        return (thread == NULL) ? osFlagsErrorUnknown : osFlagsErrorParameter;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t result = thread->flags;
+    thread->flags &= ~flags;
+    __set_PRIMASK(primask);
+    return result;
+}
+
+uint32_t osThreadFlagsGet(void){
+    if(RTOS_InISR() || RTOS_CurrentThread == NULL)
+        return 0;
+    return RTOS_CurrentThread->flags;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout){
+    if(RTOS_InISR())
+        return osFlagsErrorISR;
+    RTOS_Thread_t *thread = RTOS_CurrentThread;
+    if(thread == NULL)
+        return osFlagsErrorUnknown;
+    if(flags == 0 || (flags & osFlagsError))
+        return osFlagsErrorParameter;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t result = thread->flags;
+    uint32_t match = result & flags;
+    bool done = (options & osFlagsWaitAll) ? (match == flags) : (match != 0);
+    if(done){
+        if(!(options & osFlagsNoClear))
+            thread->flags &= ~flags;
+    } else if(timeout == 0){
+        result = osFlagsErrorResource;
+    } else if(!RTOS_CanWait(primask)){
+        result = osFlagsErrorUnknown;
+    } else {
+        thread->waitFlags = flags;
+        thread->waitOptions = options;
+        result = RTOS_Wait(RTOS_WAIT_FLAGS, NULL, timeout);
+    }
+    __set_PRIMASK(primask);
+    return result;
+}
+
+osStatus_t osDelay(uint32_t ticks){
+    if(RTOS_InISR())
+        return osErrorISR;
+    if(ticks == 0)
+        return osOK;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    osStatus_t status = osError;
+    if(RTOS_CanWait(primask))
+        status = (osStatus_t)RTOS_Wait(RTOS_WAIT_DELAY, NULL, ticks);
+    __set_PRIMASK(primask);
+    return status;
+}
+
+osStatus_t osDelayUntil(uint32_t ticks){
+    if(RTOS_InISR())
+        return osErrorISR;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t delay = ticks - RTOS_TickCount;                // Unsigned subtraction handles the tick count wrapping
+    osStatus_t status = osErrorParameter;
+    if(delay == 0 || delay > 0x7FFFFFFFUL)                  // Already in the past
+        status = osErrorParameter;
+    else if(RTOS_CanWait(primask))
+        status = (osStatus_t)RTOS_Wait(RTOS_WAIT_DELAY, NULL, delay);
+    else
+        status = osError;
+    __set_PRIMASK(primask);
+    return status;
+}
+
+osMutexId_t osMutexNew(const osMutexAttr_t *attr){
+    if(RTOS_InISR())
+        return NULL;
+
+    RTOS_Mutex_t *mutex = NULL;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if(attr != NULL && attr->cb_mem != NULL){
+        if(attr->cb_size >= sizeof(RTOS_Mutex_t))
+            mutex = attr->cb_mem;
+    } else {
+        for(uint8_t i = 0; i < RTOS_MAX_MUTEXES && mutex == NULL; i++)
+            if(!RTOS_Mutexes[i].used)
+                mutex = &RTOS_Mutexes[i];
+    }
+    if(mutex != NULL){
+        *mutex = (RTOS_Mutex_t){0};
+        mutex->used = (attr == NULL || attr->cb_mem == NULL);
+        mutex->attr = (attr != NULL) ? attr->attr_bits : 0;
+        mutex->name = (attr != NULL) ? attr->name : NULL;
+    }
+    __set_PRIMASK(primask);
+    return mutex;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout){
+    if(RTOS_InISR())
+        return osErrorISR;
+    RTOS_Mutex_t *mutex = mutex_id;
+    RTOS_Thread_t *thread = RTOS_CurrentThread;
+    if(mutex == NULL)
+        return osErrorParameter;
+    if(thread == NULL)
+        return osError;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    osStatus_t status = osOK;
+    if(mutex->owner == NULL){
+        mutex->owner = thread;
+        mutex->count = 1;
+    } else if(mutex->owner == thread){
+        if(mutex->attr & osMutexRecursive)
+            mutex->count++;
+        else
+            status = osErrorResource;
+    } else if(timeout == 0){
+        status = osErrorResource;
+    } else if(!RTOS_CanWait(primask)){
+        status = osError;
+    } else {
+        status = (osStatus_t)RTOS_Wait(RTOS_WAIT_MUTEX, mutex, timeout);   // osOK means osMutexRelease handed it over
+    }
+    __set_PRIMASK(primask);
+    return status;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id){
+    if(RTOS_InISR())
+        return osErrorISR;
+    RTOS_Mutex_t *mutex = mutex_id;
+    RTOS_Thread_t *thread = RTOS_CurrentThread;
+    if(mutex == NULL)
+        return osErrorParameter;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if(thread == NULL || mutex->owner != thread){
+        __set_PRIMASK(primask);
+        return osErrorResource;
+    }
+    if(--mutex->count == 0){
+        RTOS_Thread_t *waiter = RTOS_HighestWaiter(RTOS_WAIT_MUTEX, mutex);
+        mutex->owner = waiter;
+        if(waiter != NULL){
+            mutex->count = 1;
+            RTOS_Wake(waiter, osOK);
+            RTOS_UpdatePriority(waiter);                    // Inherits from the threads still waiting
+        }
+        RTOS_UpdatePriority(thread);                        // Drops what it inherited through this mutex
+        RTOS_Schedule(false);
+    }
+    __set_PRIMASK(primask);
+    return osOK;
+}
+
+osThreadId_t osMutexGetOwner(osMutexId_t mutex_id){
+    const RTOS_Mutex_t *mutex = mutex_id;
+    return (mutex != NULL) ? mutex->owner : NULL;
+}
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr){
+    if(RTOS_InISR() || max_count == 0 || initial_count > max_count)
+        return NULL;
+
+    RTOS_Semaphore_t *semaphore = NULL;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if(attr != NULL && attr->cb_mem != NULL){
+        if(attr->cb_size >= sizeof(RTOS_Semaphore_t))
+            semaphore = attr->cb_mem;
+    } else {
+        for(uint8_t i = 0; i < RTOS_MAX_SEMAPHORES && semaphore == NULL; i++)
+            if(!RTOS_Semaphores[i].used)
+                semaphore = &RTOS_Semaphores[i];
+    }
+    if(semaphore != NULL){
+        *semaphore = (RTOS_Semaphore_t){0};
+        semaphore->used = (attr == NULL || attr->cb_mem == NULL);
+        semaphore->count = initial_count;
+        semaphore->maxCount = max_count;
+        semaphore->name = (attr != NULL) ? attr->name : NULL;
+    }
+    __set_PRIMASK(primask);
+    return semaphore;
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout){
+    RTOS_Semaphore_t *semaphore = semaphore_id;
+    if(semaphore == NULL || (RTOS_InISR() && timeout != 0))
+        return osErrorParameter;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    osStatus_t status = osOK;
+    if(semaphore->count > 0)
+        semaphore->count--;
+    else if(timeout == 0)
+        status = osErrorResource;
+    else if(!RTOS_CanWait(primask))
+        status = osError;
+    else
+        status = (osStatus_t)RTOS_Wait(RTOS_WAIT_SEMAPHORE, semaphore, timeout);    // osOK means the token was handed over
+    __set_PRIMASK(primask);
+    return status;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id){
+    RTOS_Semaphore_t *semaphore = semaphore_id;
+    if(semaphore == NULL)
+        return osErrorParameter;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    osStatus_t status = osOK;
+    RTOS_Thread_t *waiter = RTOS_HighestWaiter(RTOS_WAIT_SEMAPHORE, semaphore);
+    if(waiter != NULL){
+        RTOS_Wake(waiter, osOK);                            // The token goes straight to the waiter
+        RTOS_Schedule(false);
+    } else if(semaphore->count < semaphore->maxCount){
+        semaphore->count++;
+    } else {
+        status = osErrorResource;
+    }
+    __set_PRIMASK(primask);
+    return status;
+}
+
+uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id){
+    const RTOS_Semaphore_t *semaphore = semaphore_id;
+    return (semaphore != NULL) ? semaphore->count : 0;
+}
+
+void RTOS_Tick(void){
+    if(RTOS_State != osKernelRunning)
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    RTOS_TickCount++;
+    for(uint8_t i = 0; i < RTOS_MAX_THREADS; i++){
+        RTOS_Thread_t *thread = &RTOS_Threads[i];
+        if(thread->state != osThreadBlocked || thread->timeout == osWaitForever || --thread->timeout != 0)
+            continue;
+        if(thread->waitType == RTOS_WAIT_DELAY){
+            RTOS_Wake(thread, (uint32_t)osOK);
+        } else if(thread->waitType == RTOS_WAIT_FLAGS){
+            RTOS_Wake(thread, osFlagsErrorTimeout);
+        } else if(thread->waitType == RTOS_WAIT_MUTEX){
+            RTOS_Mutex_t *mutex = thread->waitObject;
+            RTOS_Wake(thread, (uint32_t)osErrorTimeout);
+            RTOS_UpdatePriority(mutex->owner);              // The owner no longer runs at this thread's priority
+        } else {
+            RTOS_Wake(thread, (uint32_t)osErrorTimeout);
+        }
+    }
+
+    bool rotate = (++RTOS_SliceTicks >= RTOS_TIME_SLICE);
+    if(rotate)
+        RTOS_SliceTicks = 0;
+    RTOS_Schedule(rotate);
+    __set_PRIMASK(primask);
+}
+
+bool RTOS_CanBlock(void){
+    return !RTOS_InISR() && RTOS_CanWait(__get_PRIMASK());
+}
+
+uint8_t RTOS_GetThreadIndex(void){
+    const RTOS_Thread_t *thread = RTOS_CurrentThread;
+    if(RTOS_InISR() || thread == NULL || thread == RTOS_IDLE_THREAD)
+        return RTOS_MAX_THREADS;
+    return (uint8_t)(thread - RTOS_Threads);
+}
+
+void RTOS_DriverLock(RTOS_Mutex_t *mutex){
+    if(RTOS_CanBlock())
+        osMutexAcquire(mutex, osWaitForever);
+}
+
+void RTOS_DriverUnlock(RTOS_Mutex_t *mutex){
+    if(!RTOS_InISR() && mutex->owner != NULL && mutex->owner == RTOS_CurrentThread)
+        osMutexRelease(mutex);                              // Locks taken before osKernelStart were never acquired
+}
+
+#ifdef ACDC_HOST_TEST
+void PendSV_Handler(void){
+    // The host tests (Test/Sim) run on one stack, so the simulated PendSV only makes the next thread the running one.
+    // The test then acts as that thread, and a blocking call returns to it right away with the caller left blocked
+    RTOS_CurrentThread = RTOS_NextThread;
+}
+#else
+__attribute__((naked)) void PendSV_Handler(void){
+    // Saves r4-r11 of the running thread below its exception frame on PSP, then loads the next thread's.
+    // The first switch has no thread to save, and main()'s stack is never returned to, so MSP starts over for the handlers
+    __asm volatile(
+        "cpsid   i                                  \n"
+        "movw    r2, #:lower16:RTOS_CurrentThread   \n"
+        "movt    r2, #:upper16:RTOS_CurrentThread   \n"
+        "ldr     r1, [r2]                           \n"
+        "cbz     r1, 1f                             \n"
+        "mrs     r0, psp                            \n"
+        "stmdb   r0!, {r4-r11}                      \n"
+        "str     r0, [r1]                           \n"
+        "b       2f                                 \n"
+        "1:                                         \n"
+        "movw    r0, #0xED08                        \n"     // SCB->VTOR
+        "movt    r0, #0xE000                        \n"
+        "ldr     r0, [r0]                           \n"
+        "ldr     r0, [r0]                           \n"     // Initial stack pointer, first word of the vector table
+        "msr     msp, r0                            \n"
+        "2:                                         \n"
+        "movw    r3, #:lower16:RTOS_NextThread      \n"
+        "movt    r3, #:upper16:RTOS_NextThread      \n"
+        "ldr     r1, [r3]                           \n"
+        "str     r1, [r2]                           \n"
+        "ldr     r0, [r1]                           \n"
+        "ldmia   r0!, {r4-r11}                      \n"
+        "msr     psp, r0                            \n"
+        "mvn     lr, #2                             \n"     // EXC_RETURN 0xFFFFFFFD: thread mode on PSP {See PM-42}
+        "cpsie   i                                  \n"
+        "bx      lr                                 \n"
+    );
+}
+#endif
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static bool RTOS_InISR(void){
+    return __get_IPSR() != 0;
+}
+
+static bool RTOS_CanWait(uint32_t primask){
+    return primask == 0 && RTOS_State == osKernelRunning && !RTOS_Locked && RTOS_CurrentThread != NULL;
+}
+
+static void RTOS_Schedule(bool rotate){
+    if(RTOS_State != osKernelRunning || RTOS_Locked)
+        return;
+
+    // Scan from the thread after the running one, so the first ready thread of the top priority is the next in
+    // round robin order. Without rotate the running thread keeps the core unless a thread outranks it
+    RTOS_Thread_t *current = RTOS_CurrentThread;
+    bool currentReady = (current != NULL && current->state == osThreadReady);
+    RTOS_Thread_t *best = (currentReady && !rotate) ? current : NULL;
+    uint8_t start = (current == NULL) ? 0 : (uint8_t)(current - RTOS_Threads + 1);
+    for(uint8_t i = 0; i < RTOS_THREAD_COUNT; i++){
+        RTOS_Thread_t *thread = &RTOS_Threads[(start + i) % RTOS_THREAD_COUNT];
+        if(thread->state == osThreadReady && (best == NULL || thread->priority > best->priority))
+            best = thread;
+    }
+
+    RTOS_NextThread = best;                                 // The idle thread is always ready, so best is never NULL
+    if(best != current){
+        RTOS_SliceTicks = 0;
+        WRITE_REG(SCB->ICSR, SCB_ICSR_PENDSVSET_Msk);       // Switches once interrupts are enabled and every handler has returned
+    }
+}
+
+static uint32_t RTOS_Wait(RTOS_WaitType waitType, void *object, uint32_t timeout){
+    RTOS_Thread_t *thread = RTOS_CurrentThread;
+    thread->state = osThreadBlocked;
+    thread->waitType = waitType;
+    thread->waitObject = object;
+    thread->timeout = timeout;
+    if(waitType == RTOS_WAIT_MUTEX)
+        RTOS_UpdatePriority(((RTOS_Mutex_t*)object)->owner);   // The owner (And whatever it waits on) runs at our priority
+    RTOS_Schedule(false);
+    __enable_irq();                                         // PendSV switches away here, and comes back once the wait ends
+    __disable_irq();
+    return thread->waitResult;
+}
+
+static void RTOS_Wake(RTOS_Thread_t *thread, uint32_t result){
+    thread->state = osThreadReady;
+    thread->waitType = RTOS_WAIT_NONE;
+    thread->waitObject = NULL;
+    thread->waitResult = result;
+}
+
+static void RTOS_UpdatePriority(RTOS_Thread_t *thread){
+    // Each step follows a blocked owner to the owner of the mutex it waits on. A chain can not be longer than the
+    // thread table, which also ends the walk if threads wait on each other's mutexes in a loop (Deadlock)
+    for(uint8_t depth = 0; thread != NULL && depth < RTOS_THREAD_COUNT; depth++){
+        osPriority_t priority = thread->basePriority;
+        for(uint8_t i = 0; i < RTOS_MAX_THREADS; i++){
+            const RTOS_Thread_t *waiter = &RTOS_Threads[i];
+            if(waiter->state != osThreadBlocked || waiter->waitType != RTOS_WAIT_MUTEX)
+                continue;
+            const RTOS_Mutex_t *mutex = waiter->waitObject;
+            if(mutex->owner == thread && (mutex->attr & osMutexPrioInherit) && waiter->priority > priority)
+                priority = waiter->priority;
+        }
+        if(priority == thread->priority)
+            return;                                         // Nothing further down the chain changes either
+        thread->priority = priority;
+        if(thread->state != osThreadBlocked || thread->waitType != RTOS_WAIT_MUTEX)
+            return;
+        thread = ((RTOS_Mutex_t*)thread->waitObject)->owner;
+    }
+}
+
+static RTOS_Thread_t* RTOS_HighestWaiter(RTOS_WaitType waitType, const void *object){
+    RTOS_Thread_t *best = NULL;
+    for(uint8_t i = 0; i < RTOS_MAX_THREADS; i++){
+        RTOS_Thread_t *thread = &RTOS_Threads[i];
+        if(thread->state == osThreadBlocked && thread->waitType == waitType && thread->waitObject == object
+           && (best == NULL || thread->priority > best->priority))
+            best = thread;
+    }
+    return best;
+}
+
+static bool RTOS_IsThread(const RTOS_Thread_t *thread){
+    return thread >= RTOS_Threads && thread < &RTOS_Threads[RTOS_THREAD_COUNT]
+           && thread->state != osThreadInactive && thread->state != osThreadTerminated;
+}
+
+static void RTOS_InitStack(RTOS_Thread_t *thread, osThreadFunc_t func, void *argument){
+    uint32_t words = thread->stackSize / 4;
+    for(uint32_t i = 0; i < words; i++)
+        thread->stack[i] = RTOS_STACK_FILL;
+
+    uint32_t *sp = &thread->stack[words - RTOS_FRAME_WORDS];
+    for(uint8_t i = 0; i < 8; i++)
+        sp[i] = 0;                                          // r4-r11
+    sp[8]  = (uint32_t)argument;                            // r0
+    sp[9]  = 0;                                             // r1
+    sp[10] = 0;                                             // r2
+    sp[11] = 0;                                             // r3
+    sp[12] = 0;                                             // r12
+    sp[13] = (uint32_t)RTOS_ThreadReturn;                   // lr, where the thread function returns to
+    sp[14] = (uint32_t)func & ~1UL;                         // pc (Without the thumb bit, it is in xPSR)
+    sp[15] = RTOS_XPSR_THUMB;                               // xPSR
+    thread->sp = sp;
+}
+
+static void RTOS_ThreadReturn(void){
+    osThreadExit();
+}
+
+static void RTOS_IdleThread(void *argument){
+    (void)argument;
+    while(1){
+        __DSB();
+        __WFI();
+    }
+}
+#pragma endregion
+
+#endif
@@ -0,0 +1,266 @@
+/**
+ * @file ACDC_SCHEDULER.c
+ * @author Devin Marx
+ * @brief Implementation of the cooperative run to completion task scheduler
+ * @version 0.1
+ * @date 2024-04-25
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_SCHEDULER.h"
+#include "ACDC_USART.h"
+#include "ACDC_string.h"
+
+#define SCHEDULER_QUEUE_MASK (SCHEDULER_QUEUE_SIZE - 1)
+#define SCHEDULER_LINE_SIZE  112    // "TASK," + name + 7 numbers + commas + "\r\n"
+
+#if (SCHEDULER_QUEUE_SIZE & SCHEDULER_QUEUE_MASK) != 0
+#error "SCHEDULER_QUEUE_SIZE must be a power of 2"
+#endif
+
+typedef struct{
+    volatile uint32_t sequence;     // Position + 1 once the event is filled in, position + SCHEDULER_QUEUE_SIZE once it is free again
+    uint8_t task;
+    uint32_t arg;
+    uint32_t postCycles;
+}SCHEDULER_Event_t;
+
+typedef struct{
+    volatile uint32_t head;         // Next position to claim (Any context, claimed with LDREX/STREX)
+    uint32_t tail;                  // Next position to run (Main context only)
+    SCHEDULER_Event_t events[SCHEDULER_QUEUE_SIZE];
+}SCHEDULER_Queue_t;
+
+typedef struct{
+    SchedulerFunction function;
+    SCHEDULER_TaskStats_t stats;    // posts and dropped are updated from interrupts, the rest only from SCHEDULER_RunOne
+}SCHEDULER_Task_t;
+
+static SCHEDULER_Queue_t Queues[SCHEDULER_PRIORITIES];
+static SCHEDULER_Task_t Tasks[SCHEDULER_MAX_TASKS];
+static volatile uint8_t TaskCount = 0;
+static SCHEDULER_Stats_t SchedulerStats;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Adds to a counter that interrupts may also be adding to
+/// @param counter Counter to add to
+/// @param value Value to add
+static void SCHEDULER_AtomicAdd(volatile uint32_t *counter, uint32_t value);
+
+/// @brief Takes the oldest filled in event out of a queue (Main context only)
+/// @param queue Queue to take from
+/// @param event Filled with the event
+/// @return True if an event was taken, false if the queue is empty (Or its oldest event is still being filled in)
+static bool SCHEDULER_Pop(SCHEDULER_Queue_t *queue, SCHEDULER_Event_t *event);
+
+/// @brief Sleeps with WFI until the next interrupt, unless an event was posted since the queues were checked
+static void SCHEDULER_Sleep(void);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void SCHEDULER_Init(void){
+    SET_BIT(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);  // Enable the DWT block
+    SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);             // Start the cycle counter (Left running if ACDC_BENCH started it)
+
+    TaskCount = 0;
+    for(uint8_t p = 0; p < SCHEDULER_PRIORITIES; p++){
+        Queues[p].head = 0;
+        Queues[p].tail = 0;
+        for(uint32_t i = 0; i < SCHEDULER_QUEUE_SIZE; i++)
+            Queues[p].events[i].sequence = i;               // Every slot starts free for the first lap
+    }
+    SCHEDULER_ResetStats();
+}
+
+uint8_t SCHEDULER_AddTask(const char *name, SchedulerFunction function, uint8_t priority){
+    if(TaskCount >= SCHEDULER_MAX_TASKS || priority >= SCHEDULER_PRIORITIES || function == NULL)
+        return SCHEDULER_INVALID_TASK;
+
+    uint8_t task = TaskCount;
+    Tasks[task].function = function;
+    Tasks[task].stats = (SCHEDULER_TaskStats_t){0};
+    Tasks[task].stats.name = name;
+    Tasks[task].stats.priority = priority;
+    TaskCount = task + 1;                                   // Last, so a post can not see a half added task
+    return task;
+}
+
+bool SCHEDULER_Post(uint8_t task, uint32_t arg){
+    if(task >= TaskCount)
+        return false;
+
+    // Bounded multi producer queue: claim a position by moving head with LDREX/STREX, fill in the slot,
+    // then publish it by setting its sequence. An interrupt between LDREX and STREX makes the STREX fail and retry
+    SCHEDULER_TaskStats_t *stats = &Tasks[task].stats;
+    SCHEDULER_Queue_t *queue = &Queues[stats->priority];
+    SCHEDULER_Event_t *event;
+    uint32_t position;
+    while(1){
+        position = __LDREXW(&queue->head);
+        event = &queue->events[position & SCHEDULER_QUEUE_MASK];
+        int32_t lap = (int32_t)(event->sequence - position);
+        if(lap < 0){                                        // Slot still holds the event from one lap ago, the queue is full
+            __CLREX();
+            SCHEDULER_AtomicAdd(&stats->dropped, 1);
+            return false;
+        }
+        if(lap > 0){                                        // Another post claimed it after head was read
+            __CLREX();
+            continue;
+        }
+        if(__STREXW(position + 1, &queue->head) == 0)
+            break;
+    }
+
+    event->task = task;
+    event->arg = arg;
+    event->postCycles = DWT->CYCCNT;
+    __DMB();                                                // Event is filled in before it is published
+    event->sequence = position + 1;
+    SCHEDULER_AtomicAdd(&stats->posts, 1);
+    return true;
+}
+
+bool SCHEDULER_RunOne(void){
+    SCHEDULER_Event_t event;
+    for(uint8_t p = 0; p < SCHEDULER_PRIORITIES; p++){
+        if(!SCHEDULER_Pop(&Queues[p], &event))
+            continue;
+
+        SCHEDULER_Task_t *task = &Tasks[event.task];
+        uint32_t start = DWT->CYCCNT;
+        task->function(event.arg);
+        uint32_t cycles = DWT->CYCCNT - start;              // Unsigned subtraction handles the counter wrapping
+
+        uint32_t latency = start - event.postCycles;
+        SCHEDULER_TaskStats_t *stats = &task->stats;
+        stats->runs++;
+        stats->totalCycles += cycles;
+        if(cycles > stats->maxCycles)
+            stats->maxCycles = cycles;
+        if(latency > stats->maxLatencyCycles)
+            stats->maxLatencyCycles = latency;
+        SchedulerStats.busyCycles += cycles;
+        return true;
+    }
+    return false;
+}
+
+void SCHEDULER_Run(void){
+    while(1){
+        if(!SCHEDULER_RunOne())
+            SCHEDULER_Sleep();
+    }
+}
+
+bool SCHEDULER_GetTaskStats(uint8_t task, SCHEDULER_TaskStats_t *stats){
+    if(task >= TaskCount)
+        return false;
+    *stats = Tasks[task].stats;
+    return true;
+}
+
+void SCHEDULER_GetStats(SCHEDULER_Stats_t *stats){
+    *stats = SchedulerStats;
+}
+
+void SCHEDULER_ResetStats(void){
+    SchedulerStats = (SCHEDULER_Stats_t){0};
+    for(uint8_t i = 0; i < TaskCount; i++){
+        SCHEDULER_TaskStats_t *stats = &Tasks[i].stats;
+        stats->posts = 0;
+        stats->dropped = 0;
+        stats->runs = 0;
+        stats->maxCycles = 0;
+        stats->totalCycles = 0;
+        stats->maxLatencyCycles = 0;
+    }
+}
+
+void SCHEDULER_Report(USART_TypeDef *USARTx){
+    char line[SCHEDULER_LINE_SIZE];
+    StringBuilder sb = StringBuilderInit(line, sizeof(line));
+    for(uint8_t i = 0; i < TaskCount; i++){
+        const SCHEDULER_TaskStats_t *stats = &Tasks[i].stats;
+        uint64_t avgCycles = (stats->runs == 0) ? 0 : stats->totalCycles / stats->runs;
+
+        StringBuilderClear(&sb);
+        StringBuilderAppend(&sb, "TASK,");
+        StringBuilderAppend(&sb, stats->name);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats->priority);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats->posts);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats->dropped);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats->runs);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU64(&sb, avgCycles);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats->maxCycles);
+        StringBuilderAppendChar(&sb, ',');
+        StringBuilderAppendU32(&sb, stats->maxLatencyCycles);
+        StringBuilderAppend(&sb, "\r\n");
+        USART_SendBuffer(USARTx, sb.buffer, sb.length);
+    }
+
+    StringBuilderClear(&sb);
+    StringBuilderAppend(&sb, "SCHEDULER,");
+    StringBuilderAppendU64(&sb, SchedulerStats.busyCycles);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU64(&sb, SchedulerStats.idleCycles);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, SchedulerStats.sleeps);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, SchedulerStats.maxDepth);
+    StringBuilderAppend(&sb, "\r\n");
+    USART_SendBuffer(USARTx, sb.buffer, sb.length);
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static void SCHEDULER_AtomicAdd(volatile uint32_t *counter, uint32_t value){
+    uint32_t current;
+    do{
+        current = __LDREXW(counter);
+    }while(__STREXW(current + value, counter) != 0);
+}
+
+static bool SCHEDULER_Pop(SCHEDULER_Queue_t *queue, SCHEDULER_Event_t *event){
+    uint32_t tail = queue->tail;
+    SCHEDULER_Event_t *slot = &queue->events[tail & SCHEDULER_QUEUE_MASK];
+    if(slot->sequence != tail + 1)
+        return false;
+    __DMB();                                                // Sequence is read before the event
+
+    uint8_t depth = (uint8_t)(queue->head - tail);
+    if(depth > SchedulerStats.maxDepth)
+        SchedulerStats.maxDepth = depth;
+    event->task = slot->task;
+    event->arg = slot->arg;
+    event->postCycles = slot->postCycles;
+    __DMB();                                                // Event is copied before the slot is freed
+    slot->sequence = tail + SCHEDULER_QUEUE_SIZE;
+    queue->tail = tail + 1;
+    return true;
+}
+
+static void SCHEDULER_Sleep(void){
+    // With interrupts masked a post can not slip in between the check and WFI. WFI still wakes on a pending
+    // interrupt, which then runs as soon as they are unmasked
+    __disable_irq();
+    bool pending = false;
+    for(uint8_t p = 0; p < SCHEDULER_PRIORITIES; p++)
+        pending |= (Queues[p].head != Queues[p].tail);
+    if(!pending){
+        uint32_t start = DWT->CYCCNT;
+        __DSB();
+        __WFI();
+        SchedulerStats.idleCycles += DWT->CYCCNT - start;
+        SchedulerStats.sleeps++;
+    }
+    __enable_irq();
+}
+#pragma endregion
@@ -0,0 +1,168 @@
+/**
+ * @file ACDC_SPECTRUM.c
+ * @author Devin Marx
+ * @brief Implementation of the block FFT spectrum analyzer
+ * @version 0.1
+ * @date 2024-04-17
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_SPECTRUM.h"
+#include "ACDC_TELEMETRY.h"
+#include "arm_const_structs.h"
+
+#define SPECTRUM_BINS_HEADER_SIZE 10    // size (2), sampleRate (4), firstBin (2), count (2)
+#define SPECTRUM_BINS_PER_FRAME   ((TELEMETRY_MAX_PAYLOAD - SPECTRUM_BINS_HEADER_SIZE) / sizeof(q15_t))
+
+// Every pair of realCoefAQ15 / realCoefBQ15 a SPECTRUM_MAX_SIZE or smaller RFFT reads (ACDC_SPECTRUM_TABLES.c).
+// arm_rfft_init_q15 would link the full 8192 point tables and every CFFT up to 4096 points
+extern const q15_t SPECTRUM_RealCoefA[SPECTRUM_MAX_SIZE];
+extern const q15_t SPECTRUM_RealCoefB[SPECTRUM_MAX_SIZE];
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Gets the complex FFT an N point RFFT runs on (N / 2 points)
+/// @param size RFFT size
+/// @return CMSIS-DSP CFFT instance, or 0 if size is not supported
+static const arm_cfft_instance_q15* SPECTRUM_GetCfft(uint16_t size);
+
+/// @brief Windows the collected samples and turns them into magnitude bins
+/// @param spectrum Spectrum analyzer with a full window of samples
+static void SPECTRUM_Calculate(SPECTRUM_t *spectrum);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool SPECTRUM_Init(SPECTRUM_t *spectrum, uint16_t size, uint32_t sampleRate, q15_t *window, q15_t *input, q15_t *output){
+    const arm_cfft_instance_q15 *cfft = SPECTRUM_GetCfft(size);
+    if(cfft == 0)
+        return false;
+
+    // Same settings arm_rfft_init_q15 uses for a forward RFFT with normal order output, pointed at the smaller tables
+    spectrum->rfft.fftLenReal = size;
+    spectrum->rfft.ifftFlagR = 0;
+    spectrum->rfft.bitReverseFlagR = 1;
+    spectrum->rfft.twidCoefRModifier = SPECTRUM_MAX_SIZE / size;
+    spectrum->rfft.pTwiddleAReal = (q15_t*)SPECTRUM_RealCoefA;
+    spectrum->rfft.pTwiddleBReal = (q15_t*)SPECTRUM_RealCoefB;
+    spectrum->rfft.pCfft = cfft;
+
+    spectrum->size = size;
+    spectrum->count = 0;
+    spectrum->sampleRate = sampleRate;
+    spectrum->window = window;
+    spectrum->input = input;
+    spectrum->output = output;
+
+    // Hann window, 0.5 - 0.5 * cos(2 * pi * i / N). arm_cos_q15 maps 0 - 32767 to 0 - 2 * pi
+    for(uint16_t i = 0; i < size; i++)
+        window[i] = (q15_t)((32767 - arm_cos_q15((q15_t)(((uint32_t)i << 15) / size))) >> 1);
+    for(uint16_t i = 0; i < size / 2; i++)
+        output[i] = 0;                  // No spectrum yet
+    return true;
+}
+
+bool SPECTRUM_AddSamples(SPECTRUM_t *spectrum, const q15_t *samples, uint32_t count){
+    bool calculated = false;
+    while(count != 0){
+        uint32_t toCopy = spectrum->size - spectrum->count;
+        if(toCopy > count)
+            toCopy = count;
+        arm_copy_q15((q15_t*)samples, &spectrum->input[spectrum->count], toCopy);
+        spectrum->count += toCopy;
+        samples += toCopy;
+        count -= toCopy;
+
+        if(spectrum->count == spectrum->size){
+            SPECTRUM_Calculate(spectrum);
+            spectrum->count = 0;
+            calculated = true;
+        }
+    }
+    return calculated;
+}
+
+const q15_t* SPECTRUM_GetMagnitudes(const SPECTRUM_t *spectrum){
+    return spectrum->output;
+}
+
+uint8_t SPECTRUM_FindPeaks(const SPECTRUM_t *spectrum, SPECTRUM_Peak_t *peaks, uint8_t maxPeaks){
+    const q15_t *magnitudes = spectrum->output;
+    uint16_t bins = spectrum->size / 2;
+    uint8_t found = 0;
+    if(maxPeaks == 0)
+        return 0;
+
+    for(uint16_t bin = 1; bin + 1 < bins; bin++){
+        q15_t magnitude = magnitudes[bin];
+        if(magnitude <= magnitudes[bin - 1] || magnitude < magnitudes[bin + 1])
+            continue;                                   // Not a local maximum
+        if(found == maxPeaks && magnitude <= peaks[found - 1].magnitude)
+            continue;                                   // Smaller than every peak kept so far
+
+        // Insertion sort into the kept peaks (Largest first), the smallest falls off the end when full
+        uint8_t i = found < maxPeaks ? found++ : found - 1;
+        while(i > 0 && peaks[i - 1].magnitude < magnitude){
+            peaks[i] = peaks[i - 1];
+            i--;
+        }
+        peaks[i] = (SPECTRUM_Peak_t){bin, magnitude};
+    }
+    return found;
+}
+
+uint32_t SPECTRUM_BinToHz(const SPECTRUM_t *spectrum, uint16_t bin){
+    return (uint32_t)(((uint64_t)bin * spectrum->sampleRate) / spectrum->size);
+}
+
+bool SPECTRUM_SendBins(const SPECTRUM_t *spectrum){
+    bool sent = true;
+    uint16_t bins = spectrum->size / 2;
+    for(uint16_t firstBin = 0; firstBin < bins; firstBin += SPECTRUM_BINS_PER_FRAME){
+        uint16_t count = bins - firstBin;
+        if(count > SPECTRUM_BINS_PER_FRAME)
+            count = SPECTRUM_BINS_PER_FRAME;
+
+        TELEMETRY_Begin(TELEMETRY_SPECTRUM_BINS);
+        TELEMETRY_AddU16(spectrum->size);
+        TELEMETRY_AddU32(spectrum->sampleRate);
+        TELEMETRY_AddU16(firstBin);
+        TELEMETRY_AddU16(count);
+        TELEMETRY_AddBytes(&spectrum->output[firstBin], count * sizeof(q15_t));
+        sent &= TELEMETRY_End();
+    }
+    return sent;
+}
+
+bool SPECTRUM_SendPeaks(const SPECTRUM_t *spectrum, const SPECTRUM_Peak_t *peaks, uint8_t count){
+    TELEMETRY_Begin(TELEMETRY_SPECTRUM_PEAKS);
+    TELEMETRY_AddU16(spectrum->size);
+    TELEMETRY_AddU32(spectrum->sampleRate);
+    TELEMETRY_AddU8(count);
+    for(uint8_t i = 0; i < count; i++){
+        TELEMETRY_AddU16(peaks[i].bin);
+        TELEMETRY_AddU16((uint16_t)peaks[i].magnitude);
+    }
+    return TELEMETRY_End();
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static const arm_cfft_instance_q15* SPECTRUM_GetCfft(uint16_t size){
+    // Only the sizes listed here are linked (Saves the 1024 - 4096 point CFFT tables)
+    switch(size){
+        case 64:   return &arm_cfft_sR_q15_len32;
+        case 128:  return &arm_cfft_sR_q15_len64;
+        case 256:  return &arm_cfft_sR_q15_len128;
+        case 512:  return &arm_cfft_sR_q15_len256;
+        case 1024: return &arm_cfft_sR_q15_len512;
+        default:   return 0;
+    }
+}
+
+static void SPECTRUM_Calculate(SPECTRUM_t *spectrum){
+    uint16_t size = spectrum->size;
+    arm_mult_q15(spectrum->input, spectrum->window, spectrum->input, size);     // Apply the window in place
+    arm_rfft_q15(&spectrum->rfft, spectrum->input, spectrum->output);          // Input is used as scratch, output is N complex values
+    arm_cmplx_mag_q15(spectrum->output, spectrum->output, size / 2);           // In place, each bin reads 2 values and writes 1
+}
+#pragma endregion
@@ -0,0 +1,277 @@
+/**
+ * @file ACDC_SPECTRUM_TABLES.c
+ * @author Devin Marx
+ * @brief RFFT split tables for ACDC_SPECTRUM (GENERATED by Python_Helper/SPECTRUM_Helper.py, do not edit)
+ *
+ * Every 8th pair of the CMSIS-DSP realCoefAQ15 and realCoefBQ15 tables. They hold every value
+ * a 1024 point or smaller arm_rfft_q15 reads, in 4KB of flash instead of the 32KB the full tables take.
+ *
+ * @version 0.1
+ * @date 2024-04-17
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_SPECTRUM.h"
+
+const q15_t ALIGN4 SPECTRUM_RealCoefA[SPECTRUM_MAX_SIZE] = {
+    (q15_t)0x4000, (q15_t)0xc000, (q15_t)0x3f9b, (q15_t)0xc000, (q15_t)0x3f37, (q15_t)0xc001, (q15_t)0x3ed2, (q15_t)0xc003,
+    (q15_t)0x3e6e, (q15_t)0xc005, (q15_t)0x3e09, (q15_t)0xc008, (q15_t)0x3da5, (q15_t)0xc00b, (q15_t)0x3d40, (q15_t)0xc00f,
+    (q15_t)0x3cdc, (q15_t)0xc014, (q15_t)0x3c78, (q15_t)0xc019, (q15_t)0x3c13, (q15_t)0xc01f, (q15_t)0x3baf, (q15_t)0xc025,
+    (q15_t)0x3b4b, (q15_t)0xc02c, (q15_t)0x3ae6, (q15_t)0xc034, (q15_t)0x3a82, (q15_t)0xc03c, (q15_t)0x3a1e, (q15_t)0xc045,
+    (q15_t)0x39ba, (q15_t)0xc04f, (q15_t)0x3956, (q15_t)0xc059, (q15_t)0x38f2, (q15_t)0xc064, (q15_t)0x388e, (q15_t)0xc06f,
+    (q15_t)0x382a, (q15_t)0xc07b, (q15_t)0x37c7, (q15_t)0xc088, (q15_t)0x3763, (q15_t)0xc095, (q15_t)0x36ff, (q15_t)0xc0a3,
+    (q15_t)0x369c, (q15_t)0xc0b1, (q15_t)0x3639, (q15_t)0xc0c0, (q15_t)0x35d5, (q15_t)0xc0d0, (q15_t)0x3572, (q15_t)0xc0e0,
+    (q15_t)0x350f, (q15_t)0xc0f1, (q15_t)0x34ac, (q15_t)0xc103, (q15_t)0x3449, (q15_t)0xc115, (q15_t)0x33e6, (q15_t)0xc128,
+    (q15_t)0x3384, (q15_t)0xc13b, (q15_t)0x3321, (q15_t)0xc14f, (q15_t)0x32bf, (q15_t)0xc163, (q15_t)0x325c, (q15_t)0xc178,
+    (q15_t)0x31fa, (q15_t)0xc18e, (q15_t)0x3198, (q15_t)0xc1a4, (q15_t)0x3136, (q15_t)0xc1bb, (q15_t)0x30d5, (q15_t)0xc1d3,
+    (q15_t)0x3073, (q15_t)0xc1eb, (q15_t)0x3012, (q15_t)0xc204, (q15_t)0x2fb0, (q15_t)0xc21d, (q15_t)0x2f4f, (q15_t)0xc237,
+    (q15_t)0x2eee, (q15_t)0xc251, (q15_t)0x2e8d, (q15_t)0xc26d, (q15_t)0x2e2d, (q15_t)0xc288, (q15_t)0x2dcc, (q15_t)0xc2a5,
+    (q15_t)0x2d6c, (q15_t)0xc2c1, (q15_t)0x2d0c, (q15_t)0xc2df, (q15_t)0x2cac, (q15_t)0xc2fd, (q15_t)0x2c4c, (q15_t)0xc31c,
+    (q15_t)0x2bed, (q15_t)0xc33b, (q15_t)0x2b8d, (q15_t)0xc35b, (q15_t)0x2b2e, (q15_t)0xc37b, (q15_t)0x2acf, (q15_t)0xc39c,
+    (q15_t)0x2a70, (q15_t)0xc3be, (q15_t)0x2a12, (q15_t)0xc3e0, (q15_t)0x29b4, (q15_t)0xc403, (q15_t)0x2955, (q15_t)0xc426,
+    (q15_t)0x28f7, (q15_t)0xc44a, (q15_t)0x289a, (q15_t)0xc46e, (q15_t)0x283c, (q15_t)0xc493, (q15_t)0x27df, (q15_t)0xc4b9,
+    (q15_t)0x2782, (q15_t)0xc4df, (q15_t)0x2725, (q15_t)0xc506, (q15_t)0x26c9, (q15_t)0xc52d, (q15_t)0x266d, (q15_t)0xc555,
+    (q15_t)0x2611, (q15_t)0xc57e, (q15_t)0x25b5, (q15_t)0xc5a7, (q15_t)0x2559, (q15_t)0xc5d0, (q15_t)0x24fe, (q15_t)0xc5fa,
+    (q15_t)0x24a3, (q15_t)0xc625, (q15_t)0x2448, (q15_t)0xc650, (q15_t)0x23ee, (q15_t)0xc67c, (q15_t)0x2394, (q15_t)0xc6a8,
+    (q15_t)0x233a, (q15_t)0xc6d5, (q15_t)0x22e0, (q15_t)0xc703, (q15_t)0x2287, (q15_t)0xc731, (q15_t)0x222d, (q15_t)0xc75f,
+    (q15_t)0x21d5, (q15_t)0xc78f, (q15_t)0x217c, (q15_t)0xc7be, (q15_t)0x2124, (q15_t)0xc7ee, (q15_t)0x20cc, (q15_t)0xc81f,
+    (q15_t)0x2074, (q15_t)0xc850, (q15_t)0x201d, (q15_t)0xc882, (q15_t)0x1fc6, (q15_t)0xc8b5, (q15_t)0x1f6f, (q15_t)0xc8e8,
+    (q15_t)0x1f19, (q15_t)0xc91b, (q15_t)0x1ec3, (q15_t)0xc94f, (q15_t)0x1e6d, (q15_t)0xc983, (q15_t)0x1e18, (q15_t)0xc9b8,
+    (q15_t)0x1dc3, (q15_t)0xc9ee, (q15_t)0x1d6e, (q15_t)0xca24, (q15_t)0x1d19, (q15_t)0xca5b, (q15_t)0x1cc5, (q15_t)0xca92,
+    (q15_t)0x1c72, (q15_t)0xcac9, (q15_t)0x1c1e, (q15_t)0xcb01, (q15_t)0x1bcb, (q15_t)0xcb3a, (q15_t)0x1b78, (q15_t)0xcb73,
+    (q15_t)0x1b26, (q15_t)0xcbad, (q15_t)0x1ad4, (q15_t)0xcbe7, (q15_t)0x1a82, (q15_t)0xcc21, (q15_t)0x1a31, (q15_t)0xcc5d,
+    (q15_t)0x19e0, (q15_t)0xcc98, (q15_t)0x198f, (q15_t)0xccd4, (q15_t)0x193f, (q15_t)0xcd11, (q15_t)0x18ef, (q15_t)0xcd4e,
+    (q15_t)0x18a0, (q15_t)0xcd8c, (q15_t)0x1851, (q15_t)0xcdca, (q15_t)0x1802, (q15_t)0xce08, (q15_t)0x17b4, (q15_t)0xce47,
+    (q15_t)0x1766, (q15_t)0xce87, (q15_t)0x1719, (q15_t)0xcec7, (q15_t)0x16cb, (q15_t)0xcf07, (q15_t)0x167f, (q15_t)0xcf48,
+    (q15_t)0x1632, (q15_t)0xcf8a, (q15_t)0x15e6, (q15_t)0xcfcc, (q15_t)0x159b, (q15_t)0xd00e, (q15_t)0x1550, (q15_t)0xd051,
+    (q15_t)0x1505, (q15_t)0xd094, (q15_t)0x14bb, (q15_t)0xd0d8, (q15_t)0x1471, (q15_t)0xd11c, (q15_t)0x1428, (q15_t)0xd161,
+    (q15_t)0x13df, (q15_t)0xd1a6, (q15_t)0x1396, (q15_t)0xd1eb, (q15_t)0x134e, (q15_t)0xd231, (q15_t)0x1306, (q15_t)0xd278,
+    (q15_t)0x12bf, (q15_t)0xd2bf, (q15_t)0x1278, (q15_t)0xd306, (q15_t)0x1231, (q15_t)0xd34e, (q15_t)0x11eb, (q15_t)0xd396,
+    (q15_t)0x11a6, (q15_t)0xd3df, (q15_t)0x1161, (q15_t)0xd428, (q15_t)0x111c, (q15_t)0xd471, (q15_t)0x10d8, (q15_t)0xd4bb,
+    (q15_t)0x1094, (q15_t)0xd505, (q15_t)0x1051, (q15_t)0xd550, (q15_t)0x100e, (q15_t)0xd59b, (q15_t)0x0fcc, (q15_t)0xd5e6,
+    (q15_t)0x0f8a, (q15_t)0xd632, (q15_t)0x0f48, (q15_t)0xd67f, (q15_t)0x0f07, (q15_t)0xd6cb, (q15_t)0x0ec7, (q15_t)0xd719,
+    (q15_t)0x0e87, (q15_t)0xd766, (q15_t)0x0e47, (q15_t)0xd7b4, (q15_t)0x0e08, (q15_t)0xd802, (q15_t)0x0dca, (q15_t)0xd851,
+    (q15_t)0x0d8c, (q15_t)0xd8a0, (q15_t)0x0d4e, (q15_t)0xd8ef, (q15_t)0x0d11, (q15_t)0xd93f, (q15_t)0x0cd4, (q15_t)0xd98f,
+    (q15_t)0x0c98, (q15_t)0xd9e0, (q15_t)0x0c5d, (q15_t)0xda31, (q15_t)0x0c21, (q15_t)0xda82, (q15_t)0x0be7, (q15_t)0xdad4,
+    (q15_t)0x0bad, (q15_t)0xdb26, (q15_t)0x0b73, (q15_t)0xdb78, (q15_t)0x0b3a, (q15_t)0xdbcb, (q15_t)0x0b01, (q15_t)0xdc1e,
+    (q15_t)0x0ac9, (q15_t)0xdc72, (q15_t)0x0a92, (q15_t)0xdcc5, (q15_t)0x0a5b, (q15_t)0xdd19, (q15_t)0x0a24, (q15_t)0xdd6e,
+    (q15_t)0x09ee, (q15_t)0xddc3, (q15_t)0x09b8, (q15_t)0xde18, (q15_t)0x0983, (q15_t)0xde6d, (q15_t)0x094f, (q15_t)0xdec3,
+    (q15_t)0x091b, (q15_t)0xdf19, (q15_t)0x08e8, (q15_t)0xdf6f, (q15_t)0x08b5, (q15_t)0xdfc6, (q15_t)0x0882, (q15_t)0xe01d,
+    (q15_t)0x0850, (q15_t)0xe074, (q15_t)0x081f, (q15_t)0xe0cc, (q15_t)0x07ee, (q15_t)0xe124, (q15_t)0x07be, (q15_t)0xe17c,
+    (q15_t)0x078f, (q15_t)0xe1d5, (q15_t)0x075f, (q15_t)0xe22d, (q15_t)0x0731, (q15_t)0xe287, (q15_t)0x0703, (q15_t)0xe2e0,
+    (q15_t)0x06d5, (q15_t)0xe33a, (q15_t)0x06a8, (q15_t)0xe394, (q15_t)0x067c, (q15_t)0xe3ee, (q15_t)0x0650, (q15_t)0xe448,
+    (q15_t)0x0625, (q15_t)0xe4a3, (q15_t)0x05fa, (q15_t)0xe4fe, (q15_t)0x05d0, (q15_t)0xe559, (q15_t)0x05a7, (q15_t)0xe5b5,
+    (q15_t)0x057e, (q15_t)0xe611, (q15_t)0x0555, (q15_t)0xe66d, (q15_t)0x052d, (q15_t)0xe6c9, (q15_t)0x0506, (q15_t)0xe725,
+    (q15_t)0x04df, (q15_t)0xe782, (q15_t)0x04b9, (q15_t)0xe7df, (q15_t)0x0493, (q15_t)0xe83c, (q15_t)0x046e, (q15_t)0xe89a,
+    (q15_t)0x044a, (q15_t)0xe8f7, (q15_t)0x0426, (q15_t)0xe955, (q15_t)0x0403, (q15_t)0xe9b4, (q15_t)0x03e0, (q15_t)0xea12,
+    (q15_t)0x03be, (q15_t)0xea70, (q15_t)0x039c, (q15_t)0xeacf, (q15_t)0x037b, (q15_t)0xeb2e, (q15_t)0x035b, (q15_t)0xeb8d,
+    (q15_t)0x033b, (q15_t)0xebed, (q15_t)0x031c, (q15_t)0xec4c, (q15_t)0x02fd, (q15_t)0xecac, (q15_t)0x02df, (q15_t)0xed0c,
+    (q15_t)0x02c1, (q15_t)0xed6c, (q15_t)0x02a5, (q15_t)0xedcc, (q15_t)0x0288, (q15_t)0xee2d, (q15_t)0x026d, (q15_t)0xee8d,
+    (q15_t)0x0251, (q15_t)0xeeee, (q15_t)0x0237, (q15_t)0xef4f, (q15_t)0x021d, (q15_t)0xefb0, (q15_t)0x0204, (q15_t)0xf012,
+    (q15_t)0x01eb, (q15_t)0xf073, (q15_t)0x01d3, (q15_t)0xf0d5, (q15_t)0x01bb, (q15_t)0xf136, (q15_t)0x01a4, (q15_t)0xf198,
+    (q15_t)0x018e, (q15_t)0xf1fa, (q15_t)0x0178, (q15_t)0xf25c, (q15_t)0x0163, (q15_t)0xf2bf, (q15_t)0x014f, (q15_t)0xf321,
+    (q15_t)0x013b, (q15_t)0xf384, (q15_t)0x0128, (q15_t)0xf3e6, (q15_t)0x0115, (q15_t)0xf449, (q15_t)0x0103, (q15_t)0xf4ac,
+    (q15_t)0x00f1, (q15_t)0xf50f, (q15_t)0x00e0, (q15_t)0xf572, (q15_t)0x00d0, (q15_t)0xf5d5, (q15_t)0x00c0, (q15_t)0xf639,
+    (q15_t)0x00b1, (q15_t)0xf69c, (q15_t)0x00a3, (q15_t)0xf6ff, (q15_t)0x0095, (q15_t)0xf763, (q15_t)0x0088, (q15_t)0xf7c7,
+    (q15_t)0x007b, (q15_t)0xf82a, (q15_t)0x006f, (q15_t)0xf88e, (q15_t)0x0064, (q15_t)0xf8f2, (q15_t)0x0059, (q15_t)0xf956,
+    (q15_t)0x004f, (q15_t)0xf9ba, (q15_t)0x0045, (q15_t)0xfa1e, (q15_t)0x003c, (q15_t)0xfa82, (q15_t)0x0034, (q15_t)0xfae6,
+    (q15_t)0x002c, (q15_t)0xfb4b, (q15_t)0x0025, (q15_t)0xfbaf, (q15_t)0x001f, (q15_t)0xfc13, (q15_t)0x0019, (q15_t)0xfc78,
+    (q15_t)0x0014, (q15_t)0xfcdc, (q15_t)0x000f, (q15_t)0xfd40, (q15_t)0x000b, (q15_t)0xfda5, (q15_t)0x0008, (q15_t)0xfe09,
+    (q15_t)0x0005, (q15_t)0xfe6e, (q15_t)0x0003, (q15_t)0xfed2, (q15_t)0x0001, (q15_t)0xff37, (q15_t)0x0000, (q15_t)0xff9b,
+    (q15_t)0x0000, (q15_t)0x0000, (q15_t)0x0000, (q15_t)0x0065, (q15_t)0x0001, (q15_t)0x00c9, (q15_t)0x0003, (q15_t)0x012e,
+    (q15_t)0x0005, (q15_t)0x0192, (q15_t)0x0008, (q15_t)0x01f7, (q15_t)0x000b, (q15_t)0x025b, (q15_t)0x000f, (q15_t)0x02c0,
+    (q15_t)0x0014, (q15_t)0x0324, (q15_t)0x0019, (q15_t)0x0388, (q15_t)0x001f, (q15_t)0x03ed, (q15_t)0x0025, (q15_t)0x0451,
+    (q15_t)0x002c, (q15_t)0x04b5, (q15_t)0x0034, (q15_t)0x051a, (q15_t)0x003c, (q15_t)0x057e, (q15_t)0x0045, (q15_t)0x05e2,
+    (q15_t)0x004f, (q15_t)0x0646, (q15_t)0x0059, (q15_t)0x06aa, (q15_t)0x0064, (q15_t)0x070e, (q15_t)0x006f, (q15_t)0x0772,
+    (q15_t)0x007b, (q15_t)0x07d6, (q15_t)0x0088, (q15_t)0x0839, (q15_t)0x0095, (q15_t)0x089d, (q15_t)0x00a3, (q15_t)0x0901,
+    (q15_t)0x00b1, (q15_t)0x0964, (q15_t)0x00c0, (q15_t)0x09c7, (q15_t)0x00d0, (q15_t)0x0a2b, (q15_t)0x00e0, (q15_t)0x0a8e,
+    (q15_t)0x00f1, (q15_t)0x0af1, (q15_t)0x0103, (q15_t)0x0b54, (q15_t)0x0115, (q15_t)0x0bb7, (q15_t)0x0128, (q15_t)0x0c1a,
+    (q15_t)0x013b, (q15_t)0x0c7c, (q15_t)0x014f, (q15_t)0x0cdf, (q15_t)0x0163, (q15_t)0x0d41, (q15_t)0x0178, (q15_t)0x0da4,
+    (q15_t)0x018e, (q15_t)0x0e06, (q15_t)0x01a4, (q15_t)0x0e68, (q15_t)0x01bb, (q15_t)0x0eca, (q15_t)0x01d3, (q15_t)0x0f2b,
+    (q15_t)0x01eb, (q15_t)0x0f8d, (q15_t)0x0204, (q15_t)0x0fee, (q15_t)0x021d, (q15_t)0x1050, (q15_t)0x0237, (q15_t)0x10b1,
+    (q15_t)0x0251, (q15_t)0x1112, (q15_t)0x026d, (q15_t)0x1173, (q15_t)0x0288, (q15_t)0x11d3, (q15_t)0x02a5, (q15_t)0x1234,
+    (q15_t)0x02c1, (q15_t)0x1294, (q15_t)0x02df, (q15_t)0x12f4, (q15_t)0x02fd, (q15_t)0x1354, (q15_t)0x031c, (q15_t)0x13b4,
+    (q15_t)0x033b, (q15_t)0x1413, (q15_t)0x035b, (q15_t)0x1473, (q15_t)0x037b, (q15_t)0x14d2, (q15_t)0x039c, (q15_t)0x1531,
+    (q15_t)0x03be, (q15_t)0x1590, (q15_t)0x03e0, (q15_t)0x15ee, (q15_t)0x0403, (q15_t)0x164c, (q15_t)0x0426, (q15_t)0x16ab,
+    (q15_t)0x044a, (q15_t)0x1709, (q15_t)0x046e, (q15_t)0x1766, (q15_t)0x0493, (q15_t)0x17c4, (q15_t)0x04b9, (q15_t)0x1821,
+    (q15_t)0x04df, (q15_t)0x187e, (q15_t)0x0506, (q15_t)0x18db, (q15_t)0x052d, (q15_t)0x1937, (q15_t)0x0555, (q15_t)0x1993,
+    (q15_t)0x057e, (q15_t)0x19ef, (q15_t)0x05a7, (q15_t)0x1a4b, (q15_t)0x05d0, (q15_t)0x1aa7, (q15_t)0x05fa, (q15_t)0x1b02,
+    (q15_t)0x0625, (q15_t)0x1b5d, (q15_t)0x0650, (q15_t)0x1bb8, (q15_t)0x067c, (q15_t)0x1c12, (q15_t)0x06a8, (q15_t)0x1c6c,
+    (q15_t)0x06d5, (q15_t)0x1cc6, (q15_t)0x0703, (q15_t)0x1d20, (q15_t)0x0731, (q15_t)0x1d79, (q15_t)0x075f, (q15_t)0x1dd3,
+    (q15_t)0x078f, (q15_t)0x1e2b, (q15_t)0x07be, (q15_t)0x1e84, (q15_t)0x07ee, (q15_t)0x1edc, (q15_t)0x081f, (q15_t)0x1f34,
+    (q15_t)0x0850, (q15_t)0x1f8c, (q15_t)0x0882, (q15_t)0x1fe3, (q15_t)0x08b5, (q15_t)0x203a, (q15_t)0x08e8, (q15_t)0x2091,
+    (q15_t)0x091b, (q15_t)0x20e7, (q15_t)0x094f, (q15_t)0x213d, (q15_t)0x0983, (q15_t)0x2193, (q15_t)0x09b8, (q15_t)0x21e8,
+    (q15_t)0x09ee, (q15_t)0x223d, (q15_t)0x0a24, (q15_t)0x2292, (q15_t)0x0a5b, (q15_t)0x22e7, (q15_t)0x0a92, (q15_t)0x233b,
+    (q15_t)0x0ac9, (q15_t)0x238e, (q15_t)0x0b01, (q15_t)0x23e2, (q15_t)0x0b3a, (q15_t)0x2435, (q15_t)0x0b73, (q15_t)0x2488,
+    (q15_t)0x0bad, (q15_t)0x24da, (q15_t)0x0be7, (q15_t)0x252c, (q15_t)0x0c21, (q15_t)0x257e, (q15_t)0x0c5d, (q15_t)0x25cf,
+    (q15_t)0x0c98, (q15_t)0x2620, (q15_t)0x0cd4, (q15_t)0x2671, (q15_t)0x0d11, (q15_t)0x26c1, (q15_t)0x0d4e, (q15_t)0x2711,
+    (q15_t)0x0d8c, (q15_t)0x2760, (q15_t)0x0dca, (q15_t)0x27af, (q15_t)0x0e08, (q15_t)0x27fe, (q15_t)0x0e47, (q15_t)0x284c,
+    (q15_t)0x0e87, (q15_t)0x289a, (q15_t)0x0ec7, (q15_t)0x28e7, (q15_t)0x0f07, (q15_t)0x2935, (q15_t)0x0f48, (q15_t)0x2981,
+    (q15_t)0x0f8a, (q15_t)0x29ce, (q15_t)0x0fcc, (q15_t)0x2a1a, (q15_t)0x100e, (q15_t)0x2a65, (q15_t)0x1051, (q15_t)0x2ab0,
+    (q15_t)0x1094, (q15_t)0x2afb, (q15_t)0x10d8, (q15_t)0x2b45, (q15_t)0x111c, (q15_t)0x2b8f, (q15_t)0x1161, (q15_t)0x2bd8,
+    (q15_t)0x11a6, (q15_t)0x2c21, (q15_t)0x11eb, (q15_t)0x2c6a, (q15_t)0x1231, (q15_t)0x2cb2, (q15_t)0x1278, (q15_t)0x2cfa,
+    (q15_t)0x12bf, (q15_t)0x2d41, (q15_t)0x1306, (q15_t)0x2d88, (q15_t)0x134e, (q15_t)0x2dcf, (q15_t)0x1396, (q15_t)0x2e15,
+    (q15_t)0x13df, (q15_t)0x2e5a, (q15_t)0x1428, (q15_t)0x2e9f, (q15_t)0x1471, (q15_t)0x2ee4, (q15_t)0x14bb, (q15_t)0x2f28,
+    (q15_t)0x1505, (q15_t)0x2f6c, (q15_t)0x1550, (q15_t)0x2faf, (q15_t)0x159b, (q15_t)0x2ff2, (q15_t)0x15e6, (q15_t)0x3034,
+    (q15_t)0x1632, (q15_t)0x3076, (q15_t)0x167f, (q15_t)0x30b8, (q15_t)0x16cb, (q15_t)0x30f9, (q15_t)0x1719, (q15_t)0x3139,
+    (q15_t)0x1766, (q15_t)0x3179, (q15_t)0x17b4, (q15_t)0x31b9, (q15_t)0x1802, (q15_t)0x31f8, (q15_t)0x1851, (q15_t)0x3236,
+    (q15_t)0x18a0, (q15_t)0x3274, (q15_t)0x18ef, (q15_t)0x32b2, (q15_t)0x193f, (q15_t)0x32ef, (q15_t)0x198f, (q15_t)0x332c,
+    (q15_t)0x19e0, (q15_t)0x3368, (q15_t)0x1a31, (q15_t)0x33a3, (q15_t)0x1a82, (q15_t)0x33df, (q15_t)0x1ad4, (q15_t)0x3419,
+    (q15_t)0x1b26, (q15_t)0x3453, (q15_t)0x1b78, (q15_t)0x348d, (q15_t)0x1bcb, (q15_t)0x34c6, (q15_t)0x1c1e, (q15_t)0x34ff,
+    (q15_t)0x1c72, (q15_t)0x3537, (q15_t)0x1cc5, (q15_t)0x356e, (q15_t)0x1d19, (q15_t)0x35a5, (q15_t)0x1d6e, (q15_t)0x35dc,
+    (q15_t)0x1dc3, (q15_t)0x3612, (q15_t)0x1e18, (q15_t)0x3648, (q15_t)0x1e6d, (q15_t)0x367d, (q15_t)0x1ec3, (q15_t)0x36b1,
+    (q15_t)0x1f19, (q15_t)0x36e5, (q15_t)0x1f6f, (q15_t)0x3718, (q15_t)0x1fc6, (q15_t)0x374b, (q15_t)0x201d, (q15_t)0x377e,
+    (q15_t)0x2074, (q15_t)0x37b0, (q15_t)0x20cc, (q15_t)0x37e1, (q15_t)0x2124, (q15_t)0x3812, (q15_t)0x217c, (q15_t)0x3842,
+    (q15_t)0x21d5, (q15_t)0x3871, (q15_t)0x222d, (q15_t)0x38a1, (q15_t)0x2287, (q15_t)0x38cf, (q15_t)0x22e0, (q15_t)0x38fd,
+    (q15_t)0x233a, (q15_t)0x392b, (q15_t)0x2394, (q15_t)0x3958, (q15_t)0x23ee, (q15_t)0x3984, (q15_t)0x2448, (q15_t)0x39b0,
+    (q15_t)0x24a3, (q15_t)0x39db, (q15_t)0x24fe, (q15_t)0x3a06, (q15_t)0x2559, (q15_t)0x3a30, (q15_t)0x25b5, (q15_t)0x3a59,
+    (q15_t)0x2611, (q15_t)0x3a82, (q15_t)0x266d, (q15_t)0x3aab, (q15_t)0x26c9, (q15_t)0x3ad3, (q15_t)0x2725, (q15_t)0x3afa,
+    (q15_t)0x2782, (q15_t)0x3b21, (q15_t)0x27df, (q15_t)0x3b47, (q15_t)0x283c, (q15_t)0x3b6d, (q15_t)0x289a, (q15_t)0x3b92,
+    (q15_t)0x28f7, (q15_t)0x3bb6, (q15_t)0x2955, (q15_t)0x3bda, (q15_t)0x29b4, (q15_t)0x3bfd, (q15_t)0x2a12, (q15_t)0x3c20,
+    (q15_t)0x2a70, (q15_t)0x3c42, (q15_t)0x2acf, (q15_t)0x3c64, (q15_t)0x2b2e, (q15_t)0x3c85, (q15_t)0x2b8d, (q15_t)0x3ca5,
+    (q15_t)0x2bed, (q15_t)0x3cc5, (q15_t)0x2c4c, (q15_t)0x3ce4, (q15_t)0x2cac, (q15_t)0x3d03, (q15_t)0x2d0c, (q15_t)0x3d21,
+    (q15_t)0x2d6c, (q15_t)0x3d3f, (q15_t)0x2dcc, (q15_t)0x3d5b, (q15_t)0x2e2d, (q15_t)0x3d78, (q15_t)0x2e8d, (q15_t)0x3d93,
+    (q15_t)0x2eee, (q15_t)0x3daf, (q15_t)0x2f4f, (q15_t)0x3dc9, (q15_t)0x2fb0, (q15_t)0x3de3, (q15_t)0x3012, (q15_t)0x3dfc,
+    (q15_t)0x3073, (q15_t)0x3e15, (q15_t)0x30d5, (q15_t)0x3e2d, (q15_t)0x3136, (q15_t)0x3e45, (q15_t)0x3198, (q15_t)0x3e5c,
+    (q15_t)0x31fa, (q15_t)0x3e72, (q15_t)0x325c, (q15_t)0x3e88, (q15_t)0x32bf, (q15_t)0x3e9d, (q15_t)0x3321, (q15_t)0x3eb1,
+    (q15_t)0x3384, (q15_t)0x3ec5, (q15_t)0x33e6, (q15_t)0x3ed8, (q15_t)0x3449, (q15_t)0x3eeb, (q15_t)0x34ac, (q15_t)0x3efd,
+    (q15_t)0x350f, (q15_t)0x3f0f, (q15_t)0x3572, (q15_t)0x3f20, (q15_t)0x35d5, (q15_t)0x3f30, (q15_t)0x3639, (q15_t)0x3f40,
+    (q15_t)0x369c, (q15_t)0x3f4f, (q15_t)0x36ff, (q15_t)0x3f5d, (q15_t)0x3763, (q15_t)0x3f6b, (q15_t)0x37c7, (q15_t)0x3f78,
+    (q15_t)0x382a, (q15_t)0x3f85, (q15_t)0x388e, (q15_t)0x3f91, (q15_t)0x38f2, (q15_t)0x3f9c, (q15_t)0x3956, (q15_t)0x3fa7,
+    (q15_t)0x39ba, (q15_t)0x3fb1, (q15_t)0x3a1e, (q15_t)0x3fbb, (q15_t)0x3a82, (q15_t)0x3fc4, (q15_t)0x3ae6, (q15_t)0x3fcc,
+    (q15_t)0x3b4b, (q15_t)0x3fd4, (q15_t)0x3baf, (q15_t)0x3fdb, (q15_t)0x3c13, (q15_t)0x3fe1, (q15_t)0x3c78, (q15_t)0x3fe7,
+    (q15_t)0x3cdc, (q15_t)0x3fec, (q15_t)0x3d40, (q15_t)0x3ff1, (q15_t)0x3da5, (q15_t)0x3ff5, (q15_t)0x3e09, (q15_t)0x3ff8,
+    (q15_t)0x3e6e, (q15_t)0x3ffb, (q15_t)0x3ed2, (q15_t)0x3ffd, (q15_t)0x3f37, (q15_t)0x3fff, (q15_t)0x3f9b, (q15_t)0x4000,
+};
+
+const q15_t ALIGN4 SPECTRUM_RealCoefB[SPECTRUM_MAX_SIZE] = {
+    (q15_t)0x4000, (q15_t)0x4000, (q15_t)0x4065, (q15_t)0x4000, (q15_t)0x40c9, (q15_t)0x3fff, (q15_t)0x412e, (q15_t)0x3ffd,
+    (q15_t)0x4192, (q15_t)0x3ffb, (q15_t)0x41f7, (q15_t)0x3ff8, (q15_t)0x425b, (q15_t)0x3ff5, (q15_t)0x42c0, (q15_t)0x3ff1,
+    (q15_t)0x4324, (q15_t)0x3fec, (q15_t)0x4388, (q15_t)0x3fe7, (q15_t)0x43ed, (q15_t)0x3fe1, (q15_t)0x4451, (q15_t)0x3fdb,
+    (q15_t)0x44b5, (q15_t)0x3fd4, (q15_t)0x451a, (q15_t)0x3fcc, (q15_t)0x457e, (q15_t)0x3fc4, (q15_t)0x45e2, (q15_t)0x3fbb,
+    (q15_t)0x4646, (q15_t)0x3fb1, (q15_t)0x46aa, (q15_t)0x3fa7, (q15_t)0x470e, (q15_t)0x3f9c, (q15_t)0x4772, (q15_t)0x3f91,
+    (q15_t)0x47d6, (q15_t)0x3f85, (q15_t)0x4839, (q15_t)0x3f78, (q15_t)0x489d, (q15_t)0x3f6b, (q15_t)0x4901, (q15_t)0x3f5d,
+    (q15_t)0x4964, (q15_t)0x3f4f, (q15_t)0x49c7, (q15_t)0x3f40, (q15_t)0x4a2b, (q15_t)0x3f30, (q15_t)0x4a8e, (q15_t)0x3f20,
+    (q15_t)0x4af1, (q15_t)0x3f0f, (q15_t)0x4b54, (q15_t)0x3efd, (q15_t)0x4bb7, (q15_t)0x3eeb, (q15_t)0x4c1a, (q15_t)0x3ed8,
+    (q15_t)0x4c7c, (q15_t)0x3ec5, (q15_t)0x4cdf, (q15_t)0x3eb1, (q15_t)0x4d41, (q15_t)0x3e9d, (q15_t)0x4da4, (q15_t)0x3e88,
+    (q15_t)0x4e06, (q15_t)0x3e72, (q15_t)0x4e68, (q15_t)0x3e5c, (q15_t)0x4eca, (q15_t)0x3e45, (q15_t)0x4f2b, (q15_t)0x3e2d,
+    (q15_t)0x4f8d, (q15_t)0x3e15, (q15_t)0x4fee, (q15_t)0x3dfc, (q15_t)0x5050, (q15_t)0x3de3, (q15_t)0x50b1, (q15_t)0x3dc9,
+    (q15_t)0x5112, (q15_t)0x3daf, (q15_t)0x5173, (q15_t)0x3d93, (q15_t)0x51d3, (q15_t)0x3d78, (q15_t)0x5234, (q15_t)0x3d5b,
+    (q15_t)0x5294, (q15_t)0x3d3f, (q15_t)0x52f4, (q15_t)0x3d21, (q15_t)0x5354, (q15_t)0x3d03, (q15_t)0x53b4, (q15_t)0x3ce4,
+    (q15_t)0x5413, (q15_t)0x3cc5, (q15_t)0x5473, (q15_t)0x3ca5, (q15_t)0x54d2, (q15_t)0x3c85, (q15_t)0x5531, (q15_t)0x3c64,
+    (q15_t)0x5590, (q15_t)0x3c42, (q15_t)0x55ee, (q15_t)0x3c20, (q15_t)0x564c, (q15_t)0x3bfd, (q15_t)0x56ab, (q15_t)0x3bda,
+    (q15_t)0x5709, (q15_t)0x3bb6, (q15_t)0x5766, (q15_t)0x3b92, (q15_t)0x57c4, (q15_t)0x3b6d, (q15_t)0x5821, (q15_t)0x3b47,
+    (q15_t)0x587e, (q15_t)0x3b21, (q15_t)0x58db, (q15_t)0x3afa, (q15_t)0x5937, (q15_t)0x3ad3, (q15_t)0x5993, (q15_t)0x3aab,
+    (q15_t)0x59ef, (q15_t)0x3a82, (q15_t)0x5a4b, (q15_t)0x3a59, (q15_t)0x5aa7, (q15_t)0x3a30, (q15_t)0x5b02, (q15_t)0x3a06,
+    (q15_t)0x5b5d, (q15_t)0x39db, (q15_t)0x5bb8, (q15_t)0x39b0, (q15_t)0x5c12, (q15_t)0x3984, (q15_t)0x5c6c, (q15_t)0x3958,
+    (q15_t)0x5cc6, (q15_t)0x392b, (q15_t)0x5d20, (q15_t)0x38fd, (q15_t)0x5d79, (q15_t)0x38cf, (q15_t)0x5dd3, (q15_t)0x38a1,
+    (q15_t)0x5e2b, (q15_t)0x3871, (q15_t)0x5e84, (q15_t)0x3842, (q15_t)0x5edc, (q15_t)0x3812, (q15_t)0x5f34, (q15_t)0x37e1,
+    (q15_t)0x5f8c, (q15_t)0x37b0, (q15_t)0x5fe3, (q15_t)0x377e, (q15_t)0x603a, (q15_t)0x374b, (q15_t)0x6091, (q15_t)0x3718,
+    (q15_t)0x60e7, (q15_t)0x36e5, (q15_t)0x613d, (q15_t)0x36b1, (q15_t)0x6193, (q15_t)0x367d, (q15_t)0x61e8, (q15_t)0x3648,
+    (q15_t)0x623d, (q15_t)0x3612, (q15_t)0x6292, (q15_t)0x35dc, (q15_t)0x62e7, (q15_t)0x35a5, (q15_t)0x633b, (q15_t)0x356e,
+    (q15_t)0x638e, (q15_t)0x3537, (q15_t)0x63e2, (q15_t)0x34ff, (q15_t)0x6435, (q15_t)0x34c6, (q15_t)0x6488, (q15_t)0x348d,
+    (q15_t)0x64da, (q15_t)0x3453, (q15_t)0x652c, (q15_t)0x3419, (q15_t)0x657e, (q15_t)0x33df, (q15_t)0x65cf, (q15_t)0x33a3,
+    (q15_t)0x6620, (q15_t)0x3368, (q15_t)0x6671, (q15_t)0x332c, (q15_t)0x66c1, (q15_t)0x32ef, (q15_t)0x6711, (q15_t)0x32b2,
+    (q15_t)0x6760, (q15_t)0x3274, (q15_t)0x67af, (q15_t)0x3236, (q15_t)0x67fe, (q15_t)0x31f8, (q15_t)0x684c, (q15_t)0x31b9,
+    (q15_t)0x689a, (q15_t)0x3179, (q15_t)0x68e7, (q15_t)0x3139, (q15_t)0x6935, (q15_t)0x30f9, (q15_t)0x6981, (q15_t)0x30b8,
+    (q15_t)0x69ce, (q15_t)0x3076, (q15_t)0x6a1a, (q15_t)0x3034, (q15_t)0x6a65, (q15_t)0x2ff2, (q15_t)0x6ab0, (q15_t)0x2faf,
+    (q15_t)0x6afb, (q15_t)0x2f6c, (q15_t)0x6b45, (q15_t)0x2f28, (q15_t)0x6b8f, (q15_t)0x2ee4, (q15_t)0x6bd8, (q15_t)0x2e9f,
+    (q15_t)0x6c21, (q15_t)0x2e5a, (q15_t)0x6c6a, (q15_t)0x2e15, (q15_t)0x6cb2, (q15_t)0x2dcf, (q15_t)0x6cfa, (q15_t)0x2d88,
+    (q15_t)0x6d41, (q15_t)0x2d41, (q15_t)0x6d88, (q15_t)0x2cfa, (q15_t)0x6dcf, (q15_t)0x2cb2, (q15_t)0x6e15, (q15_t)0x2c6a,
+    (q15_t)0x6e5a, (q15_t)0x2c21, (q15_t)0x6e9f, (q15_t)0x2bd8, (q15_t)0x6ee4, (q15_t)0x2b8f, (q15_t)0x6f28, (q15_t)0x2b45,
+    (q15_t)0x6f6c, (q15_t)0x2afb, (q15_t)0x6faf, (q15_t)0x2ab0, (q15_t)0x6ff2, (q15_t)0x2a65, (q15_t)0x7034, (q15_t)0x2a1a,
+    (q15_t)0x7076, (q15_t)0x29ce, (q15_t)0x70b8, (q15_t)0x2981, (q15_t)0x70f9, (q15_t)0x2935, (q15_t)0x7139, (q15_t)0x28e7,
+    (q15_t)0x7179, (q15_t)0x289a, (q15_t)0x71b9, (q15_t)0x284c, (q15_t)0x71f8, (q15_t)0x27fe, (q15_t)0x7236, (q15_t)0x27af,
+    (q15_t)0x7274, (q15_t)0x2760, (q15_t)0x72b2, (q15_t)0x2711, (q15_t)0x72ef, (q15_t)0x26c1, (q15_t)0x732c, (q15_t)0x2671,
+    (q15_t)0x7368, (q15_t)0x2620, (q15_t)0x73a3, (q15_t)0x25cf, (q15_t)0x73df, (q15_t)0x257e, (q15_t)0x7419, (q15_t)0x252c,
+    (q15_t)0x7453, (q15_t)0x24da, (q15_t)0x748d, (q15_t)0x2488, (q15_t)0x74c6, (q15_t)0x2435, (q15_t)0x74ff, (q15_t)0x23e2,
+    (q15_t)0x7537, (q15_t)0x238e, (q15_t)0x756e, (q15_t)0x233b, (q15_t)0x75a5, (q15_t)0x22e7, (q15_t)0x75dc, (q15_t)0x2292,
+    (q15_t)0x7612, (q15_t)0x223d, (q15_t)0x7648, (q15_t)0x21e8, (q15_t)0x767d, (q15_t)0x2193, (q15_t)0x76b1, (q15_t)0x213d,
+    (q15_t)0x76e5, (q15_t)0x20e7, (q15_t)0x7718, (q15_t)0x2091, (q15_t)0x774b, (q15_t)0x203a, (q15_t)0x777e, (q15_t)0x1fe3,
+    (q15_t)0x77b0, (q15_t)0x1f8c, (q15_t)0x77e1, (q15_t)0x1f34, (q15_t)0x7812, (q15_t)0x1edc, (q15_t)0x7842, (q15_t)0x1e84,
+    (q15_t)0x7871, (q15_t)0x1e2b, (q15_t)0x78a1, (q15_t)0x1dd3, (q15_t)0x78cf, (q15_t)0x1d79, (q15_t)0x78fd, (q15_t)0x1d20,
+    (q15_t)0x792b, (q15_t)0x1cc6, (q15_t)0x7958, (q15_t)0x1c6c, (q15_t)0x7984, (q15_t)0x1c12, (q15_t)0x79b0, (q15_t)0x1bb8,
+    (q15_t)0x79db, (q15_t)0x1b5d, (q15_t)0x7a06, (q15_t)0x1b02, (q15_t)0x7a30, (q15_t)0x1aa7, (q15_t)0x7a59, (q15_t)0x1a4b,
+    (q15_t)0x7a82, (q15_t)0x19ef, (q15_t)0x7aab, (q15_t)0x1993, (q15_t)0x7ad3, (q15_t)0x1937, (q15_t)0x7afa, (q15_t)0x18db,
+    (q15_t)0x7b21, (q15_t)0x187e, (q15_t)0x7b47, (q15_t)0x1821, (q15_t)0x7b6d, (q15_t)0x17c4, (q15_t)0x7b92, (q15_t)0x1766,
+    (q15_t)0x7bb6, (q15_t)0x1709, (q15_t)0x7bda, (q15_t)0x16ab, (q15_t)0x7bfd, (q15_t)0x164c, (q15_t)0x7c20, (q15_t)0x15ee,
+    (q15_t)0x7c42, (q15_t)0x1590, (q15_t)0x7c64, (q15_t)0x1531, (q15_t)0x7c85, (q15_t)0x14d2, (q15_t)0x7ca5, (q15_t)0x1473,
+    (q15_t)0x7cc5, (q15_t)0x1413, (q15_t)0x7ce4, (q15_t)0x13b4, (q15_t)0x7d03, (q15_t)0x1354, (q15_t)0x7d21, (q15_t)0x12f4,
+    (q15_t)0x7d3f, (q15_t)0x1294, (q15_t)0x7d5b, (q15_t)0x1234, (q15_t)0x7d78, (q15_t)0x11d3, (q15_t)0x7d93, (q15_t)0x1173,
+    (q15_t)0x7daf, (q15_t)0x1112, (q15_t)0x7dc9, (q15_t)0x10b1, (q15_t)0x7de3, (q15_t)0x1050, (q15_t)0x7dfc, (q15_t)0x0fee,
+    (q15_t)0x7e15, (q15_t)0x0f8d, (q15_t)0x7e2d, (q15_t)0x0f2b, (q15_t)0x7e45, (q15_t)0x0eca, (q15_t)0x7e5c, (q15_t)0x0e68,
+    (q15_t)0x7e72, (q15_t)0x0e06, (q15_t)0x7e88, (q15_t)0x0da4, (q15_t)0x7e9d, (q15_t)0x0d41, (q15_t)0x7eb1, (q15_t)0x0cdf,
+    (q15_t)0x7ec5, (q15_t)0x0c7c, (q15_t)0x7ed8, (q15_t)0x0c1a, (q15_t)0x7eeb, (q15_t)0x0bb7, (q15_t)0x7efd, (q15_t)0x0b54,
+    (q15_t)0x7f0f, (q15_t)0x0af1, (q15_t)0x7f20, (q15_t)0x0a8e, (q15_t)0x7f30, (q15_t)0x0a2b, (q15_t)0x7f40, (q15_t)0x09c7,
+    (q15_t)0x7f4f, (q15_t)0x0964, (q15_t)0x7f5d, (q15_t)0x0901, (q15_t)0x7f6b, (q15_t)0x089d, (q15_t)0x7f78, (q15_t)0x0839,
+    (q15_t)0x7f85, (q15_t)0x07d6, (q15_t)0x7f91, (q15_t)0x0772, (q15_t)0x7f9c, (q15_t)0x070e, (q15_t)0x7fa7, (q15_t)0x06aa,
+    (q15_t)0x7fb1, (q15_t)0x0646, (q15_t)0x7fbb, (q15_t)0x05e2, (q15_t)0x7fc4, (q15_t)0x057e, (q15_t)0x7fcc, (q15_t)0x051a,
+    (q15_t)0x7fd4, (q15_t)0x04b5, (q15_t)0x7fdb, (q15_t)0x0451, (q15_t)0x7fe1, (q15_t)0x03ed, (q15_t)0x7fe7, (q15_t)0x0388,
+    (q15_t)0x7fec, (q15_t)0x0324, (q15_t)0x7ff1, (q15_t)0x02c0, (q15_t)0x7ff5, (q15_t)0x025b, (q15_t)0x7ff8, (q15_t)0x01f7,
+    (q15_t)0x7ffb, (q15_t)0x0192, (q15_t)0x7ffd, (q15_t)0x012e, (q15_t)0x7fff, (q15_t)0x00c9, (q15_t)0x7fff, (q15_t)0x0065,
+    (q15_t)0x7fff, (q15_t)0x0000, (q15_t)0x7fff, (q15_t)0xff9b, (q15_t)0x7fff, (q15_t)0xff37, (q15_t)0x7ffd, (q15_t)0xfed2,
+    (q15_t)0x7ffb, (q15_t)0xfe6e, (q15_t)0x7ff8, (q15_t)0xfe09, (q15_t)0x7ff5, (q15_t)0xfda5, (q15_t)0x7ff1, (q15_t)0xfd40,
+    (q15_t)0x7fec, (q15_t)0xfcdc, (q15_t)0x7fe7, (q15_t)0xfc78, (q15_t)0x7fe1, (q15_t)0xfc13, (q15_t)0x7fdb, (q15_t)0xfbaf,
+    (q15_t)0x7fd4, (q15_t)0xfb4b, (q15_t)0x7fcc, (q15_t)0xfae6, (q15_t)0x7fc4, (q15_t)0xfa82, (q15_t)0x7fbb, (q15_t)0xfa1e,
+    (q15_t)0x7fb1, (q15_t)0xf9ba, (q15_t)0x7fa7, (q15_t)0xf956, (q15_t)0x7f9c, (q15_t)0xf8f2, (q15_t)0x7f91, (q15_t)0xf88e,
+    (q15_t)0x7f85, (q15_t)0xf82a, (q15_t)0x7f78, (q15_t)0xf7c7, (q15_t)0x7f6b, (q15_t)0xf763, (q15_t)0x7f5d, (q15_t)0xf6ff,
+    (q15_t)0x7f4f, (q15_t)0xf69c, (q15_t)0x7f40, (q15_t)0xf639, (q15_t)0x7f30, (q15_t)0xf5d5, (q15_t)0x7f20, (q15_t)0xf572,
+    (q15_t)0x7f0f, (q15_t)0xf50f, (q15_t)0x7efd, (q15_t)0xf4ac, (q15_t)0x7eeb, (q15_t)0xf449, (q15_t)0x7ed8, (q15_t)0xf3e6,
+    (q15_t)0x7ec5, (q15_t)0xf384, (q15_t)0x7eb1, (q15_t)0xf321, (q15_t)0x7e9d, (q15_t)0xf2bf, (q15_t)0x7e88, (q15_t)0xf25c,
+    (q15_t)0x7e72, (q15_t)0xf1fa, (q15_t)0x7e5c, (q15_t)0xf198, (q15_t)0x7e45, (q15_t)0xf136, (q15_t)0x7e2d, (q15_t)0xf0d5,
+    (q15_t)0x7e15, (q15_t)0xf073, (q15_t)0x7dfc, (q15_t)0xf012, (q15_t)0x7de3, (q15_t)0xefb0, (q15_t)0x7dc9, (q15_t)0xef4f,
+    (q15_t)0x7daf, (q15_t)0xeeee, (q15_t)0x7d93, (q15_t)0xee8d, (q15_t)0x7d78, (q15_t)0xee2d, (q15_t)0x7d5b, (q15_t)0xedcc,
+    (q15_t)0x7d3f, (q15_t)0xed6c, (q15_t)0x7d21, (q15_t)0xed0c, (q15_t)0x7d03, (q15_t)0xecac, (q15_t)0x7ce4, (q15_t)0xec4c,
+    (q15_t)0x7cc5, (q15_t)0xebed, (q15_t)0x7ca5, (q15_t)0xeb8d, (q15_t)0x7c85, (q15_t)0xeb2e, (q15_t)0x7c64, (q15_t)0xeacf,
+    (q15_t)0x7c42, (q15_t)0xea70, (q15_t)0x7c20, (q15_t)0xea12, (q15_t)0x7bfd, (q15_t)0xe9b4, (q15_t)0x7bda, (q15_t)0xe955,
+    (q15_t)0x7bb6, (q15_t)0xe8f7, (q15_t)0x7b92, (q15_t)0xe89a, (q15_t)0x7b6d, (q15_t)0xe83c, (q15_t)0x7b47, (q15_t)0xe7df,
+    (q15_t)0x7b21, (q15_t)0xe782, (q15_t)0x7afa, (q15_t)0xe725, (q15_t)0x7ad3, (q15_t)0xe6c9, (q15_t)0x7aab, (q15_t)0xe66d,
+    (q15_t)0x7a82, (q15_t)0xe611, (q15_t)0x7a59, (q15_t)0xe5b5, (q15_t)0x7a30, (q15_t)0xe559, (q15_t)0x7a06, (q15_t)0xe4fe,
+    (q15_t)0x79db, (q15_t)0xe4a3, (q15_t)0x79b0, (q15_t)0xe448, (q15_t)0x7984, (q15_t)0xe3ee, (q15_t)0x7958, (q15_t)0xe394,
+    (q15_t)0x792b, (q15_t)0xe33a, (q15_t)0x78fd, (q15_t)0xe2e0, (q15_t)0x78cf, (q15_t)0xe287, (q15_t)0x78a1, (q15_t)0xe22d,
+    (q15_t)0x7871, (q15_t)0xe1d5, (q15_t)0x7842, (q15_t)0xe17c, (q15_t)0x7812, (q15_t)0xe124, (q15_t)0x77e1, (q15_t)0xe0cc,
+    (q15_t)0x77b0, (q15_t)0xe074, (q15_t)0x777e, (q15_t)0xe01d, (q15_t)0x774b, (q15_t)0xdfc6, (q15_t)0x7718, (q15_t)0xdf6f,
+    (q15_t)0x76e5, (q15_t)0xdf19, (q15_t)0x76b1, (q15_t)0xdec3, (q15_t)0x767d, (q15_t)0xde6d, (q15_t)0x7648, (q15_t)0xde18,
+    (q15_t)0x7612, (q15_t)0xddc3, (q15_t)0x75dc, (q15_t)0xdd6e, (q15_t)0x75a5, (q15_t)0xdd19, (q15_t)0x756e, (q15_t)0xdcc5,
+    (q15_t)0x7537, (q15_t)0xdc72, (q15_t)0x74ff, (q15_t)0xdc1e, (q15_t)0x74c6, (q15_t)0xdbcb, (q15_t)0x748d, (q15_t)0xdb78,
+    (q15_t)0x7453, (q15_t)0xdb26, (q15_t)0x7419, (q15_t)0xdad4, (q15_t)0x73df, (q15_t)0xda82, (q15_t)0x73a3, (q15_t)0xda31,
+    (q15_t)0x7368, (q15_t)0xd9e0, (q15_t)0x732c, (q15_t)0xd98f, (q15_t)0x72ef, (q15_t)0xd93f, (q15_t)0x72b2, (q15_t)0xd8ef,
+    (q15_t)0x7274, (q15_t)0xd8a0, (q15_t)0x7236, (q15_t)0xd851, (q15_t)0x71f8, (q15_t)0xd802, (q15_t)0x71b9, (q15_t)0xd7b4,
+    (q15_t)0x7179, (q15_t)0xd766, (q15_t)0x7139, (q15_t)0xd719, (q15_t)0x70f9, (q15_t)0xd6cb, (q15_t)0x70b8, (q15_t)0xd67f,
+    (q15_t)0x7076, (q15_t)0xd632, (q15_t)0x7034, (q15_t)0xd5e6, (q15_t)0x6ff2, (q15_t)0xd59b, (q15_t)0x6faf, (q15_t)0xd550,
+    (q15_t)0x6f6c, (q15_t)0xd505, (q15_t)0x6f28, (q15_t)0xd4bb, (q15_t)0x6ee4, (q15_t)0xd471, (q15_t)0x6e9f, (q15_t)0xd428,
+    (q15_t)0x6e5a, (q15_t)0xd3df, (q15_t)0x6e15, (q15_t)0xd396, (q15_t)0x6dcf, (q15_t)0xd34e, (q15_t)0x6d88, (q15_t)0xd306,
+    (q15_t)0x6d41, (q15_t)0xd2bf, (q15_t)0x6cfa, (q15_t)0xd278, (q15_t)0x6cb2, (q15_t)0xd231, (q15_t)0x6c6a, (q15_t)0xd1eb,
+    (q15_t)0x6c21, (q15_t)0xd1a6, (q15_t)0x6bd8, (q15_t)0xd161, (q15_t)0x6b8f, (q15_t)0xd11c, (q15_t)0x6b45, (q15_t)0xd0d8,
+    (q15_t)0x6afb, (q15_t)0xd094, (q15_t)0x6ab0, (q15_t)0xd051, (q15_t)0x6a65, (q15_t)0xd00e, (q15_t)0x6a1a, (q15_t)0xcfcc,
+    (q15_t)0x69ce, (q15_t)0xcf8a, (q15_t)0x6981, (q15_t)0xcf48, (q15_t)0x6935, (q15_t)0xcf07, (q15_t)0x68e7, (q15_t)0xcec7,
+    (q15_t)0x689a, (q15_t)0xce87, (q15_t)0x684c, (q15_t)0xce47, (q15_t)0x67fe, (q15_t)0xce08, (q15_t)0x67af, (q15_t)0xcdca,
+    (q15_t)0x6760, (q15_t)0xcd8c, (q15_t)0x6711, (q15_t)0xcd4e, (q15_t)0x66c1, (q15_t)0xcd11, (q15_t)0x6671, (q15_t)0xccd4,
+    (q15_t)0x6620, (q15_t)0xcc98, (q15_t)0x65cf, (q15_t)0xcc5d, (q15_t)0x657e, (q15_t)0xcc21, (q15_t)0x652c, (q15_t)0xcbe7,
+    (q15_t)0x64da, (q15_t)0xcbad, (q15_t)0x6488, (q15_t)0xcb73, (q15_t)0x6435, (q15_t)0xcb3a, (q15_t)0x63e2, (q15_t)0xcb01,
+    (q15_t)0x638e, (q15_t)0xcac9, (q15_t)0x633b, (q15_t)0xca92, (q15_t)0x62e7, (q15_t)0xca5b, (q15_t)0x6292, (q15_t)0xca24,
+    (q15_t)0x623d, (q15_t)0xc9ee, (q15_t)0x61e8, (q15_t)0xc9b8, (q15_t)0x6193, (q15_t)0xc983, (q15_t)0x613d, (q15_t)0xc94f,
+    (q15_t)0x60e7, (q15_t)0xc91b, (q15_t)0x6091, (q15_t)0xc8e8, (q15_t)0x603a, (q15_t)0xc8b5, (q15_t)0x5fe3, (q15_t)0xc882,
+    (q15_t)0x5f8c, (q15_t)0xc850, (q15_t)0x5f34, (q15_t)0xc81f, (q15_t)0x5edc, (q15_t)0xc7ee, (q15_t)0x5e84, (q15_t)0xc7be,
+    (q15_t)0x5e2b, (q15_t)0xc78f, (q15_t)0x5dd3, (q15_t)0xc75f, (q15_t)0x5d79, (q15_t)0xc731, (q15_t)0x5d20, (q15_t)0xc703,
+    (q15_t)0x5cc6, (q15_t)0xc6d5, (q15_t)0x5c6c, (q15_t)0xc6a8, (q15_t)0x5c12, (q15_t)0xc67c, (q15_t)0x5bb8, (q15_t)0xc650,
+    (q15_t)0x5b5d, (q15_t)0xc625, (q15_t)0x5b02, (q15_t)0xc5fa, (q15_t)0x5aa7, (q15_t)0xc5d0, (q15_t)0x5a4b, (q15_t)0xc5a7,
+    (q15_t)0x59ef, (q15_t)0xc57e, (q15_t)0x5993, (q15_t)0xc555, (q15_t)0x5937, (q15_t)0xc52d, (q15_t)0x58db, (q15_t)0xc506,
+    (q15_t)0x587e, (q15_t)0xc4df, (q15_t)0x5821, (q15_t)0xc4b9, (q15_t)0x57c4, (q15_t)0xc493, (q15_t)0x5766, (q15_t)0xc46e,
+    (q15_t)0x5709, (q15_t)0xc44a, (q15_t)0x56ab, (q15_t)0xc426, (q15_t)0x564c, (q15_t)0xc403, (q15_t)0x55ee, (q15_t)0xc3e0,
+    (q15_t)0x5590, (q15_t)0xc3be, (q15_t)0x5531, (q15_t)0xc39c, (q15_t)0x54d2, (q15_t)0xc37b, (q15_t)0x5473, (q15_t)0xc35b,
+    (q15_t)0x5413, (q15_t)0xc33b, (q15_t)0x53b4, (q15_t)0xc31c, (q15_t)0x5354, (q15_t)0xc2fd, (q15_t)0x52f4, (q15_t)0xc2df,
+    (q15_t)0x5294, (q15_t)0xc2c1, (q15_t)0x5234, (q15_t)0xc2a5, (q15_t)0x51d3, (q15_t)0xc288, (q15_t)0x5173, (q15_t)0xc26d,
+    (q15_t)0x5112, (q15_t)0xc251, (q15_t)0x50b1, (q15_t)0xc237, (q15_t)0x5050, (q15_t)0xc21d, (q15_t)0x4fee, (q15_t)0xc204,
+    (q15_t)0x4f8d, (q15_t)0xc1eb, (q15_t)0x4f2b, (q15_t)0xc1d3, (q15_t)0x4eca, (q15_t)0xc1bb, (q15_t)0x4e68, (q15_t)0xc1a4,
+    (q15_t)0x4e06, (q15_t)0xc18e, (q15_t)0x4da4, (q15_t)0xc178, (q15_t)0x4d41, (q15_t)0xc163, (q15_t)0x4cdf, (q15_t)0xc14f,
+    (q15_t)0x4c7c, (q15_t)0xc13b, (q15_t)0x4c1a, (q15_t)0xc128, (q15_t)0x4bb7, (q15_t)0xc115, (q15_t)0x4b54, (q15_t)0xc103,
+    (q15_t)0x4af1, (q15_t)0xc0f1, (q15_t)0x4a8e, (q15_t)0xc0e0, (q15_t)0x4a2b, (q15_t)0xc0d0, (q15_t)0x49c7, (q15_t)0xc0c0,
+    (q15_t)0x4964, (q15_t)0xc0b1, (q15_t)0x4901, (q15_t)0xc0a3, (q15_t)0x489d, (q15_t)0xc095, (q15_t)0x4839, (q15_t)0xc088,
+    (q15_t)0x47d6, (q15_t)0xc07b, (q15_t)0x4772, (q15_t)0xc06f, (q15_t)0x470e, (q15_t)0xc064, (q15_t)0x46aa, (q15_t)0xc059,
+    (q15_t)0x4646, (q15_t)0xc04f, (q15_t)0x45e2, (q15_t)0xc045, (q15_t)0x457e, (q15_t)0xc03c, (q15_t)0x451a, (q15_t)0xc034,
+    (q15_t)0x44b5, (q15_t)0xc02c, (q15_t)0x4451, (q15_t)0xc025, (q15_t)0x43ed, (q15_t)0xc01f, (q15_t)0x4388, (q15_t)0xc019,
+    (q15_t)0x4324, (q15_t)0xc014, (q15_t)0x42c0, (q15_t)0xc00f, (q15_t)0x425b, (q15_t)0xc00b, (q15_t)0x41f7, (q15_t)0xc008,
+    (q15_t)0x4192, (q15_t)0xc005, (q15_t)0x412e, (q15_t)0xc003, (q15_t)0x40c9, (q15_t)0xc001, (q15_t)0x4065, (q15_t)0xc000,
+};
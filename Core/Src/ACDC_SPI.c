@@ -14,6 +14,20 @@
 #include "ACDC_SPI.h"
 #include "ACDC_GPIO.h"
 #include "ACDC_CLOCK.h"
+#include "ACDC_INTERRUPT.h"
+#include "ACDC_ATTRIBUTES.h"
+#include "ACDC_WATCHDOG.h"
+#ifdef ACDC_THREAD_SAFE
+#include "ACDC_RTOS.h"
+#endif
+
+#define SPI_TIMEOUT_US 2000   // Longest a status flag may take (A 16-bit frame at APB / 256 with an 8MHz clock is 512us)
+
+static SPI_Callback SPI_RxCallbacks[2];    // SPI1, SPI2
+#ifdef ACDC_THREAD_SAFE
+static RTOS_Mutex_t SPI_Locks[2] = {RTOS_MUTEX_INIT, RTOS_MUTEX_INIT};   // SPI1, SPI2
+static volatile bool SPI_BackgroundBusy[2];                                 // SPI1, SPI2 (Taken by SPI_TryLockBackground)
+#endif
 
 #pragma region PRIVATE_FUNCTION_PROTOTYPES
 /// @brief Enables the SPIx peripheral clock (Needed for peripheral to function)
@@ -24,6 +38,19 @@ static void SPI_InitClk(const SPI_TypeDef *SPIx);
 /// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
 /// @param isMaster true if SPIx should act as the master, false if it should act as a slave
 static void SPI_InitPin(const SPI_TypeDef *SPIx, bool isMaster);
+
+/// @brief Hands the received frame to the SPIx receive callback
+/// @param SPIx SPI Peripheral that caused the interrupt
+/// @param callback Function to call with the received frame
+ACDC_RAMFUNC static void SPI_RxInterruptHandler(SPI_TypeDef *SPIx, SPI_Callback callback);
+
+/// @brief Waits until a status flag of SPIx is set or cleared. A master gives up after SPI_TIMEOUT_US (Counted by ACDC_WATCHDOG)
+/// @param SPIx SPI Peripheral (Ex. SPI1 or SPI2)
+/// @param flag SR flag to wait on (Ex. SPI_SR_TXE)
+/// @param set True to wait until the flag is set, false until it is cleared
+/// @param site Name of the wait for the watchdog report
+/// @return False if the wait timed out
+static bool SPI_WaitFlag(const SPI_TypeDef *SPIx, uint32_t flag, bool set, const char *site);
 #pragma endregion
 
 void SPI_InitCS(SPI_TypeDef *SPIx, bool isMaster, GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN){
@@ -61,27 +88,30 @@ void SPI_EnableRemap(const SPI_TypeDef *SPIx, bool enable){
 
 void SPI_Transmit(SPI_TypeDef *SPIx, uint16_t data) {
     // Wait until transmit buffer is empty
-    while (!(SPIx->SR & SPI_SR_TXE));
+    if(!SPI_WaitFlag(SPIx, SPI_SR_TXE, true, "SPI TXE"))
+        return;                                 // The peripheral is stuck (Clock off?), drop the frame instead of hanging
 
     // Send data
-    SPIx->DR = data;
+    WRITE_REG(SPIx->DR, data);
 
-    while(!READ_BIT(SPIx->SR, SPI_SR_TXE)){}    // Wait to return until the transmission has completed (Needed for CS pin)
+    SPI_WaitFlag(SPIx, SPI_SR_TXE, true, "SPI TXE");   // Wait to return until the transmission has completed (Needed for CS pin)
 }
 
 void SPI_TransmitCS(SPI_TypeDef *SPIx, uint16_t data, GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN){
+    SPI_Lock(SPIx);
     GPIO_Clear(GPIOx, GPIO_PIN);
     SPI_Transmit(SPIx, data);
-    while(READ_BIT(SPIx->SR, SPI_SR_BSY));
+    SPI_WaitUntilIdle(SPIx);
     GPIO_Set(GPIOx, GPIO_PIN);
+    SPI_Unlock(SPIx);
 }
 
 uint16_t SPI_Receive(const SPI_TypeDef *SPIx) {
     // Wait until receive buffer is full
-    while (!(SPIx->SR & SPI_SR_RXNE));
+    SPI_WaitFlag(SPIx, SPI_SR_RXNE, true, "SPI RXNE");
 
     // Return received data
-    return SPIx->DR;
+    return READ_REG(SPIx->DR);                  // Reading DR clears RXNE
 }
 
 uint16_t SPI_TransmitReceive(SPI_TypeDef *SPIx, uint16_t data) {
@@ -90,15 +120,17 @@ uint16_t SPI_TransmitReceive(SPI_TypeDef *SPIx, uint16_t data) {
 }
 
 uint16_t SPI_TransmitReceiveCS(SPI_TypeDef *SPIx, uint16_t data, GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN){
+    SPI_Lock(SPIx);                                             // Another thread's CS can not go low mid transfer
     GPIO_Clear(GPIOx, GPIO_PIN);                                // Set CS Low
     uint16_t returnedData = SPI_TransmitReceive(SPIx, data);    // Transmit and Recieve the data
-    while(READ_BIT(SPIx->SR, SPI_SR_BSY)){}                     // Wait until the data has finished sending
+    SPI_WaitUntilIdle(SPIx);                                    // Wait until the data has finished sending
     GPIO_Set(GPIOx, GPIO_PIN);                                  // Set CS High
+    SPI_Unlock(SPIx);
     return returnedData;                                        // Return the SPI data
 }
 
 void SPI_SetBaudDivider(SPI_TypeDef *SPIx, SPI_BaudDivider SPI_BAUD_DIV_x){
-    while(READ_BIT(SPIx->SR, SPI_SR_BSY)){}                 // While SPIx is busy in communication or Tx buffer is not empty
+    SPI_WaitUntilIdle(SPIx);                                // While SPIx is busy in communication or Tx buffer is not empty
     CLEAR_BIT(SPIx->CR1, SPI_CR1_BR_Msk);                   // Clear the SPIx Baud Divisor bits
     SET_BIT(SPIx->CR1, SPI_BAUD_DIV_x << SPI_CR1_BR_Pos);   // Set the SPIx Baud Divisor bits
 }
@@ -145,7 +177,7 @@ void SPI_SetBitMode(SPI_TypeDef *SPIx, SPI_BitMode SPI_MODE_x){
 
 void SPI_SetLsbFirst(SPI_TypeDef *SPIx, bool LsbFirst){
     //Note: This bit should not be changed when communication is ongoing {See RM-743}
-    while(READ_BIT(SPIx->SR, SPI_SR_BSY)){}     // While SPIx is busy in communication or Tx buffer is not empty
+    SPI_WaitUntilIdle(SPIx);                    // While SPIx is busy in communication or Tx buffer is not empty
     if(LsbFirst)
         SET_BIT(SPIx->CR1  , SPI_CR1_LSBFIRST); // Set LSB first
     else
@@ -175,6 +207,69 @@ bool SPI_HasDataToRecieve(SPI_TypeDef *SPIx){
     return READ_BIT(SPIx->SR, SPI_SR_RXNE) ? true : false; // Checks if the SPIx's recieve buffer is not empty
 }
 
+bool SPI_WaitUntilIdle(const SPI_TypeDef *SPIx){
+    return SPI_WaitFlag(SPIx, SPI_SR_BSY, false, "SPI BSY");
+}
+
+void SPI_SetReceiveCallback(SPI_TypeDef *SPIx, SPI_Callback callback){
+    IRQn_Type IRQn = SPIx == SPI1 ? SPI1_IRQn : SPI2_IRQn;
+    SPI_RxCallbacks[SPIx == SPI1 ? 0 : 1] = callback;
+
+    if(callback == 0){
+        CLEAR_BIT(SPIx->CR2, SPI_CR2_RXNEIE);           // Back to polling
+        INTERRUPT_Disable(IRQn);
+    } else if(!READ_BIT(SPIx->CR2, SPI_CR2_RXNEIE)){    // Only flush when switching over from polling
+        (void)READ_REG(SPIx->DR);                       // Drop any frame left by a blocking transfer
+        (void)READ_REG(SPIx->SR);                       // Reading DR then SR clears an overrun
+        SET_BIT(SPIx->CR2, SPI_CR2_RXNEIE);
+        INTERRUPT_Enable(IRQn);
+    }
+}
+
+#ifdef ACDC_THREAD_SAFE
+void SPI_Lock(const SPI_TypeDef *SPIx){
+    uint8_t bus = SPIx == SPI1 ? 0 : 1;
+    RTOS_DriverLock(&SPI_Locks[bus]);
+    if(!RTOS_CanBlock())
+        return;
+
+    // Holding the mutex stops new background transfers, one already running still owns chip select until it ends
+    uint32_t start = WATCHDOG_WaitStart();
+    while(SPI_BackgroundBusy[bus]){
+        if(WATCHDOG_WaitExpired(start, 2 * SPI_TIMEOUT_US, "SPI background"))
+            break;
+        osDelay(1);
+    }
+}
+
+void SPI_Unlock(const SPI_TypeDef *SPIx){
+    RTOS_DriverUnlock(&SPI_Locks[SPIx == SPI1 ? 0 : 1]);
+}
+
+bool SPI_TryLockBackground(const SPI_TypeDef *SPIx){
+    uint8_t bus = SPIx == SPI1 ? 0 : 1;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();                                // A thread can not take the mutex between the check and the claim
+    bool free = SPI_Locks[bus].owner == NULL && !SPI_BackgroundBusy[bus];
+    if(free)
+        SPI_BackgroundBusy[bus] = true;
+    __set_PRIMASK(primask);
+    return free;
+}
+
+void SPI_UnlockBackground(const SPI_TypeDef *SPIx){
+    SPI_BackgroundBusy[SPIx == SPI1 ? 0 : 1] = false;
+}
+#endif
+
+ACDC_RAMFUNC void SPI1_IRQHandler(void){
+    SPI_RxInterruptHandler(SPI1, SPI_RxCallbacks[0]);
+}
+
+ACDC_RAMFUNC void SPI2_IRQHandler(void){
+    SPI_RxInterruptHandler(SPI2, SPI_RxCallbacks[1]);
+}
+
 #pragma region PRIVATE_FUNCTIONS
 static void SPI_InitClk(const SPI_TypeDef *SPIx){
     if(SPIx == SPI1)
@@ -216,4 +311,22 @@ static void SPI_InitPin(const SPI_TypeDef *SPIx, bool isMaster){
         GPIO_PinDirection(GPIO_PORT, SPI_MOSI, GPIO_MODE_INPUT             , GPIO_CNF_INPUT_FLOATING     );
     }
 }
+
+ACDC_RAMFUNC static void SPI_RxInterruptHandler(SPI_TypeDef *SPIx, SPI_Callback callback){
+    if(!READ_BIT(SPIx->SR, SPI_SR_RXNE))
+        return;                                 // Not a receive interrupt
+    uint16_t data = READ_REG(SPIx->DR);         // Reading DR clears RXNE
+    if(callback)
+        callback(data);
+}
+
+static bool SPI_WaitFlag(const SPI_TypeDef *SPIx, uint32_t flag, bool set, const char *site){
+    bool bounded = READ_BIT(SPIx->CR1, SPI_CR1_MSTR) != 0;     // A slave waits for the master's clock, however long it takes
+    uint32_t start = WATCHDOG_WaitStart();
+    while((READ_BIT(SPIx->SR, flag) != 0) != set){
+        if(bounded && WATCHDOG_WaitExpired(start, SPI_TIMEOUT_US, site))
+            return false;
+    }
+    return true;
+}
 #pragma endregion
\ No newline at end of file
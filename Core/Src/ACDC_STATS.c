@@ -0,0 +1,153 @@
+/**
+ * @file ACDC_STATS.c
+ * @author Devin Marx
+ * @brief Implementation of streaming block statistics
+ * @version 0.1
+ * @date 2024-04-20
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_STATS.h"
+#include "ACDC_TELEMETRY.h"
+
+#define STATS_CHUNK_SIZE 256    // Most samples merged at once (Keeps the square of the chunk's sum inside 64 bits)
+#define STATS_MEAN_SHIFT 16     // Extra fractional bits kept in the running mean
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Merges up to STATS_CHUNK_SIZE samples into the running statistics (Chan's parallel form of Welford's algorithm)
+/// @param stats Statistics stage
+/// @param samples q15 samples
+/// @param count Number of samples (1 - STATS_CHUNK_SIZE)
+static void STATS_Merge(STATS_t *stats, const q15_t *samples, uint32_t count);
+
+/// @brief Makes the summary of the current period and starts a new one
+/// @param stats Statistics stage with a completed period
+static void STATS_Summarize(STATS_t *stats);
+
+/// @brief Square root of a Q30 value
+/// @param value Q30 value (Ex. a mean square)
+/// @return Square root as q15
+static q15_t STATS_SqrtQ30(int64_t value);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool STATS_Init(STATS_t *stats, uint8_t id, uint32_t periodSamples){
+    if(periodSamples == 0 || periodSamples > STATS_MAX_PERIOD)
+        return false;
+
+    stats->id = id;
+    stats->periodSamples = periodSamples;
+    stats->summary = (STATS_Summary_t){0};
+    STATS_Reset(stats);
+    return true;
+}
+
+bool STATS_AddBlock(STATS_t *stats, const q15_t *samples, uint32_t count){
+    bool summarized = false;
+    while(count != 0){
+        uint32_t toMerge = stats->periodSamples - stats->count;
+        if(toMerge > count)
+            toMerge = count;
+        if(toMerge > STATS_CHUNK_SIZE)
+            toMerge = STATS_CHUNK_SIZE;
+
+        STATS_Merge(stats, samples, toMerge);
+        samples += toMerge;
+        count -= toMerge;
+
+        if(stats->count == stats->periodSamples){
+            STATS_Summarize(stats);
+            summarized = true;
+        }
+    }
+    return summarized;
+}
+
+const STATS_Summary_t* STATS_GetSummary(const STATS_t *stats){
+    return &stats->summary;
+}
+
+void STATS_Reset(STATS_t *stats){
+    stats->count = 0;
+    stats->mean = 0;
+    stats->m2 = 0;
+    stats->sumSquares = 0;
+    stats->min = 32767;
+    stats->max = -32768;
+}
+
+bool STATS_SendSummary(const STATS_t *stats){
+    const STATS_Summary_t *summary = &stats->summary;
+    TELEMETRY_Begin(TELEMETRY_STATS_SUMMARY);
+    TELEMETRY_AddU8(stats->id);
+    TELEMETRY_AddU32(summary->count);
+    TELEMETRY_AddU16((uint16_t)summary->mean);
+    TELEMETRY_AddU16((uint16_t)summary->rms);
+    TELEMETRY_AddU16((uint16_t)summary->min);
+    TELEMETRY_AddU16((uint16_t)summary->max);
+    TELEMETRY_AddU32((uint32_t)summary->variance);
+    TELEMETRY_AddU16((uint16_t)summary->stdDev);
+    return TELEMETRY_End();
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static void STATS_Merge(STATS_t *stats, const q15_t *samples, uint32_t count){
+    // Reduce the chunk. arm_power_q15 returns the exact sum of squares (34.30), the sum is exact as well.
+    // arm_mean_q15 and arm_rms_q15 round to q15, which would lose the variance of quiet signals
+    int32_t sum = 0;
+    for(uint32_t i = 0; i < count; i++)
+        sum += samples[i];
+    q63_t sumSquares;
+    q15_t value;
+    uint32_t index;
+    arm_power_q15((q15_t*)samples, count, &sumSquares);    // CMSIS-DSP 1.5 does not take const input
+    arm_min_q15((q15_t*)samples, count, &value, &index);
+    if(value < stats->min)
+        stats->min = value;
+    arm_max_q15((q15_t*)samples, count, &value, &index);
+    if(value > stats->max)
+        stats->max = value;
+
+    int64_t chunkMean = ((int64_t)sum << STATS_MEAN_SHIFT) / (int32_t)count;
+    int64_t chunkM2 = sumSquares - ((int64_t)sum * sum) / (int32_t)count;
+
+    // Merge: mean += delta * nB / n, M2 += M2B + delta^2 * nA * nB / n
+    uint32_t previous = stats->count;
+    uint32_t total = previous + count;
+    int64_t delta = chunkMean - stats->mean;
+    stats->mean += (delta * (int32_t)count) / (int32_t)total;
+
+    int64_t delta8 = delta >> (STATS_MEAN_SHIFT - 8);                               // q15 with 8 extra bits (Squared fits in 48 bits)
+    uint64_t weight = (((uint64_t)previous * count) << 16) / total;                 // nA * nB / n in Q16 (At most count)
+    int64_t spread = (int64_t)((((uint64_t)(delta8 * delta8) >> 16) * weight) >> 16);   // Q30
+    stats->m2 += chunkM2 + spread;
+    stats->sumSquares += sumSquares;
+    stats->count = total;
+}
+
+static void STATS_Summarize(STATS_t *stats){
+    STATS_Summary_t *summary = &stats->summary;
+    int32_t count = (int32_t)stats->count;
+    int64_t mean = (stats->mean + (1 << (STATS_MEAN_SHIFT - 1))) >> STATS_MEAN_SHIFT;
+    int64_t variance = stats->m2 / count;                  // Q30
+
+    summary->count = stats->count;
+    summary->mean = (q15_t)__SSAT((int32_t)mean, 16);
+    summary->rms = STATS_SqrtQ30(stats->sumSquares / count);
+    summary->min = stats->min;
+    summary->max = stats->max;
+    summary->variance = (variance >= 0x40000000) ? 0x7FFFFFFF : (q31_t)(variance << 1);
+    summary->stdDev = STATS_SqrtQ30(variance);
+    STATS_Reset(stats);
+}
+
+static q15_t STATS_SqrtQ30(int64_t value){
+    q31_t root = 0;
+    if(value > 0)
+        arm_sqrt_q31((value >= 0x40000000) ? 0x7FFFFFFF : (q31_t)(value << 1), &root);
+    int32_t rounded = (int32_t)(((int64_t)root + 0x8000) >> 16);     // Rounded, arm_sqrt_q31 can land just under an exact root
+    return (q15_t)(rounded > 32767 ? 32767 : rounded);
+}
+#pragma endregion
@@ -0,0 +1,156 @@
+/**
+ * @file ACDC_TELEMETRY.c
+ * @author Devin Marx
+ * @brief Implementation of binary telemetry frames sent over USART
+ * @version 0.1
+ * @date 2024-04-17
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_USART.h"
+#include "ACDC_WATCHDOG.h"
+
+#define TELEMETRY_HEADER_SIZE  6        // Sync (2), type, sequence, length (2)
+#define TELEMETRY_CRC_SIZE     2
+#define TELEMETRY_CRC_INIT     0xFFFF   // CRC-16/CCITT-FALSE
+#define TELEMETRY_CRC_POLY     0x1021
+#define TELEMETRY_TIMEOUT_US   500000   // Longest the previous frame may take (A full frame at 9600 baud is 275ms)
+
+static USART_TypeDef *TELEMETRY_USART;
+static uint8_t TELEMETRY_Frame[TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_SIZE];   // Sent in place by USART_SendBufferAsync
+static uint16_t TELEMETRY_Length;       // Payload bytes in the current frame
+static bool TELEMETRY_Overflowed;       // Current frame ran out of room
+static uint8_t TELEMETRY_Sequence;
+static uint32_t TELEMETRY_DroppedFrames;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Calculates the CRC-16/CCITT-FALSE of length bytes
+/// @param crc TELEMETRY_CRC_INIT, or the CRC of the bytes before these to continue it
+/// @param data Bytes to run through the CRC
+/// @param length Number of bytes
+/// @return CRC of the bytes
+static uint16_t TELEMETRY_CRC16(uint16_t crc, const uint8_t *data, uint16_t length);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void TELEMETRY_Init(USART_TypeDef *USARTx){
+    TELEMETRY_USART = USARTx;
+}
+
+bool TELEMETRY_Begin(TELEMETRY_Type TELEMETRY_x){
+    uint32_t start = WATCHDOG_WaitStart();
+    while(USART_IsTransmitting(TELEMETRY_USART)){       // The previous frame is still being sent out of TELEMETRY_Frame
+        if(WATCHDOG_WaitExpired(start, TELEMETRY_TIMEOUT_US, "TELEMETRY")){
+            TELEMETRY_Length = TELEMETRY_MAX_PAYLOAD;   // Nothing may be written into the frame still going out
+            TELEMETRY_Overflowed = true;                // TELEMETRY_End drops this frame
+            return false;
+        }
+    }
+
+    TELEMETRY_Frame[0] = TELEMETRY_SYNC_0;
+    TELEMETRY_Frame[1] = TELEMETRY_SYNC_1;
+    TELEMETRY_Frame[2] = (uint8_t)TELEMETRY_x;
+    TELEMETRY_Frame[3] = TELEMETRY_Sequence;
+    TELEMETRY_Length = 0;
+    TELEMETRY_Overflowed = false;
+    return true;
+}
+
+bool TELEMETRY_AddU8(uint8_t value){
+    return TELEMETRY_AddBytes(&value, sizeof(value));
+}
+
+bool TELEMETRY_AddU16(uint16_t value){
+    return TELEMETRY_AddBytes(&value, sizeof(value));   // Cortex-M3 is little endian, the bytes are already in frame order
+}
+
+bool TELEMETRY_AddU32(uint32_t value){
+    return TELEMETRY_AddBytes(&value, sizeof(value));
+}
+
+bool TELEMETRY_AddBytes(const void *data, uint16_t length){
+    if(length > TELEMETRY_GetFreeSpace()){
+        TELEMETRY_Overflowed = true;                    // Sending part of a payload would be decoded as garbage, drop the whole frame
+        return false;
+    }
+
+    const uint8_t *bytes = (const uint8_t*)data;
+    uint8_t *payload = &TELEMETRY_Frame[TELEMETRY_HEADER_SIZE + TELEMETRY_Length];
+    for(uint16_t i = 0; i < length; i++)
+        payload[i] = bytes[i];
+    TELEMETRY_Length += length;
+    return true;
+}
+
+uint16_t TELEMETRY_GetFreeSpace(void){
+    return TELEMETRY_MAX_PAYLOAD - TELEMETRY_Length;
+}
+
+bool TELEMETRY_End(void){
+    if(TELEMETRY_Overflowed){
+        TELEMETRY_DroppedFrames++;
+        return false;
+    }
+
+    TELEMETRY_Frame[4] = TELEMETRY_Length & 0xFF;
+    TELEMETRY_Frame[5] = TELEMETRY_Length >> 8;
+    uint16_t crcIndex = TELEMETRY_HEADER_SIZE + TELEMETRY_Length;
+    uint16_t crc = TELEMETRY_CRC16(TELEMETRY_CRC_INIT, &TELEMETRY_Frame[2], crcIndex - 2);     // Everything after the sync bytes
+    TELEMETRY_Frame[crcIndex] = crc & 0xFF;
+    TELEMETRY_Frame[crcIndex + 1] = crc >> 8;
+
+    TELEMETRY_Sequence++;
+    return USART_SendBufferAsync(TELEMETRY_USART, (const char*)TELEMETRY_Frame, crcIndex + TELEMETRY_CRC_SIZE);
+}
+
+uint32_t TELEMETRY_GetDroppedFrames(void){
+    return TELEMETRY_DroppedFrames;
+}
+
+bool TELEMETRY_IsSending(void){
+    return USART_IsTransmitting(TELEMETRY_USART);
+}
+
+void TELEMETRY_SendFrame(USART_TypeDef *USARTx, TELEMETRY_Type TELEMETRY_x, const void *payload, uint16_t length){
+    uint8_t header[TELEMETRY_HEADER_SIZE] = {TELEMETRY_SYNC_0, TELEMETRY_SYNC_1, (uint8_t)TELEMETRY_x, TELEMETRY_Sequence++,
+                                             length & 0xFF, length >> 8};
+    uint16_t crc = TELEMETRY_CRC16(TELEMETRY_CRC_INIT, &header[2], TELEMETRY_HEADER_SIZE - 2);
+    crc = TELEMETRY_CRC16(crc, payload, length);
+    uint8_t trailer[TELEMETRY_CRC_SIZE] = {crc & 0xFF, crc >> 8};
+
+    USART_SendBuffer(USARTx, (const char*)header, TELEMETRY_HEADER_SIZE);
+    USART_SendBuffer(USARTx, payload, length);
+    USART_SendBuffer(USARTx, (const char*)trailer, TELEMETRY_CRC_SIZE);
+}
+
+uint16_t TELEMETRY_EncodeFrame(uint8_t *frame, TELEMETRY_Type TELEMETRY_x, const void *payload, uint16_t length){
+    frame[0] = TELEMETRY_SYNC_0;
+    frame[1] = TELEMETRY_SYNC_1;
+    frame[2] = (uint8_t)TELEMETRY_x;
+    frame[3] = TELEMETRY_Sequence++;
+    frame[4] = length & 0xFF;
+    frame[5] = length >> 8;
+    const uint8_t *bytes = (const uint8_t*)payload;
+    for(uint16_t i = 0; i < length; i++)
+        frame[TELEMETRY_HEADER_SIZE + i] = bytes[i];
+
+    uint16_t crcIndex = TELEMETRY_HEADER_SIZE + length;
+    uint16_t crc = TELEMETRY_CRC16(TELEMETRY_CRC_INIT, &frame[2], crcIndex - 2);    // Everything after the sync bytes
+    frame[crcIndex] = crc & 0xFF;
+    frame[crcIndex + 1] = crc >> 8;
+    return crcIndex + TELEMETRY_CRC_SIZE;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static uint16_t TELEMETRY_CRC16(uint16_t crc, const uint8_t *data, uint16_t length){
+    for(uint16_t i = 0; i < length; i++){
+        crc ^= (uint16_t)data[i] << 8;
+        for(uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ TELEMETRY_CRC_POLY : crc << 1;
+    }
+    return crc;
+}
+#pragma endregion
@@ -11,13 +11,21 @@
 #include "ACDC_TIMER.h"
 #include "ACDC_GPIO.h"
 #include "ACDC_INTERRUPT.h"
+#include "ACDC_ATTRIBUTES.h"
 #include "stm32f1xx.h"
+#ifdef ACDC_THREAD_SAFE
+#include "ACDC_RTOS.h"
+#endif
 
 #define MS_PER_SECOND 1000  // Number of milliseconds per second
 #define US_PER_MS     1000  // Number of microseconds per millisecond
+#define NS_PER_SECOND 1000000000ULL  // Number of nanoseconds per second
+#define TICK_TIMER_COUNT 3  // TIM2, TIM3, TIM4
+#define TIMER_MAX_COUNT  0x10000    // PSC and ARR are 16-bit registers {See RM-419}
 
 volatile static uint64_t SysTickCounter;
 static uint8_t SCS_IN_MHz;                  // Clock frequency in MHz (SCS_72Mhz -> 72, SCS_36Mhz -> 36, Etc.)
+static TimerCallback TIMER_TickCallbacks[TICK_TIMER_COUNT];
 
 #pragma region PRIVATE_FUNCTION_PROTOTYPES
 /// @brief Enables the TIMx peripheral clock
@@ -38,6 +46,17 @@ static void TIMER_PWM_SetOutputEnable(TIMx_CHx TIMx_CHx_Pxx, bool enable);
 /// @param TIMx_CHx_Pxx Struct containing configuration data for the specific timer and channel
 /// @param enable True if you want to enable preloading the output, else false to disable
 static void TIMER_PWM_SetPreloadEnable(TIMx_CHx TIMx_CHx_Pxx, bool enable);
+
+/// @brief Gets the index into TIMER_TickCallbacks and the interrupt vector of TIMx
+/// @param TIMx Timer (Ex. TIM2, TIM3, TIM4)
+/// @param IRQn Set to the update interrupt vector of TIMx
+/// @return Index of TIMx, or TICK_TIMER_COUNT if TIMx does not support TIMER_TICK
+static uint8_t TIMER_TICK_GetIndex(const TIM_TypeDef *TIMx, IRQn_Type *IRQn);
+
+/// @brief Handles the update interrupt of a TIMER_TICK timer
+/// @param TIMx Timer that caused the interrupt
+/// @param callback Function to call if it was an update interrupt
+ACDC_RAMFUNC static void TIMER_TICK_InterruptHandler(TIM_TypeDef *TIMx, TimerCallback callback);
 #pragma endregion
 
 #pragma region PUBLIC_FUNCTIONS
@@ -103,8 +122,62 @@ uint32_t TIMER_PWM_GetPeriod(TIMx_CHx TIMx_CHx_Pxx){
     return TIMx_CHx_Pxx.TIMx->ARR;
 }
 
-void SysTick_Handler(void){
+bool TIMER_TICK_Init(TIM_TypeDef *TIMx, uint32_t frequency, TimerCallback callback){
+    IRQn_Type IRQn;
+    uint8_t index = TIMER_TICK_GetIndex(TIMx, &IRQn);
+    if(index == TICK_TIMER_COUNT || frequency == 0)
+        return false;
+
+    uint32_t ticks = CLOCK_GetSystemClockSpeed() / frequency;      // Timer clock ticks per callback (Same clock as TIMER_PWM_Init)
+    uint32_t prescaler = (ticks - 1) / TIMER_MAX_COUNT + 1;         // Smallest divider that fits the period into the 16-bit ARR
+    if(ticks == 0 || prescaler > TIMER_MAX_COUNT)
+        return false;
+
+    TIMER_InitClk(TIMx);
+    CLEAR_BIT(TIMx->CR1, TIM_CR1_CEN);              // Stop the timer while it is configured
+    TIMER_TickCallbacks[index] = callback;
+    WRITE_REG(TIMx->PSC, prescaler - 1);            // Prescaler is 0 based {See RM-419}
+    WRITE_REG(TIMx->ARR, ticks / prescaler - 1);    // Period is 0 based
+    WRITE_REG(TIMx->EGR, TIM_EGR_UG);               // Load the prescaler now instead of at the next update
+    WRITE_REG(TIMx->SR, ~TIM_SR_UIF);               // UG also sets the update flag, clear it so callback is not called early
+    SET_BIT(TIMx->DIER, TIM_DIER_UIE);              // Enable the update interrupt
+    INTERRUPT_Enable(IRQn);
+    SET_BIT(TIMx->CR1, TIM_CR1_CEN);                // Start counting
+    return true;
+}
+
+void TIMER_TICK_Stop(TIM_TypeDef *TIMx){
+    IRQn_Type IRQn;
+    if(TIMER_TICK_GetIndex(TIMx, &IRQn) == TICK_TIMER_COUNT)
+        return;
+    CLEAR_BIT(TIMx->CR1, TIM_CR1_CEN);      // Stop counting
+    CLEAR_BIT(TIMx->DIER, TIM_DIER_UIE);    // Disable the update interrupt
+    INTERRUPT_Disable(IRQn);
+}
+
+uint32_t TIMER_TICK_GetPeriodNs(const TIM_TypeDef *TIMx){
+    // The period is rounded to whole timer ticks, so it can be a little off from 1 / frequency
+    uint64_t ticks = (uint64_t)(TIMx->PSC + 1) * (TIMx->ARR + 1);
+    return (uint32_t)((ticks * NS_PER_SECOND) / CLOCK_GetSystemClockSpeed());
+}
+
+ACDC_RAMFUNC void TIM2_IRQHandler(void){
+    TIMER_TICK_InterruptHandler(TIM2, TIMER_TickCallbacks[0]);
+}
+
+ACDC_RAMFUNC void TIM3_IRQHandler(void){
+    TIMER_TICK_InterruptHandler(TIM3, TIMER_TickCallbacks[1]);
+}
+
+ACDC_RAMFUNC void TIM4_IRQHandler(void){
+    TIMER_TICK_InterruptHandler(TIM4, TIMER_TickCallbacks[2]);
+}
+
+ACDC_RAMFUNC void SysTick_Handler(void){   // Runs every millisecond
     SysTickCounter += 1;
+#ifdef ACDC_THREAD_SAFE
+    RTOS_Tick();                            // Kernel tick (Timeouts and round robin)
+#endif
 }
 
 uint64_t Millis(){
@@ -112,11 +185,32 @@ uint64_t Millis(){
 }
 
 uint64_t Micros(){
-    uint32_t numSysTicks = 1000 - (SysTick->VAL / SCS_IN_MHz);   // Current number of ticks in the value register (SysTick counts down from SysTick->LOAD)
-    return (SysTickCounter * US_PER_MS) + numSysTicks;           // Gets the total number of us from startup (MS * 1000) + us 
+    // The 64-bit counter takes two reads and SysTick can roll over between reading it and VAL,
+    // so read both again until the counter stays the same
+    uint64_t milliseconds;
+    uint32_t value;
+    do{
+        milliseconds = SysTickCounter;
+        value = SysTick->VAL;
+    }while(milliseconds != SysTickCounter);
+
+    // From an interrupt of the same priority as SysTick (Or with interrupts off) the rollover is pending instead of counted.
+    // A large VAL means it was read after the rollover, so that millisecond has already started
+    uint32_t load = SysTick->LOAD;
+    if(READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk) && value > load / 2)
+        milliseconds++;
+
+    uint32_t numMicros = (load - value) / SCS_IN_MHz;           // us into the current millisecond (SysTick counts down from SysTick->LOAD)
+    return (milliseconds * US_PER_MS) + numMicros;              // Gets the total number of us from startup (MS * 1000) + us
 }
 
 void Delay_MS(uint64_t delayVal){
+#ifdef ACDC_THREAD_SAFE
+    if(RTOS_CanBlock() && delayVal < osWaitForever){
+        osDelay((uint32_t)delayVal);        // Other threads run instead of spinning
+        return;
+    }
+#endif
     uint64_t current = Millis();
     while(Millis() - current < delayVal){}
 }
@@ -143,7 +237,7 @@ static void TIMER_InitClk(const TIM_TypeDef *TIMx){
 
 static void TIMER_PWM_SetPwmMode(TIMx_CHx TIMx_CHx_Pxx, PWM_MODE PWM_MODE_x){
     // CCMR1 and CCMR2 have the same bit structure
-    volatile uint16_t *CCMRx = TIMx_CHx_Pxx.TimerChannel < 3 ?  // If it is channel 1 or 2
+    volatile uint32_t *CCMRx = TIMx_CHx_Pxx.TimerChannel < 3 ?  // If it is channel 1 or 2
                                    &TIMx_CHx_Pxx.TIMx->CCMR1 :  // Grab CCMR1
                                    &TIMx_CHx_Pxx.TIMx->CCMR2;   // Else grab CCMR2
     
@@ -167,7 +261,7 @@ static void TIMER_PWM_SetOutputEnable(TIMx_CHx TIMx_CHx_Pxx, bool enable){
 
 static void TIMER_PWM_SetPreloadEnable(TIMx_CHx TIMx_CHx_Pxx, bool enable){
     // CCMR1 and CCMR2 have the same bit structure
-    volatile uint16_t *CCMRx = TIMx_CHx_Pxx.TimerChannel < 3 ?  // If it is channel 1 or 2
+    volatile uint32_t *CCMRx = TIMx_CHx_Pxx.TimerChannel < 3 ?  // If it is channel 1 or 2
                                    &TIMx_CHx_Pxx.TIMx->CCMR1 :  // Grab CCMR1
                                    &TIMx_CHx_Pxx.TIMx->CCMR2;   // Else grab CCMR2
     
@@ -183,4 +277,27 @@ static void TIMER_PWM_SetPreloadEnable(TIMx_CHx TIMx_CHx_Pxx, bool enable){
             CLEAR_BIT(*CCMRx, TIM_CCMR1_OC2PE);  
     }
 }
+
+static uint8_t TIMER_TICK_GetIndex(const TIM_TypeDef *TIMx, IRQn_Type *IRQn){
+    // TIM1 has a separate update vector and drives the PWM outputs, only the general purpose timers are used
+    if(TIMx == TIM2){
+        *IRQn = TIM2_IRQn;
+        return 0;
+    } else if(TIMx == TIM3){
+        *IRQn = TIM3_IRQn;
+        return 1;
+    } else if(TIMx == TIM4){
+        *IRQn = TIM4_IRQn;
+        return 2;
+    }
+    return TICK_TIMER_COUNT;
+}
+
+ACDC_RAMFUNC static void TIMER_TICK_InterruptHandler(TIM_TypeDef *TIMx, TimerCallback callback){
+    if(!READ_BIT(TIMx->SR, TIM_SR_UIF))
+        return;                             // Not an update interrupt
+    WRITE_REG(TIMx->SR, ~TIM_SR_UIF);       // rc_w0, writing 1s leaves the other flags alone {See RM-410}
+    if(callback)
+        callback();
+}
 #pragma endregion
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ * @file ACDC_TIMESTAMP.c
+ * @author Devin Marx
+ * @brief Implementation of EXTI event and ACQUIRE block timestamps
+ * @version 0.1
+ * @date 2024-04-22
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_TIMESTAMP.h"
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_TIMER.h"
+
+static TIMESTAMP_Event_t TIMESTAMP_Events[TIMESTAMP_MAX_EVENTS];
+static volatile uint32_t TIMESTAMP_EventsWritten;   // Free running, only written by the interrupts
+static volatile uint32_t TIMESTAMP_EventsRead;      // Free running, only written by the main loop
+static volatile uint32_t TIMESTAMP_DroppedEvents;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Copies a queued event without taking it off the queue (Main loop only)
+/// @param index Position in the queue, 0 is the oldest event
+/// @param event Set to the event
+/// @return True if there was an event at index, false otherwise
+static bool TIMESTAMP_PeekEvent(uint32_t index, TIMESTAMP_Event_t *event);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+bool TIMESTAMP_RecordEXTI(uint8_t line){
+    uint32_t time = (uint32_t)Micros();             // Read before anything else so the time is as close to the edge as possible
+    uint32_t sampleNumber = ACQUIRE_GetSampleNumber();
+
+    // EXTI interrupts of different priorities can interrupt each other, so only one writes at a time
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t written = TIMESTAMP_EventsWritten;
+    bool queued = written - TIMESTAMP_EventsRead < TIMESTAMP_MAX_EVENTS;
+    if(queued){
+        TIMESTAMP_Events[written % TIMESTAMP_MAX_EVENTS] = (TIMESTAMP_Event_t){time, sampleNumber, line};
+        TIMESTAMP_EventsWritten = written + 1;
+    } else
+        TIMESTAMP_DroppedEvents++;
+    __set_PRIMASK(primask);
+    return queued;
+}
+
+bool TIMESTAMP_GetEvent(TIMESTAMP_Event_t *event){
+    if(!TIMESTAMP_PeekEvent(0, event))
+        return false;
+    TIMESTAMP_EventsRead++;                         // The interrupts may now reuse this slot
+    return true;
+}
+
+bool TIMESTAMP_SendEvents(void){
+    uint32_t count = TIMESTAMP_EventsWritten - TIMESTAMP_EventsRead;    // Events recorded after this are sent next time
+    if(count == 0)
+        return true;
+
+    TIMESTAMP_Event_t event;
+    TELEMETRY_Begin(TELEMETRY_EXTI_EVENTS);
+    TELEMETRY_AddU8((uint8_t)count);
+    for(uint32_t i = 0; i < count && TIMESTAMP_PeekEvent(i, &event); i++){
+        TELEMETRY_AddU8(event.line);
+        TELEMETRY_AddU32(event.time);
+        TELEMETRY_AddU32(event.sampleNumber);
+    }
+    if(!TELEMETRY_End())
+        return false;                               // The events stay queued for the next try
+    TIMESTAMP_EventsRead += count;
+    return true;
+}
+
+bool TIMESTAMP_SendBlock(const ACQUIRE_Block_t *block){
+    TELEMETRY_Begin(TELEMETRY_BLOCK_TIME);
+    TELEMETRY_AddU32(block->firstSample);
+    TELEMETRY_AddU32(block->timestamp);
+    TELEMETRY_AddU32(block->samplePeriod);
+    TELEMETRY_AddU16((uint16_t)block->length);
+    return TELEMETRY_End();
+}
+
+uint32_t TIMESTAMP_GetDroppedEvents(void){
+    return TIMESTAMP_DroppedEvents;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static bool TIMESTAMP_PeekEvent(uint32_t index, TIMESTAMP_Event_t *event){
+    uint32_t read = TIMESTAMP_EventsRead;
+    if(TIMESTAMP_EventsWritten - read <= index)
+        return false;
+    *event = TIMESTAMP_Events[(read + index) % TIMESTAMP_MAX_EVENTS];
+    return true;
+}
+#pragma endregion
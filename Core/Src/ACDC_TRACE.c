@@ -0,0 +1,134 @@
+/**
+ * @file ACDC_TRACE.c
+ * @author Devin Marx
+ * @brief Implementation of the binary trace ring
+ * @version 0.1
+ * @date 2024-04-29
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_TRACE.h"
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_CLOCK.h"
+
+#define TRACE_HEADER_SIZE   8   // System clock (4), number of the first record (4)
+
+typedef struct{
+    uint32_t clock;             // System clock, to turn cycles into seconds
+    uint32_t first;             // Number of the first record since TRACE_Init (Gaps between frames are lost records)
+    TRACE_Record_t records[TRACE_RECORDS_PER_FRAME];
+}TRACE_Frame_t;                 // Payload of a TELEMETRY_TRACE_RECORDS frame (Little endian like the core)
+
+static TRACE_Record_t TraceBuffer[TRACE_BUFFER_RECORDS];
+static volatile uint32_t TraceHead = 0;     // Records written since TRACE_Init (The next one goes to TraceHead % TRACE_BUFFER_RECORDS)
+static uint32_t TraceTail = 0;              // Records drained (Main loop only)
+static uint32_t TraceLost = 0;
+static volatile bool TraceEnabled = false;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Copies the records from *next up to end (At most TRACE_RECORDS_PER_FRAME) into a frame payload. Stops early
+///        if a writer laps the copy, so the records in a frame are always consecutive
+/// @param frame Payload to fill
+/// @param next Number of the first record to copy, moved past the records copied
+/// @param end Number of the record after the last one to copy
+/// @return Bytes of payload filled (TRACE_HEADER_SIZE if no record could be copied)
+static uint16_t TRACE_BuildFrame(TRACE_Frame_t *frame, uint32_t *next, uint32_t end);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void TRACE_Init(void){
+    SET_BIT(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);  // Enable the DWT block
+    SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);             // Start the cycle counter (Left running if ACDC_BENCH started it)
+
+    TraceEnabled = false;
+    TraceHead = 0;
+    TraceTail = 0;
+    TraceLost = 0;
+    TraceEnabled = true;
+    TRACE("trace started, %u Hz", CLOCK_GetSystemClockSpeed(), 0);
+}
+
+void TRACE_Write(uint16_t id, uint32_t arg0, uint32_t arg1){
+    if(!TraceEnabled)
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();                                        // A nested TRACE can not land in the middle of this record
+    TRACE_Record_t *record = &TraceBuffer[TraceHead & (TRACE_BUFFER_RECORDS - 1)];
+    record->time = DWT->CYCCNT;
+    record->id = id;
+    record->context = (uint16_t)(__get_IPSR() & 0x1FF);
+    record->arg0 = arg0;
+    record->arg1 = arg1;
+    TraceHead++;
+    __set_PRIMASK(primask);
+}
+
+void TRACE_SetEnabled(bool enabled){
+    TraceEnabled = enabled;
+}
+
+bool TRACE_Drain(void){
+    uint32_t head = TraceHead;
+    if(head == TraceTail || TELEMETRY_IsSending())
+        return false;
+
+    if(head - TraceTail > TRACE_BUFFER_RECORDS){            // The oldest records were overwritten before they were sent
+        TraceLost += head - TraceTail - TRACE_BUFFER_RECORDS;
+        TraceTail = head - TRACE_BUFFER_RECORDS;
+    }
+
+    TRACE_Frame_t frame;
+    uint16_t length = TRACE_BuildFrame(&frame, &TraceTail, head);
+    if(length == TRACE_HEADER_SIZE)
+        return false;                                       // Lapped before the first copy, the next call skips ahead
+    TELEMETRY_Begin(TELEMETRY_TRACE_RECORDS);
+    TELEMETRY_AddBytes(&frame, length);
+    return TELEMETRY_End();
+}
+
+uint32_t TRACE_GetPending(void){
+    uint32_t pending = TraceHead - TraceTail;
+    return (pending > TRACE_BUFFER_RECORDS) ? TRACE_BUFFER_RECORDS : pending;
+}
+
+uint32_t TRACE_GetLost(void){
+    uint32_t pending = TraceHead - TraceTail;
+    return TraceLost + ((pending > TRACE_BUFFER_RECORDS) ? pending - TRACE_BUFFER_RECORDS : 0);
+}
+
+void TRACE_Dump(USART_TypeDef *USARTx){
+    TraceEnabled = false;                                   // Keep the ring as it was when the dump started
+
+    uint32_t end = TraceHead;
+    uint32_t next = (end > TRACE_BUFFER_RECORDS) ? end - TRACE_BUFFER_RECORDS : 0;
+    TRACE_Frame_t frame;
+    while(next != end){
+        uint16_t length = TRACE_BuildFrame(&frame, &next, end);
+        TELEMETRY_SendFrame(USARTx, TELEMETRY_TRACE_RECORDS, &frame, length);
+    }
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static uint16_t TRACE_BuildFrame(TRACE_Frame_t *frame, uint32_t *next, uint32_t end){
+    frame->clock = CLOCK_GetSystemClockSpeed();
+    frame->first = *next;
+
+    uint8_t count = 0;
+    while(count < TRACE_RECORDS_PER_FRAME && *next != end){
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        bool overwritten = TraceHead - *next > TRACE_BUFFER_RECORDS;
+        if(!overwritten)
+            frame->records[count] = TraceBuffer[*next & (TRACE_BUFFER_RECORDS - 1)];
+        __set_PRIMASK(primask);
+        if(overwritten)
+            break;
+        count++;
+        (*next)++;
+    }
+    return TRACE_HEADER_SIZE + count * sizeof(TRACE_Record_t);
+}
+#pragma endregion
@@ -10,8 +10,34 @@
 
 #include "ACDC_USART.h"
 #include "ACDC_GPIO.h"
+#include "ACDC_INTERRUPT.h"
+#include "ACDC_ATTRIBUTES.h"
+#include "ACDC_WATCHDOG.h"
+#ifdef ACDC_THREAD_SAFE
+#include "ACDC_RTOS.h"
+#endif
+
+#define USART_COUNT 3   // USART1, USART2, USART3
+#define USART_TIMEOUT_US 20000  // Longest TXE may take (One character at 1200 baud is 8.3ms)
+
+typedef struct{
+    const char *data;               /**< Next byte to send (Owned by the caller until remaining is 0) */
+    volatile uint16_t remaining;    /**< Number of bytes left to send                                  */
+#ifdef ACDC_THREAD_SAFE
+    volatile osThreadId_t waiter;   /**< Thread blocked in USART_Write until remaining is 0            */
+#endif
+}USART_TxState;
 
 static uint8_t USART_Initialized = 0;
+static USART_TxState USART_TxStates[USART_COUNT];
+#ifdef ACDC_THREAD_SAFE
+static RTOS_Mutex_t USART_TxLocks[USART_COUNT] = {RTOS_MUTEX_INIT, RTOS_MUTEX_INIT, RTOS_MUTEX_INIT};
+static RTOS_Mutex_t USART_RxLocks[USART_COUNT] = {RTOS_MUTEX_INIT, RTOS_MUTEX_INIT, RTOS_MUTEX_INIT};
+static volatile osThreadId_t USART_RxWaiters[USART_COUNT];     // Thread blocked in USART_Read until RXNE is set
+#else
+#define USART_Lock(locks, USARTx)   ((void)0)
+#define USART_Unlock(locks, USARTx) ((void)0)
+#endif
 
 #pragma region PRIVATE_FUNCTION_PROTOTYPES
 /// @brief Enables the USARTx peripheral clock (Needed for peripheral to function)
@@ -37,6 +63,53 @@ static bool USART_IsInitialized(const USART_TypeDef *USARTx);
 /// @brief Sets the initialization status of the current USARTx peripheral.
 /// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
 static void USART_SetInitialized(const USART_TypeDef *USARTx);
+
+/// @brief Retrieves the background transmit state for the USARTx peripheral
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @return Pointer to the transmit state, or 0 if USARTx is not a USART peripheral
+static USART_TxState* USART_GetTxState(const USART_TypeDef *USARTx);
+
+/// @brief Enables the USARTx interrupt in the NVIC
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+static void USART_EnableInterrupt(const USART_TypeDef *USARTx);
+
+/// @brief Waits for a USART_SendBufferAsync transmission to finish, so blocking bytes never land in the middle of it
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @return True once USARTx is free, false if no byte went out for USART_TIMEOUT_US (Ex. interrupts are masked)
+static bool USART_WaitTxIdle(const USART_TypeDef *USARTx);
+
+/// @brief Sends length bytes, blocking the thread on the TXE interrupt in the thread-safe build and spinning on TXE otherwise
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @param data Bytes to send
+/// @param length Number of bytes to send
+static void USART_Write(USART_TypeDef *USARTx, const char* data, uint16_t length);
+
+/// @brief Receives one byte, blocking the thread on the RXNE interrupt in the thread-safe build and spinning on RXNE otherwise
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @return Character received
+static char USART_Read(const USART_TypeDef *USARTx);
+
+#ifdef ACDC_THREAD_SAFE
+/// @brief Locks the transmitter or receiver of USARTx for the running thread (Does nothing in interrupts and before osKernelStart)
+/// @param locks USART_TxLocks or USART_RxLocks
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+static void USART_Lock(RTOS_Mutex_t *locks, const USART_TypeDef *USARTx);
+
+/// @brief Unlocks the transmitter or receiver of USARTx after USART_Lock
+/// @param locks USART_TxLocks or USART_RxLocks
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+static void USART_Unlock(RTOS_Mutex_t *locks, const USART_TypeDef *USARTx);
+
+/// @brief Wakes the thread waiting in USART_Read once a byte is received (Called from the USARTx interrupt handler)
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @param waiter Thread waiting on USARTx
+ACDC_RAMFUNC static void USART_RxInterruptHandler(USART_TypeDef *USARTx, volatile osThreadId_t *waiter);
+#endif
+
+/// @brief Sends the next byte of a USART_SendBufferAsync transmission (Called from the USARTx interrupt handler)
+/// @param USARTx USART Peripheral (Ex. USART1, USART2, ...)
+/// @param txState Background transmit state of USARTx
+ACDC_RAMFUNC static void USART_TxInterruptHandler(USART_TypeDef *USARTx, USART_TxState *txState);
 #pragma endregion
 
 #pragma region PUBLIC_FUNCTIONS
@@ -69,35 +142,92 @@ void USART_ChangeSerialSpeed(USART_TypeDef *USARTx, SerialSpeed Serial_x){
 }
 
 void USART_SendChar(USART_TypeDef *USARTx, char chr){
-    while(!READ_BIT(USARTx->SR, USART_SR_TXE)){}  // Wait until buffer is ready to transmit again
-    WRITE_REG(USARTx->DR, chr & USART_DR_DR_Msk); // Transmit the data
+    USART_Lock(USART_TxLocks, USARTx);
+    USART_Write(USARTx, &chr, 1);
+    USART_Unlock(USART_TxLocks, USARTx);
 }
 
 void USART_SendString(USART_TypeDef *USARTx, const char* str){
-    for(uint32_t i = 0; str[i] != '\0'; i++)    // Iterate over the whole string
-        USART_SendChar(USARTx, str[i]);         // Send each character 1 by 1
+    USART_Lock(USART_TxLocks, USARTx);                      // The line and its "\r\n" go out together
+    USART_Write(USARTx, str, (uint16_t)StringLength(str));  // Send the whole string
+    USART_Write(USARTx, "\r\n", 2);                         // Carriage return & Line feed
+    USART_Unlock(USART_TxLocks, USARTx);
+}
+
+void USART_SendBuffer(USART_TypeDef *USARTx, const char* data, uint16_t length){
+    USART_Lock(USART_TxLocks, USARTx);
+    USART_Write(USARTx, data, length);                      // Exactly length bytes
+    USART_Unlock(USART_TxLocks, USARTx);
+}
+
+bool USART_SendBufferAsync(USART_TypeDef *USARTx, const char* data, uint16_t length){
+    USART_TxState *txState = USART_GetTxState(USARTx);
+    if(txState == 0 || txState->remaining != 0)     // Unknown peripheral or the previous buffer is still sending
+        return false;
+    if(length == 0)
+        return true;
+
+    txState->data = data;                           // Hold on to the caller's buffer (No copy)
+    txState->remaining = length;
+
+    USART_EnableInterrupt(USARTx);
+    SET_BIT(USARTx->CR1, USART_CR1_TXEIE);          // The interrupt fires as soon as the transmit register is empty
+    return true;
+}
+
+bool USART_SendStringBuilderAsync(USART_TypeDef *USARTx, const StringBuilder *sb){
+    if(sb->length < 0 || sb->length > 0xFFFF)      // Does not fit the 16-bit count of the transmit state
+        return false;
+    return USART_SendBufferAsync(USARTx, sb->buffer, (uint16_t)sb->length);
+}
 
-    USART_SendChar(USARTx, '\r'); // Terminate the USART Transaction
-    USART_SendChar(USARTx, '\n'); // Carriage return & Line feed
+bool USART_IsTransmitting(const USART_TypeDef *USARTx){
+    const USART_TxState *txState = USART_GetTxState(USARTx);
+    return txState != 0 && txState->remaining != 0;
+}
+
+ACDC_RAMFUNC void USART1_IRQHandler(void){
+    USART_TxInterruptHandler(USART1, &USART_TxStates[0]);
+#ifdef ACDC_THREAD_SAFE
+    USART_RxInterruptHandler(USART1, &USART_RxWaiters[0]);
+#endif
+}
+
+ACDC_RAMFUNC void USART2_IRQHandler(void){
+    USART_TxInterruptHandler(USART2, &USART_TxStates[1]);
+#ifdef ACDC_THREAD_SAFE
+    USART_RxInterruptHandler(USART2, &USART_RxWaiters[1]);
+#endif
+}
+
+ACDC_RAMFUNC void USART3_IRQHandler(void){
+    USART_TxInterruptHandler(USART3, &USART_TxStates[2]);
+#ifdef ACDC_THREAD_SAFE
+    USART_RxInterruptHandler(USART3, &USART_RxWaiters[2]);
+#endif
 }
 
 char USART_RecieveChar(const USART_TypeDef *USARTx){
-    while(!READ_BIT(USARTx->SR, USART_SR_RXNE)){}  // Wait until available in the buffer
-    return READ_REG(USARTx->DR & 0xFF);            // Retrieve the character and return it
+    USART_Lock(USART_RxLocks, USARTx);
+    char chr = USART_Read(USARTx);
+    USART_Unlock(USART_RxLocks, USARTx);
+    return chr;
 }
 
 void USART_RecieveString(const USART_TypeDef *USARTx, char* buffer, uint16_t bufferLen){
+    USART_Lock(USART_RxLocks, USARTx);                 // The whole line goes to one thread
     uint16_t i;
     for(i = 0; i < bufferLen; i++){                    // Iterate over the maximum buffer size
-        buffer[i] = USART_RecieveChar(USARTx);         // Read the next character in the USARTx buffer
+        buffer[i] = USART_Read(USARTx);                // Read the next character in the USARTx buffer
         if(buffer[i] == '\n' && buffer[i-1] == '\r')   // If the null terminating character is detected
             break;                                     // Break out of the loop
     }
 
     if(buffer[i] != '\n')                              // If more characters are sent than the buffer can store
-        while(USART_RecieveChar(USARTx) != '\n'){}     // Read the characters until there are no more to be recieved
+        while(USART_Read(USARTx) != '\n'){}            // Read the characters until there are no more to be recieved
 
     buffer[i-1] = '\0';                                // End the string with a null terminating character
+    USART_Unlock(USART_RxLocks, USARTx);
 }
 
 bool USART_HasDataToRecieve(const USART_TypeDef *USARTx){
@@ -191,11 +321,141 @@ static bool USART_IsInitialized(const USART_TypeDef *USARTx){
 }       
 
 static void USART_SetInitialized(const USART_TypeDef *USARTx){
+    uint32_t primask = __get_PRIMASK();     // Read-modify-write of a bitmask shared by every USART
+    __disable_irq();
     if(USARTx == USART1)
         SET_BIT(USART_Initialized, 0b001);
     else if(USARTx == USART2)
         SET_BIT(USART_Initialized, 0b010);
     else if(USARTx == USART3)
         SET_BIT(USART_Initialized, 0b100);
+    __set_PRIMASK(primask);
+}
+static USART_TxState* USART_GetTxState(const USART_TypeDef *USARTx){
+    if(USARTx == USART1)
+        return &USART_TxStates[0];
+    else if(USARTx == USART2)
+        return &USART_TxStates[1];
+    else if(USARTx == USART3)
+        return &USART_TxStates[2];
+    else
+        return 0;
+}
+
+static void USART_EnableInterrupt(const USART_TypeDef *USARTx){
+    if(USARTx == USART1)
+        INTERRUPT_Enable(USART1_IRQn);
+    else if(USARTx == USART2)
+        INTERRUPT_Enable(USART2_IRQn);
+    else
+        INTERRUPT_Enable(USART3_IRQn);
+}
+
+static bool USART_WaitTxIdle(const USART_TypeDef *USARTx){
+    const USART_TxState *txState = USART_GetTxState(USARTx);
+    if(txState == 0)
+        return true;
+
+    uint16_t remaining = txState->remaining;
+    uint32_t start = WATCHDOG_WaitStart();
+    while(remaining != 0){
+        if(txState->remaining != remaining){                // Still sending, give the next byte its own timeout
+            remaining = txState->remaining;
+            start = WATCHDOG_WaitStart();
+        } else if(WATCHDOG_WaitExpired(start, USART_TIMEOUT_US, "USART async")){
+            return false;
+        }
+    }
+    return true;
+}
+
+static void USART_Write(USART_TypeDef *USARTx, const char* data, uint16_t length){
+#ifdef ACDC_THREAD_SAFE
+    USART_TxState *txState = USART_GetTxState(USARTx);
+    if(txState != 0 && length > 0 && RTOS_CanBlock()){     // Sleep until the TXE interrupt has sent the last byte
+        osThreadFlagsClear(RTOS_FLAG_DRIVER);
+        while(1){
+            __disable_irq();                                // The waiter is set before the interrupt can finish the buffer
+            bool started = USART_SendBufferAsync(USARTx, data, length);
+            if(started)
+                txState->waiter = osThreadGetId();
+            __enable_irq();
+            if(started)
+                break;
+            osDelay(1);                                     // A USART_SendBufferAsync buffer is still going out
+        }
+        osThreadFlagsWait(RTOS_FLAG_DRIVER, osFlagsWaitAny, osWaitForever);
+        return;
+    }
+#endif
+    if(!USART_WaitTxIdle(USARTx))
+        return;                                             // The background buffer is not moving, drop the bytes
+    for(uint16_t i = 0; i < length; i++){
+        uint32_t start = WATCHDOG_WaitStart();
+        while(!READ_BIT(USARTx->SR, USART_SR_TXE)){         // Wait until buffer is ready to transmit again
+            if(WATCHDOG_WaitExpired(start, USART_TIMEOUT_US, "USART TXE"))
+                return;                                     // The peripheral is stuck (Clock off?), drop the rest
+        }
+        WRITE_REG(USARTx->DR, data[i] & USART_DR_DR_Msk);   // Transmit the data
+    }
+}
+
+static char USART_Read(const USART_TypeDef *USARTx){
+#ifdef ACDC_THREAD_SAFE
+    const USART_TxState *txState = USART_GetTxState(USARTx);
+    if(txState != 0 && RTOS_CanBlock() && !READ_BIT(USARTx->SR, USART_SR_RXNE)){   // Sleep until the RXNE interrupt
+        USART_TypeDef *usart = (USART_TypeDef *)USARTx;     // Only RXNEIE is changed, the byte is still read below
+        osThreadFlagsClear(RTOS_FLAG_DRIVER);
+        USART_EnableInterrupt(usart);
+        __disable_irq();                                    // CR1 is also changed by the TXE interrupt
+        USART_RxWaiters[txState - USART_TxStates] = osThreadGetId();
+        SET_BIT(usart->CR1, USART_CR1_RXNEIE);              // Fires right away if a byte came in since RXNE was checked
+        __enable_irq();
+        osThreadFlagsWait(RTOS_FLAG_DRIVER, osFlagsWaitAny, osWaitForever);
+    }
+#endif
+    while(!READ_BIT(USARTx->SR, USART_SR_RXNE)){}  // Wait until available in the buffer
+    return READ_REG(USARTx->DR) & 0xFF;            // Retrieve the character and return it
+}
+
+#ifdef ACDC_THREAD_SAFE
+static void USART_Lock(RTOS_Mutex_t *locks, const USART_TypeDef *USARTx){
+    const USART_TxState *txState = USART_GetTxState(USARTx);
+    if(txState != 0)
+        RTOS_DriverLock(&locks[txState - USART_TxStates]);
+}
+
+static void USART_Unlock(RTOS_Mutex_t *locks, const USART_TypeDef *USARTx){
+    const USART_TxState *txState = USART_GetTxState(USARTx);
+    if(txState != 0)
+        RTOS_DriverUnlock(&locks[txState - USART_TxStates]);
+}
+
+ACDC_RAMFUNC static void USART_RxInterruptHandler(USART_TypeDef *USARTx, volatile osThreadId_t *waiter){
+    if(!READ_BIT(USARTx->CR1, USART_CR1_RXNEIE) || !READ_BIT(USARTx->SR, USART_SR_RXNE))
+        return;                                             // Not a receive interrupt
+
+    CLEAR_BIT(USARTx->CR1, USART_CR1_RXNEIE);               // The byte stays in DR for the thread to read
+    if(*waiter != NULL){
+        osThreadFlagsSet(*waiter, RTOS_FLAG_DRIVER);
+        *waiter = NULL;
+    }
+}
+#endif
+
+ACDC_RAMFUNC static void USART_TxInterruptHandler(USART_TypeDef *USARTx, USART_TxState *txState){
+    if(!READ_BIT(USARTx->CR1, USART_CR1_TXEIE) || !READ_BIT(USARTx->SR, USART_SR_TXE))
+        return;                                             // Not a transmit interrupt
+
+    WRITE_REG(USARTx->DR, *txState->data++ & USART_DR_DR_Msk); // Send the next byte
+    if(--txState->remaining == 0){                          // Last byte is in the shift register, the buffer is free
+        CLEAR_BIT(USARTx->CR1, USART_CR1_TXEIE);
+#ifdef ACDC_THREAD_SAFE
+        if(txState->waiter != NULL){                        // Wake the thread blocked in USART_Write
+            osThreadFlagsSet(txState->waiter, RTOS_FLAG_DRIVER);
+            txState->waiter = NULL;
+        }
+#endif
+    }
 }
 #pragma endregion
\ No newline at end of file
@@ -0,0 +1,272 @@
+/**
+ * @file ACDC_WATCHDOG.c
+ * @author Devin Marx
+ * @brief Implementation of the watchdog supervisor
+ * @version 0.1
+ * @date 2024-05-01
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_WATCHDOG.h"
+#include "ACDC_CLOCK.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_USART.h"
+#include "ACDC_string.h"
+
+#define WATCHDOG_MAGIC          0x5AFEDD06UL
+#define WATCHDOG_KEY_RELOAD     0xAAAA          // Refresh the counter
+#define WATCHDOG_KEY_UNLOCK     0x5555          // Allow writes to PR and RLR
+#define WATCHDOG_KEY_START      0xCCCC          // Start the IWDG (And the LSI)
+#define WATCHDOG_LSI_KHZ        40              // Typical LSI, 30 - 60kHz
+#define WATCHDOG_MAX_RELOAD     0xFFF
+#define WATCHDOG_MAX_PRESCALER  6               // /4 << 6 = /256
+#define WATCHDOG_UPDATE_TIMEOUT 10000           // us, PR and RLR take up to 5 LSI periods (125us) to reach the IWDG
+#define WATCHDOG_LINE_SIZE      96
+#define WATCHDOG_RESET_FLAGS    (RCC_CSR_LPWRRSTF | RCC_CSR_WWDGRSTF | RCC_CSR_IWDGRSTF | RCC_CSR_SFTRSTF | RCC_CSR_PORRSTF | RCC_CSR_PINRSTF)
+#define WATCHDOG_CAUSE_UNREAD   0xFF
+
+typedef struct{
+    const char *name;
+    uint32_t deadline;                          // ms
+    volatile uint32_t lastCheckIn;              // Millis() of the last check-in
+    uint32_t worstGap;                          // ms
+}WATCHDOG_Task_t;
+
+typedef struct{
+    uint32_t magic;                             // WATCHDOG_MAGIC when a task was late
+    char task[WATCHDOG_NAME_LENGTH];            // Late task
+    uint32_t gap;                               // ms since its last check-in when it was found late
+    uint32_t deadline;                          // ms
+    uint32_t uptime;                            // Millis() when it was found late
+    char site[WATCHDOG_NAME_LENGTH];            // Last busy-wait that timed out before that ("" if none)
+    uint32_t timeouts;                          // Busy-waits that timed out before that
+    uint32_t check;
+}WATCHDOG_Record_t;                             // Saved in .noinit so WATCHDOG_Report can name the task after the reset
+
+__attribute__((section(".noinit"))) static WATCHDOG_Record_t WatchdogRecord;     // Survives the reset
+static WATCHDOG_Task_t WatchdogTasks[WATCHDOG_MAX_TASKS];
+static volatile uint8_t WatchdogTaskCount = 0;
+static bool WatchdogStarted = false;
+static volatile bool WatchdogStarved = false;   // A task was late, the IWDG is no longer refreshed
+static volatile uint32_t WatchdogTimeouts = 0;
+static const char *volatile WatchdogTimeoutSite = NULL;
+static uint8_t WatchdogResetCause = WATCHDOG_CAUSE_UNREAD;
+static uint32_t WatchdogResetFlags = 0;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Saves the late task to the .noinit record (Only the first late task is kept)
+/// @param task Late task
+/// @param gap ms since its last check-in
+/// @param now Millis()
+static void WATCHDOG_SaveRecord(const WATCHDOG_Task_t *task, uint32_t gap, uint32_t now);
+
+/// @brief Calculates the checksum of the record
+/// @param record Record to check
+/// @return Checksum of every word before check
+static uint32_t WATCHDOG_Checksum(const WATCHDOG_Record_t *record);
+
+/// @brief Copies a name into a fixed size field of the record, cut to fit
+/// @param destination Field of WATCHDOG_NAME_LENGTH characters
+/// @param source Name to copy (NULL for "")
+static void WATCHDOG_CopyName(char *destination, const char *source);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void WATCHDOG_Init(uint32_t timeoutMs){
+    // Find the smallest prescaler the timeout fits in (Finer steps)
+    uint32_t prescaler = 0;
+    uint32_t ticks = timeoutMs * WATCHDOG_LSI_KHZ / 4;
+    while(ticks > WATCHDOG_MAX_RELOAD + 1 && prescaler < WATCHDOG_MAX_PRESCALER){
+        prescaler++;
+        ticks >>= 1;
+    }
+    if(ticks > WATCHDOG_MAX_RELOAD + 1)
+        ticks = WATCHDOG_MAX_RELOAD + 1;
+    if(ticks == 0)
+        ticks = 1;
+
+    SET_BIT(DBGMCU->CR, DBGMCU_CR_DBG_IWDG_STOP);          // Do not reset while the debugger has the core halted
+    WRITE_REG(IWDG->KR, WATCHDOG_KEY_START);
+    WRITE_REG(IWDG->KR, WATCHDOG_KEY_UNLOCK);
+    WRITE_REG(IWDG->PR, prescaler);
+    WRITE_REG(IWDG->RLR, ticks - 1);
+    uint32_t start = WATCHDOG_WaitStart();
+    while(READ_REG(IWDG->SR) != 0){                         // Wait until PR and RLR are in use
+        if(WATCHDOG_WaitExpired(start, WATCHDOG_UPDATE_TIMEOUT, "IWDG update"))
+            break;
+    }
+    WRITE_REG(IWDG->KR, WATCHDOG_KEY_RELOAD);
+    WatchdogStarted = true;
+}
+
+uint8_t WATCHDOG_AddTask(const char *name, uint32_t deadlineMs){
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint8_t id = WatchdogTaskCount;
+    if(id < WATCHDOG_MAX_TASKS){
+        WatchdogTasks[id].name = name;
+        WatchdogTasks[id].deadline = deadlineMs;
+        WatchdogTasks[id].lastCheckIn = (uint32_t)Millis();
+        WatchdogTasks[id].worstGap = 0;
+        WatchdogTaskCount = id + 1;                         // Service only sees the task once it is filled in
+    }else{
+        id = WATCHDOG_INVALID_TASK;
+    }
+    __set_PRIMASK(primask);
+    return id;
+}
+
+void WATCHDOG_CheckIn(uint8_t task){
+    if(task >= WatchdogTaskCount)
+        return;
+    WATCHDOG_Task_t *entry = &WatchdogTasks[task];
+    uint32_t now = (uint32_t)Millis();
+    uint32_t gap = now - entry->lastCheckIn;
+    if(gap > entry->worstGap)
+        entry->worstGap = gap;
+    entry->lastCheckIn = now;
+}
+
+void WATCHDOG_Service(void){
+    if(!WatchdogStarted || WatchdogStarved)
+        return;                                             // Once a task was late it stays late until the reset
+
+    uint32_t now = (uint32_t)Millis();
+    uint8_t count = WatchdogTaskCount;
+    for(uint8_t i = 0; i < count; i++){
+        // Signed, a task that checks in from a higher priority interrupt after now was read is not late
+        int32_t gap = (int32_t)(now - WatchdogTasks[i].lastCheckIn);
+        if(gap > (int32_t)WatchdogTasks[i].deadline){
+            WatchdogStarved = true;
+            WATCHDOG_SaveRecord(&WatchdogTasks[i], (uint32_t)gap, now);
+            return;
+        }
+    }
+    WRITE_REG(IWDG->KR, WATCHDOG_KEY_RELOAD);
+}
+
+bool WATCHDOG_IsHealthy(void){
+    return !WatchdogStarved;
+}
+
+uint32_t WATCHDOG_GetWorstGap(uint8_t task){
+    return (task < WatchdogTaskCount) ? WatchdogTasks[task].worstGap : 0;
+}
+
+uint32_t WATCHDOG_GetTimeouts(const char **lastSite){
+    if(lastSite != NULL)
+        *lastSite = WatchdogTimeoutSite;
+    return WatchdogTimeouts;
+}
+
+WATCHDOG_ResetCause WATCHDOG_GetResetCause(void){
+    if(WatchdogResetCause != WATCHDOG_CAUSE_UNREAD)
+        return (WATCHDOG_ResetCause)WatchdogResetCause;
+
+    // Several flags can be set (A power on also sets PINRSTF, NVIC_SystemReset pulses NRST), so the most specific one wins
+    WatchdogResetFlags = READ_REG(RCC->CSR) & WATCHDOG_RESET_FLAGS;
+    SET_BIT(RCC->CSR, RCC_CSR_RMVF);                        // Clear the flags so the next reset starts fresh
+    if(WatchdogResetFlags & RCC_CSR_LPWRRSTF)
+        WatchdogResetCause = WATCHDOG_RESET_LOW_POWER;
+    else if(WatchdogResetFlags & RCC_CSR_WWDGRSTF)
+        WatchdogResetCause = WATCHDOG_RESET_WWDG;
+    else if(WatchdogResetFlags & RCC_CSR_IWDGRSTF)
+        WatchdogResetCause = WATCHDOG_RESET_IWDG;
+    else if(WatchdogResetFlags & RCC_CSR_SFTRSTF)
+        WatchdogResetCause = WATCHDOG_RESET_SOFTWARE;
+    else if(WatchdogResetFlags & RCC_CSR_PORRSTF)
+        WatchdogResetCause = WATCHDOG_RESET_POWER_ON;
+    else if(WatchdogResetFlags & RCC_CSR_PINRSTF)
+        WatchdogResetCause = WATCHDOG_RESET_PIN;
+    else
+        WatchdogResetCause = WATCHDOG_RESET_UNKNOWN;
+    return (WATCHDOG_ResetCause)WatchdogResetCause;
+}
+
+void WATCHDOG_Report(USART_TypeDef *USARTx){
+    static const char *const names[] = {"unknown", "power on", "pin", "software", "IWDG", "WWDG", "low power"};   // WATCHDOG_ResetCause order
+    WATCHDOG_ResetCause cause = WATCHDOG_GetResetCause();
+
+    char line[WATCHDOG_LINE_SIZE];
+    StringBuilder sb = StringBuilderInit(line, sizeof(line));
+    StringBuilderAppend(&sb, "RESET,");
+    StringBuilderAppend(&sb, names[cause]);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendHex(&sb, WatchdogResetFlags, 8);
+    StringBuilderAppend(&sb, "\r\n");
+    USART_SendBuffer(USARTx, sb.buffer, sb.length);
+
+    if(WatchdogRecord.magic != WATCHDOG_MAGIC || WatchdogRecord.check != WATCHDOG_Checksum(&WatchdogRecord))
+        return;                                             // No late task (An IWDG reset without one means WATCHDOG_Service stopped)
+
+    StringBuilderClear(&sb);
+    StringBuilderAppend(&sb, "WATCHDOG,");
+    StringBuilderAppend(&sb, WatchdogRecord.task);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, WatchdogRecord.gap);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, WatchdogRecord.deadline);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, WatchdogRecord.uptime);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppend(&sb, WatchdogRecord.site);
+    StringBuilderAppendChar(&sb, ',');
+    StringBuilderAppendU32(&sb, WatchdogRecord.timeouts);
+    StringBuilderAppend(&sb, "\r\n");
+    USART_SendBuffer(USARTx, sb.buffer, sb.length);
+
+    WatchdogRecord.magic = 0;
+    WatchdogRecord.check = 0;
+}
+
+bool WATCHDOG_WaitExpired(uint32_t start, uint32_t timeoutUs, const char *site){
+    if(!READ_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk)){      // Stopped counters hold their value, so start stays valid
+        SET_BIT(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);
+        SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);
+    }
+    if(DWT->CYCCNT - start < timeoutUs * (CLOCK_GetSystemClockSpeed() / 1000000))
+        return false;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    WatchdogTimeouts++;
+    WatchdogTimeoutSite = site;
+    __set_PRIMASK(primask);
+    return true;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static void WATCHDOG_SaveRecord(const WATCHDOG_Task_t *task, uint32_t gap, uint32_t now){
+    if(WatchdogRecord.magic == WATCHDOG_MAGIC && WatchdogRecord.check == WATCHDOG_Checksum(&WatchdogRecord))
+        return;                                             // The record from before the last reset was never reported
+
+    WatchdogRecord.magic = WATCHDOG_MAGIC;
+    WATCHDOG_CopyName(WatchdogRecord.task, task->name);
+    WatchdogRecord.gap = gap;
+    WatchdogRecord.deadline = task->deadline;
+    WatchdogRecord.uptime = now;
+    WATCHDOG_CopyName(WatchdogRecord.site, WatchdogTimeoutSite);
+    WatchdogRecord.timeouts = WatchdogTimeouts;
+    WatchdogRecord.check = WATCHDOG_Checksum(&WatchdogRecord);
+}
+
+static uint32_t WATCHDOG_Checksum(const WATCHDOG_Record_t *record){
+    const uint32_t *words = (const uint32_t *)record;
+    uint32_t sum = WATCHDOG_MAGIC;
+    for(uint32_t i = 0; i < sizeof(WATCHDOG_Record_t) / sizeof(uint32_t) - 1; i++)
+        sum = (sum << 1 | sum >> 31) ^ words[i];            // Rotate so swapped words change the checksum
+    return sum;
+}
+
+static void WATCHDOG_CopyName(char *destination, const char *source){
+    uint8_t i = 0;
+    while(source != NULL && i < WATCHDOG_NAME_LENGTH - 1 && source[i] != '\0'){
+        destination[i] = (source[i] == ',') ? ' ' : source[i];     // Keep the report line a valid CSV line
+        i++;
+    }
+    while(i < WATCHDOG_NAME_LENGTH)
+        destination[i++] = '\0';
+}
+#pragma endregion
@@ -13,9 +13,92 @@
  */
 
 #include "ACDC_string.h"
+#ifdef ACDC_THREAD_SAFE
+#include "ACDC_RTOS.h"
+#endif
 
 #define UPPER_TO_LOWER 32   //Number of characters to move to reach a lowercase character from a uppercase character
 #define LOWER_TO_UPPER 32
+#define DIV_100_MAGIC  0x51EB851FULL    // ceil(2^37 / 100), (n * DIV_100_MAGIC) >> 37 == n / 100 for every uint32_t
+#define DIV_100_SHIFT  37
+#define MAX_U32_DIGITS 10               // 4,294,967,295
+#define MAX_DECIMAL_PLACES 9            // 10^9 is the largest power of 10 that fits in a uint32_t
+#define U64_CHUNK_DIVISOR 100000000ULL  // 10^8, uint64_t values are formatted in 8 digit chunks
+#define UINT32_MAX_VALUE    0xFFFFFFFFUL // Largest uint32_t
+#define INT32_MAX_VALUE     0x7FFFFFFFUL // Largest int32_t
+#define INT32_MIN_MAGNITUDE 0x80000000UL // Magnitude of the smallest int32_t (-2,147,483,648)
+
+static const char DigitPairs[201] =     // Two digits per lookup (Index 2*n holds the tens digit of n, 2*n+1 the ones digit)
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const char HexDigits[17] = "0123456789ABCDEF";
+
+static const uint32_t PowersOf10[MAX_U32_DIGITS] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+/// @brief Counts the number of decimal digits needed to represent num (Ex. 0 -> 1, 1234 -> 4)
+/// @param num Number to count the digits of
+/// @return Number of decimal digits in num (1-10)
+static int32_t StringCountDigits(uint32_t num){
+    int32_t digits = 1;
+    while(digits < MAX_U32_DIGITS && num >= PowersOf10[digits])  // Compare against powers of 10 instead of dividing
+        digits++;
+    return digits;
+}
+
+/// @brief Checks if the character c is a decimal digit 0-9
+/// @param c Character to check
+/// @return True if c is 0-9, otherwise false
+static bool StringIsDigit(char c){
+    return (uint8_t)(c - '0') <= 9;     // Characters below '0' wrap around to a large unsigned value
+}
+
+/// @brief Parses decimal digits from the start of str and saturates the result at limit
+/// @param str String to parse
+/// @param length Maximum number of characters to read from str
+/// @param limit Largest value that is allowed (Ex. UINT32_MAX, or 2147483648 for a negative int32_t)
+/// @param value Parsed value, saturated to limit on overflow
+/// @param digits Number of digits that were consumed
+/// @return STRING_PARSE_OK, STRING_PARSE_NO_DIGITS, or STRING_PARSE_OVERFLOW
+static StringParseResult StringParseDigits(const char *str, int32_t length, uint32_t limit, uint32_t *value, int32_t *digits){
+    const uint32_t cutoff = limit / 10;             // Values above cutoff overflow when multiplied by 10
+    const uint32_t cutoffDigit = limit % 10;        // Largest digit that can be added to cutoff (Only 1 divide per parse)
+    StringParseResult result = STRING_PARSE_OK;
+    uint32_t number = 0;
+    int32_t i = 0;
+
+    for(; i < length && StringIsDigit(str[i]); i++){
+        uint32_t digit = str[i] - '0';
+        if(number > cutoff || (number == cutoff && digit > cutoffDigit))
+            result = STRING_PARSE_OVERFLOW;         // Keep consuming digits so the caller can skip the whole number
+        else
+            number = number * 10 + digit;
+    }
+
+    *value = (result == STRING_PARSE_OVERFLOW) ? limit : number;
+    *digits = i;
+    return (i == 0) ? STRING_PARSE_NO_DIGITS : result;
+}
+
+/// @brief Writes exactly numDigits decimal digits of num (zero padded) ending right before end. Does not null terminate.
+/// @param end Pointer to the character after the last digit to write
+/// @param num Number to write
+/// @param numDigits Number of digits to write
+static void StringWriteDigits(char *end, uint32_t num, int32_t numDigits){
+    while(numDigits >= 2){
+        uint32_t quotient = (uint32_t)(((uint64_t)num * DIV_100_MAGIC) >> DIV_100_SHIFT);  // num / 100 without a divide
+        uint32_t pair = (num - quotient * 100) * 2;     // Index of the lowest two digits in DigitPairs
+        *--end = DigitPairs[pair + 1];                  // Ones digit
+        *--end = DigitPairs[pair];                      // Tens digit
+        num = quotient;
+        numDigits -= 2;
+    }
+    if(numDigits)                                       // Odd number of digits, one left to write
+        *--end = DigitPairs[num * 2 + 1];
+}
 
 char* StringCopy(char* dest, const char* source){
     int32_t i = 0;
@@ -44,7 +127,8 @@ int32_t StringCompare(const char *str1, const char *str2){
 
 int32_t StringLength(const char *str){
     int32_t i = 0;                  //Initilize a counter
-    while(str[++i] != '\0'){}   //Increment i when not at the end of the string
+    while(str[i] != '\0')       //Increment i when not at the end of the string (An empty string is 0)
+        i++;
     return i;                   //Return counter
 }
 
@@ -71,12 +155,11 @@ char* StringSubstring(char *str, int32_t index){
     return str + index;
 }
 
-bool StringStartsWith(char *str, const char *compareWith){
-    if(StringLength(str) < StringLength(compareWith))
-        return false;
-    
-    str[StringLength(compareWith)] = '\0';
-    return StringCompare(str, compareWith) == 0;
+bool StringStartsWith(const char *str, const char *compareWith){
+    for(int32_t i = 0; compareWith[i] != '\0'; i++)   // str is left as it is (Ex. a command that is parsed next)
+        if(str[i] != compareWith[i])                    // Also stops at the end of a shorter str
+            return false;
+    return true;
 }
 
 bool StringEndsWith(const char *str, const char* compareWith){
@@ -183,31 +266,350 @@ bool StringIsAlphanumeric(const char* str){
 }
 
 char *StringConvert(int32_t num){
-    // maximum number of characters in a int32_t (-2,147,483,647 -> 2,147,483,647 or 11 chars)
-    static char buffer[12];         // 11 numbers + 1 null terminating bit
+    // maximum number of characters in a int32_t (-2,147,483,648 -> 2,147,483,647 or 11 chars)
+#ifdef ACDC_THREAD_SAFE
+    static char buffers[RTOS_MAX_THREADS + 1][STRING_I32_BUFFER_SIZE];  // One per thread, the last one is shared by interrupts
+    char *buffer = buffers[RTOS_GetThreadIndex()];
+#else
+    static char buffer[STRING_I32_BUFFER_SIZE];     // 11 characters + 1 null terminating character
+#endif
+    StringFormatI32(buffer, num);
+    return buffer;
+}
+
+int32_t StringFormatU32(char *buffer, uint32_t num){
+    int32_t length = StringCountDigits(num);    // Count first so the digits can be written in place (no reversing)
+    StringWriteDigits(buffer + length, num, length);
+    buffer[length] = '\0';
+    return length;
+}
+
+int32_t StringFormatI32(char *buffer, int32_t num){
+    if(num >= 0)
+        return StringFormatU32(buffer, (uint32_t)num);
+
+    buffer[0] = '-';
+    return StringFormatU32(buffer + 1, 0UL - (uint32_t)num) + 1;   // Negate as unsigned so INT32_MIN does not overflow
+}
+
+int32_t StringFormatU64(char *buffer, uint64_t num){
+    if(num <= 0xFFFFFFFFULL)                    // Most values fit in 32 bits, which avoids the 64-bit divide entirely
+        return StringFormatU32(buffer, (uint32_t)num);
+
+    // Split into 8 digit chunks so each chunk can use the 32-bit routine (at most two 64-bit divides)
+    uint64_t upper = num / U64_CHUNK_DIVISOR;
+    uint32_t lower = (uint32_t)(num - upper * U64_CHUNK_DIVISOR);
+    int32_t length;
+
+    if(upper <= 0xFFFFFFFFULL){
+        length = StringFormatU32(buffer, (uint32_t)upper);
+    } else {
+        uint32_t top = (uint32_t)(upper / U64_CHUNK_DIVISOR);
+        uint32_t middle = (uint32_t)(upper - top * U64_CHUNK_DIVISOR);
+        length = StringFormatU32(buffer, top);
+        StringWriteDigits(buffer + length + 8, middle, 8);
+        length += 8;
+    }
+
+    StringWriteDigits(buffer + length + 8, lower, 8);
+    length += 8;
+    buffer[length] = '\0';
+    return length;
+}
+
+int32_t StringFormatI64(char *buffer, int64_t num){
+    if(num >= 0)
+        return StringFormatU64(buffer, (uint64_t)num);
+
+    buffer[0] = '-';
+    return StringFormatU64(buffer + 1, 0ULL - (uint64_t)num) + 1;  // Negate as unsigned so INT64_MIN does not overflow
+}
+
+int32_t StringFormatHex(char *buffer, uint32_t num, uint8_t minDigits){
+    int32_t length = 1;
+    while(length < 8 && (num >> (length * 4)) != 0) // Count the number of nibbles needed
+        length++;
+    if(minDigits > 8)
+        minDigits = 8;
+    if(length < minDigits)
+        length = minDigits;
+
+    for(int32_t i = length - 1; i >= 0; i--){      // Write from the last nibble to the first
+        buffer[i] = HexDigits[num & 0xF];
+        num >>= 4;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+int32_t StringFormatBinary(char *buffer, uint32_t num, uint8_t minDigits){
+    int32_t length = 1;
+    while(length < 32 && (num >> length) != 0)     // Count the number of bits needed
+        length++;
+    if(minDigits > 32)
+        minDigits = 32;
+    if(length < minDigits)
+        length = minDigits;
+
+    for(int32_t i = length - 1; i >= 0; i--){      // Write from the last bit to the first
+        buffer[i] = '0' + (num & 0b1);
+        num >>= 1;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+int32_t StringFormatFixed(char *buffer, int32_t num, uint8_t fractionalBits, uint8_t decimalPlaces){
+    char *str = buffer;
+    uint32_t magnitude = (uint32_t)num;
+    if(num < 0)
+        magnitude = 0UL - magnitude;            // Negate as unsigned so INT32_MIN does not overflow
+
+    if(fractionalBits > 31)
+        fractionalBits = 31;
+    if(decimalPlaces > MAX_DECIMAL_PLACES)
+        decimalPlaces = MAX_DECIMAL_PLACES;
+
+    uint32_t integer = magnitude >> fractionalBits;
+    uint32_t fraction = magnitude & ((1UL << fractionalBits) - 1);
+    uint32_t decimals = 0;
+
+    if(fractionalBits > 0){
+        // Scale the fraction to decimalPlaces digits and round to nearest: (fraction * 10^d + 0.5 LSB) / 2^n
+        uint64_t scaled = (uint64_t)fraction * PowersOf10[decimalPlaces] + (1ULL << (fractionalBits - 1));
+        decimals = (uint32_t)(scaled >> fractionalBits);
+        if(decimals >= PowersOf10[decimalPlaces]){  // Rounding carried into the integer part (Ex. 1.999 -> 2.00)
+            decimals -= PowersOf10[decimalPlaces];
+            integer++;
+        }
+    }
+
+    if(num < 0 && (integer != 0 || decimals != 0))
+        *str++ = '-';                           // A value that rounds to 0 has no sign (Ex. -0.001 -> "0.00")
+    str += StringFormatU32(str, integer);
+    if(decimalPlaces > 0){
+        *str++ = '.';
+        StringWriteDigits(str + decimalPlaces, decimals, decimalPlaces);
+        str += decimalPlaces;
+    }
+    *str = '\0';
+    return str - buffer;
+}
+
+StringParseResult StringParseU32(const char *str, int32_t length, uint32_t *value, int32_t *consumed){
+    int32_t digits;
+    StringParseResult result = StringParseDigits(str, length, UINT32_MAX_VALUE, value, &digits);
+    if(consumed)
+        *consumed = digits;
+    return result;
+}
+
+StringParseResult StringParseI32(const char *str, int32_t length, int32_t *value, int32_t *consumed){
     bool isNeg = false;
-    int strLen = 0;
+    int32_t signLength = 0;
+    if(length > 0 && (str[0] == '-' || str[0] == '+')){
+        isNeg = (str[0] == '-');
+        signLength = 1;
+    }
+
+    uint32_t magnitude;
+    int32_t digits;
+    uint32_t limit = isNeg ? INT32_MIN_MAGNITUDE : INT32_MAX_VALUE;
+    StringParseResult result = StringParseDigits(str + signLength, length - signLength, limit, &magnitude, &digits);
 
-    if(num == 0)                        // If the number is 0
-        return StringCopy(buffer, "0"); // Set dest to 0 and return
-    else if(num < 0){                   // If the number is negative
-        isNeg = true;                   // Set the isNegative variable true
-        num = -num;                     // Temporarily convert it to positive
+    *value = isNeg ? (int32_t)(0UL - magnitude) : (int32_t)magnitude;  // Negate as unsigned so INT32_MIN does not overflow
+    if(consumed)
+        *consumed = (result == STRING_PARSE_NO_DIGITS) ? 0 : signLength + digits;
+    return result;
+}
+
+StringParseResult StringParseHex(const char *str, int32_t length, uint32_t *value, int32_t *consumed){
+    int32_t i = 0;
+    if(length > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))    // Skip the optional prefix
+        i = 2;
+
+    StringParseResult result = STRING_PARSE_OK;
+    uint32_t number = 0;
+    int32_t start = i;
+    for(; i < length; i++){
+        uint8_t nibble;
+        if(StringIsDigit(str[i]))
+            nibble = str[i] - '0';
+        else if(str[i] >= 'A' && str[i] <= 'F')
+            nibble = str[i] - 'A' + 10;
+        else if(str[i] >= 'a' && str[i] <= 'f')
+            nibble = str[i] - 'a' + 10;
+        else
+            break;
+
+        if(number >> 28)                            // The top nibble is in use, shifting would lose data
+            result = STRING_PARSE_OVERFLOW;
+        else
+            number = (number << 4) | nibble;
     }
 
-    while(num != 0){                             // If the remaining number to convert is 0 (no more characters to convert)
-        buffer[strLen++] = "0123456789"[num % 10]; // Grab the next digit in the 1's place
-        num /= 10;                               // Shift the entire number down 1 place (Ex. 1234 -> 123 -> 12 -> 1)
+    if(i == start){                                 // "0x" without any hex digits after it, only the '0' is a number
+        i = (start == 2) ? 1 : 0;
+        result = (start == 2) ? STRING_PARSE_OK : STRING_PARSE_NO_DIGITS;
+        number = 0;
+    }
+
+    *value = (result == STRING_PARSE_OVERFLOW) ? UINT32_MAX_VALUE : number;
+    if(consumed)
+        *consumed = i;
+    return result;
+}
+
+StringParseResult StringParseFixed(const char *str, int32_t length, uint8_t fractionalBits, int32_t *value, int32_t *consumed){
+    if(fractionalBits > 31)
+        fractionalBits = 31;
+
+    bool isNeg = false;
+    int32_t i = 0;
+    if(length > 0 && (str[0] == '-' || str[0] == '+')){
+        isNeg = (str[0] == '-');
+        i = 1;
     }
 
-    if(isNeg)                           // If the number was negative
-        buffer[strLen++] = '-';         // Append the negative sign onto the string
+    const uint32_t limit = isNeg ? INT32_MIN_MAGNITUDE : INT32_MAX_VALUE;   // Largest magnitude of the result
+    uint32_t integer;
+    int32_t integerDigits;
+    StringParseResult result = StringParseDigits(str + i, length - i, UINT32_MAX_VALUE, &integer, &integerDigits);
+    i += integerDigits;
+
+    uint32_t fraction = 0;          // Fractional digits as an integer (Ex. ".25" -> 25)
+    uint32_t fractionScale = 1;     // 10^(number of fractional digits kept) (Ex. ".25" -> 100)
+    int32_t fractionDigits = 0;
+    if(i < length && str[i] == '.' && i + 1 < length && StringIsDigit(str[i + 1])){
+        for(i++; i < length && StringIsDigit(str[i]); i++, fractionDigits++){
+            if(fractionDigits < MAX_DECIMAL_PLACES){ // Digits past 10^-9 are below the resolution of any Qm.n, skip them
+                fraction = fraction * 10 + (str[i] - '0');
+                fractionScale *= 10;
+            }
+        }
+    }
 
-    for(int i = 0; i < strLen/2; i++){  // Reverse the string
-        char temp = buffer[i];
-        buffer[i] = buffer[strLen-i-1];
-        buffer[strLen-i-1] = temp;
+    if(integerDigits == 0 && fractionDigits == 0){
+        *value = 0;
+        if(consumed)
+            *consumed = 0;
+        return STRING_PARSE_NO_DIGITS;
     }
-    buffer[strLen] = '\0';              // Append the null terminating character
-    return buffer;
-}
\ No newline at end of file
+
+    // Convert the decimal fraction into n fractional bits, rounded to nearest (One 64-bit divide per parse)
+    uint32_t fractionBits = (uint32_t)((((uint64_t)fraction << fractionalBits) + (fractionScale >> 1)) / fractionScale);
+    uint64_t magnitude = ((uint64_t)integer << fractionalBits) + fractionBits;
+    if(result == STRING_PARSE_OVERFLOW || magnitude > limit){
+        result = STRING_PARSE_OVERFLOW;
+        magnitude = limit;
+    } else {
+        result = STRING_PARSE_OK;
+    }
+
+    *value = isNeg ? (int32_t)(0UL - (uint32_t)magnitude) : (int32_t)magnitude;
+    if(consumed)
+        *consumed = i;
+    return result;
+}
+
+StringBuilder StringBuilderInit(char *buffer, int32_t capacity){
+    StringBuilder sb = {buffer, capacity, 0, false};
+    if(capacity > 0)
+        buffer[0] = '\0';
+    return sb;
+}
+
+void StringBuilderClear(StringBuilder *sb){
+    sb->length = 0;
+    sb->truncated = false;
+    if(sb->capacity > 0)
+        sb->buffer[0] = '\0';
+}
+
+bool StringBuilderAppend(StringBuilder *sb, const char *str){
+    int32_t i = sb->length;
+    const int32_t last = sb->capacity - 1;      // Last index is reserved for the '\0'
+    while(i < last && *str != '\0')             // Only walks the new characters, never rescans the buffer
+        sb->buffer[i++] = *str++;
+
+    if(sb->capacity > 0)
+        sb->buffer[i] = '\0';
+    sb->length = i;
+    if(*str != '\0')                            // Ran out of room before the end of str
+        sb->truncated = true;
+    return *str == '\0';
+}
+
+bool StringBuilderAppendLength(StringBuilder *sb, const char *str, int32_t length){
+    int32_t space = sb->capacity - 1 - sb->length;
+    bool fits = length <= space;
+    if(!fits){
+        length = (space > 0) ? space : 0;
+        sb->truncated = true;
+    }
+
+    for(int32_t i = 0; i < length; i++)
+        sb->buffer[sb->length + i] = str[i];
+    sb->length += length;
+    if(sb->capacity > 0)
+        sb->buffer[sb->length] = '\0';
+    return fits;
+}
+
+bool StringBuilderAppendChar(StringBuilder *sb, char c){
+    return StringBuilderAppendLength(sb, &c, 1);
+}
+
+bool StringBuilderAppendU32(StringBuilder *sb, uint32_t num){
+    if(sb->capacity - sb->length >= STRING_U32_BUFFER_SIZE){         // Enough room to format straight into the buffer
+        sb->length += StringFormatU32(sb->buffer + sb->length, num);
+        return true;
+    }
+    char temp[STRING_U32_BUFFER_SIZE];
+    return StringBuilderAppendLength(sb, temp, StringFormatU32(temp, num));
+}
+
+bool StringBuilderAppendI32(StringBuilder *sb, int32_t num){
+    if(sb->capacity - sb->length >= STRING_I32_BUFFER_SIZE){
+        sb->length += StringFormatI32(sb->buffer + sb->length, num);
+        return true;
+    }
+    char temp[STRING_I32_BUFFER_SIZE];
+    return StringBuilderAppendLength(sb, temp, StringFormatI32(temp, num));
+}
+
+bool StringBuilderAppendU64(StringBuilder *sb, uint64_t num){
+    if(sb->capacity - sb->length >= STRING_U64_BUFFER_SIZE){
+        sb->length += StringFormatU64(sb->buffer + sb->length, num);
+        return true;
+    }
+    char temp[STRING_U64_BUFFER_SIZE];
+    return StringBuilderAppendLength(sb, temp, StringFormatU64(temp, num));
+}
+
+bool StringBuilderAppendI64(StringBuilder *sb, int64_t num){
+    if(sb->capacity - sb->length >= STRING_I64_BUFFER_SIZE){
+        sb->length += StringFormatI64(sb->buffer + sb->length, num);
+        return true;
+    }
+    char temp[STRING_I64_BUFFER_SIZE];
+    return StringBuilderAppendLength(sb, temp, StringFormatI64(temp, num));
+}
+
+bool StringBuilderAppendHex(StringBuilder *sb, uint32_t num, uint8_t minDigits){
+    if(sb->capacity - sb->length >= STRING_HEX_BUFFER_SIZE){
+        sb->length += StringFormatHex(sb->buffer + sb->length, num, minDigits);
+        return true;
+    }
+    char temp[STRING_HEX_BUFFER_SIZE];
+    return StringBuilderAppendLength(sb, temp, StringFormatHex(temp, num, minDigits));
+}
+
+bool StringBuilderAppendFixed(StringBuilder *sb, int32_t num, uint8_t fractionalBits, uint8_t decimalPlaces){
+    if(sb->capacity - sb->length >= STRING_FIXED_BUFFER_SIZE){
+        sb->length += StringFormatFixed(sb->buffer + sb->length, num, fractionalBits, decimalPlaces);
+        return true;
+    }
+    char temp[STRING_FIXED_BUFFER_SIZE];
+    return StringBuilderAppendLength(sb, temp, StringFormatFixed(temp, num, fractionalBits, decimalPlaces));
+}
@@ -0,0 +1,393 @@
+/**
+ * @file bench_main.c
+ * @author Devin Marx
+ * @brief Entry point of the benchmark firmware (Built with make bench instead of main.c)
+ *
+ * Runs every registered benchmark once and prints the results over USART2 at 115200 baud.
+ * Collect and compare the output with Python_Helper/BENCH_Helper.py
+ *
+ * Self-checks of the timebase, string, scheduler, and telemetry framing code run first and print
+ * "CHECK,name,PASS/FAIL" lines.
+ *
+ * The QEMU build (make qemu-test, ACDC_QEMU) skips the clock setup and the peripheral benchmarks,
+ * prints through semihosting, and ends the QEMU session with the number of failed checks as its exit status.
+ *
+ * @version 0.1
+ * @date 2024-04-02
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "main.h"
+
+#define BENCH_FAST_ITERATIONS 1000  // Iterations for benchmarks that take less than a few microseconds
+#define BENCH_SLOW_ITERATIONS  100  // Iterations for benchmarks that wait on the SPI bus or work on a whole block
+#define CRC32_POLYNOMIAL 0xEDB88320 // Reflected CRC-32 polynomial used by the flash vs RAM kernel
+#define BENCH_DSP_BLOCK_SIZE    64  // Samples per block handed to the CMSIS-DSP kernels
+#define BENCH_FIR_TAPS          16  // Taps of the moving average FIR (arm_fir_q15 needs an even number >= 4)
+#define BENCH_BIQUAD_SECTIONS    2  // 4th order low pass made of two identical biquads
+#define BENCH_DECIMATION         4  // 64 samples in, 16 samples out of the filter pipeline
+#define BENCH_GOERTZEL_TONES     4  // DTMF row tones, run over every 64 sample block
+#define BENCH_GOERTZEL_WINDOW  256  // 4 blocks per detection window at 4kHz (15.6Hz bins)
+#define BENCH_CHECK_READS     1000  // Timebase reads that must never go backwards
+#define BENCH_CHECK_FRAME_CRC 0x4E60 // CRC-16/CCITT-FALSE of the first frame of "123456789" (Type 0x20, sequence 0)
+
+#ifndef ACDC_QEMU
+static LTC1298_t BenchADC;
+#endif
+static char BenchBuffer[STRING_FIXED_BUFFER_SIZE];
+static const char BenchNumber[] = "4294967295";
+static volatile uint64_t BenchSink;   // Keeps results that change from run to run (Time, bus data) out of the checksum
+static uint16_t BenchSamples[BENCH_DSP_BLOCK_SIZE];                           // Fake 12-bit ADC samples (Same on every run)
+static q15_t BenchBlock[BENCH_DSP_BLOCK_SIZE];
+static q15_t BenchFirOutput[BENCH_DSP_BLOCK_SIZE];
+static q15_t BenchFirCoefficients[BENCH_FIR_TAPS];
+static q15_t BenchFirState[BENCH_FIR_TAPS + BENCH_DSP_BLOCK_SIZE - 1];
+static arm_fir_instance_q15 BenchFir;
+static const q15_t BenchBiquadCoefficients[6 * BENCH_BIQUAD_SECTIONS] = {   // Butterworth low pass at fs / 10, scaled by 1/2 (postShift = 1)
+  1106, 0, 2212, 1106, 18727, -6763,
+  1106, 0, 2212, 1106, 18727, -6763
+};
+static q15_t BenchPipelineFirState[BENCH_FIR_TAPS + BENCH_DSP_BLOCK_SIZE - 1];
+static q15_t BenchPipelineBiquadState[4 * BENCH_BIQUAD_SECTIONS];
+static q15_t BenchPipelineDecimateState[BENCH_FIR_TAPS + BENCH_DSP_BLOCK_SIZE - 1];
+static q15_t BenchPipelineBlock[BENCH_DSP_BLOCK_SIZE];
+static FILTER_Pipeline_t BenchPipeline;
+static const uint16_t BenchGoertzelTones[BENCH_GOERTZEL_TONES] = {697, 770, 852, 941};
+static GOERTZEL_Bank_t BenchGoertzel;
+static CLASSIFIER_t BenchClassifier;
+static q7_t BenchFeatures[CLASSIFIER_MAX_WIDTH];
+static ACQUIRE_Block_t BenchAcquireBlock;
+static POOL_t BenchPool;
+static POOL_MEMORY(BenchPoolMemory, 48, 4);
+#ifndef ACDC_QEMU
+static uint8_t BenchTask;
+static volatile uint32_t BenchTaskArg;
+#endif
+static uint32_t BenchCheckOrder[SCHEDULER_QUEUE_SIZE];
+static uint8_t BenchCheckRuns;
+
+/// @brief Sets up the clock and every peripheral used by the benchmarks
+void ACDC_BenchInit(void);
+
+/// @brief Adds every benchmark to the list run by BENCH_RunAll
+void ACDC_BenchRegister(void);
+
+/// @brief Runs the self-checks of the register free code and prints a CHECK line for each
+void ACDC_BenchCheck(void);
+
+/// @brief Same CRC-32 kernel as Bench_CRC32Flash, run from SRAM (Shows the cycles saved by ACDC_RAMFUNC)
+/// @param iteration Current iteration
+/// @return CRC-32 of iteration
+ACDC_RAMFUNC uint32_t Bench_CRC32Ram(uint32_t iteration);
+
+#ifndef ACDC_QEMU
+/// @brief Task run by the scheduler_post_run benchmark
+/// @param arg Iteration it was posted from
+static void Bench_SCHEDULER_Task(uint32_t arg);
+#endif
+
+/// @brief Task of the scheduler check, records the order events run in
+/// @param arg Value it was posted with
+static void Bench_CheckTask(uint32_t arg);
+
+int main(void)
+{
+  ACDC_BenchInit();
+  ACDC_BenchCheck();
+  BENCH_Init();
+  ACDC_BenchRegister();
+
+  BENCH_RunAll(USART2);
+#ifdef ACDC_QEMU
+  BENCH_Exit(BENCH_GetFailedChecks());                                          // make qemu-test fails on a nonzero status
+#endif
+
+  while (1)
+  {
+  }
+}
+
+void ACDC_BenchInit(void){
+#ifdef ACDC_QEMU
+  TIMER_Init(SCS_8MHz);                                                           // QEMU does not model the RCC, stay on the 8MHz HSI
+#else
+  CLOCK_SetSystemClockSpeed(SCS_72MHz);
+  USART_Init(USART2, Serial_115200, true);                                        // Initilize USART2 with a baud of 115200
+  GPIO_PinDirection(GPIOA, GPIO_PIN_5, GPIO_MODE_OUTPUT_SPEED_50MHz, GPIO_CNF_OUTPUT_PUSH_PULL);
+  BenchADC = LTCADC_InitCS(SPI2, GPIOB, GPIO_PIN_12);                              // SPI2 runs at the ADC's 200kHz limit
+#endif
+
+  for(uint16_t i = 0; i < BENCH_DSP_BLOCK_SIZE; i++)
+    BenchSamples[i] = (uint16_t)((i * 2654435761u) >> 20);                       // Spread over the full 12-bit range
+  DSP_SamplesToQ15(BenchSamples, BenchBlock, BENCH_DSP_BLOCK_SIZE);
+
+  for(uint16_t i = 0; i < BENCH_FIR_TAPS; i++)
+    BenchFirCoefficients[i] = 32768 / BENCH_FIR_TAPS;                             // Moving average (1/16 per tap)
+  arm_fir_init_q15(&BenchFir, BENCH_FIR_TAPS, BenchFirCoefficients, BenchFirState, BENCH_DSP_BLOCK_SIZE);
+
+  FILTER_Init(&BenchPipeline, BENCH_DSP_BLOCK_SIZE);                              // Same stages a real acquisition would use
+  FILTER_AddFIR(&BenchPipeline, BenchFirCoefficients, BENCH_FIR_TAPS, BenchPipelineFirState);
+  FILTER_AddBiquad(&BenchPipeline, BenchBiquadCoefficients, BENCH_BIQUAD_SECTIONS, BenchPipelineBiquadState, 1);
+  FILTER_AddDecimator(&BenchPipeline, BenchFirCoefficients, BENCH_FIR_TAPS, BENCH_DECIMATION, BenchPipelineDecimateState);
+
+  GOERTZEL_Init(&BenchGoertzel, 4000, BENCH_GOERTZEL_WINDOW, 0);
+  for(uint8_t i = 0; i < BENCH_GOERTZEL_TONES; i++)
+    GOERTZEL_AddTone(&BenchGoertzel, BenchGoertzelTones[i], 8192);
+
+  CLASSIFIER_Init(&BenchClassifier, &CLASSIFIER_DefaultNetwork);                   // Network in ACDC_CLASSIFIER_WEIGHTS.c
+  for(uint16_t i = 0; i < CLASSIFIER_MAX_WIDTH; i++)
+    BenchFeatures[i] = (q7_t)(BenchBlock[i % BENCH_DSP_BLOCK_SIZE] >> 8);
+  BenchAcquireBlock = (ACQUIRE_Block_t){BenchBlock, BENCH_DSP_BLOCK_SIZE, 0, 0, 250000};
+  POOL_Init(&BenchPool, "bench", BenchPoolMemory, 48, 4);
+
+  SCHEDULER_Init();                                                               // QEMU does not model the DWT, its cycle stats stay 0
+#ifndef ACDC_QEMU
+  BenchTask = SCHEDULER_AddTask("bench", Bench_SCHEDULER_Task, 0);
+  TRACE_Init();                                                                   // Timestamps with the DWT cycle counter too
+#endif
+}
+
+#pragma region BENCHMARKS
+#ifndef ACDC_QEMU
+static uint32_t Bench_GPIO_Toggle(uint32_t iteration){
+  GPIO_Toggle(GPIOA, GPIO_PIN_5);
+  return iteration;
+}
+
+static uint32_t Bench_GPIO_Write(uint32_t iteration){
+  GPIO_Write(GPIOA, GPIO_PIN_5, iteration & 1);
+  return iteration;
+}
+
+static uint32_t Bench_SPI_Transfer(uint32_t iteration){
+  BenchSink = SPI_TransmitReceive(SPI2, (uint16_t)iteration);
+  return iteration;
+}
+
+static uint32_t Bench_LTCADC_ReadCH0(uint32_t iteration){
+  BenchSink = LTCADC_ReadCH0CS(BenchADC);
+  return iteration;
+}
+
+static void Bench_SCHEDULER_Task(uint32_t arg){
+  BenchTaskArg = arg;
+}
+
+static uint32_t Bench_SCHEDULER_PostRun(uint32_t iteration){
+  SCHEDULER_Post(BenchTask, iteration);
+  SCHEDULER_RunOne();
+  return BenchTaskArg;
+}
+
+static uint32_t Bench_TRACE_Write(uint32_t iteration){
+  TRACE("bench %u", iteration, 0);                                                // Never drained, the ring just wraps
+  return iteration;
+}
+#endif
+
+static uint32_t Bench_Millis(uint32_t iteration){
+  BenchSink = Millis();
+  return iteration;
+}
+
+static uint32_t Bench_Micros(uint32_t iteration){
+  BenchSink = Micros();
+  return iteration;
+}
+
+static uint32_t Bench_StringConvert(uint32_t iteration){
+  return (uint32_t)StringLength(StringConvert((int32_t)(iteration * 2654435761u)));
+}
+
+static uint32_t Bench_StringFormatU32(uint32_t iteration){
+  int32_t length = StringFormatU32(BenchBuffer, iteration * 2654435761u);
+  return ((uint32_t)length << 8) | (uint8_t)BenchBuffer[0];
+}
+
+static uint32_t Bench_StringFormatI64(uint32_t iteration){
+  int32_t length = StringFormatI64(BenchBuffer, -(int64_t)iteration * 1000000007LL);
+  return ((uint32_t)length << 8) | (uint8_t)BenchBuffer[length - 1];
+}
+
+static uint32_t Bench_StringFormatHex(uint32_t iteration){
+  int32_t length = StringFormatHex(BenchBuffer, iteration * 2654435761u, 8);
+  return ((uint32_t)length << 8) | (uint8_t)BenchBuffer[7];
+}
+
+static uint32_t Bench_StringFormatFixed(uint32_t iteration){
+  int32_t length = StringFormatFixed(BenchBuffer, (int32_t)(iteration * 2654435761u), 15, 4);
+  return ((uint32_t)length << 8) | (uint8_t)BenchBuffer[length - 1];
+}
+
+static uint32_t Bench_StringParseU32(uint32_t iteration){
+  uint32_t value = 0;
+  StringParseU32(BenchNumber, 1 + (iteration % 10), &value, 0);
+  return value;
+}
+
+static uint32_t Bench_StringBuilderLine(uint32_t iteration){
+  char line[32];
+  StringBuilder sb = StringBuilderInit(line, sizeof(line));
+  StringBuilderAppend(&sb, "CH0,");
+  StringBuilderAppendU32(&sb, iteration);
+  StringBuilderAppendChar(&sb, ',');
+  StringBuilderAppendFixed(&sb, (int32_t)iteration << 4, 15, 3);
+  StringBuilderAppend(&sb, "\r\n");
+  return (uint32_t)sb.length;
+}
+
+static uint32_t Bench_DSP_SamplesToQ15(uint32_t iteration){
+  DSP_SamplesToQ15(BenchSamples, BenchBlock, BENCH_DSP_BLOCK_SIZE);
+  return (uint16_t)BenchBlock[iteration % BENCH_DSP_BLOCK_SIZE];
+}
+
+static uint32_t Bench_DSP_MeanQ15(uint32_t iteration){
+  return (uint16_t)DSP_MeanQ15(BenchBlock, BENCH_DSP_BLOCK_SIZE) ^ iteration;
+}
+
+static uint32_t Bench_DSP_RmsQ15(uint32_t iteration){
+  return (uint16_t)DSP_RmsQ15(BenchBlock, BENCH_DSP_BLOCK_SIZE) ^ iteration;
+}
+
+static uint32_t Bench_DSP_FirQ15(uint32_t iteration){
+  arm_fir_q15(&BenchFir, BenchBlock, BenchFirOutput, BENCH_DSP_BLOCK_SIZE);
+  return (uint16_t)BenchFirOutput[iteration % BENCH_DSP_BLOCK_SIZE];
+}
+
+static uint32_t Bench_FILTER_Pipeline(uint32_t iteration){
+  for(uint16_t i = 0; i < BENCH_DSP_BLOCK_SIZE; i++)
+    BenchPipelineBlock[i] = BenchBlock[i] >> 2;                                   // Keeps the biquad input in [-0.25, +0.25), the pipeline works in place
+  uint32_t length = FILTER_Process(&BenchPipeline, BenchPipelineBlock);
+  return (uint16_t)BenchPipelineBlock[iteration % length];
+}
+
+static uint32_t Bench_GOERTZEL_Block(uint32_t iteration){
+  GOERTZEL_AddSamples(&BenchGoertzel, BenchBlock, BENCH_DSP_BLOCK_SIZE);        // Every 4th call also finishes a window
+  return (uint16_t)GOERTZEL_GetLevel(&BenchGoertzel, iteration % BENCH_GOERTZEL_TONES);
+}
+
+static uint32_t Bench_CLASSIFIER_Run(uint32_t iteration){
+  BenchFeatures[iteration % CLASSIFIER_DefaultNetwork.inputSize] ^= 0x55;       // Different input every run so the result is not cached
+  uint8_t classIndex = CLASSIFIER_Run(&BenchClassifier, BenchFeatures);
+  return ((uint32_t)classIndex << 8) | (uint8_t)CLASSIFIER_GetResult(&BenchClassifier)->scores[classIndex];
+}
+
+static uint32_t Bench_CLASSIFIER_Block(uint32_t iteration){
+  BenchAcquireBlock.firstSample = iteration * BENCH_DSP_BLOCK_SIZE;
+  CLASSIFIER_AddBlock(&BenchClassifier, &BenchAcquireBlock);                      // Finishes a window every windowSize / 64 calls
+  return CLASSIFIER_GetResult(&BenchClassifier)->classIndex;
+}
+
+static uint32_t Bench_POOL_AllocFree(uint32_t iteration){
+  uint8_t *block = POOL_Alloc(32 + (iteration & 15));                              // Size class lookup, then the lock-free pop and push
+  block[0] = (uint8_t)iteration;
+  POOL_Free(block);
+  return (uint32_t)(block - (uint8_t *)BenchPoolMemory);                          // Always the first block (LIFO free list)
+}
+
+/// @brief Bitwise CRC-32 of a 32-bit word, branchy on purpose so flash wait states show up
+/// @param data Word to run through the CRC
+/// @return CRC-32 of data
+static inline __attribute__((always_inline)) uint32_t Bench_CRC32Kernel(uint32_t data){
+  uint32_t crc = ~data;
+  for(uint8_t bit = 0; bit < 32; bit++){
+    if(crc & 1)
+      crc = (crc >> 1) ^ CRC32_POLYNOMIAL;
+    else
+      crc >>= 1;
+  }
+  return ~crc;
+}
+
+static uint32_t Bench_CRC32Flash(uint32_t iteration){
+  return Bench_CRC32Kernel(iteration);
+}
+
+ACDC_RAMFUNC uint32_t Bench_CRC32Ram(uint32_t iteration){
+  return Bench_CRC32Kernel(iteration);
+}
+#pragma endregion
+
+void ACDC_BenchCheck(void){
+  bool passed = true;                                                             // Timebase: never backwards, Millis and Micros agree
+  uint64_t last = Micros();
+  for(uint16_t i = 0; i < BENCH_CHECK_READS; i++){
+    uint64_t now = Micros();
+    passed = passed && now >= last;
+    last = now;
+  }
+  uint64_t startMs = Millis();
+  uint64_t startUs = Micros();
+  Delay_MS(2);
+  uint64_t elapsedMs = Millis() - startMs;
+  uint64_t elapsedUs = Micros() - startUs;
+  passed = passed && elapsedMs >= 2 && elapsedUs + 1000 >= elapsedMs * 1000 && elapsedUs <= (elapsedMs + 1) * 1000;
+  BENCH_Check(USART2, "timebase", passed);
+
+  int32_t value = 0;                                                              // String: edge cases of the formatters and parsers
+  uint32_t unsignedValue = 0;
+  passed = StringFormatU32(BenchBuffer, 4294967295u) == 10 && StringCompare(BenchBuffer, "4294967295") == 0;
+  passed = passed && StringFormatI64(BenchBuffer, INT64_MIN) == 20 && StringCompare(BenchBuffer, "-9223372036854775808") == 0;
+  passed = passed && StringFormatFixed(BenchBuffer, -0x00018000, 16, 2) == 5 && StringCompare(BenchBuffer, "-1.50") == 0;
+  passed = passed && StringParseI32("-2147483648", 11, &value, 0) == STRING_PARSE_OK && value == INT32_MIN;
+  passed = passed && StringParseU32("4294967296", 10, &unsignedValue, 0) == STRING_PARSE_OVERFLOW && unsignedValue == UINT32_MAX;
+  BENCH_Check(USART2, "string", passed);
+
+  uint8_t low = SCHEDULER_AddTask("check_low", Bench_CheckTask, SCHEDULER_PRIORITIES - 1);  // Scheduler: priority order, FIFO, full queue
+  uint8_t high = SCHEDULER_AddTask("check_high", Bench_CheckTask, 0);
+  passed = SCHEDULER_Post(low, 1) && SCHEDULER_Post(low, 2) && SCHEDULER_Post(high, 3);
+  while(SCHEDULER_RunOne()){}
+  passed = passed && BenchCheckRuns == 3 && BenchCheckOrder[0] == 3 && BenchCheckOrder[1] == 1 && BenchCheckOrder[2] == 2;
+  for(uint8_t i = 0; i < SCHEDULER_QUEUE_SIZE; i++)
+    passed = passed && SCHEDULER_Post(low, i);
+  passed = passed && !SCHEDULER_Post(low, SCHEDULER_QUEUE_SIZE);
+  BenchCheckRuns = 0;
+  while(SCHEDULER_RunOne()){}
+  passed = passed && BenchCheckRuns == SCHEDULER_QUEUE_SIZE && BenchCheckOrder[SCHEDULER_QUEUE_SIZE - 1] == SCHEDULER_QUEUE_SIZE - 1;
+  BENCH_Check(USART2, "scheduler", passed);
+
+  uint8_t frame[9 + TELEMETRY_FRAME_OVERHEAD];                                    // Framing: header, payload, and CRC of the first frame
+  passed = TELEMETRY_EncodeFrame(frame, TELEMETRY_STATS_SUMMARY, "123456789", 9) == sizeof(frame);
+  passed = passed && frame[0] == TELEMETRY_SYNC_0 && frame[1] == TELEMETRY_SYNC_1 && frame[2] == TELEMETRY_STATS_SUMMARY;
+  passed = passed && frame[3] == 0 && frame[4] == 9 && frame[5] == 0 && frame[6] == '1' && frame[14] == '9';
+  passed = passed && (frame[15] | (frame[16] << 8)) == BENCH_CHECK_FRAME_CRC;
+  BENCH_Check(USART2, "framing", passed);
+}
+
+void ACDC_BenchRegister(void){
+#ifndef ACDC_QEMU
+  BENCH_Register("gpio_toggle",         Bench_GPIO_Toggle,       BENCH_FAST_ITERATIONS);
+  BENCH_Register("gpio_write",          Bench_GPIO_Write,        BENCH_FAST_ITERATIONS);
+  BENCH_Register("spi_transfer16",      Bench_SPI_Transfer,      BENCH_SLOW_ITERATIONS);
+  BENCH_Register("ltcadc_read_ch0",     Bench_LTCADC_ReadCH0,    BENCH_SLOW_ITERATIONS);
+  BENCH_Register("scheduler_post_run",  Bench_SCHEDULER_PostRun, BENCH_FAST_ITERATIONS);
+  BENCH_Register("trace_write",         Bench_TRACE_Write,       BENCH_FAST_ITERATIONS);
+#endif
+  BENCH_Register("millis",              Bench_Millis,            BENCH_FAST_ITERATIONS);
+  BENCH_Register("micros",              Bench_Micros,            BENCH_FAST_ITERATIONS);
+  BENCH_Register("string_convert",      Bench_StringConvert,     BENCH_FAST_ITERATIONS);
+  BENCH_Register("string_format_u32",   Bench_StringFormatU32,   BENCH_FAST_ITERATIONS);
+  BENCH_Register("string_format_i64",   Bench_StringFormatI64,   BENCH_FAST_ITERATIONS);
+  BENCH_Register("string_format_hex",   Bench_StringFormatHex,   BENCH_FAST_ITERATIONS);
+  BENCH_Register("string_format_fixed", Bench_StringFormatFixed, BENCH_FAST_ITERATIONS);
+  BENCH_Register("string_parse_u32",    Bench_StringParseU32,    BENCH_FAST_ITERATIONS);
+  BENCH_Register("string_builder_line", Bench_StringBuilderLine, BENCH_FAST_ITERATIONS);
+  BENCH_Register("crc32_flash",         Bench_CRC32Flash,        BENCH_FAST_ITERATIONS);
+  BENCH_Register("crc32_ram",           Bench_CRC32Ram,          BENCH_FAST_ITERATIONS);
+  BENCH_Register("pool_alloc_free",     Bench_POOL_AllocFree,    BENCH_FAST_ITERATIONS);
+  BENCH_Register("dsp_to_q15_64",       Bench_DSP_SamplesToQ15,  BENCH_SLOW_ITERATIONS);
+  BENCH_Register("dsp_mean_q15_64",     Bench_DSP_MeanQ15,       BENCH_SLOW_ITERATIONS);
+  BENCH_Register("dsp_rms_q15_64",      Bench_DSP_RmsQ15,        BENCH_SLOW_ITERATIONS);
+  BENCH_Register("dsp_fir_q15_64x16",   Bench_DSP_FirQ15,        BENCH_SLOW_ITERATIONS);
+  BENCH_Register("filter_pipeline_64",  Bench_FILTER_Pipeline,   BENCH_SLOW_ITERATIONS);
+  BENCH_Register("goertzel_4x64",       Bench_GOERTZEL_Block,    BENCH_SLOW_ITERATIONS);
+  BENCH_Register("classifier_run_q7",   Bench_CLASSIFIER_Run,    BENCH_SLOW_ITERATIONS);
+  BENCH_Register("classifier_block_64", Bench_CLASSIFIER_Block,  BENCH_SLOW_ITERATIONS);
+}
+
+static void Bench_CheckTask(uint32_t arg){
+  if(BenchCheckRuns < SCHEDULER_QUEUE_SIZE)
+    BenchCheckOrder[BenchCheckRuns] = arg;
+  BenchCheckRuns++;
+}
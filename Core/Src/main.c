@@ -18,6 +18,17 @@
 /// @param SCS_x System Clock Speed (Ex. SCS_72Mhz, SCS_36Mhz, ...)
 void ACDC_Init(SystemClockSpeed SCS_x);
 
+/// @brief Steps the LED brightness up or down (Scheduler task)
+/// @param arg Unused
+void ACDC_FadeTask(uint32_t arg);
+
+/// @brief Posts a fade step every tick of TIM2 (TIM2 interrupt)
+void ACDC_FadeTick(void);
+
+static uint8_t FadeTask;
+static uint8_t FadeWatch;
+static int8_t FadeIncrement = 10;
+
 /**
   * @brief  The application entry point.
   * @retval int
@@ -27,18 +38,31 @@ int main(void)
   ACDC_Init(SCS_72MHz);
 
   TIMER_PWM_Init(TIM3_CH2_PA7, PWM_MODE_1, 100000);
+
+  SCHEDULER_Init();
+  FadeTask = SCHEDULER_AddTask("fade", ACDC_FadeTask, 2);
+  TIMER_TICK_Init(TIM2, 100, ACDC_FadeTick);                                    // One fade step every 10ms
+
+  WATCHDOG_Init(500);                                                           // Reset if the supervisor stops refreshing for 500ms
+  FadeWatch = WATCHDOG_AddTask("fade", 100);                                    // The fade task runs every 10ms, 100ms late means it is stuck
+  TIMER_TICK_Init(TIM4, 10, WATCHDOG_Service);                                  // Refresh from an interrupt so a stuck task is named in the report
+
+  SCHEDULER_Run();                                                              // Sleeps between steps, never returns
+}
+
+void ACDC_FadeTask(uint32_t arg){
+  (void)arg;
   uint32_t timPeriod = TIMER_PWM_GetPeriod(TIM3_CH2_PA7);
-  int8_t incrementValue = 10;
+  int64_t currVal = TIMER_PWM_GetDuty(TIM3_CH2_PA7);                            // Get the current duty value
+  if(currVal + FadeIncrement <= 0 || currVal + FadeIncrement >= timPeriod)      // If the new value is less than 0 or greator than the period
+    FadeIncrement *= -1;                                                        // Change the incrementation direction
 
-  while (1)
-  {
-    int64_t currVal = TIMER_PWM_GetDuty(TIM3_CH2_PA7);                          // Get the current duty value
-    if(currVal + incrementValue <= 0 || currVal + incrementValue >= timPeriod)  // If the new value is less than 0 or greator than the period
-      incrementValue *= -1;                                                     // Change the incrementation direction
-    
-    TIMER_PWM_SetDuty(TIM3_CH2_PA7, currVal + incrementValue);                  // Set the new value of the LED
-    Delay_MS(10);
-  }
+  TIMER_PWM_SetDuty(TIM3_CH2_PA7, currVal + FadeIncrement);                     // Set the new value of the LED
+  WATCHDOG_CheckIn(FadeWatch);
+}
+
+void ACDC_FadeTick(void){
+  SCHEDULER_Post(FadeTask, 0);
 }
 
 void ACDC_Init(SystemClockSpeed SCS_x){
@@ -46,6 +70,9 @@ void ACDC_Init(SystemClockSpeed SCS_x){
   //APB1 & APB2 Prescalers are set the highest speed in CLOCK_SetSystemClockSpeed
 
   USART_Init(USART2, Serial_115200, true);  // Initilize USART2 with a baud of 115200
+  FAULT_Init(NULL);                         // Save a crash dump on faults and reset
+  WATCHDOG_Report(USART2);                  // Print why the board reset (And the late task if it was the watchdog)
+  FAULT_Report(USART2);                     // Print the crash dump from before the last reset, if there is one
 
   TIMER_PWM_Init(TIM1_CH4_PA11, PWM_MODE_1, 1000000);                         // Needed to drive the ARINC429 Clock
   TIMER_PWM_SetDuty(TIM1_CH4_PA11, TIMER_PWM_GetPeriod(TIM1_CH4_PA11) / 2);   // Set the Duty cycle to 50%
@@ -0,0 +1,161 @@
+from dataclasses import dataclass
+#BENCH Helper
+
+@dataclass
+class BenchResult:
+    name : str
+    iterations : int
+    min_cycles : int
+    avg_cycles : int
+    max_cycles : int
+    checksum : str
+
+@dataclass
+class BenchRun:
+    clock_hz : int
+    cycle_counter_running : bool
+    overhead : int
+    results : dict[str, BenchResult]
+
+def BENCH_Parse_Lines(lines : list[str]) -> BenchRun:
+    """Parses the BENCH_BEGIN, BENCH, and BENCH_END lines printed by BENCH_RunAll (Any other lines are ignored)
+
+    Args:
+        lines (list[str]): Lines read from the serial port or a capture file
+
+    Returns:
+        BenchRun: Clock speed, overhead, and results of every benchmark
+    """
+    run = BenchRun(0, False, 0, {})
+    for line in lines:
+        fields = line.strip().split(",")
+        match fields[0]:
+            case "BENCH_BEGIN" if len(fields) == 4:
+                run.clock_hz = int(fields[1])
+                run.cycle_counter_running = fields[2] == "1"
+                run.overhead = int(fields[3])
+            case "BENCH" if len(fields) == 7:
+                run.results[fields[1]] = BenchResult(fields[1], int(fields[2]), int(fields[3]), int(fields[4]), int(fields[5]), fields[6])
+    return run
+
+def BENCH_Read_File(path : str) -> BenchRun:
+    """Reads a capture file saved by BENCH_Capture_Serial (Or any log of the serial output)
+
+    Args:
+        path (str): Path to the capture file
+
+    Returns:
+        BenchRun: Clock speed, overhead, and results of every benchmark
+    """
+    with open(path, "r") as file:
+        return BENCH_Parse_Lines(file.readlines())
+
+def BENCH_Capture_Serial(port : str, path : str, baud : int = 115200, timeout : float = 30) -> BenchRun:
+    """Reads the benchmark output from the serial port until BENCH_END and saves it to path (Requires pyserial)
+
+    Args:
+        port (str): Serial port of the board (Ex. COM3, /dev/ttyACM0)
+        path (str): File to save the raw output to
+        baud (int): Baud rate of USART2
+        timeout (float): Seconds to wait for the next line before giving up
+
+    Returns:
+        BenchRun: Clock speed, overhead, and results of every benchmark
+    """
+    import serial
+    lines : list[str] = []
+    with serial.Serial(port, baud, timeout=timeout) as ser:
+        while True:
+            line = ser.readline().decode("ascii", errors="replace")
+            if line == "":
+                print("\tTimed out waiting for BENCH_END, saving what was received")
+                break
+            lines.append(line.strip())
+            if line.startswith("BENCH_END"):
+                break
+    with open(path, "w") as file:
+        file.write("\n".join(lines) + "\n")
+    return BENCH_Parse_Lines(lines)
+
+def BENCH_Cycles_To_Us(cycles : int, clock_hz : int) -> float:
+    """Converts a number of core clock cycles to microseconds
+
+    Args:
+        cycles (int): Number of cycles
+        clock_hz (int): Core clock speed in Hz
+
+    Returns:
+        float: Time in microseconds
+    """
+    return cycles * 1e6 / clock_hz if clock_hz else 0.0
+
+def BENCH_Print_Run(run : BenchRun) -> None:
+    print(F"\tClock: {run.clock_hz} Hz, Cycle counter: {'running' if run.cycle_counter_running else 'stopped (only checksums are valid)'}, Overhead: {run.overhead} cycles")
+    print(F"\t{'Benchmark':<24}{'Iter':>8}{'Min':>10}{'Avg':>10}{'Max':>10}{'Avg us':>10}  Checksum")
+    for result in run.results.values():
+        avgUs = BENCH_Cycles_To_Us(result.avg_cycles, run.clock_hz)
+        print(F"\t{result.name:<24}{result.iterations:>8}{result.min_cycles:>10}{result.avg_cycles:>10}{result.max_cycles:>10}{avgUs:>10.2f}  {result.checksum}")
+
+def BENCH_Compare_Runs(base : BenchRun, new : BenchRun, threshold : float = 5.0) -> bool:
+    """Prints the change in average cycles between two runs and flags regressions and checksum mismatches
+
+    Args:
+        base (BenchRun): Run to compare against
+        new (BenchRun): Run to compare
+        threshold (float): Percent increase in average cycles that counts as a regression
+
+    Returns:
+        bool: True if no benchmark regressed and every checksum matched, false otherwise
+    """
+    passed = True
+    compareCycles = base.cycle_counter_running and new.cycle_counter_running
+    print(F"\t{'Benchmark':<24}{'Base':>10}{'New':>10}{'Change':>10}  Status")
+    for name, newResult in new.results.items():
+        baseResult = base.results.get(name)
+        if baseResult is None:
+            print(F"\t{name:<24}{'-':>10}{newResult.avg_cycles:>10}{'-':>10}  NEW")
+            continue
+
+        status = "OK"
+        change = 0.0
+        if baseResult.checksum != newResult.checksum:
+            status = "CHECKSUM MISMATCH"
+            passed = False
+        elif compareCycles and baseResult.avg_cycles:
+            change = (newResult.avg_cycles - baseResult.avg_cycles) * 100 / baseResult.avg_cycles
+            if change > threshold:
+                status = "REGRESSION"
+                passed = False
+        print(F"\t{name:<24}{baseResult.avg_cycles:>10}{newResult.avg_cycles:>10}{change:>9.1f}%  {status}")
+
+    for name in base.results.keys() - new.results.keys():
+        print(F"\t{name:<24}{base.results[name].avg_cycles:>10}{'-':>10}{'-':>10}  MISSING")
+    return passed
+
+def main():
+    value = input("\n1. Capture a benchmark run from the serial port\n" +
+                    "2. Print a saved benchmark run\n" +
+                    "3. Compare two saved benchmark runs\n" +
+                    "Please Select an option: ")
+
+    match value:
+        case "1":
+            port = input("\tPlease enter the serial port (Ex. COM3, /dev/ttyACM0): ")
+            path = input("\tPlease enter the file to save the run to: ")
+            BENCH_Print_Run(BENCH_Capture_Serial(port, path))
+        case "2":
+            path = input("\tPlease enter the saved run: ")
+            BENCH_Print_Run(BENCH_Read_File(path))
+        case "3":
+            basePath = input("\tPlease enter the baseline run: ")
+            newPath = input("\tPlease enter the new run: ")
+            threshold = float(input("\tPlease enter the regression threshold in percent: ") or 5.0)
+            if BENCH_Compare_Runs(BENCH_Read_File(basePath), BENCH_Read_File(newPath), threshold):
+                print("\t\tNo regressions")
+            else:
+                print("\t\tRegressions found!")
+        case _:
+            print("You have entered in an incorrect value!")
+
+if __name__ == "__main__":
+    main()
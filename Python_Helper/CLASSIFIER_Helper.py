@@ -0,0 +1,314 @@
+import argparse
+import numpy as np
+#CLASSIFIER Helper
+
+OUTPUT_FILE : str = "Core/Src/ACDC_CLASSIFIER_WEIGHTS.c"
+CLASSIFIER_MAX_WIDTH : int = 64     # Widest layer ACDC_CLASSIFIER supports (Must match CLASSIFIER_MAX_WIDTH in ACDC_CLASSIFIER.h)
+CLASSIFIER_MAX_CLASSES : int = 16   # Most classes (Must match CLASSIFIER_MAX_CLASSES in ACDC_CLASSIFIER.h)
+DEMO_CLASSES : list[str] = ["normal", "clipped", "spike", "dropout"]
+
+def CLASSIFIER_Features(windows : np.ndarray, inputSize : int, inputShift : int) -> np.ndarray:
+    """Turns q15 sample windows into q7 features exactly like CLASSIFIER_AddBlock does
+
+    Each feature is the mean of windowSize / inputSize samples (Floored with a shift), the mean of the features
+    is removed, and the result is shifted down to q7 and saturated.
+
+    Args:
+        windows (np.ndarray): q15 samples, one window per row (windowSize columns)
+        inputSize (int): Features per window (Power of 2)
+        inputShift (int): Right shift from q15 to q7
+
+    Returns:
+        np.ndarray: q7 features, one row per window
+    """
+    windowSize = windows.shape[1]
+    groupShift = (windowSize // inputSize).bit_length() - 1
+    averages = windows.astype(np.int64).reshape(len(windows), inputSize, -1).sum(axis=2) >> groupShift
+    mean = averages.sum(axis=1, keepdims=True) >> (inputSize.bit_length() - 1)
+    return np.clip((averages - mean) >> inputShift, -128, 127).astype(np.int64)
+
+def CLASSIFIER_Synthetic(count : int, windowSize : int, rng : np.random.Generator) -> tuple[np.ndarray, np.ndarray]:
+    """Makes q15 windows of a sine with one of the demo fault signatures (See DEMO_CLASSES)
+
+    Args:
+        count (int): Number of windows
+        windowSize (int): Samples per window
+        rng (np.random.Generator): Random number generator
+
+    Returns:
+        tuple[np.ndarray, np.ndarray]: q15 windows (count x windowSize) and their class numbers
+    """
+    labels = rng.integers(0, len(DEMO_CLASSES), count)
+    t = np.arange(windowSize)
+    windows = np.zeros((count, windowSize))
+    for i, label in enumerate(labels):
+        amplitude = rng.uniform(0.15, 0.8)
+        offset = rng.uniform(-0.15, 0.15)
+        wave = amplitude * np.sin(2 * np.pi * rng.uniform(1.5, 6) * t / windowSize + rng.uniform(0, 2 * np.pi))
+        if DEMO_CLASSES[label] == "clipped":
+            wave = np.clip(wave * rng.uniform(2, 4), -amplitude, amplitude)
+        elif DEMO_CLASSES[label] == "spike":
+            start = rng.integers(0, windowSize - 4)
+            wave[start : start + rng.integers(2, 5)] += rng.choice([-1, 1]) * rng.uniform(0.5, 1)
+        elif DEMO_CLASSES[label] == "dropout":
+            start = rng.integers(0, windowSize // 2)
+            wave[start : start + rng.integers(windowSize // 8, windowSize // 2)] = 0
+        windows[i] = np.clip((offset + wave + rng.normal(0, 0.01, windowSize)) * 32768, -32768, 32767)
+    return windows.astype(np.int64), labels
+
+def CLASSIFIER_Train(features : np.ndarray, labels : np.ndarray, sizes : list[int], epochs : int, decay : float, rng : np.random.Generator) -> tuple[list[np.ndarray], list[np.ndarray]]:
+    """Trains a float ReLU network on q7 features (AdamW, softmax cross entropy, full batch)
+
+    Args:
+        features (np.ndarray): q7 features, one row per window
+        labels (np.ndarray): Class number of each window
+        sizes (list[int]): Width of every layer, from the features to the classes (Ex. [32, 16, 16, 4])
+        epochs (int): Training steps
+        decay (float): Decoupled weight decay (AdamW)
+        rng (np.random.Generator): Random number generator (Initial weights)
+
+    Returns:
+        tuple[list[np.ndarray], list[np.ndarray]]: Weights (outputs x inputs) and biases of every layer
+    """
+    x = features / 128.0
+    target = np.eye(sizes[-1])[labels]
+    weights = [rng.normal(0, np.sqrt(2 / sizes[i]), (sizes[i + 1], sizes[i])) for i in range(len(sizes) - 1)]
+    biases = [np.zeros(size) for size in sizes[1:]]
+    params = weights + biases
+    moments = [np.zeros_like(p) for p in params]
+    squares = [np.zeros_like(p) for p in params]
+    for step in range(1, epochs + 1):
+        activations = [x]
+        for layer in range(len(weights)):
+            out = activations[-1] @ weights[layer].T + biases[layer]
+            activations.append(np.maximum(out, 0) if layer < len(weights) - 1 else out)
+        probabilities = np.exp(activations[-1] - activations[-1].max(axis=1, keepdims=True))
+        probabilities /= probabilities.sum(axis=1, keepdims=True)
+
+        error = (probabilities - target) / len(x)
+        gradWeights, gradBiases = [None] * len(weights), [None] * len(weights)
+        for layer in reversed(range(len(weights))):
+            gradWeights[layer] = error.T @ activations[layer]
+            gradBiases[layer] = error.sum(axis=0)
+            error = (error @ weights[layer]) * (activations[layer] > 0)
+        for p, g, m, v in zip(params, gradWeights + gradBiases, moments, squares):
+            p *= 1 - 0.01 * decay     # Weight decay keeps the ranges small, so the q7 scales stay fine
+            m *= 0.9
+            m += 0.1 * g
+            v *= 0.999
+            v += 0.001 * g * g
+            p -= 0.01 * (m / (1 - 0.9 ** step)) / (np.sqrt(v / (1 - 0.999 ** step)) + 1e-8)
+    return weights, biases
+
+def CLASSIFIER_Run_Float(weights : list[np.ndarray], biases : list[np.ndarray], features : np.ndarray) -> list[np.ndarray]:
+    """Runs the float network
+
+    Returns:
+        list[np.ndarray]: Output of every layer (After the ReLU for hidden layers)
+    """
+    activations = [features / 128.0]
+    for layer in range(len(weights)):
+        out = activations[-1] @ weights[layer].T + biases[layer]
+        activations.append(np.maximum(out, 0) if layer < len(weights) - 1 else out)
+    return activations[1:]
+
+def CLASSIFIER_Frac_Bits(values : np.ndarray) -> int:
+    """Most fractional bits a q7 value can have and still hold every value
+
+    Args:
+        values (np.ndarray): Float values
+
+    Returns:
+        int: Fractional bits (7 for values inside +-1, less for larger values, more for smaller ones)
+    """
+    largest = float(np.max(np.abs(values)))
+    return 7 if largest == 0 else int(np.floor(np.log2(127.5 / largest)))
+
+def CLASSIFIER_Quantize(weights : list[np.ndarray], biases : list[np.ndarray], features : np.ndarray) -> list[dict]:
+    """Quantizes a float network to q7 with power of 2 scales (The CMSIS-NN arm_fully_connected_q7 format)
+
+    The features are q7 with 7 fractional bits. Every layer gets its own weight, bias, and output fractional bits
+    (The output bits are picked from the largest output seen on the features). arm_fully_connected_q7 then needs
+    biasShift = input + weight - bias bits, and outShift = input + weight - output bits.
+
+    Args:
+        weights (list[np.ndarray]): Weights (outputs x inputs) of every layer
+        biases (list[np.ndarray]): Biases of every layer
+        features (np.ndarray): q7 features used to pick the output ranges
+
+    Returns:
+        list[dict]: One dict per layer with q7 weights, q7 bias, biasShift, outShift, and relu
+    """
+    outputs = CLASSIFIER_Run_Float(weights, biases, features)
+    layers : list[dict] = []
+    inputBits = 7
+    for layer in range(len(weights)):
+        weightBits = CLASSIFIER_Frac_Bits(weights[layer])
+        biasBits = min(CLASSIFIER_Frac_Bits(biases[layer]), inputBits + weightBits)
+        outputBits = min(CLASSIFIER_Frac_Bits(outputs[layer]), inputBits + weightBits - 1)    # outShift of at least 1 (NN_ROUND)
+        layers.append({
+            "weights": np.clip(np.round(weights[layer] * 2.0 ** weightBits), -128, 127).astype(np.int64),
+            "bias": np.clip(np.round(biases[layer] * 2.0 ** biasBits), -128, 127).astype(np.int64),
+            "biasShift": inputBits + weightBits - biasBits,
+            "outShift": inputBits + weightBits - outputBits,
+            "relu": layer < len(weights) - 1,
+        })
+        inputBits = outputBits
+    return layers
+
+def CLASSIFIER_Run_Quantized(layers : list[dict], features : np.ndarray) -> np.ndarray:
+    """Runs the q7 network exactly like arm_fully_connected_q7 and arm_relu_q7 do on the Cortex-M3
+
+    Args:
+        layers (list[dict]): Layers from CLASSIFIER_Quantize
+        features (np.ndarray): q7 features, one row per window
+
+    Returns:
+        np.ndarray: q7 outputs of the last layer, one row per window
+    """
+    values = features.astype(np.int64)
+    for layer in layers:
+        accumulator = values @ layer["weights"].T + (layer["bias"] << layer["biasShift"]) + (1 << (layer["outShift"] - 1))
+        values = np.clip(accumulator >> layer["outShift"], -128, 127)
+        if layer["relu"]:
+            values = np.maximum(values, 0)
+    return values
+
+def CLASSIFIER_Format_Array(name : str, values : np.ndarray, rowLength : int) -> str:
+    lines = [F"static const q7_t {name}[{values.size}] = {{"]
+    flat = values.flatten()
+    for start in range(0, flat.size, rowLength):
+        lines.append("    " + ", ".join(F"{value:4d}" for value in flat[start : start + rowLength]) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+def CLASSIFIER_Write_Weights(outputPath : str, layers : list[dict], windowSize : int, inputShift : int, classNames : list[str], accuracy : float) -> None:
+    """Writes the network as ACDC_CLASSIFIER_WEIGHTS.c
+
+    Args:
+        outputPath (str): Path of the C file to write
+        layers (list[dict]): Layers from CLASSIFIER_Quantize
+        windowSize (int): Samples per window
+        inputShift (int): Right shift from q15 to q7 used for the features
+        classNames (list[str]): Name of every class
+        accuracy (float): Accuracy of the q7 network on the test windows (Written in the file comment)
+    """
+    sizes = [layers[0]["weights"].shape[1]] + [layer["weights"].shape[0] for layer in layers]
+    if max(sizes) > CLASSIFIER_MAX_WIDTH or len(classNames) != sizes[-1] or sizes[-1] > CLASSIFIER_MAX_CLASSES:
+        raise ValueError(F"Network {sizes} with {len(classNames)} class names does not fit ACDC_CLASSIFIER")
+
+    arrays, entries = [], []
+    for number, layer in enumerate(layers):
+        arrays.append(CLASSIFIER_Format_Array(F"CLASSIFIER_Weights{number}", layer["weights"], layer["weights"].shape[1] if layer["weights"].shape[1] <= 16 else 16))
+        arrays.append(CLASSIFIER_Format_Array(F"CLASSIFIER_Bias{number}", layer["bias"], 16))
+        entries.append(F"    {{CLASSIFIER_Weights{number}, CLASSIFIER_Bias{number}, {sizes[number]}, {sizes[number + 1]}, "
+                       F"{layer['biasShift']}, {layer['outShift']}, {'true' if layer['relu'] else 'false'}}},")
+    names = ", ".join(F"\"{name}\"" for name in classNames)
+    flash = sum(layer["weights"].size + layer["bias"].size for layer in layers)
+    arrayText = "\n\n".join(arrays)
+    entryText = "\n".join(entries)
+
+    with open(outputPath, "w") as file:
+        file.write(F"""/**
+ * @file ACDC_CLASSIFIER_WEIGHTS.c
+ * @author Devin Marx
+ * @brief Default network for ACDC_CLASSIFIER (GENERATED by Python_Helper/CLASSIFIER_Helper.py, do not edit)
+ *
+ * {" -> ".join(str(size) for size in sizes)} fully connected q7 network ({flash} bytes of flash) that sorts {windowSize} sample windows
+ * into {", ".join(classNames)}. The q7 network matched {accuracy * 100:.1f}% of the test windows.
+ *
+ * @version 0.1
+ * @date 2024-04-24
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_CLASSIFIER.h"
+
+{arrayText}
+
+static const CLASSIFIER_Layer_t CLASSIFIER_Layers[{len(layers)}] = {{
+{entryText}
+}};
+
+static const char * const CLASSIFIER_ClassNames[{len(classNames)}] = {{{names}}};
+
+const CLASSIFIER_Network_t CLASSIFIER_DefaultNetwork = {{
+    CLASSIFIER_Layers, {len(layers)}, {windowSize}, {sizes[0]}, {inputShift}, CLASSIFIER_ClassNames
+}};
+""")
+    print(F"\tWrote {outputPath} ({flash} bytes of weights)")
+
+def CLASSIFIER_Demo(savePath : str, windowSize : int, sizes : list[int], inputShift : int, epochs : int, decay : float, seed : int) -> None:
+    """Trains the demo network on synthetic fault signatures and saves it for CLASSIFIER_Export
+
+    Args:
+        savePath (str): .npz file to write
+        windowSize (int): Samples per window
+        sizes (list[int]): Width of every layer, from the features to the classes
+        inputShift (int): Right shift from q15 to q7 for the features
+        epochs (int): Training steps
+        decay (float): Weight decay
+        seed (int): Random seed
+    """
+    rng = np.random.default_rng(seed)
+    windows, labels = CLASSIFIER_Synthetic(20000, windowSize, rng)
+    features = CLASSIFIER_Features(windows, sizes[0], inputShift)
+    weights, biases = CLASSIFIER_Train(features, labels, sizes, epochs, decay, rng)
+    print(F"\tFloat accuracy on the training windows: {np.mean(CLASSIFIER_Run_Float(weights, biases, features)[-1].argmax(axis=1) == labels) * 100:.1f}%")
+
+    arrays = {F"W{layer}": weights[layer] for layer in range(len(weights))}
+    arrays.update({F"b{layer}": biases[layer] for layer in range(len(biases))})
+    np.savez(savePath, windowSize=windowSize, inputShift=inputShift, classNames=np.array(DEMO_CLASSES), features=features, labels=labels, **arrays)
+    print(F"\tSaved {savePath}")
+
+def CLASSIFIER_Export(loadPath : str, outputPath : str, seed : int) -> None:
+    """Quantizes a saved float network and writes it as C
+
+    The .npz holds W0, b0, W1, b1, ... (Weights are outputs x inputs, the input is q7 features / 128),
+    windowSize, inputShift, classNames, and the q7 features and labels it was trained on (Used to pick
+    the output ranges). Accuracy is checked on new synthetic windows when the classes are the demo classes,
+    otherwise on the saved features.
+
+    Args:
+        loadPath (str): .npz file to read
+        outputPath (str): Path of the C file to write
+        seed (int): Random seed for the test windows
+    """
+    data = np.load(loadPath)
+    layerCount = len([key for key in data.files if key.startswith("W")])
+    weights = [data[F"W{layer}"] for layer in range(layerCount)]
+    biases = [data[F"b{layer}"] for layer in range(layerCount)]
+    windowSize, inputShift = int(data["windowSize"]), int(data["inputShift"])
+    classNames = [str(name) for name in data["classNames"]]
+    layers = CLASSIFIER_Quantize(weights, biases, data["features"])
+
+    features, labels = data["features"], data["labels"]
+    if classNames == DEMO_CLASSES:
+        windows, labels = CLASSIFIER_Synthetic(2000, windowSize, np.random.default_rng(seed + 1))
+        features = CLASSIFIER_Features(windows, weights[0].shape[1], inputShift)
+    floatAccuracy = np.mean(CLASSIFIER_Run_Float(weights, biases, features)[-1].argmax(axis=1) == labels)
+    quantizedAccuracy = np.mean(CLASSIFIER_Run_Quantized(layers, features).argmax(axis=1) == labels)
+    print(F"\tTest accuracy: float {floatAccuracy * 100:.1f}%, q7 {quantizedAccuracy * 100:.1f}%")
+    for number, layer in enumerate(layers):
+        print(F"\tLayer {number}: biasShift {layer['biasShift']}, outShift {layer['outShift']}")
+    CLASSIFIER_Write_Weights(outputPath, layers, windowSize, inputShift, classNames, quantizedAccuracy)
+
+def main():
+    parser = argparse.ArgumentParser(description="Exports q7 weights for ACDC_CLASSIFIER (Run from the repository root)")
+    parser.add_argument("network", help=".npz file with the float network (Written first when --demo is given)")
+    parser.add_argument("--demo", action="store_true", help="Train the demo network on synthetic fault signatures and save it to network")
+    parser.add_argument("--window", type=int, default=64, help="Samples per window for --demo (Power of 2)")
+    parser.add_argument("--sizes", type=int, nargs="+", default=[64, 16, 16, len(DEMO_CLASSES)], help="Layer widths for --demo, features first")
+    parser.add_argument("--shift", type=int, default=7, help="Right shift from q15 samples to q7 features for --demo")
+    parser.add_argument("--epochs", type=int, default=3000, help="Training steps for --demo")
+    parser.add_argument("--decay", type=float, default=0.1, help="Weight decay for --demo")
+    parser.add_argument("--seed", type=int, default=1, help="Random seed")
+    parser.add_argument("--output", default=OUTPUT_FILE, help="C file to write")
+    args = parser.parse_args()
+    if args.demo:
+        CLASSIFIER_Demo(args.network, args.window, args.sizes, args.shift, args.epochs, args.decay, args.seed)
+    CLASSIFIER_Export(args.network, args.output, args.seed)
+
+if __name__ == "__main__":
+    main()
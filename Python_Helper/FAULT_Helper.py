@@ -0,0 +1,172 @@
+import argparse
+import subprocess
+from dataclasses import dataclass, field
+#FAULT Helper
+
+REGISTER_NAMES : list[str] = ["r0", "r1", "r2", "r3", "r12", "lr", "pc", "xpsr", "sp", "exc_return"]
+
+# Configurable Fault Status Register bits (MMFSR 0-7, BFSR 8-15, UFSR 16-31) {See PM-4.4.15}
+CFSR_BITS : dict[int, str] = {
+    0 : "IACCVIOL: instruction fetch from a region the MPU forbids",
+    1 : "DACCVIOL: data access to a region the MPU forbids",
+    3 : "MUNSTKERR: MemManage fault returning from an exception (unstacking)",
+    4 : "MSTKERR: MemManage fault entering an exception (stacking)",
+    8 : "IBUSERR: bus fault on an instruction fetch",
+    9 : "PRECISERR: bus fault on a data access, pc is the instruction",
+    10 : "IMPRECISERR: bus fault on a buffered write, pc is after the instruction",
+    11 : "UNSTKERR: bus fault returning from an exception (unstacking)",
+    12 : "STKERR: bus fault entering an exception (stacking, stack overflow?)",
+    16 : "UNDEFINSTR: undefined instruction",
+    17 : "INVSTATE: Thumb bit clear (Called a function pointer without bit 0 set?)",
+    18 : "INVPC: bad EXC_RETURN on exception return",
+    19 : "NOCP: coprocessor instruction (No FPU on the Cortex-M3)",
+    24 : "UNALIGNED: unaligned access with UNALIGN_TRP set, or an unaligned LDM/STM/LDRD",
+    25 : "DIVBYZERO: division by zero with DIV_0_TRP set",
+}
+MMARVALID : int = 1 << 7
+BFARVALID : int = 1 << 15
+
+HFSR_BITS : dict[int, str] = {
+    1 : "VECTTBL: bus fault reading the vector table",
+    30 : "FORCED: a MemManage, BusFault, or UsageFault escalated (Disabled or at a blocked priority)",
+    31 : "DEBUGEVT: debug event with the debugger detached (BKPT?)",
+}
+
+@dataclass
+class FaultReport:
+    name : str = ""
+    exception : int = 0
+    count : int = 0
+    uptime : int = 0                    # ms
+    registers : dict[str, int] = field(default_factory=dict)
+    cfsr : int = 0
+    hfsr : int = 0
+    mmfar : int = 0
+    bfar : int = 0
+    backtrace : list[int] = field(default_factory=list)
+
+def FAULT_Parse_Lines(lines : list[str]) -> list[FaultReport]:
+    """Finds the FAULT lines FAULT_Report printed in a log (Anything else in it is skipped)
+
+    Args:
+        lines (list[str]): Lines of text read from the USART
+
+    Returns:
+        list[FaultReport]: Every crash report in the log, oldest first
+    """
+    reports : list[FaultReport] = []
+    for line in lines:
+        fields = line.strip().split(",")
+        if fields[0] == "FAULT" and len(fields) == 5:
+            reports.append(FaultReport(fields[1], int(fields[2]), int(fields[3]), int(fields[4])))
+        elif not reports:
+            continue
+        elif fields[0] == "FAULT_REGS" and len(fields) == len(REGISTER_NAMES) + 1:
+            reports[-1].registers = dict(zip(REGISTER_NAMES, (int(value, 16) for value in fields[1:])))
+        elif fields[0] == "FAULT_STATUS" and len(fields) == 5:
+            reports[-1].cfsr, reports[-1].hfsr, reports[-1].mmfar, reports[-1].bfar = (int(value, 16) for value in fields[1:])
+        elif fields[0] == "FAULT_STACK":
+            reports[-1].backtrace = [int(value, 16) for value in fields[1:] if value]
+    return reports
+
+def FAULT_Locate(addr2line : str, elf : str, addresses : list[int]) -> list[str]:
+    """Turns code addresses into function names and source lines with addr2line
+
+    Args:
+        addr2line (str): addr2line program for the ELF (Ex. arm-none-eabi-addr2line)
+        elf (str): ELF of the build that crashed
+        addresses (list[int]): Code addresses to look up
+
+    Returns:
+        list[str]: "function (file:line)" for each address, with the functions it was inlined into after "<-"
+    """
+    output = subprocess.run([addr2line, "-e", elf, "-f", "-C", "-i", "-a"] + [F"0x{address:08x}" for address in addresses],
+                            capture_output=True, text=True, check=True).stdout.splitlines()
+    frames : list[list[str]] = []
+    for line in output:
+        if line.startswith("0x"):                                   # -a prints each address before its function/line pairs
+            frames.append([])
+        elif frames:
+            frames[-1].append(line)
+    return [" <- ".join(F"{lines[i]} ({lines[i + 1]})" for i in range(0, len(lines) - 1, 2)) for lines in frames]
+
+def FAULT_Print(report : FaultReport, elf : str | None, addr2line : str) -> None:
+    """Prints a crash report with the status bits spelled out, and the code addresses located in the ELF if one is given
+
+    Args:
+        report (FaultReport): Report from FAULT_Parse_Lines
+        elf (str | None): ELF of the build that crashed (None to print the addresses only)
+        addr2line (str): addr2line program for the ELF
+    """
+    print(F"{report.name} (exception {report.exception}) after {report.uptime / 1000:.3f}s" + (F", {report.count - 1} more fault(s) before the report" if report.count > 1 else ""))
+    registers = report.registers
+    if not registers.get("pc"):
+        print("\tNo exception frame (The stack could not be read)")
+    excReturn = registers.get("exc_return", 0)
+    print(F"\tStack: {'PSP' if excReturn & 0x4 else 'MSP'}, {'thread' if excReturn & 0x8 else 'handler'} mode")
+    print("\t" + "  ".join(F"{name}={value:08X}" for name, value in registers.items()))
+
+    for bits, status in ((CFSR_BITS, report.cfsr), (HFSR_BITS, report.hfsr)):
+        for bit, meaning in bits.items():
+            if status & (1 << bit):
+                print(F"\t{meaning}")
+    if report.cfsr & MMARVALID:
+        print(F"\tMemManage address: 0x{report.mmfar:08X}")
+    if report.cfsr & BFARVALID:
+        print(F"\tBus fault address: 0x{report.bfar:08X}")
+
+    # Return addresses point after the call, so the call itself is looked up (1 byte back stays inside the bl)
+    addresses = [registers.get("pc", 0)] + [address & ~1 for address in [registers.get("lr", 0)] + report.backtrace]
+    lookups = addresses[:1] + [address - 1 for address in addresses[1:]]
+    labels = ["pc", "lr"] + [F"#{i}" for i in range(len(report.backtrace))]
+    locations = FAULT_Locate(addr2line, elf, lookups) if elf else [""] * len(addresses)
+    print("\tBacktrace (pc, lr, then return addresses found on the stack, innermost first. Some may be stale):")
+    for label, address, location in zip(labels, addresses, locations):
+        print(F"\t{label:>4} 0x{address:08X} {location}")
+
+def FAULT_Read_Serial(port : str, baud : int = 115200) -> list[str]:
+    """Reads lines from the serial port until the first crash report is complete or Ctrl+C (Requires pyserial)
+
+    Args:
+        port (str): Serial port of the board (Ex. COM3, /dev/ttyACM0)
+        baud (int): Baud rate of the USART FAULT_Report prints to
+
+    Returns:
+        list[str]: Lines read
+    """
+    import serial
+    lines : list[str] = []
+    try:
+        with serial.Serial(port, baud, timeout=1) as ser:
+            while not lines or not lines[-1].startswith("FAULT_STACK"):
+                line = ser.readline().decode("ascii", "replace")
+                if line:
+                    lines.append(line)
+    except KeyboardInterrupt:
+        pass
+    return lines
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodes the crash reports ACDC_FAULT prints at boot")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="Serial port to read from (Reset the board after starting)")
+    source.add_argument("--file", help="Log of the USART output")
+    parser.add_argument("--elf", help="build/<target>.elf of the build that crashed (To print function names and lines)")
+    parser.add_argument("--addr2line", default="arm-none-eabi-addr2line")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    if args.port:
+        lines = FAULT_Read_Serial(args.port, args.baud)
+    else:
+        with open(args.file, "r", errors="replace") as file:
+            lines = file.readlines()
+
+    reports = FAULT_Parse_Lines(lines)
+    if not reports:
+        print("No FAULT lines found")
+    for report in reports:
+        FAULT_Print(report, args.elf, args.addr2line)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,239 @@
+import argparse
+import os
+import re
+import subprocess
+from dataclasses import dataclass, field
+from BENCH_Helper import BenchRun, BENCH_Read_File
+#MAP Helper
+
+FLASH_SIZE : int = 127 * 1024   # STM32F103RB Flash, less the last 1K page the linker keeps for ACDC_CALIBRATION
+RAM_SIZE : int = 20 * 1024      # STM32F103RB SRAM
+
+# Output sections in STM32F103RBTx_FLASH.ld and the column they are counted in
+SECTION_KINDS : dict[str, str] = {
+    ".isr_vector" : "text", ".text" : "text", ".ARM.extab" : "text", ".ARM" : "text",
+    ".preinit_array" : "text", ".init_array" : "text", ".fini_array" : "text",
+    ".rodata" : "rodata", ".data" : "data", ".bss" : "bss", ".noinit" : "bss", "._user_heap_stack" : "stack",
+}
+
+@dataclass
+class ModuleSize:
+    text : int = 0
+    rodata : int = 0
+    data : int = 0
+    ramfunc : int = 0
+    bss : int = 0
+    stack : int = 0
+
+    def Flash(self) -> int:
+        return self.text + self.rodata + self.data + self.ramfunc   # .data and .ramfunc are stored in flash and copied to RAM
+
+    def Ram(self) -> int:
+        return self.data + self.ramfunc + self.bss + self.stack
+
+@dataclass
+class Profile:
+    name : str
+    build_dir : str
+    modules : dict[str, ModuleSize] = field(default_factory=dict)
+    bench : BenchRun | None = None
+
+    def Total(self) -> ModuleSize:
+        total = ModuleSize()
+        for size in self.modules.values():
+            total.text += size.text
+            total.rodata += size.rodata
+            total.data += size.data
+            total.ramfunc += size.ramfunc
+            total.bss += size.bss
+            total.stack += size.stack
+        return total
+
+def MAP_Module_Name(objectPath : str) -> str:
+    """Turns an input file from the .map into a module name (build/ACDC_SPI.o -> ACDC_SPI, .../libc_nano.a(lib_a-memcpy.o) -> libc_nano.a)
+
+    Args:
+        objectPath (str): Input file as printed in the .map
+
+    Returns:
+        str: Module name
+    """
+    library = re.match(r"(.*\.a)\(", objectPath)
+    if library:
+        return os.path.basename(library.group(1))
+    return os.path.splitext(os.path.basename(objectPath))[0]
+
+def MAP_Symbol_Name(sectionName : str) -> str:
+    """Recovers the function or variable name from an input section (.text.SPI_Init.constprop.0 -> SPI_Init)
+
+    Args:
+        sectionName (str): Input section name
+
+    Returns:
+        str: Symbol name
+    """
+    for prefix in (".text.", ".rodata.", ".data.", ".bss."):
+        if sectionName.startswith(prefix):
+            return sectionName[len(prefix):].split(".")[0]
+    return sectionName
+
+def MAP_Load_Symbols(buildDir : str, nm : str) -> dict[str, str]:
+    """Maps every symbol defined in the build's object files to its module (Used to place LTO output back into modules)
+
+    Args:
+        buildDir (str): Folder holding the object files
+        nm (str): nm program that can read the object files (arm-none-eabi-gcc-nm reads LTO objects)
+
+    Returns:
+        dict[str, str]: Symbol name -> Module name
+    """
+    symbols : dict[str, str] = {}
+    for file in sorted(os.listdir(buildDir)):
+        if not file.endswith(".o"):
+            continue
+        try:
+            output = subprocess.run([nm, "--defined-only", "-P", os.path.join(buildDir, file)], capture_output=True, text=True).stdout
+        except FileNotFoundError:
+            return symbols
+        for line in output.splitlines():
+            fields = line.split()
+            if fields:
+                symbols.setdefault(fields[0].split(".")[0], os.path.splitext(file)[0])
+    return symbols
+
+def MAP_Parse(mapPath : str, symbols : dict[str, str]) -> dict[str, ModuleSize]:
+    """Adds up the size of every input section in the .map by module
+
+    Args:
+        mapPath (str): .map file written by the linker (-Wl,-Map)
+        symbols (dict[str, str]): Symbol name -> Module name, used for sections that came out of LTO
+
+    Returns:
+        dict[str, ModuleSize]: Module name -> Bytes used in each section
+    """
+    modules : dict[str, ModuleSize] = {}
+    with open(mapPath, "r") as file:
+        lines = file.read().split("Linker script and memory map", 1)[-1].splitlines()
+
+    kind : str | None = None
+    pendingSection : str | None = None
+    for line in lines:
+        output = re.match(r"^(\.\S+|/DISCARD/)", line)
+        if output:
+            kind = SECTION_KINDS.get(output.group(1))
+            pendingSection = None
+            continue
+
+        inputSection = re.match(r"^ (\.\S+|COMMON)\s*(0x[0-9a-f]+)?\s*(0x[0-9a-f]+)?\s*(\S.*)?$", line)
+        if inputSection and not line.startswith(" *"):
+            pendingSection = inputSection.group(1)
+            if inputSection.group(3) is None:
+                continue                                # Long section names put the address and size on the next line
+            address, size, objectPath = inputSection.group(2), inputSection.group(3), inputSection.group(4)
+        else:
+            wrapped = re.match(r"^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S.*)$", line)
+            if not (wrapped and pendingSection):
+                continue
+            address, size, objectPath = wrapped.groups()
+
+        sectionName, pendingSection = pendingSection, None
+        if kind is None or objectPath is None or int(size, 16) == 0:
+            continue
+
+        column = kind
+        if kind == "data" and sectionName.startswith(".ramfunc"):
+            column = "ramfunc"                          # ACDC_RAMFUNC code is linked into .data (Counted separately)
+
+        module = MAP_Module_Name(objectPath)
+        if ".ltrans" in objectPath:                     # LTO merges modules, find the owner by the symbol name
+            module = symbols.get(MAP_Symbol_Name(sectionName), "(lto)")
+
+        moduleSize = modules.setdefault(module, ModuleSize())
+        setattr(moduleSize, column, getattr(moduleSize, column) + int(size, 16))
+    return modules
+
+def MAP_Print_Sizes(profiles : list[Profile]) -> None:
+    print("\nMemory used by each profile")
+    print(F"\t{'Profile':<10}{'Text':>10}{'Rodata':>10}{'Data':>10}{'RamFunc':>10}{'Bss':>10}{'Flash':>18}{'RAM':>18}")
+    for profile in profiles:
+        total = profile.Total()
+        flashText = F"{total.Flash()} ({total.Flash() * 100 / FLASH_SIZE:.1f}%)"
+        ramText = F"{total.Ram()} ({total.Ram() * 100 / RAM_SIZE:.1f}%)"
+        print(F"\t{profile.name:<10}{total.text:>10}{total.rodata:>10}{total.data:>10}{total.ramfunc:>10}{total.bss:>10}{flashText:>18}{ramText:>18}")
+
+    print("\nFlash / RAM used by each module")
+    header = "".join(F"{profile.name:>18}" for profile in profiles)
+    print(F"\t{'Module':<28}{header}")
+    names = sorted({name for profile in profiles for name in profile.modules}, key=lambda name: -max(p.modules.get(name, ModuleSize()).Flash() for p in profiles))
+    for name in names:
+        columns = ""
+        for profile in profiles:
+            size = profile.modules.get(name)
+            columns += F"{F'{size.Flash()} / {size.Ram()}' if size else '-':>18}"
+        print(F"\t{name:<28}{columns}")
+
+    ramfuncs = [(name, profile.name, size.ramfunc) for profile in profiles for name, size in profile.modules.items() if size.ramfunc]
+    if ramfuncs:
+        print("\nCode run from RAM (ACDC_RAMFUNC)")
+        for name, profileName, size in ramfuncs:
+            print(F"\t{name:<28}{profileName:>10}{size:>8} bytes")
+
+def MAP_Print_Bench(profiles : list[Profile]) -> None:
+    benched = [profile for profile in profiles if profile.bench and profile.bench.cycle_counter_running]
+    if not benched:
+        print("\nNo benchmark runs found (Save one as <build folder>/bench.txt with BENCH_Helper.py to compare cycles)")
+        return
+
+    base = benched[0]
+    print(F"\nAverage cycles of each benchmark (Change is against {base.name})")
+    header = "".join(F"{profile.name:>18}" for profile in benched)
+    print(F"\t{'Benchmark':<24}{header}")
+    for name, baseResult in base.bench.results.items():
+        columns = ""
+        for profile in benched:
+            result = profile.bench.results.get(name)
+            if result is None:
+                columns += F"{'-':>18}"
+            elif profile is base or baseResult.avg_cycles == 0:
+                columns += F"{result.avg_cycles:>18}"
+            else:
+                change = (result.avg_cycles - baseResult.avg_cycles) * 100 / baseResult.avg_cycles
+                columns += F"{F'{result.avg_cycles} ({change:+.0f}%)':>18}"
+        print(F"\t{name:<24}{columns}")
+
+def MAP_Print_Recommendation(profiles : list[Profile]) -> None:
+    fits = [profile for profile in profiles if profile.Total().Flash() <= FLASH_SIZE and profile.Total().Ram() <= RAM_SIZE]
+    for profile in profiles:
+        if profile not in fits:
+            print(F"\n{profile.name} does not fit in {FLASH_SIZE // 1024}K flash / {RAM_SIZE // 1024}K RAM!")
+
+    benched = [profile for profile in fits if profile.bench and profile.bench.cycle_counter_running]
+    if not benched:
+        return
+    common = set.intersection(*(set(profile.bench.results) for profile in benched))
+    fastest = min(benched, key=lambda profile: sum(profile.bench.results[name].avg_cycles for name in common))
+    print(F"\nFastest profile that fits: {fastest.name}")
+
+def main():
+    parser = argparse.ArgumentParser(description="Compares the .map sizes and benchmark runs of the build profiles")
+    parser.add_argument("profiles", nargs="+", help="name=build folder (Ex. debug=build speed=build/speed)")
+    parser.add_argument("--nm", default="arm-none-eabi-gcc-nm", help="nm used to find the owner of LTO sections")
+    parser.add_argument("--target", default="ACDC_SeniorProj", help="Name of the .map file (Without .map)")
+    args = parser.parse_args()
+
+    profiles : list[Profile] = []
+    for entry in args.profiles:
+        name, buildDir = entry.split("=", 1)
+        profile = Profile(name, buildDir)
+        profile.modules = MAP_Parse(os.path.join(buildDir, args.target + ".map"), MAP_Load_Symbols(buildDir, args.nm))
+        benchPath = os.path.join(buildDir, "bench.txt")
+        if os.path.exists(benchPath):
+            profile.bench = BENCH_Read_File(benchPath)
+        profiles.append(profile)
+
+    MAP_Print_Sizes(profiles)
+    MAP_Print_Bench(profiles)
+    MAP_Print_Recommendation(profiles)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,94 @@
+import argparse
+import re
+#SPECTRUM Helper
+
+CMSIS_TABLE_FILE : str = "Drivers/CMSIS/DSP/Source/TransformFunctions/arm_rfft_init_q15.c"
+OUTPUT_FILE : str = "Core/Src/ACDC_SPECTRUM_TABLES.c"
+CMSIS_MAX_SIZE : int = 8192     # realCoefAQ15 / realCoefBQ15 cover RFFTs up to 8192 points
+SPECTRUM_MAX_SIZE : int = 1024  # Largest RFFT ACDC_SPECTRUM supports (Must match SPECTRUM_MAX_SIZE in ACDC_SPECTRUM.h)
+
+def SPECTRUM_Read_Table(source : str, name : str) -> list[int]:
+    """Reads a q15 table out of a CMSIS-DSP source file
+
+    Args:
+        source (str): Contents of the source file
+        name (str): Name of the table (Ex. realCoefAQ15)
+
+    Returns:
+        list[int]: Values of the table as 16-bit hex values (Ex. 0xc000)
+    """
+    table = re.search(name + r"\[\d+\]\s*=\s*\{(.*?)\};", source, re.S)
+    if table is None:
+        raise ValueError(F"{name} was not found in {CMSIS_TABLE_FILE}")
+    return [int(value, 16) for value in re.findall(r"\(q15_t\)(0x[0-9a-fA-F]+)", table.group(1))]
+
+def SPECTRUM_Stride_Table(table : list[int], maxSize : int) -> list[int]:
+    """Keeps the (real, imaginary) pairs that an RFFT of maxSize or less reads
+
+    CMSIS steps through the table by 8192 / N pairs for an N point RFFT, so every pair a smaller RFFT reads
+    is also read by the maxSize RFFT. The kept pairs are the same values arm_rfft_q15 would use.
+
+    Args:
+        table (list[int]): Full CMSIS table (8192 values, 4096 pairs)
+        maxSize (int): Largest RFFT size to keep values for
+
+    Returns:
+        list[int]: maxSize values (maxSize / 2 pairs)
+    """
+    stride = CMSIS_MAX_SIZE // maxSize
+    values : list[int] = []
+    for pair in range(maxSize // 2):
+        values += table[2 * pair * stride : 2 * pair * stride + 2]
+    return values
+
+def SPECTRUM_Format_Table(name : str, values : list[int]) -> str:
+    lines = [F"const q15_t ALIGN4 SPECTRUM_{name}[SPECTRUM_MAX_SIZE] = {{"]
+    for start in range(0, len(values), 8):
+        lines.append("    " + ", ".join(F"(q15_t)0x{value:04x}" for value in values[start : start + 8]) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+def SPECTRUM_Write_Tables(cmsisPath : str, outputPath : str) -> None:
+    """Writes the RFFT split tables used by ACDC_SPECTRUM.c
+
+    Args:
+        cmsisPath (str): Path to arm_rfft_init_q15.c
+        outputPath (str): Path of the C file to write
+    """
+    with open(cmsisPath, "r") as file:
+        source = file.read()
+    coefA = SPECTRUM_Stride_Table(SPECTRUM_Read_Table(source, "realCoefAQ15"), SPECTRUM_MAX_SIZE)
+    coefB = SPECTRUM_Stride_Table(SPECTRUM_Read_Table(source, "realCoefBQ15"), SPECTRUM_MAX_SIZE)
+
+    with open(outputPath, "w") as file:
+        file.write(F"""/**
+ * @file ACDC_SPECTRUM_TABLES.c
+ * @author Devin Marx
+ * @brief RFFT split tables for ACDC_SPECTRUM (GENERATED by Python_Helper/SPECTRUM_Helper.py, do not edit)
+ *
+ * Every {CMSIS_MAX_SIZE // SPECTRUM_MAX_SIZE}th pair of the CMSIS-DSP realCoefAQ15 and realCoefBQ15 tables. They hold every value
+ * a {SPECTRUM_MAX_SIZE} point or smaller arm_rfft_q15 reads, in 4KB of flash instead of the 32KB the full tables take.
+ *
+ * @version 0.1
+ * @date 2024-04-17
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ACDC_SPECTRUM.h"
+
+{SPECTRUM_Format_Table("RealCoefA", coefA)}
+
+{SPECTRUM_Format_Table("RealCoefB", coefB)}
+""")
+    print(F"\tWrote {outputPath} ({len(coefA)} + {len(coefB)} values)")
+
+def main():
+    parser = argparse.ArgumentParser(description="Generates the RFFT tables used by ACDC_SPECTRUM (Run from the repository root)")
+    parser.add_argument("--cmsis", default=CMSIS_TABLE_FILE, help="Path to arm_rfft_init_q15.c")
+    parser.add_argument("--output", default=OUTPUT_FILE, help="C file to write")
+    args = parser.parse_args()
+    SPECTRUM_Write_Tables(args.cmsis, args.output)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,254 @@
+import struct
+from dataclasses import dataclass
+#TELEMETRY Helper
+
+SYNC : bytes = bytes([0xA5, 0x5A])  # TELEMETRY_SYNC_0, TELEMETRY_SYNC_1
+HEADER_SIZE : int = 6               # Sync (2), type, sequence, length (2)
+CRC_SIZE : int = 2
+MAX_PAYLOAD : int = 256             # TELEMETRY_MAX_PAYLOAD
+
+# TELEMETRY_Type in ACDC_TELEMETRY.h
+TYPE_NAMES : dict[int, str] = {
+    0x10 : "SPECTRUM_BINS",
+    0x11 : "SPECTRUM_PEAKS",
+    0x20 : "STATS_SUMMARY",
+    0x30 : "CAPTURE_DATA",
+    0x40 : "BLOCK_TIME",
+    0x41 : "EXTI_EVENTS",
+    0x50 : "CLASSIFIER_EVENT",
+    0x60 : "TRACE_RECORDS",
+}
+
+@dataclass
+class TelemetryFrame:
+    type : int
+    sequence : int
+    payload : bytes
+
+def TELEMETRY_CRC16(data : bytes) -> int:
+    """Calculates the CRC-16/CCITT-FALSE used by ACDC_TELEMETRY
+
+    Args:
+        data (bytes): Type, sequence, length, and payload of a frame
+
+    Returns:
+        int: CRC of the bytes
+    """
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+def TELEMETRY_Parse_Frames(data : bytes) -> tuple[list[TelemetryFrame], bytes, int]:
+    """Finds every complete frame in data (Bytes between frames, such as text output, are skipped)
+
+    Args:
+        data (bytes): Bytes read from the serial port or a capture file
+
+    Returns:
+        tuple[list[TelemetryFrame], bytes, int]: Frames with a valid CRC, bytes left over that may be the start of a frame, number of bad frames
+    """
+    frames : list[TelemetryFrame] = []
+    badFrames = 0
+    index = 0
+    while True:
+        start = data.find(SYNC, index)
+        if start < 0:
+            return frames, data[-1:] if data.endswith(SYNC[:1]) else b"", badFrames
+        if len(data) - start < HEADER_SIZE:
+            return frames, data[start:], badFrames
+
+        frameType, sequence, length = struct.unpack_from("<BBH", data, start + 2)
+        if length > MAX_PAYLOAD:                    # Not a real frame, look for the next sync
+            index = start + 1
+            continue
+        end = start + HEADER_SIZE + length + CRC_SIZE
+        if end > len(data):
+            return frames, data[start:], badFrames
+
+        (crc,) = struct.unpack_from("<H", data, end - CRC_SIZE)
+        if crc != TELEMETRY_CRC16(data[start + 2 : end - CRC_SIZE]):
+            badFrames += 1
+            index = start + 1
+            continue
+        frames.append(TelemetryFrame(frameType, sequence, data[start + HEADER_SIZE : end - CRC_SIZE]))
+        index = end
+
+def TELEMETRY_Decode(frame : TelemetryFrame) -> str:
+    """Turns a frame into a line of text
+
+    Args:
+        frame (TelemetryFrame): Frame to decode
+
+    Returns:
+        str: Decoded contents of the frame
+    """
+    name = TYPE_NAMES.get(frame.type, F"0x{frame.type:02x}")
+    payload = frame.payload
+    match frame.type:
+        case 0x10:
+            size, sampleRate, firstBin, count = struct.unpack_from("<HIHH", payload)
+            magnitudes = struct.unpack_from(F"<{count}h", payload, 10)
+            binHz = sampleRate / size
+            bins = ", ".join(F"{(firstBin + i) * binHz:.1f}Hz={magnitude}" for i, magnitude in enumerate(magnitudes))
+            return F"{name} N={size} bins {firstBin}-{firstBin + count - 1}: {bins}"
+        case 0x11:
+            size, sampleRate, count = struct.unpack_from("<HIB", payload)
+            peaks = [struct.unpack_from("<Hh", payload, 7 + 4 * i) for i in range(count)]
+            binHz = sampleRate / size
+            return F"{name} N={size}: " + ", ".join(F"{peakBin * binHz:.1f}Hz={magnitude}" for peakBin, magnitude in peaks)
+        case 0x20:
+            statsId, count, mean, rms, minimum, maximum, variance, stdDev = struct.unpack_from("<BIhhhhih", payload)
+            return (F"{name} id={statsId} n={count} mean={mean / 32768:.5f} rms={rms / 32768:.5f} min={minimum / 32768:.5f} " +
+                    F"max={maximum / 32768:.5f} var={variance / 2**31:.3e} std={stdDev / 32768:.5f}")
+        case 0x30:
+            captureNumber, length, preTrigger, sampleRate, offset, count = struct.unpack_from("<HHHIHH", payload)
+            return F"{name} #{captureNumber} samples {offset}-{offset + count - 1} of {length}, trigger at {preTrigger}, {sampleRate}Hz"
+        case 0x40:
+            firstSample, timestamp, samplePeriod, length = struct.unpack_from("<IIIH", payload)
+            return F"{name} samples from #{firstSample} at {timestamp}us, {length} every {samplePeriod / 1000:.3f}us"
+        case 0x41:
+            events = [struct.unpack_from("<BII", payload, 1 + 9 * i) for i in range(payload[0])]
+            return F"{name}: " + ", ".join(F"EXTI{line} at {time}us (sample #{sampleNumber})" for line, time, sampleNumber in events)
+        case 0x50:
+            firstSample, timestamp, classIndex, count = struct.unpack_from("<IIBB", payload)
+            scores = struct.unpack_from(F"<{count}b", payload, 10)
+            return (F"{name} class {classIndex} ({scores[classIndex] * 100 / 128:.0f}%) for the window from #{firstSample} at {timestamp}us, scores " +
+                    ", ".join(str(score) for score in scores))
+        case 0x60:
+            clock, first = struct.unpack_from("<II", payload)
+            count = (len(payload) - 8) // 16
+            return F"{name} #{first} - #{first + count - 1} (Decode them with TRACE_Helper.py)"
+        case _:
+            return F"{name}: {payload.hex()}"
+
+def TELEMETRY_Print_Frames(frames : list[TelemetryFrame], lastSequence : int | None = None) -> int | None:
+    """Prints decoded frames and warns about gaps in the sequence numbers
+
+    Args:
+        frames (list[TelemetryFrame]): Frames to print
+        lastSequence (int | None): Sequence number of the frame before these, None if unknown
+
+    Returns:
+        int | None: Sequence number of the last frame printed
+    """
+    for frame in frames:
+        if lastSequence is not None and frame.sequence != (lastSequence + 1) & 0xFF:
+            print(F"\t{(frame.sequence - lastSequence - 1) & 0xFF} frame(s) lost")
+        lastSequence = frame.sequence
+        print(F"\t[{frame.sequence:3}] {TELEMETRY_Decode(frame)}")
+    return lastSequence
+
+def TELEMETRY_Read_File(path : str) -> None:
+    with open(path, "rb") as file:
+        frames, _, badFrames = TELEMETRY_Parse_Frames(file.read())
+    TELEMETRY_Print_Frames(frames)
+    print(F"\t{len(frames)} frames, {badFrames} with a bad CRC")
+
+def TELEMETRY_Save_Captures(frames : list[TelemetryFrame], prefix : str) -> None:
+    """Puts CAPTURE_DATA frames back together and saves every complete capture as a CSV file
+
+    Args:
+        frames (list[TelemetryFrame]): Frames to look through
+        prefix (str): Start of the file names (Ex. "capture" saves capture_1.csv, capture_2.csv, ...)
+    """
+    captures : dict[int, dict] = {}
+    for frame in frames:
+        if frame.type != 0x30:
+            continue
+        captureNumber, length, preTrigger, sampleRate, offset, count = struct.unpack_from("<HHHIHH", frame.payload)
+        capture = captures.setdefault(captureNumber, {"length" : length, "preTrigger" : preTrigger, "sampleRate" : sampleRate, "samples" : {}})
+        for i, sample in enumerate(struct.unpack_from(F"<{count}h", frame.payload, 14)):
+            capture["samples"][offset + i] = sample
+
+    for captureNumber, capture in captures.items():
+        if len(capture["samples"]) != capture["length"]:
+            print(F"\tCapture {captureNumber} is missing {capture['length'] - len(capture['samples'])} samples, skipped")
+            continue
+        path = F"{prefix}_{captureNumber}.csv"
+        with open(path, "w") as file:
+            file.write("time_s,sample_q15,value\n")
+            for index in range(capture["length"]):
+                sample = capture["samples"][index]
+                file.write(F"{(index - capture['preTrigger']) / capture['sampleRate']:.6f},{sample},{sample / 32768:.5f}\n")
+        print(F"\tSaved {path} (Time 0 is the trigger)")
+
+def TELEMETRY_Align_Events(frames : list[TelemetryFrame]) -> None:
+    """Prints where every EXTI event happened between samples, using the BLOCK_TIME frame before it
+
+    Args:
+        frames (list[TelemetryFrame]): Frames to look through
+    """
+    block = None
+    for frame in frames:
+        if frame.type == 0x40:
+            block = struct.unpack_from("<IIIH", frame.payload)
+        elif frame.type == 0x41:
+            for i in range(frame.payload[0]):
+                line, time, sampleNumber = struct.unpack_from("<BII", frame.payload, 1 + 9 * i)
+                if block is None:
+                    print(F"\tEXTI{line} at {time}us (No BLOCK_TIME frame yet)")
+                    continue
+                firstSample, timestamp, samplePeriod, _ = block
+                elapsed = ((time - timestamp + 2**31) % 2**32) - 2**31     # Micros() wraps at 32 bits
+                position = elapsed * 1000 / samplePeriod                   # Samples after the block's first sample (After decimation)
+                print(F"\tEXTI{line} at {time}us is {position:+.2f} samples from #{firstSample} ({elapsed:+}us), during sample #{sampleNumber}")
+
+def TELEMETRY_Capture_Serial(port : str, path : str | None, baud : int = 115200) -> None:
+    """Decodes frames from the serial port until Ctrl+C, optionally saving the raw bytes (Requires pyserial)
+
+    Args:
+        port (str): Serial port of the board (Ex. COM3, /dev/ttyACM0)
+        path (str | None): File to save the raw bytes to, None to not save them
+        baud (int): Baud rate of the telemetry USART
+    """
+    import serial
+    pending = b""
+    lastSequence = None
+    capture = open(path, "wb") if path else None
+    try:
+        with serial.Serial(port, baud, timeout=0.1) as ser:
+            while True:
+                data = ser.read(4096)
+                if capture:
+                    capture.write(data)
+                frames, pending, _ = TELEMETRY_Parse_Frames(pending + data)
+                lastSequence = TELEMETRY_Print_Frames(frames, lastSequence)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if capture:
+            capture.close()
+
+def main():
+    value = input("\n1. Decode telemetry from the serial port\n" +
+                    "2. Decode a saved capture\n" +
+                    "3. Save the triggered captures (ACDC_CAPTURE) in a saved capture as CSV files\n" +
+                    "4. Line up the EXTI events (ACDC_TIMESTAMP) in a saved capture with the samples\n" +
+                    "Please Select an option: ")
+
+    match value:
+        case "1":
+            port = input("\tPlease enter the serial port (Ex. COM3, /dev/ttyACM0): ")
+            path = input("\tPlease enter a file to save the raw bytes to (Leave empty to not save): ")
+            TELEMETRY_Capture_Serial(port, path or None)
+        case "2":
+            path = input("\tPlease enter the saved capture: ")
+            TELEMETRY_Read_File(path)
+        case "3":
+            path = input("\tPlease enter the saved capture: ")
+            with open(path, "rb") as file:
+                frames, _, _ = TELEMETRY_Parse_Frames(file.read())
+            TELEMETRY_Save_Captures(frames, "capture")
+        case "4":
+            path = input("\tPlease enter the saved capture: ")
+            with open(path, "rb") as file:
+                frames, _, _ = TELEMETRY_Parse_Frames(file.read())
+            TELEMETRY_Align_Events(frames)
+        case _:
+            print("You have entered in an incorrect value!")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,185 @@
+import argparse
+import re
+import struct
+from dataclasses import dataclass
+from TELEMETRY_Helper import TelemetryFrame, TELEMETRY_Parse_Frames
+#TRACE Helper
+
+TRACE_TYPE : int = 0x60             # TELEMETRY_TRACE_RECORDS
+HEADER_FORMAT : str = "<II"         # System clock, number of the first record
+RECORD_FORMAT : str = "<IHHII"      # TRACE_Record_t: time, id, context, arg0, arg1
+RECORD_SIZE : int = struct.calcsize(RECORD_FORMAT)
+
+# printf conversions TRACE() format strings can use (Length modifiers are ignored, every argument is 32 bits)
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|t)?([diuxXoc%])")
+
+# Exception numbers below 16 and the STM32F103 interrupts (IRQn + 16) that drivers use
+CONTEXT_NAMES : dict[int, str] = {
+    0 : "main", 2 : "NMI", 3 : "HardFault", 4 : "MemManage", 5 : "BusFault", 6 : "UsageFault", 11 : "SVCall",
+    14 : "PendSV", 15 : "SysTick", 22 : "EXTI0", 23 : "EXTI1", 24 : "EXTI2", 25 : "EXTI3", 26 : "EXTI4", 39 : "EXTI9_5",
+    44 : "TIM2", 45 : "TIM3", 46 : "TIM4", 51 : "SPI1", 52 : "SPI2", 53 : "USART1", 54 : "USART2", 55 : "USART3",
+    56 : "EXTI15_10",
+}
+
+@dataclass
+class TraceRecord:
+    number : int                    # Records written before this one since TRACE_Init
+    seconds : float                 # Time since the first record decoded
+    id : int
+    context : int
+    arg0 : int
+    arg1 : int
+
+def TRACE_Load_Formats(path : str) -> bytes:
+    """Loads the TRACE() format strings from the .trace file made by the build, or from the ELF itself
+
+    Args:
+        path (str): build/<target>.trace or build/<target>.elf
+
+    Returns:
+        bytes: Contents of the .trace_fmt section (Event ids are offsets into it)
+    """
+    with open(path, "rb") as file:
+        data = file.read()
+    if not data.startswith(b"\x7fELF"):
+        return data
+
+    # ELF32 little endian: find .trace_fmt through the section header string table
+    sectionOffset, = struct.unpack_from("<I", data, 0x20)
+    entrySize, entryCount, namesIndex = struct.unpack_from("<HHH", data, 0x2E)
+    sections = [struct.unpack_from("<IIIIII", data, sectionOffset + i * entrySize) for i in range(entryCount)]
+    namesStart = sections[namesIndex][4]
+    for name, _, _, _, offset, size in sections:
+        end = data.index(b"\0", namesStart + name)
+        if data[namesStart + name : end] == b".trace_fmt":
+            return data[offset : offset + size]
+    raise ValueError(F"{path} has no .trace_fmt section (Does it use TRACE?)")
+
+def TRACE_Format(formats : bytes, id : int, arg0 : int, arg1 : int) -> str:
+    """Turns a record back into text with its format string
+
+    Args:
+        formats (bytes): Contents of the .trace_fmt section
+        id (int): Event id of the record
+        arg0 (int): First argument
+        arg1 (int): Second argument
+
+    Returns:
+        str: Formatted event, or the raw values if the id is not in formats (Wrong build?)
+    """
+    if id >= len(formats):
+        return F"unknown event 0x{id:04x} (0x{arg0:08x}, 0x{arg1:08x})"
+    text = formats[id : formats.index(b"\0", id)].decode("ascii", "replace")
+
+    args = [arg0, arg1]
+    def Convert(match : re.Match) -> str:
+        flags, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        value = args.pop(0) if args else 0
+        if conversion in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conversion = "d"
+        elif conversion == "u":
+            conversion = "d"
+        elif conversion == "c":
+            value = value & 0xFF
+        return ("%" + flags + conversion) % value
+    return CONVERSION.sub(Convert, text)
+
+class TraceDecoder:
+    """Decodes TELEMETRY_TRACE_RECORDS frames, keeping the time and record count between frames"""
+
+    def __init__(self, formats : bytes):
+        self.formats = formats
+        self.nextNumber : int | None = None     # Record expected next
+        self.lastTime : int | None = None       # Cycle count of the last record (To count the wraps)
+        self.cycles = 0                         # Cycles since the first record
+        self.lost = 0
+
+    def Decode(self, frame : TelemetryFrame) -> list[TraceRecord]:
+        """Decodes the records of a trace frame (Frames of any other type give no records)
+
+        Args:
+            frame (TelemetryFrame): Frame from TELEMETRY_Parse_Frames
+
+        Returns:
+            list[TraceRecord]: Records in the frame
+        """
+        if frame.type != TRACE_TYPE:
+            return []
+        clock, first = struct.unpack_from(HEADER_FORMAT, frame.payload)
+        clock = clock or 1
+        if self.nextNumber is not None and first != self.nextNumber:
+            if first > self.nextNumber:
+                self.lost += first - self.nextNumber
+                print(F"\t{first - self.nextNumber} record(s) lost")
+            else:
+                print(F"\tRecords restart at #{first} (Reset or TRACE_Dump)")
+                self.lastTime = None                                    # Older records, the times can not be followed across
+
+        records : list[TraceRecord] = []
+        count = (len(frame.payload) - struct.calcsize(HEADER_FORMAT)) // RECORD_SIZE
+        for i in range(count):
+            time, id, context, arg0, arg1 = struct.unpack_from(RECORD_FORMAT, frame.payload, struct.calcsize(HEADER_FORMAT) + i * RECORD_SIZE)
+            if self.lastTime is not None:
+                self.cycles += (time - self.lastTime) & 0xFFFFFFFF     # The cycle counter wraps every 2^32 cycles (59s at 72MHz)
+            self.lastTime = time
+            records.append(TraceRecord(first + i, self.cycles / clock, id, context, arg0, arg1))
+        self.nextNumber = first + count
+        return records
+
+    def Print(self, frames : list[TelemetryFrame]) -> None:
+        """Prints every record in frames as a line of text
+
+        Args:
+            frames (list[TelemetryFrame]): Frames from TELEMETRY_Parse_Frames
+        """
+        for frame in frames:
+            for record in self.Decode(frame):
+                context = CONTEXT_NAMES.get(record.context, F"IRQ{record.context - 16}" if record.context >= 16 else F"exception {record.context}")
+                print(F"\t#{record.number:<6} {record.seconds:12.6f}s {context:>10} | {TRACE_Format(self.formats, record.id, record.arg0, record.arg1)}")
+
+def TRACE_Read_File(formats : bytes, path : str) -> None:
+    with open(path, "rb") as file:
+        frames, _, badFrames = TELEMETRY_Parse_Frames(file.read())
+    decoder = TraceDecoder(formats)
+    decoder.Print(frames)
+    print(F"\t{sum(frame.type == TRACE_TYPE for frame in frames)} trace frames, {decoder.lost} records lost, {badFrames} frames with a bad CRC")
+
+def TRACE_Capture_Serial(formats : bytes, port : str, baud : int = 115200) -> None:
+    """Decodes trace records from the serial port until Ctrl+C (Requires pyserial)
+
+    Args:
+        formats (bytes): Contents of the .trace_fmt section
+        port (str): Serial port of the board (Ex. COM3, /dev/ttyACM0)
+        baud (int): Baud rate of the telemetry USART
+    """
+    import serial
+    pending = b""
+    decoder = TraceDecoder(formats)
+    try:
+        with serial.Serial(port, baud, timeout=0.1) as ser:
+            while True:
+                frames, pending, _ = TELEMETRY_Parse_Frames(pending + ser.read(4096))
+                decoder.Print(frames)
+    except KeyboardInterrupt:
+        pass
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodes ACDC_TRACE records with the format strings of the build that made them")
+    parser.add_argument("formats", help="build/<target>.trace (Made by make) or the .elf")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--port", help="Serial port to read from (Ex. COM3, /dev/ttyACM0)")
+    source.add_argument("--file", help="Raw capture saved by TELEMETRY_Helper.py")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    formats = TRACE_Load_Formats(args.formats)
+    if args.port:
+        TRACE_Capture_Serial(formats, args.port, args.baud)
+    else:
+        TRACE_Read_File(formats, args.file)
+
+if __name__ == "__main__":
+    main()
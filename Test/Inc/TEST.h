@@ -0,0 +1,98 @@
+/**
+ * @file TEST.h
+ * @author Devin Marx
+ * @brief Header file for the host unit tests (make host-test)
+ *
+ * Every test runs in its own process on a freshly reset simulated MCU (SIM_Reset), so module state (Static
+ * variables, registered callbacks, ...) never leaks from one test into the next, and a test that crashes or ends in
+ * SIM_Fatal is reported as a failure instead of stopping the run.
+ *
+ * A failed assert prints where it failed and ends the test. make host-test fails if any test failed.
+ *
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __TEST_H
+#define __TEST_H
+
+#include <stdio.h>
+#include <string.h>
+#include "SIM.h"
+
+typedef void (*TEST_Function)(void);
+
+/// @brief Marks the running test as failed and prints why (Use the TEST_ASSERT macros)
+/// @param file File of the assert
+/// @param line Line of the assert
+/// @param message What was expected
+void TEST_Fail(const char *file, int line, const char *message) __attribute__((noreturn));
+
+/// @brief Runs one test in its own process on a reset simulated MCU
+/// @param name Name printed with the result
+/// @param test Test to run
+void TEST_Run(const char *name, TEST_Function test);
+
+#define TEST_ASSERT(CONDITION) do{ \
+    if(!(CONDITION)){ TEST_Fail(__FILE__, __LINE__, #CONDITION); return; } \
+}while(0)
+
+#define TEST_ASSERT_EQUAL(EXPECTED, ACTUAL) do{ \
+    long long TEST_Expected = (long long)(EXPECTED), TEST_Actual = (long long)(ACTUAL); \
+    if(TEST_Expected != TEST_Actual){ \
+        char TEST_Message[160]; \
+        snprintf(TEST_Message, sizeof(TEST_Message), "%s == %s (Expected %lld, got %lld)", #EXPECTED, #ACTUAL, TEST_Expected, TEST_Actual); \
+        TEST_Fail(__FILE__, __LINE__, TEST_Message); return; \
+    } \
+}while(0)
+
+#define TEST_ASSERT_NEAR(EXPECTED, ACTUAL, TOLERANCE) do{ \
+    double TEST_Expected = (double)(EXPECTED), TEST_Actual = (double)(ACTUAL); \
+    if(!(TEST_Actual >= TEST_Expected - (TOLERANCE) && TEST_Actual <= TEST_Expected + (TOLERANCE))){ \
+        char TEST_Message[160]; \
+        snprintf(TEST_Message, sizeof(TEST_Message), "%s ~= %s +/- %s (Expected %g, got %g)", #EXPECTED, #ACTUAL, #TOLERANCE, TEST_Expected, TEST_Actual); \
+        TEST_Fail(__FILE__, __LINE__, TEST_Message); return; \
+    } \
+}while(0)
+
+#define TEST_ASSERT_EQUAL_STRING(EXPECTED, ACTUAL) do{ \
+    const char *TEST_Expected = (EXPECTED), *TEST_Actual = (ACTUAL); \
+    if(strcmp(TEST_Expected, TEST_Actual) != 0){ \
+        char TEST_Message[160]; \
+        snprintf(TEST_Message, sizeof(TEST_Message), "%s == %s (Expected \"%s\", got \"%s\")", #EXPECTED, #ACTUAL, TEST_Expected, TEST_Actual); \
+        TEST_Fail(__FILE__, __LINE__, TEST_Message); return; \
+    } \
+}while(0)
+
+#define TEST_ASSERT_EQUAL_MEMORY(EXPECTED, ACTUAL, LENGTH) do{ \
+    if(memcmp((EXPECTED), (ACTUAL), (LENGTH)) != 0){ TEST_Fail(__FILE__, __LINE__, #EXPECTED " == " #ACTUAL " (" #LENGTH " bytes)"); return; } \
+}while(0)
+
+// Test suites (One per Test/Src/TEST_<MODULE>.c, called from main in TEST.c)
+void TEST_string(void);
+void TEST_CLOCK(void);
+void TEST_GPIO(void);
+void TEST_INTERRUPT(void);
+void TEST_SPI(void);
+void TEST_USART(void);
+void TEST_TIMER(void);
+void TEST_FILTER(void);
+void TEST_TELEMETRY(void);
+void TEST_SPECTRUM(void);
+void TEST_GOERTZEL(void);
+void TEST_CONTROL(void);
+void TEST_STATS(void);
+void TEST_CAPTURE(void);
+void TEST_TIMESTAMP(void);
+void TEST_ACQUIRE(void);
+void TEST_CALIBRATION(void);
+void TEST_CLASSIFIER(void);
+void TEST_SCHEDULER(void);
+void TEST_RTOS(void);
+void TEST_POOL(void);
+void TEST_TRACE(void);
+void TEST_WATCHDOG(void);
+
+#endif
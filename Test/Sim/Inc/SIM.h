@@ -0,0 +1,195 @@
+/**
+ * @file SIM.h
+ * @author Devin Marx
+ * @brief Header file for the simulated STM32F103xB used by the host unit tests
+ *
+ * Behavioural models of the peripherals the ACDC drivers use. Models only change registers when the drivers (Or a
+ * test) access them through the macros in the simulated stm32f1xx.h, or when a test calls SIM_Run:
+ *  - Core: a cycle counter (SIM_CYCLES_PER_ACCESS per register access), PRIMASK/IPSR, the NVIC enable and pending
+ *    registers, SysTick, the DWT cycle counter, and LDREX/STREX with an exclusive monitor interrupts clear
+ *  - RCC: oscillator ready flags follow their enable bits, SWS follows SW, and the system clock is worked out from
+ *    the PLL settings (8MHz HSE like the NUCLEO-F103RB). SPI and USART with their clock off never set a flag
+ *  - GPIO/AFIO/EXTI: IDR follows ODR on outputs and the level a test drives on inputs, edges on the EXTICR selected
+ *    pins set EXTI->PR
+ *  - SPI: a master frame written to DR is exchanged with the device a test attached, RXNE is set until DR is read
+ *  - USART: bytes written to DR are kept for the test to read, bytes a test sends are delivered through RXNE
+ *  - TIM1-4: the counter runs from the core clock through PSC and ARR and sets UIF on every update
+ *  - FLASH, CRC, IWDG: prefetch status, the calibration page (_scalibration) erase, the CRC-32 unit, and the
+ *    watchdog counter on a 40kHz LSI
+ *
+ * Interrupts are taken whenever a source is pending, enabled in the NVIC, and PRIMASK is clear. Handlers do not
+ * nest, the highest priority (Lowest IRQn on a tie) pending interrupt runs first.
+ *
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __SIM_H
+#define __SIM_H
+
+#include <stm32f1xx.h>   // <> so the search starts at -ITest/Sim/Inc, "" would find this folder first and skip the real header
+#include "ACDC_stdint.h"
+#include "ACDC_stdbool.h"
+
+#define SIM_CYCLES_PER_ACCESS 4         /**< Core cycles that pass on every register access       */
+#define SIM_HSE_HZ            8000000   /**< External clock of the NUCLEO-F103RB (ST-Link MCO)     */
+#define SIM_HSI_HZ            8000000   /**< Internal RC oscillator                                */
+#define SIM_USART_BUFFER_SIZE 4096      /**< Bytes kept of each USART's output and input           */
+
+/// @brief Device on a simulated SPI bus
+/// @param SPIx SPI the frame was sent on (Ex. SPI1)
+/// @param mosi Frame the master sent
+/// @return Frame the device sends back
+typedef uint16_t (*SIM_SpiDevice)(SPI_TypeDef *SPIx, uint16_t mosi);
+
+extern GPIO_TypeDef SIM_GPIOA, SIM_GPIOB, SIM_GPIOC, SIM_GPIOD, SIM_GPIOE;
+extern AFIO_TypeDef SIM_AFIO;
+extern EXTI_TypeDef SIM_EXTI;
+extern RCC_TypeDef SIM_RCC;
+extern FLASH_TypeDef SIM_FLASH;
+extern CRC_TypeDef SIM_CRC;
+extern SPI_TypeDef SIM_SPI1, SIM_SPI2;
+extern USART_TypeDef SIM_USART1, SIM_USART2, SIM_USART3;
+extern TIM_TypeDef SIM_TIM1, SIM_TIM2, SIM_TIM3, SIM_TIM4;
+extern IWDG_TypeDef SIM_IWDG;
+extern DBGMCU_TypeDef SIM_DBGMCU;
+extern SysTick_Type SIM_SysTick;
+extern NVIC_Type SIM_NVIC;
+extern SCB_Type SIM_SCB;
+extern DWT_Type SIM_DWT;
+extern CoreDebug_Type SIM_CoreDebug;
+
+#pragma region CORE
+/// @brief Puts every register at its reset value, clears the model state, and sets the cycle counter to 0 (Call first in every test)
+void SIM_Reset(void);
+
+/// @brief One register access: time passes, the models update, and pending interrupts are taken
+void SIM_Poll(void);
+
+/// @brief Called after a register was written through a macro (Handles write side effects, then SIM_Poll)
+/// @param reg Register that was written
+void SIM_Write(const volatile void *reg);
+
+/// @brief Called after a register was read through READ_REG (Handles read side effects, then SIM_Poll)
+/// @param reg Register that was read
+void SIM_Read(const volatile void *reg);
+
+/// @brief Lets cycles core cycles pass, taking interrupts along the way (Ex. the main loop waiting on a timer)
+/// @param cycles Core cycles to run
+void SIM_Run(uint64_t cycles);
+
+/// @brief Gets the core cycles since SIM_Reset
+/// @return Cycle count
+uint64_t SIM_GetCycles(void);
+
+/// @brief Gets the core clock (HCLK) the RCC registers select (Timers count on it too, like TIMER_TICK_Init assumes)
+/// @return HCLK in Hz
+uint32_t SIM_GetCoreClockHz(void);
+
+/// @brief Sets PRIMASK, taking any pending interrupt if it was cleared (__disable_irq, __enable_irq, __set_PRIMASK)
+/// @param primask 1 to mask interrupts, 0 to allow them
+void SIM_SetPrimask(uint32_t primask);
+
+/// @brief Gets PRIMASK (__get_PRIMASK)
+/// @return 1 if interrupts are masked
+uint32_t SIM_GetPrimask(void);
+
+/// @brief Gets IPSR (__get_IPSR)
+/// @return 0 in thread mode, the exception number (IRQn + 16) in a handler
+uint32_t SIM_GetIpsr(void);
+
+/// @brief Sleeps until an interrupt is pending (__WFI). Fails the test if nothing can ever wake the core
+void SIM_Wfi(void);
+
+/// @brief Loads a word and marks it for exclusive access (__LDREXW)
+/// @param address Word to load
+/// @return Value of the word
+uint32_t SIM_Ldrex(volatile uint32_t *address);
+
+/// @brief Stores a word if nothing cleared the exclusive monitor since SIM_Ldrex (__STREXW, interrupts clear it)
+/// @param value Value to store
+/// @param address Word to store to
+/// @return 0 if the word was stored, 1 if the store failed
+uint32_t SIM_Strex(uint32_t value, volatile uint32_t *address);
+
+/// @brief Clears the exclusive monitor (__CLREX)
+void SIM_Clrex(void);
+
+/// @brief Makes the next SIM_Strex fail, as if an interrupt ran between LDREX and STREX
+void SIM_BreakExclusive(void);
+
+/// @brief Stops the test run with a message (Missing handlers, __BKPT, NVIC_SystemReset, and waits that never end)
+/// @param reason What happened
+void SIM_Fatal(const char *reason) __attribute__((noreturn));
+
+/// @brief Sets an interrupt pending in the NVIC (Ex. a test firing a vector the models do not drive)
+/// @param IRQn Interrupt to pend
+void SIM_SetPending(IRQn_Type IRQn);
+
+/// @brief Checks if an interrupt is enabled in the NVIC
+/// @param IRQn Interrupt to check
+/// @return True if enabled
+bool SIM_IsEnabled(IRQn_Type IRQn);
+
+/// @brief Gets how many times the handler of an interrupt has run since SIM_Reset
+/// @param IRQn Interrupt to check (SysTick_IRQn for SysTick)
+/// @return Number of times it was taken
+uint32_t SIM_GetInterruptCount(IRQn_Type IRQn);
+#pragma endregion
+
+#pragma region PERIPHERALS
+/// @brief Drives an input pin high or low from outside the MCU (Edges are seen by EXTI)
+/// @param GPIOx Port (Ex. GPIOA)
+/// @param GPIO_PIN Pins to drive (Ex. GPIO_PIN_0)
+/// @param high True to drive high, false to drive low
+void SIM_GPIO_Drive(GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN, bool high);
+
+/// @brief Stops driving input pins (They go back to their pull-up/pull-down)
+/// @param GPIOx Port (Ex. GPIOA)
+/// @param GPIO_PIN Pins to release (Ex. GPIO_PIN_0)
+void SIM_GPIO_Release(GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN);
+
+/// @brief Attaches a device to an SPI bus (0 to remove it, frames then read back as 0)
+/// @param SPIx SPI (Ex. SPI1)
+/// @param device Function called with every frame the master sends
+void SIM_SPI_Attach(SPI_TypeDef *SPIx, SIM_SpiDevice device);
+
+/// @brief Sends a frame to an SPI slave as if an external master clocked it (Sets RXNE)
+/// @param SPIx SPI in slave mode (Ex. SPI2)
+/// @param frame Frame the external master sends
+/// @return Frame the slave had in DR
+uint16_t SIM_SPI_SlaveTransfer(SPI_TypeDef *SPIx, uint16_t frame);
+
+/// @brief Gets the number of frames a master SPI has sent since SIM_Reset
+/// @param SPIx SPI (Ex. SPI1)
+/// @return Frames sent
+uint32_t SIM_SPI_GetFrameCount(const SPI_TypeDef *SPIx);
+
+/// @brief Queues bytes for a USART to receive (Delivered one at a time through RXNE)
+/// @param USARTx USART (Ex. USART2)
+/// @param data Bytes to receive
+/// @param length Number of bytes
+void SIM_USART_Send(USART_TypeDef *USARTx, const char *data, uint32_t length);
+
+/// @brief Gets the bytes a USART has transmitted since SIM_Reset (Or the last SIM_USART_ClearOutput)
+/// @param USARTx USART (Ex. USART2)
+/// @param length Set to the number of bytes
+/// @return Transmitted bytes (Not '\0' terminated)
+const char* SIM_USART_GetOutput(const USART_TypeDef *USARTx, uint32_t *length);
+
+/// @brief Forgets the bytes a USART has transmitted
+/// @param USARTx USART (Ex. USART2)
+void SIM_USART_ClearOutput(const USART_TypeDef *USARTx);
+
+/// @brief Gets the number of times the IWDG counter reached 0 (Each one a reset on the MCU)
+/// @return Number of watchdog resets
+uint32_t SIM_IWDG_GetResetCount(void);
+
+/// @brief Gets the number of times the IWDG was refreshed
+/// @return Number of refreshes
+uint32_t SIM_IWDG_GetReloadCount(void);
+#pragma endregion
+
+#endif
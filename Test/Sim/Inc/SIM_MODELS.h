@@ -0,0 +1,61 @@
+/**
+ * @file SIM_MODELS.h
+ * @author Devin Marx
+ * @brief Header file shared by the peripheral models of the simulated STM32F103xB (Not for tests, use SIM.h)
+ *
+ * Every model has the same four hooks, called by SIM_CORE:
+ *  - Reset: registers to their reset values, model state cleared
+ *  - Update: cycles core cycles passed, plain register writes made since the last update are picked up, and the
+ *    interrupt lines of the model are raised with SIM_RaiseLine
+ *  - Write / Read: a register of the model was accessed through a macro (Returns false if reg is not one of its registers)
+ *
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __SIM_MODELS_H
+#define __SIM_MODELS_H
+
+#include <stm32f1xx.h>   // See SIM.h
+#include "SIM.h"
+
+#define SIM_LSI_HZ 40000    /**< IWDG clock (Typical LSI) */
+
+#define SIM_IS_SET(REG, BIT) (((REG) & (BIT)) != 0)   /**< Reads a register without it counting as an access */
+
+/// @brief Raises the interrupt line of a peripheral for this update (Sets the NVIC pending bit)
+/// @param IRQn Interrupt of the peripheral
+void SIM_RaiseLine(IRQn_Type IRQn);
+
+/// @brief Gets the core clock (HCLK) the RCC registers select
+/// @return HCLK in Hz
+uint32_t SIM_RCC_GetCoreClockHz(void);
+
+void SIM_RCC_Reset(void);
+void SIM_RCC_Update(uint32_t cycles);
+bool SIM_RCC_Write(const volatile void *reg);
+bool SIM_RCC_Read(const volatile void *reg);
+
+void SIM_GPIO_Reset(void);
+void SIM_GPIO_Update(uint32_t cycles);
+bool SIM_GPIO_Write(const volatile void *reg);
+bool SIM_GPIO_Read(const volatile void *reg);
+
+void SIM_SPI_Reset(void);
+void SIM_SPI_Update(uint32_t cycles);
+bool SIM_SPI_Write(const volatile void *reg);
+bool SIM_SPI_Read(const volatile void *reg);
+
+void SIM_USART_Reset(void);
+void SIM_USART_Update(uint32_t cycles);
+bool SIM_USART_Write(const volatile void *reg);
+bool SIM_USART_Read(const volatile void *reg);
+
+void SIM_TIMER_Reset(void);
+void SIM_TIMER_Update(uint32_t cycles);
+bool SIM_TIMER_Write(const volatile void *reg);
+bool SIM_TIMER_Read(const volatile void *reg);
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file stm32f1xx.h
+ * @author Devin Marx
+ * @brief Simulated STM32F103xB register map for the host build (make host-test)
+ *
+ * Found before Drivers/CMSIS/Device/ST/STM32F1xx/Include, so every ACDC module that includes "stm32f1xx.h" gets
+ * this file instead. The real device header is still included for the register structs and bit definitions, then:
+ *  - Every peripheral pointer (GPIOA, RCC, SPI1, SysTick, NVIC, ...) is pointed at a struct in host RAM
+ *  - The register access macros (SET_BIT, WRITE_REG, READ_BIT, ...) let the models in Test/Sim/Src see the access,
+ *    so status flags change, data registers shift, time passes, and interrupts are taken like on the MCU
+ *  - The Cortex-M3 intrinsics (__disable_irq, __LDREXW, __WFI, ...) run against the simulated core
+ *
+ * Drivers must use the access macros for registers with side effects (Data, status, and NVIC registers), the same
+ * as they do on the MCU. Plain reads and writes still work, the models only see them on the next macro access.
+ *
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef __SIM_STM32F1XX_H
+#define __SIM_STM32F1XX_H
+
+#include <stddef.h>     // NULL, size_t, offsetof (The MCU build gets them through the HAL headers)
+#include_next "stm32f1xx.h"
+
+#include "SIM.h"
+
+#undef GPIOA
+#undef GPIOB
+#undef GPIOC
+#undef GPIOD
+#undef GPIOE
+#undef AFIO
+#undef EXTI
+#undef RCC
+#undef FLASH
+#undef CRC
+#undef SPI1
+#undef SPI2
+#undef USART1
+#undef USART2
+#undef USART3
+#undef TIM1
+#undef TIM2
+#undef TIM3
+#undef TIM4
+#undef IWDG
+#undef DBGMCU
+#undef SysTick
+#undef NVIC
+#undef SCB
+#undef DWT
+#undef CoreDebug
+
+#define GPIOA       (&SIM_GPIOA)
+#define GPIOB       (&SIM_GPIOB)
+#define GPIOC       (&SIM_GPIOC)
+#define GPIOD       (&SIM_GPIOD)
+#define GPIOE       (&SIM_GPIOE)
+#define AFIO        (&SIM_AFIO)
+#define EXTI        (&SIM_EXTI)
+#define RCC         (&SIM_RCC)
+#define FLASH       (&SIM_FLASH)
+#define CRC         (&SIM_CRC)
+#define SPI1        (&SIM_SPI1)
+#define SPI2        (&SIM_SPI2)
+#define USART1      (&SIM_USART1)
+#define USART2      (&SIM_USART2)
+#define USART3      (&SIM_USART3)
+#define TIM1        (&SIM_TIM1)
+#define TIM2        (&SIM_TIM2)
+#define TIM3        (&SIM_TIM3)
+#define TIM4        (&SIM_TIM4)
+#define IWDG        (&SIM_IWDG)
+#define DBGMCU      (&SIM_DBGMCU)
+#define SysTick     (&SIM_SysTick)
+#define NVIC        (&SIM_NVIC)
+#define SCB         (&SIM_SCB)
+#define DWT         (&SIM_DWT)
+#define CoreDebug   (&SIM_CoreDebug)
+
+// Register access (Every access is one step of simulated time)
+#undef SET_BIT
+#undef CLEAR_BIT
+#undef READ_BIT
+#undef CLEAR_REG
+#undef WRITE_REG
+#undef READ_REG
+#undef MODIFY_REG
+
+#define SET_BIT(REG, BIT)       ((void)((REG) |= (BIT)), SIM_Write(&(REG)))
+#define CLEAR_BIT(REG, BIT)     ((void)((REG) &= (uint32_t)~(BIT)), SIM_Write(&(REG)))
+#define READ_BIT(REG, BIT)      (SIM_Poll(), ((REG) & (BIT)))
+#define CLEAR_REG(REG)          ((void)((REG) = (0x0)), SIM_Write(&(REG)))
+#define WRITE_REG(REG, VAL)     ((void)((REG) = (__typeof__(REG))(VAL)), SIM_Write(&(REG)))   // ~UL masks are 64-bit on the host
+#define READ_REG(REG)           ({ __typeof__(REG) SIM_Value = (REG); SIM_Read(&(REG)); SIM_Value; })
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  WRITE_REG((REG), (((REG) & (~(CLEARMASK))) | (SETMASK)))
+
+// Cortex-M3 intrinsics
+#undef __disable_irq
+#undef __enable_irq
+#undef __WFI
+#undef __NOP
+#undef __DSB
+#undef __DMB
+#undef __ISB
+#undef __BKPT
+#undef NVIC_SystemReset
+#define __disable_irq()         SIM_SetPrimask(1)
+#define __enable_irq()          SIM_SetPrimask(0)
+#define __get_PRIMASK()         SIM_GetPrimask()
+#define __set_PRIMASK(value)    SIM_SetPrimask(value)
+#define __get_IPSR()            SIM_GetIpsr()
+#define __WFI()                 SIM_Wfi()
+#define __NOP()                 ((void)0)
+#define __DSB()                 ((void)0)
+#define __DMB()                 ((void)0)
+#define __ISB()                 ((void)0)
+#define __LDREXW(address)       SIM_Ldrex(address)
+#define __STREXW(value, address) SIM_Strex((value), (address))
+#define __CLREX()               SIM_Clrex()
+#define __BKPT(value)           SIM_Fatal("__BKPT")
+#define NVIC_SystemReset()      SIM_Fatal("NVIC_SystemReset")
+
+#endif
@@ -0,0 +1,398 @@
+/**
+ * @file SIM_CORE.c
+ * @author Devin Marx
+ * @brief Implementation of the simulated Cortex-M3 core (Time, NVIC, SysTick, SCB, DWT, PRIMASK, LDREX/STREX)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SIM_MODELS.h"
+
+#define SIM_EXCEPTION_COUNT  (16 + 43)         // Cortex-M3 exceptions + STM32F103xB interrupts
+#define SIM_IRQ_WORDS        2                 // ISER/ICER/ISPR/ICPR words the STM32F103xB uses
+#define SIM_ENTRY_CYCLES     12                // Exception entry (Stacking) {See PM-35}
+#define SIM_RUN_STEP         64                // Cycles SIM_Run and SIM_Wfi move at a time
+#define SIM_CYCLE_LIMIT      10000000000ULL    // Cycles a test may run before it is taken as stuck (139s at 72MHz)
+#define SIM_WFI_LIMIT        1000000000ULL     // Cycles __WFI may sleep before nothing is taken as able to wake it
+
+typedef void (*SIM_Handler)(void);
+
+// Vectors the firmware does not define are 0 (The startup file points them at Default_Handler)
+#define SIM_VECTOR(name) extern void name(void) __attribute__((weak));
+SIM_VECTOR(NMI_Handler) SIM_VECTOR(HardFault_Handler) SIM_VECTOR(MemManage_Handler) SIM_VECTOR(BusFault_Handler)
+SIM_VECTOR(UsageFault_Handler) SIM_VECTOR(SVC_Handler) SIM_VECTOR(DebugMon_Handler) SIM_VECTOR(PendSV_Handler)
+SIM_VECTOR(SysTick_Handler) SIM_VECTOR(WWDG_IRQHandler) SIM_VECTOR(PVD_IRQHandler) SIM_VECTOR(TAMPER_IRQHandler)
+SIM_VECTOR(RTC_IRQHandler) SIM_VECTOR(FLASH_IRQHandler) SIM_VECTOR(RCC_IRQHandler) SIM_VECTOR(EXTI0_IRQHandler)
+SIM_VECTOR(EXTI1_IRQHandler) SIM_VECTOR(EXTI2_IRQHandler) SIM_VECTOR(EXTI3_IRQHandler) SIM_VECTOR(EXTI4_IRQHandler)
+SIM_VECTOR(DMA1_Channel1_IRQHandler) SIM_VECTOR(DMA1_Channel2_IRQHandler) SIM_VECTOR(DMA1_Channel3_IRQHandler)
+SIM_VECTOR(DMA1_Channel4_IRQHandler) SIM_VECTOR(DMA1_Channel5_IRQHandler) SIM_VECTOR(DMA1_Channel6_IRQHandler)
+SIM_VECTOR(DMA1_Channel7_IRQHandler) SIM_VECTOR(ADC1_2_IRQHandler) SIM_VECTOR(USB_HP_CAN1_TX_IRQHandler)
+SIM_VECTOR(USB_LP_CAN1_RX0_IRQHandler) SIM_VECTOR(CAN1_RX1_IRQHandler) SIM_VECTOR(CAN1_SCE_IRQHandler)
+SIM_VECTOR(EXTI9_5_IRQHandler) SIM_VECTOR(TIM1_BRK_IRQHandler) SIM_VECTOR(TIM1_UP_IRQHandler)
+SIM_VECTOR(TIM1_TRG_COM_IRQHandler) SIM_VECTOR(TIM1_CC_IRQHandler) SIM_VECTOR(TIM2_IRQHandler) SIM_VECTOR(TIM3_IRQHandler)
+SIM_VECTOR(TIM4_IRQHandler) SIM_VECTOR(I2C1_EV_IRQHandler) SIM_VECTOR(I2C1_ER_IRQHandler) SIM_VECTOR(I2C2_EV_IRQHandler)
+SIM_VECTOR(I2C2_ER_IRQHandler) SIM_VECTOR(SPI1_IRQHandler) SIM_VECTOR(SPI2_IRQHandler) SIM_VECTOR(USART1_IRQHandler)
+SIM_VECTOR(USART2_IRQHandler) SIM_VECTOR(USART3_IRQHandler) SIM_VECTOR(EXTI15_10_IRQHandler)
+SIM_VECTOR(RTC_Alarm_IRQHandler) SIM_VECTOR(USBWakeUp_IRQHandler)
+
+static SIM_Handler const SIM_Vectors[SIM_EXCEPTION_COUNT] = {   // Same order as startup_stm32f103xb.s
+    0, 0, NMI_Handler, HardFault_Handler, MemManage_Handler, BusFault_Handler, UsageFault_Handler, 0, 0, 0, 0,
+    SVC_Handler, DebugMon_Handler, 0, PendSV_Handler, SysTick_Handler,
+    WWDG_IRQHandler, PVD_IRQHandler, TAMPER_IRQHandler, RTC_IRQHandler, FLASH_IRQHandler, RCC_IRQHandler,
+    EXTI0_IRQHandler, EXTI1_IRQHandler, EXTI2_IRQHandler, EXTI3_IRQHandler, EXTI4_IRQHandler,
+    DMA1_Channel1_IRQHandler, DMA1_Channel2_IRQHandler, DMA1_Channel3_IRQHandler, DMA1_Channel4_IRQHandler,
+    DMA1_Channel5_IRQHandler, DMA1_Channel6_IRQHandler, DMA1_Channel7_IRQHandler, ADC1_2_IRQHandler,
+    USB_HP_CAN1_TX_IRQHandler, USB_LP_CAN1_RX0_IRQHandler, CAN1_RX1_IRQHandler, CAN1_SCE_IRQHandler,
+    EXTI9_5_IRQHandler, TIM1_BRK_IRQHandler, TIM1_UP_IRQHandler, TIM1_TRG_COM_IRQHandler, TIM1_CC_IRQHandler,
+    TIM2_IRQHandler, TIM3_IRQHandler, TIM4_IRQHandler, I2C1_EV_IRQHandler, I2C1_ER_IRQHandler,
+    I2C2_EV_IRQHandler, I2C2_ER_IRQHandler, SPI1_IRQHandler, SPI2_IRQHandler, USART1_IRQHandler,
+    USART2_IRQHandler, USART3_IRQHandler, EXTI15_10_IRQHandler, RTC_Alarm_IRQHandler, USBWakeUp_IRQHandler
+};
+
+SysTick_Type SIM_SysTick;
+NVIC_Type SIM_NVIC;
+SCB_Type SIM_SCB;
+DWT_Type SIM_DWT;
+CoreDebug_Type SIM_CoreDebug;
+
+static uint64_t SimCycles;                          // Core cycles since SIM_Reset
+static uint32_t SimSysTickPrescale;                 // Cycles towards the next SysTick tick on the HCLK / 8 clock
+static uint32_t SimPrimask;
+static uint32_t SimActive;                          // Exception number of the running handler (0 in thread mode)
+static bool SimSysTickPending;
+static bool SimPendSVPending;
+static uint32_t SimEnabled[SIM_IRQ_WORDS];
+static uint32_t SimPending[SIM_IRQ_WORDS];
+static uint32_t SimLines[SIM_IRQ_WORDS];            // Peripheral interrupt lines raised in the last update
+static uint32_t SimTaken[SIM_EXCEPTION_COUNT];
+static volatile uint32_t *SimExclusiveAddress;      // 0 when the exclusive monitor is clear
+static uint32_t SimStrexFailures;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Lets cycles pass: SysTick and DWT count, every model updates, and the NVIC picks up the new pending bits
+/// @param cycles Core cycles that passed (0 only refreshes the interrupt lines)
+static void SIM_Advance(uint32_t cycles);
+
+/// @brief Counts SysTick down (Sets COUNTFLAG and pends the SysTick exception every time it reaches 0)
+/// @param cycles Core cycles that passed
+static void SIM_SysTickUpdate(uint32_t cycles);
+
+/// @brief Syncs the NVIC registers with the enabled and pending state (Plain writes to ISER/ICER/ISPR/ICPR are picked up here)
+static void SIM_NvicUpdate(void);
+
+/// @brief Finds the exception that would be taken next
+/// @return Exception number (IRQn + 16), 0 if nothing is pending and enabled
+static uint32_t SIM_NextException(void);
+
+/// @brief Gets the priority of an exception (Only bits [7:4] are implemented)
+/// @param exception Exception number (IRQn + 16)
+/// @return Priority, lower runs first
+static uint8_t SIM_GetPriority(uint32_t exception);
+
+/// @brief Takes pending interrupts while PRIMASK is clear and no handler is running
+static void SIM_Dispatch(void);
+
+/// @brief Handles a macro write to a core register (NVIC, SCB->ICSR, SysTick->VAL)
+/// @param reg Register that was written
+/// @return True if reg is a core register
+static bool SIM_CoreWrite(const volatile void *reg);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void SIM_Reset(void){
+    memset(&SIM_SysTick, 0, sizeof(SIM_SysTick));
+    memset(&SIM_NVIC, 0, sizeof(SIM_NVIC));
+    memset(&SIM_SCB, 0, sizeof(SIM_SCB));
+    memset(&SIM_DWT, 0, sizeof(SIM_DWT));
+    memset(&SIM_CoreDebug, 0, sizeof(SIM_CoreDebug));
+    *(uint32_t*)&SIM_SCB.CPUID = 0x411FC231;        // Cortex-M3 r1p1 (Read only to the firmware)
+    SIM_DWT.CTRL = 0x40000000;                      // NUMCOMP = 4
+
+    SimCycles = 0;
+    SimSysTickPrescale = 0;
+    SimPrimask = 0;
+    SimActive = 0;
+    SimSysTickPending = false;
+    SimPendSVPending = false;
+    memset(SimEnabled, 0, sizeof(SimEnabled));
+    memset(SimPending, 0, sizeof(SimPending));
+    memset(SimLines, 0, sizeof(SimLines));
+    memset(SimTaken, 0, sizeof(SimTaken));
+    SimExclusiveAddress = 0;
+    SimStrexFailures = 0;
+
+    SIM_RCC_Reset();
+    SIM_GPIO_Reset();
+    SIM_SPI_Reset();
+    SIM_USART_Reset();
+    SIM_TIMER_Reset();
+}
+
+void SIM_Poll(void){
+    SIM_Advance(SIM_CYCLES_PER_ACCESS);
+    SIM_Dispatch();
+}
+
+void SIM_Write(const volatile void *reg){
+    if(!SIM_CoreWrite(reg) && !SIM_RCC_Write(reg) && !SIM_GPIO_Write(reg) && !SIM_SPI_Write(reg) && !SIM_USART_Write(reg))
+        SIM_TIMER_Write(reg);
+    SIM_Poll();
+}
+
+void SIM_Read(const volatile void *reg){
+    if(reg == &SIM_SysTick.CTRL)
+        SIM_SysTick.CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;    // Cleared by reading CTRL
+    else if(!SIM_RCC_Read(reg) && !SIM_GPIO_Read(reg) && !SIM_SPI_Read(reg) && !SIM_USART_Read(reg))
+        SIM_TIMER_Read(reg);
+    SIM_Poll();
+}
+
+void SIM_Run(uint64_t cycles){
+    while(cycles > 0){
+        uint32_t step = cycles < SIM_RUN_STEP ? (uint32_t)cycles : SIM_RUN_STEP;
+        SIM_Advance(step);
+        SIM_Dispatch();
+        cycles -= step;
+    }
+}
+
+uint64_t SIM_GetCycles(void){
+    return SimCycles;
+}
+
+uint32_t SIM_GetCoreClockHz(void){
+    return SIM_RCC_GetCoreClockHz();
+}
+
+void SIM_SetPrimask(uint32_t primask){
+    SimPrimask = primask & 1;
+    SIM_Dispatch();
+}
+
+uint32_t SIM_GetPrimask(void){
+    return SimPrimask;
+}
+
+uint32_t SIM_GetIpsr(void){
+    return SimActive;
+}
+
+void SIM_Wfi(void){
+    uint64_t start = SimCycles;
+    while(SIM_NextException() == 0){
+        if(SimCycles - start > SIM_WFI_LIMIT)
+            SIM_Fatal("__WFI with nothing left to wake the core");
+        SIM_Advance(SIM_RUN_STEP);
+    }
+    SIM_Dispatch();                                 // Wakes even with PRIMASK set, the handler then waits for __enable_irq
+}
+
+uint32_t SIM_Ldrex(volatile uint32_t *address){
+    uint32_t value = *address;
+    SimExclusiveAddress = address;
+    SIM_Poll();                                     // An interrupt can come in before the STREX
+    return value;
+}
+
+uint32_t SIM_Strex(uint32_t value, volatile uint32_t *address){
+    bool open = SimExclusiveAddress == address;
+    SimExclusiveAddress = 0;
+    if(open && SimStrexFailures > 0){
+        SimStrexFailures--;
+        open = false;
+    }
+    if(open)
+        *address = value;
+    SIM_Poll();
+    return open ? 0 : 1;
+}
+
+void SIM_Clrex(void){
+    SimExclusiveAddress = 0;
+}
+
+void SIM_BreakExclusive(void){
+    SimStrexFailures++;
+}
+
+void SIM_Fatal(const char *reason){
+    fprintf(stderr, "SIM: %s (At cycle %llu)\n", reason, (unsigned long long)SimCycles);
+    exit(EXIT_FAILURE);
+}
+
+void SIM_SetPending(IRQn_Type IRQn){
+    if(IRQn == SysTick_IRQn)
+        SimSysTickPending = true;
+    else if(IRQn == PendSV_IRQn)
+        SimPendSVPending = true;
+    else if(IRQn >= 0)
+        SimPending[IRQn >> 5] |= 1UL << (IRQn & 0x1F);
+    SIM_NvicUpdate();
+    SIM_Dispatch();
+}
+
+bool SIM_IsEnabled(IRQn_Type IRQn){
+    SIM_NvicUpdate();
+    return IRQn >= 0 && (SimEnabled[IRQn >> 5] & (1UL << (IRQn & 0x1F))) != 0;
+}
+
+uint32_t SIM_GetInterruptCount(IRQn_Type IRQn){
+    return SimTaken[IRQn + 16];
+}
+
+void SIM_RaiseLine(IRQn_Type IRQn){
+    SimLines[IRQn >> 5] |= 1UL << (IRQn & 0x1F);
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static void SIM_Advance(uint32_t cycles){
+    SimCycles += cycles;
+    if(SimCycles > SIM_CYCLE_LIMIT)
+        SIM_Fatal("The test ran too long (A wait that never ends?)");
+
+    SIM_SysTickUpdate(cycles);
+    if(SIM_IS_SET(SIM_CoreDebug.DEMCR, CoreDebug_DEMCR_TRCENA_Msk) && SIM_IS_SET(SIM_DWT.CTRL, DWT_CTRL_CYCCNTENA_Msk))
+        SIM_DWT.CYCCNT += cycles;
+
+    memset(SimLines, 0, sizeof(SimLines));
+    SIM_RCC_Update(cycles);
+    SIM_GPIO_Update(cycles);
+    SIM_SPI_Update(cycles);
+    SIM_USART_Update(cycles);
+    SIM_TIMER_Update(cycles);
+    SIM_NvicUpdate();
+}
+
+static void SIM_SysTickUpdate(uint32_t cycles){
+    if(!SIM_IS_SET(SIM_SysTick.CTRL, SysTick_CTRL_ENABLE_Msk))
+        return;
+
+    uint32_t ticks = cycles;
+    if(!SIM_IS_SET(SIM_SysTick.CTRL, SysTick_CTRL_CLKSOURCE_Msk)){  // External reference is HCLK / 8
+        SimSysTickPrescale += cycles;
+        ticks = SimSysTickPrescale / 8;
+        SimSysTickPrescale %= 8;
+    }
+
+    uint32_t value = SIM_SysTick.VAL & SysTick_VAL_CURRENT_Msk;
+    while(ticks > 0){
+        if(value == 0){                             // Reloading takes a tick
+            value = SIM_SysTick.LOAD & SysTick_LOAD_RELOAD_Msk;
+            ticks--;
+        } else if(ticks < value){
+            value -= ticks;
+            ticks = 0;
+        } else {                                    // Reaches 0
+            ticks -= value;
+            value = 0;
+            SIM_SysTick.CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+            if(SIM_IS_SET(SIM_SysTick.CTRL, SysTick_CTRL_TICKINT_Msk))
+                SimSysTickPending = true;
+        }
+    }
+    SIM_SysTick.VAL = value;
+}
+
+static void SIM_NvicUpdate(void){
+    for(uint32_t i = 0; i < SIM_IRQ_WORDS; i++){
+        SimEnabled[i] |= SIM_NVIC.ISER[i];
+        SimEnabled[i] &= ~SIM_NVIC.ICER[i];
+        SimPending[i] |= SIM_NVIC.ISPR[i];
+        SimPending[i] &= ~SIM_NVIC.ICPR[i];
+        uint32_t active = (SimActive >= 16 && (SimActive - 16) >> 5 == i) ? 1UL << ((SimActive - 16) & 0x1F) : 0;
+        SimPending[i] |= SimLines[i] & ~active; // A line that is still high pends again once its handler returns {See PM-122}
+
+        SIM_NVIC.ISER[i] = SimEnabled[i];
+        SIM_NVIC.ICER[i] = 0;                   // Reads 0 so the next write is seen (The MCU reads back ISER)
+        SIM_NVIC.ISPR[i] = SimPending[i];
+        SIM_NVIC.ICPR[i] = 0;
+        SIM_NVIC.IABR[i] = active;
+    }
+
+    uint32_t icsr = SIM_SCB.ICSR & ~(SCB_ICSR_PENDSTSET_Msk | SCB_ICSR_PENDSVSET_Msk | SCB_ICSR_VECTACTIVE_Msk);
+    if(SimSysTickPending)
+        icsr |= SCB_ICSR_PENDSTSET_Msk;
+    if(SimPendSVPending)
+        icsr |= SCB_ICSR_PENDSVSET_Msk;
+    SIM_SCB.ICSR = icsr | SimActive;
+}
+
+static uint32_t SIM_NextException(void){
+    uint32_t next = 0;
+    if(SimPendSVPending)
+        next = PendSV_IRQn + 16;
+    if(SimSysTickPending && (next == 0 || SIM_GetPriority(SysTick_IRQn + 16) < SIM_GetPriority(next)))
+        next = SysTick_IRQn + 16;
+    for(uint32_t irq = 0; irq < SIM_EXCEPTION_COUNT - 16; irq++){
+        uint32_t bit = 1UL << (irq & 0x1F);
+        if((SimPending[irq >> 5] & SimEnabled[irq >> 5] & bit) && (next == 0 || SIM_GetPriority(irq + 16) < SIM_GetPriority(next)))
+            next = irq + 16;                        // Ties go to the lower exception number
+    }
+    return next;
+}
+
+static uint8_t SIM_GetPriority(uint32_t exception){
+    if(exception >= 16)
+        return SIM_NVIC.IP[exception - 16] >> 4;
+    return SIM_SCB.SHP[exception - 4] >> 4;         // SHP[0] is MemManage (Exception 4)
+}
+
+static void SIM_Dispatch(void){
+    while(SimPrimask == 0 && SimActive == 0){
+        uint32_t exception = SIM_NextException();
+        if(exception == 0)
+            return;
+
+        if(exception == SysTick_IRQn + 16)
+            SimSysTickPending = false;
+        else if(exception == PendSV_IRQn + 16)
+            SimPendSVPending = false;
+        else {
+            SimPending[(exception - 16) >> 5] &= ~(1UL << ((exception - 16) & 0x1F));
+            SIM_NVIC.ISPR[(exception - 16) >> 5] = SimPending[(exception - 16) >> 5];   // Or SIM_NvicUpdate pends it again
+        }
+        SimExclusiveAddress = 0;                    // Exception entry clears the exclusive monitor
+        SimTaken[exception]++;
+        SimActive = exception;
+        SIM_Advance(SIM_ENTRY_CYCLES);
+
+        if(SIM_Vectors[exception] == 0){
+            char reason[64];
+            snprintf(reason, sizeof(reason), "Exception %u has no handler (Default_Handler)", (unsigned)exception);
+            SIM_Fatal(reason);
+        }
+        SIM_Vectors[exception]();
+
+        SimActive = 0;
+        SIM_Advance(0);                             // Lines the handler cleared do not pend again
+    }
+}
+
+static bool SIM_CoreWrite(const volatile void *reg){
+    if(reg == &SIM_SCB.ICSR){
+        uint32_t icsr = SIM_SCB.ICSR;
+        if(icsr & SCB_ICSR_PENDSTSET_Msk)
+            SimSysTickPending = true;
+        if(icsr & SCB_ICSR_PENDSTCLR_Msk)
+            SimSysTickPending = false;
+        if(icsr & SCB_ICSR_PENDSVSET_Msk)
+            SimPendSVPending = true;
+        if(icsr & SCB_ICSR_PENDSVCLR_Msk)
+            SimPendSVPending = false;
+        SIM_SCB.ICSR = icsr & ~(SCB_ICSR_PENDSTCLR_Msk | SCB_ICSR_PENDSVCLR_Msk);   // Write only
+    } else if(reg == &SIM_SysTick.VAL){
+        SIM_SysTick.VAL = 0;                        // Any write clears the counter and COUNTFLAG
+        SIM_SysTick.CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+    } else if(!((const volatile uint8_t*)reg >= (const volatile uint8_t*)&SIM_NVIC &&
+                (const volatile uint8_t*)reg < (const volatile uint8_t*)&SIM_NVIC + sizeof(SIM_NVIC))){
+        return false;                               // Nothing else on the core has write side effects
+    }
+    return true;                                    // NVIC writes are picked up by SIM_NvicUpdate
+}
+#pragma endregion
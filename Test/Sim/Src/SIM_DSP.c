@@ -0,0 +1,43 @@
+/**
+ * @file SIM_DSP.c
+ * @author Devin Marx
+ * @brief C versions of the CMSIS-DSP assembly kernels (arm_bitreversal2.S), so the host tests link the vendored library
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "arm_math.h"
+
+/// @brief Swaps the complex q31/f32 pairs the bit reversal table lists (Same as arm_bitreversal_32 in arm_bitreversal2.S)
+/// @param pSrc Complex buffer (Real, imaginary, ...)
+/// @param bitRevLen Length of the table
+/// @param pBitRevTab Byte offsets of the pairs to swap (In pairs)
+void arm_bitreversal_32(uint32_t *pSrc, const uint16_t bitRevLen, const uint16_t *pBitRevTab){
+    for(uint32_t i = 0; i < bitRevLen; i += 2){
+        uint32_t a = pBitRevTab[i] >> 2;
+        uint32_t b = pBitRevTab[i + 1] >> 2;
+        uint32_t real = pSrc[a], imag = pSrc[a + 1];
+        pSrc[a] = pSrc[b];
+        pSrc[a + 1] = pSrc[b + 1];
+        pSrc[b] = real;
+        pSrc[b + 1] = imag;
+    }
+}
+
+/// @brief Swaps the complex q15 pairs the bit reversal table lists (Same as arm_bitreversal_16 in arm_bitreversal2.S)
+/// @param pSrc Complex buffer (Real, imaginary, ...)
+/// @param bitRevLen Length of the table
+/// @param pBitRevTab Offsets of the pairs to swap, scaled like the 32-bit table (In pairs)
+void arm_bitreversal_16(uint16_t *pSrc, const uint16_t bitRevLen, const uint16_t *pBitRevTab){
+    for(uint32_t i = 0; i < bitRevLen; i += 2){
+        uint32_t a = pBitRevTab[i] >> 2;
+        uint32_t b = pBitRevTab[i + 1] >> 2;
+        uint16_t real = pSrc[a], imag = pSrc[a + 1];
+        pSrc[a] = pSrc[b];
+        pSrc[a + 1] = pSrc[b + 1];
+        pSrc[b] = real;
+        pSrc[b + 1] = imag;
+    }
+}
@@ -0,0 +1,188 @@
+/**
+ * @file SIM_GPIO.c
+ * @author Devin Marx
+ * @brief Implementation of the simulated GPIO ports, AFIO, and EXTI
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <string.h>
+#include "SIM_MODELS.h"
+
+#define SIM_GPIO_PORTS 5    // GPIOA - GPIOE
+#define SIM_EXTI_LINES 16   // Lines 0 - 15 come from the GPIO pins
+
+GPIO_TypeDef SIM_GPIOA, SIM_GPIOB, SIM_GPIOC, SIM_GPIOD, SIM_GPIOE;
+AFIO_TypeDef SIM_AFIO;
+EXTI_TypeDef SIM_EXTI;
+
+typedef struct{
+    GPIO_TypeDef *GPIOx;
+    uint32_t clockEnable;       /**< RCC->APB2ENR bit of the port                 */
+    uint16_t drivenMask;        /**< Input pins a test drives                     */
+    uint16_t drivenLevel;       /**< Level of the driven pins                     */
+    uint16_t level;             /**< Pin levels at the last update (For edges)    */
+}SIM_Port;
+
+static SIM_Port SimPorts[SIM_GPIO_PORTS] = {
+    {&SIM_GPIOA, RCC_APB2ENR_IOPAEN, 0, 0, 0},
+    {&SIM_GPIOB, RCC_APB2ENR_IOPBEN, 0, 0, 0},
+    {&SIM_GPIOC, RCC_APB2ENR_IOPCEN, 0, 0, 0},
+    {&SIM_GPIOD, RCC_APB2ENR_IOPDEN, 0, 0, 0},
+    {&SIM_GPIOE, RCC_APB2ENR_IOPEEN, 0, 0, 0},
+};
+static uint32_t SimExtiPending;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Gets the simulated state of a port
+/// @param GPIOx Port (Ex. GPIOA)
+/// @return Port state, fails the test if GPIOx is not a port
+static SIM_Port* SIM_GPIO_GetPort(const GPIO_TypeDef *GPIOx);
+
+/// @brief Works out the level of every pin from CRL/CRH, ODR, and what the test drives
+/// @param port Port to update
+/// @return Pin levels
+static uint16_t SIM_GPIO_GetLevels(const SIM_Port *port);
+
+/// @brief Sets EXTI->PR for the edges between the last and the new pin levels of a port
+/// @param index Port number (0 = GPIOA, the EXTICR value)
+/// @param previous Levels at the last update
+/// @param current Levels now
+static void SIM_EXTI_Edges(uint8_t index, uint16_t previous, uint16_t current);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void SIM_GPIO_Reset(void){
+    for(uint8_t i = 0; i < SIM_GPIO_PORTS; i++){
+        GPIO_TypeDef *GPIOx = SimPorts[i].GPIOx;
+        memset(GPIOx, 0, sizeof(GPIO_TypeDef));
+        GPIOx->CRL = 0x44444444;                    // Floating inputs {See RM-171}
+        GPIOx->CRH = 0x44444444;
+        SimPorts[i].drivenMask = 0;
+        SimPorts[i].drivenLevel = 0;
+        SimPorts[i].level = 0;
+    }
+    memset(&SIM_AFIO, 0, sizeof(SIM_AFIO));
+    memset(&SIM_EXTI, 0, sizeof(SIM_EXTI));
+    SimExtiPending = 0;
+}
+
+void SIM_GPIO_Update(uint32_t cycles){
+    (void)cycles;
+
+    // Software interrupt events (SWIER) pend the line like an edge does
+    SimExtiPending |= SIM_EXTI.SWIER & SIM_EXTI.IMR;
+    SIM_EXTI.SWIER &= ~SimExtiPending;
+
+    for(uint8_t i = 0; i < SIM_GPIO_PORTS; i++){
+        SIM_Port *port = &SimPorts[i];
+        if(!SIM_IS_SET(SIM_RCC.APB2ENR, port->clockEnable))
+            continue;                               // IDR is not sampled without the port clock
+        uint16_t levels = SIM_GPIO_GetLevels(port);
+        SIM_EXTI_Edges(i, port->level, levels);
+        port->level = levels;
+        port->GPIOx->IDR = levels;
+    }
+    SIM_EXTI.PR = SimExtiPending;
+
+    static const IRQn_Type lines[SIM_EXTI_LINES] = {
+        EXTI0_IRQn, EXTI1_IRQn, EXTI2_IRQn, EXTI3_IRQn, EXTI4_IRQn,
+        EXTI9_5_IRQn, EXTI9_5_IRQn, EXTI9_5_IRQn, EXTI9_5_IRQn, EXTI9_5_IRQn,
+        EXTI15_10_IRQn, EXTI15_10_IRQn, EXTI15_10_IRQn, EXTI15_10_IRQn, EXTI15_10_IRQn, EXTI15_10_IRQn
+    };
+    uint32_t requests = SimExtiPending & SIM_EXTI.IMR;
+    for(uint8_t line = 0; line < SIM_EXTI_LINES; line++)
+        if(requests & (1UL << line))
+            SIM_RaiseLine(lines[line]);
+}
+
+bool SIM_GPIO_Write(const volatile void *reg){
+    if(reg == &SIM_EXTI.PR){
+        SimExtiPending &= ~SIM_EXTI.PR;             // Write 1 to clear
+        SIM_EXTI.PR = SimExtiPending;
+        return true;
+    }
+    for(uint8_t i = 0; i < SIM_GPIO_PORTS; i++){
+        GPIO_TypeDef *GPIOx = SimPorts[i].GPIOx;
+        if(reg == &GPIOx->BSRR){                    // Set the low half, reset the high half (Set wins)
+            uint32_t bsrr = GPIOx->BSRR;
+            GPIOx->ODR = (GPIOx->ODR & ~(bsrr >> 16)) | (bsrr & 0xFFFF);
+            GPIOx->BSRR = 0;
+            return true;
+        }
+        if(reg == &GPIOx->BRR){
+            GPIOx->ODR &= ~(GPIOx->BRR & 0xFFFF);
+            GPIOx->BRR = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SIM_GPIO_Read(const volatile void *reg){
+    (void)reg;
+    return false;                                   // No read side effects
+}
+
+void SIM_GPIO_Drive(GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN, bool high){
+    SIM_Port *port = SIM_GPIO_GetPort(GPIOx);
+    port->drivenMask |= GPIO_PIN;
+    if(high)
+        port->drivenLevel |= GPIO_PIN;
+    else
+        port->drivenLevel &= ~GPIO_PIN;
+    SIM_Poll();
+}
+
+void SIM_GPIO_Release(GPIO_TypeDef *GPIOx, uint16_t GPIO_PIN){
+    SIM_Port *port = SIM_GPIO_GetPort(GPIOx);
+    port->drivenMask &= ~GPIO_PIN;
+    SIM_Poll();
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static SIM_Port* SIM_GPIO_GetPort(const GPIO_TypeDef *GPIOx){
+    for(uint8_t i = 0; i < SIM_GPIO_PORTS; i++)
+        if(SimPorts[i].GPIOx == GPIOx)
+            return &SimPorts[i];
+    SIM_Fatal("Not a GPIO port");
+}
+
+static uint16_t SIM_GPIO_GetLevels(const SIM_Port *port){
+    uint16_t levels = 0;
+    for(uint8_t pin = 0; pin < 16; pin++){
+        uint32_t config = ((pin < 8 ? port->GPIOx->CRL : port->GPIOx->CRH) >> ((pin % 8) * 4)) & 0xF;
+        uint32_t mode = config & 0b11;
+        uint32_t cnf = config >> 2;
+        uint16_t bit = 1U << pin;
+        bool high;
+        if(mode != 0)                               // Output, the pin reads back what it drives
+            high = (port->GPIOx->ODR & bit) != 0;
+        else if(port->drivenMask & bit)             // Input driven by the test
+            high = (port->drivenLevel & bit) != 0;
+        else if(cnf == 0b10)                        // Pull-up / pull-down picked by ODR
+            high = (port->GPIOx->ODR & bit) != 0;
+        else                                        // Floating or analog
+            high = false;
+        if(high)
+            levels |= bit;
+    }
+    return levels;
+}
+
+static void SIM_EXTI_Edges(uint8_t index, uint16_t previous, uint16_t current){
+    uint16_t rising = current & ~previous;
+    uint16_t falling = previous & ~current;
+    for(uint8_t line = 0; line < SIM_EXTI_LINES; line++){
+        uint32_t source = (SIM_AFIO.EXTICR[line / 4] >> ((line % 4) * 4)) & 0xF;
+        if(source != index)
+            continue;                               // The line listens to another port
+        uint32_t bit = 1UL << line;
+        if(((rising & bit) && (SIM_EXTI.RTSR & bit)) || ((falling & bit) && (SIM_EXTI.FTSR & bit)))
+            SimExtiPending |= bit;
+    }
+}
+#pragma endregion
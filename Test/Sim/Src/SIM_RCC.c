@@ -0,0 +1,273 @@
+/**
+ * @file SIM_RCC.c
+ * @author Devin Marx
+ * @brief Implementation of the simulated clock tree, FLASH controller, CRC unit, and IWDG
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <string.h>
+#include "SIM_MODELS.h"
+
+#define SIM_FLASH_PAGE_SIZE 1024            // Bytes in a flash page of the STM32F103xB
+#define SIM_CRC_POLYNOMIAL  0x04C11DB7UL    // CRC-32 (Ethernet), MSB first, no reflection or final XOR {See RM-65}
+#define SIM_IWDG_KEY_RELOAD 0xAAAA
+#define SIM_IWDG_KEY_UNLOCK 0x5555
+#define SIM_IWDG_KEY_START  0xCCCC
+
+RCC_TypeDef SIM_RCC;
+FLASH_TypeDef SIM_FLASH;
+CRC_TypeDef SIM_CRC;
+IWDG_TypeDef SIM_IWDG;
+DBGMCU_TypeDef SIM_DBGMCU;
+
+// Calibration page (The linker script puts _scalibration at the last flash page). Erased at startup, and kept
+// through SIM_Reset like flash is kept through a reset
+uint32_t _scalibration[SIM_FLASH_PAGE_SIZE / sizeof(uint32_t)] = {[0 ... SIM_FLASH_PAGE_SIZE / sizeof(uint32_t) - 1] = 0xFFFFFFFF};
+
+static bool SimFlashLocked;
+static uint8_t SimFlashKeys;                // FLASH_KEY1/FLASH_KEY2 written in order so far
+static uint32_t SimFlashCR;
+static uint32_t SimFlashSR;
+static uint32_t SimCrc;
+static bool SimIwdgRunning;
+static bool SimIwdgUnlocked;
+static uint32_t SimIwdgPR;
+static uint32_t SimIwdgRLR;
+static uint32_t SimIwdgCounter;
+static uint64_t SimIwdgFraction;            // Cycles * LSI Hz towards the next IWDG tick
+static uint32_t SimIwdgResets;
+static uint32_t SimIwdgReloads;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Gets the divider of the AHB prescaler (HPRE)
+/// @return 1 - 512
+static uint32_t SIM_RCC_GetAhbDivider(void);
+
+/// @brief Handles a write to FLASH->CR (Lock, page erase)
+static void SIM_FLASH_WriteCR(void);
+
+/// @brief Runs a word through the CRC unit
+/// @param crc Current CRC
+/// @param word Word written to CRC->DR
+/// @return New CRC
+static uint32_t SIM_CRC_Step(uint32_t crc, uint32_t word);
+
+/// @brief Handles a write to IWDG->KR
+static void SIM_IWDG_WriteKR(void);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void SIM_RCC_Reset(void){
+    memset(&SIM_RCC, 0, sizeof(SIM_RCC));
+    SIM_RCC.CR = 0x00000083;                        // HSION, HSIRDY, HSITRIM = 16 {See RM-99}
+    SIM_RCC.AHBENR = RCC_AHBENR_SRAMEN | RCC_AHBENR_FLITFEN;
+    SIM_RCC.CSR = RCC_CSR_PORRSTF | RCC_CSR_PINRSTF;// Power on
+
+    memset(&SIM_FLASH, 0, sizeof(SIM_FLASH));
+    SIM_FLASH.ACR = FLASH_ACR_PRFTBE | FLASH_ACR_PRFTBS;
+    SIM_FLASH.CR = FLASH_CR_LOCK;
+    SimFlashLocked = true;
+    SimFlashKeys = 0;
+    SimFlashCR = SIM_FLASH.CR;
+    SimFlashSR = 0;
+
+    memset(&SIM_CRC, 0, sizeof(SIM_CRC));
+    SIM_CRC.DR = 0xFFFFFFFF;
+    SimCrc = 0xFFFFFFFF;
+
+    memset(&SIM_IWDG, 0, sizeof(SIM_IWDG));
+    SIM_IWDG.RLR = 0xFFF;
+    SimIwdgRunning = false;
+    SimIwdgUnlocked = false;
+    SimIwdgPR = 0;
+    SimIwdgRLR = 0xFFF;
+    SimIwdgCounter = 0xFFF;
+    SimIwdgFraction = 0;
+    SimIwdgResets = 0;
+    SimIwdgReloads = 0;
+
+    memset(&SIM_DBGMCU, 0, sizeof(SIM_DBGMCU));
+    SIM_DBGMCU.IDCODE = 0x20036410;                 // Medium density, revision X
+}
+
+void SIM_RCC_Update(uint32_t cycles){
+    // Oscillators are ready as soon as they are turned on, and SWS follows SW once the source is ready
+    uint32_t cr = SIM_RCC.CR & ~(RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY);
+    if(cr & RCC_CR_HSION)
+        cr |= RCC_CR_HSIRDY;
+    if(cr & RCC_CR_HSEON)
+        cr |= RCC_CR_HSERDY;
+    if(cr & RCC_CR_PLLON)
+        cr |= RCC_CR_PLLRDY;
+    SIM_RCC.CR = cr;
+
+    uint32_t sw = SIM_RCC.CFGR & RCC_CFGR_SW_Msk;
+    static const uint32_t ready[] = {RCC_CR_HSIRDY, RCC_CR_HSERDY, RCC_CR_PLLRDY, 0};
+    if(cr & ready[sw])
+        SIM_RCC.CFGR = (SIM_RCC.CFGR & ~RCC_CFGR_SWS_Msk) | (sw << RCC_CFGR_SWS_Pos);
+
+    if(SIM_IS_SET(SIM_RCC.CSR, RCC_CSR_LSION) || SimIwdgRunning)
+        SIM_RCC.CSR |= RCC_CSR_LSIRDY;
+
+    // The prefetch buffer status follows its enable
+    if(SIM_IS_SET(SIM_FLASH.ACR, FLASH_ACR_PRFTBE))
+        SIM_FLASH.ACR |= FLASH_ACR_PRFTBS;
+    else
+        SIM_FLASH.ACR &= ~FLASH_ACR_PRFTBS;
+
+    // IWDG counts down on the LSI, a reset each time it reaches 0 (The test sees it through SIM_IWDG_GetResetCount)
+    if(SimIwdgRunning && cycles > 0){
+        uint64_t cyclesPerTick = (uint64_t)SIM_RCC_GetCoreClockHz() * (4UL << SimIwdgPR);
+        SimIwdgFraction += (uint64_t)cycles * SIM_LSI_HZ;
+        while(SimIwdgFraction >= cyclesPerTick){
+            SimIwdgFraction -= cyclesPerTick;
+            if(SimIwdgCounter == 0){
+                SimIwdgResets++;
+                SIM_RCC.CSR |= RCC_CSR_IWDGRSTF;
+                SimIwdgCounter = SimIwdgRLR;
+            } else {
+                SimIwdgCounter--;
+            }
+        }
+    }
+    SIM_IWDG.SR = 0;                                // PR and RLR updates are instant
+}
+
+bool SIM_RCC_Write(const volatile void *reg){
+    if(reg == &SIM_RCC.CSR){
+        if(SIM_RCC.CSR & RCC_CSR_RMVF)              // Clears every reset flag
+            SIM_RCC.CSR &= ~(RCC_CSR_RMVF | RCC_CSR_PINRSTF | RCC_CSR_PORRSTF | RCC_CSR_SFTRSTF |
+                             RCC_CSR_IWDGRSTF | RCC_CSR_WWDGRSTF | RCC_CSR_LPWRRSTF);
+    } else if(reg == &SIM_FLASH.KEYR){
+        uint32_t key = SIM_FLASH.KEYR;
+        SIM_FLASH.KEYR = 0;                         // Write only
+        if(SimFlashKeys == 0 && key == FLASH_KEY1)
+            SimFlashKeys = 1;
+        else if(SimFlashKeys == 1 && key == FLASH_KEY2){
+            SimFlashLocked = false;
+            SimFlashKeys = 0;
+            SimFlashCR &= ~FLASH_CR_LOCK;
+            SIM_FLASH.CR = SimFlashCR;
+        } else
+            SimFlashKeys = 0;                       // Wrong sequence, locked until the next reset on the MCU
+    } else if(reg == &SIM_FLASH.CR){
+        SIM_FLASH_WriteCR();
+    } else if(reg == &SIM_FLASH.SR){
+        SimFlashSR &= ~(SIM_FLASH.SR & (FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPRTERR));   // Write 1 to clear
+        SIM_FLASH.SR = SimFlashSR;
+    } else if(reg == &SIM_CRC.CR){
+        if(SIM_CRC.CR & CRC_CR_RESET)
+            SimCrc = 0xFFFFFFFF;
+        SIM_CRC.CR = 0;                             // RESET clears itself
+        SIM_CRC.DR = SimCrc;
+    } else if(reg == &SIM_CRC.DR){
+        if(SIM_IS_SET(SIM_RCC.AHBENR, RCC_AHBENR_CRCEN))
+            SimCrc = SIM_CRC_Step(SimCrc, SIM_CRC.DR);
+        SIM_CRC.DR = SimCrc;
+    } else if(reg == &SIM_IWDG.KR){
+        SIM_IWDG_WriteKR();
+    } else if(reg == &SIM_IWDG.PR || reg == &SIM_IWDG.RLR){
+        if(SimIwdgUnlocked){                        // Ignored unless 0x5555 was written to KR first
+            SimIwdgPR = SIM_IWDG.PR & IWDG_PR_PR_Msk;
+            SimIwdgRLR = SIM_IWDG.RLR & IWDG_RLR_RL_Msk;
+        }
+        SIM_IWDG.PR = SimIwdgPR;
+        SIM_IWDG.RLR = SimIwdgRLR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool SIM_RCC_Read(const volatile void *reg){
+    return reg == &SIM_RCC.CSR || reg == &SIM_CRC.DR || reg == &SIM_IWDG.SR;   // No read side effects
+}
+
+uint32_t SIM_RCC_GetCoreClockHz(void){
+    uint32_t sysclk;
+    switch((SIM_RCC.CFGR & RCC_CFGR_SWS_Msk) >> RCC_CFGR_SWS_Pos){
+        case 1:                                     // HSE
+            sysclk = SIM_HSE_HZ;
+            break;
+        case 2: {                                   // PLL
+            uint32_t multiplier = ((SIM_RCC.CFGR & RCC_CFGR_PLLMULL_Msk) >> RCC_CFGR_PLLMULL_Pos) + 2;
+            if(multiplier > 16)
+                multiplier = 16;                    // 0b1111 is also x16 {See RM-101}
+            uint32_t source = SIM_HSI_HZ / 2;
+            if(SIM_IS_SET(SIM_RCC.CFGR, RCC_CFGR_PLLSRC))
+                source = SIM_IS_SET(SIM_RCC.CFGR, RCC_CFGR_PLLXTPRE) ? SIM_HSE_HZ / 2 : SIM_HSE_HZ;
+            sysclk = source * multiplier;
+            break;
+        }
+        default:                                    // HSI
+            sysclk = SIM_HSI_HZ;
+            break;
+    }
+    return sysclk / SIM_RCC_GetAhbDivider();
+}
+
+uint32_t SIM_IWDG_GetResetCount(void){
+    return SimIwdgResets;
+}
+
+uint32_t SIM_IWDG_GetReloadCount(void){
+    return SimIwdgReloads;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static uint32_t SIM_RCC_GetAhbDivider(void){
+    static const uint16_t dividers[] = {2, 4, 8, 16, 64, 128, 256, 512};
+    uint32_t hpre = (SIM_RCC.CFGR & RCC_CFGR_HPRE_Msk) >> RCC_CFGR_HPRE_Pos;
+    return (hpre & 0b1000) ? dividers[hpre & 0b111] : 1;
+}
+
+static void SIM_FLASH_WriteCR(void){
+    uint32_t cr = SIM_FLASH.CR;
+    if(SimFlashLocked){                             // Writes are ignored while locked
+        SIM_FLASH.CR = SimFlashCR;
+        return;
+    }
+    if(cr & FLASH_CR_LOCK)
+        SimFlashLocked = true;
+
+    if((cr & FLASH_CR_STRT) && (cr & FLASH_CR_PER)){
+        uint8_t *page = (uint8_t*)_scalibration;
+        uint32_t address = SIM_FLASH.AR;
+        if(address >= (uint32_t)(uintptr_t)page && address < (uint32_t)(uintptr_t)page + SIM_FLASH_PAGE_SIZE)
+            memset(page, 0xFF, SIM_FLASH_PAGE_SIZE);
+        else
+            SimFlashSR |= FLASH_SR_WRPRTERR;        // Only the calibration page is simulated, the program can not be erased
+        SimFlashSR |= FLASH_SR_EOP;
+        cr &= ~FLASH_CR_STRT;                       // Cleared when the erase is done
+    }
+    SimFlashCR = cr;
+    SIM_FLASH.CR = cr;
+    SIM_FLASH.SR = SimFlashSR;
+}
+
+static uint32_t SIM_CRC_Step(uint32_t crc, uint32_t word){
+    crc ^= word;
+    for(uint8_t bit = 0; bit < 32; bit++)
+        crc = (crc & 0x80000000UL) ? (crc << 1) ^ SIM_CRC_POLYNOMIAL : crc << 1;
+    return crc;
+}
+
+static void SIM_IWDG_WriteKR(void){
+    uint32_t key = SIM_IWDG.KR & IWDG_KR_KEY_Msk;
+    SIM_IWDG.KR = 0;                                // Write only
+    if(key == SIM_IWDG_KEY_START){
+        SimIwdgRunning = true;
+        SimIwdgCounter = SimIwdgRLR;
+    } else if(key == SIM_IWDG_KEY_UNLOCK){
+        SimIwdgUnlocked = true;
+    } else if(key == SIM_IWDG_KEY_RELOAD){
+        SimIwdgUnlocked = false;                    // Reloading protects PR and RLR again
+        SimIwdgCounter = SimIwdgRLR;
+        SimIwdgReloads++;
+    }
+}
+#pragma endregion
@@ -0,0 +1,173 @@
+/**
+ * @file SIM_SPI.c
+ * @author Devin Marx
+ * @brief Implementation of the simulated SPI1 and SPI2 (Frames go out the moment DR is written, BSY is never set)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <string.h>
+#include "SIM_MODELS.h"
+
+#define SIM_SPI_COUNT 2     // SPI1, SPI2
+
+SPI_TypeDef SIM_SPI1, SIM_SPI2;
+
+typedef struct{
+    SPI_TypeDef *SPIx;
+    volatile uint32_t *clockRegister;   /**< RCC enable register of the SPI         */
+    uint32_t clockEnable;               /**< RCC enable bit of the SPI              */
+    IRQn_Type IRQn;
+    SIM_SpiDevice device;               /**< Device on the bus (Master mode)        */
+    uint16_t rxData;                    /**< Receive buffer (What DR reads)         */
+    uint16_t txData;                    /**< Frame a slave sends on the next clock  */
+    bool rxne;
+    bool overrun;
+    uint32_t frames;
+}SIM_Spi;
+
+static SIM_Spi SimSpis[SIM_SPI_COUNT] = {
+    {&SIM_SPI1, &SIM_RCC.APB2ENR, RCC_APB2ENR_SPI1EN, SPI1_IRQn, 0, 0, 0, false, false, 0},
+    {&SIM_SPI2, &SIM_RCC.APB1ENR, RCC_APB1ENR_SPI2EN, SPI2_IRQn, 0, 0, 0, false, false, 0},
+};
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Gets the simulated state of an SPI
+/// @param SPIx SPI (Ex. SPI1)
+/// @return SPI state, 0 if SPIx is not an SPI
+static SIM_Spi* SIM_SPI_Get(const SPI_TypeDef *SPIx);
+
+/// @brief Checks if an SPI has its clock and SPE on
+/// @param spi SPI state
+/// @return True if it can send and receive
+static bool SIM_SPI_IsRunning(const SIM_Spi *spi);
+
+/// @brief Puts a frame in the receive buffer (Overrun if the last one was not read)
+/// @param spi SPI state
+/// @param frame Frame received
+static void SIM_SPI_Receive(SIM_Spi *spi, uint16_t frame);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void SIM_SPI_Reset(void){
+    for(uint8_t i = 0; i < SIM_SPI_COUNT; i++){
+        SIM_Spi *spi = &SimSpis[i];
+        memset(spi->SPIx, 0, sizeof(SPI_TypeDef));
+        spi->SPIx->SR = SPI_SR_TXE;
+        spi->SPIx->CRCPR = 0x0007;
+        spi->device = 0;
+        spi->rxData = 0;
+        spi->txData = 0;
+        spi->rxne = false;
+        spi->overrun = false;
+        spi->frames = 0;
+    }
+}
+
+void SIM_SPI_Update(uint32_t cycles){
+    (void)cycles;
+    for(uint8_t i = 0; i < SIM_SPI_COUNT; i++){
+        SIM_Spi *spi = &SimSpis[i];
+        if(!SIM_IS_SET(*spi->clockRegister, spi->clockEnable)){
+            spi->SPIx->SR = 0;                      // Reads 0 without its clock, so every wait on a flag times out
+            continue;
+        }
+        spi->SPIx->SR = SPI_SR_TXE | (spi->rxne ? SPI_SR_RXNE : 0) | (spi->overrun ? SPI_SR_OVR : 0);
+
+        uint32_t cr2 = spi->SPIx->CR2;
+        if(((cr2 & SPI_CR2_RXNEIE) && spi->rxne) || (cr2 & SPI_CR2_TXEIE) || ((cr2 & SPI_CR2_ERRIE) && spi->overrun))
+            SIM_RaiseLine(spi->IRQn);
+    }
+}
+
+bool SIM_SPI_Write(const volatile void *reg){
+    for(uint8_t i = 0; i < SIM_SPI_COUNT; i++){
+        SIM_Spi *spi = &SimSpis[i];
+        if(reg != &spi->SPIx->DR)
+            continue;
+
+        uint16_t mask = SIM_IS_SET(spi->SPIx->CR1, SPI_CR1_DFF) ? 0xFFFF : 0xFF;
+        uint16_t frame = spi->SPIx->DR & mask;
+        spi->SPIx->DR = spi->rxData;                // DR reads the receive buffer, not what was written
+        if(!SIM_SPI_IsRunning(spi))
+            return true;
+
+        if(SIM_IS_SET(spi->SPIx->CR1, SPI_CR1_MSTR)){
+            spi->frames++;
+            uint16_t miso = spi->device != 0 ? spi->device(spi->SPIx, frame) : 0;
+            SIM_SPI_Receive(spi, miso & mask);
+        } else {
+            spi->txData = frame;                    // Goes out when the master clocks the next frame
+        }
+        return true;
+    }
+    return false;
+}
+
+bool SIM_SPI_Read(const volatile void *reg){
+    for(uint8_t i = 0; i < SIM_SPI_COUNT; i++){
+        SIM_Spi *spi = &SimSpis[i];
+        if(reg == &spi->SPIx->DR){
+            spi->rxne = false;                      // Reading DR clears RXNE
+            return true;
+        }
+        if(reg == &spi->SPIx->SR){
+            if(!spi->rxne)
+                spi->overrun = false;               // Reading DR then SR clears OVR
+            return true;
+        }
+    }
+    return false;
+}
+
+void SIM_SPI_Attach(SPI_TypeDef *SPIx, SIM_SpiDevice device){
+    SIM_Spi *spi = SIM_SPI_Get(SPIx);
+    if(spi == 0)
+        SIM_Fatal("SIM_SPI_Attach: not an SPI");
+    spi->device = device;
+}
+
+uint16_t SIM_SPI_SlaveTransfer(SPI_TypeDef *SPIx, uint16_t frame){
+    SIM_Spi *spi = SIM_SPI_Get(SPIx);
+    if(spi == 0 || SIM_IS_SET(SPIx->CR1, SPI_CR1_MSTR))
+        SIM_Fatal("SIM_SPI_SlaveTransfer: not an SPI in slave mode");
+
+    uint16_t sent = spi->txData;
+    if(SIM_SPI_IsRunning(spi)){
+        uint16_t mask = SIM_IS_SET(SPIx->CR1, SPI_CR1_DFF) ? 0xFFFF : 0xFF;
+        SIM_SPI_Receive(spi, frame & mask);
+        spi->txData = 0;                            // Nothing new written, the next frame sends 0
+    }
+    SIM_Poll();
+    return sent;
+}
+
+uint32_t SIM_SPI_GetFrameCount(const SPI_TypeDef *SPIx){
+    const SIM_Spi *spi = SIM_SPI_Get(SPIx);
+    return spi != 0 ? spi->frames : 0;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static SIM_Spi* SIM_SPI_Get(const SPI_TypeDef *SPIx){
+    for(uint8_t i = 0; i < SIM_SPI_COUNT; i++)
+        if(SimSpis[i].SPIx == SPIx)
+            return &SimSpis[i];
+    return 0;
+}
+
+static bool SIM_SPI_IsRunning(const SIM_Spi *spi){
+    return SIM_IS_SET(*spi->clockRegister, spi->clockEnable) && SIM_IS_SET(spi->SPIx->CR1, SPI_CR1_SPE);
+}
+
+static void SIM_SPI_Receive(SIM_Spi *spi, uint16_t frame){
+    if(spi->rxne)
+        spi->overrun = true;                        // The old frame is kept {See RM-716}
+    else
+        spi->rxData = frame;
+    spi->rxne = true;
+    spi->SPIx->DR = spi->rxData;
+}
+#pragma endregion
@@ -0,0 +1,116 @@
+/**
+ * @file SIM_TIMER.c
+ * @author Devin Marx
+ * @brief Implementation of the simulated TIM1 - TIM4 (Up counting, update events only)
+ *
+ * The counters run on the core clock, the same clock TIMER_TICK_Init and TIMER_PWM_Init work their periods out from.
+ *
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <string.h>
+#include "SIM_MODELS.h"
+
+#define SIM_TIMER_COUNT 4   // TIM1, TIM2, TIM3, TIM4
+
+TIM_TypeDef SIM_TIM1, SIM_TIM2, SIM_TIM3, SIM_TIM4;
+
+typedef struct{
+    TIM_TypeDef *TIMx;
+    volatile uint32_t *clockRegister;   /**< RCC enable register of the timer                           */
+    uint32_t clockEnable;               /**< RCC enable bit of the timer                                */
+    IRQn_Type IRQn;                     /**< Update interrupt                                           */
+    uint32_t prescaler;                 /**< PSC in use (PSC is loaded at the next update event)        */
+    uint32_t prescaleCount;             /**< Cycles towards the next counter tick                       */
+    uint32_t status;                    /**< SR (Flags are only set by the timer)                       */
+}SIM_Timer;
+
+static SIM_Timer SimTimers[SIM_TIMER_COUNT] = {
+    {&SIM_TIM1, &SIM_RCC.APB2ENR, RCC_APB2ENR_TIM1EN, TIM1_UP_IRQn, 0, 0, 0},
+    {&SIM_TIM2, &SIM_RCC.APB1ENR, RCC_APB1ENR_TIM2EN, TIM2_IRQn, 0, 0, 0},
+    {&SIM_TIM3, &SIM_RCC.APB1ENR, RCC_APB1ENR_TIM3EN, TIM3_IRQn, 0, 0, 0},
+    {&SIM_TIM4, &SIM_RCC.APB1ENR, RCC_APB1ENR_TIM4EN, TIM4_IRQn, 0, 0, 0},
+};
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Generates an update event (Loads PSC, sets UIF unless UDIS is set)
+/// @param timer Timer state
+static void SIM_TIMER_UpdateEvent(SIM_Timer *timer);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void SIM_TIMER_Reset(void){
+    for(uint8_t i = 0; i < SIM_TIMER_COUNT; i++){
+        SIM_Timer *timer = &SimTimers[i];
+        memset(timer->TIMx, 0, sizeof(TIM_TypeDef));
+        timer->TIMx->ARR = 0xFFFF;
+        timer->prescaler = 0;
+        timer->prescaleCount = 0;
+        timer->status = 0;
+    }
+}
+
+void SIM_TIMER_Update(uint32_t cycles){
+    for(uint8_t i = 0; i < SIM_TIMER_COUNT; i++){
+        SIM_Timer *timer = &SimTimers[i];
+        TIM_TypeDef *TIMx = timer->TIMx;
+        if(SIM_IS_SET(*timer->clockRegister, timer->clockEnable) && SIM_IS_SET(TIMx->CR1, TIM_CR1_CEN) && cycles > 0){
+            timer->prescaleCount += cycles;
+            uint32_t ticks = timer->prescaleCount / (timer->prescaler + 1);
+            timer->prescaleCount %= timer->prescaler + 1;
+
+            uint32_t period = (TIMx->ARR & 0xFFFF) + 1;
+            uint64_t count = (uint64_t)(TIMx->CNT & 0xFFFF) + ticks;
+            if(count >= period){                    // Overflowed at least once
+                count %= period;
+                SIM_TIMER_UpdateEvent(timer);
+            }
+            TIMx->CNT = (uint32_t)count;
+        }
+
+        TIMx->SR = timer->status;
+        if(timer->status & TIMx->DIER & TIM_DIER_UIE)
+            SIM_RaiseLine(timer->IRQn);
+    }
+}
+
+bool SIM_TIMER_Write(const volatile void *reg){
+    for(uint8_t i = 0; i < SIM_TIMER_COUNT; i++){
+        SIM_Timer *timer = &SimTimers[i];
+        TIM_TypeDef *TIMx = timer->TIMx;
+        if(reg == &TIMx->SR){
+            timer->status &= TIMx->SR;              // rc_w0, writing 1 leaves a flag alone
+            TIMx->SR = timer->status;
+            return true;
+        }
+        if(reg == &TIMx->EGR){
+            if(TIMx->EGR & TIM_EGR_UG){             // Restarts the counter and the prescaler
+                TIMx->CNT = 0;
+                timer->prescaleCount = 0;
+                SIM_TIMER_UpdateEvent(timer);
+            }
+            TIMx->EGR = 0;                          // Cleared by hardware
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SIM_TIMER_Read(const volatile void *reg){
+    (void)reg;
+    return false;                                   // No read side effects
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static void SIM_TIMER_UpdateEvent(SIM_Timer *timer){
+    if(SIM_IS_SET(timer->TIMx->CR1, TIM_CR1_UDIS))
+        return;
+    timer->prescaler = timer->TIMx->PSC & 0xFFFF;
+    timer->status |= TIM_SR_UIF;
+    timer->TIMx->SR = timer->status;
+}
+#pragma endregion
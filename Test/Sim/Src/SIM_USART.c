@@ -0,0 +1,149 @@
+/**
+ * @file SIM_USART.c
+ * @author Devin Marx
+ * @brief Implementation of the simulated USART1 - USART3 (Bytes go out the moment DR is written, so TXE stays set)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <string.h>
+#include "SIM_MODELS.h"
+
+#define SIM_USART_COUNT 3   // USART1, USART2, USART3
+
+USART_TypeDef SIM_USART1, SIM_USART2, SIM_USART3;
+
+typedef struct{
+    USART_TypeDef *USARTx;
+    volatile uint32_t *clockRegister;           /**< RCC enable register of the USART   */
+    uint32_t clockEnable;                       /**< RCC enable bit of the USART        */
+    IRQn_Type IRQn;
+    char output[SIM_USART_BUFFER_SIZE];         /**< Bytes transmitted                  */
+    uint32_t outputLength;
+    char input[SIM_USART_BUFFER_SIZE];          /**< Bytes waiting to be received       */
+    uint32_t inputHead;
+    uint32_t inputTail;
+    bool rxne;
+}SIM_Usart;
+
+static SIM_Usart SimUsarts[SIM_USART_COUNT] = {
+    {.USARTx = &SIM_USART1, .clockRegister = &SIM_RCC.APB2ENR, .clockEnable = RCC_APB2ENR_USART1EN, .IRQn = USART1_IRQn},
+    {.USARTx = &SIM_USART2, .clockRegister = &SIM_RCC.APB1ENR, .clockEnable = RCC_APB1ENR_USART2EN, .IRQn = USART2_IRQn},
+    {.USARTx = &SIM_USART3, .clockRegister = &SIM_RCC.APB1ENR, .clockEnable = RCC_APB1ENR_USART3EN, .IRQn = USART3_IRQn},
+};
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Gets the simulated state of a USART
+/// @param USARTx USART (Ex. USART2)
+/// @return USART state, fails the test if USARTx is not a USART
+static SIM_Usart* SIM_USART_Get(const USART_TypeDef *USARTx);
+
+/// @brief Checks if the USART has its clock and UE on, and the transmitter or receiver enabled
+/// @param usart USART state
+/// @param enable USART_CR1_TE or USART_CR1_RE
+/// @return True if it can send (TE) or receive (RE)
+static bool SIM_USART_IsRunning(const SIM_Usart *usart, uint32_t enable);
+#pragma endregion
+
+#pragma region PUBLIC_FUNCTIONS
+void SIM_USART_Reset(void){
+    for(uint8_t i = 0; i < SIM_USART_COUNT; i++){
+        SIM_Usart *usart = &SimUsarts[i];
+        memset(usart->USARTx, 0, sizeof(USART_TypeDef));
+        usart->USARTx->SR = USART_SR_TXE | USART_SR_TC;
+        usart->outputLength = 0;
+        usart->inputHead = 0;
+        usart->inputTail = 0;
+        usart->rxne = false;
+    }
+}
+
+void SIM_USART_Update(uint32_t cycles){
+    (void)cycles;
+    for(uint8_t i = 0; i < SIM_USART_COUNT; i++){
+        SIM_Usart *usart = &SimUsarts[i];
+        if(!SIM_IS_SET(*usart->clockRegister, usart->clockEnable)){
+            usart->USARTx->SR = 0;                  // Reads 0 without its clock, so every wait on a flag times out
+            continue;
+        }
+
+        if(!usart->rxne && usart->inputHead != usart->inputTail && SIM_USART_IsRunning(usart, USART_CR1_RE)){
+            usart->USARTx->DR = (uint8_t)usart->input[usart->inputHead];
+            usart->inputHead = (usart->inputHead + 1) % SIM_USART_BUFFER_SIZE;
+            usart->rxne = true;
+        }
+        usart->USARTx->SR = USART_SR_TXE | USART_SR_TC | (usart->rxne ? USART_SR_RXNE : 0);   // Input waits, so no overrun
+
+        uint32_t cr1 = usart->USARTx->CR1;
+        if((cr1 & USART_CR1_TXEIE) || (cr1 & USART_CR1_TCIE) || ((cr1 & USART_CR1_RXNEIE) && usart->rxne))
+            SIM_RaiseLine(usart->IRQn);
+    }
+}
+
+bool SIM_USART_Write(const volatile void *reg){
+    for(uint8_t i = 0; i < SIM_USART_COUNT; i++){
+        SIM_Usart *usart = &SimUsarts[i];
+        if(reg == &usart->USARTx->DR){
+            char byte = (char)(usart->USARTx->DR & 0xFF);
+            if(SIM_USART_IsRunning(usart, USART_CR1_TE) && usart->outputLength < SIM_USART_BUFFER_SIZE)
+                usart->output[usart->outputLength++] = byte;
+            return true;
+        }
+        if(reg == &usart->USARTx->SR){              // RXNE and TC are cleared by writing 0
+            if(!SIM_IS_SET(usart->USARTx->SR, USART_SR_RXNE))
+                usart->rxne = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SIM_USART_Read(const volatile void *reg){
+    for(uint8_t i = 0; i < SIM_USART_COUNT; i++){
+        SIM_Usart *usart = &SimUsarts[i];
+        if(reg == &usart->USARTx->DR){
+            usart->rxne = false;                    // Reading DR clears RXNE
+            return true;
+        }
+    }
+    return false;
+}
+
+void SIM_USART_Send(USART_TypeDef *USARTx, const char *data, uint32_t length){
+    SIM_Usart *usart = SIM_USART_Get(USARTx);
+    for(uint32_t i = 0; i < length; i++){
+        uint32_t next = (usart->inputTail + 1) % SIM_USART_BUFFER_SIZE;
+        if(next == usart->inputHead)
+            SIM_Fatal("SIM_USART_Send: input buffer full");
+        usart->input[usart->inputTail] = data[i];
+        usart->inputTail = next;
+    }
+    SIM_Poll();
+}
+
+const char* SIM_USART_GetOutput(const USART_TypeDef *USARTx, uint32_t *length){
+    const SIM_Usart *usart = SIM_USART_Get(USARTx);
+    *length = usart->outputLength;
+    return usart->output;
+}
+
+void SIM_USART_ClearOutput(const USART_TypeDef *USARTx){
+    SIM_USART_Get(USARTx)->outputLength = 0;
+}
+#pragma endregion
+
+#pragma region PRIVATE_FUNCTIONS
+static SIM_Usart* SIM_USART_Get(const USART_TypeDef *USARTx){
+    for(uint8_t i = 0; i < SIM_USART_COUNT; i++)
+        if(SimUsarts[i].USARTx == USARTx)
+            return &SimUsarts[i];
+    SIM_Fatal("Not a USART");
+}
+
+static bool SIM_USART_IsRunning(const SIM_Usart *usart, uint32_t enable){
+    return SIM_IS_SET(*usart->clockRegister, usart->clockEnable) && SIM_IS_SET(usart->USARTx->CR1, USART_CR1_UE) &&
+           SIM_IS_SET(usart->USARTx->CR1, enable);
+}
+#pragma endregion
@@ -0,0 +1,92 @@
+/**
+ * @file TEST.c
+ * @author Devin Marx
+ * @brief Implementation of the host unit test runner (make host-test)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "TEST.h"
+
+static uint32_t TestsRun;
+static uint32_t TestsFailed;
+static const char *TestFilter;                  // Only tests whose name starts with this run (make host-test TEST=SPI)
+
+void TEST_Fail(const char *file, int line, const char *message){
+    fprintf(stderr, "    %s:%d: %s\n", file, line, message);
+    fflush(stderr);
+    exit(EXIT_FAILURE);                         // Ends the test's process, the runner reports it
+}
+
+void TEST_Run(const char *name, TEST_Function test){
+    if(TestFilter != NULL && strncmp(name, TestFilter, strlen(TestFilter)) != 0)
+        return;
+    fflush(stdout);
+    fflush(stderr);
+    TestsRun++;
+
+    pid_t pid = fork();
+    if(pid < 0){
+        perror("fork");
+        exit(EXIT_FAILURE);
+    }
+    if(pid == 0){                               // The test, on a reset MCU with fresh module state
+        SIM_Reset();
+        test();
+        fflush(stdout);
+        _exit(EXIT_SUCCESS);
+    }
+
+    int status;
+    if(waitpid(pid, &status, 0) < 0){
+        perror("waitpid");
+        exit(EXIT_FAILURE);
+    }
+    if(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS){
+        printf("PASS %s\n", name);
+    } else {
+        TestsFailed++;
+        if(WIFSIGNALED(status))
+            printf("FAIL %s (Signal %d)\n", name, WTERMSIG(status));
+        else
+            printf("FAIL %s\n", name);
+    }
+}
+
+int main(int argc, char *argv[]){
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    if(argc > 1)
+        TestFilter = argv[1];
+
+    TEST_string();
+    TEST_CLOCK();
+    TEST_GPIO();
+    TEST_INTERRUPT();
+    TEST_SPI();
+    TEST_USART();
+    TEST_TIMER();
+    TEST_FILTER();
+    TEST_TELEMETRY();
+    TEST_SPECTRUM();
+    TEST_GOERTZEL();
+    TEST_CONTROL();
+    TEST_STATS();
+    TEST_CAPTURE();
+    TEST_TIMESTAMP();
+    TEST_ACQUIRE();
+    TEST_CALIBRATION();
+    TEST_CLASSIFIER();
+    TEST_SCHEDULER();
+    TEST_RTOS();
+    TEST_POOL();
+    TEST_TRACE();
+    TEST_WATCHDOG();
+
+    printf("%lu tests, %lu failed\n", (unsigned long)TestsRun, (unsigned long)TestsFailed);
+    return TestsFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file TEST_ACQUIRE.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_ACQUIRE (Oversampled blocks from a simulated LTC1298 and stopping with a stuck read)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_ACQUIRE.h"
+#include "ACDC_WATCHDOG.h"
+#include "ACDC_GPIO.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_ACQUIRE_CODE   0x900       // Code the simulated ADC converts, 4096 in q15 once midscale is taken off
+#define TEST_ACQUIRE_RATE   4000
+
+static bool TestAdcDataFrame;
+static uint32_t TestConversions;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief LTC1298 on SPI1: answers the data frame after a command frame with TEST_ACQUIRE_CODE (MSB first, 3 bits up)
+static uint16_t TEST_ACQUIRE_Adc(SPI_TypeDef *SPIx, uint16_t mosi);
+
+/// @brief Samples a constant input with oversampling until the first block is full, and checks every sample of it
+/// @param filter ACQUIRE_OVERSAMPLE_BOXCAR or ACQUIRE_OVERSAMPLE_CIC2
+/// @param conversions Conversions the first block should take
+static void TEST_ACQUIRE_FirstBlock(ACQUIRE_OversampleFilter filter, uint32_t conversions);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_ACQUIRE_Boxcar(void){
+    TEST_ACQUIRE_FirstBlock(ACQUIRE_OVERSAMPLE_BOXCAR, ACQUIRE_BLOCK_SIZE * 4);
+}
+
+static void TEST_ACQUIRE_Cic2DropsWarmup(void){
+    // Without the discard the first sample would be 10 / 16 of the input (-9728 in q15)
+    TEST_ACQUIRE_FirstBlock(ACQUIRE_OVERSAMPLE_CIC2, (ACQUIRE_BLOCK_SIZE + 1) * 4);
+}
+
+static void TEST_ACQUIRE_StopWithStuckRead(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SIM_SPI_Attach(SPI1, TEST_ACQUIRE_Adc);
+    LTC1298_t adc = LTCADC_InitCS(SPI1, GPIOB, GPIO_PIN_6);
+    TEST_ASSERT(ACQUIRE_Init(adc, ACQUIRE_CH0, TIM3, TEST_ACQUIRE_RATE));
+
+    __disable_irq();                                    // The receive interrupt of the read can not run
+    TEST_ASSERT(LTCADC_StartReadCH0CS(adc, 0));
+    uint64_t start = SIM_GetCycles();
+    ACQUIRE_Stop();
+    __enable_irq();
+    const char *site;
+    TEST_ASSERT_EQUAL(1, WATCHDOG_GetTimeouts(&site));
+    TEST_ASSERT_EQUAL_STRING("ACQUIRE stop", site);
+    TEST_ASSERT(SIM_GetCycles() - start >= 72ULL * 5000);
+
+    SIM_Poll();                                         // The read finishes once interrupts are back
+    TEST_ASSERT(!LTCADC_IsReading());
+    ACQUIRE_Stop();
+    TEST_ASSERT_EQUAL(1, WATCHDOG_GetTimeouts(0));
+}
+#pragma endregion
+
+void TEST_ACQUIRE(void){
+    TEST_Run("ACQUIRE: boxcar oversampled block", TEST_ACQUIRE_Boxcar);
+    TEST_Run("ACQUIRE: CIC2 throws away its warm-up sample", TEST_ACQUIRE_Cic2DropsWarmup);
+    TEST_Run("ACQUIRE: Stop gives up on a stuck read", TEST_ACQUIRE_StopWithStuckRead);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static uint16_t TEST_ACQUIRE_Adc(SPI_TypeDef *SPIx, uint16_t mosi){
+    (void)SPIx;
+    if(!TestAdcDataFrame){
+        TestAdcDataFrame = (mosi & 0b1000) != 0;        // Start bit of a command frame
+        return 0;
+    }
+    TestAdcDataFrame = false;
+    TestConversions++;
+    return (uint16_t)(TEST_ACQUIRE_CODE << 3);
+}
+
+static void TEST_ACQUIRE_FirstBlock(ACQUIRE_OversampleFilter filter, uint32_t conversions){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SIM_SPI_Attach(SPI1, TEST_ACQUIRE_Adc);
+    LTC1298_t adc = LTCADC_InitCS(SPI1, GPIOB, GPIO_PIN_6);
+    TEST_ASSERT(ACQUIRE_Init(adc, ACQUIRE_CH0, TIM3, TEST_ACQUIRE_RATE));
+    TEST_ASSERT(ACQUIRE_SetOversampling(ACQUIRE_CH0, 1, filter));   // 4 conversions per sample
+    TEST_ASSERT(ACQUIRE_Start());
+
+    ACQUIRE_Block_t block;
+    while(!ACQUIRE_GetBlock(&block)){
+        SIM_Run(72000000ULL / TEST_ACQUIRE_RATE);       // 1 conversion
+        TEST_ASSERT(TestConversions <= conversions);
+    }
+    ACQUIRE_Stop();
+    TEST_ASSERT_EQUAL(conversions, TestConversions);
+    TEST_ASSERT_EQUAL(ACQUIRE_BLOCK_SIZE, block.length);
+    TEST_ASSERT_EQUAL(0, block.firstSample);
+    for(uint32_t i = 0; i < ACQUIRE_BLOCK_SIZE; i++)
+        TEST_ASSERT_EQUAL((TEST_ACQUIRE_CODE << 4) - 32768, block.samples[i]);
+    TEST_ASSERT_EQUAL(0, ACQUIRE_GetMissedSamples());
+    TEST_ASSERT_EQUAL(0, WATCHDOG_GetTimeouts(0));
+}
+#pragma endregion
@@ -0,0 +1,175 @@
+/**
+ * @file TEST_CALIBRATION.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_CALIBRATION (Two point fit against a double precision line, table, flash page CRC)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_CALIBRATION.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_CALIBRATION_TOLERANCE 3    // LSBs the q15 offset and gain may be off from the exact line (Rounding of both)
+
+extern uint32_t _scalibration[];        // Simulated calibration page (SIM_RCC.c)
+
+typedef struct{
+    q15_t measured1, actual1, measured2, actual2;
+}TEST_TwoPoint_t;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Calculates CRC-32/MPEG-2 the slow way (What the STM32 CRC unit calculates over whole words)
+/// @param words Words to run through the CRC
+/// @param count Number of words
+/// @return CRC of the words
+static uint32_t TEST_CRC32(const uint32_t *words, uint32_t count);
+
+/// @brief Fills a calibration set with values that are not the defaults
+/// @param set Set to fill
+static void TEST_CALIBRATION_FillSet(CALIBRATION_Set_t *set);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_CALIBRATION_TwoPointMatchesLine(void){
+    static const TEST_TwoPoint_t points[] = {
+        {-16384, -16000, 16384, 16000},         // Gain just under 1
+        {-30000, -32000, 30000, 32000},         // Gain just over 1
+        {  1000,   3000,  9000,  7000},         // Gain 0.5 with an offset
+        {  -200,  -1000,   200,  1000},         // Gain 5
+        {  -100, -12700,   100, 12700},         // Gain 127, the most CALIBRATION_MAX_SHIFT allows
+        { 20000,  10000,  4000, -6000},         // Points given high first
+    };
+    for(uint32_t p = 0; p < sizeof(points) / sizeof(points[0]); p++){
+        const TEST_TwoPoint_t *t = &points[p];
+        CALIBRATION_t calibration;
+        TEST_ASSERT(CALIBRATION_SetTwoPoint(&calibration, t->measured1, t->actual1, t->measured2, t->actual2));
+        TEST_ASSERT(!calibration.useTable);
+
+        double gain = ((double)t->actual2 - t->actual1) / ((double)t->measured2 - t->measured1);
+        for(int32_t value = -32768; value <= 32767; value += 97){
+            double expected = t->actual1 + (value - t->measured1) * gain;
+            if(expected > 32767.0)
+                expected = 32767.0;             // arm_offset_q15 and arm_scale_q15 saturate
+            else if(expected < -32768.0)
+                expected = -32768.0;
+            if((double)value + calibration.offset > 32767.0 || (double)value + calibration.offset < -32768.0)
+                continue;                       // The offset saturates before the gain, the line does not
+            double tolerance = TEST_CALIBRATION_TOLERANCE * (gain > 1.0 ? gain : 1.0);
+            TEST_ASSERT_NEAR(expected, CALIBRATION_CorrectQ15(&calibration, (q15_t)value), tolerance);
+        }
+    }
+}
+
+static void TEST_CALIBRATION_TwoPointRejects(void){
+    CALIBRATION_t calibration;
+    TEST_ASSERT(!CALIBRATION_SetTwoPoint(&calibration, 100, 0, 100, 1000));        // Same point twice
+    TEST_ASSERT(!CALIBRATION_SetTwoPoint(&calibration, 0, 0, 1000, 0));            // Gain 0
+    TEST_ASSERT(!CALIBRATION_SetTwoPoint(&calibration, 0, 1000, 1000, 0));         // Negative gain
+    TEST_ASSERT(!CALIBRATION_SetTwoPoint(&calibration, -100, -12900, 100, 12900));  // Gain 129, over 2^CALIBRATION_MAX_SHIFT
+}
+
+static void TEST_CALIBRATION_Table(void){
+    CALIBRATION_t calibration;
+    CALIBRATION_Init(&calibration);
+    for(int32_t value = -32768; value <= 32767; value += 13)
+        TEST_ASSERT_EQUAL(value, CALIBRATION_CorrectQ15(&calibration, (q15_t)value));   // Unity changes nothing
+
+    q15_t table[CALIBRATION_TABLE_POINTS];
+    for(uint8_t i = 0; i < CALIBRATION_TABLE_POINTS; i++)
+        table[i] = (q15_t)((i < 8 ? 0 : (i - 8) * 4096) - (i == 16 ? 1 : 0));  // 0 below the middle, unity above
+    CALIBRATION_SetTable(&calibration, table);
+    TEST_ASSERT(calibration.useTable);
+    TEST_ASSERT_EQUAL(0, CALIBRATION_CorrectQ15(&calibration, -20000));
+    TEST_ASSERT_EQUAL(0, CALIBRATION_CorrectQ15(&calibration, 0));
+    TEST_ASSERT_EQUAL(2048, CALIBRATION_CorrectQ15(&calibration, 2048));           // Half way between two points
+    TEST_ASSERT_NEAR(32767, CALIBRATION_CorrectQ15(&calibration, 32767), 1);
+
+    CALIBRATION_SetTable(&calibration, 0);
+    TEST_ASSERT(!calibration.useTable);
+    TEST_ASSERT_EQUAL(-20000, CALIBRATION_CorrectQ15(&calibration, -20000));
+}
+
+static void TEST_CALIBRATION_DacCode(void){
+    CALIBRATION_t calibration;
+    CALIBRATION_Init(&calibration);
+    TEST_ASSERT_EQUAL(0, CALIBRATION_ToDACCode(&calibration, -32768));
+    TEST_ASSERT_EQUAL(2048, CALIBRATION_ToDACCode(&calibration, 0));
+    TEST_ASSERT_EQUAL(4095, CALIBRATION_ToDACCode(&calibration, 32767));
+}
+
+static void TEST_CALIBRATION_SaveAndLoad(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    CALIBRATION_Set_t set, loaded;
+    TEST_ASSERT(!CALIBRATION_Load(&loaded));        // Erased page, defaults
+    TEST_ASSERT_EQUAL(0, loaded.adc[1].offset);
+    TEST_ASSERT(!loaded.dac.useTable);
+
+    TEST_CALIBRATION_FillSet(&set);
+    TEST_ASSERT(CALIBRATION_Save(&set));
+    TEST_ASSERT(READ_BIT(FLASH->CR, FLASH_CR_LOCK));   // Locked again
+    TEST_ASSERT(CALIBRATION_Load(&loaded));
+    TEST_ASSERT_EQUAL_MEMORY(&set, &loaded, sizeof(set));
+
+    // magic, version and size, the set, then the CRC-32/MPEG-2 of every word before it
+    uint32_t crcIndex = 2 + sizeof(CALIBRATION_Set_t) / sizeof(uint32_t);
+    TEST_ASSERT_EQUAL(TEST_CRC32(_scalibration, crcIndex), _scalibration[crcIndex]);
+
+    TEST_CALIBRATION_FillSet(&set);                 // Saving again erases the page first
+    set.dac.offset = -7;
+    TEST_ASSERT(CALIBRATION_Save(&set));
+    TEST_ASSERT(CALIBRATION_Load(&loaded));
+    TEST_ASSERT_EQUAL(-7, loaded.dac.offset);
+}
+
+static void TEST_CALIBRATION_CorruptPageIgnored(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    CALIBRATION_Set_t set, loaded;
+    TEST_CALIBRATION_FillSet(&set);
+    TEST_ASSERT(CALIBRATION_Save(&set));
+
+    _scalibration[5] ^= 0x00010000;                 // One bit of the set flipped
+    TEST_ASSERT(!CALIBRATION_Load(&loaded));
+    TEST_ASSERT_EQUAL(0, loaded.adc[0].offset);     // Defaults instead of the damaged set
+    TEST_ASSERT_EQUAL(32767, CALIBRATION_CorrectQ15(&loaded.adc[0], 32767));
+    _scalibration[5] ^= 0x00010000;
+    TEST_ASSERT(CALIBRATION_Load(&loaded));
+
+    _scalibration[1] += 1;                          // Page saved by a different version
+    TEST_ASSERT(!CALIBRATION_Load(&loaded));
+}
+#pragma endregion
+
+void TEST_CALIBRATION(void){
+    TEST_Run("CALIBRATION: two point fit matches the exact line", TEST_CALIBRATION_TwoPointMatchesLine);
+    TEST_Run("CALIBRATION: two point fit rejects bad points", TEST_CALIBRATION_TwoPointRejects);
+    TEST_Run("CALIBRATION: piecewise linear table", TEST_CALIBRATION_Table);
+    TEST_Run("CALIBRATION: DAC codes", TEST_CALIBRATION_DacCode);
+    TEST_Run("CALIBRATION: save and load with the CRC unit", TEST_CALIBRATION_SaveAndLoad);
+    TEST_Run("CALIBRATION: a damaged page is ignored", TEST_CALIBRATION_CorruptPageIgnored);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static uint32_t TEST_CRC32(const uint32_t *words, uint32_t count){
+    uint32_t crc = 0xFFFFFFFF;
+    for(uint32_t i = 0; i < count; i++){
+        crc ^= words[i];
+        for(uint8_t bit = 0; bit < 32; bit++)
+            crc = (crc & 0x80000000UL) ? (crc << 1) ^ 0x04C11DB7UL : crc << 1;
+    }
+    return crc;
+}
+
+static void TEST_CALIBRATION_FillSet(CALIBRATION_Set_t *set){
+    memset(set, 0, sizeof(*set));                   // Padding is saved too, keep it the same for the compare
+    TEST_ASSERT(CALIBRATION_SetTwoPoint(&set->adc[0], -16384, -16000, 16384, 16000));
+    TEST_ASSERT(CALIBRATION_SetTwoPoint(&set->adc[1], 1000, 3000, 9000, 7000));
+    CALIBRATION_Init(&set->dac);
+    q15_t table[CALIBRATION_TABLE_POINTS];
+    for(uint8_t i = 0; i < CALIBRATION_TABLE_POINTS; i++)
+        table[i] = (q15_t)(i * 4000 - 32000);
+    CALIBRATION_SetTable(&set->dac, table);
+}
+#pragma endregion
@@ -0,0 +1,170 @@
+/**
+ * @file TEST_CAPTURE.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_CAPTURE (Triggers, pre-trigger history across the ring wrap, and the telemetry frames)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_CAPTURE.h"
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_USART.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_CAPTURE_LENGTH 16
+#define TEST_CAPTURE_PRE    4
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Runs samples value(start), value(start + 1), ... through a capture as one block
+/// @param capture Capture
+/// @param firstSample ACQUIRE sample number of the first sample (Before decimation)
+/// @param length Samples in the block (ACQUIRE_BLOCK_SIZE / length ACQUIRE samples per sample)
+/// @param period Samples per period of the square wave added to the ramp (0 for a plain ramp)
+/// @return CAPTURE_AddBlock
+static bool TEST_CAPTURE_AddRamp(CAPTURE_t *capture, uint32_t firstSample, uint32_t length, uint32_t period);
+
+/// @brief Value of the test signal at a sample number: a ramp of 10 per sample, minus 20000 every other half period
+/// @param number Sample number (After decimation)
+/// @param period Samples per period of the square wave (0 for a plain ramp)
+/// @return Sample value
+static q15_t TEST_CAPTURE_Value(uint32_t number, uint32_t period);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_CAPTURE_RisingEdgeWithHistory(void){
+    static q15_t buffer[TEST_CAPTURE_LENGTH];
+    CAPTURE_t capture;
+    TEST_ASSERT(!CAPTURE_Init(&capture, buffer, 1, 1000));
+    TEST_ASSERT(CAPTURE_Init(&capture, buffer, TEST_CAPTURE_LENGTH, 1000));
+    TEST_ASSERT(!CAPTURE_SetTrigger(&capture, CAPTURE_RISING_EDGE, 0, TEST_CAPTURE_LENGTH));
+    TEST_ASSERT(CAPTURE_SetTrigger(&capture, CAPTURE_RISING_EDGE, 5000, TEST_CAPTURE_PRE));
+    TEST_ASSERT(!TEST_CAPTURE_AddRamp(&capture, 0, ACQUIRE_BLOCK_SIZE, 0));    // Idle until armed
+    TEST_ASSERT_EQUAL(CAPTURE_IDLE, CAPTURE_GetState(&capture));
+
+    CAPTURE_Arm(&capture);
+    uint32_t first = 0;
+    while(!TEST_CAPTURE_AddRamp(&capture, first, ACQUIRE_BLOCK_SIZE, 0)){   // 10 per sample, crosses 5000 at sample 500
+        first += ACQUIRE_BLOCK_SIZE;
+        TEST_ASSERT(first < 2000);
+        TEST_ASSERT(CAPTURE_GetState(&capture) != CAPTURE_DONE);
+    }
+    TEST_ASSERT_EQUAL(CAPTURE_DONE, CAPTURE_GetState(&capture));
+    TEST_ASSERT_EQUAL(500, capture.triggerSample);
+    const q15_t *samples = CAPTURE_GetSamples(&capture);
+    for(uint32_t i = 0; i < TEST_CAPTURE_LENGTH; i++)               // The ring wrapped many times, oldest first
+        TEST_ASSERT_EQUAL(TEST_CAPTURE_Value(500 - TEST_CAPTURE_PRE + i, 0), samples[i]);
+
+    TEST_ASSERT(!TEST_CAPTURE_AddRamp(&capture, 1000, ACQUIRE_BLOCK_SIZE, 0));  // Frozen until armed again
+    TEST_ASSERT_EQUAL(5000 - 10 * TEST_CAPTURE_PRE, samples[0]);
+    TEST_ASSERT_EQUAL(1, capture.captureNumber);
+}
+
+static void TEST_CAPTURE_TriggerTypes(void){
+    static const struct{
+        CAPTURE_TriggerType type;
+        q15_t level;
+        uint32_t expected;          // Sample number of the trigger on the square wave + ramp
+    }cases[] = {
+        {CAPTURE_FALLING_EDGE, -10000, 20},     // Ramp 200 at 20 drops to -19800
+        {CAPTURE_ABOVE, -20000, 4},             // Checked as soon as the history is full
+        {CAPTURE_BELOW, -19000, 20},
+        {CAPTURE_RISING_SLOPE, 15000, 40},      // Jumps back up by 20000
+        {CAPTURE_FALLING_SLOPE, 15000, 20},
+    };
+    static q15_t buffer[TEST_CAPTURE_LENGTH];
+    for(uint32_t n = 0; n < sizeof(cases) / sizeof(cases[0]); n++){
+        CAPTURE_t capture;
+        CAPTURE_Init(&capture, buffer, TEST_CAPTURE_LENGTH, 1000);
+        TEST_ASSERT(CAPTURE_SetTrigger(&capture, cases[n].type, cases[n].level, TEST_CAPTURE_PRE));
+        CAPTURE_Arm(&capture);
+        TEST_ASSERT(TEST_CAPTURE_AddRamp(&capture, 0, ACQUIRE_BLOCK_SIZE, 40));
+        TEST_ASSERT_EQUAL(cases[n].expected, capture.triggerSample);
+        TEST_ASSERT_EQUAL(TEST_CAPTURE_Value(cases[n].expected, 40), CAPTURE_GetSamples(&capture)[TEST_CAPTURE_PRE]);
+    }
+}
+
+static void TEST_CAPTURE_ExternalAndDecimated(void){
+    static q15_t buffer[TEST_CAPTURE_LENGTH];
+    CAPTURE_t capture;
+    CAPTURE_Init(&capture, buffer, TEST_CAPTURE_LENGTH, 250);
+    TEST_ASSERT(CAPTURE_SetTrigger(&capture, CAPTURE_EXTERNAL, 0, 0));
+    CAPTURE_Arm(&capture);
+    TEST_ASSERT(!TEST_CAPTURE_AddRamp(&capture, 0, ACQUIRE_BLOCK_SIZE / 4, 0));    // No event yet
+    TEST_ASSERT_EQUAL(CAPTURE_ARMED, CAPTURE_GetState(&capture));
+
+    CAPTURE_TriggerExternal(&capture);                  // ACQUIRE is not running, the event is at sample 0
+    TEST_ASSERT(TEST_CAPTURE_AddRamp(&capture, ACQUIRE_BLOCK_SIZE, ACQUIRE_BLOCK_SIZE / 4, 0));    // Exactly one window
+    TEST_ASSERT_EQUAL(ACQUIRE_BLOCK_SIZE, capture.triggerSample);   // The first sample after the event
+    TEST_ASSERT_EQUAL(TEST_CAPTURE_Value(16, 0), CAPTURE_GetSamples(&capture)[0]);  // 16 samples per decimated block
+    TEST_ASSERT_EQUAL(TEST_CAPTURE_Value(31, 0), CAPTURE_GetSamples(&capture)[TEST_CAPTURE_LENGTH - 1]);
+
+    CAPTURE_Disarm(&capture);
+    CAPTURE_TriggerExternal(&capture);                  // Ignored while not armed
+    TEST_ASSERT(!capture.externalPending);
+}
+
+static void TEST_CAPTURE_SendFrames(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TELEMETRY_Init(USART2);
+    static q15_t buffer[300];
+    CAPTURE_t capture;
+    CAPTURE_Init(&capture, buffer, 300, 4000);
+    TEST_ASSERT(!CAPTURE_Send(&capture));               // Not done
+    TEST_ASSERT(CAPTURE_SetTrigger(&capture, CAPTURE_ABOVE, 1000, 50));
+    CAPTURE_Arm(&capture);
+    for(uint32_t first = 0; CAPTURE_GetState(&capture) != CAPTURE_DONE && first < 4096; first += ACQUIRE_BLOCK_SIZE)
+        TEST_CAPTURE_AddRamp(&capture, first, ACQUIRE_BLOCK_SIZE, 0);
+    TEST_ASSERT(CAPTURE_Send(&capture));
+    SIM_Poll();
+
+    // 121 samples per frame: 121 + 121 + 58
+    uint32_t length, position = 0, offset = 0;
+    const uint8_t *output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    for(uint8_t frame = 0; frame < 3; frame++){
+        const uint8_t *payload = output + position + 6;
+        uint16_t count = payload[12] | (payload[13] << 8);
+        TEST_ASSERT_EQUAL(TELEMETRY_CAPTURE_DATA, output[position + 2]);
+        TEST_ASSERT_EQUAL(frame, output[position + 3]);
+        TEST_ASSERT_EQUAL(1, payload[0] | (payload[1] << 8));                  // captureNumber
+        TEST_ASSERT_EQUAL(300, payload[2] | (payload[3] << 8));
+        TEST_ASSERT_EQUAL(50, payload[4] | (payload[5] << 8));
+        TEST_ASSERT_EQUAL(4000, payload[6] | (payload[7] << 8) | (payload[8] << 16) | (payload[9] << 24));
+        TEST_ASSERT_EQUAL(offset, payload[10] | (payload[11] << 8));
+        TEST_ASSERT_EQUAL(frame < 2 ? 121 : 58, count);
+        TEST_ASSERT_EQUAL_MEMORY(&buffer[offset], payload + 14, count * sizeof(q15_t));
+        offset += count;
+        position += 14 + count * sizeof(q15_t) + TELEMETRY_FRAME_OVERHEAD;
+    }
+    TEST_ASSERT_EQUAL(length, position);
+    TEST_ASSERT_EQUAL(1000, buffer[50]);                // The trigger sample, 100 samples into the ramp
+}
+#pragma endregion
+
+void TEST_CAPTURE(void){
+    TEST_Run("CAPTURE: rising edge with pre-trigger history", TEST_CAPTURE_RisingEdgeWithHistory);
+    TEST_Run("CAPTURE: edge, level, and slope triggers", TEST_CAPTURE_TriggerTypes);
+    TEST_Run("CAPTURE: external trigger on decimated blocks", TEST_CAPTURE_ExternalAndDecimated);
+    TEST_Run("CAPTURE: window sent as telemetry frames", TEST_CAPTURE_SendFrames);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static bool TEST_CAPTURE_AddRamp(CAPTURE_t *capture, uint32_t firstSample, uint32_t length, uint32_t period){
+    static q15_t samples[ACQUIRE_BLOCK_SIZE];
+    uint32_t step = ACQUIRE_BLOCK_SIZE / length;
+    for(uint32_t i = 0; i < length; i++)
+        samples[i] = TEST_CAPTURE_Value(firstSample / step + i, period);
+    ACQUIRE_Block_t block = {samples, length, firstSample, 0, 0};
+    return CAPTURE_AddBlock(capture, &block);
+}
+
+static q15_t TEST_CAPTURE_Value(uint32_t number, uint32_t period){
+    int32_t value = (int32_t)(number * 10);
+    if(period != 0 && (number % period) >= period / 2)
+        value -= 20000;
+    return (q15_t)value;
+}
+#pragma endregion
@@ -0,0 +1,253 @@
+/**
+ * @file TEST_CLASSIFIER.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_CLASSIFIER (Network checks, windows across blocks, outputs against CLASSIFIER_Helper.py)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <math.h>
+#include "TEST.h"
+#include "ACDC_CLASSIFIER.h"
+
+#define TEST_CLASSIFIER_WINDOWS     4
+#define TEST_CLASSIFIER_PERIOD_NS   250000      // 4kHz samples
+#define TEST_CLASSIFIER_BLOCK       36          // Not a multiple of the 32 sample window or the 8 sample groups
+
+// One layer that passes its 4 inputs through (64 is 1.0 with outShift 6), so the features come out unchanged
+static const q7_t TestIdentity[4 * 4] = {64, 0, 0, 0, 0, 64, 0, 0, 0, 0, 64, 0, 0, 0, 0, 64};
+static const q7_t TestZero[4] = {0};
+static const CLASSIFIER_Layer_t TestGroupLayer = {TestIdentity, TestZero, 4, 4, 0, 6, false};
+static const CLASSIFIER_Network_t TestGroupNetwork = {&TestGroupLayer, 1, 32, 4, 6, NULL};
+
+// Made by Python_Helper/CLASSIFIER_Helper.py for CLASSIFIER_DefaultNetwork: CLASSIFIER_Synthetic(4, 64,
+// np.random.default_rng(12)) windows (Classes spike, clipped, dropout, dropout), their CLASSIFIER_Features(windows, 64, 7),
+// and CLASSIFIER_Run_Quantized of the layers read from ACDC_CLASSIFIER_WEIGHTS.c
+static const q15_t TestWindows[TEST_CLASSIFIER_WINDOWS][64] = {
+    {
+        6055, 5643, 4940, 2561, 1072, -1813, -3624, -6509, -8752, -10812, -11631, -11870, -11645, -10383, -8308, -6055,
+        -3394, -630, 1649, 4108, 4670, 6044, 5343, 4357, 2385, 532, -2087, -4633, -7421, -9395, -10443, -11805,
+        -12232, -11033, -9948, -7661, -5179, -2831, -700, 2175, 4335, 5234, 5938, 5741, 4092, 2853, 654, -2146,
+        -4800, -7321, -9031, -11200, -12018, -11777, -11431, -10079, -7716, 26293, 29014, 30958, 32767, 4326, 5437, 5770,
+    },
+    {
+        -28344, -27881, -27740, -18017, 10954, 23118, 23126, 22286, 22620, 7735, -21141, -28454, -27574, -28102, -28034, -6909,
+        21755, 22391, 23185, 22886, 22608, -3922, -28674, -28170, -27899, -28191, -24387, 4406, 22876, 23195, 22852, 22775,
+        13987, -14513, -28071, -27790, -28475, -27517, -13139, 16033, 22841, 22519, 23151, 23108, 2299, -26474, -27811, -28014,
+        -27102, -28160, -2122, 22824, 22315, 22569, 23399, 19764, -9072, -28375, -27768, -27743, -27874, -19687, 9530, 22986,
+    },
+    {
+        12299, 19687, 21087, 44, -153, -227, -29, -168, -675, -367, 121, -674, -280, -428, -595, -632,
+        -268, -197, -200, -775, -395, -188, 8, -80, -28, 58, -31, -568, -282, -20890, -13683, -1478,
+        11941, 19204, 20491, 15478, 5262, -7853, -17783, -22182, -18997, -9177, 3159, 14288, 21130, 20629, 12751, 1060,
+        -11222, -20116, -21546, -16761, -6197, 6076, 16510, 21953, 18320, 9711, -2979, -14264, -21074, -21340, -14033, -2188,
+    },
+    {
+        679, 7739, 13296, 15055, 13370, 8680, 549, -7684, -15479, -3758, -3849, -3139, -3563, -3850, -3031, -4098,
+        -3381, -3330, -3475, -3749, -3705, -3776, -3405, -4426, -3831, -3613, -3853, -4259, -3743, -3910, -3401, -3205,
+        -3640, -4297, -3727, -3966, -3439, -3109, -3559, -20192, -15489, -8456, -675, 7321, 12309, 15387, 13669, 9264,
+        1641, -7374, -14197, -19649, -21735, -21247, -16467, -8908, -991, 6600, 12288, 15886, 13543, 8707, 1687, -6445,
+    },
+};
+static const q7_t TestFeatures[TEST_CLASSIFIER_WINDOWS][64] = {
+    {
+        55, 51, 46, 27, 16, -7, -21, -44, -61, -77, -84, -85, -84, -74, -58, -40,
+        -19, 2, 20, 39, 44, 54, 49, 41, 26, 11, -9, -29, -51, -66, -74, -85,
+        -88, -79, -70, -53, -33, -15, 2, 24, 41, 48, 54, 52, 39, 30, 12, -10,
+        -30, -50, -63, -80, -87, -85, -82, -71, -53, 127, 127, 127, 127, 41, 50, 52,
+    },
+    {
+        -128, -128, -128, -115, 112, 127, 127, 127, 127, 86, -128, -128, -128, -128, -128, -28,
+        127, 127, 127, 127, 127, -5, -128, -128, -128, -128, -128, 60, 127, 127, 127, 127,
+        127, -87, -128, -128, -128, -128, -77, 127, 127, 127, 127, 127, 44, -128, -128, -128,
+        -128, -128, 9, 127, 127, 127, 127, 127, -45, -128, -128, -128, -128, -128, 100, 127,
+    },
+    {
+        96, 127, 127, 0, -2, -2, -1, -2, -6, -3, 0, -6, -3, -4, -5, -5,
+        -3, -2, -2, -7, -4, -2, 0, -1, -1, 0, -1, -5, -3, -128, -107, -12,
+        93, 127, 127, 120, 41, -62, -128, -128, -128, -72, 24, 111, 127, 127, 99, 8,
+        -88, -128, -128, -128, -49, 47, 127, 127, 127, 75, -24, -112, -128, -128, -110, -18,
+    },
+    {
+        19, 74, 118, 127, 118, 82, 18, -46, -107, -16, -16, -11, -14, -16, -10, -18,
+        -13, -12, -13, -15, -15, -16, -13, -21, -16, -14, -16, -19, -15, -17, -13, -11,
+        -15, -20, -15, -17, -13, -10, -14, -128, -107, -52, 9, 71, 110, 127, 121, 86,
+        27, -44, -97, -128, -128, -128, -115, -56, 6, 65, 110, 127, 120, 82, 27, -37,
+    },
+};
+static const q7_t TestOutputs[TEST_CLASSIFIER_WINDOWS][4] = {
+    {-29, -5, 16, 0},
+    {-2, 9, 1, -21},
+    {-2, -25, 5, 19},
+    {-9, -46, 15, 31},
+};
+
+static CLASSIFIER_t TestClassifier;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Features of one window the way CLASSIFIER_Features in CLASSIFIER_Helper.py makes them
+/// @param samples windowSize samples
+/// @param network Network with the window and feature sizes
+/// @param features Set to the inputSize q7 features
+static void TEST_CLASSIFIER_Features(const q15_t *samples, const CLASSIFIER_Network_t *network, q7_t *features);
+
+/// @brief Outputs of the last layer of the last window or CLASSIFIER_Run
+/// @param classifier Classifier
+/// @return Outputs (Layers swap the two activation buffers, the first layer writes activations[0])
+static const q7_t *TEST_CLASSIFIER_Outputs(const CLASSIFIER_t *classifier);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_CLASSIFIER_InitChecksNetwork(void){
+    TEST_ASSERT(CLASSIFIER_Init(&TestClassifier, &CLASSIFIER_DefaultNetwork));
+    TEST_ASSERT_EQUAL(4, CLASSIFIER_GetResult(&TestClassifier)->classCount);
+    TEST_ASSERT_EQUAL_STRING("dropout", CLASSIFIER_DefaultNetwork.classNames[3]);
+
+    CLASSIFIER_Layer_t layers[2] = {{TestIdentity, TestZero, 4, 4, 0, 6, true}, {TestIdentity, TestZero, 4, 4, 0, 6, false}};
+    CLASSIFIER_Network_t network = {layers, 2, 32, 4, 6, NULL};
+    TEST_ASSERT(CLASSIFIER_Init(&TestClassifier, &network));
+    TEST_ASSERT_EQUAL(3, TestClassifier.groupShift);
+    TEST_ASSERT_EQUAL(2, TestClassifier.meanShift);
+
+    CLASSIFIER_Network_t bad = network;
+    bad.layerCount = 0;
+    TEST_ASSERT(!CLASSIFIER_Init(&TestClassifier, &bad));
+    bad = network;
+    bad.inputSize = 3;                              // Not a power of 2
+    TEST_ASSERT(!CLASSIFIER_Init(&TestClassifier, &bad));
+    bad = network;
+    bad.inputSize = 2 * CLASSIFIER_MAX_WIDTH;
+    TEST_ASSERT(!CLASSIFIER_Init(&TestClassifier, &bad));
+    bad = network;
+    bad.windowSize = 48;
+    TEST_ASSERT(!CLASSIFIER_Init(&TestClassifier, &bad));
+    bad = network;
+    bad.windowSize = 2;                             // Fewer samples than features
+    TEST_ASSERT(!CLASSIFIER_Init(&TestClassifier, &bad));
+    bad = network;
+    bad.inputShift = 16;
+    TEST_ASSERT(!CLASSIFIER_Init(&TestClassifier, &bad));
+
+    struct{ uint8_t layer; CLASSIFIER_Layer_t change; } cases[] = {
+        {1, {TestIdentity, TestZero, 8, 4, 0, 6, false}},     // Does not take the outputs of layer 0
+        {0, {TestIdentity, TestZero, 4, 0, 0, 6, true}},
+        {0, {TestIdentity, TestZero, 4, CLASSIFIER_MAX_WIDTH + 1, 0, 6, true}},
+        {1, {TestIdentity, TestZero, 4, 4, 0, 0, false}},     // arm_fully_connected_q7 rounds with 1 << (outShift - 1)
+        {1, {TestIdentity, TestZero, 4, 4, 0, 32, false}},
+        {1, {TestIdentity, TestZero, 4, 4, 25, 6, false}},
+        {1, {TestIdentity, TestZero, 4, CLASSIFIER_MAX_CLASSES + 1, 0, 6, false}},
+    };
+    for(uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+        CLASSIFIER_Layer_t saved = layers[cases[i].layer];
+        layers[cases[i].layer] = cases[i].change;
+        TEST_ASSERT(!CLASSIFIER_Init(&TestClassifier, &network));
+        layers[cases[i].layer] = saved;
+    }
+    TEST_ASSERT(CLASSIFIER_Init(&TestClassifier, &network));
+}
+
+static void TEST_CLASSIFIER_WindowsAcrossBlocks(void){
+    static q15_t stream[2 * TEST_CLASSIFIER_BLOCK];
+    for(uint32_t n = 0; n < 2 * TEST_CLASSIFIER_BLOCK; n++)
+        stream[n] = (q15_t)((n * n * 37) % 4001) - 2000;
+    TEST_ASSERT(CLASSIFIER_Init(&TestClassifier, &TestGroupNetwork));
+
+    // 36 sample blocks with a step of 1: window 0 is samples 0 - 31, window 1 is 32 - 63 and its first group
+    // (32 - 39) is split between the blocks
+    ACQUIRE_Block_t first = {stream, TEST_CLASSIFIER_BLOCK, 1000, 5000, TEST_CLASSIFIER_PERIOD_NS};
+    ACQUIRE_Block_t second = {stream + TEST_CLASSIFIER_BLOCK, TEST_CLASSIFIER_BLOCK, 1000 + TEST_CLASSIFIER_BLOCK,
+                              5000 + TEST_CLASSIFIER_BLOCK * TEST_CLASSIFIER_PERIOD_NS / 1000, TEST_CLASSIFIER_PERIOD_NS};
+    q7_t expected[4];
+    TEST_ASSERT(CLASSIFIER_AddBlock(&TestClassifier, &first));
+    TEST_CLASSIFIER_Features(stream, &TestGroupNetwork, expected);
+    TEST_ASSERT_EQUAL_MEMORY(expected, TEST_CLASSIFIER_Outputs(&TestClassifier), sizeof(expected));
+    TEST_ASSERT_EQUAL(1000, CLASSIFIER_GetResult(&TestClassifier)->firstSample);
+    TEST_ASSERT_EQUAL(5000, CLASSIFIER_GetResult(&TestClassifier)->timestamp);
+    TEST_ASSERT_EQUAL(0, TestClassifier.featureCount);
+    TEST_ASSERT_EQUAL(4, TestClassifier.groupCount);        // Half of the split group
+
+    TEST_ASSERT(CLASSIFIER_AddBlock(&TestClassifier, &second));
+    TEST_CLASSIFIER_Features(stream + 32, &TestGroupNetwork, expected);
+    TEST_ASSERT_EQUAL_MEMORY(expected, TEST_CLASSIFIER_Outputs(&TestClassifier), sizeof(expected));
+    TEST_ASSERT_EQUAL(1032, CLASSIFIER_GetResult(&TestClassifier)->firstSample);
+    TEST_ASSERT_EQUAL(5000 + 32 * 250, CLASSIFIER_GetResult(&TestClassifier)->timestamp);
+
+    // The last 8 samples of the second block start window 2
+    TEST_ASSERT_EQUAL(1, TestClassifier.featureCount);
+    TEST_ASSERT_EQUAL(0, TestClassifier.groupCount);
+    TEST_ASSERT_EQUAL(1064, TestClassifier.firstSample);
+    TEST_ASSERT_EQUAL(5000 + 64 * 250, TestClassifier.timestamp);
+
+    ACQUIRE_Block_t decimated = {stream, 16, 2000, 0, 4 * TEST_CLASSIFIER_PERIOD_NS};  // 16 samples, every 4th ACQUIRE sample
+    CLASSIFIER_Reset(&TestClassifier);
+    TEST_ASSERT(!CLASSIFIER_AddBlock(&TestClassifier, &decimated));
+    TEST_ASSERT(CLASSIFIER_AddBlock(&TestClassifier, &decimated));
+    TEST_ASSERT_EQUAL(2000, CLASSIFIER_GetResult(&TestClassifier)->firstSample);
+    first.length = 8;
+    TEST_ASSERT(!CLASSIFIER_AddBlock(&TestClassifier, &first));    // Nothing classified, the result is kept
+    TEST_ASSERT_EQUAL(2000, CLASSIFIER_GetResult(&TestClassifier)->firstSample);
+    TEST_ASSERT_EQUAL(1000, TestClassifier.firstSample);
+}
+
+static void TEST_CLASSIFIER_RunMatchesHelper(void){
+    TEST_ASSERT(CLASSIFIER_Init(&TestClassifier, &CLASSIFIER_DefaultNetwork));
+    for(uint32_t w = 0; w < TEST_CLASSIFIER_WINDOWS; w++){
+        uint8_t best = 0;
+        for(uint8_t i = 1; i < 4; i++){
+            if(TestOutputs[w][i] > TestOutputs[w][best])
+                best = i;
+        }
+
+        TEST_ASSERT_EQUAL(best, CLASSIFIER_Run(&TestClassifier, TestFeatures[w]));
+        TEST_ASSERT_EQUAL_MEMORY(TestOutputs[w], TEST_CLASSIFIER_Outputs(&TestClassifier), sizeof(TestOutputs[w]));
+        const CLASSIFIER_Result_t *result = CLASSIFIER_GetResult(&TestClassifier);
+        TEST_ASSERT_EQUAL(best, result->classIndex);
+        TEST_ASSERT_EQUAL(0, result->firstSample);
+        int32_t total = 0;
+        for(uint8_t i = 0; i < result->classCount; i++){
+            TEST_ASSERT(result->scores[i] >= 0 && result->scores[i] <= result->scores[best]);
+            total += result->scores[i];
+        }
+        TEST_ASSERT(total > 64 && total <= 128);    // Softmax scores, 128 is 100%
+
+        // The same window as samples gives the helper's features and so the same outputs
+        ACQUIRE_Block_t block = {(q15_t*)TestWindows[w], 64, 64 * w, 16000 * w, TEST_CLASSIFIER_PERIOD_NS};
+        TEST_ASSERT(CLASSIFIER_AddBlock(&TestClassifier, &block));
+        TEST_ASSERT_EQUAL_MEMORY(TestOutputs[w], TEST_CLASSIFIER_Outputs(&TestClassifier), sizeof(TestOutputs[w]));
+        TEST_ASSERT_EQUAL(best, result->classIndex);
+        TEST_ASSERT_EQUAL(64 * w, result->firstSample);
+        TEST_ASSERT_EQUAL(16000 * w, result->timestamp);
+    }
+}
+#pragma endregion
+
+void TEST_CLASSIFIER(void){
+    TEST_Run("CLASSIFIER: Init rejects networks that do not fit", TEST_CLASSIFIER_InitChecksNetwork);
+    TEST_Run("CLASSIFIER: windows and feature groups across block boundaries", TEST_CLASSIFIER_WindowsAcrossBlocks);
+    TEST_Run("CLASSIFIER: outputs match CLASSIFIER_Helper.py bit for bit", TEST_CLASSIFIER_RunMatchesHelper);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_CLASSIFIER_Features(const q15_t *samples, const CLASSIFIER_Network_t *network, q7_t *features){
+    int32_t group = network->windowSize / network->inputSize;
+    int32_t means[CLASSIFIER_MAX_WIDTH], total = 0;
+    for(uint16_t i = 0; i < network->inputSize; i++){
+        int32_t sum = 0;
+        for(int32_t j = 0; j < group; j++)
+            sum += samples[i * group + j];
+        means[i] = (int32_t)floor((double)sum / group);
+        total += means[i];
+    }
+    int32_t mean = (int32_t)floor((double)total / network->inputSize);
+    for(uint16_t i = 0; i < network->inputSize; i++){
+        int32_t feature = (int32_t)floor((double)(means[i] - mean) / (1 << network->inputShift));
+        features[i] = (q7_t)(feature > 127 ? 127 : (feature < -128 ? -128 : feature));
+    }
+}
+
+static const q7_t *TEST_CLASSIFIER_Outputs(const CLASSIFIER_t *classifier){
+    return classifier->activations[(classifier->network->layerCount - 1) % 2];
+}
+#pragma endregion
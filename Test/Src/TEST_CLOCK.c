@@ -0,0 +1,90 @@
+/**
+ * @file TEST_CLOCK.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_CLOCK and the SysTick timebase (Millis, Micros)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_CLOCK.h"
+#include "ACDC_TIMER.h"
+
+#pragma region TESTS
+static void TEST_CLOCK_PllMatchesEverySpeed(void){
+    static const SystemClockSpeed speeds[] = {  // SCS_1MHz is left out, the PLL can not go below 2 x 4MHz / 8
+        SCS_2MHz, SCS_3MHz, SCS_4MHz, SCS_5MHz, SCS_6MHz, SCS_7MHz, SCS_8MHz, SCS_9MHz, SCS_10MHz, SCS_11MHz,
+        SCS_12MHz, SCS_13MHz, SCS_14MHz, SCS_15MHz, SCS_16MHz, SCS_18MHz, SCS_20MHz, SCS_22MHz, SCS_24MHz,
+        SCS_26MHz, SCS_28MHz, SCS_30MHz, SCS_32MHz, SCS_36MHz, SCS_40MHz, SCS_44MHz, SCS_48MHz, SCS_52MHz,
+        SCS_56MHz, SCS_60MHz, SCS_64MHz, SCS_72MHz
+    };
+    for(uint32_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++){
+        CLOCK_SetSystemClockSpeed(speeds[i]);
+        TEST_ASSERT_EQUAL(speeds[i], SIM_GetCoreClockHz());
+        TEST_ASSERT_EQUAL(speeds[i], CLOCK_GetSystemClockSpeed());
+        TEST_ASSERT(READ_BIT(RCC->CFGR, RCC_CFGR_SWS) == RCC_CFGR_SWS_PLL);
+
+        uint32_t latency = READ_BIT(FLASH->ACR, FLASH_ACR_LATENCY);   // Wait states {See RM-58}
+        TEST_ASSERT_EQUAL(speeds[i] <= SCS_24MHz ? FLASH_ACR_LATENCY_0 : speeds[i] <= SCS_48MHz ? FLASH_ACR_LATENCY_1 : FLASH_ACR_LATENCY_2, latency);
+    }
+}
+
+static void TEST_CLOCK_Apb1StaysUnder36MHz(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    TEST_ASSERT_EQUAL(36000000, CLOCK_GetAPB1ClockSpeed());
+    TEST_ASSERT_EQUAL(72000000, CLOCK_GetAPB1TimerClockSpeed());
+    TEST_ASSERT_EQUAL(RCC_CFGR_PPRE1_DIV2, READ_BIT(RCC->CFGR, RCC_CFGR_PPRE1));
+
+    CLOCK_SetSystemClockSpeed(SCS_36MHz);
+    TEST_ASSERT_EQUAL(36000000, CLOCK_GetAPB1ClockSpeed());
+    TEST_ASSERT_EQUAL(RCC_CFGR_PPRE1_DIV1, READ_BIT(RCC->CFGR, RCC_CFGR_PPRE1));
+
+    CLOCK_SetAPB2Prescaler(APB_DIV_4);
+    TEST_ASSERT_EQUAL(9000000, CLOCK_GetAPB2ClockSpeed());
+    TEST_ASSERT_EQUAL(RCC_CFGR_PPRE2_DIV4, READ_BIT(RCC->CFGR, RCC_CFGR_PPRE2));
+}
+
+static void TEST_CLOCK_MillisCountsSysTick(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    TEST_ASSERT_EQUAL(72000 - 1, SysTick->LOAD);
+    uint64_t start = Millis();
+    SIM_Run(72000ULL * 250);                        // 250ms
+    TEST_ASSERT_NEAR(250, Millis() - start, 1);
+    TEST_ASSERT_NEAR(250, SIM_GetInterruptCount(SysTick_IRQn), 1);
+}
+
+static void TEST_CLOCK_MicrosIsMonotonic(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    uint64_t startCycles = SIM_GetCycles();
+    uint64_t previous = Micros();
+    uint64_t first = previous;
+    for(uint32_t i = 0; i < 20000; i++){            // Steps of 7us land on every part of the millisecond
+        SIM_Run(7 * 72);
+        uint64_t now = Micros();
+        TEST_ASSERT(now >= previous);
+        previous = now;
+    }
+    TEST_ASSERT_NEAR((SIM_GetCycles() - startCycles) / 72, previous - first, 2);
+}
+
+static void TEST_CLOCK_MicrosCountsPendingRollover(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SIM_Run(72000ULL * 3 + 100);
+    __disable_irq();                                // Like calling Micros from an interrupt of SysTick's priority
+    uint64_t before = Micros();
+    SIM_Run(72000);                                 // SysTick rolls over while it can not be taken
+    uint64_t after = Micros();
+    __enable_irq();
+    TEST_ASSERT_NEAR(1000, after - before, 20);
+}
+#pragma endregion
+
+void TEST_CLOCK(void){
+    TEST_Run("CLOCK: PLL gives every system clock speed", TEST_CLOCK_PllMatchesEverySpeed);
+    TEST_Run("CLOCK: APB1 stays at or under 36MHz", TEST_CLOCK_Apb1StaysUnder36MHz);
+    TEST_Run("CLOCK: Millis counts SysTick interrupts", TEST_CLOCK_MillisCountsSysTick);
+    TEST_Run("CLOCK: Micros never goes backwards", TEST_CLOCK_MicrosIsMonotonic);
+    TEST_Run("CLOCK: Micros counts a pending SysTick rollover", TEST_CLOCK_MicrosCountsPendingRollover);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file TEST_CONTROL.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_CONTROL (Text commands and a closed loop through a simulated LTC1451 wired to an LTC1298)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_CONTROL.h"
+#include "ACDC_GPIO.h"
+#include "ACDC_CLOCK.h"
+
+static uint16_t TestDacCode = 2048;     // Last code written to the DAC, the ADC reads it back (Vout wired to CH0)
+static uint32_t TestDacWrites;
+static bool TestAdcDataFrame;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief LTC1298 on SPI1: answers the data frame after a command frame with the DAC code (MSB first, 3 bits up)
+static uint16_t TEST_CONTROL_Adc(SPI_TypeDef *SPIx, uint16_t mosi);
+
+/// @brief LTC1451 on SPI2: keeps the 12-bit code of every frame
+static uint16_t TEST_CONTROL_Dac(SPI_TypeDef *SPIx, uint16_t mosi);
+
+/// @brief Checks the status line starts with prefix
+/// @param prefix Expected start of CONTROL_AppendStatus
+/// @return True if it matches
+static bool TEST_CONTROL_StatusStartsWith(const char *prefix);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_CONTROL_Commands(void){
+    TEST_ASSERT(CONTROL_HandleCommand("kp 0.25"));
+    TEST_ASSERT(CONTROL_HandleCommand("ki -0.125"));
+    TEST_ASSERT(CONTROL_HandleCommand("shift 5"));
+    TEST_ASSERT(TEST_CONTROL_StatusStartsWith("kp=0.2500 ki=-0.1250 kd=0.0000 shift=5 "));
+
+    TEST_ASSERT(!CONTROL_HandleCommand("shift 9"));     // Over CONTROL_MAX_SHIFT
+    TEST_ASSERT(!CONTROL_HandleCommand("shift x"));
+    TEST_ASSERT(!CONTROL_HandleCommand("kp 1.5"));      // Not a q15
+    TEST_ASSERT(!CONTROL_HandleCommand("kp"));
+    TEST_ASSERT(!CONTROL_HandleCommand("gain 0.5"));
+    TEST_ASSERT(TEST_CONTROL_StatusStartsWith("kp=0.2500 ki=-0.1250 kd=0.0000 shift=5 "));
+
+    TEST_ASSERT(CONTROL_HandleCommand("sp 0.5"));
+    TEST_ASSERT(CONTROL_HandleCommand("max 0.5"));
+    TEST_ASSERT(!CONTROL_HandleCommand("min 0.75"));    // Above max
+    TEST_ASSERT(CONTROL_HandleCommand("min -0.5"));
+}
+
+static void TEST_CONTROL_ClosedLoop(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SIM_SPI_Attach(SPI1, TEST_CONTROL_Adc);
+    SIM_SPI_Attach(SPI2, TEST_CONTROL_Dac);
+    LTC1298_t adc = LTCADC_InitCS(SPI1, GPIOB, GPIO_PIN_6);
+    LTC1451_t dac = LTCDAC_InitCS(SPI2, GPIOB, GPIO_PIN_12);
+
+    TEST_ASSERT(!CONTROL_Init(adc, CONTROL_CH0, TIM3, CONTROL_MAX_RATE + 1));
+    TEST_ASSERT(CONTROL_Init(adc, CONTROL_CH0, TIM3, 1000));
+    TEST_ASSERT(!CONTROL_Start());                      // No output yet
+    CONTROL_SetOutputDAC(dac);
+    TEST_ASSERT(CONTROL_SetGains(0, 8192, 0, 0));      // Integral only, the wire is a 1 step delay
+    CONTROL_SetSetpoint(8192);                          // 0.25
+    TEST_ASSERT(CONTROL_Start());
+
+    SIM_Run(72000ULL * 100 + 36000);                    // 100 steps
+    CONTROL_Stop();
+    CONTROL_Stats_t stats;
+    CONTROL_GetStats(&stats);
+    TEST_ASSERT_EQUAL(100, stats.steps);
+    TEST_ASSERT_EQUAL(0, stats.missedSteps);
+    TEST_ASSERT_EQUAL(100, TestDacWrites);
+    TEST_ASSERT_NEAR(8192, CONTROL_GetInput(), 16);    // 1 LTC1298 code is 16 q15 LSBs
+    TEST_ASSERT_EQUAL((CONTROL_GetOutput() + 32768) >> 4, TestDacCode);
+
+    uint32_t writes = TestDacWrites;
+    SIM_Run(72000ULL * 10);                             // Stopped, the output keeps its last value
+    TEST_ASSERT_EQUAL(writes, TestDacWrites);
+
+    TEST_ASSERT(CONTROL_SetLimits(-32768, 4096));       // The integral does not wind up past the limit
+    CONTROL_SetSetpoint(16384);
+    TEST_ASSERT(CONTROL_Start());
+    SIM_Run(72000ULL * 50);
+    TEST_ASSERT_EQUAL(4096, CONTROL_GetOutput());
+    CONTROL_SetLimits(-32768, 32767);
+    SIM_Run(72000ULL * 2);                              // Leaves the limit on the first step instead of unwinding
+    TEST_ASSERT(CONTROL_GetOutput() > 4096);
+    CONTROL_Stop();
+}
+#pragma endregion
+
+void TEST_CONTROL(void){
+    TEST_Run("CONTROL: text commands", TEST_CONTROL_Commands);
+    TEST_Run("CONTROL: DAC to ADC loop settles on the setpoint", TEST_CONTROL_ClosedLoop);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static uint16_t TEST_CONTROL_Adc(SPI_TypeDef *SPIx, uint16_t mosi){
+    (void)SPIx;
+    if(!TestAdcDataFrame){
+        TestAdcDataFrame = (mosi & 0b1000) != 0;        // Start bit of a command frame
+        return 0;
+    }
+    TestAdcDataFrame = false;
+    return (uint16_t)(TestDacCode << 3);
+}
+
+static uint16_t TEST_CONTROL_Dac(SPI_TypeDef *SPIx, uint16_t mosi){
+    (void)SPIx;
+    TestDacCode = mosi & 0xFFF;
+    TestDacWrites++;
+    return 0;
+}
+
+static bool TEST_CONTROL_StatusStartsWith(const char *prefix){
+    char storage[160];
+    StringBuilder sb = StringBuilderInit(storage, sizeof(storage));
+    CONTROL_AppendStatus(&sb);
+    return strncmp(storage, prefix, strlen(prefix)) == 0;
+}
+#pragma endregion
@@ -0,0 +1,169 @@
+/**
+ * @file TEST_FILTER.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_FILTER against the CMSIS-DSP reference kernels (DSP_Lib_TestSuite/RefLibs)
+ *
+ * FILTER is q15 only. Each test runs a pipeline in place on several blocks (So the state carries over) and the
+ * matching RefLibs kernel on its own instance with separate source and destination buffers, then checks every output
+ * sample is within TEST_FILTER_TOLERANCE_LSB. Both sides accumulate in integers, so they are expected to agree exactly,
+ * the 1 LSB leaves room for a kernel that rounds its final shift.
+ *
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <stdlib.h>
+#include "TEST.h"
+#include "ACDC_FILTER.h"
+#include "ref.h"
+
+#define TEST_FILTER_TOLERANCE_LSB 1     /**< Largest difference allowed from the reference, in q15 LSBs */
+#define TEST_FILTER_BLOCK_SIZE    64
+#define TEST_FILTER_BLOCKS        8
+#define TEST_FILTER_FIR_TAPS      16
+#define TEST_FILTER_DEC_TAPS      24
+#define TEST_FILTER_DEC_FACTOR    4
+
+// 2 low pass sections from bench_main.c {b0, 0, b1, b2, a1, a2} with postShift 1
+static const q15_t TestBiquadCoeffs[2 * 6] = {1106, 0, 2212, 1106, 18727, -6763,
+                                              1106, 0, 2212, 1106, 18727, -6763};
+
+static uint32_t TestSeed = 12345;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Fills a buffer with pseudo random samples in [-limit, +limit]
+/// @param buffer Buffer to fill
+/// @param length Number of samples
+/// @param limit Largest magnitude
+static void TEST_FILTER_Random(q15_t *buffer, uint32_t length, q15_t limit);
+
+/// @brief Largest difference between two sample buffers
+/// @param a First buffer
+/// @param b Second buffer
+/// @param length Number of samples
+/// @return max |a[i] - b[i]| in LSBs
+static uint32_t TEST_FILTER_MaxError(const q15_t *a, const q15_t *b, uint32_t length);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_FILTER_FirMatchesReference(void){
+    q15_t coeffs[TEST_FILTER_FIR_TAPS];
+    TEST_FILTER_Random(coeffs, TEST_FILTER_FIR_TAPS, 2048);
+    q15_t state[TEST_FILTER_FIR_TAPS + TEST_FILTER_BLOCK_SIZE - 1];
+    q15_t refState[TEST_FILTER_FIR_TAPS + TEST_FILTER_BLOCK_SIZE];    // The reference copies one extra sample back
+    memset(refState, 0, sizeof(refState));
+
+    FILTER_Pipeline_t pipeline;
+    FILTER_Init(&pipeline, TEST_FILTER_BLOCK_SIZE);
+    TEST_ASSERT(FILTER_AddFIR(&pipeline, coeffs, TEST_FILTER_FIR_TAPS, state));
+    arm_fir_instance_q15 ref = {TEST_FILTER_FIR_TAPS, refState, coeffs};
+
+    for(uint32_t n = 0; n < TEST_FILTER_BLOCKS; n++){
+        q15_t input[TEST_FILTER_BLOCK_SIZE], block[TEST_FILTER_BLOCK_SIZE], expected[TEST_FILTER_BLOCK_SIZE];
+        TEST_FILTER_Random(input, TEST_FILTER_BLOCK_SIZE, 8192);      // Scaled down log2(16) bits, no wrap around
+        memcpy(block, input, sizeof(block));
+        TEST_ASSERT_EQUAL(TEST_FILTER_BLOCK_SIZE, FILTER_Process(&pipeline, block));
+        ref_fir_fast_q15(&ref, input, expected, TEST_FILTER_BLOCK_SIZE);
+        TEST_ASSERT(TEST_FILTER_MaxError(expected, block, TEST_FILTER_BLOCK_SIZE) <= TEST_FILTER_TOLERANCE_LSB);
+    }
+}
+
+static void TEST_FILTER_BiquadMatchesReference(void){
+    q15_t state[4 * 2], refState[4 * 2] = {0};
+    FILTER_Pipeline_t pipeline;
+    FILTER_Init(&pipeline, TEST_FILTER_BLOCK_SIZE);
+    TEST_ASSERT(FILTER_AddBiquad(&pipeline, TestBiquadCoeffs, 2, state, 1));
+    arm_biquad_casd_df1_inst_q15 ref = {2, refState, (q15_t*)TestBiquadCoeffs, 1};
+
+    for(uint32_t n = 0; n < TEST_FILTER_BLOCKS; n++){
+        q15_t input[TEST_FILTER_BLOCK_SIZE], block[TEST_FILTER_BLOCK_SIZE], expected[TEST_FILTER_BLOCK_SIZE];
+        TEST_FILTER_Random(input, TEST_FILTER_BLOCK_SIZE, 8191);      // [-0.25, +0.25)
+        memcpy(block, input, sizeof(block));
+        FILTER_Process(&pipeline, block);
+        ref_biquad_cascade_df1_fast_q15(&ref, input, expected, TEST_FILTER_BLOCK_SIZE);
+        TEST_ASSERT(TEST_FILTER_MaxError(expected, block, TEST_FILTER_BLOCK_SIZE) <= TEST_FILTER_TOLERANCE_LSB);
+    }
+}
+
+static void TEST_FILTER_PipelineMatchesReference(void){
+    q15_t firCoeffs[TEST_FILTER_FIR_TAPS], decCoeffs[TEST_FILTER_DEC_TAPS];
+    TEST_FILTER_Random(firCoeffs, TEST_FILTER_FIR_TAPS, 2048);
+    TEST_FILTER_Random(decCoeffs, TEST_FILTER_DEC_TAPS, 1365);
+    q15_t firState[TEST_FILTER_FIR_TAPS + TEST_FILTER_BLOCK_SIZE - 1], biquadState[4 * 2];
+    q15_t decState[TEST_FILTER_DEC_TAPS + TEST_FILTER_BLOCK_SIZE - 1];
+    q15_t refFirState[TEST_FILTER_FIR_TAPS + TEST_FILTER_BLOCK_SIZE] = {0}, refBiquadState[4 * 2] = {0};
+    q15_t refDecState[TEST_FILTER_DEC_TAPS + TEST_FILTER_BLOCK_SIZE] = {0};
+
+    FILTER_Pipeline_t pipeline;
+    FILTER_Init(&pipeline, TEST_FILTER_BLOCK_SIZE);
+    TEST_ASSERT(FILTER_AddFIR(&pipeline, firCoeffs, TEST_FILTER_FIR_TAPS, firState));
+    TEST_ASSERT(FILTER_AddBiquad(&pipeline, TestBiquadCoeffs, 2, biquadState, 1));
+    TEST_ASSERT(FILTER_AddDecimator(&pipeline, decCoeffs, TEST_FILTER_DEC_TAPS, TEST_FILTER_DEC_FACTOR, decState));
+    TEST_ASSERT(!FILTER_AddDecimator(&pipeline, decCoeffs, TEST_FILTER_DEC_TAPS, 3, decState));   // 16 is not a multiple of 3
+    TEST_ASSERT_EQUAL(TEST_FILTER_BLOCK_SIZE / TEST_FILTER_DEC_FACTOR, pipeline.outputSize);
+
+    arm_fir_instance_q15 refFir = {TEST_FILTER_FIR_TAPS, refFirState, firCoeffs};
+    arm_biquad_casd_df1_inst_q15 refBiquad = {2, refBiquadState, (q15_t*)TestBiquadCoeffs, 1};
+    arm_fir_decimate_instance_q15 refDec = {TEST_FILTER_DEC_FACTOR, TEST_FILTER_DEC_TAPS, decCoeffs, refDecState};
+
+    for(uint32_t n = 0; n < TEST_FILTER_BLOCKS; n++){
+        q15_t input[TEST_FILTER_BLOCK_SIZE], block[TEST_FILTER_BLOCK_SIZE];
+        q15_t afterFir[TEST_FILTER_BLOCK_SIZE], afterBiquad[TEST_FILTER_BLOCK_SIZE];
+        q15_t expected[TEST_FILTER_BLOCK_SIZE / TEST_FILTER_DEC_FACTOR];
+        TEST_FILTER_Random(input, TEST_FILTER_BLOCK_SIZE, 8192);
+        memcpy(block, input, sizeof(block));
+        TEST_ASSERT_EQUAL(TEST_FILTER_BLOCK_SIZE / TEST_FILTER_DEC_FACTOR, FILTER_Process(&pipeline, block));
+
+        ref_fir_fast_q15(&refFir, input, afterFir, TEST_FILTER_BLOCK_SIZE);
+        ref_biquad_cascade_df1_fast_q15(&refBiquad, afterFir, afterBiquad, TEST_FILTER_BLOCK_SIZE);
+        ref_fir_decimate_q15(&refDec, afterBiquad, expected, TEST_FILTER_BLOCK_SIZE);
+        TEST_ASSERT(TEST_FILTER_MaxError(expected, block, TEST_FILTER_BLOCK_SIZE / TEST_FILTER_DEC_FACTOR) <= TEST_FILTER_TOLERANCE_LSB);
+    }
+}
+
+static void TEST_FILTER_StageLimits(void){
+    q15_t coeffs[4] = {8192, 8192, 8192, 8192}, state[4 + TEST_FILTER_BLOCK_SIZE - 1];
+    FILTER_Pipeline_t pipeline;
+    FILTER_Init(&pipeline, TEST_FILTER_BLOCK_SIZE);
+    TEST_ASSERT(!FILTER_AddFIR(&pipeline, coeffs, 0, state));
+    TEST_ASSERT(!FILTER_AddBiquad(&pipeline, TestBiquadCoeffs, 0, state, 1));
+    TEST_ASSERT(!FILTER_AddDecimator(&pipeline, coeffs, 4, 0, state));
+    TEST_ASSERT_EQUAL(0, pipeline.count);
+
+    q15_t block[TEST_FILTER_BLOCK_SIZE] = {1, 2, 3};
+    TEST_ASSERT_EQUAL(TEST_FILTER_BLOCK_SIZE, FILTER_Process(&pipeline, block));   // No stages, untouched
+    TEST_ASSERT_EQUAL(3, block[2]);
+
+    for(uint32_t i = 0; i < FILTER_MAX_STAGES; i++)
+        TEST_ASSERT(FILTER_AddFIR(&pipeline, coeffs, 4, state));
+    TEST_ASSERT(!FILTER_AddFIR(&pipeline, coeffs, 4, state));
+}
+#pragma endregion
+
+void TEST_FILTER(void){
+    TEST_Run("FILTER: FIR matches ref_fir_fast_q15", TEST_FILTER_FirMatchesReference);
+    TEST_Run("FILTER: biquad matches ref_biquad_cascade_df1_fast_q15", TEST_FILTER_BiquadMatchesReference);
+    TEST_Run("FILTER: FIR, biquad, decimator pipeline matches the reference chain", TEST_FILTER_PipelineMatchesReference);
+    TEST_Run("FILTER: invalid stages and FILTER_MAX_STAGES", TEST_FILTER_StageLimits);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_FILTER_Random(q15_t *buffer, uint32_t length, q15_t limit){
+    for(uint32_t i = 0; i < length; i++){
+        TestSeed = TestSeed * 1664525 + 1013904223;     // Numerical Recipes LCG, same samples every run
+        buffer[i] = (q15_t)((int32_t)((TestSeed >> 16) % (2 * (uint32_t)limit + 1)) - limit);
+    }
+}
+
+static uint32_t TEST_FILTER_MaxError(const q15_t *a, const q15_t *b, uint32_t length){
+    uint32_t maxError = 0;
+    for(uint32_t i = 0; i < length; i++){
+        uint32_t error = (uint32_t)abs(a[i] - b[i]);
+        if(error > maxError)
+            maxError = error;
+    }
+    return maxError;
+}
+#pragma endregion
@@ -0,0 +1,152 @@
+/**
+ * @file TEST_GOERTZEL.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_GOERTZEL against a double precision DFT
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <math.h>
+#include "TEST.h"
+#include "ACDC_GOERTZEL.h"
+
+#define TEST_GOERTZEL_RATE      8000
+#define TEST_GOERTZEL_WINDOW    256
+#define TEST_GOERTZEL_TOLERANCE 2       /**< Largest difference allowed from the DFT level, in q15 LSBs */
+
+static uint8_t TestCallbackTone;
+static bool TestCallbackDetected;
+static uint32_t TestCallbackCount;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Fills a window with the sum of two sines and a little deterministic noise
+/// @param samples TEST_GOERTZEL_WINDOW samples to fill
+/// @param frequency1 Frequency of the first sine in Hz
+/// @param amplitude1 Amplitude of the first sine (Fraction of full scale)
+/// @param frequency2 Frequency of the second sine in Hz
+/// @param amplitude2 Amplitude of the second sine (Fraction of full scale)
+static void TEST_GOERTZEL_Signal(q15_t *samples, double frequency1, double amplitude1, double frequency2, double amplitude2);
+
+/// @brief Level of one frequency over a window, from a double precision DFT (2|X| / N, same scale as GOERTZEL_GetLevel)
+/// @param samples TEST_GOERTZEL_WINDOW samples
+/// @param coefficient 2cos(w) in Q2.14 the tone was given, so the DFT is taken at the frequency the resonator is tuned to
+/// @return Level in q15 LSBs
+static double TEST_GOERTZEL_DftLevel(const q15_t *samples, q15_t coefficient);
+
+/// @brief Detection callback that keeps the last change
+static void TEST_GOERTZEL_Callback(uint8_t tone, bool detected, q15_t level);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_GOERTZEL_MatchesDft(void){
+    static const uint32_t frequencies[] = {697, 770, 1209, 1336, 2000, 3900};
+    GOERTZEL_Bank_t bank;
+    TEST_ASSERT(GOERTZEL_Init(&bank, TEST_GOERTZEL_RATE, TEST_GOERTZEL_WINDOW, 0));
+    for(uint32_t i = 0; i < sizeof(frequencies) / sizeof(frequencies[0]); i++)
+        TEST_ASSERT(GOERTZEL_AddTone(&bank, frequencies[i], 4096));
+
+    static const double signals[][4] = {{697, 0.5, 1209, 0.25}, {770, 0.9, 1336, 0.05}, {2000, 0.3, 3900, 0.6}, {1000, 0.7, 100, 0.2}};
+    for(uint32_t n = 0; n < sizeof(signals) / sizeof(signals[0]); n++){
+        q15_t samples[TEST_GOERTZEL_WINDOW];
+        TEST_GOERTZEL_Signal(samples, signals[n][0], signals[n][1], signals[n][2], signals[n][3]);
+        TEST_ASSERT(!GOERTZEL_AddSamples(&bank, samples, 100));    // Split across calls like ACQUIRE blocks
+        TEST_ASSERT(GOERTZEL_AddSamples(&bank, samples + 100, TEST_GOERTZEL_WINDOW - 100));
+
+        for(uint8_t tone = 0; tone < bank.count; tone++){
+            double expected = TEST_GOERTZEL_DftLevel(samples, bank.tones[tone].coefficient);
+            TEST_ASSERT_NEAR(expected, GOERTZEL_GetLevel(&bank, tone), TEST_GOERTZEL_TOLERANCE);
+        }
+    }
+}
+
+static void TEST_GOERTZEL_ToneRange(void){
+    GOERTZEL_Bank_t bank;
+    TEST_ASSERT(!GOERTZEL_Init(&bank, TEST_GOERTZEL_RATE, GOERTZEL_MAX_WINDOW + 1, 0));
+    TEST_ASSERT(GOERTZEL_Init(&bank, TEST_GOERTZEL_RATE, TEST_GOERTZEL_WINDOW, 0));   // 1 bin is 31.25Hz
+    TEST_ASSERT(!GOERTZEL_AddTone(&bank, 31, 4096));
+    TEST_ASSERT(GOERTZEL_AddTone(&bank, 32, 4096));
+    TEST_ASSERT(!GOERTZEL_AddTone(&bank, 3969, 4096));     // Within 1 bin of 4000Hz
+    TEST_ASSERT(GOERTZEL_AddTone(&bank, 3968, 4096));
+    TEST_ASSERT(!GOERTZEL_AddTone(&bank, 4000, 4096));
+    TEST_ASSERT(!GOERTZEL_AddTone(&bank, 5000, 4096));
+    TEST_ASSERT_EQUAL(2, bank.count);
+
+    // A large sine 1 bin below sampleRate / 2 is read without wrapping the q31 state
+    q15_t samples[TEST_GOERTZEL_WINDOW];
+    TEST_GOERTZEL_Signal(samples, 3968, 0.9, 0, 0);
+    GOERTZEL_AddSamples(&bank, samples, TEST_GOERTZEL_WINDOW);
+    double expected = TEST_GOERTZEL_DftLevel(samples, bank.tones[1].coefficient);
+    TEST_ASSERT_NEAR(expected, GOERTZEL_GetLevel(&bank, 1), TEST_GOERTZEL_TOLERANCE);
+    TEST_ASSERT(GOERTZEL_GetLevel(&bank, 1) > 29000);
+
+    for(uint32_t i = bank.count; i < GOERTZEL_MAX_TONES; i++)
+        TEST_ASSERT(GOERTZEL_AddTone(&bank, 1000, 4096));
+    TEST_ASSERT(!GOERTZEL_AddTone(&bank, 1000, 4096));
+}
+
+static void TEST_GOERTZEL_Hysteresis(void){
+    GOERTZEL_Bank_t bank;
+    TEST_ASSERT(GOERTZEL_Init(&bank, TEST_GOERTZEL_RATE, TEST_GOERTZEL_WINDOW, TEST_GOERTZEL_Callback));
+    TEST_ASSERT(GOERTZEL_AddTone(&bank, 1000, 8192));
+    q15_t samples[TEST_GOERTZEL_WINDOW];
+
+    TEST_GOERTZEL_Signal(samples, 1000, 0.3, 0, 0);         // 9830 >= 8192
+    GOERTZEL_AddSamples(&bank, samples, TEST_GOERTZEL_WINDOW);
+    TEST_ASSERT(GOERTZEL_IsDetected(&bank, 0));
+    TEST_ASSERT_EQUAL(1, TestCallbackCount);
+    TEST_ASSERT(TestCallbackDetected);
+    TEST_ASSERT_EQUAL(0, TestCallbackTone);
+
+    TEST_GOERTZEL_Signal(samples, 1000, 0.2, 0, 0);         // 6553, above 3/4 of the threshold (6144), stays detected
+    GOERTZEL_AddSamples(&bank, samples, TEST_GOERTZEL_WINDOW);
+    TEST_ASSERT(GOERTZEL_IsDetected(&bank, 0));
+    TEST_ASSERT_EQUAL(1, TestCallbackCount);
+
+    TEST_GOERTZEL_Signal(samples, 1000, 0.15, 0, 0);        // 4915, goes away
+    GOERTZEL_AddSamples(&bank, samples, TEST_GOERTZEL_WINDOW);
+    TEST_ASSERT(!GOERTZEL_IsDetected(&bank, 0));
+    TEST_ASSERT_EQUAL(2, TestCallbackCount);
+    TEST_ASSERT(!TestCallbackDetected);
+
+    GOERTZEL_Reset(&bank);
+    TEST_ASSERT_EQUAL(0, GOERTZEL_GetLevel(&bank, 0));
+    TEST_ASSERT_EQUAL(0, GOERTZEL_GetLevel(&bank, 7));      // Not added
+}
+#pragma endregion
+
+void TEST_GOERTZEL(void){
+    TEST_Run("GOERTZEL: levels match a double precision DFT", TEST_GOERTZEL_MatchesDft);
+    TEST_Run("GOERTZEL: tones at least 1 bin from DC and sampleRate / 2", TEST_GOERTZEL_ToneRange);
+    TEST_Run("GOERTZEL: detection hysteresis and callbacks", TEST_GOERTZEL_Hysteresis);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_GOERTZEL_Signal(q15_t *samples, double frequency1, double amplitude1, double frequency2, double amplitude2){
+    uint32_t seed = 1;
+    for(uint32_t i = 0; i < TEST_GOERTZEL_WINDOW; i++){
+        seed = seed * 1664525 + 1013904223;
+        double t = (double)i / TEST_GOERTZEL_RATE;
+        double value = amplitude1 * sin(2 * M_PI * frequency1 * t) + amplitude2 * sin(2 * M_PI * frequency2 * t);
+        samples[i] = (q15_t)lround(value * 32767 + (double)(int32_t)((seed >> 24) % 33) - 16);   // +/- 16 LSB of noise
+    }
+}
+
+static double TEST_GOERTZEL_DftLevel(const q15_t *samples, q15_t coefficient){
+    double w = acos(coefficient / 32768.0);
+    double real = 0, imag = 0;
+    for(uint32_t i = 0; i < TEST_GOERTZEL_WINDOW; i++){
+        real += samples[i] * cos(w * i);
+        imag -= samples[i] * sin(w * i);
+    }
+    return 2 * sqrt(real * real + imag * imag) / TEST_GOERTZEL_WINDOW;
+}
+
+static void TEST_GOERTZEL_Callback(uint8_t tone, bool detected, q15_t level){
+    (void)level;
+    TestCallbackTone = tone;
+    TestCallbackDetected = detected;
+    TestCallbackCount++;
+}
+#pragma endregion
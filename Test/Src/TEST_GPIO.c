@@ -0,0 +1,76 @@
+/**
+ * @file TEST_GPIO.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_GPIO
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_GPIO.h"
+
+#pragma region TESTS
+static void TEST_GPIO_PinNumber(void){
+    for(uint8_t pin = 0; pin < 16; pin++)
+        TEST_ASSERT_EQUAL(pin, GPIO_GetPinNumber(1U << pin));
+}
+
+static void TEST_GPIO_OutputReadsBack(void){
+    GPIO_PinDirection(GPIOA, GPIO_PIN_5, GPIO_MODE_OUTPUT_SPEED_2MHz, GPIO_CNF_OUTPUT_PUSH_PULL);
+    TEST_ASSERT(READ_BIT(RCC->APB2ENR, RCC_APB2ENR_IOPAEN));
+    TEST_ASSERT_EQUAL(0x2, (GPIOA->CRL >> 20) & 0xF);
+    TEST_ASSERT_EQUAL(0x44444444 & ~(0xFUL << 20), GPIOA->CRL & ~(0xFUL << 20));  // Other pins untouched
+
+    GPIO_Set(GPIOA, GPIO_PIN_5);
+    TEST_ASSERT_EQUAL(1, GPIO_Read(GPIOA, GPIO_PIN_5));
+    GPIO_Clear(GPIOA, GPIO_PIN_5);
+    TEST_ASSERT_EQUAL(0, GPIO_Read(GPIOA, GPIO_PIN_5));
+    GPIO_Toggle(GPIOA, GPIO_PIN_5);
+    TEST_ASSERT_EQUAL(1, GPIO_Read(GPIOA, GPIO_PIN_5));
+    GPIO_Write(GPIOA, GPIO_PIN_5, 0);
+    TEST_ASSERT_EQUAL(0, GPIO_Read(GPIOA, GPIO_PIN_5));
+
+    GPIO_PinDirection(GPIOB, GPIO_PIN_12, GPIO_MODE_OUTPUT_SPEED_50MHz, GPIO_CNF_OUTPUT_OPEN_DRAIN);
+    TEST_ASSERT_EQUAL(0x7, (GPIOB->CRH >> 16) & 0xF);
+    GPIO_Write(GPIOB, GPIO_PIN_12, 1);
+    TEST_ASSERT_EQUAL(1, GPIO_Read(GPIOB, GPIO_PIN_12));
+}
+
+static void TEST_GPIO_InputPulls(void){
+    GPIO_PinDirection(GPIOC, GPIO_PIN_13, GPIO_MODE_INPUT, GPIO_CNF_INPUT_PULLUP);
+    TEST_ASSERT_EQUAL(0x8, (GPIOC->CRH >> 20) & 0xF);
+    TEST_ASSERT_EQUAL(1, GPIO_Read(GPIOC, GPIO_PIN_13));
+    SIM_GPIO_Drive(GPIOC, GPIO_PIN_13, false);      // Button pressed
+    TEST_ASSERT_EQUAL(0, GPIO_Read(GPIOC, GPIO_PIN_13));
+    SIM_GPIO_Release(GPIOC, GPIO_PIN_13);
+    TEST_ASSERT_EQUAL(1, GPIO_Read(GPIOC, GPIO_PIN_13));
+
+    GPIO_PinDirection(GPIOC, GPIO_PIN_13, GPIO_MODE_INPUT, GPIO_CNF_INPUT_PULLDOWN);
+    TEST_ASSERT_EQUAL(0, GPIO_Read(GPIOC, GPIO_PIN_13));
+    SIM_GPIO_Drive(GPIOC, GPIO_PIN_13, true);
+    TEST_ASSERT_EQUAL(1, GPIO_Read(GPIOC, GPIO_PIN_13));
+}
+
+static void TEST_GPIO_DeinitRestoresOnlyThatPin(void){
+    for(uint8_t pin = 0; pin < 16; pin++){
+        uint16_t GPIO_PIN = 1U << pin;
+        for(uint8_t other = 0; other < 16; other++)
+            GPIO_PinDirection(GPIOB, 1U << other, GPIO_MODE_OUTPUT_SPEED_50MHz, GPIO_CNF_OUTPUT_PUSH_PULL);
+
+        GPIO_Deinit(GPIOB, GPIO_PIN);
+        for(uint8_t other = 0; other < 16; other++){
+            uint32_t config = ((other < 8 ? GPIOB->CRL : GPIOB->CRH) >> ((other % 8) * 4)) & 0xF;
+            TEST_ASSERT_EQUAL(other == pin ? 0x4 : 0x3, config);
+        }
+    }
+}
+#pragma endregion
+
+void TEST_GPIO(void){
+    TEST_Run("GPIO: pin numbers", TEST_GPIO_PinNumber);
+    TEST_Run("GPIO: outputs read back what they drive", TEST_GPIO_OutputReadsBack);
+    TEST_Run("GPIO: pull-up and pull-down inputs", TEST_GPIO_InputPulls);
+    TEST_Run("GPIO: Deinit restores only its pin", TEST_GPIO_DeinitRestoresOnlyThatPin);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file TEST_INTERRUPT.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_INTERRUPT (NVIC enable/priority, EXTI on GPIO pins)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_INTERRUPT.h"
+#include "ACDC_GPIO.h"
+
+static volatile uint32_t TestExtiCount;
+
+void EXTI15_10_IRQHandler(void){                    // ACDC does not define EXTI handlers, the application does
+    if(READ_BIT(EXTI->PR, EXTI_PR_PR13)){
+        WRITE_REG(EXTI->PR, EXTI_PR_PR13);          // Write 1 to clear
+        TestExtiCount++;
+    }
+}
+
+#pragma region TESTS
+static void TEST_INTERRUPT_EnableBothWords(void){
+    INTERRUPT_Enable(TIM2_IRQn);                    // IRQ 28, word 0
+    INTERRUPT_Enable(USART3_IRQn);                  // IRQ 39, word 1
+    TEST_ASSERT(SIM_IsEnabled(TIM2_IRQn));
+    TEST_ASSERT(SIM_IsEnabled(USART3_IRQn));
+    TEST_ASSERT_EQUAL(1UL << TIM2_IRQn, NVIC->ISER[0]);
+    TEST_ASSERT_EQUAL(1UL << (USART3_IRQn - 32), NVIC->ISER[1]);
+
+    INTERRUPT_Disable(TIM2_IRQn);
+    TEST_ASSERT(!SIM_IsEnabled(TIM2_IRQn));
+    TEST_ASSERT(SIM_IsEnabled(USART3_IRQn));        // Disabling one leaves the others alone
+
+    INTERRUPT_Enable(SysTick_IRQn);                 // System exceptions are not in the NVIC
+    TEST_ASSERT_EQUAL(0, NVIC->ISER[0]);
+}
+
+static void TEST_INTERRUPT_Priorities(void){
+    INTERRUPT_SetPriority(USART2_IRQn, 5);
+    TEST_ASSERT_EQUAL(5 << 4, NVIC->IP[USART2_IRQn]);
+    INTERRUPT_SetPriority(SysTick_IRQn, 3);
+    TEST_ASSERT_EQUAL(3 << 4, SCB->SHP[11]);       // SHPR3 bits [31:24] {See PM-140}
+    INTERRUPT_SetPriority(PendSV_IRQn, 15);
+    TEST_ASSERT_EQUAL(15 << 4, SCB->SHP[10]);
+    INTERRUPT_SetPriority(HardFault_IRQn, 1);       // Fixed priority, nothing is written
+    for(uint32_t i = 0; i < 10; i++)
+        TEST_ASSERT_EQUAL(0, SCB->SHP[i]);
+}
+
+static void TEST_INTERRUPT_ExtiEdges(void){
+    GPIO_PinDirection(GPIOC, GPIO_PIN_13, GPIO_MODE_INPUT, GPIO_CNF_INPUT_PULLUP);
+    GPIO_INT_SetToInterrupt(GPIOC, GPIO_PIN_13, TT_FALLING_EDGE);
+    TEST_ASSERT(READ_BIT(RCC->APB2ENR, RCC_APB2ENR_AFIOEN));
+    TEST_ASSERT_EQUAL(AFIO_EXTICR4_EXTI13_PC, AFIO->EXTICR[3] & AFIO_EXTICR4_EXTI13);
+    TEST_ASSERT(READ_BIT(EXTI->IMR, EXTI_IMR_MR13));
+    TEST_ASSERT(READ_BIT(EXTI->FTSR, EXTI_FTSR_TR13));
+    TEST_ASSERT(!READ_BIT(EXTI->RTSR, EXTI_RTSR_TR13));
+    INTERRUPT_Enable(EXTI15_10_IRQn);
+
+    SIM_GPIO_Drive(GPIOC, GPIO_PIN_13, false);      // Press
+    TEST_ASSERT_EQUAL(1, TestExtiCount);
+    SIM_GPIO_Drive(GPIOC, GPIO_PIN_13, true);       // Release, rising edges are not selected
+    TEST_ASSERT_EQUAL(1, TestExtiCount);
+    SIM_GPIO_Drive(GPIOC, GPIO_PIN_13, false);
+    TEST_ASSERT_EQUAL(2, TestExtiCount);
+
+    GPIO_INT_SetToInterrupt(GPIOA, GPIO_PIN_13, TT_RISING_AND_FALLING_EDGE);   // Line 13 moves to PA13
+    TEST_ASSERT_EQUAL(AFIO_EXTICR4_EXTI13_PA, AFIO->EXTICR[3] & AFIO_EXTICR4_EXTI13);
+    SIM_GPIO_Drive(GPIOC, GPIO_PIN_13, true);
+    TEST_ASSERT_EQUAL(2, TestExtiCount);
+}
+#pragma endregion
+
+void TEST_INTERRUPT(void){
+    TEST_Run("INTERRUPT: enable and disable in both NVIC words", TEST_INTERRUPT_EnableBothWords);
+    TEST_Run("INTERRUPT: NVIC and system handler priorities", TEST_INTERRUPT_Priorities);
+    TEST_Run("INTERRUPT: EXTI follows the selected port and edges", TEST_INTERRUPT_ExtiEdges);
+}
@@ -0,0 +1,200 @@
+/**
+ * @file TEST_POOL.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_POOL (Blocks, exhaustion, size classes, high-water marks, and interrupts allocating)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_POOL.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_USART.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_POOL_TAG_MAIN 0x4D41494E   // Written into blocks the main loop holds
+#define TEST_POOL_TAG_ISR  0x49535220   // Written into blocks the interrupt holds
+
+static POOL_t TestShared;
+static uint32_t *TestIsrBlocks[2];
+static uint32_t TestIsrAllocs;
+static bool TestIsrCorrupt;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Timer callback, keeps up to 2 blocks of TestShared, freeing the older one on every other tick
+static void TEST_POOL_Tick(void);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_POOL_BlocksAndExhaustion(void){
+    static POOL_MEMORY(memory, 20, 3);
+    POOL_t pool;
+    TEST_ASSERT(!POOL_Init(&pool, "bad", NULL, 20, 3));
+    TEST_ASSERT(!POOL_Init(&pool, "bad", memory, 0, 3));
+    TEST_ASSERT(!POOL_Init(&pool, "bad", (uint8_t *)memory + 4, 20, 3));  // Not 8 byte aligned
+    TEST_ASSERT(POOL_Init(&pool, "three", memory, 20, 3));
+    TEST_ASSERT_EQUAL(24, pool.blockSize);
+
+    uint8_t *blocks[3];
+    for(uint32_t i = 0; i < 3; i++){
+        blocks[i] = POOL_AllocFrom(&pool);
+        TEST_ASSERT(blocks[i] != NULL);
+        TEST_ASSERT_EQUAL(0, ((uintptr_t)blocks[i]) % POOL_ALIGNMENT);
+        TEST_ASSERT_EQUAL(24 * i, blocks[i] - (uint8_t *)memory);          // Handed out in order the first time
+        memset(blocks[i], 0xA5, 24);                                        // The whole block is the caller's
+    }
+    TEST_ASSERT(POOL_AllocFrom(&pool) == NULL);
+    TEST_ASSERT(POOL_AllocFrom(&pool) == NULL);
+
+    POOL_Stats_t stats;
+    POOL_GetStats(&pool, &stats);
+    TEST_ASSERT_EQUAL_STRING("three", stats.name);
+    TEST_ASSERT_EQUAL(3, stats.used);
+    TEST_ASSERT_EQUAL(3, stats.highWater);
+    TEST_ASSERT_EQUAL(3, stats.allocs);
+    TEST_ASSERT_EQUAL(2, stats.failures);
+
+    POOL_FreeTo(&pool, blocks[1]);
+    POOL_FreeTo(&pool, blocks[0]);
+    TEST_ASSERT(POOL_AllocFrom(&pool) == blocks[0]);                        // Last freed is first out
+    TEST_ASSERT(POOL_AllocFrom(&pool) == blocks[1]);
+    POOL_FreeTo(&pool, blocks[0]);
+    POOL_FreeTo(&pool, blocks[1]);
+
+    POOL_ResetStats(&pool);                                                 // High-water restarts from the 1 block out
+    POOL_GetStats(&pool, &stats);
+    TEST_ASSERT_EQUAL(1, stats.used);
+    TEST_ASSERT_EQUAL(1, stats.highWater);
+    TEST_ASSERT_EQUAL(0, stats.allocs);
+    TEST_ASSERT_EQUAL(0, stats.failures);
+    blocks[0] = POOL_AllocFrom(&pool);
+    POOL_GetStats(&pool, &stats);
+    TEST_ASSERT_EQUAL(2, stats.highWater);
+}
+
+static void TEST_POOL_SizeClasses(void){
+    static POOL_MEMORY(smallMemory, 16, 2);
+    static POOL_MEMORY(midMemory, 64, 1);
+    static POOL_MEMORY(largeMemory, 256, 1);
+    POOL_t small, mid, large;
+    TEST_ASSERT(POOL_Init(&large, "large", largeMemory, 256, 1));         // Registered out of order
+    TEST_ASSERT(POOL_Init(&small, "small", smallMemory, 16, 2));
+    TEST_ASSERT(POOL_Init(&mid, "mid", midMemory, 64, 1));
+
+    void *a = POOL_Alloc(10), *b = POOL_Alloc(16);
+    TEST_ASSERT(a == smallMemory);                                          // Smallest that fits
+    TEST_ASSERT(b != NULL && b != a);
+    void *c = POOL_Alloc(10);                                               // small is empty, moves up without a failure
+    TEST_ASSERT(c == midMemory);
+    void *d = POOL_Alloc(1);
+    TEST_ASSERT(d == largeMemory);
+    TEST_ASSERT_EQUAL(0, small.failures);
+    TEST_ASSERT_EQUAL(0, mid.failures);
+
+    TEST_ASSERT(POOL_Alloc(10) == NULL);                                    // Every pool that fits is empty
+    TEST_ASSERT_EQUAL(1, small.failures);
+    TEST_ASSERT_EQUAL(0, mid.failures);
+    TEST_ASSERT_EQUAL(0, large.failures);
+    TEST_ASSERT(POOL_Alloc(100) == NULL);                                   // Only large fits
+    TEST_ASSERT_EQUAL(1, large.failures);
+    TEST_ASSERT(POOL_Alloc(257) == NULL);                                   // Nothing fits, no pool to blame
+    TEST_ASSERT_EQUAL(1, small.failures);
+    TEST_ASSERT_EQUAL(0, mid.failures);
+    TEST_ASSERT_EQUAL(1, large.failures);
+
+    uint32_t local;
+    TEST_ASSERT(!POOL_Free(NULL));
+    TEST_ASSERT(!POOL_Free(&local));
+    TEST_ASSERT(!POOL_Free((uint8_t *)c + 8));                              // Inside a block, not its start
+    TEST_ASSERT(POOL_Free(c));
+    TEST_ASSERT(POOL_Free(a));
+    TEST_ASSERT_EQUAL(0, mid.used);
+    TEST_ASSERT_EQUAL(1, small.used);
+    TEST_ASSERT(POOL_Alloc(10) == a);                                       // Back to the smallest class
+    TEST_ASSERT_EQUAL(3, small.allocs);
+    TEST_ASSERT_EQUAL(2, small.highWater);
+}
+
+static void TEST_POOL_InterruptsAllocating(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    static POOL_MEMORY(memory, 32, 4);
+    TEST_ASSERT(POOL_Init(&TestShared, "shared", memory, 32, 4));
+    TEST_ASSERT(TIMER_TICK_Init(TIM2, 500000, TEST_POOL_Tick));
+
+    // Main holds up to 2 blocks while the interrupt takes and frees its own, often inside main's LDREX/STREX
+    uint32_t *held[2] = {NULL, NULL};
+    uint32_t mainAllocs = 0;
+    for(uint32_t i = 0; i < 4000; i++){
+        uint32_t slot = i & 1;
+        if(held[slot] != NULL){
+            TEST_ASSERT_EQUAL(TEST_POOL_TAG_MAIN + slot, held[slot][0]);    // Nobody else was handed the block
+            POOL_FreeTo(&TestShared, held[slot]);
+            held[slot] = NULL;
+        } else if((held[slot] = POOL_AllocFrom(&TestShared)) != NULL){
+            held[slot][0] = TEST_POOL_TAG_MAIN + slot;
+            mainAllocs++;
+        }
+    }
+    TIMER_TICK_Stop(TIM2);
+    TEST_ASSERT(!TestIsrCorrupt);
+    TEST_ASSERT(TestIsrAllocs > 200);
+    for(uint32_t slot = 0; slot < 2; slot++){
+        if(held[slot] != NULL)
+            POOL_FreeTo(&TestShared, held[slot]);
+        if(TestIsrBlocks[slot] != NULL)
+            POOL_FreeTo(&TestShared, TestIsrBlocks[slot]);
+    }
+
+    POOL_Stats_t stats;
+    POOL_GetStats(&TestShared, &stats);
+    TEST_ASSERT_EQUAL(0, stats.used);
+    TEST_ASSERT_EQUAL(mainAllocs + TestIsrAllocs, stats.allocs);
+    TEST_ASSERT_EQUAL(4, stats.highWater);                                  // Both held 2 at once at some point
+    for(uint32_t i = 0; i < 4; i++)                                         // Every block is back on the free list
+        TEST_ASSERT(POOL_AllocFrom(&TestShared) != NULL);
+    TEST_ASSERT(POOL_AllocFrom(&TestShared) == NULL);
+}
+
+static void TEST_POOL_Report(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    static POOL_MEMORY(memory, 12, 2);
+    POOL_t pool;
+    POOL_Init(&pool, "pkt", memory, 12, 2);
+    POOL_Alloc(12);
+    POOL_Alloc(12);
+    POOL_Alloc(12);
+    POOL_Report(USART2);
+    SIM_Poll();
+
+    uint32_t length;
+    const char *output = SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT_EQUAL(strlen("POOL,pkt,16,2,2,2,2,1\r\n"), length);
+    TEST_ASSERT(strncmp(output, "POOL,pkt,16,2,2,2,2,1\r\n", length) == 0);
+}
+#pragma endregion
+
+void TEST_POOL(void){
+    TEST_Run("POOL: blocks, exhaustion, and high-water mark", TEST_POOL_BlocksAndExhaustion);
+    TEST_Run("POOL: size classes only fail when every fitting pool is empty", TEST_POOL_SizeClasses);
+    TEST_Run("POOL: interrupts allocating while the main loop does", TEST_POOL_InterruptsAllocating);
+    TEST_Run("POOL: report line", TEST_POOL_Report);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_POOL_Tick(void){
+    static uint32_t ticks;
+    uint32_t slot = ticks++ & 1;
+    if(TestIsrBlocks[slot] != NULL){
+        if(TestIsrBlocks[slot][0] != TEST_POOL_TAG_ISR + slot)
+            TestIsrCorrupt = true;
+        POOL_FreeTo(&TestShared, TestIsrBlocks[slot]);
+        TestIsrBlocks[slot] = NULL;
+    } else if((TestIsrBlocks[slot] = POOL_AllocFrom(&TestShared)) != NULL){
+        TestIsrBlocks[slot][0] = TEST_POOL_TAG_ISR + slot;
+        TestIsrAllocs++;
+    }
+}
+#pragma endregion
@@ -0,0 +1,321 @@
+/**
+ * @file TEST_RTOS.c
+ * @author Devin Marx
+ * @brief Host unit tests of the ACDC_RTOS kernel (Ready order and round robin, thread flags, mutex handoff and priority
+ *        inheritance, semaphores)
+ *
+ * The simulated PendSV_Handler (ACDC_HOST_TEST) only makes RTOS_NextThread the running thread, so the thread functions
+ * never run. Each test acts as whichever thread osThreadGetId says is running: a call that blocks returns right away with
+ * the caller left blocked, and the test goes on as the thread the kernel switched to.
+ *
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_RTOS.h"
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Thread function, never runs on the host
+/// @param argument Unused
+static void TEST_RTOS_Thread(void *argument);
+
+/// @brief Creates a thread with a name and priority
+/// @param name Thread name
+/// @param priority Thread priority
+/// @return Thread id
+static osThreadId_t TEST_RTOS_NewThread(const char *name, osPriority_t priority);
+
+/// @brief Runs kernel ticks like SysTick_Handler does
+/// @param ticks Ticks to run
+static void TEST_RTOS_Tick(uint32_t ticks);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_RTOS_ReadyOrder(void){
+    TEST_ASSERT_EQUAL(osError, osDelay(1));             // No kernel yet
+    TEST_ASSERT(TEST_RTOS_NewThread("early", osPriorityNormal) == NULL);
+    TEST_ASSERT_EQUAL(osOK, osKernelInitialize());
+    TEST_ASSERT_EQUAL(osKernelReady, osKernelGetState());
+    osThreadId_t a = TEST_RTOS_NewThread("a", osPriorityNormal);
+    osThreadId_t b = TEST_RTOS_NewThread("b", osPriorityNormal);
+    osThreadId_t low = TEST_RTOS_NewThread("low", osPriorityLow);
+    TEST_ASSERT(a != NULL && b != NULL && low != NULL);
+    TEST_ASSERT_EQUAL(osThreadReady, osThreadGetState(a));
+    TEST_ASSERT(osThreadGetId() == NULL);
+
+    TEST_ASSERT_EQUAL(osOK, osKernelStart());           // Returns on the host only
+    TEST_ASSERT_EQUAL(osKernelRunning, osKernelGetState());
+    TEST_ASSERT(osThreadGetId() == a);                  // First of the top priority
+    TEST_ASSERT_EQUAL(osThreadRunning, osThreadGetState(a));
+    TEST_ASSERT_EQUAL(0, RTOS_GetThreadIndex());
+    TEST_ASSERT_EQUAL(osOK, osThreadYield());
+    TEST_ASSERT(osThreadGetId() == b);
+    TEST_ASSERT_EQUAL(1, RTOS_GetThreadIndex());
+    TEST_ASSERT_EQUAL(osOK, osThreadYield());
+    TEST_ASSERT(osThreadGetId() == a);                  // low never gets a turn
+
+    TEST_RTOS_Tick(RTOS_TIME_SLICE - 1);                // Round robin every RTOS_TIME_SLICE ticks
+    TEST_ASSERT(osThreadGetId() == a);
+    TEST_RTOS_Tick(1);
+    TEST_ASSERT(osThreadGetId() == b);
+    TEST_RTOS_Tick(RTOS_TIME_SLICE);
+    TEST_ASSERT(osThreadGetId() == a);
+    TEST_ASSERT_EQUAL(2 * RTOS_TIME_SLICE, osKernelGetTickCount());
+
+    osThreadId_t high = TEST_RTOS_NewThread("high", osPriorityHigh);
+    TEST_ASSERT(osThreadGetId() == high);               // Runs right away
+    TEST_ASSERT_EQUAL(osOK, osDelay(3));
+    TEST_ASSERT_EQUAL(osThreadBlocked, osThreadGetState(high));
+    TEST_ASSERT(osThreadGetId() == a);
+    TEST_RTOS_Tick(2);
+    TEST_ASSERT(osThreadGetId() == a || osThreadGetId() == b);
+    TEST_RTOS_Tick(1);
+    TEST_ASSERT(osThreadGetId() == high);               // Preempts as soon as the delay ends
+
+    osKernelLock();                                     // Woken threads wait for osKernelUnlock
+    TEST_ASSERT_EQUAL(osKernelLocked, osKernelGetState());
+    TEST_ASSERT_EQUAL(osOK, osThreadYield());
+    TEST_ASSERT(osThreadGetId() == high);
+    TEST_ASSERT_EQUAL(osError, osDelay(1));             // Can not block while locked
+    TEST_ASSERT_EQUAL(1, osKernelUnlock());
+
+    osDelay(10);                                        // Everything waits, the idle thread runs
+    osThreadId_t current = osThreadGetId();
+    TEST_ASSERT(current == a || current == b);
+    osDelay(10);
+    current = osThreadGetId();
+    TEST_ASSERT(current != a && current != high);
+    osDelay(10);
+    if(osThreadGetId() == low)
+        osDelay(10);
+    TEST_ASSERT_EQUAL_STRING("idle", osThreadGetName(osThreadGetId()));
+    TEST_ASSERT_EQUAL(RTOS_MAX_THREADS, RTOS_GetThreadIndex());
+    TEST_RTOS_Tick(10);
+    TEST_ASSERT(osThreadGetId() == high);
+}
+
+static void TEST_RTOS_ThreadFlags(void){
+    TEST_ASSERT_EQUAL(osOK, osKernelInitialize());
+    osThreadId_t waiter = TEST_RTOS_NewThread("waiter", osPriorityHigh);
+    osThreadId_t setter = TEST_RTOS_NewThread("setter", osPriorityNormal);
+    osKernelStart();
+    TEST_ASSERT(osThreadGetId() == waiter);
+
+    osThreadFlagsWait(0x3, osFlagsWaitAll, osWaitForever);
+    TEST_ASSERT(osThreadGetId() == setter);
+    TEST_ASSERT_EQUAL(0x1, osThreadFlagsSet(waiter, 0x1));
+    TEST_ASSERT(osThreadGetId() == setter);             // Needs both flags
+    TEST_ASSERT_EQUAL(0x3, osThreadFlagsSet(waiter, 0x2));
+    TEST_ASSERT(osThreadGetId() == waiter);
+    TEST_ASSERT_EQUAL(0, osThreadFlagsGet());           // Cleared by the wait
+
+    TEST_ASSERT_EQUAL(osFlagsErrorResource, osThreadFlagsWait(0x4, osFlagsWaitAny, 0));
+    TEST_ASSERT_EQUAL(0x4, osThreadFlagsSet(waiter, 0x4));
+    TEST_ASSERT_EQUAL(0x4, osThreadFlagsWait(0x4 | 0x8, osFlagsWaitAny | osFlagsNoClear, 0));
+    TEST_ASSERT_EQUAL(0x4, osThreadFlagsGet());
+    TEST_ASSERT_EQUAL(0x4, osThreadFlagsClear(0x4));
+    TEST_ASSERT_EQUAL(0, osThreadFlagsGet());
+    TEST_ASSERT_EQUAL(osFlagsErrorParameter, osThreadFlagsSet(NULL, 0x1));
+    TEST_ASSERT_EQUAL(osFlagsErrorParameter, osThreadFlagsSet(waiter, osFlagsError));
+    TEST_ASSERT_EQUAL(osFlagsErrorParameter, osThreadFlagsWait(0, osFlagsWaitAny, 0));
+
+    osThreadFlagsWait(RTOS_FLAG_DRIVER, osFlagsWaitAny, 2);     // Times out
+    TEST_ASSERT(osThreadGetId() == setter);
+    TEST_RTOS_Tick(1);
+    TEST_ASSERT_EQUAL(osThreadBlocked, osThreadGetState(waiter));
+    TEST_RTOS_Tick(1);
+    TEST_ASSERT(osThreadGetId() == waiter);
+    TEST_ASSERT_EQUAL(osThreadFlagsSet(waiter, 0x10), 0x10);   // The timed out wait took nothing
+}
+
+static void TEST_RTOS_MutexHandoff(void){
+    TEST_ASSERT_EQUAL(osOK, osKernelInitialize());
+    osMutexId_t plain = osMutexNew(NULL);
+    osMutexId_t recursive = osMutexNew(&(osMutexAttr_t){.name = "recursive", .attr_bits = osMutexRecursive});
+    TEST_ASSERT_EQUAL(osError, osMutexAcquire(plain, 0));      // No running thread
+    osThreadId_t first = TEST_RTOS_NewThread("first", osPriorityNormal);
+    osThreadId_t second = TEST_RTOS_NewThread("second", osPriorityNormal);
+    osThreadId_t third = TEST_RTOS_NewThread("third", osPriorityAboveNormal);
+    osKernelStart();
+    TEST_ASSERT(osThreadGetId() == third);
+    osDelay(5);
+    TEST_ASSERT(osThreadGetId() == first);
+
+    TEST_ASSERT_EQUAL(osOK, osMutexAcquire(plain, 0));
+    TEST_ASSERT_EQUAL(osErrorResource, osMutexAcquire(plain, 0));   // Not recursive
+    TEST_ASSERT_EQUAL(osOK, osMutexAcquire(recursive, 0));
+    TEST_ASSERT_EQUAL(osOK, osMutexAcquire(recursive, 0));
+    TEST_ASSERT(osMutexGetOwner(plain) == first);
+    osThreadYield();
+    TEST_ASSERT(osThreadGetId() == second);
+    TEST_ASSERT_EQUAL(osErrorResource, osMutexRelease(plain));      // Not the owner
+    TEST_ASSERT_EQUAL(osErrorResource, osMutexAcquire(plain, 0));
+    osMutexAcquire(plain, osWaitForever);
+    TEST_ASSERT_EQUAL(osThreadBlocked, osThreadGetState(second));
+    TEST_ASSERT(osThreadGetId() == first);
+    TEST_ASSERT_EQUAL(osPriorityNormal, osThreadGetPriority(first));    // No osMutexPrioInherit, nothing to inherit anyway
+
+    TEST_RTOS_Tick(5);                                  // third wakes and waits behind second
+    TEST_ASSERT(osThreadGetId() == third);
+    osMutexAcquire(plain, osWaitForever);
+    TEST_ASSERT(osThreadGetId() == first);
+    TEST_ASSERT_EQUAL(osPriorityNormal, osThreadGetPriority(first));    // Still no inheritance
+
+    TEST_ASSERT_EQUAL(osOK, osMutexRelease(plain));     // Handed to the highest waiter, which runs
+    TEST_ASSERT(osMutexGetOwner(plain) == third);
+    TEST_ASSERT(osThreadGetId() == third);
+    TEST_ASSERT_EQUAL(osOK, osMutexRelease(plain));
+    TEST_ASSERT(osMutexGetOwner(plain) == second);
+    TEST_ASSERT_EQUAL(osThreadReady, osThreadGetState(second));
+    TEST_ASSERT(osThreadGetId() == third);
+
+    osDelay(1);
+    TEST_ASSERT(osThreadGetId() == first);              // Round robin continues after second
+    TEST_ASSERT_EQUAL(osOK, osMutexRelease(recursive));
+    TEST_ASSERT(osMutexGetOwner(recursive) == first);   // Held until released as often as acquired
+    TEST_ASSERT_EQUAL(osOK, osMutexRelease(recursive));
+    TEST_ASSERT(osMutexGetOwner(recursive) == NULL);
+}
+
+static void TEST_RTOS_InheritanceChain(void){
+    TEST_ASSERT_EQUAL(osOK, osKernelInitialize());
+    osMutexId_t first = osMutexNew(&(osMutexAttr_t){.attr_bits = osMutexPrioInherit});
+    osMutexId_t second = osMutexNew(&(osMutexAttr_t){.attr_bits = osMutexPrioInherit});
+    osThreadId_t high = TEST_RTOS_NewThread("high", osPriorityHigh);
+    osThreadId_t mid = TEST_RTOS_NewThread("mid", osPriorityNormal);
+    osThreadId_t low = TEST_RTOS_NewThread("low", osPriorityLow);
+    osKernelStart();
+    osDelay(10);
+    TEST_ASSERT(osThreadGetId() == mid);
+    osDelay(5);
+    TEST_ASSERT(osThreadGetId() == low);
+    TEST_ASSERT_EQUAL(osOK, osMutexAcquire(first, 0));
+
+    TEST_RTOS_Tick(5);                                  // mid takes second, then waits on first held by low
+    TEST_ASSERT(osThreadGetId() == mid);
+    TEST_ASSERT_EQUAL(osOK, osMutexAcquire(second, 0));
+    osMutexAcquire(first, osWaitForever);
+    TEST_ASSERT(osThreadGetId() == low);
+    TEST_ASSERT_EQUAL(osPriorityNormal, osThreadGetPriority(low));
+
+    TEST_RTOS_Tick(5);                                  // high waits on second: high -> mid -> low
+    TEST_ASSERT(osThreadGetId() == high);
+    osMutexAcquire(second, osWaitForever);
+    TEST_ASSERT(osThreadGetId() == low);
+    TEST_ASSERT_EQUAL(osPriorityHigh, osThreadGetPriority(mid));
+    TEST_ASSERT_EQUAL(osPriorityHigh, osThreadGetPriority(low));
+
+    TEST_ASSERT_EQUAL(osOK, osMutexRelease(first));     // mid gets first and keeps high's priority through second
+    TEST_ASSERT_EQUAL(osPriorityLow, osThreadGetPriority(low));
+    TEST_ASSERT(osMutexGetOwner(first) == mid);
+    TEST_ASSERT(osThreadGetId() == mid);
+    TEST_ASSERT_EQUAL(osPriorityHigh, osThreadGetPriority(mid));
+
+    TEST_ASSERT_EQUAL(osOK, osMutexRelease(second));
+    TEST_ASSERT_EQUAL(osPriorityNormal, osThreadGetPriority(mid));
+    TEST_ASSERT(osMutexGetOwner(second) == high);
+    TEST_ASSERT(osThreadGetId() == high);
+    TEST_ASSERT_EQUAL(osOK, osMutexRelease(second));
+    TEST_ASSERT(osMutexGetOwner(second) == NULL);
+}
+
+static void TEST_RTOS_InheritanceTimeout(void){
+    TEST_ASSERT_EQUAL(osOK, osKernelInitialize());
+    osMutexId_t first = osMutexNew(&(osMutexAttr_t){.attr_bits = osMutexPrioInherit});
+    osMutexId_t second = osMutexNew(&(osMutexAttr_t){.attr_bits = osMutexPrioInherit});
+    osThreadId_t high = TEST_RTOS_NewThread("high", osPriorityHigh);
+    osThreadId_t mid = TEST_RTOS_NewThread("mid", osPriorityNormal);
+    osThreadId_t low = TEST_RTOS_NewThread("low", osPriorityLow);
+    osKernelStart();
+    osDelay(10);
+    osDelay(5);
+    TEST_ASSERT(osThreadGetId() == low);
+    TEST_ASSERT_EQUAL(osOK, osMutexAcquire(first, 0));
+    TEST_RTOS_Tick(5);
+    TEST_ASSERT(osThreadGetId() == mid);
+    TEST_ASSERT_EQUAL(osOK, osMutexAcquire(second, 0));
+    osMutexAcquire(first, osWaitForever);
+    TEST_RTOS_Tick(5);
+    TEST_ASSERT(osThreadGetId() == high);
+    osMutexAcquire(second, 3);
+    TEST_ASSERT(osThreadGetId() == low);
+    TEST_ASSERT_EQUAL(osPriorityHigh, osThreadGetPriority(low));
+
+    TEST_RTOS_Tick(2);
+    TEST_ASSERT_EQUAL(osPriorityHigh, osThreadGetPriority(low));
+    TEST_RTOS_Tick(1);                                  // high gives up, the chain drops back to mid's priority
+    TEST_ASSERT(osThreadGetId() == high);
+    TEST_ASSERT(osMutexGetOwner(second) == mid);
+    TEST_ASSERT_EQUAL(osPriorityNormal, osThreadGetPriority(mid));
+    TEST_ASSERT_EQUAL(osPriorityNormal, osThreadGetPriority(low));
+
+    osDelay(100);                                       // high is out of the way, low gets the core back
+    TEST_ASSERT(osThreadGetId() == low);
+    TEST_ASSERT_EQUAL(osOK, osMutexRelease(first));
+    TEST_ASSERT_EQUAL(osPriorityLow, osThreadGetPriority(low));
+    TEST_ASSERT(osThreadGetId() == mid);
+    TEST_ASSERT(osMutexGetOwner(first) == mid);
+}
+
+static void TEST_RTOS_Semaphore(void){
+    TEST_ASSERT(osSemaphoreNew(0, 0, NULL) == NULL);
+    TEST_ASSERT(osSemaphoreNew(1, 2, NULL) == NULL);
+    TEST_ASSERT_EQUAL(osOK, osKernelInitialize());
+    osSemaphoreId_t semaphore = osSemaphoreNew(2, 1, NULL);
+    TEST_ASSERT(semaphore != NULL);
+    osThreadId_t high = TEST_RTOS_NewThread("high", osPriorityHigh);
+    osThreadId_t low = TEST_RTOS_NewThread("low", osPriorityLow);
+    osKernelStart();
+    TEST_ASSERT(osThreadGetId() == high);
+
+    TEST_ASSERT_EQUAL(osOK, osSemaphoreAcquire(semaphore, 0));
+    TEST_ASSERT_EQUAL(0, osSemaphoreGetCount(semaphore));
+    TEST_ASSERT_EQUAL(osErrorResource, osSemaphoreAcquire(semaphore, 0));
+    TEST_ASSERT_EQUAL(osOK, osSemaphoreRelease(semaphore));
+    TEST_ASSERT_EQUAL(osOK, osSemaphoreRelease(semaphore));
+    TEST_ASSERT_EQUAL(2, osSemaphoreGetCount(semaphore));
+    TEST_ASSERT_EQUAL(osErrorResource, osSemaphoreRelease(semaphore));  // Full
+    TEST_ASSERT_EQUAL(osOK, osSemaphoreAcquire(semaphore, 0));
+    TEST_ASSERT_EQUAL(osOK, osSemaphoreAcquire(semaphore, 0));
+
+    osSemaphoreAcquire(semaphore, osWaitForever);
+    TEST_ASSERT(osThreadGetId() == low);
+    TEST_ASSERT_EQUAL(osOK, osSemaphoreRelease(semaphore));    // The token goes straight to high
+    TEST_ASSERT(osThreadGetId() == high);
+    TEST_ASSERT_EQUAL(0, osSemaphoreGetCount(semaphore));
+
+    osSemaphoreAcquire(semaphore, 2);
+    TEST_ASSERT(osThreadGetId() == low);
+    TEST_RTOS_Tick(2);                                  // Times out
+    TEST_ASSERT(osThreadGetId() == high);
+    TEST_ASSERT_EQUAL(osOK, osSemaphoreRelease(semaphore));
+    TEST_ASSERT_EQUAL(1, osSemaphoreGetCount(semaphore));      // Nobody waits, so it is counted
+}
+#pragma endregion
+
+void TEST_RTOS(void){
+    TEST_Run("RTOS: ready order, preemption, and round robin", TEST_RTOS_ReadyOrder);
+    TEST_Run("RTOS: thread flags wait, set, and time out", TEST_RTOS_ThreadFlags);
+    TEST_Run("RTOS: mutexes are handed to the highest waiter", TEST_RTOS_MutexHandoff);
+    TEST_Run("RTOS: priority inheritance through a two mutex chain", TEST_RTOS_InheritanceChain);
+    TEST_Run("RTOS: inherited priority is dropped when a waiter times out", TEST_RTOS_InheritanceTimeout);
+    TEST_Run("RTOS: semaphores count and hand tokens to waiters", TEST_RTOS_Semaphore);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_RTOS_Thread(void *argument){
+    (void)argument;
+}
+
+static osThreadId_t TEST_RTOS_NewThread(const char *name, osPriority_t priority){
+    return osThreadNew(TEST_RTOS_Thread, NULL, &(osThreadAttr_t){.name = name, .stack_size = RTOS_MIN_STACK_SIZE, .priority = priority});
+}
+
+static void TEST_RTOS_Tick(uint32_t ticks){
+    for(uint32_t i = 0; i < ticks; i++)
+        RTOS_Tick();
+}
+#pragma endregion
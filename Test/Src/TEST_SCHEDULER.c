@@ -0,0 +1,198 @@
+/**
+ * @file TEST_SCHEDULER.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_SCHEDULER (Priority and FIFO order, full queues, posts from interrupts, the report)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_SCHEDULER.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_USART.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_SCHEDULER_RUNS 64
+
+static uint32_t TestRuns[TEST_SCHEDULER_RUNS];     // (task << 16) | arg of every run, in order
+static uint32_t TestRunCount;
+static uint8_t TestTickTask;
+static uint32_t TestTickArg;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Task 0, records the run
+static void TEST_SCHEDULER_Task0(uint32_t arg);
+
+/// @brief Task 1, records the run
+static void TEST_SCHEDULER_Task1(uint32_t arg);
+
+/// @brief Task 2, records the run
+static void TEST_SCHEDULER_Task2(uint32_t arg);
+
+/// @brief Records a run of a task
+/// @param task Task number
+/// @param arg Argument it was posted with
+static void TEST_SCHEDULER_Record(uint32_t task, uint32_t arg);
+
+/// @brief Timer callback, posts the next argument to TestTickTask
+static void TEST_SCHEDULER_Tick(void);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_SCHEDULER_PriorityOrder(void){
+    SCHEDULER_Init();
+    TEST_ASSERT_EQUAL(0, SCHEDULER_AddTask("low", TEST_SCHEDULER_Task0, 3));
+    TEST_ASSERT_EQUAL(1, SCHEDULER_AddTask("high", TEST_SCHEDULER_Task1, 0));
+    TEST_ASSERT_EQUAL(2, SCHEDULER_AddTask("mid", TEST_SCHEDULER_Task2, 1));
+    TEST_ASSERT_EQUAL(SCHEDULER_INVALID_TASK, SCHEDULER_AddTask("bad", TEST_SCHEDULER_Task0, SCHEDULER_PRIORITIES));
+    TEST_ASSERT_EQUAL(SCHEDULER_INVALID_TASK, SCHEDULER_AddTask("null", 0, 0));
+    TEST_ASSERT(!SCHEDULER_RunOne());
+    TEST_ASSERT(!SCHEDULER_Post(3, 0));
+
+    TEST_ASSERT(SCHEDULER_Post(0, 10));
+    TEST_ASSERT(SCHEDULER_Post(2, 20));
+    SIM_BreakExclusive();                               // An interrupt between LDREX and STREX, the post retries
+    TEST_ASSERT(SCHEDULER_Post(1, 30));
+    TEST_ASSERT(SCHEDULER_Post(0, 11));
+    TEST_ASSERT(SCHEDULER_Post(1, 31));
+    TEST_ASSERT(SCHEDULER_Post(2, 21));
+    while(SCHEDULER_RunOne()){}
+
+    // Highest priority first, oldest first within a priority
+    static const uint32_t expected[] = {(1 << 16) | 30, (1 << 16) | 31, (2 << 16) | 20, (2 << 16) | 21, 10, 11};
+    TEST_ASSERT_EQUAL(sizeof(expected) / sizeof(expected[0]), TestRunCount);
+    TEST_ASSERT_EQUAL_MEMORY(expected, TestRuns, sizeof(expected));
+
+    SCHEDULER_TaskStats_t stats;
+    TEST_ASSERT(SCHEDULER_GetTaskStats(1, &stats));
+    TEST_ASSERT_EQUAL_STRING("high", stats.name);
+    TEST_ASSERT_EQUAL(2, stats.posts);
+    TEST_ASSERT_EQUAL(2, stats.runs);
+    TEST_ASSERT(!SCHEDULER_GetTaskStats(3, &stats));
+}
+
+static void TEST_SCHEDULER_FullQueue(void){
+    SCHEDULER_Init();
+    SCHEDULER_AddTask("a", TEST_SCHEDULER_Task0, 2);
+    SCHEDULER_AddTask("b", TEST_SCHEDULER_Task1, 2);    // Same queue as a
+    SCHEDULER_AddTask("c", TEST_SCHEDULER_Task2, 1);
+
+    for(uint32_t i = 0; i < SCHEDULER_QUEUE_SIZE; i++)
+        TEST_ASSERT(SCHEDULER_Post(i & 1, i));
+    TEST_ASSERT(!SCHEDULER_Post(0, 100));
+    TEST_ASSERT(!SCHEDULER_Post(1, 101));
+    TEST_ASSERT(SCHEDULER_Post(2, 200));                // Other priorities have their own queue
+
+    SCHEDULER_TaskStats_t stats;
+    SCHEDULER_GetTaskStats(0, &stats);
+    TEST_ASSERT_EQUAL(SCHEDULER_QUEUE_SIZE / 2, stats.posts);
+    TEST_ASSERT_EQUAL(1, stats.dropped);
+
+    // Keep the queue full across several laps, the order holds and nothing more is dropped
+    uint32_t next = SCHEDULER_QUEUE_SIZE;
+    TEST_ASSERT(SCHEDULER_RunOne());                    // c first
+    for(uint32_t lap = 0; lap < 3 * SCHEDULER_QUEUE_SIZE; lap++){
+        TEST_ASSERT(SCHEDULER_RunOne());
+        TEST_ASSERT(SCHEDULER_Post(next & 1, next));
+        TEST_ASSERT(!SCHEDULER_Post(0, 100));
+        next++;
+        if(TestRunCount == TEST_SCHEDULER_RUNS)
+            break;
+    }
+    TEST_ASSERT_EQUAL((2 << 16) | 200, TestRuns[0]);
+    for(uint32_t i = 1; i < TestRunCount; i++)
+        TEST_ASSERT_EQUAL((((i - 1) & 1) << 16) | (i - 1), TestRuns[i]);
+
+    SCHEDULER_Stats_t scheduler;
+    SCHEDULER_GetStats(&scheduler);
+    TEST_ASSERT_EQUAL(SCHEDULER_QUEUE_SIZE, scheduler.maxDepth);
+    SCHEDULER_GetTaskStats(1, &stats);
+    TEST_ASSERT_EQUAL(1, stats.dropped);
+}
+
+static void TEST_SCHEDULER_PostsFromInterrupt(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SCHEDULER_Init();
+    SCHEDULER_AddTask("main", TEST_SCHEDULER_Task0, 1);
+    TestTickTask = SCHEDULER_AddTask("tick", TEST_SCHEDULER_Task1, 0);
+    TEST_ASSERT(TIMER_TICK_Init(TIM2, 50000, TEST_SCHEDULER_Tick));
+
+    // Main posts while the timer interrupt posts to another queue, interrupts land inside LDREX/STREX
+    uint32_t posted = 0;
+    while(TestRunCount < TEST_SCHEDULER_RUNS - 4){
+        if(posted < TEST_SCHEDULER_RUNS / 2 && SCHEDULER_Post(0, posted))
+            posted++;
+        if(!SCHEDULER_RunOne())
+            SIM_Poll();                                 // Lets time pass once main is done posting
+    }
+    TIMER_TICK_Stop(TIM2);
+    while(TestRunCount < TEST_SCHEDULER_RUNS && SCHEDULER_RunOne()){}
+
+    uint32_t nextMain = 0, nextTick = 0;
+    for(uint32_t i = 0; i < TestRunCount; i++){
+        if((TestRuns[i] >> 16) == 0)
+            TEST_ASSERT_EQUAL(nextMain++, TestRuns[i] & 0xFFFF);
+        else
+            TEST_ASSERT_EQUAL(nextTick++, TestRuns[i] & 0xFFFF);
+    }
+    TEST_ASSERT(nextTick > 0);
+    SCHEDULER_TaskStats_t stats;
+    SCHEDULER_GetTaskStats(TestTickTask, &stats);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+}
+
+static void TEST_SCHEDULER_Report(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    SCHEDULER_Init();
+    SCHEDULER_AddTask("fade", TEST_SCHEDULER_Task0, 2);
+    for(uint32_t i = 0; i < 3; i++){
+        SCHEDULER_Post(0, i);
+        SCHEDULER_RunOne();
+    }
+    SCHEDULER_Report(USART2);
+    SIM_Poll();
+
+    uint32_t length;
+    const char *output = SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT(length > 0);
+    TEST_ASSERT(strncmp(output, "TASK,fade,2,3,0,3,", 18) == 0);
+    const char *summary = strstr(output, "SCHEDULER,");
+    TEST_ASSERT(summary != NULL);
+    for(const char *c = output; c < output + length; c++)   // Cycle counts are unsigned
+        TEST_ASSERT(*c != '-');
+}
+#pragma endregion
+
+void TEST_SCHEDULER(void){
+    TEST_Run("SCHEDULER: priority then FIFO order", TEST_SCHEDULER_PriorityOrder);
+    TEST_Run("SCHEDULER: full queues drop posts and keep order across laps", TEST_SCHEDULER_FullQueue);
+    TEST_Run("SCHEDULER: posts from an interrupt and the main loop", TEST_SCHEDULER_PostsFromInterrupt);
+    TEST_Run("SCHEDULER: report lines", TEST_SCHEDULER_Report);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_SCHEDULER_Task0(uint32_t arg){
+    TEST_SCHEDULER_Record(0, arg);
+}
+
+static void TEST_SCHEDULER_Task1(uint32_t arg){
+    TEST_SCHEDULER_Record(1, arg);
+}
+
+static void TEST_SCHEDULER_Task2(uint32_t arg){
+    TEST_SCHEDULER_Record(2, arg);
+}
+
+static void TEST_SCHEDULER_Record(uint32_t task, uint32_t arg){
+    if(TestRunCount < TEST_SCHEDULER_RUNS)
+        TestRuns[TestRunCount++] = (task << 16) | arg;
+}
+
+static void TEST_SCHEDULER_Tick(void){
+    if(SCHEDULER_Post(TestTickTask, TestTickArg))
+        TestTickArg++;
+}
+#pragma endregion
@@ -0,0 +1,145 @@
+/**
+ * @file TEST_SPECTRUM.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_SPECTRUM against a double precision DFT and the full size CMSIS-DSP RFFT tables
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <math.h>
+#include "TEST.h"
+#include "ACDC_SPECTRUM.h"
+
+#define TEST_SPECTRUM_RATE      8000
+#define TEST_SPECTRUM_TOLERANCE 1.5     /**< Largest difference allowed from the DFT magnitude squared, in LSBs of the arm_sqrt_q15 input */
+
+static q15_t TestWindow[SPECTRUM_MAX_SIZE];
+static q15_t TestInput[SPECTRUM_MAX_SIZE];
+static q15_t TestOutput[2 * SPECTRUM_MAX_SIZE];
+static q15_t TestSamples[SPECTRUM_MAX_SIZE];
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Fills TestSamples with the sum of two sines and a little deterministic noise
+/// @param size Samples to fill
+/// @param frequency1 Frequency of the first sine in Hz
+/// @param amplitude1 Amplitude of the first sine (Fraction of full scale)
+/// @param frequency2 Frequency of the second sine in Hz
+/// @param amplitude2 Amplitude of the second sine (Fraction of full scale)
+static void TEST_SPECTRUM_Signal(uint16_t size, double frequency1, double amplitude1, double frequency2, double amplitude2);
+
+/// @brief Magnitude of one bin of the windowed samples from a double precision DFT (|X| / 2N, the scale of SPECTRUM_GetMagnitudes)
+/// @param windowed size samples, already multiplied by the window like arm_mult_q15 does
+/// @param size Samples in the window
+/// @param bin Bin number
+/// @return Magnitude in q15 LSBs
+static double TEST_SPECTRUM_DftMagnitude(const q15_t *windowed, uint16_t size, uint16_t bin);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_SPECTRUM_Sizes(void){
+    SPECTRUM_t spectrum;
+    static const uint16_t unsupported[] = {0, 32, 100, 2048};
+    for(uint32_t i = 0; i < sizeof(unsupported) / sizeof(unsupported[0]); i++)
+        TEST_ASSERT(!SPECTRUM_Init(&spectrum, unsupported[i], TEST_SPECTRUM_RATE, TestWindow, TestInput, TestOutput));
+
+    for(uint16_t size = SPECTRUM_MIN_SIZE; size <= SPECTRUM_MAX_SIZE; size *= 2){
+        TEST_ASSERT(SPECTRUM_Init(&spectrum, size, TEST_SPECTRUM_RATE, TestWindow, TestInput, TestOutput));
+        for(uint16_t i = 0; i < size; i++)                  // Hann window
+            TEST_ASSERT_NEAR(16383.5 * (1 - cos(2 * M_PI * i / size)), TestWindow[i], 2);
+        TEST_ASSERT_EQUAL(0, SPECTRUM_GetMagnitudes(&spectrum)[size / 2 - 1]);
+        TEST_ASSERT_EQUAL(TEST_SPECTRUM_RATE / 2, SPECTRUM_BinToHz(&spectrum, size / 2));
+    }
+}
+
+static void TEST_SPECTRUM_MatchesDft(void){
+    for(uint16_t size = SPECTRUM_MIN_SIZE; size <= SPECTRUM_MAX_SIZE; size *= 2){
+        SPECTRUM_t spectrum;
+        TEST_ASSERT(SPECTRUM_Init(&spectrum, size, TEST_SPECTRUM_RATE, TestWindow, TestInput, TestOutput));
+        TEST_SPECTRUM_Signal(size, 1000, 0.5, 2750, 0.25);
+
+        static q15_t windowed[SPECTRUM_MAX_SIZE];
+        arm_mult_q15(TestSamples, TestWindow, windowed, size);
+        TEST_ASSERT(!SPECTRUM_AddSamples(&spectrum, TestSamples, 50));     // Split across calls like ACQUIRE blocks
+        TEST_ASSERT(SPECTRUM_AddSamples(&spectrum, TestSamples + 50, size - 50));
+
+        // arm_cmplx_mag_q15 truncates the squared magnitude to q15 before arm_sqrt_q15, a bin of 512 reads 512 or 479,
+        // so the bins are compared squared, where that truncation is one LSB at every magnitude
+        const q15_t *magnitudes = SPECTRUM_GetMagnitudes(&spectrum);
+        for(uint16_t bin = 0; bin < size / 2; bin++){
+            double expected = TEST_SPECTRUM_DftMagnitude(windowed, size, bin);
+            TEST_ASSERT_NEAR(expected * expected / 32768, (double)magnitudes[bin] * magnitudes[bin] / 32768, TEST_SPECTRUM_TOLERANCE);
+        }
+    }
+}
+
+static void TEST_SPECTRUM_SameAsFullTables(void){
+    // The subsampled tables with twidCoefRModifier give the same bits as arm_rfft_init_q15 and the full 8192 point tables
+    for(uint16_t size = SPECTRUM_MIN_SIZE; size <= SPECTRUM_MAX_SIZE; size *= 2){
+        SPECTRUM_t spectrum;
+        TEST_ASSERT(SPECTRUM_Init(&spectrum, size, TEST_SPECTRUM_RATE, TestWindow, TestInput, TestOutput));
+        arm_rfft_instance_q15 reference;
+        TEST_ASSERT_EQUAL(ARM_MATH_SUCCESS, arm_rfft_init_q15(&reference, size, 0, 1));
+
+        TEST_SPECTRUM_Signal(size, 440, 0.7, 3000, 0.2);
+        static q15_t scratch[SPECTRUM_MAX_SIZE];
+        static q15_t expected[2 * SPECTRUM_MAX_SIZE];
+        arm_mult_q15(TestSamples, TestWindow, scratch, size);
+        arm_rfft_q15(&reference, scratch, expected);
+        arm_cmplx_mag_q15(expected, expected, size / 2);
+
+        TEST_ASSERT(SPECTRUM_AddSamples(&spectrum, TestSamples, size));
+        TEST_ASSERT_EQUAL_MEMORY(expected, SPECTRUM_GetMagnitudes(&spectrum), size / 2 * sizeof(q15_t));
+    }
+}
+
+static void TEST_SPECTRUM_PeakScaling(void){
+    SPECTRUM_t spectrum;
+    TEST_ASSERT(SPECTRUM_Init(&spectrum, 256, TEST_SPECTRUM_RATE, TestWindow, TestInput, TestOutput));   // 31.25Hz bins
+    TEST_SPECTRUM_Signal(256, 1000, 0.7, 2500, 0.25);      // Bins 32 and 80
+    TEST_ASSERT(SPECTRUM_AddSamples(&spectrum, TestSamples, 256));
+
+    SPECTRUM_Peak_t peaks[3];
+    TEST_ASSERT(SPECTRUM_FindPeaks(&spectrum, peaks, 0) == 0);
+    uint8_t found = SPECTRUM_FindPeaks(&spectrum, peaks, 3);
+    TEST_ASSERT(found >= 2);
+    TEST_ASSERT_EQUAL(32, peaks[0].bin);
+    TEST_ASSERT_EQUAL(80, peaks[1].bin);
+    TEST_ASSERT_NEAR(0.7 * 4096, peaks[0].magnitude, 20);   // A full scale sine reads about 4096
+    TEST_ASSERT_NEAR(0.25 * 4096, peaks[1].magnitude, 20);
+    TEST_ASSERT_EQUAL(1000, SPECTRUM_BinToHz(&spectrum, peaks[0].bin));
+    if(found == 3)
+        TEST_ASSERT(peaks[2].magnitude < 50);              // Only noise is left
+}
+#pragma endregion
+
+void TEST_SPECTRUM(void){
+    TEST_Run("SPECTRUM: supported sizes and the Hann window", TEST_SPECTRUM_Sizes);
+    TEST_Run("SPECTRUM: bins match a double precision DFT at every size", TEST_SPECTRUM_MatchesDft);
+    TEST_Run("SPECTRUM: subsampled RFFT tables match the full tables", TEST_SPECTRUM_SameAsFullTables);
+    TEST_Run("SPECTRUM: peak bins and magnitude scale", TEST_SPECTRUM_PeakScaling);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_SPECTRUM_Signal(uint16_t size, double frequency1, double amplitude1, double frequency2, double amplitude2){
+    uint32_t seed = 1;
+    for(uint32_t i = 0; i < size; i++){
+        seed = seed * 1664525 + 1013904223;
+        double t = (double)i / TEST_SPECTRUM_RATE;
+        double value = amplitude1 * sin(2 * M_PI * frequency1 * t) + amplitude2 * sin(2 * M_PI * frequency2 * t);
+        value = value * 32767 + (double)(int32_t)((seed >> 24) % 33) - 16;     // +/- 16 LSB of noise
+        TestSamples[i] = (q15_t)lround(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+    }
+}
+
+static double TEST_SPECTRUM_DftMagnitude(const q15_t *windowed, uint16_t size, uint16_t bin){
+    double real = 0, imag = 0;
+    for(uint32_t i = 0; i < size; i++){
+        double w = 2 * M_PI * bin * i / size;
+        real += windowed[i] * cos(w);
+        imag -= windowed[i] * sin(w);
+    }
+    return sqrt(real * real + imag * imag) / (2 * size);
+}
+#pragma endregion
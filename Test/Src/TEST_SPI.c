@@ -0,0 +1,158 @@
+/**
+ * @file TEST_SPI.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_SPI
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_SPI.h"
+#include "ACDC_GPIO.h"
+#include "ACDC_CLOCK.h"
+#include "ACDC_WATCHDOG.h"
+
+static uint16_t TestLastMosi;
+static uint32_t TestCsLowFrames;
+static uint16_t TestReceived[4];
+static uint32_t TestReceivedCount;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Device that answers every frame with its bits inverted, and checks CS (PB6) is low while it is clocked
+/// @param SPIx SPI the frame was sent on
+/// @param mosi Frame the master sent
+/// @return ~mosi
+static uint16_t TEST_SPI_Device(SPI_TypeDef *SPIx, uint16_t mosi);
+
+/// @brief Receive callback that keeps the frames it is given
+/// @param data Frame received
+static void TEST_SPI_Callback(uint16_t data);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_SPI_InitMaster(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SPI_InitCS(SPI1, true, GPIOB, GPIO_PIN_6);
+    TEST_ASSERT(READ_BIT(RCC->APB2ENR, RCC_APB2ENR_SPI1EN));
+    uint32_t cr1 = SPI1->CR1;
+    TEST_ASSERT(cr1 & SPI_CR1_SPE);
+    TEST_ASSERT(cr1 & SPI_CR1_MSTR);
+    TEST_ASSERT(cr1 & SPI_CR1_DFF);
+    TEST_ASSERT((cr1 & (SPI_CR1_SSM | SPI_CR1_SSI)) == (SPI_CR1_SSM | SPI_CR1_SSI));
+    TEST_ASSERT_EQUAL(0, cr1 & (SPI_CR1_BR | SPI_CR1_CPHA | SPI_CR1_CPOL | SPI_CR1_LSBFIRST));
+    TEST_ASSERT_EQUAL(0xB, (GPIOA->CRL >> 20) & 0xF);  // SCK PA5 AF push-pull
+    TEST_ASSERT_EQUAL(0x4, (GPIOA->CRL >> 24) & 0xF);  // MISO PA6 floating input
+    TEST_ASSERT_EQUAL(0xB, (GPIOA->CRL >> 28) & 0xF);  // MOSI PA7 AF push-pull
+    TEST_ASSERT_EQUAL(0x3, (GPIOB->CRL >> 24) & 0xF);  // CS PB6 push-pull output
+
+    SPI_EnableRemap(SPI1, true);
+    SPI_InitCS(SPI1, true, GPIOB, GPIO_PIN_6);
+    TEST_ASSERT(READ_BIT(AFIO->MAPR, AFIO_MAPR_SPI1_REMAP));
+    TEST_ASSERT_EQUAL(0xB, (GPIOB->CRL >> 12) & 0xF);  // SCK PB3
+    TEST_ASSERT_EQUAL(0x4, (GPIOB->CRL >> 16) & 0xF);  // MISO PB4
+    TEST_ASSERT_EQUAL(0xB, (GPIOB->CRL >> 20) & 0xF);  // MOSI PB5
+}
+
+static void TEST_SPI_TransferWithCS(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SPI_InitCS(SPI1, true, GPIOB, GPIO_PIN_6);
+    GPIO_Set(GPIOB, GPIO_PIN_6);
+    SIM_SPI_Attach(SPI1, TEST_SPI_Device);
+
+    TEST_ASSERT_EQUAL(0xEDCB, SPI_TransmitReceiveCS(SPI1, 0x1234, GPIOB, GPIO_PIN_6));
+    TEST_ASSERT_EQUAL(0x1234, TestLastMosi);
+    TEST_ASSERT_EQUAL(1, TestCsLowFrames);
+    TEST_ASSERT_EQUAL(1, GPIO_Read(GPIOB, GPIO_PIN_6));  // CS back high
+
+    SPI_TransmitCS(SPI1, 0xA5A5, GPIOB, GPIO_PIN_6);
+    TEST_ASSERT_EQUAL(0xA5A5, TestLastMosi);
+    TEST_ASSERT_EQUAL(2, TestCsLowFrames);
+    TEST_ASSERT_EQUAL(2, SIM_SPI_GetFrameCount(SPI1));
+
+    SPI_SetBitMode(SPI1, SPI_MODE_8Bit);            // Frames are cut to 8 bits both ways
+    TEST_ASSERT(READ_BIT(SPI1->CR1, SPI_CR1_SPE));
+    (void)SPI_Receive(SPI1);                        // Frame left by SPI_TransmitCS
+    TEST_ASSERT_EQUAL(0xCB, SPI_TransmitReceiveCS(SPI1, 0x1234, GPIOB, GPIO_PIN_6));
+    TEST_ASSERT_EQUAL(0x34, TestLastMosi);
+
+    const char *site = 0;
+    TEST_ASSERT_EQUAL(0, WATCHDOG_GetTimeouts(&site));
+}
+
+static void TEST_SPI_BaudDivider(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SPI_InitCS(SPI1, true, GPIOB, GPIO_PIN_6);      // APB2 72MHz
+    SPI_CalculateAndSetBaudDivider(SPI1, 10000000);
+    TEST_ASSERT_EQUAL(SPI_BAUD_DIV_8, (SPI1->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos);
+    SPI_InitCS(SPI2, true, GPIOB, GPIO_PIN_12);     // APB1 36MHz
+    SPI_CalculateAndSetBaudDivider(SPI2, 10000000);
+    TEST_ASSERT_EQUAL(SPI_BAUD_DIV_4, (SPI2->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos);
+    SPI_CalculateAndSetBaudDivider(SPI2, 200000);     // 36MHz / 256 = 140kHz
+    TEST_ASSERT_EQUAL(SPI_BAUD_DIV_256, (SPI2->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos);
+}
+
+static void TEST_SPI_StuckMasterTimesOut(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SPI_InitCS(SPI1, true, GPIOB, GPIO_PIN_6);
+    CLEAR_BIT(RCC->APB2ENR, RCC_APB2ENR_SPI1EN);    // Flags read 0, TXE never comes
+
+    uint64_t start = SIM_GetCycles();
+    SPI_Transmit(SPI1, 0x1234);
+    const char *site = 0;
+    TEST_ASSERT_EQUAL(1, WATCHDOG_GetTimeouts(&site));
+    TEST_ASSERT_EQUAL_STRING("SPI TXE", site);
+    TEST_ASSERT_EQUAL(0, SIM_SPI_GetFrameCount(SPI1));
+    TEST_ASSERT_NEAR(2000 * 72, SIM_GetCycles() - start, 200);  // SPI_TIMEOUT_US and no longer
+}
+
+static void TEST_SPI_SlaveCallback(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SPI_InitCS(SPI2, false, GPIOB, GPIO_PIN_12);
+    TEST_ASSERT(!READ_BIT(SPI2->CR1, SPI_CR1_MSTR));
+    TEST_ASSERT_EQUAL(0x4, (GPIOB->CRH >> 20) & 0xF);  // SCK PB13 floating input
+    TEST_ASSERT_EQUAL(0xB, (GPIOB->CRH >> 24) & 0xF);  // MISO PB14 AF push-pull
+
+    SPI_SetReceiveCallback(SPI2, TEST_SPI_Callback);
+    TEST_ASSERT(READ_BIT(SPI2->CR2, SPI_CR2_RXNEIE));
+    TEST_ASSERT(SIM_IsEnabled(SPI2_IRQn));
+    SIM_SPI_SlaveTransfer(SPI2, 0x1111);
+    SIM_SPI_SlaveTransfer(SPI2, 0x2222);
+    TEST_ASSERT_EQUAL(2, TestReceivedCount);
+    TEST_ASSERT_EQUAL(0x1111, TestReceived[0]);
+    TEST_ASSERT_EQUAL(0x2222, TestReceived[1]);
+    TEST_ASSERT(!SPI_HasDataToRecieve(SPI2));
+
+    SPI_SetReceiveCallback(SPI2, 0);                // Back to polling
+    TEST_ASSERT(!SIM_IsEnabled(SPI2_IRQn));
+    SIM_SPI_SlaveTransfer(SPI2, 0x3333);
+    TEST_ASSERT_EQUAL(2, TestReceivedCount);
+    TEST_ASSERT(SPI_HasDataToRecieve(SPI2));
+    TEST_ASSERT_EQUAL(0x3333, SPI_Receive(SPI2));
+}
+#pragma endregion
+
+void TEST_SPI(void){
+    TEST_Run("SPI: master init and pin remap", TEST_SPI_InitMaster);
+    TEST_Run("SPI: transfers hold CS low", TEST_SPI_TransferWithCS);
+    TEST_Run("SPI: baud divider from the APB clock", TEST_SPI_BaudDivider);
+    TEST_Run("SPI: a stuck master times out", TEST_SPI_StuckMasterTimesOut);
+    TEST_Run("SPI: slave receive callback", TEST_SPI_SlaveCallback);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static uint16_t TEST_SPI_Device(SPI_TypeDef *SPIx, uint16_t mosi){
+    (void)SPIx;
+    TestLastMosi = mosi;
+    if((GPIOB->ODR & GPIO_PIN_6) == 0)              // Plain read, the device sees the pin without an access passing
+        TestCsLowFrames++;
+    return (uint16_t)~mosi;
+}
+
+static void TEST_SPI_Callback(uint16_t data){
+    if(TestReceivedCount < sizeof(TestReceived) / sizeof(TestReceived[0]))
+        TestReceived[TestReceivedCount] = data;
+    TestReceivedCount++;
+}
+#pragma endregion
@@ -0,0 +1,170 @@
+/**
+ * @file TEST_STATS.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_STATS against statistics worked out in double precision
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <math.h>
+#include "TEST.h"
+#include "ACDC_STATS.h"
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_USART.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_STATS_PERIOD 1000      // Not a multiple of the block size or of the 256 sample chunks
+
+static uint32_t TestSeed = 7;
+
+typedef struct{
+    double mean;
+    double rms;
+    double variance;
+    q15_t min;
+    q15_t max;
+}TEST_STATS_Expected;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Fills a buffer with a DC level, a sine, and deterministic noise
+/// @param samples Buffer to fill
+/// @param count Number of samples
+/// @param dc DC level (q15)
+/// @param amplitude Sine amplitude (q15)
+/// @param noise Largest noise magnitude (q15)
+static void TEST_STATS_Signal(q15_t *samples, uint32_t count, int32_t dc, int32_t amplitude, int32_t noise);
+
+/// @brief Works out the statistics of samples in double precision
+/// @param samples q15 samples
+/// @param count Number of samples
+/// @return Mean, RMS, and population variance in q15 units, min and max
+static TEST_STATS_Expected TEST_STATS_Reference(const q15_t *samples, uint32_t count);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_STATS_MatchesReference(void){
+    static const int32_t signals[][3] = {{0, 16000, 100}, {-12000, 3000, 2000}, {20000, 0, 30}, {0, 32000, 0}};
+    STATS_t stats;
+    TEST_ASSERT(STATS_Init(&stats, 3, TEST_STATS_PERIOD));
+
+    for(uint32_t n = 0; n < sizeof(signals) / sizeof(signals[0]); n++){
+        static q15_t samples[TEST_STATS_PERIOD];
+        TEST_STATS_Signal(samples, TEST_STATS_PERIOD, signals[n][0], signals[n][1], signals[n][2]);
+        TEST_ASSERT(!STATS_AddBlock(&stats, samples, 100));             // Uneven blocks, like ACQUIRE blocks of another size
+        TEST_ASSERT(!STATS_AddBlock(&stats, samples + 100, 611));
+        TEST_ASSERT(STATS_AddBlock(&stats, samples + 711, TEST_STATS_PERIOD - 711));
+
+        TEST_STATS_Expected expected = TEST_STATS_Reference(samples, TEST_STATS_PERIOD);
+        const STATS_Summary_t *summary = STATS_GetSummary(&stats);
+        TEST_ASSERT_EQUAL(TEST_STATS_PERIOD, summary->count);
+        TEST_ASSERT_NEAR(expected.mean, summary->mean, 1);
+        TEST_ASSERT_NEAR(expected.rms, summary->rms, 2);
+        TEST_ASSERT_EQUAL(expected.min, summary->min);
+        TEST_ASSERT_EQUAL(expected.max, summary->max);
+        TEST_ASSERT_NEAR(sqrt(expected.variance), summary->stdDev, 2);
+        double variance = expected.variance * 2;                        // q15^2 is Q30, the summary is q31
+        TEST_ASSERT_NEAR(variance, summary->variance, variance * 1e-4 + 64);
+    }
+}
+
+static void TEST_STATS_QuietSignal(void){
+    // A few LSB of noise on a large DC level, where sum of squares minus square of the sum would cancel out
+    STATS_t stats;
+    TEST_ASSERT(STATS_Init(&stats, 0, 4096));
+    static q15_t samples[4096];
+    TEST_STATS_Signal(samples, 4096, 30000, 0, 3);
+    TEST_ASSERT(STATS_AddBlock(&stats, samples, 4096));
+
+    TEST_STATS_Expected expected = TEST_STATS_Reference(samples, 4096);
+    const STATS_Summary_t *summary = STATS_GetSummary(&stats);
+    TEST_ASSERT_NEAR(expected.variance * 2, summary->variance, expected.variance * 2 * 0.01);
+    TEST_ASSERT_NEAR(sqrt(expected.variance), summary->stdDev, 1);
+    TEST_ASSERT_NEAR(expected.mean, summary->mean, 1);
+}
+
+static void TEST_STATS_PeriodsAndReset(void){
+    STATS_t stats;
+    TEST_ASSERT(!STATS_Init(&stats, 0, 0));
+    TEST_ASSERT(!STATS_Init(&stats, 0, STATS_MAX_PERIOD + 1));
+    TEST_ASSERT(STATS_Init(&stats, 0, 10));
+    TEST_ASSERT_EQUAL(0, STATS_GetSummary(&stats)->count);
+
+    q15_t samples[25];
+    for(uint32_t i = 0; i < 25; i++)
+        samples[i] = (q15_t)(i < 10 ? 100 : (i < 20 ? -200 : 5000));
+    TEST_ASSERT(STATS_AddBlock(&stats, samples, 25));                  // 2 periods in one block, the last one is kept
+    TEST_ASSERT_EQUAL(-200, STATS_GetSummary(&stats)->mean);
+    TEST_ASSERT_EQUAL(0, STATS_GetSummary(&stats)->variance);
+
+    STATS_Reset(&stats);                                                // The 5 samples of 5000 are thrown away
+    for(uint32_t i = 0; i < 10; i++)
+        samples[i] = 1000;
+    TEST_ASSERT(STATS_AddBlock(&stats, samples, 10));
+    TEST_ASSERT_EQUAL(1000, STATS_GetSummary(&stats)->mean);
+    TEST_ASSERT_EQUAL(1000, STATS_GetSummary(&stats)->max);
+}
+
+static void TEST_STATS_SendSummary(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TELEMETRY_Init(USART2);
+    STATS_t stats;
+    TEST_ASSERT(STATS_Init(&stats, 7, 4));
+    q15_t samples[4] = {-100, 100, -100, 100};
+    TEST_ASSERT(STATS_AddBlock(&stats, samples, 4));
+    TEST_ASSERT(STATS_SendSummary(&stats));
+    SIM_Poll();
+
+    static const uint8_t payload[] = {7, 4, 0, 0, 0,            // id, count
+                                      0, 0, 100, 0,             // mean, rms
+                                      0x9C, 0xFF, 100, 0,       // min, max
+                                      0x20, 0x4E, 0, 0,         // variance (100^2 * 2 in q31)
+                                      100, 0};                  // stdDev
+    uint32_t length;
+    const uint8_t *output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT_EQUAL(sizeof(payload) + TELEMETRY_FRAME_OVERHEAD, length);
+    TEST_ASSERT_EQUAL(TELEMETRY_STATS_SUMMARY, output[2]);
+    TEST_ASSERT_EQUAL(sizeof(payload), output[4]);
+    TEST_ASSERT_EQUAL_MEMORY(payload, output + 6, sizeof(payload));
+}
+#pragma endregion
+
+void TEST_STATS(void){
+    TEST_Run("STATS: summaries match double precision statistics", TEST_STATS_MatchesReference);
+    TEST_Run("STATS: variance of a quiet signal on a large DC level", TEST_STATS_QuietSignal);
+    TEST_Run("STATS: periods across blocks and Reset", TEST_STATS_PeriodsAndReset);
+    TEST_Run("STATS: summary telemetry payload", TEST_STATS_SendSummary);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_STATS_Signal(q15_t *samples, uint32_t count, int32_t dc, int32_t amplitude, int32_t noise){
+    for(uint32_t i = 0; i < count; i++){
+        TestSeed = TestSeed * 1664525 + 1013904223;
+        int32_t value = dc + (int32_t)lround(amplitude * sin(2 * M_PI * i / 37.0));
+        if(noise != 0)
+            value += (int32_t)((TestSeed >> 8) % (2 * (uint32_t)noise + 1)) - noise;
+        samples[i] = (q15_t)(value > 32767 ? 32767 : (value < -32768 ? -32768 : value));
+    }
+}
+
+static TEST_STATS_Expected TEST_STATS_Reference(const q15_t *samples, uint32_t count){
+    TEST_STATS_Expected expected = {0, 0, 0, 32767, -32768};
+    double sum = 0, sumSquares = 0;
+    for(uint32_t i = 0; i < count; i++){
+        sum += samples[i];
+        sumSquares += (double)samples[i] * samples[i];
+        if(samples[i] < expected.min)
+            expected.min = samples[i];
+        if(samples[i] > expected.max)
+            expected.max = samples[i];
+    }
+    expected.mean = sum / count;
+    expected.rms = sqrt(sumSquares / count);
+    for(uint32_t i = 0; i < count; i++)
+        expected.variance += (samples[i] - expected.mean) * (samples[i] - expected.mean);
+    expected.variance /= count;
+    return expected;
+}
+#pragma endregion
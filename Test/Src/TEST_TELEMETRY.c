@@ -0,0 +1,163 @@
+/**
+ * @file TEST_TELEMETRY.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_TELEMETRY framing (Layout, CRC-16/CCITT-FALSE, sequence numbers, dropped frames)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_USART.h"
+#include "ACDC_WATCHDOG.h"
+#include "ACDC_CLOCK.h"
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Bitwise CRC-16/CCITT-FALSE written from the catalogue parameters (Poly 0x1021, init 0xFFFF, no reflection)
+/// @param data Bytes to run through the CRC
+/// @param length Number of bytes
+/// @return CRC of the bytes
+static uint16_t TEST_TELEMETRY_Crc(const uint8_t *data, uint32_t length);
+
+/// @brief Checks a frame: sync bytes, type, sequence, length, and the CRC over everything after the sync bytes
+/// @param frame Frame bytes
+/// @param frameLength Bytes in frame
+/// @param type Expected type
+/// @param sequence Expected sequence number
+/// @param payload Expected payload
+/// @param length Expected payload bytes
+/// @return True if the frame is exactly what was expected
+static bool TEST_TELEMETRY_FrameIs(const uint8_t *frame, uint32_t frameLength, uint8_t type, uint8_t sequence, const void *payload, uint16_t length);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_TELEMETRY_CrcCheckValue(void){
+    TEST_ASSERT_EQUAL(0x29B1, TEST_TELEMETRY_Crc((const uint8_t*)"123456789", 9));     // Check value of the catalogue
+
+    uint8_t frame[9 + TELEMETRY_FRAME_OVERHEAD];
+    TEST_ASSERT_EQUAL(sizeof(frame), TELEMETRY_EncodeFrame(frame, TELEMETRY_STATS_SUMMARY, "123456789", 9));
+    TEST_ASSERT(TEST_TELEMETRY_FrameIs(frame, sizeof(frame), TELEMETRY_STATS_SUMMARY, 0, "123456789", 9));
+    TEST_ASSERT_EQUAL(0x4E60, frame[15] | (frame[16] << 8));    // Same value bench_main.c checks under QEMU
+}
+
+static void TEST_TELEMETRY_BuiltFrames(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TELEMETRY_Init(USART2);
+
+    TELEMETRY_Begin(TELEMETRY_BLOCK_TIME);
+    TEST_ASSERT(TELEMETRY_AddU8(0x11));
+    TEST_ASSERT(TELEMETRY_AddU16(0x2233));
+    TEST_ASSERT(TELEMETRY_AddU32(0x44556677));
+    TEST_ASSERT(TELEMETRY_AddBytes("xy", 2));
+    TEST_ASSERT_EQUAL(TELEMETRY_MAX_PAYLOAD - 9, TELEMETRY_GetFreeSpace());
+    TEST_ASSERT(TELEMETRY_End());
+    SIM_Poll();
+    TEST_ASSERT(!TELEMETRY_IsSending());
+
+    static const uint8_t payload[] = {0x11, 0x33, 0x22, 0x77, 0x66, 0x55, 0x44, 'x', 'y'};  // Little endian
+    uint32_t length;
+    const uint8_t *output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT(TEST_TELEMETRY_FrameIs(output, length, TELEMETRY_BLOCK_TIME, 0, payload, sizeof(payload)));
+
+    // The polled and encoded frames are the same bytes, each takes the next sequence number
+    SIM_USART_ClearOutput(USART2);
+    TELEMETRY_SendFrame(USART2, TELEMETRY_EXTI_EVENTS, payload, sizeof(payload));
+    output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT(TEST_TELEMETRY_FrameIs(output, length, TELEMETRY_EXTI_EVENTS, 1, payload, sizeof(payload)));
+
+    uint8_t frame[sizeof(payload) + TELEMETRY_FRAME_OVERHEAD];
+    TELEMETRY_EncodeFrame(frame, TELEMETRY_EXTI_EVENTS, payload, sizeof(payload));
+    TEST_ASSERT(TEST_TELEMETRY_FrameIs(frame, sizeof(frame), TELEMETRY_EXTI_EVENTS, 2, payload, sizeof(payload)));
+    TEST_ASSERT_EQUAL_MEMORY(output + 4, frame + 4, sizeof(frame) - 4 - 2);   // Only the sequence and CRC differ
+}
+
+static void TEST_TELEMETRY_OverflowDropsFrame(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TELEMETRY_Init(USART2);
+    static uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+    for(uint32_t i = 0; i < sizeof(payload); i++)
+        payload[i] = (uint8_t)i;
+
+    TELEMETRY_Begin(TELEMETRY_CAPTURE_DATA);
+    TEST_ASSERT(TELEMETRY_AddBytes(payload, TELEMETRY_MAX_PAYLOAD - 1));
+    TEST_ASSERT(!TELEMETRY_AddU16(0));                  // 1 byte left, nothing partial is added
+    TEST_ASSERT(TELEMETRY_AddU8(0xFF));
+    TEST_ASSERT(!TELEMETRY_End());
+    TEST_ASSERT_EQUAL(1, TELEMETRY_GetDroppedFrames());
+    uint32_t length;
+    SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT_EQUAL(0, length);
+
+    TELEMETRY_Begin(TELEMETRY_CAPTURE_DATA);            // A full payload fits, and the dropped frame used no sequence number
+    TEST_ASSERT(TELEMETRY_AddBytes(payload, TELEMETRY_MAX_PAYLOAD));
+    TEST_ASSERT_EQUAL(0, TELEMETRY_GetFreeSpace());
+    TEST_ASSERT(TELEMETRY_End());
+    SIM_Poll();
+    const uint8_t *output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT(TEST_TELEMETRY_FrameIs(output, length, TELEMETRY_CAPTURE_DATA, 0, payload, TELEMETRY_MAX_PAYLOAD));
+    TEST_ASSERT_EQUAL(1, TELEMETRY_GetDroppedFrames());
+}
+
+static void TEST_TELEMETRY_BeginTimesOut(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TELEMETRY_Init(USART2);
+    static const uint8_t payload[] = {1, 2, 3, 4};
+
+    __disable_irq();                                    // The TXE interrupt can not send the first frame
+    TEST_ASSERT(TELEMETRY_Begin(TELEMETRY_STATS_SUMMARY));
+    TELEMETRY_AddBytes(payload, sizeof(payload));
+    TEST_ASSERT(TELEMETRY_End());
+    uint64_t start = SIM_GetCycles();
+    TEST_ASSERT(!TELEMETRY_Begin(TELEMETRY_STATS_SUMMARY));
+    TEST_ASSERT(SIM_GetCycles() - start >= 72ULL * 500000);
+    TEST_ASSERT(!TELEMETRY_AddU8(0xEE));                // The frame going out is left alone
+    TEST_ASSERT(!TELEMETRY_End());
+    __enable_irq();
+    const char *site;
+    TEST_ASSERT_EQUAL(1, WATCHDOG_GetTimeouts(&site));
+    TEST_ASSERT_EQUAL_STRING("TELEMETRY", site);
+    TEST_ASSERT_EQUAL(1, TELEMETRY_GetDroppedFrames());
+
+    SIM_Poll();                                         // Only the first frame went out
+    uint32_t length;
+    const uint8_t *output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT(TEST_TELEMETRY_FrameIs(output, length, TELEMETRY_STATS_SUMMARY, 0, payload, sizeof(payload)));
+    TEST_ASSERT(TELEMETRY_Begin(TELEMETRY_STATS_SUMMARY));
+}
+#pragma endregion
+
+void TEST_TELEMETRY(void){
+    TEST_Run("TELEMETRY: CRC-16/CCITT-FALSE check value", TEST_TELEMETRY_CrcCheckValue);
+    TEST_Run("TELEMETRY: built, polled, and encoded frames", TEST_TELEMETRY_BuiltFrames);
+    TEST_Run("TELEMETRY: a payload overflow drops the frame", TEST_TELEMETRY_OverflowDropsFrame);
+    TEST_Run("TELEMETRY: Begin gives up on a frame that is not moving", TEST_TELEMETRY_BeginTimesOut);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static uint16_t TEST_TELEMETRY_Crc(const uint8_t *data, uint32_t length){
+    uint16_t crc = 0xFFFF;
+    for(uint32_t i = 0; i < length; i++){
+        for(int8_t bit = 7; bit >= 0; bit--){
+            bool feedback = ((crc >> 15) ^ (data[i] >> bit)) & 1;
+            crc = (uint16_t)((crc << 1) ^ (feedback ? 0x1021 : 0));
+        }
+    }
+    return crc;
+}
+
+static bool TEST_TELEMETRY_FrameIs(const uint8_t *frame, uint32_t frameLength, uint8_t type, uint8_t sequence, const void *payload, uint16_t length){
+    if(frameLength != (uint32_t)length + TELEMETRY_FRAME_OVERHEAD)
+        return false;
+    if(frame[0] != TELEMETRY_SYNC_0 || frame[1] != TELEMETRY_SYNC_1 || frame[2] != type || frame[3] != sequence)
+        return false;
+    if((frame[4] | (frame[5] << 8)) != length || memcmp(&frame[6], payload, length) != 0)
+        return false;
+    uint16_t crc = TEST_TELEMETRY_Crc(&frame[2], 4 + length);
+    return frame[6 + length] == (crc & 0xFF) && frame[7 + length] == (crc >> 8);
+}
+#pragma endregion
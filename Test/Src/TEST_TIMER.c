@@ -0,0 +1,100 @@
+/**
+ * @file TEST_TIMER.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_TIMER (TIMER_TICK and PWM)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_GPIO.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_CLOCK.h"
+
+static volatile uint32_t TestTicks;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief TIMER_TICK callback that counts its calls
+static void TEST_TIMER_Tick(void);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_TIMER_TickPeriod(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    TEST_ASSERT(TIMER_TICK_Init(TIM3, 1000, TEST_TIMER_Tick));
+    TEST_ASSERT(READ_BIT(RCC->APB1ENR, RCC_APB1ENR_TIM3EN));
+    TEST_ASSERT_EQUAL(1, TIM3->PSC);                // 72000 ticks do not fit in 16 bits, divide by 2
+    TEST_ASSERT_EQUAL(35999, TIM3->ARR);
+    TEST_ASSERT_EQUAL(1000000, TIMER_TICK_GetPeriodNs(TIM3));
+    TEST_ASSERT(SIM_IsEnabled(TIM3_IRQn));
+    TEST_ASSERT_EQUAL(0, TestTicks);                // The UG update is not a tick
+
+    SIM_Run(72000 / 2);
+    TEST_ASSERT_EQUAL(0, TestTicks);
+    SIM_Run(72000ULL * 10);
+    TEST_ASSERT_EQUAL(10, TestTicks);
+
+    TIMER_TICK_Stop(TIM3);
+    TEST_ASSERT(!SIM_IsEnabled(TIM3_IRQn));
+    SIM_Run(72000ULL * 5);
+    TEST_ASSERT_EQUAL(10, TestTicks);
+}
+
+static void TEST_TIMER_TickInvalid(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    TEST_ASSERT(!TIMER_TICK_Init(TIM1, 1000, TEST_TIMER_Tick));     // TIM1 is kept for PWM
+    TEST_ASSERT(!TIMER_TICK_Init(TIM2, 0, TEST_TIMER_Tick));
+    TEST_ASSERT(!TIMER_TICK_Init(TIM2, 72000001, TEST_TIMER_Tick)); // Faster than the timer clock
+    TEST_ASSERT(!READ_BIT(RCC->APB1ENR, RCC_APB1ENR_TIM2EN));       // Nothing was set up
+
+    TEST_ASSERT(TIMER_TICK_Init(TIM2, 1, TEST_TIMER_Tick));         // Slowest rate, 72M ticks need the prescaler
+    TEST_ASSERT_EQUAL(1098, TIM2->PSC);
+    TEST_ASSERT_NEAR(1000000000, TIMER_TICK_GetPeriodNs(TIM2), 20000);  // Rounded to whole timer ticks
+}
+
+static void TEST_TIMER_Pwm(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    TIMER_PWM_Init(TIM2_CH1_PA0, PWM_MODE_1, 10000);
+    TIMER_PWM_Init(TIM2_CH2_PA1, PWM_MODE_2, 10000);
+    TEST_ASSERT_EQUAL(7199, TIMER_PWM_GetPeriod(TIM2_CH1_PA0));
+    TEST_ASSERT_EQUAL(0, TIM2->PSC);
+    TEST_ASSERT(READ_BIT(TIM2->CR1, TIM_CR1_CEN));
+    TEST_ASSERT_EQUAL(PWM_MODE_1 | TIM_CCMR1_OC1PE, TIM2->CCMR1 & 0xFF);
+    TEST_ASSERT_EQUAL(PWM_MODE_2 | (TIM_CCMR1_OC2PE >> 8), (TIM2->CCMR1 >> 8) & 0xFF);
+    TEST_ASSERT_EQUAL(TIM_CCER_CC1E | TIM_CCER_CC2E, TIM2->CCER);
+    TEST_ASSERT_EQUAL(0xB, GPIOA->CRL & 0xF);       // PA0 AF push-pull
+    TEST_ASSERT_EQUAL(0xB, (GPIOA->CRL >> 4) & 0xF);
+
+    TIMER_PWM_SetDuty(TIM2_CH1_PA0, 3600);
+    TEST_ASSERT_EQUAL(3600, TIMER_PWM_GetDuty(TIM2_CH1_PA0));
+    TIMER_PWM_SetDuty(TIM2_CH2_PA1, 100000);        // Over 100% is clamped to the period
+    TEST_ASSERT_EQUAL(7199, TIMER_PWM_GetDuty(TIM2_CH2_PA1));
+    TEST_ASSERT_EQUAL(3600, TIM2->CCR1);
+
+    TIMER_PWM_Init(TIM4_CH4_PB9, PWM_MODE_1, 1000); // Channels 3 and 4 are in CCMR2
+    TEST_ASSERT_EQUAL(PWM_MODE_1 | TIM_CCMR2_OC4PE >> 8, (TIM4->CCMR2 >> 8) & 0xFF);
+    TEST_ASSERT_EQUAL(TIM_CCER_CC4E, TIM4->CCER);
+}
+
+static void TEST_TIMER_DelayUs(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    uint64_t start = SIM_GetCycles();
+    Delay_US(250);
+    TEST_ASSERT_NEAR(250 * 72, SIM_GetCycles() - start, 2 * 72);
+}
+#pragma endregion
+
+void TEST_TIMER(void){
+    TEST_Run("TIMER: TICK period and callbacks", TEST_TIMER_TickPeriod);
+    TEST_Run("TIMER: TICK rejects what it can not do", TEST_TIMER_TickInvalid);
+    TEST_Run("TIMER: PWM mode, outputs and duty", TEST_TIMER_Pwm);
+    TEST_Run("TIMER: Delay_US", TEST_TIMER_DelayUs);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_TIMER_Tick(void){
+    TestTicks++;
+}
+#pragma endregion
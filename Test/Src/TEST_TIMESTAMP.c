@@ -0,0 +1,189 @@
+/**
+ * @file TEST_TIMESTAMP.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_TIMESTAMP (Event times across a SysTick rollover, the queue, the telemetry frames)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_TIMESTAMP.h"
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_USART.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_TIMESTAMP_EVENT_SIZE 9     // line (u8), time (u32), sampleNumber (u32)
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Finds the payload of the frame at position in the USART2 output
+/// @param output USART2 output
+/// @param length Bytes of output
+/// @param position Index of the frame, moved past it
+/// @param type Frame type expected
+/// @param size Set to the payload size
+/// @return Payload, NULL if there is no frame of that type at position
+static const uint8_t *TEST_TIMESTAMP_Frame(const uint8_t *output, uint32_t length, uint32_t *position, uint8_t type, uint16_t *size);
+
+/// @brief Reads a little endian u32 from a payload
+/// @param data First byte
+/// @return Value
+static uint32_t TEST_TIMESTAMP_U32(const uint8_t *data);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_TIMESTAMP_PendingRollover(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    SIM_Run(72000ULL * 5 + 71000);                  // Near the end of a millisecond
+
+    __disable_irq();                                // Like an EXTI interrupt of SysTick's priority
+    uint64_t before = Micros();
+    SIM_Run(2000);                                  // SysTick rolls over, COUNTFLAG is set and the exception stays pending
+    TEST_ASSERT(READ_BIT(SysTick->CTRL, SysTick_CTRL_COUNTFLAG_Msk));
+    TEST_ASSERT(READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk));
+    TEST_ASSERT(TIMESTAMP_RecordEXTI(13));
+    uint64_t millis = Millis();
+    __enable_irq();
+    TEST_ASSERT_EQUAL(millis + 1, Millis());        // The rollover was only counted once taken
+
+    TIMESTAMP_Event_t event;
+    TEST_ASSERT(TIMESTAMP_GetEvent(&event));
+    TEST_ASSERT_EQUAL(13, event.line);
+    TEST_ASSERT_EQUAL(0, event.sampleNumber);       // ACQUIRE is not running
+    TEST_ASSERT_NEAR(2000 / 72, event.time - (uint32_t)before, 3);     // Not a millisecond behind
+    TEST_ASSERT(event.time / 1000 == Millis() - 1 || event.time / 1000 == Millis());
+    TEST_ASSERT(!TIMESTAMP_GetEvent(&event));
+}
+
+static void TEST_TIMESTAMP_QueueOrder(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    for(uint8_t i = 0; i < TIMESTAMP_MAX_EVENTS; i++){
+        TEST_ASSERT(TIMESTAMP_RecordEXTI(i));
+        SIM_Run(720);
+    }
+    TEST_ASSERT(!TIMESTAMP_RecordEXTI(15));         // Full
+    TEST_ASSERT_EQUAL(1, TIMESTAMP_GetDroppedEvents());
+
+    TIMESTAMP_Event_t event, previous = {0};
+    for(uint8_t i = 0; i < TIMESTAMP_MAX_EVENTS; i++){
+        TEST_ASSERT(TIMESTAMP_GetEvent(&event));
+        TEST_ASSERT_EQUAL(i, event.line);
+        if(i > 0)
+            TEST_ASSERT(event.time - previous.time >= 10);
+        previous = event;
+        if(i == 0)
+            TEST_ASSERT(TIMESTAMP_RecordEXTI(3));   // Takes the slot just freed
+    }
+    TEST_ASSERT(TIMESTAMP_GetEvent(&event));
+    TEST_ASSERT_EQUAL(3, event.line);
+    TEST_ASSERT(!TIMESTAMP_GetEvent(&event));
+    TEST_ASSERT_EQUAL(1, TIMESTAMP_GetDroppedEvents());
+}
+
+static void TEST_TIMESTAMP_Frames(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TELEMETRY_Init(USART2);
+    TEST_ASSERT(TIMESTAMP_SendEvents());            // Nothing to send, no frame
+    SIM_Poll();
+    uint32_t length;
+    SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT_EQUAL(0, length);
+
+    uint32_t times[3];
+    for(uint8_t i = 0; i < 3; i++){
+        times[i] = (uint32_t)Micros();
+        TEST_ASSERT(TIMESTAMP_RecordEXTI(10 + i));
+        SIM_Run(72000);
+    }
+    TEST_ASSERT(TIMESTAMP_SendEvents());
+    SIM_Poll();
+    ACQUIRE_Block_t block = {.firstSample = 256, .timestamp = 123456, .samplePeriod = 125000, .length = 128};
+    TEST_ASSERT(TIMESTAMP_SendBlock(&block));
+    SIM_Poll();
+
+    const uint8_t *output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    uint32_t position = 0;
+    uint16_t size;
+    const uint8_t *payload = TEST_TIMESTAMP_Frame(output, length, &position, TELEMETRY_EXTI_EVENTS, &size);
+    TEST_ASSERT(payload != NULL);
+    TEST_ASSERT_EQUAL(1 + 3 * TEST_TIMESTAMP_EVENT_SIZE, size);
+    TEST_ASSERT_EQUAL(3, payload[0]);
+    for(uint8_t i = 0; i < 3; i++){
+        const uint8_t *event = payload + 1 + i * TEST_TIMESTAMP_EVENT_SIZE;
+        TEST_ASSERT_EQUAL(10 + i, event[0]);
+        TEST_ASSERT_NEAR(times[i], TEST_TIMESTAMP_U32(event + 1), 1);
+        TEST_ASSERT_EQUAL(0, TEST_TIMESTAMP_U32(event + 5));
+    }
+
+    payload = TEST_TIMESTAMP_Frame(output, length, &position, TELEMETRY_BLOCK_TIME, &size);
+    TEST_ASSERT(payload != NULL);
+    TEST_ASSERT_EQUAL(14, size);
+    TEST_ASSERT_EQUAL(256, TEST_TIMESTAMP_U32(payload));
+    TEST_ASSERT_EQUAL(123456, TEST_TIMESTAMP_U32(payload + 4));
+    TEST_ASSERT_EQUAL(125000, TEST_TIMESTAMP_U32(payload + 8));
+    TEST_ASSERT_EQUAL(128, payload[12] | (payload[13] << 8));
+    TEST_ASSERT_EQUAL(length, position);
+
+    TIMESTAMP_Event_t event;
+    TEST_ASSERT(!TIMESTAMP_GetEvent(&event));       // Sent events leave the queue
+}
+
+static void TEST_TIMESTAMP_DroppedFrameKeepsEvents(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TELEMETRY_Init(USART2);
+    TEST_ASSERT(TIMESTAMP_RecordEXTI(4));
+    TEST_ASSERT(TIMESTAMP_RecordEXTI(5));
+
+    __disable_irq();                                // The TXE interrupt can not send the block frame
+    ACQUIRE_Block_t block = {.firstSample = 0, .timestamp = 0, .samplePeriod = 125000, .length = 128};
+    TEST_ASSERT(TIMESTAMP_SendBlock(&block));
+    TEST_ASSERT(!TIMESTAMP_SendEvents());           // TELEMETRY_Begin times out
+    __enable_irq();
+    TEST_ASSERT_EQUAL(1, TELEMETRY_GetDroppedFrames());
+    SIM_Poll();
+
+    TEST_ASSERT(TIMESTAMP_SendEvents());            // Both events go out with the next frame
+    SIM_Poll();
+    uint32_t length, position = 0;
+    uint16_t size;
+    const uint8_t *output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    TEST_ASSERT(TEST_TIMESTAMP_Frame(output, length, &position, TELEMETRY_BLOCK_TIME, &size) != NULL);
+    const uint8_t *payload = TEST_TIMESTAMP_Frame(output, length, &position, TELEMETRY_EXTI_EVENTS, &size);
+    TEST_ASSERT(payload != NULL);
+    TEST_ASSERT_EQUAL(2, payload[0]);
+    TEST_ASSERT_EQUAL(4, payload[1]);
+    TEST_ASSERT_EQUAL(5, payload[1 + TEST_TIMESTAMP_EVENT_SIZE]);
+    TEST_ASSERT_EQUAL(length, position);
+
+    TIMESTAMP_Event_t event;
+    TEST_ASSERT(!TIMESTAMP_GetEvent(&event));
+}
+#pragma endregion
+
+void TEST_TIMESTAMP(void){
+    TEST_Run("TIMESTAMP: event time across a pending SysTick rollover", TEST_TIMESTAMP_PendingRollover);
+    TEST_Run("TIMESTAMP: queue order and dropped events", TEST_TIMESTAMP_QueueOrder);
+    TEST_Run("TIMESTAMP: event and block frames", TEST_TIMESTAMP_Frames);
+    TEST_Run("TIMESTAMP: a dropped frame keeps its events queued", TEST_TIMESTAMP_DroppedFrameKeepsEvents);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static const uint8_t *TEST_TIMESTAMP_Frame(const uint8_t *output, uint32_t length, uint32_t *position, uint8_t type, uint16_t *size){
+    const uint8_t *frame = output + *position;
+    if(*position + TELEMETRY_FRAME_OVERHEAD > length || frame[0] != TELEMETRY_SYNC_0 || frame[1] != TELEMETRY_SYNC_1 || frame[2] != type)
+        return NULL;
+    *size = frame[4] | (frame[5] << 8);
+    if(*position + TELEMETRY_FRAME_OVERHEAD + *size > length)
+        return NULL;
+    *position += TELEMETRY_FRAME_OVERHEAD + *size;
+    return frame + 6;
+}
+
+static uint32_t TEST_TIMESTAMP_U32(const uint8_t *data){
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+#pragma endregion
@@ -0,0 +1,201 @@
+/**
+ * @file TEST_TRACE.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_TRACE (Ring wrap and lost records, frames decoded back into records, interrupt context)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <stdio.h>
+#include "TEST.h"
+#include "ACDC_TRACE.h"
+#include "ACDC_TELEMETRY.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_USART.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_TRACE_RECORDS  256
+#define TEST_TRACE_ID_MAIN  0x100       // Ids of the records the tests write (TRACE_Write does not look them up)
+#define TEST_TRACE_ID_TICK  0x200
+
+// Lands in .trace_fmt with the TRACE() format strings, the ids are the low 16 bits of their addresses on the host
+static const char TestAnchor[] __attribute__((section(".trace_fmt"), used)) = "";
+
+static TRACE_Record_t TestRecords[TEST_TRACE_RECORDS];     // Records decoded from USART2, in order
+static uint32_t TestNumbers[TEST_TRACE_RECORDS];           // Number of each record since TRACE_Init
+static uint32_t TestTicks;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Decodes the TELEMETRY_TRACE_RECORDS frames sent on USART2 into TestRecords and TestNumbers, like
+///        TraceDecoder in Python_Helper/TRACE_Helper.py
+/// @param frames Number of frames found
+/// @param gaps Records missing between frames
+/// @return Number of records decoded (0 if a frame is not a trace frame)
+static uint32_t TEST_TRACE_Decode(uint32_t *frames, uint32_t *gaps);
+
+/// @brief Finds the format string of a TRACE() id, the way TRACE_Format in TRACE_Helper.py indexes the .trace_fmt dump
+/// @param id Event id of a record
+/// @return Format string
+static const char *TEST_TRACE_Format(uint16_t id);
+
+/// @brief Timer callback, writes a record with the tick number
+static void TEST_TRACE_Tick(void);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_TRACE_RingWrap(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TRACE_Init();
+    TEST_ASSERT_EQUAL(1, TRACE_GetPending());
+    TEST_ASSERT_EQUAL(0, TRACE_GetLost());
+
+    for(uint32_t i = 1; i < 100; i++)
+        TRACE_Write(TEST_TRACE_ID_MAIN, i, ~i);
+    TEST_ASSERT_EQUAL(TRACE_BUFFER_RECORDS, TRACE_GetPending());
+    TEST_ASSERT_EQUAL(100 - TRACE_BUFFER_RECORDS, TRACE_GetLost());
+
+    TRACE_Dump(USART2);
+    TRACE_Write(TEST_TRACE_ID_MAIN, 100, 0);                // Recording stopped for the dump
+    TEST_ASSERT_EQUAL(100 - TRACE_BUFFER_RECORDS, TRACE_GetLost());
+
+    // The last 64 records, oldest first: 15 + 15 + 15 + 15 + 4
+    uint32_t frames, gaps;
+    TEST_ASSERT_EQUAL(TRACE_BUFFER_RECORDS, TEST_TRACE_Decode(&frames, &gaps));
+    TEST_ASSERT_EQUAL(5, frames);
+    TEST_ASSERT_EQUAL(0, gaps);
+    for(uint32_t i = 0; i < TRACE_BUFFER_RECORDS; i++){
+        uint32_t number = 100 - TRACE_BUFFER_RECORDS + i;
+        TEST_ASSERT_EQUAL(number, TestNumbers[i]);
+        TEST_ASSERT_EQUAL(TEST_TRACE_ID_MAIN, TestRecords[i].id);
+        TEST_ASSERT_EQUAL(0, TestRecords[i].context);
+        TEST_ASSERT_EQUAL(number, TestRecords[i].arg0);
+        TEST_ASSERT_EQUAL(~number, TestRecords[i].arg1);
+        if(i > 0)
+            TEST_ASSERT(TestRecords[i].time - TestRecords[i - 1].time < 0x80000000);
+    }
+}
+
+static void TEST_TRACE_DrainRoundTrip(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TELEMETRY_Init(USART2);
+    TRACE_Init();
+    TEST_ASSERT(TRACE_Drain());                             // Just the first record
+    SIM_Poll();
+    TEST_ASSERT(!TRACE_Drain());                            // Nothing left
+
+    for(uint32_t i = 1; i < 20; i++)
+        TRACE_Write(TEST_TRACE_ID_MAIN, i, 0);
+    TEST_ASSERT(TRACE_Drain());                             // 15 records per frame
+    TEST_ASSERT_EQUAL(4, TRACE_GetPending());
+    SIM_Poll();
+    TEST_ASSERT(TRACE_Drain());
+    SIM_Poll();
+    TEST_ASSERT_EQUAL(0, TRACE_GetPending());
+
+    for(uint32_t i = 20; i < 120; i++)                      // Laps the ring before the next drain
+        TRACE_Write(TEST_TRACE_ID_MAIN, i, 0);
+    while(TRACE_Drain())
+        SIM_Poll();
+    TEST_ASSERT_EQUAL(100 - TRACE_BUFFER_RECORDS, TRACE_GetLost());
+
+    uint32_t frames, gaps;
+    uint32_t count = TEST_TRACE_Decode(&frames, &gaps);
+    TEST_ASSERT_EQUAL(20 + TRACE_BUFFER_RECORDS, count);
+    TEST_ASSERT_EQUAL(100 - TRACE_BUFFER_RECORDS, gaps);
+    for(uint32_t i = 1; i < count; i++){
+        TEST_ASSERT_EQUAL(TestNumbers[i], TestRecords[i].arg0);
+        TEST_ASSERT_EQUAL(TEST_TRACE_ID_MAIN, TestRecords[i].id);
+    }
+    TEST_ASSERT_EQUAL(19, TestNumbers[19]);
+    TEST_ASSERT_EQUAL(120 - TRACE_BUFFER_RECORDS, TestNumbers[20]);    // Picks up at the oldest record left
+
+    char text[48];
+    snprintf(text, sizeof(text), TEST_TRACE_Format(TestRecords[0].id), TestRecords[0].arg0, TestRecords[0].arg1);
+    TEST_ASSERT_EQUAL_STRING("trace started, 72000000 Hz", text);
+}
+
+static void TEST_TRACE_InterruptContext(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TRACE_Init();
+    TEST_ASSERT(TIMER_TICK_Init(TIM2, 10000, TEST_TRACE_Tick));
+    SIM_Run(72000000 / 10000 * 10);
+    TRACE_SetEnabled(false);
+    uint32_t ticks = TestTicks;
+    TEST_ASSERT(ticks >= 9);
+    SIM_Run(72000000 / 10000 * 10);                         // Ticks keep coming, nothing is recorded
+    TIMER_TICK_Stop(TIM2);
+    TEST_ASSERT(TestTicks > ticks);
+    TEST_ASSERT_EQUAL(1 + ticks, TRACE_GetPending());
+
+    TRACE_Write(TEST_TRACE_ID_MAIN, 0, 0);
+    TEST_ASSERT_EQUAL(1 + ticks, TRACE_GetPending());
+    TRACE_SetEnabled(true);
+    TRACE_Write(TEST_TRACE_ID_MAIN, 0, 0);
+    TRACE_Dump(USART2);
+
+    uint32_t frames, gaps;
+    TEST_ASSERT_EQUAL(2 + ticks, TEST_TRACE_Decode(&frames, &gaps));
+    for(uint32_t i = 1; i <= ticks; i++){
+        TEST_ASSERT_EQUAL(TEST_TRACE_ID_TICK, TestRecords[i].id);
+        TEST_ASSERT_EQUAL(TIM2_IRQn + 16, TestRecords[i].context);
+        TEST_ASSERT_EQUAL(i - 1, TestRecords[i].arg0);
+    }
+    TEST_ASSERT_EQUAL(0, TestRecords[ticks + 1].context);
+}
+#pragma endregion
+
+void TEST_TRACE(void){
+    TEST_Run("TRACE: ring wraps and counts the records lost", TEST_TRACE_RingWrap);
+    TEST_Run("TRACE: drained frames decode back into the records", TEST_TRACE_DrainRoundTrip);
+    TEST_Run("TRACE: interrupt context and recording switched off", TEST_TRACE_InterruptContext);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static uint32_t TEST_TRACE_Decode(uint32_t *frames, uint32_t *gaps){
+    uint32_t length, position = 0, count = 0, next = 0;
+    const uint8_t *output = (const uint8_t*)SIM_USART_GetOutput(USART2, &length);
+    *frames = 0;
+    *gaps = 0;
+    while(position + TELEMETRY_FRAME_OVERHEAD <= length){
+        const uint8_t *payload = output + position + 6;
+        uint16_t size = output[position + 4] | (output[position + 5] << 8);
+        if(output[position + 2] != TELEMETRY_TRACE_RECORDS || size < 8 || (size - 8) % sizeof(TRACE_Record_t) != 0)
+            return 0;
+
+        uint32_t clock, first;
+        memcpy(&clock, payload, sizeof(clock));
+        memcpy(&first, payload + 4, sizeof(first));
+        if(clock != CLOCK_GetSystemClockSpeed())
+            return 0;
+        if(*frames > 0 && first > next)
+            *gaps += first - next;
+        for(uint32_t i = 0; i < (size - 8u) / sizeof(TRACE_Record_t) && count < TEST_TRACE_RECORDS; i++, count++){
+            memcpy(&TestRecords[count], payload + 8 + i * sizeof(TRACE_Record_t), sizeof(TRACE_Record_t));
+            TestNumbers[count] = first + i;
+        }
+        next = first + (size - 8u) / sizeof(TRACE_Record_t);
+        (*frames)++;
+        position += size + TELEMETRY_FRAME_OVERHEAD;
+    }
+    return count;
+}
+
+static const char *TEST_TRACE_Format(uint16_t id){
+    uintptr_t anchor = (uintptr_t)TestAnchor;
+    uintptr_t address = (anchor & ~(uintptr_t)0xFFFF) | id;
+    if(address > anchor + 0x8000)                           // The section can straddle a 64 KiB boundary
+        address -= 0x10000;
+    else if(address + 0x8000 < anchor)
+        address += 0x10000;
+    return (const char*)address;
+}
+
+static void TEST_TRACE_Tick(void){
+    TRACE_Write(TEST_TRACE_ID_TICK, TestTicks++, 0);
+}
+#pragma endregion
@@ -0,0 +1,147 @@
+/**
+ * @file TEST_USART.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_USART
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "TEST.h"
+#include "ACDC_USART.h"
+#include "ACDC_CLOCK.h"
+#include "ACDC_WATCHDOG.h"
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Checks what a USART has transmitted so far
+/// @param USARTx USART (Ex. USART2)
+/// @param expected Bytes it should have sent
+/// @param length Number of bytes in expected
+/// @return True if the output is exactly expected
+static bool TEST_USART_OutputIs(const USART_TypeDef *USARTx, const char *expected, uint32_t length);
+#pragma endregion
+
+#define TEST_USART_OUTPUT_IS(USARTx, LITERAL) TEST_USART_OutputIs((USARTx), (LITERAL), sizeof(LITERAL) - 1)
+
+#pragma region TESTS
+static void TEST_USART_Init(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TEST_ASSERT(READ_BIT(RCC->APB1ENR, RCC_APB1ENR_USART2EN));
+    TEST_ASSERT_EQUAL((19 << 4) | 8, USART2->BRR);     // 36MHz / (16 x 115200) = 19.53 {See RM-798}
+    TEST_ASSERT((USART2->CR1 & (USART_CR1_UE | USART_CR1_TE | USART_CR1_RE)) == (USART_CR1_UE | USART_CR1_TE | USART_CR1_RE));
+    TEST_ASSERT_EQUAL(0xB, (GPIOA->CRL >> 8) & 0xF);   // TX PA2 AF push-pull
+    TEST_ASSERT_EQUAL(0x4, (GPIOA->CRL >> 12) & 0xF);  // RX PA3 floating input
+
+    USART_Init(USART1, Serial_9600, true);          // APB2 72MHz
+    TEST_ASSERT_EQUAL((468 << 4) | 12, USART1->BRR);
+    USART_ChangeSerialSpeed(USART1, Serial_115200);
+    TEST_ASSERT_EQUAL((39 << 4) | 1, USART1->BRR);
+    TEST_ASSERT(READ_BIT(USART1->CR1, USART_CR1_UE));
+}
+
+static void TEST_USART_BlockingSends(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    USART_SendChar(USART2, '>');
+    USART_SendString(USART2, "Hi");
+    USART_SendBuffer(USART2, "a\0b", 3);            // Exactly length bytes, even a '\0'
+    TEST_ASSERT(TEST_USART_OUTPUT_IS(USART2, ">Hi\r\na\0b"));
+}
+
+static void TEST_USART_AsyncSend(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    static char buffer[16] = "async";
+
+    __disable_irq();                                // Nothing goes out until the interrupt can be taken
+    TEST_ASSERT(USART_SendBufferAsync(USART2, buffer, 5));
+    TEST_ASSERT(USART_IsTransmitting(USART2));
+    TEST_ASSERT(!USART_SendBufferAsync(USART2, "x", 1));   // One buffer at a time
+    TEST_ASSERT(TEST_USART_OUTPUT_IS(USART2, ""));
+    __enable_irq();
+
+    SIM_Poll();
+    TEST_ASSERT(!USART_IsTransmitting(USART2));
+    TEST_ASSERT(!READ_BIT(USART2->CR1, USART_CR1_TXEIE));
+    TEST_ASSERT(TEST_USART_OUTPUT_IS(USART2, "async"));
+    TEST_ASSERT_EQUAL(5, SIM_GetInterruptCount(USART2_IRQn));
+
+    char storage[8];
+    StringBuilder sb = StringBuilderInit(storage, sizeof(storage));
+    StringBuilderAppendU32(&sb, 42);
+    TEST_ASSERT(USART_SendStringBuilderAsync(USART2, &sb));
+    TEST_ASSERT(TEST_USART_OUTPUT_IS(USART2, "async42"));
+    TEST_ASSERT(USART_SendBufferAsync(USART2, buffer, 0));
+    TEST_ASSERT(!USART_SendBufferAsync((USART_TypeDef *)GPIOA, buffer, 1));
+
+    StringBuilder large = sb;
+    large.length = 0x10000;                         // Would send nothing if cut to 16 bits
+    TEST_ASSERT(!USART_SendStringBuilderAsync(USART2, &large));
+    TEST_ASSERT(!USART_IsTransmitting(USART2));
+}
+
+static void TEST_USART_BlockingWaitsForAsync(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TEST_ASSERT(USART_SendBufferAsync(USART2, "async", 5));
+    USART_SendString(USART2, "Hi");                 // Goes out after the whole buffer, not between its bytes
+    TEST_ASSERT(TEST_USART_OUTPUT_IS(USART2, "asyncHi\r\n"));
+
+    __disable_irq();                                // The buffer can not move, the blocking send gives up
+    TEST_ASSERT(USART_SendBufferAsync(USART2, "async", 5));
+    USART_SendChar(USART2, '!');
+    const char *site = 0;
+    TEST_ASSERT_EQUAL(1, WATCHDOG_GetTimeouts(&site));
+    TEST_ASSERT_EQUAL_STRING("USART async", site);
+    __enable_irq();
+    SIM_Poll();
+    TEST_ASSERT(TEST_USART_OUTPUT_IS(USART2, "asyncHi\r\nasync"));
+}
+
+static void TEST_USART_Receive(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    TEST_ASSERT(!USART_HasDataToRecieve(USART2));
+    SIM_USART_Send(USART2, "k", 1);
+    TEST_ASSERT(USART_HasDataToRecieve(USART2));
+    TEST_ASSERT_EQUAL('k', USART_RecieveChar(USART2));
+
+    char line[16];
+    SIM_USART_Send(USART2, "GET 5\r\n", 7);
+    USART_RecieveString(USART2, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("GET 5", line);
+    SIM_USART_Send(USART2, "Z", 1);
+    TEST_ASSERT_EQUAL('Z', USART_RecieveChar(USART2));  // Nothing of the line is left behind
+}
+
+static void TEST_USART_StuckTransmitterTimesOut(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    CLEAR_BIT(RCC->APB1ENR, RCC_APB1ENR_USART2EN);  // TXE never comes
+
+    USART_SendString(USART2, "lost");
+    const char *site = 0;
+    TEST_ASSERT(WATCHDOG_GetTimeouts(&site) >= 1);
+    TEST_ASSERT_EQUAL_STRING("USART TXE", site);
+    TEST_ASSERT(TEST_USART_OUTPUT_IS(USART2, ""));
+}
+#pragma endregion
+
+void TEST_USART(void){
+    TEST_Run("USART: init pins and baud rate", TEST_USART_Init);
+    TEST_Run("USART: blocking sends", TEST_USART_BlockingSends);
+    TEST_Run("USART: async send from the TXE interrupt", TEST_USART_AsyncSend);
+    TEST_Run("USART: blocking sends wait for an async buffer", TEST_USART_BlockingWaitsForAsync);
+    TEST_Run("USART: receive characters and lines", TEST_USART_Receive);
+    TEST_Run("USART: a stuck transmitter times out", TEST_USART_StuckTransmitterTimesOut);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static bool TEST_USART_OutputIs(const USART_TypeDef *USARTx, const char *expected, uint32_t length){
+    uint32_t outputLength;
+    const char *output = SIM_USART_GetOutput(USARTx, &outputLength);
+    return outputLength == length && memcmp(output, expected, length) == 0;
+}
+#pragma endregion
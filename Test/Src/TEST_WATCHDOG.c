@@ -0,0 +1,147 @@
+/**
+ * @file TEST_WATCHDOG.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_WATCHDOG (Check-ins keeping the IWDG refreshed, a late task, bounded waits, the report)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <stdio.h>
+#include "TEST.h"
+#include "ACDC_WATCHDOG.h"
+#include "ACDC_TIMER.h"
+#include "ACDC_USART.h"
+#include "ACDC_CLOCK.h"
+
+#define TEST_WATCHDOG_MS 72000ULL       // Cycles per ms at 72MHz
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Lets ms pass 1ms at a time, checking a task in every period ms
+/// @param task Id from WATCHDOG_AddTask (WATCHDOG_INVALID_TASK to check nothing in)
+/// @param period ms between check-ins
+/// @param ms Time to run for
+static void TEST_WATCHDOG_Run(uint8_t task, uint32_t period, uint32_t ms);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_WATCHDOG_CheckInsKeepRefreshing(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    WATCHDOG_Init(100);
+    TEST_ASSERT_EQUAL(0, WATCHDOG_GetTimeouts(0));      // PR and RLR reached the IWDG in time
+    uint8_t adc = WATCHDOG_AddTask("adc", 20);
+    uint8_t loop = WATCHDOG_AddTask("loop", 50);
+    TEST_ASSERT_EQUAL(0, adc);
+    TEST_ASSERT_EQUAL(1, loop);
+    TEST_ASSERT(TIMER_TICK_Init(TIM4, 100, WATCHDOG_Service));
+
+    for(uint32_t i = 0; i < 10; i++){                   // 300ms, adc every 5ms and loop every 30ms
+        TEST_WATCHDOG_Run(adc, 5, 30);
+        WATCHDOG_CheckIn(loop);
+    }
+    TEST_ASSERT(WATCHDOG_IsHealthy());
+    TEST_ASSERT_EQUAL(0, SIM_IWDG_GetResetCount());
+    TEST_ASSERT(SIM_IWDG_GetReloadCount() >= 29);
+    TEST_ASSERT_NEAR(5, WATCHDOG_GetWorstGap(adc), 1);
+    TEST_ASSERT_NEAR(30, WATCHDOG_GetWorstGap(loop), 1);
+
+    for(uint32_t i = 2; i < WATCHDOG_MAX_TASKS; i++)
+        TEST_ASSERT_EQUAL(i, WATCHDOG_AddTask("spare", 1000));
+    TEST_ASSERT_EQUAL(WATCHDOG_INVALID_TASK, WATCHDOG_AddTask("full", 1000));
+    WATCHDOG_CheckIn(WATCHDOG_INVALID_TASK);            // Ignored
+    TEST_ASSERT_EQUAL(0, WATCHDOG_GetWorstGap(WATCHDOG_INVALID_TASK));
+    TIMER_TICK_Stop(TIM4);
+}
+
+static void TEST_WATCHDOG_BoundedWait(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    const char *site;
+    TEST_ASSERT_EQUAL(0, WATCHDOG_GetTimeouts(&site));
+    TEST_ASSERT(site == NULL);
+
+    uint32_t start = WATCHDOG_WaitStart();              // Counter stopped, the first WaitExpired starts it
+    TEST_ASSERT(!WATCHDOG_WaitExpired(start, 1000, "quick"));
+    uint64_t cycles = SIM_GetCycles();
+    uint32_t polls = 0;
+    while(!WATCHDOG_WaitExpired(start, 1000, "SPI TXE")){
+        SIM_Run(720);                                   // 10us per poll of the stuck flag
+        polls++;
+        TEST_ASSERT(polls < 1000);
+    }
+    TEST_ASSERT_NEAR(100, polls, 2);
+    TEST_ASSERT(SIM_GetCycles() - cycles >= 72 * 1000 - 720);
+    TEST_ASSERT_EQUAL(1, WATCHDOG_GetTimeouts(&site));
+    TEST_ASSERT_EQUAL_STRING("SPI TXE", site);
+
+    start = WATCHDOG_WaitStart();
+    TEST_ASSERT(!WATCHDOG_WaitExpired(start, 1000, "quick"));   // Waits that finish in time are not counted
+    TEST_ASSERT_EQUAL(1, WATCHDOG_GetTimeouts(&site));
+    TEST_ASSERT_EQUAL_STRING("SPI TXE", site);
+}
+
+static void TEST_WATCHDOG_LateTaskReported(void){
+    CLOCK_SetSystemClockSpeed(SCS_72MHz);
+    USART_Init(USART2, Serial_115200, true);
+    WATCHDOG_Init(100);
+    uint8_t adc = WATCHDOG_AddTask("adc,ch0", 20);      // The comma would split the CSV line
+    TEST_ASSERT(TIMER_TICK_Init(TIM4, 100, WATCHDOG_Service));
+    TEST_WATCHDOG_Run(adc, 5, 50);
+    uint32_t start = WATCHDOG_WaitStart();
+    while(!WATCHDOG_WaitExpired(start, 1000, "SPI TXE"))
+        SIM_Run(720);
+
+    TEST_WATCHDOG_Run(WATCHDOG_INVALID_TASK, 1, 60);    // adc stops checking in
+    TEST_ASSERT(!WATCHDOG_IsHealthy());
+    uint32_t reloads = SIM_IWDG_GetReloadCount();
+    TEST_ASSERT_EQUAL(0, SIM_IWDG_GetResetCount());
+    WATCHDOG_CheckIn(adc);                              // Too late, the refreshes stay stopped
+    TEST_WATCHDOG_Run(adc, 5, 150);
+    TIMER_TICK_Stop(TIM4);
+    TEST_ASSERT(!WATCHDOG_IsHealthy());
+    TEST_ASSERT_EQUAL(reloads, SIM_IWDG_GetReloadCount());
+    TEST_ASSERT(SIM_IWDG_GetResetCount() >= 1);
+
+    // After the reset the flags name the IWDG and the .noinit record names the late task
+    WATCHDOG_Report(USART2);
+    SIM_Poll();
+    uint32_t length;
+    const char *output = SIM_USART_GetOutput(USART2, &length);
+    static const char reset[] = "RESET,IWDG,2C000000\r\n";     // IWDGRSTF over PORRSTF and PINRSTF from the power on
+    TEST_ASSERT(length > sizeof(reset) - 1);
+    TEST_ASSERT(strncmp(output, reset, sizeof(reset) - 1) == 0);
+    char line[64];
+    uint32_t lineLength = length - (sizeof(reset) - 1);
+    TEST_ASSERT(lineLength < sizeof(line));
+    memcpy(line, output + sizeof(reset) - 1, lineLength);
+    line[lineLength] = '\0';
+    unsigned gap, uptime, end = 0;
+    TEST_ASSERT_EQUAL(2, sscanf(line, "WATCHDOG,adc ch0,%u,20,%u,SPI TXE,1\r\n%n", &gap, &uptime, &end));
+    TEST_ASSERT_EQUAL(lineLength, end);
+    TEST_ASSERT(gap > 20 && gap <= 30);                 // Found by the first service after the deadline
+    TEST_ASSERT(uptime > 50 && uptime <= 100);
+
+    WATCHDOG_Report(USART2);                            // The record is only reported once
+    SIM_Poll();
+    uint32_t again;
+    output = SIM_USART_GetOutput(USART2, &again);
+    TEST_ASSERT_EQUAL(length + sizeof(reset) - 1, again);
+    TEST_ASSERT(strncmp(output + length, reset, sizeof(reset) - 1) == 0);
+}
+#pragma endregion
+
+void TEST_WATCHDOG(void){
+    TEST_Run("WATCHDOG: check-ins keep the IWDG refreshed", TEST_WATCHDOG_CheckInsKeepRefreshing);
+    TEST_Run("WATCHDOG: bounded waits count their timeouts", TEST_WATCHDOG_BoundedWait);
+    TEST_Run("WATCHDOG: late task stops the refreshes and is reported", TEST_WATCHDOG_LateTaskReported);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static void TEST_WATCHDOG_Run(uint8_t task, uint32_t period, uint32_t ms){
+    for(uint32_t i = 1; i <= ms; i++){
+        SIM_Run(TEST_WATCHDOG_MS);
+        if(i % period == 0)
+            WATCHDOG_CheckIn(task);
+    }
+}
+#pragma endregion
@@ -0,0 +1,318 @@
+/**
+ * @file TEST_string.c
+ * @author Devin Marx
+ * @brief Host unit tests of ACDC_string (Formatters are checked against the C library's snprintf)
+ * @version 0.1
+ * @date 2024-05-03
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include "TEST.h"
+#include "ACDC_string.h"
+
+#define TEST_RANDOM_VALUES 10000
+
+static uint64_t TestRandomState;
+
+#pragma region PRIVATE_FUNCTION_PROTOTYPES
+/// @brief Gets the next value of a fixed seed pseudo random sequence (Same values every run)
+/// @return 64 random bits
+static uint64_t TEST_Random(void);
+
+/// @brief Gets 10^exponent
+/// @param exponent Power (0 to 19)
+/// @return 10^exponent
+static uint64_t TEST_PowerOf10(uint8_t exponent);
+
+/// @brief Gets an edge case or random value, so every formatter sees 0, the limits, and every digit count
+/// @param i Index of the value (0 to TEST_RANDOM_VALUES - 1)
+/// @return Value to format
+static uint64_t TEST_Value(uint32_t i);
+
+/// @brief Writes a random string of digits, signs, spaces, and letters, or a printed edge case value (Null terminated)
+/// @param i Index of the string (0 to TEST_RANDOM_VALUES - 1)
+/// @param buffer Where to write the string (At least 32 characters)
+/// @return Length of the string
+static int32_t TEST_ParseInput(uint32_t i, char *buffer);
+#pragma endregion
+
+#pragma region TESTS
+static void TEST_string_Basics(void){
+    char buffer[32];
+    TEST_ASSERT_EQUAL(5, StringLength("Hello"));
+    TEST_ASSERT_EQUAL(0, StringLength(""));
+    TEST_ASSERT_EQUAL_STRING("Hello", StringCopy(buffer, "Hello"));
+    TEST_ASSERT_EQUAL_STRING("Hello World", StringConcat(buffer, " World"));
+    TEST_ASSERT_EQUAL(0, StringCompare("abc", "abc"));
+    TEST_ASSERT(StringCompare("abc", "abd") < 0);
+    TEST_ASSERT(StringCompare("abd", "abc") > 0);
+    TEST_ASSERT_EQUAL(4, StringIndexOf("Hello", 'o'));
+    TEST_ASSERT_EQUAL(-1, StringIndexOf("Hello", 'z'));
+    TEST_ASSERT_EQUAL_STRING("World", StringSubstring(buffer, 6));
+    TEST_ASSERT(StringStartsWith(buffer, "Hello"));
+    TEST_ASSERT(StringEndsWith(buffer, "World"));
+    TEST_ASSERT(!StringEndsWith(buffer, "Hello"));
+    TEST_ASSERT_EQUAL_STRING("HELLO WORLD", StringToUpper(buffer));
+    TEST_ASSERT(StringIsUpper("ABC"));
+    TEST_ASSERT_EQUAL_STRING("hello world", StringToLower(buffer));
+    TEST_ASSERT(StringIsLower("abc"));
+    TEST_ASSERT(StringIsNumeric("0123456789"));
+    TEST_ASSERT(!StringIsNumeric("12a"));
+    TEST_ASSERT(StringIsAlphabetic("abcXYZ"));
+    TEST_ASSERT(StringIsAlphanumeric("abc123"));
+    TEST_ASSERT(!StringIsAlphanumeric("abc 123"));
+}
+
+static void TEST_string_FormatIntegers(void){
+    char actual[STRING_U64_BUFFER_SIZE], expected[32];
+    for(uint32_t i = 0; i < TEST_RANDOM_VALUES; i++){
+        uint64_t value = TEST_Value(i);
+
+        snprintf(expected, sizeof(expected), "%" PRIu32, (uint32_t)value);
+        TEST_ASSERT_EQUAL((int32_t)strlen(expected), StringFormatU32(actual, (uint32_t)value));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+        snprintf(expected, sizeof(expected), "%" PRId32, (int32_t)value);
+        TEST_ASSERT_EQUAL((int32_t)strlen(expected), StringFormatI32(actual, (int32_t)value));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+        snprintf(expected, sizeof(expected), "%" PRIu64, value);
+        TEST_ASSERT_EQUAL((int32_t)strlen(expected), StringFormatU64(actual, value));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+        snprintf(expected, sizeof(expected), "%" PRId64, (int64_t)value);
+        TEST_ASSERT_EQUAL((int32_t)strlen(expected), StringFormatI64(actual, (int64_t)value));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+    }
+}
+
+static void TEST_string_FormatHexAndBinary(void){
+    char actual[STRING_BIN_BUFFER_SIZE], expected[STRING_BIN_BUFFER_SIZE];
+    for(uint32_t i = 0; i < TEST_RANDOM_VALUES; i++){
+        uint32_t value = (uint32_t)TEST_Value(i);
+        uint8_t minDigits = i % 9;
+
+        snprintf(expected, sizeof(expected), "%0*" PRIX32, minDigits, value);
+        TEST_ASSERT_EQUAL((int32_t)strlen(expected), StringFormatHex(actual, value, minDigits));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+
+        uint8_t bits = 1;                           // Expected binary, built the slow way
+        while(bits < 32 && (value >> bits) != 0)
+            bits++;
+        uint8_t digits = (i % 33) > bits ? (uint8_t)(i % 33) : bits;
+        for(uint8_t d = 0; d < digits; d++)
+            expected[d] = (value >> (digits - 1 - d)) & 1 ? '1' : '0';
+        expected[digits] = '\0';
+        TEST_ASSERT_EQUAL(digits, StringFormatBinary(actual, value, (uint8_t)(i % 33)));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+    }
+}
+
+static void TEST_string_FormatFixed(void){
+    char actual[STRING_FIXED_BUFFER_SIZE];
+    TEST_ASSERT_EQUAL(4, StringFormatFixed(actual, 0x00018000, 16, 2));
+    TEST_ASSERT_EQUAL_STRING("1.50", actual);
+    StringFormatFixed(actual, -0x00018000, 16, 2);
+    TEST_ASSERT_EQUAL_STRING("-1.50", actual);
+    StringFormatFixed(actual, 0x7FFF, 15, 3);       // q15 just under 1 rounds up
+    TEST_ASSERT_EQUAL_STRING("1.000", actual);
+    StringFormatFixed(actual, 5, 0, 0);
+    TEST_ASSERT_EQUAL_STRING("5", actual);
+
+    char expected[32];
+    for(uint32_t i = 0; i < TEST_RANDOM_VALUES; i++){
+        int32_t value = (int32_t)TEST_Value(i);
+        uint8_t fractionalBits = i % 32;
+        uint8_t decimalPlaces = i % 7;              // Past 6 places double rounding no longer matches exactly
+        uint64_t magnitude = value < 0 ? 0ULL - (int64_t)value : (uint64_t)value;
+        unsigned __int128 scaled = (unsigned __int128)magnitude * TEST_PowerOf10(decimalPlaces);
+        if(fractionalBits > 0 && (scaled & ((1ULL << fractionalBits) - 1)) == 1ULL << (fractionalBits - 1))
+            continue;                               // Exactly half way: printf rounds to even, ACDC rounds away from 0
+        snprintf(expected, sizeof(expected), "%.*f", decimalPlaces, value / (double)(1ULL << fractionalBits));
+        if(strcmp(expected, "-0") == 0 || strncmp(expected, "-0.", 3) == 0){
+            bool zero = true;                       // printf keeps the sign of a value that rounds to 0
+            for(const char *c = expected + 1; *c != '\0'; c++)
+                zero = zero && (*c == '0' || *c == '.');
+            if(zero)
+                memmove(expected, expected + 1, strlen(expected));
+        }
+        StringFormatFixed(actual, value, fractionalBits, decimalPlaces);
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+    }
+}
+
+static void TEST_string_ParseEdges(void){
+    uint32_t u;
+    int32_t value, consumed;
+    TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, StringParseU32("", 0, &u, &consumed));
+    TEST_ASSERT_EQUAL(0, u);
+    TEST_ASSERT_EQUAL(0, consumed);
+    TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, StringParseI32("", 0, &value, &consumed));
+    TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, StringParseI32("-", 1, &value, &consumed));   // A sign with no digits
+    TEST_ASSERT_EQUAL(0, value);
+    TEST_ASSERT_EQUAL(0, consumed);
+    TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, StringParseI32("+x", 2, &value, &consumed));
+    TEST_ASSERT_EQUAL(0, consumed);
+    TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, StringParseU32(" 12", 3, &u, &consumed));     // Whitespace is not skipped
+    TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, StringParseI32(" -12", 4, &value, &consumed));
+    TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, StringParseU32("-12", 3, &u, &consumed));     // No sign on an unsigned
+
+    TEST_ASSERT_EQUAL(STRING_PARSE_OK, StringParseU32("4294967295", 10, &u, &consumed));
+    TEST_ASSERT_EQUAL(UINT32_MAX, u);
+    TEST_ASSERT_EQUAL(STRING_PARSE_OVERFLOW, StringParseU32("4294967296 ", 11, &u, &consumed));
+    TEST_ASSERT_EQUAL(UINT32_MAX, u);
+    TEST_ASSERT_EQUAL(10, consumed);                // The whole number is consumed
+    TEST_ASSERT_EQUAL(STRING_PARSE_OK, StringParseI32("-2147483648", 11, &value, &consumed));
+    TEST_ASSERT_EQUAL(INT32_MIN, value);
+    TEST_ASSERT_EQUAL(STRING_PARSE_OVERFLOW, StringParseI32("-2147483649", 11, &value, &consumed));
+    TEST_ASSERT_EQUAL(INT32_MIN, value);
+    TEST_ASSERT_EQUAL(STRING_PARSE_OVERFLOW, StringParseI32("+2147483648", 11, &value, &consumed));
+    TEST_ASSERT_EQUAL(INT32_MAX, value);
+    TEST_ASSERT_EQUAL(11, consumed);
+
+    TEST_ASSERT_EQUAL(STRING_PARSE_OK, StringParseU32("12345", 3, &u, &consumed));          // Stops after length
+    TEST_ASSERT_EQUAL(123, u);
+    TEST_ASSERT_EQUAL(3, consumed);
+}
+
+static void TEST_string_ParseMatchesStrtol(void){
+    char input[32];
+    for(uint32_t i = 0; i < TEST_RANDOM_VALUES; i++){
+        int32_t length = TEST_ParseInput(i, input);
+        char *end;
+
+        // strtoul also takes whitespace and a sign, ACDC only takes digits
+        bool digitFirst = length > 0 && input[0] >= '0' && input[0] <= '9';
+        errno = 0;
+        unsigned long expectedU = strtoul(input, &end, 10);
+        bool overflowU = errno == ERANGE || expectedU > UINT32_MAX;
+        uint32_t u;
+        int32_t consumed;
+        StringParseResult result = StringParseU32(input, length, &u, &consumed);
+        if(!digitFirst){
+            TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, result);
+            TEST_ASSERT_EQUAL(0, u);
+            TEST_ASSERT_EQUAL(0, consumed);
+        } else {
+            TEST_ASSERT_EQUAL(overflowU ? STRING_PARSE_OVERFLOW : STRING_PARSE_OK, result);
+            TEST_ASSERT_EQUAL(overflowU ? UINT32_MAX : expectedU, u);
+            TEST_ASSERT_EQUAL(end - input, consumed);
+        }
+
+        // strtol also takes whitespace, and a lone sign is no number for either
+        bool hasSign = length > 0 && (input[0] == '-' || input[0] == '+');
+        bool numberFirst = hasSign ? (input[1] >= '0' && input[1] <= '9') : digitFirst;
+        errno = 0;
+        long expected = strtol(input, &end, 10);
+        bool overflow = errno == ERANGE || expected > INT32_MAX || expected < INT32_MIN;
+        int32_t value;
+        result = StringParseI32(input, length, &value, &consumed);
+        if(!numberFirst){
+            TEST_ASSERT_EQUAL(STRING_PARSE_NO_DIGITS, result);
+            TEST_ASSERT_EQUAL(0, value);
+            TEST_ASSERT_EQUAL(0, consumed);
+        } else {
+            TEST_ASSERT_EQUAL(overflow ? STRING_PARSE_OVERFLOW : STRING_PARSE_OK, result);
+            if(overflow)
+                TEST_ASSERT_EQUAL(input[0] == '-' ? INT32_MIN : INT32_MAX, value);
+            else
+                TEST_ASSERT_EQUAL(expected, value);
+            TEST_ASSERT_EQUAL(end - input, consumed);
+        }
+    }
+}
+
+static void TEST_string_Builder(void){
+    char buffer[8];
+    StringBuilder sb = StringBuilderInit(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(0, sb.length);
+    TEST_ASSERT_EQUAL_STRING("", sb.buffer);
+
+    TEST_ASSERT(StringBuilderAppend(&sb, "ab"));
+    TEST_ASSERT(StringBuilderAppendChar(&sb, ','));
+    TEST_ASSERT(StringBuilderAppendI32(&sb, -12));
+    TEST_ASSERT_EQUAL_STRING("ab,-12", sb.buffer);
+    TEST_ASSERT(!sb.truncated);
+
+    TEST_ASSERT(!StringBuilderAppendU32(&sb, 345));   // Only one character left
+    TEST_ASSERT_EQUAL_STRING("ab,-123", sb.buffer);
+    TEST_ASSERT_EQUAL(7, sb.length);
+    TEST_ASSERT(sb.truncated);
+    TEST_ASSERT(!StringBuilderAppendChar(&sb, 'x'));
+    TEST_ASSERT_EQUAL_STRING("ab,-123", sb.buffer);
+
+    StringBuilderClear(&sb);
+    TEST_ASSERT_EQUAL(0, sb.length);
+    TEST_ASSERT(!sb.truncated);
+    TEST_ASSERT(StringBuilderAppendLength(&sb, "xyz\0w", 5));   // Exactly length characters, even a '\0'
+    TEST_ASSERT_EQUAL(5, sb.length);
+    TEST_ASSERT_EQUAL_MEMORY("xyz\0w", sb.buffer, 6);
+
+    StringBuilderClear(&sb);
+    TEST_ASSERT(StringBuilderAppendHex(&sb, 0x2F, 4));
+    TEST_ASSERT_EQUAL_STRING("002F", sb.buffer);
+    StringBuilderClear(&sb);
+    TEST_ASSERT(StringBuilderAppendFixed(&sb, 0x00018000, 16, 1));
+    TEST_ASSERT_EQUAL_STRING("1.5", sb.buffer);
+    StringBuilderClear(&sb);
+    TEST_ASSERT(!StringBuilderAppendI64(&sb, INT64_MIN));
+    TEST_ASSERT_EQUAL_STRING("-922337", sb.buffer);
+    StringBuilderClear(&sb);
+    TEST_ASSERT(!StringBuilderAppendU64(&sb, 1ULL << 63));         // Would be negative through AppendI64
+    TEST_ASSERT_EQUAL_STRING("9223372", sb.buffer);
+}
+#pragma endregion
+
+void TEST_string(void){
+    TEST_Run("string: basics", TEST_string_Basics);
+    TEST_Run("string: U32/I32/U64/I64 match printf", TEST_string_FormatIntegers);
+    TEST_Run("string: hex and binary match printf", TEST_string_FormatHexAndBinary);
+    TEST_Run("string: fixed point matches printf", TEST_string_FormatFixed);
+    TEST_Run("string: parse edge cases", TEST_string_ParseEdges);
+    TEST_Run("string: U32/I32 parse matches strtoul/strtol", TEST_string_ParseMatchesStrtol);
+    TEST_Run("string: StringBuilder appends and truncates", TEST_string_Builder);
+}
+
+#pragma region PRIVATE_FUNCTIONS
+static uint64_t TEST_Random(void){
+    TestRandomState = TestRandomState * 6364136223846793005ULL + 1442695040888963407ULL;   // Knuth's MMIX LCG
+    uint64_t x = TestRandomState;
+    return x ^ (x >> 29);
+}
+
+static uint64_t TEST_PowerOf10(uint8_t exponent){
+    uint64_t power = 1;
+    while(exponent-- > 0)
+        power *= 10;
+    return power;
+}
+
+static uint64_t TEST_Value(uint32_t i){
+    static const uint64_t edges[] = {
+        0, 1, 9, 10, 99, 100, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0x100000000ULL, 0x7FFFFFFFFFFFFFFFULL,
+        0x8000000000000000ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFF80000000ULL, 1000000000, 4294967295ULL
+    };
+    if(i < sizeof(edges) / sizeof(edges[0]))
+        return edges[i];
+    uint64_t value = TEST_Random();
+    return value >> (TEST_Random() % 64);           // Every magnitude, not just 20 digit values
+}
+
+static int32_t TEST_ParseInput(uint32_t i, char *buffer){
+    static const char alphabet[] = "0123456789000999-+ x";   // Mostly digits, long runs of 0s and 9s overflow
+    if(i % 2 == 0){                                 // A printed value with an optional sign, near every limit
+        uint64_t value = TEST_Value(i / 2);
+        const char *sign = (i % 6 == 0) ? "-" : (i % 6 == 2) ? "+" : "";
+        return snprintf(buffer, 32, "%s%" PRIu64 "%s", sign, value >> (TEST_Random() % 40), (i % 8 == 0) ? " 7" : "");
+    }
+    int32_t length = (int32_t)(TEST_Random() % 25);
+    for(int32_t c = 0; c < length; c++)
+        buffer[c] = alphabet[TEST_Random() % (sizeof(alphabet) - 1)];
+    buffer[length] = '\0';
+    return length;
+}
+#pragma endregion